@@ -20,6 +20,7 @@ python3 tools/check_core_purity.py \
   components/mcp4726/mcp4726_protocol.h \
   components/mlx90614/mlx90614_registers.h \
   components/bq25628/bq25628_registers.h \
+  components/bq25628/bq25628_register_config.h \
   components/bq25628/bq25628_protocol.h \
   components/bq25628/bq25628_protocol.cpp \
   components/bq25628/bq25628_bus.h \
@@ -29,21 +30,42 @@ python3 tools/check_core_purity.py \
   components/bq76952/bq76952_registers.h \
   components/bq76952/bq76952_status.h \
   components/bq76952/bq76952_status.cpp \
-  components/mcf83xx_common \
+  components/mcf83xx_common/comms_bringup.h \
+  components/mcf83xx_common/diagnostic_snapshot.h \
+  components/mcf83xx_common/poll_service.h \
+  components/mcf83xx_common/protocol.h \
+  components/mcf83xx_common/register_access.h \
+  components/mcf83xx_common/register_bus.h \
+  components/mcf83xx_common/speed_command.h \
+  components/mcf83xx_common/tuning_record.h \
+  components/mcf83xx_common/watchdog_tickle.h \
   components/mcf8316d/mcf8316d_bus.h \
   components/mcf8316d/mcf8316d_registers.h \
   components/mcf8316d/mcf8316d_protocol.h \
   components/mcf8316d/mcf8316d_protocol.cpp \
   components/mcf8316d/mcf8316d_service.h \
   components/mcf8316d/mcf8316d_service.cpp \
+  components/mcf8316d/mcf8316d_poll_service.h \
+  components/mcf8316d/mcf8316d_diagnostics.h \
+  components/mcf8316d/mcf8316d_startup_search.h \
+  components/mcf8316d/mcf8316d_startup_search.cpp \
+  components/mcf8316d/mcf8316d_scope_capture.h \
+  components/mcf8316d/mcf8316d_scope_capture.cpp \
   components/mcf8329a/mcf8329a_bus.h \
   components/mcf8329a/mcf8329a_registers.h \
   components/mcf8329a/mcf8329a_protocol.h \
   components/mcf8329a/mcf8329a_protocol.cpp \
   components/mcf8329a/mcf8329a_service.h \
   components/mcf8329a/mcf8329a_service.cpp \
+  components/mcf8329a/mcf8329a_poll_service.h \
+  components/mcf8329a/mcf8329a_diagnostics.h \
+  components/mcf8329a/mcf8329a_diagnostics.cpp \
+  components/mcf8329a/mcf8329a_tuning_service.h \
+  components/mcf8329a/mcf8329a_tuning_service.cpp \
   components/mcf8329a/mcf8329a_tables.h \
   components/programmable_load/calibration.h \
+  components/programmable_load/calibration_store.h \
+  components/programmable_load/calibration_store.cpp \
   components/programmable_load/programmable_load_core.h \
   components/programmable_load/programmable_load_core.cpp
 
@@ -88,6 +110,11 @@ run_test register_components_test \
   components/husb238/husb238_protocol.cpp \
   components/husb238/husb238_service.cpp
 
+run_test husb238_service_test \
+  tests/husb238_service_test.cpp \
+  components/husb238/husb238_protocol.cpp \
+  components/husb238/husb238_service.cpp
+
 run_test bq25628_service_test \
   tests/bq25628_service_test.cpp \
   components/bq25628/bq25628_protocol.cpp \
@@ -98,6 +125,10 @@ run_test bq25756_service_test \
   components/bq25756/bq25756_protocol.cpp \
   components/bq25756/bq25756_service.cpp
 
+run_test bq25756_telemetry_test \
+  tests/bq25756_telemetry_test.cpp \
+  components/bq25756/bq25756_telemetry_service.cpp
+
 run_test bq76952_status_test \
   tests/bq76952_status_test.cpp \
   components/bq76952/bq76952_status.cpp
@@ -112,8 +143,38 @@ run_test mcf83xx_services_test \
   components/mcf8329a/mcf8329a_protocol.cpp \
   components/mcf8329a/mcf8329a_service.cpp
 
+run_test mcf83xx_driver_core_test \
+  tests/mcf83xx_driver_core_test.cpp \
+  components/mcf8316d/mcf8316d_protocol.cpp \
+  components/mcf8316d/mcf8316d_service.cpp \
+  components/mcf8329a/mcf8329a_protocol.cpp \
+  components/mcf8329a/mcf8329a_service.cpp \
+  components/mcf8329a/mcf8329a_diagnostics.cpp
+
+run_test mcf8316d_startup_search_test \
+  tests/mcf8316d_startup_search_test.cpp \
+  components/mcf8316d/mcf8316d_protocol.cpp \
+  components/mcf8316d/mcf8316d_startup_search.cpp
+
+run_test mcf8316d_scope_capture_test \
+  tests/mcf8316d_scope_capture_test.cpp \
+  components/mcf8316d/mcf8316d_scope_capture.cpp
+
+run_test mcf8329a_runtime_test \
+  tests/mcf8329a_runtime_test.cpp \
+  components/mcf8329a/mcf8329a_protocol.cpp \
+  components/mcf8329a/mcf8329a_service.cpp \
+  components/mcf8329a/mcf8329a_diagnostics.cpp
+
+run_test mcf8329a_tuning_replay_test \
+  tests/mcf8329a_tuning_replay_test.cpp \
+  components/mcf8329a/mcf8329a_protocol.cpp \
+  components/mcf8329a/mcf8329a_service.cpp \
+  components/mcf8329a/mcf8329a_tuning_service.cpp
+
 run_test programmable_load_core_test \
   tests/programmable_load_core_test.cpp \
-  components/programmable_load/programmable_load_core.cpp
+  components/programmable_load/programmable_load_core.cpp \
+  components/programmable_load/calibration_store.cpp
 
 echo "host tests: passed ($cxx)"
@@ -1,51 +1,144 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
-from esphome.components import i2c, sensor
+from esphome.components import i2c, sensor, text_sensor
 from esphome.const import (
     CONF_BATTERY_VOLTAGE,
     CONF_ID,
+    DEVICE_CLASS_CURRENT,
+    DEVICE_CLASS_TEMPERATURE,
     DEVICE_CLASS_VOLTAGE,
+    ENTITY_CATEGORY_DIAGNOSTIC,
     STATE_CLASS_MEASUREMENT,
+    UNIT_AMPERE,
+    UNIT_CELSIUS,
+    UNIT_PERCENT,
     UNIT_VOLT,
 )
 
 DEPENDENCIES = ["i2c"]
-AUTO_LOAD = ["component_common", "sensor"]
+AUTO_LOAD = ["component_common", "sensor", "text_sensor"]
+MULTI_CONF = True
+
+component_common_ns = cg.global_ns.namespace("component_common")
+ChargerInterface = component_common_ns.class_("ChargerInterface")
 
 bq25628_ns = cg.esphome_ns.namespace("bq25628")
-BQ25628Component = bq25628_ns.class_("BQ25628Component", cg.PollingComponent, i2c.I2CDevice)
+BQ25628Component = bq25628_ns.class_(
+    "BQ25628Component", cg.PollingComponent, i2c.I2CDevice, ChargerInterface
+)
 
+CONF_DISABLE_WATCHDOG = "disable_watchdog"
 CONF_MEASUREMENTS = "measurements"
+CONF_BATTERY_CURRENT = "battery_current"
+CONF_INPUT_VOLTAGE = "input_voltage"
+CONF_INPUT_CURRENT = "input_current"
+CONF_PMID_VOLTAGE = "pmid_voltage"
+CONF_SYSTEM_VOLTAGE = "system_voltage"
+CONF_TEMPERATURE_PERCENT = "temperature_percent"
+CONF_DIE_TEMPERATURE = "die_temperature"
+CONF_STATUS = "status"
+CONF_CHARGING_STATUS = "charging"
+CONF_VBUS_STATUS = "vbus"
+CONF_TEMPERATURE_STATUS = "temperature"
+CONF_FAULTS = "faults"
+
+def voltage_sensor_schema():
+    return sensor.sensor_schema(
+        unit_of_measurement=UNIT_VOLT,
+        accuracy_decimals=3,
+        device_class=DEVICE_CLASS_VOLTAGE,
+        state_class=STATE_CLASS_MEASUREMENT,
+    )
+
+
+def current_sensor_schema():
+    return sensor.sensor_schema(
+        unit_of_measurement=UNIT_AMPERE,
+        accuracy_decimals=3,
+        device_class=DEVICE_CLASS_CURRENT,
+        state_class=STATE_CLASS_MEASUREMENT,
+    )
+
 
 MEASUREMENTS_SCHEMA = cv.Schema(
     {
-        cv.Optional(CONF_BATTERY_VOLTAGE): sensor.sensor_schema(
-            unit_of_measurement=UNIT_VOLT,
-            accuracy_decimals=3,
-            device_class=DEVICE_CLASS_VOLTAGE,
+        cv.Optional(CONF_BATTERY_VOLTAGE): voltage_sensor_schema(),
+        cv.Optional(CONF_BATTERY_CURRENT): current_sensor_schema(),
+        cv.Optional(CONF_INPUT_VOLTAGE): voltage_sensor_schema(),
+        cv.Optional(CONF_INPUT_CURRENT): current_sensor_schema(),
+        cv.Optional(CONF_PMID_VOLTAGE): voltage_sensor_schema(),
+        cv.Optional(CONF_SYSTEM_VOLTAGE): voltage_sensor_schema(),
+        cv.Optional(CONF_TEMPERATURE_PERCENT): sensor.sensor_schema(
+            unit_of_measurement=UNIT_PERCENT,
+            accuracy_decimals=2,
+            state_class=STATE_CLASS_MEASUREMENT,
+        ),
+        cv.Optional(CONF_DIE_TEMPERATURE): sensor.sensor_schema(
+            unit_of_measurement=UNIT_CELSIUS,
+            accuracy_decimals=1,
+            device_class=DEVICE_CLASS_TEMPERATURE,
             state_class=STATE_CLASS_MEASUREMENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
         ),
     }
 )
 
+STATUS_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_CHARGING_STATUS): text_sensor.text_sensor_schema(),
+        cv.Optional(CONF_VBUS_STATUS): text_sensor.text_sensor_schema(),
+        cv.Optional(CONF_TEMPERATURE_STATUS): text_sensor.text_sensor_schema(),
+        cv.Optional(CONF_FAULTS): text_sensor.text_sensor_schema(entity_category=ENTITY_CATEGORY_DIAGNOSTIC),
+    }
+)
+
 CONFIG_SCHEMA = (
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(BQ25628Component),
+            cv.Optional(CONF_DISABLE_WATCHDOG, default=True): cv.boolean,
             cv.Optional(CONF_MEASUREMENTS, default={}): MEASUREMENTS_SCHEMA,
+            cv.Optional(CONF_STATUS, default={}): STATUS_SCHEMA,
         }
     )
     .extend(cv.polling_component_schema("60s"))
     .extend(i2c.i2c_device_schema(default_address=0x6A))
 )
 
+MEASUREMENT_SETTERS = {
+    CONF_BATTERY_VOLTAGE: "set_battery_voltage_sensor",
+    CONF_BATTERY_CURRENT: "set_battery_current_sensor",
+    CONF_INPUT_VOLTAGE: "set_bus_voltage_sensor",
+    CONF_INPUT_CURRENT: "set_bus_current_sensor",
+    CONF_PMID_VOLTAGE: "set_pmid_voltage_sensor",
+    CONF_SYSTEM_VOLTAGE: "set_system_voltage_sensor",
+    CONF_TEMPERATURE_PERCENT: "set_ts_sensor",
+    CONF_DIE_TEMPERATURE: "set_die_temperature_sensor",
+}
+
+STATUS_SETTERS = {
+    CONF_CHARGING_STATUS: "set_charge_status_text_sensor",
+    CONF_VBUS_STATUS: "set_vbus_status_text_sensor",
+    CONF_TEMPERATURE_STATUS: "set_ts_status_text_sensor",
+    CONF_FAULTS: "set_fault_text_sensor",
+}
+
 
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     await i2c.register_i2c_device(var, config)
 
+    cg.add(var.set_disable_watchdog(config[CONF_DISABLE_WATCHDOG]))
+
     measurements = config[CONF_MEASUREMENTS]
-    if CONF_BATTERY_VOLTAGE in measurements:
-        battery_voltage = await sensor.new_sensor(measurements[CONF_BATTERY_VOLTAGE])
-        cg.add(var.set_battery_voltage_sensor(battery_voltage))
+    for key, setter in MEASUREMENT_SETTERS.items():
+        if key in measurements:
+            sens = await sensor.new_sensor(measurements[key])
+            cg.add(getattr(var, setter)(sens))
+
+    status = config[CONF_STATUS]
+    for key, setter in STATUS_SETTERS.items():
+        if key in status:
+            sens = await text_sensor.new_text_sensor(status[key])
+            cg.add(getattr(var, setter)(sens))
@@ -1,5 +1,6 @@
 #include "bq25628.h"
 
+#include "esphome/core/hal.h"
 #include "esphome/core/log.h"
 
 namespace esphome {
@@ -7,34 +8,67 @@ namespace bq25628 {
 
 static const char *const TAG = "bq25628";
 
+// Publishes only when the text differs from the last published value.
+static void publish_text(text_sensor::TextSensor *sensor, ::component_common::PublishGuard &guard, const char *text) {
+  if (sensor != nullptr && guard.changed(text))
+    sensor->publish_state(text);
+}
+
 void BQ25628Component::setup() {
   if (!this->service_.probe()) {
     ESP_LOGE(TAG, "BQ25628E not detected at address 0x%02X", this->address_);
     this->mark_failed();
     return;
   }
-  if (!this->service_.enable_adc()) {
-    ESP_LOGE(TAG, "Unable to enable the charger ADC");
+  // The charger's own values are the base; YAML settings are laid over them.
+  ::bq25628_core::Bq25628RegisterConfig base{};
+  if (!this->service_.read_register_config(base)) {
+    ESP_LOGE(TAG, "Unable to read the charger configuration");
+    this->mark_failed();
+    return;
+  }
+  this->build_register_config_image_(base);
+  if (!this->ensure_configuration_()) {
+    ESP_LOGE(TAG, "Unable to apply the charger configuration");
     this->mark_failed();
     return;
   }
-  ESP_LOGI(TAG, "BQ25628E detected; charger ADC enabled");
+  ESP_LOGI(TAG, "BQ25628E detected; configuration applied");
 }
 
 void BQ25628Component::update() {
   if (this->is_failed())
     return;
 
-  float battery_voltage_v;
-  if (!this->service_.read_battery_voltage_v(battery_voltage_v)) {
-    ESP_LOGW(TAG, "Unable to read battery voltage");
+  ::bq25628_core::Status status{};
+  if (!this->service_.read_status(status)) {
+    ESP_LOGW(TAG, "Unable to read charger status");
     this->status_set_warning();
+    this->publish_invalid_snapshot_();
+    return;
+  }
+  // Free while the verified fingerprint stands; a watchdog expiry or I/O
+  // error since the last poll makes it reconcile.
+  if (!this->ensure_configuration_()) {
+    this->status_set_warning();
+    this->publish_invalid_snapshot_();
     return;
   }
 
+  ::bq25628_core::Measurements measurements{};
+  if (!this->service_.read_measurements(measurements)) {
+    ESP_LOGW(TAG, "Unable to read charger ADC");
+    this->status_set_warning();
+    this->publish_invalid_snapshot_();
+    return;
+  }
+  if (!this->disable_watchdog_ && !this->service_.reset_watchdog())
+    ESP_LOGW(TAG, "Unable to reset the charger watchdog");
+
   this->status_clear_warning();
-  if (this->battery_voltage_sensor_ != nullptr)
-    this->battery_voltage_sensor_->publish_state(battery_voltage_v);
+  this->publish_snapshot_(::bq25628_core::make_charger_snapshot(status, measurements, millis()));
+  this->publish_measurements_(measurements);
+  this->publish_status_texts_(status);
 }
 
 void BQ25628Component::dump_config() {
@@ -43,7 +77,22 @@ void BQ25628Component::dump_config() {
   if (this->is_failed())
     ESP_LOGE(TAG, "Communication failed");
   LOG_UPDATE_INTERVAL(this);
+  ESP_LOGCONFIG(TAG, "  disable_watchdog: %s", this->disable_watchdog_ ? "true" : "false");
+  if (this->has_register_config_image_)
+    ESP_LOGCONFIG(TAG, "  configuration fingerprint: 0x%08X",
+                  static_cast<unsigned>(component_common::configuration_fingerprint(this->register_config_image_)));
   LOG_SENSOR("  ", "Battery Voltage", this->battery_voltage_sensor_);
+  LOG_SENSOR("  ", "Battery Current", this->battery_current_sensor_);
+  LOG_SENSOR("  ", "Bus Voltage", this->bus_voltage_sensor_);
+  LOG_SENSOR("  ", "Bus Current", this->bus_current_sensor_);
+  LOG_SENSOR("  ", "PMID Voltage", this->pmid_voltage_sensor_);
+  LOG_SENSOR("  ", "System Voltage", this->system_voltage_sensor_);
+  LOG_SENSOR("  ", "TS", this->ts_sensor_);
+  LOG_SENSOR("  ", "Die Temperature", this->die_temperature_sensor_);
+  LOG_TEXT_SENSOR("  ", "Charge Status", this->charge_status_text_sensor_);
+  LOG_TEXT_SENSOR("  ", "VBUS Status", this->vbus_status_text_sensor_);
+  LOG_TEXT_SENSOR("  ", "TS Status", this->ts_status_text_sensor_);
+  LOG_TEXT_SENSOR("  ", "Faults", this->fault_text_sensor_);
 }
 
 bool BQ25628Component::read_registers(uint8_t reg, uint8_t *data, size_t len) {
@@ -54,5 +103,101 @@ bool BQ25628Component::write_registers(uint8_t reg, const uint8_t *data, size_t
   return this->write_bytes(reg, data, len);
 }
 
+::component_common::ChargerCapabilities BQ25628Component::capabilities() const {
+  return {
+      .enable_control = true,
+      .battery_current = ::bq25628_core::REGISTER_U16_BYTE_ORDER_CONFIRMED,
+      .battery_voltage = ::bq25628_core::REGISTER_U16_BYTE_ORDER_CONFIRMED,
+      .charge_state = true,
+      .power_good = true,
+      .fault_status = true,
+  };
+}
+
+bool BQ25628Component::request_enabled(bool enabled) {
+  if (this->is_failed() || !this->service_.set_charge_enabled(enabled))
+    return false;
+  if (this->latest_snapshot().enabled != enabled) {
+    auto snapshot = this->latest_snapshot();
+    snapshot.enabled = enabled;
+    this->publish_snapshot_(snapshot);
+  }
+  return true;
+}
+
+void BQ25628Component::build_register_config_image_(const ::bq25628_core::Bq25628RegisterConfig &base) {
+  namespace fields = ::bq25628_core::fields;
+  auto config = base;
+  config.charger_control_0 = fields::Watchdog::replace(
+      config.charger_control_0,
+      this->disable_watchdog_ ? ::bq25628_core::WATCHDOG_DISABLED : ::bq25628_core::WATCHDOG_50S);
+  // Continuous conversion of every channel, at the charger's sample and
+  // averaging settings.
+  config.adc_control = fields::AdcOneShot::replace(fields::AdcEnable::replace(config.adc_control, 1), 0);
+  config.adc_function_disable_0 = 0;
+  this->register_config_image_ = ::bq25628_core::make_register_config_image(config);
+  this->has_register_config_image_ = true;
+}
+
+bool BQ25628Component::ensure_configuration_() {
+  ::bq25628_core::ConfigurationReconcileResult result{};
+  const bool ok = this->service_.ensure_configuration(this->register_config_image_, result);
+  if (result.read_only_mismatch_count != 0) {
+    ESP_LOGW(TAG, "%u 16-bit limit registers differ from the setup image; left unwritten",
+             static_cast<unsigned>(result.read_only_mismatch_count));
+  }
+  if (ok)
+    return true;
+  if (!result.io_ok) {
+    ESP_LOGW(TAG, "Configuration check failed: I2C error");
+  } else {
+    ESP_LOGW(TAG, "Configuration mismatch: %u registers still differ, first at 0x%02X",
+             static_cast<unsigned>(result.remaining_mismatch_count),
+             static_cast<unsigned>(result.first_mismatch_address));
+  }
+  return false;
+}
+
+void BQ25628Component::publish_measurements_(const ::bq25628_core::Measurements &measurements) {
+  if (this->battery_voltage_sensor_ != nullptr)
+    this->battery_voltage_sensor_->publish_state(measurements.vbat_v);
+  if (this->battery_current_sensor_ != nullptr)
+    this->battery_current_sensor_->publish_state(measurements.ibat_a);
+  if (this->bus_voltage_sensor_ != nullptr)
+    this->bus_voltage_sensor_->publish_state(measurements.vbus_v);
+  if (this->bus_current_sensor_ != nullptr)
+    this->bus_current_sensor_->publish_state(measurements.ibus_a);
+  if (this->pmid_voltage_sensor_ != nullptr)
+    this->pmid_voltage_sensor_->publish_state(measurements.vpmid_v);
+  if (this->system_voltage_sensor_ != nullptr)
+    this->system_voltage_sensor_->publish_state(measurements.vsys_v);
+  if (this->ts_sensor_ != nullptr)
+    this->ts_sensor_->publish_state(measurements.ts_percent);
+  if (this->die_temperature_sensor_ != nullptr)
+    this->die_temperature_sensor_->publish_state(measurements.tdie_c);
+}
+
+void BQ25628Component::publish_status_texts_(const ::bq25628_core::Status &status) {
+  publish_text(this->charge_status_text_sensor_, this->charge_status_guard_,
+               ::bq25628_core::charge_status_to_string(::bq25628_core::decode_charge_status(status)));
+  publish_text(this->vbus_status_text_sensor_, this->vbus_status_guard_,
+               ::bq25628_core::vbus_status_to_string(::bq25628_core::decode_vbus_status(status)));
+  publish_text(this->ts_status_text_sensor_, this->ts_status_guard_,
+               ::bq25628_core::ts_status_to_string(::bq25628_core::decode_ts_status(status)));
+  if (this->fault_text_sensor_ != nullptr) {
+    char faults[96];
+    ::bq25628_core::format_faults(status, faults, sizeof(faults));
+    publish_text(this->fault_text_sensor_, this->fault_guard_, faults);
+  }
+}
+
+void BQ25628Component::publish_invalid_snapshot_() {
+  if (!this->latest_snapshot().valid)
+    return;
+  auto snapshot = this->latest_snapshot();
+  snapshot.valid = false;
+  this->publish_snapshot_(snapshot);
+}
+
 }  // namespace bq25628
 }  // namespace esphome
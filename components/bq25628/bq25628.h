@@ -5,9 +5,12 @@
 
 #include "bq25628_bus.h"
 #include "bq25628_service.h"
+#include "../component_common/charger.h"
+#include "../component_common/fixed_string.h"
 
 #include "esphome/components/i2c/i2c.h"
 #include "esphome/components/sensor/sensor.h"
+#include "esphome/components/text_sensor/text_sensor.h"
 #include "esphome/core/component.h"
 
 namespace esphome {
@@ -15,13 +18,25 @@ namespace bq25628 {
 
 class BQ25628Component : public PollingComponent,
                          public i2c::I2CDevice,
-                         public ::bq25628_core::RegisterBus {
+                         public ::bq25628_core::RegisterBus,
+                         public ::component_common::ChargerInterface {
  public:
   BQ25628Component() : service_(this) {}
 
-  void set_battery_voltage_sensor(sensor::Sensor *sensor) {
-    battery_voltage_sensor_ = sensor;
-  }
+  void set_battery_voltage_sensor(sensor::Sensor *sensor) { battery_voltage_sensor_ = sensor; }
+  void set_battery_current_sensor(sensor::Sensor *sensor) { battery_current_sensor_ = sensor; }
+  void set_bus_voltage_sensor(sensor::Sensor *sensor) { bus_voltage_sensor_ = sensor; }
+  void set_bus_current_sensor(sensor::Sensor *sensor) { bus_current_sensor_ = sensor; }
+  void set_pmid_voltage_sensor(sensor::Sensor *sensor) { pmid_voltage_sensor_ = sensor; }
+  void set_system_voltage_sensor(sensor::Sensor *sensor) { system_voltage_sensor_ = sensor; }
+  void set_ts_sensor(sensor::Sensor *sensor) { ts_sensor_ = sensor; }
+  void set_die_temperature_sensor(sensor::Sensor *sensor) { die_temperature_sensor_ = sensor; }
+  void set_charge_status_text_sensor(text_sensor::TextSensor *sensor) { charge_status_text_sensor_ = sensor; }
+  void set_vbus_status_text_sensor(text_sensor::TextSensor *sensor) { vbus_status_text_sensor_ = sensor; }
+  void set_ts_status_text_sensor(text_sensor::TextSensor *sensor) { ts_status_text_sensor_ = sensor; }
+  void set_fault_text_sensor(text_sensor::TextSensor *sensor) { fault_text_sensor_ = sensor; }
+
+  void set_disable_watchdog(bool disable) { this->disable_watchdog_ = disable; }
 
   void setup() override;
   void update() override;
@@ -31,9 +46,38 @@ class BQ25628Component : public PollingComponent,
   bool read_registers(uint8_t reg, uint8_t *data, size_t len) override;
   bool write_registers(uint8_t reg, const uint8_t *data, size_t len) override;
 
+  ::component_common::ChargerCapabilities capabilities() const override;
+  bool request_enabled(bool enabled) override;
+
  protected:
+  void build_register_config_image_(const ::bq25628_core::Bq25628RegisterConfig &base);
+  bool ensure_configuration_();
+  void publish_measurements_(const ::bq25628_core::Measurements &measurements);
+  void publish_status_texts_(const ::bq25628_core::Status &status);
+  void publish_invalid_snapshot_();
+
   ::bq25628_core::Bq25628Service service_;
+  ::bq25628_core::Bq25628RegisterConfigImage register_config_image_{::bq25628_core::REGISTER_CONFIG_LAYOUT};
+  bool has_register_config_image_{false};
+
   sensor::Sensor *battery_voltage_sensor_{nullptr};
+  sensor::Sensor *battery_current_sensor_{nullptr};
+  sensor::Sensor *bus_voltage_sensor_{nullptr};
+  sensor::Sensor *bus_current_sensor_{nullptr};
+  sensor::Sensor *pmid_voltage_sensor_{nullptr};
+  sensor::Sensor *system_voltage_sensor_{nullptr};
+  sensor::Sensor *ts_sensor_{nullptr};
+  sensor::Sensor *die_temperature_sensor_{nullptr};
+  text_sensor::TextSensor *charge_status_text_sensor_{nullptr};
+  text_sensor::TextSensor *vbus_status_text_sensor_{nullptr};
+  text_sensor::TextSensor *ts_status_text_sensor_{nullptr};
+  text_sensor::TextSensor *fault_text_sensor_{nullptr};
+  ::component_common::PublishGuard charge_status_guard_{};
+  ::component_common::PublishGuard vbus_status_guard_{};
+  ::component_common::PublishGuard ts_status_guard_{};
+  ::component_common::PublishGuard fault_guard_{};
+
+  bool disable_watchdog_{true};
 };
 
 }  // namespace bq25628
@@ -1,7 +1,53 @@
 #include "bq25628_protocol.h"
 
+#include <cmath>
+#include <cstring>
+
+#include "../component_common/byte_order.h"
+
 namespace bq25628_core {
 
+namespace {
+
+constexpr uint8_t TS_STATUS_COLD = 1;
+constexpr uint8_t TS_STATUS_HOT = 2;
+constexpr uint8_t TS_STATUS_BIAS_FAULT = 7;
+
+bool ts_suspends_charging(uint8_t ts_status) {
+  return ts_status == TS_STATUS_COLD || ts_status == TS_STATUS_HOT || ts_status == TS_STATUS_BIAS_FAULT;
+}
+
+uint16_t register_at(const uint8_t *block, RegisterId id) {
+  return load_register_u16(block + (register_address(id) - register_address(RegisterId::IBUS_ADC)));
+}
+
+// Two's complement across the register; bit 0 is reserved and reads zero.
+float decode_signed_current_a(uint16_t raw, float lsb_a) {
+  const int16_t code = static_cast<int16_t>(raw & 0xFFFEU);
+  return static_cast<float>(code / 2) * lsb_a;
+}
+
+uint16_t clamp_u16(uint16_t value, uint16_t minimum, uint16_t maximum) {
+  return value < minimum ? minimum : value > maximum ? maximum : value;
+}
+
+bool append_text(char *buffer, size_t size, size_t &length, const char *text) {
+  const size_t separator = length == 0 ? 0 : 1;
+  const size_t text_length = std::strlen(text);
+  if (length + separator + text_length >= size) {
+    return false;
+  }
+  if (separator != 0) {
+    buffer[length++] = ',';
+  }
+  std::memcpy(buffer + length, text, text_length);
+  length += text_length;
+  buffer[length] = '\0';
+  return true;
+}
+
+}  // namespace
+
 bool is_bq25628e(uint8_t part_information) {
   return fields::PartNumber::decode(part_information) == BQ25628E_PART_NUMBER;
 }
@@ -10,8 +56,202 @@ uint8_t enable_adc(uint8_t adc_control) {
   return fields::AdcEnable::replace(adc_control, 1);
 }
 
+uint16_t load_register_u16(const uint8_t *raw) { return component_common::load_be<uint16_t>(raw); }
+
+void store_register_u16(uint16_t value, uint8_t *raw) { component_common::store_be<uint16_t>(value, raw); }
+
 float decode_battery_voltage_v(uint16_t vbat_adc_raw_be) {
   return static_cast<float>(fields::BatteryVoltageAdc::decode(vbat_adc_raw_be)) * VBAT_ADC_LSB_V;
 }
 
+Measurements decode_measurements(const uint8_t *block) {
+  Measurements measurements{};
+  measurements.ibus_a = decode_signed_current_a(register_at(block, RegisterId::IBUS_ADC), IBUS_ADC_LSB_A);
+  measurements.ibat_a = decode_signed_current_a(register_at(block, RegisterId::IBAT_ADC), IBAT_ADC_LSB_A);
+  measurements.vbus_v =
+      static_cast<float>(fields::BusVoltageAdc::decode(register_at(block, RegisterId::VBUS_ADC))) * VBUS_ADC_LSB_V;
+  measurements.vpmid_v =
+      static_cast<float>(fields::PmidVoltageAdc::decode(register_at(block, RegisterId::VPMID_ADC))) * VPMID_ADC_LSB_V;
+  measurements.vbat_v = decode_battery_voltage_v(register_at(block, RegisterId::VBAT_ADC));
+  measurements.vsys_v =
+      static_cast<float>(fields::SystemVoltageAdc::decode(register_at(block, RegisterId::VSYS_ADC))) * VSYS_ADC_LSB_V;
+  measurements.ts_percent =
+      static_cast<float>(fields::TsAdc::decode(register_at(block, RegisterId::TS_ADC))) * TS_ADC_LSB_PERCENT;
+  // TDIE is a 12-bit two's complement value.
+  int16_t tdie = static_cast<int16_t>(fields::DieTemperatureAdc::decode(register_at(block, RegisterId::TDIE_ADC)));
+  if (tdie >= 0x800) {
+    tdie = static_cast<int16_t>(tdie - 0x1000);
+  }
+  measurements.tdie_c = static_cast<float>(tdie) * TDIE_ADC_LSB_C;
+  return measurements;
+}
+
+ChargeStatus decode_charge_status(const Status &status) {
+  return static_cast<ChargeStatus>(fields::ChargeStatus::decode(status.charger_status_1));
+}
+
+uint8_t decode_vbus_status(const Status &status) { return fields::VbusStatus::decode(status.charger_status_1); }
+
+uint8_t decode_ts_status(const Status &status) { return fields::TsStatus::decode(status.fault_status_0); }
+
+bool charge_enabled(const Status &status) { return fields::ChargeEnable::decode(status.charger_control_0) != 0; }
+
+bool hiz_enabled(const Status &status) { return fields::HizEnable::decode(status.charger_control_0) != 0; }
+
+bool power_good(const Status &status) {
+  return decode_vbus_status(status) != 0 && fields::VbusFault::decode(status.fault_status_0) == 0;
+}
+
+bool charger_fault_active(const Status &status) {
+  return fields::VbusFault::decode(status.fault_status_0) != 0 ||
+         fields::BatteryFault::decode(status.fault_status_0) != 0 ||
+         fields::SystemFault::decode(status.fault_status_0) != 0 ||
+         fields::ThermalShutdown::decode(status.fault_status_0) != 0 ||
+         fields::SafetyTimerExpired::decode(status.charger_status_0) != 0 ||
+         ts_suspends_charging(decode_ts_status(status));
+}
+
+bool watchdog_expired(const Status &status) {
+  return fields::WatchdogExpired::decode(status.charger_status_0) != 0 ||
+         fields::WatchdogExpired::decode(status.charger_flag_0) != 0;
+}
+
+bool status_flags_set(const Status &status) {
+  return status.charger_flag_0 != 0 || status.charger_flag_1 != 0 || status.fault_flag_0 != 0;
+}
+
+::component_common::ChargerState decode_charger_state(const Status &status) {
+  switch (decode_charge_status(status)) {
+    case ChargeStatus::CHARGING:
+      return ::component_common::ChargerState::FAST_CC;
+    case ChargeStatus::TAPER:
+      return ::component_common::ChargerState::TAPER_CV;
+    case ChargeStatus::TOPOFF:
+      return ::component_common::ChargerState::TOPOFF;
+    case ChargeStatus::NOT_CHARGING:
+    default:
+      break;
+  }
+  if (charge_enabled(status) && !hiz_enabled(status) && power_good(status) && !charger_fault_active(status)) {
+    return ::component_common::ChargerState::TERMINATION_DONE;
+  }
+  return ::component_common::ChargerState::NOT_CHARGING;
+}
+
+::component_common::ChargerSnapshot make_charger_snapshot(
+    const Status &status, const Measurements &measurements, uint32_t timestamp_ms) {
+  ::component_common::ChargerSnapshot snapshot{};
+  snapshot.timestamp_ms = timestamp_ms;
+  snapshot.current_a = measurements.ibat_a;
+  snapshot.voltage_v = measurements.vbat_v;
+  snapshot.state = decode_charger_state(status);
+  snapshot.status_flags = static_cast<uint32_t>(status.charger_status_0) |
+                          (static_cast<uint32_t>(status.charger_status_1) << 8);
+  snapshot.fault_flags = status.fault_status_0;
+  snapshot.enabled = charge_enabled(status);
+  snapshot.power_good = power_good(status);
+  snapshot.fault_active = charger_fault_active(status);
+  snapshot.valid = REGISTER_U16_BYTE_ORDER_CONFIRMED && std::isfinite(snapshot.current_a) &&
+                   std::isfinite(snapshot.voltage_v);
+  return snapshot;
+}
+
+const char *charge_status_to_string(ChargeStatus charge_status) {
+  switch (charge_status) {
+    case ChargeStatus::NOT_CHARGING:
+      return "not_charging";
+    case ChargeStatus::CHARGING:
+      return "charging";
+    case ChargeStatus::TAPER:
+      return "taper_cv";
+    case ChargeStatus::TOPOFF:
+      return "topoff";
+    default:
+      return "unknown";
+  }
+}
+
+const char *vbus_status_to_string(uint8_t vbus_status) {
+  switch (vbus_status) {
+    case 0:
+      return "none";
+    case 4:
+      return "unknown_adapter";
+    default:
+      return "reserved";
+  }
+}
+
+const char *ts_status_to_string(uint8_t ts_status) {
+  switch (ts_status) {
+    case 0:
+      return "normal";
+    case 1:
+      return "cold";
+    case 2:
+      return "hot";
+    case 3:
+      return "cool";
+    case 4:
+      return "warm";
+    case 5:
+      return "precool";
+    case 6:
+      return "prewarm";
+    default:
+      return "bias_fault";
+  }
+}
+
+size_t format_faults(const Status &status, char *buffer, size_t size) {
+  if (buffer == nullptr || size == 0) {
+    return 0;
+  }
+  buffer[0] = '\0';
+  size_t length = 0;
+  const uint8_t ts_status = decode_ts_status(status);
+  const struct {
+    bool active;
+    const char *name;
+  } entries[] = {
+      {fields::VbusFault::decode(status.fault_status_0) != 0, "vbus_overvoltage"},
+      {fields::BatteryFault::decode(status.fault_status_0) != 0, "battery_fault"},
+      {fields::SystemFault::decode(status.fault_status_0) != 0, "system_fault"},
+      {fields::ThermalShutdown::decode(status.fault_status_0) != 0, "thermal_shutdown"},
+      {fields::SafetyTimerExpired::decode(status.charger_status_0) != 0, "safety_timer"},
+      {ts_status == TS_STATUS_COLD, "ts_cold"},
+      {ts_status == TS_STATUS_HOT, "ts_hot"},
+      {ts_status == TS_STATUS_BIAS_FAULT, "ts_bias"},
+  };
+  for (const auto &entry : entries) {
+    if (entry.active && !append_text(buffer, size, length, entry.name)) {
+      return length;
+    }
+  }
+  if (length == 0) {
+    append_text(buffer, size, length, "none");
+  }
+  return length;
+}
+
+uint16_t encode_charge_current_limit_ma(uint16_t ma) {
+  const uint16_t clamped = clamp_u16(ma, CHARGE_CURRENT_MIN_MA, CHARGE_CURRENT_MAX_MA);
+  return fields::ChargeCurrentLimit::encode(static_cast<uint16_t>(clamped / CHARGE_CURRENT_LSB_MA));
+}
+
+uint16_t encode_charge_voltage_limit_mv(uint16_t mv) {
+  const uint16_t clamped = clamp_u16(mv, CHARGE_VOLTAGE_MIN_MV, CHARGE_VOLTAGE_MAX_MV);
+  return fields::ChargeVoltageLimit::encode(static_cast<uint16_t>(clamped / CHARGE_VOLTAGE_LSB_MV));
+}
+
+uint16_t encode_input_current_limit_ma(uint16_t ma) {
+  const uint16_t clamped = clamp_u16(ma, INPUT_CURRENT_MIN_MA, INPUT_CURRENT_MAX_MA);
+  return fields::InputCurrentLimit::encode(static_cast<uint16_t>(clamped / INPUT_CURRENT_LSB_MA));
+}
+
+uint16_t encode_input_voltage_limit_mv(uint16_t mv) {
+  const uint16_t clamped = clamp_u16(mv, INPUT_VOLTAGE_MIN_MV, INPUT_VOLTAGE_MAX_MV);
+  return fields::InputVoltageLimit::encode(static_cast<uint16_t>(clamped / INPUT_VOLTAGE_LSB_MV));
+}
+
 }  // namespace bq25628_core
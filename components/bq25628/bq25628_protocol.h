@@ -1,16 +1,119 @@
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 
 #include "bq25628_registers.h"
+#include "../component_common/charger.h"
 
 namespace bq25628_core {
 
+// Protocol owns interpretation of register values: physical scaling,
+// encoders/decoders, typed status and measurements, and charger snapshots.
+// Raw addresses, masks, and fields belong to bq25628_registers.h.
+
 static constexpr uint8_t BQ25628E_PART_NUMBER = 0x04;
 static constexpr float VBAT_ADC_LSB_V = 0.00199f;
+static constexpr float VSYS_ADC_LSB_V = 0.00199f;
+static constexpr float VBUS_ADC_LSB_V = 0.00397f;
+static constexpr float VPMID_ADC_LSB_V = 0.00397f;
+static constexpr float IBUS_ADC_LSB_A = 0.002f;
+static constexpr float IBAT_ADC_LSB_A = 0.002f;
+static constexpr float TS_ADC_LSB_PERCENT = 0.0961f;
+static constexpr float TDIE_ADC_LSB_C = 0.5f;
+
+// Limit encodings: LSB and the datasheet range of each field.
+static constexpr uint16_t CHARGE_CURRENT_LSB_MA = 40;
+static constexpr uint16_t CHARGE_CURRENT_MIN_MA = 40;
+static constexpr uint16_t CHARGE_CURRENT_MAX_MA = 2000;
+static constexpr uint16_t CHARGE_VOLTAGE_LSB_MV = 10;
+static constexpr uint16_t CHARGE_VOLTAGE_MIN_MV = 3500;
+static constexpr uint16_t CHARGE_VOLTAGE_MAX_MV = 4800;
+static constexpr uint16_t INPUT_CURRENT_LSB_MA = 20;
+static constexpr uint16_t INPUT_CURRENT_MIN_MA = 100;
+static constexpr uint16_t INPUT_CURRENT_MAX_MA = 3200;
+static constexpr uint16_t INPUT_VOLTAGE_LSB_MV = 40;
+static constexpr uint16_t INPUT_VOLTAGE_MIN_MV = 3800;
+static constexpr uint16_t INPUT_VOLTAGE_MAX_MV = 16800;
+
+// REG0x16 WATCHDOG codes.
+static constexpr uint8_t WATCHDOG_DISABLED = 0;
+static constexpr uint8_t WATCHDOG_50S = 1;
+
+// REG0x1E CHG_STAT. CHARGING covers trickle, precharge and fast charge.
+enum class ChargeStatus : uint8_t {
+  NOT_CHARGING = 0,
+  CHARGING = 1,
+  TAPER = 2,
+  TOPOFF = 3,
+};
+
+// REG0x16 and REG0x1D..0x22 as one burst; reading clears the three flag
+// registers.
+struct Status {
+  uint8_t charger_control_0{0};
+  uint8_t charger_status_0{0};
+  uint8_t charger_status_1{0};
+  uint8_t fault_status_0{0};
+  uint8_t charger_flag_0{0};
+  uint8_t charger_flag_1{0};
+  uint8_t fault_flag_0{0};
+};
+
+// REG0x28..0x37 in volts, amps, percent of REGN and degrees Celsius.
+struct Measurements {
+  float ibus_a{0.0f};
+  float ibat_a{0.0f};
+  float vbus_v{0.0f};
+  float vpmid_v{0.0f};
+  float vbat_v{0.0f};
+  float vsys_v{0.0f};
+  float ts_percent{0.0f};
+  float tdie_c{0.0f};
+};
 
 bool is_bq25628e(uint8_t part_information);
 uint8_t enable_adc(uint8_t adc_control);
+// 16-bit registers are transferred most significant byte first. That order
+// is inferred from the VBAT decode and has not been confirmed against the
+// BQ25628E datasheet.
+uint16_t load_register_u16(const uint8_t *raw);
+void store_register_u16(uint16_t value, uint8_t *raw);
+// Until the order is confirmed, ADC-derived battery current and voltage are
+// not trusted as a charger measurement: make_charger_snapshot() never marks a
+// snapshot valid and the component does not advertise either capability.
+inline constexpr bool REGISTER_U16_BYTE_ORDER_CONFIRMED = false;
 float decode_battery_voltage_v(uint16_t vbat_adc_raw_be);
+// `block` holds REG0x28..0x37.
+Measurements decode_measurements(const uint8_t *block);
+
+ChargeStatus decode_charge_status(const Status &status);
+uint8_t decode_vbus_status(const Status &status);
+uint8_t decode_ts_status(const Status &status);
+bool charge_enabled(const Status &status);
+bool hiz_enabled(const Status &status);
+// The BQ25628E has no PG_STAT bit: input is good while VBUS_STAT reports an
+// adapter and no VBUS fault is latched.
+bool power_good(const Status &status);
+bool charger_fault_active(const Status &status);
+bool watchdog_expired(const Status &status);
+bool status_flags_set(const Status &status);
+// CHG_STAT cannot tell "terminated" from "not charging"; with charging
+// enabled, input good and no fault, not charging means termination.
+::component_common::ChargerState decode_charger_state(const Status &status);
+::component_common::ChargerSnapshot make_charger_snapshot(
+    const Status &status, const Measurements &measurements, uint32_t timestamp_ms);
+
+const char *charge_status_to_string(ChargeStatus charge_status);
+const char *vbus_status_to_string(uint8_t vbus_status);
+const char *ts_status_to_string(uint8_t ts_status);
+// Comma-delimited names of the active faults, "none" without any. Returns
+// the length written, truncated to fit `size`.
+size_t format_faults(const Status &status, char *buffer, size_t size);
+
+uint16_t encode_charge_current_limit_ma(uint16_t ma);
+uint16_t encode_charge_voltage_limit_mv(uint16_t mv);
+uint16_t encode_input_current_limit_ma(uint16_t ma);
+uint16_t encode_input_voltage_limit_mv(uint16_t mv);
 
 }  // namespace bq25628_core
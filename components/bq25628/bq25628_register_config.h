@@ -0,0 +1,114 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "bq25628_registers.h"
+
+namespace bq25628_core {
+
+// Desired values for every register with configuration-owned bits. The
+// component starts from the values read back at setup and overlays its YAML
+// settings, so these defaults only fix the layout.
+struct Bq25628RegisterConfig {
+  uint16_t charge_current_limit{0};
+  uint16_t charge_voltage_limit{0};
+  uint16_t input_current_limit{0};
+  uint16_t input_voltage_limit{0};
+  uint16_t minimal_system_voltage{0};
+  uint8_t precharge_control{0};
+  uint8_t termination_control{0};
+  uint8_t charge_control{0};
+  uint8_t charge_timer_control{0};
+  uint8_t charger_control_0{0};
+  uint8_t charger_control_1{0};
+  uint8_t charger_control_2{0};
+  uint8_t charger_control_3{0};
+  uint8_t ntc_control_0{0};
+  uint8_t ntc_control_1{0};
+  uint8_t ntc_control_2{0};
+  uint8_t charger_mask_0{0};
+  uint8_t charger_mask_1{0};
+  uint8_t fault_mask_0{0};
+  uint8_t adc_control{0};
+  uint8_t adc_function_disable_0{0};
+};
+
+using Bq25628RegisterConfigImage =
+    std::array<component_common::RegisterImageEntry, CONFIGURATION_REGISTER_COUNT>;
+
+constexpr component_common::RegisterImageEntry config_image_entry(RegisterId id, uint32_t value) {
+  const auto &info = register_info(id);
+  return {
+      .name = info.name,
+      .address = info.address,
+      .width = static_cast<uint8_t>(info.width),
+      .value = value,
+      .mask = info.masks.configuration,
+      .command_mask = info.masks.command,
+  };
+}
+
+// Entries are in address order so the image splits into burst runs.
+constexpr Bq25628RegisterConfigImage make_register_config_image(const Bq25628RegisterConfig &config) {
+  return {{
+      config_image_entry(RegisterId::CHARGE_CURRENT_LIMIT, config.charge_current_limit),
+      config_image_entry(RegisterId::CHARGE_VOLTAGE_LIMIT, config.charge_voltage_limit),
+      config_image_entry(RegisterId::INPUT_CURRENT_LIMIT, config.input_current_limit),
+      config_image_entry(RegisterId::INPUT_VOLTAGE_LIMIT, config.input_voltage_limit),
+      config_image_entry(RegisterId::MINIMAL_SYSTEM_VOLTAGE, config.minimal_system_voltage),
+      config_image_entry(RegisterId::PRECHARGE_CONTROL, config.precharge_control),
+      config_image_entry(RegisterId::TERMINATION_CONTROL, config.termination_control),
+      config_image_entry(RegisterId::CHARGE_CONTROL, config.charge_control),
+      config_image_entry(RegisterId::CHARGE_TIMER_CONTROL, config.charge_timer_control),
+      config_image_entry(RegisterId::CHARGER_CONTROL_0, config.charger_control_0),
+      config_image_entry(RegisterId::CHARGER_CONTROL_1, config.charger_control_1),
+      config_image_entry(RegisterId::CHARGER_CONTROL_2, config.charger_control_2),
+      config_image_entry(RegisterId::CHARGER_CONTROL_3, config.charger_control_3),
+      config_image_entry(RegisterId::NTC_CONTROL_0, config.ntc_control_0),
+      config_image_entry(RegisterId::NTC_CONTROL_1, config.ntc_control_1),
+      config_image_entry(RegisterId::NTC_CONTROL_2, config.ntc_control_2),
+      config_image_entry(RegisterId::CHARGER_MASK_0, config.charger_mask_0),
+      config_image_entry(RegisterId::CHARGER_MASK_1, config.charger_mask_1),
+      config_image_entry(RegisterId::FAULT_MASK_0, config.fault_mask_0),
+      config_image_entry(RegisterId::ADC_CONTROL, config.adc_control),
+      config_image_entry(RegisterId::ADC_FUNCTION_DISABLE_0, config.adc_function_disable_0),
+  }};
+}
+
+// Fills `config` from an image of the same layout, e.g. one read back from
+// the charger.
+constexpr Bq25628RegisterConfig register_config_from_values(const Bq25628RegisterConfigImage &image) {
+  Bq25628RegisterConfig config{};
+  size_t index = 0;
+  config.charge_current_limit = static_cast<uint16_t>(image[index++].value);
+  config.charge_voltage_limit = static_cast<uint16_t>(image[index++].value);
+  config.input_current_limit = static_cast<uint16_t>(image[index++].value);
+  config.input_voltage_limit = static_cast<uint16_t>(image[index++].value);
+  config.minimal_system_voltage = static_cast<uint16_t>(image[index++].value);
+  config.precharge_control = static_cast<uint8_t>(image[index++].value);
+  config.termination_control = static_cast<uint8_t>(image[index++].value);
+  config.charge_control = static_cast<uint8_t>(image[index++].value);
+  config.charge_timer_control = static_cast<uint8_t>(image[index++].value);
+  config.charger_control_0 = static_cast<uint8_t>(image[index++].value);
+  config.charger_control_1 = static_cast<uint8_t>(image[index++].value);
+  config.charger_control_2 = static_cast<uint8_t>(image[index++].value);
+  config.charger_control_3 = static_cast<uint8_t>(image[index++].value);
+  config.ntc_control_0 = static_cast<uint8_t>(image[index++].value);
+  config.ntc_control_1 = static_cast<uint8_t>(image[index++].value);
+  config.ntc_control_2 = static_cast<uint8_t>(image[index++].value);
+  config.charger_mask_0 = static_cast<uint8_t>(image[index++].value);
+  config.charger_mask_1 = static_cast<uint8_t>(image[index++].value);
+  config.fault_mask_0 = static_cast<uint8_t>(image[index++].value);
+  config.adc_control = static_cast<uint8_t>(image[index++].value);
+  config.adc_function_disable_0 = static_cast<uint8_t>(image[index++].value);
+  return config;
+}
+
+static constexpr auto REGISTER_CONFIG_LAYOUT = make_register_config_image(Bq25628RegisterConfig{});
+
+static_assert(component_common::configuration_image_layout_complete(REGISTER_MANIFEST, REGISTER_CONFIG_LAYOUT),
+              "BQ25628 register config must own every configurable register");
+
+}  // namespace bq25628_core
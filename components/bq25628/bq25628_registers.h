@@ -66,7 +66,8 @@ struct RegisterInfo {
 
 static constexpr size_t REGISTER_COUNT = static_cast<size_t>(RegisterId::COUNT);
 
-// All writable fields are configuration except self-clearing commands. Status
+// Writable fields are configuration except self-clearing commands and the
+// EN_CHG/EN_HIZ runtime controls, which the configuration image leaves alone. Status
 // and ADC fields are read-only telemetry. Reserved bits are explicit so a
 // manifest check catches omissions and accidental overlaps.
 static constexpr std::array<RegisterInfo, REGISTER_COUNT> REGISTER_DEFINITIONS{{
@@ -79,7 +80,7 @@ static constexpr std::array<RegisterInfo, REGISTER_COUNT> REGISTER_DEFINITIONS{{
     {.id = RegisterId::TERMINATION_CONTROL, .name = "termination_control", .address = 0x12, .width = RegisterWidth::U8, .masks = {.configuration = 0xFC, .reserved = 0x03}},
     {.id = RegisterId::CHARGE_CONTROL, .name = "charge_control", .address = 0x14, .width = RegisterWidth::U8, .masks = {.configuration = 0xFF}},
     {.id = RegisterId::CHARGE_TIMER_CONTROL, .name = "charge_timer_control", .address = 0x15, .width = RegisterWidth::U8, .masks = {.configuration = 0x8F, .reserved = 0x70}},
-    {.id = RegisterId::CHARGER_CONTROL_0, .name = "charger_control_0", .address = 0x16, .width = RegisterWidth::U8, .masks = {.configuration = 0xFB, .command = 0x04}},
+    {.id = RegisterId::CHARGER_CONTROL_0, .name = "charger_control_0", .address = 0x16, .width = RegisterWidth::U8, .masks = {.configuration = 0xCB, .runtime = 0x30, .command = 0x04}},
     {.id = RegisterId::CHARGER_CONTROL_1, .name = "charger_control_1", .address = 0x17, .width = RegisterWidth::U8, .masks = {.configuration = 0x7D, .command = 0x80, .reserved = 0x02}},
     {.id = RegisterId::CHARGER_CONTROL_2, .name = "charger_control_2", .address = 0x18, .width = RegisterWidth::U8, .masks = {.configuration = 0x1F, .reserved = 0xE0}},
     {.id = RegisterId::CHARGER_CONTROL_3, .name = "charger_control_3", .address = 0x19, .width = RegisterWidth::U8, .masks = {.configuration = 0xE7, .reserved = 0x18}},
@@ -149,12 +150,67 @@ constexpr std::array<RegisterManifestEntry, REGISTER_COUNT> make_register_manife
 
 static constexpr auto REGISTER_MANIFEST = make_register_manifest();
 
+constexpr size_t configuration_register_count() {
+  size_t count = 0;
+  for (const auto &info : REGISTER_INFO)
+    if (info.masks.configuration != 0)
+      count++;
+  return count;
+}
+
+static constexpr size_t CONFIGURATION_REGISTER_COUNT = configuration_register_count();
+
 static_assert(register_definitions_have_all_ids_once(), "BQ25628 register IDs must be complete and unique");
 static_assert(component_common::register_manifest_valid(REGISTER_MANIFEST), "BQ25628 register manifest must be complete");
 
 namespace fields {
+// Limit registers.
+using ChargeCurrentLimit = component_common::RegisterField<uint16_t, 0x07E0>;
+using ChargeVoltageLimit = component_common::RegisterField<uint16_t, 0x0FF8>;
+using InputCurrentLimit = component_common::RegisterField<uint16_t, 0x0FF0>;
+using InputVoltageLimit = component_common::RegisterField<uint16_t, 0x3FE0>;
+
+// REG0x16 Charger_Control_0.
+using ChargeEnable = component_common::RegisterField<uint8_t, 0x20>;
+using HizEnable = component_common::RegisterField<uint8_t, 0x10>;
+using WatchdogReset = component_common::RegisterField<uint8_t, 0x04>;
+using Watchdog = component_common::RegisterField<uint8_t, 0x03>;
+
+// REG0x1D..0x1F status, and the matching clear-on-read flags REG0x20..0x22.
+using AdcDone = component_common::RegisterField<uint8_t, 0x40>;
+using ThermalRegulation = component_common::RegisterField<uint8_t, 0x20>;
+using SystemRegulation = component_common::RegisterField<uint8_t, 0x10>;
+using InputCurrentDpm = component_common::RegisterField<uint8_t, 0x08>;
+using InputVoltageDpm = component_common::RegisterField<uint8_t, 0x04>;
+using SafetyTimerExpired = component_common::RegisterField<uint8_t, 0x02>;
+using WatchdogExpired = component_common::RegisterField<uint8_t, 0x01>;
+using ChargeStatus = component_common::RegisterField<uint8_t, 0x18>;
+using VbusStatus = component_common::RegisterField<uint8_t, 0x07>;
+using ChargeStatusChanged = component_common::RegisterField<uint8_t, 0x08>;
+using VbusStatusChanged = component_common::RegisterField<uint8_t, 0x01>;
+using VbusFault = component_common::RegisterField<uint8_t, 0x80>;
+using BatteryFault = component_common::RegisterField<uint8_t, 0x40>;
+using SystemFault = component_common::RegisterField<uint8_t, 0x20>;
+using ThermalShutdown = component_common::RegisterField<uint8_t, 0x08>;
+using TsStatus = component_common::RegisterField<uint8_t, 0x07>;
+
+// REG0x26 ADC_Control.
 using AdcEnable = component_common::RegisterField<uint8_t, 0x80>;
+using AdcOneShot = component_common::RegisterField<uint8_t, 0x40>;
+using AdcSample = component_common::RegisterField<uint8_t, 0x30>;
+using AdcAverage = component_common::RegisterField<uint8_t, 0x08>;
+
+// ADC results. IBUS/IBAT are two's complement across the whole register and
+// TDIE across its 12-bit field.
+using BusCurrentAdc = component_common::RegisterField<uint16_t, 0xFFFE>;
+using BatteryCurrentAdc = component_common::RegisterField<uint16_t, 0xFFFE>;
+using BusVoltageAdc = component_common::RegisterField<uint16_t, 0x3FFE>;
+using PmidVoltageAdc = component_common::RegisterField<uint16_t, 0x3FFE>;
 using BatteryVoltageAdc = component_common::RegisterField<uint16_t, 0x1FFE>;
+using SystemVoltageAdc = component_common::RegisterField<uint16_t, 0x1FFE>;
+using TsAdc = component_common::RegisterField<uint16_t, 0x0FFF>;
+using DieTemperatureAdc = component_common::RegisterField<uint16_t, 0x0FFF>;
+
 using PartNumber = component_common::RegisterField<uint8_t, 0x38>;
 }  // namespace fields
 
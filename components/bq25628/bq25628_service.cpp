@@ -2,6 +2,45 @@
 
 namespace bq25628_core {
 
+namespace {
+
+// Reading on through the six configuration registers after REG0x16 lets one
+// 13-byte burst carry the charge-enable state, status and flags.
+constexpr uint8_t STATUS_BLOCK_BASE = register_address(RegisterId::CHARGER_CONTROL_0);
+constexpr size_t STATUS_BLOCK_LEN = register_address(RegisterId::FAULT_FLAG_0) - STATUS_BLOCK_BASE + 1;
+constexpr size_t ADC_BLOCK_LEN =
+    register_address(RegisterId::TDIE_ADC) + 2 - register_address(RegisterId::IBUS_ADC);
+static_assert(STATUS_BLOCK_LEN == 13);
+static_assert(ADC_BLOCK_LEN == 16);
+
+constexpr size_t status_offset(RegisterId id) { return register_address(id) - STATUS_BLOCK_BASE; }
+
+// The register-config layout is fixed, so its burst plan is too: five runs,
+// the longest REG0x14..0x1C. Reserved gaps between runs are never accessed.
+constexpr size_t CONFIG_BURST_MAX_LEN = 16;
+constexpr auto CONFIG_BURSTS = component_common::plan_register_image_bursts(REGISTER_CONFIG_LAYOUT, CONFIG_BURST_MAX_LEN);
+static_assert(CONFIG_BURSTS.count == 5, "BQ25628 register config should read in five bursts");
+
+uint32_t load_value(const uint8_t *raw, uint8_t width) {
+  return width == 2 ? load_register_u16(raw) : raw[0];
+}
+
+void store_value(uint32_t value, uint8_t width, uint8_t *raw) {
+  if (width == 2) {
+    store_register_u16(static_cast<uint16_t>(value), raw);
+  } else {
+    raw[0] = static_cast<uint8_t>(value);
+  }
+}
+
+// The 16-bit limit registers' byte order has not been confirmed against the
+// BQ25628E datasheet, so reconcile only compares them. A burst that shares
+// a run with one writes back the value it just read; load_value() and
+// store_value() are inverses, so that round trip holds whatever the order.
+bool is_read_only_entry(const component_common::RegisterImageEntry &entry) { return entry.width == 2; }
+
+}  // namespace
+
 bool Bq25628Service::probe() {
   uint8_t part_information;
   return this->read_byte_(RegisterId::PART_INFORMATION, part_information) &&
@@ -22,8 +61,194 @@ bool Bq25628Service::read_battery_voltage_v(float &voltage_v) {
   if (!this->read_bytes_(RegisterId::VBAT_ADC, raw, sizeof(raw)))
     return false;
 
-  const uint16_t raw_be = (static_cast<uint16_t>(raw[0]) << 8) | raw[1];
-  voltage_v = decode_battery_voltage_v(raw_be);
+  voltage_v = decode_battery_voltage_v(load_register_u16(raw));
+  return true;
+}
+
+bool Bq25628Service::read_status(Status &status) {
+  uint8_t block[STATUS_BLOCK_LEN];
+  if (!this->read_bytes_(STATUS_BLOCK_BASE, block, sizeof(block))) {
+    this->charger_control_0_known_ = false;
+    this->invalidate_configuration();
+    return false;
+  }
+
+  status.charger_control_0 = block[status_offset(RegisterId::CHARGER_CONTROL_0)];
+  status.charger_status_0 = block[status_offset(RegisterId::CHARGER_STATUS_0)];
+  status.charger_status_1 = block[status_offset(RegisterId::CHARGER_STATUS_1)];
+  status.fault_status_0 = block[status_offset(RegisterId::FAULT_STATUS_0)];
+  status.charger_flag_0 = block[status_offset(RegisterId::CHARGER_FLAG_0)];
+  status.charger_flag_1 = block[status_offset(RegisterId::CHARGER_FLAG_1)];
+  status.fault_flag_0 = block[status_offset(RegisterId::FAULT_FLAG_0)];
+  this->charger_control_0_ = status.charger_control_0;
+  this->charger_control_0_known_ = true;
+  // Watchdog expiry returns the charger registers to their reset values. The
+  // status bit stays set until the next reset, so only its flag or rising
+  // edge triggers re-verification.
+  const bool expired = fields::WatchdogExpired::decode(status.charger_status_0) != 0;
+  if (fields::WatchdogExpired::decode(status.charger_flag_0) != 0 || (expired && !this->last_watchdog_expired_)) {
+    this->invalidate_configuration();
+  }
+  this->last_watchdog_expired_ = expired;
+  return true;
+}
+
+bool Bq25628Service::read_measurements(Measurements &measurements) {
+  uint8_t block[ADC_BLOCK_LEN];
+  if (!this->read_bytes_(RegisterId::IBUS_ADC, block, sizeof(block)))
+    return false;
+
+  measurements = decode_measurements(block);
+  return true;
+}
+
+bool Bq25628Service::set_charge_enabled(bool enabled) {
+  uint8_t control;
+  if (!this->read_byte_(RegisterId::CHARGER_CONTROL_0, control)) {
+    this->charger_control_0_known_ = false;
+    return false;
+  }
+
+  control = fields::WatchdogReset::replace(control, 0);
+  const uint8_t requested = fields::ChargeEnable::replace(control, enabled ? 1 : 0);
+  if (requested != control && !this->write_byte_(RegisterId::CHARGER_CONTROL_0, requested)) {
+    this->charger_control_0_known_ = false;
+    return false;
+  }
+  this->charger_control_0_ = requested;
+  this->charger_control_0_known_ = true;
+  return true;
+}
+
+bool Bq25628Service::reset_watchdog() {
+  if (!this->charger_control_0_known_ &&
+      !this->read_byte_(RegisterId::CHARGER_CONTROL_0, this->charger_control_0_)) {
+    return false;
+  }
+  this->charger_control_0_known_ = true;
+  return this->write_byte_(RegisterId::CHARGER_CONTROL_0, fields::WatchdogReset::replace(this->charger_control_0_, 1));
+}
+
+bool Bq25628Service::read_register_config(Bq25628RegisterConfig &config) {
+  std::array<uint32_t, CONFIGURATION_REGISTER_COUNT> values{};
+  for (size_t burst = 0; burst < CONFIG_BURSTS.count; burst++) {
+    if (!this->read_config_values_(REGISTER_CONFIG_LAYOUT, burst, values))
+      return false;
+  }
+
+  auto image = REGISTER_CONFIG_LAYOUT;
+  for (size_t index = 0; index < image.size(); index++)
+    image[index].value = values[index];
+  config = register_config_from_values(image);
+  return true;
+}
+
+bool Bq25628Service::reconcile_configuration(const Bq25628RegisterConfigImage &image, bool repair,
+                                             ConfigurationReconcileResult &result) {
+  result = {};
+  result.desired_fingerprint = component_common::configuration_fingerprint(image);
+  std::array<uint32_t, CONFIGURATION_REGISTER_COUNT> values{};
+  std::array<bool, CONFIGURATION_REGISTER_COUNT> mismatched{};
+
+  for (size_t burst = 0; burst < CONFIG_BURSTS.count; burst++) {
+    if (!this->read_config_values_(image, burst, values)) {
+      result.io_ok = false;
+      result.matches = false;
+      this->invalidate_configuration();
+      return false;
+    }
+  }
+  for (size_t index = 0; index < image.size(); index++) {
+    if (component_common::register_value_matches(values[index], image[index].value, image[index].mask))
+      continue;
+    if (is_read_only_entry(image[index])) {
+      result.read_only_mismatch_count++;
+      continue;
+    }
+    if (result.mismatch_count == 0)
+      result.first_mismatch_address = image[index].address;
+    mismatched[index] = true;
+    result.mismatch_count++;
+    result.matches = false;
+  }
+
+  if (repair && result.mismatch_count != 0) {
+    for (size_t burst_index = 0; burst_index < CONFIG_BURSTS.count; burst_index++) {
+      const auto &burst = CONFIG_BURSTS.bursts[burst_index];
+      bool dirty = false;
+      uint8_t raw[CONFIG_BURST_MAX_LEN] = {};
+      size_t offset = 0;
+      for (size_t entry = burst.first_entry; entry < burst.first_entry + burst.entry_count; entry++) {
+        uint32_t value = values[entry];
+        if (mismatched[entry]) {
+          value = component_common::merge_register_value(value, image[entry].value, image[entry].mask);
+          dirty = true;
+          result.repaired_count++;
+        }
+        value &= ~image[entry].command_mask;
+        store_value(value, image[entry].width, raw + offset);
+        offset += image[entry].width;
+      }
+      if (!dirty)
+        continue;
+      if (!this->write_bytes_(static_cast<uint8_t>(burst.address), raw, burst.length) ||
+          !this->read_config_values_(image, burst_index, values)) {
+        result.io_ok = false;
+        result.matches = false;
+        this->invalidate_configuration();
+        return false;
+      }
+    }
+    result.repaired = true;
+    // The repaired runs may hold REG0x16; its cached value is stale.
+    this->charger_control_0_known_ = false;
+
+    result.matches = true;
+    for (size_t index = 0; index < image.size(); index++) {
+      if (is_read_only_entry(image[index]))
+        continue;
+      if (!component_common::register_value_matches(values[index], image[index].value, image[index].mask)) {
+        result.matches = false;
+        result.remaining_mismatch_count++;
+      }
+    }
+  }
+
+  result.observed_fingerprint = component_common::FNV1A_OFFSET_BASIS;
+  for (size_t index = 0; index < image.size(); index++) {
+    result.observed_fingerprint =
+        component_common::fingerprint_register_value(result.observed_fingerprint, image[index], values[index]);
+  }
+  this->configuration_verified_ = result.matches;
+  this->verified_fingerprint_ = result.desired_fingerprint;
+  return result.matches;
+}
+
+bool Bq25628Service::ensure_configuration(const Bq25628RegisterConfigImage &image,
+                                          ConfigurationReconcileResult &result) {
+  const uint32_t desired = component_common::configuration_fingerprint(image);
+  if (this->configuration_verified_ && this->verified_fingerprint_ == desired) {
+    result = {};
+    result.skipped = true;
+    result.desired_fingerprint = desired;
+    result.observed_fingerprint = desired;
+    return true;
+  }
+  return this->reconcile_configuration(image, true, result);
+}
+
+bool Bq25628Service::read_config_values_(const Bq25628RegisterConfigImage &image, size_t burst_index,
+                                         std::array<uint32_t, CONFIGURATION_REGISTER_COUNT> &values) {
+  const auto &burst = CONFIG_BURSTS.bursts[burst_index];
+  uint8_t raw[CONFIG_BURST_MAX_LEN];
+  if (!this->read_bytes_(static_cast<uint8_t>(burst.address), raw, burst.length))
+    return false;
+
+  size_t offset = 0;
+  for (size_t entry = burst.first_entry; entry < burst.first_entry + burst.entry_count; entry++) {
+    values[entry] = load_value(raw + offset, image[entry].width);
+    offset += image[entry].width;
+  }
   return true;
 }
 
@@ -32,13 +257,19 @@ bool Bq25628Service::read_byte_(RegisterId reg, uint8_t &value) {
 }
 
 bool Bq25628Service::read_bytes_(RegisterId reg, uint8_t *data, size_t len) {
-  return this->bus_ != nullptr &&
-         this->bus_->read_registers(register_address(reg), data, len);
+  return this->read_bytes_(register_address(reg), data, len);
+}
+
+bool Bq25628Service::read_bytes_(uint8_t address, uint8_t *data, size_t len) {
+  return this->bus_ != nullptr && this->bus_->read_registers(address, data, len);
 }
 
 bool Bq25628Service::write_byte_(RegisterId reg, uint8_t value) {
-  return this->bus_ != nullptr &&
-         this->bus_->write_registers(register_address(reg), &value, 1);
+  return this->write_bytes_(register_address(reg), &value, 1);
+}
+
+bool Bq25628Service::write_bytes_(uint8_t address, const uint8_t *data, size_t len) {
+  return this->bus_ != nullptr && this->bus_->write_registers(address, data, len);
 }
 
 }  // namespace bq25628_core
@@ -1,24 +1,80 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
 #include "bq25628_bus.h"
 #include "bq25628_protocol.h"
+#include "bq25628_register_config.h"
 
 namespace bq25628_core {
 
+struct ConfigurationReconcileResult {
+  bool io_ok{true};
+  bool matches{true};
+  bool repaired{false};
+  // True when a verified fingerprint let ensure_configuration() skip the bus.
+  bool skipped{false};
+  size_t mismatch_count{0};
+  size_t repaired_count{0};
+  size_t remaining_mismatch_count{0};
+  // 16-bit limit registers that differ from the image. They are compared
+  // but never written until their byte order is confirmed, so they do not
+  // count towards mismatch_count or clear matches.
+  size_t read_only_mismatch_count{0};
+  uint16_t first_mismatch_address{0};
+  uint32_t desired_fingerprint{0};
+  uint32_t observed_fingerprint{0};
+};
+
 class Bq25628Service {
  public:
   explicit Bq25628Service(RegisterBus *bus) : bus_(bus) {}
 
   bool probe();
   bool enable_adc();
- bool read_battery_voltage_v(float &voltage_v);
+  bool read_battery_voltage_v(float &voltage_v);
+
+  // REG0x16 and REG0x1D..0x22 in one burst, clearing the flags. A watchdog
+  // expiry or read error marks the configuration for re-verification.
+  bool read_status(Status &status);
+  // Every ADC result, REG0x28..0x37, in one burst.
+  bool read_measurements(Measurements &measurements);
+  bool set_charge_enabled(bool enabled);
+  // Sets WD_RST on the REG0x16 value from the last status read, so a poll
+  // that already read the status spends one write.
+  bool reset_watchdog();
+
+  // Reads every configuration register, one burst per address run.
+  bool read_register_config(Bq25628RegisterConfig &config);
+  // Compares the configuration bits of every image register and, with
+  // `repair`, rewrites each burst run that holds a mismatch, keeping the
+  // runtime bits just read, then reads those runs back to verify.
+  bool reconcile_configuration(const Bq25628RegisterConfigImage &image, bool repair,
+                               ConfigurationReconcileResult &result);
+  // Reconcile with repair, skipped without bus traffic while the image's
+  // fingerprint is the one last verified and nothing has invalidated it.
+  bool ensure_configuration(const Bq25628RegisterConfigImage &image, ConfigurationReconcileResult &result);
+  // Call after any event that may have reset the charger registers.
+  void invalidate_configuration() { this->configuration_verified_ = false; }
+  bool configuration_verified() const { return this->configuration_verified_; }
 
  private:
   bool read_byte_(RegisterId reg, uint8_t &value);
   bool read_bytes_(RegisterId reg, uint8_t *data, size_t len);
+  bool read_bytes_(uint8_t address, uint8_t *data, size_t len);
   bool write_byte_(RegisterId reg, uint8_t value);
+  bool write_bytes_(uint8_t address, const uint8_t *data, size_t len);
+  bool read_config_values_(const Bq25628RegisterConfigImage &image, size_t burst,
+                           std::array<uint32_t, CONFIGURATION_REGISTER_COUNT> &values);
 
   RegisterBus *bus_{nullptr};
+  bool configuration_verified_{false};
+  uint32_t verified_fingerprint_{0};
+  bool charger_control_0_known_{false};
+  uint8_t charger_control_0_{0};
+  bool last_watchdog_expired_{false};
 };
 
 }  // namespace bq25628_core
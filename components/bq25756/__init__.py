@@ -1,16 +1,26 @@
+import zlib
+
+from esphome import pins
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import button, i2c, number, sensor, switch as switch_, text_sensor
+from esphome.core import CORE
 from esphome.const import (
     CONF_ID,
     DEVICE_CLASS_CURRENT,
+    DEVICE_CLASS_ENERGY,
+    DEVICE_CLASS_POWER,
     DEVICE_CLASS_VOLTAGE,
     ENTITY_CATEGORY_CONFIG,
     ENTITY_CATEGORY_DIAGNOSTIC,
     STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
     UNIT_MILLIAMP,
+    UNIT_MILLISECOND,
     UNIT_MILLIVOLT,
     UNIT_PERCENT,
+    UNIT_WATT,
+    UNIT_WATT_HOURS,
 )
 
 # YAML example:
@@ -34,6 +44,7 @@ from esphome.const import (
 
 DEPENDENCIES = ["i2c"]
 AUTO_LOAD = ["component_common", "button", "number", "sensor", "switch", "text_sensor"]
+MULTI_CONF = True
 
 component_common_ns = cg.global_ns.namespace("component_common")
 ChargerInterface = component_common_ns.class_("ChargerInterface")
@@ -77,6 +88,22 @@ CONF_MEASURED_VOLTAGE = "measured_voltage"
 CONF_CALIBRATE = "calibrate"
 CONF_CALIBRATION_STATUS = "status"
 CONF_CONFIGURATION_STATUS = "configuration_status"
+CONF_RECONFIGURE_LATENCY = "reconfigure_latency"
+CONF_INTERRUPT_PIN = "interrupt_pin"
+CONF_INTERRUPT_LATENCY = "interrupt_latency"
+CONF_TELEMETRY = "telemetry"
+CONF_WINDOW = "window"
+CONF_INPUT_POWER = "input_power"
+CONF_OUTPUT_POWER = "output_power"
+CONF_EFFICIENCY = "efficiency"
+CONF_INPUT_ENERGY = "input_energy"
+CONF_OUTPUT_ENERGY = "output_energy"
+CONF_SUMMARY = "summary"
+CONF_ADC = "adc"
+CONF_MODE = "mode"
+CONF_RESOLUTION = "resolution"
+CONF_AVERAGING = "averaging"
+CONF_CHANNELS = "channels"
 
 CELL_CHEMISTRY_PROFILES = {
     "lithium_ion": {"maximum_cell_voltage": 4.2, "minimum_cell_voltage": 3.0},
@@ -118,12 +145,64 @@ MEASUREMENTS_SCHEMA = cv.Schema(
     }
 )
 
-CONFIG_SCHEMA = (
+ADC_MODES = {"continuous": False, "one_shot": True}
+# Effective bits -> REG2B.ADC_SAMPLE code.
+ADC_RESOLUTIONS = {15: 0, 14: 1, 13: 2}
+# Measurement key -> bq25756_core::ADC_CHANNEL_* bit.
+ADC_CHANNELS = {
+    CONF_INPUT_CURRENT: 0x01,
+    CONF_BATTERY_CURRENT: 0x02,
+    CONF_INPUT_VOLTAGE: 0x04,
+    CONF_BATTERY_VOLTAGE: 0x08,
+    CONF_TEMPERATURE_PERCENT: 0x10,
+}
+
+ADC_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_MODE, default="continuous"): cv.one_of(*ADC_MODES, lower=True),
+        cv.Optional(CONF_RESOLUTION, default=15): cv.one_of(*ADC_RESOLUTIONS, int=True),
+        cv.Optional(CONF_AVERAGING, default=False): cv.boolean,
+        cv.Optional(CONF_CHANNELS, default=list(ADC_CHANNELS)): cv.All(
+            cv.ensure_list(cv.one_of(*ADC_CHANNELS, lower=True)), cv.Length(min=1)
+        ),
+    }
+)
+
+
+def validate_adc_channels(config):
+    channels = config[CONF_ADC][CONF_CHANNELS]
+    for key in config[CONF_MEASUREMENTS]:
+        if key not in channels:
+            raise cv.Invalid(f"measurements.{key} needs '{key}' in adc.channels")
+    if CONF_TELEMETRY in config and not {
+        CONF_INPUT_CURRENT, CONF_INPUT_VOLTAGE, CONF_BATTERY_CURRENT, CONF_BATTERY_VOLTAGE
+    } <= set(channels):
+        raise cv.Invalid("telemetry needs both current and voltage channels in adc.channels")
+    return config
+
+
+# Window-rate aggregates, published once per window instead of per poll.
+TELEMETRY_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_WINDOW, default="60s"): cv.All(
+            cv.positive_time_period_milliseconds, cv.Range(min=cv.TimePeriod(seconds=1))
+        ),
+        cv.Optional(CONF_INPUT_POWER): sensor.sensor_schema(unit_of_measurement=UNIT_WATT, accuracy_decimals=2, device_class=DEVICE_CLASS_POWER, state_class=STATE_CLASS_MEASUREMENT),
+        cv.Optional(CONF_OUTPUT_POWER): sensor.sensor_schema(unit_of_measurement=UNIT_WATT, accuracy_decimals=2, device_class=DEVICE_CLASS_POWER, state_class=STATE_CLASS_MEASUREMENT),
+        cv.Optional(CONF_EFFICIENCY): sensor.sensor_schema(unit_of_measurement=UNIT_PERCENT, accuracy_decimals=1, state_class=STATE_CLASS_MEASUREMENT),
+        cv.Optional(CONF_INPUT_ENERGY): sensor.sensor_schema(unit_of_measurement=UNIT_WATT_HOURS, accuracy_decimals=3, device_class=DEVICE_CLASS_ENERGY, state_class=STATE_CLASS_TOTAL_INCREASING),
+        cv.Optional(CONF_OUTPUT_ENERGY): sensor.sensor_schema(unit_of_measurement=UNIT_WATT_HOURS, accuracy_decimals=3, device_class=DEVICE_CLASS_ENERGY, state_class=STATE_CLASS_TOTAL_INCREASING),
+        cv.Optional(CONF_SUMMARY): text_sensor.text_sensor_schema(entity_category=ENTITY_CATEGORY_DIAGNOSTIC),
+    }
+)
+
+CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(BQ25756Component),
             cv.Required(CONF_BATTERY): BATTERY_SCHEMA,
             cv.Required(CONF_CHARGING): CHARGING_SCHEMA,
+            cv.Optional(CONF_INTERRUPT_PIN): pins.internal_gpio_input_pin_schema,
             cv.Optional(CONF_CALIBRATION): cv.Schema({
                 cv.Optional(CONF_RESTORE, default=True): cv.boolean,
                 cv.Required(CONF_MEASURED_VOLTAGE): number.number_schema(BQ25756CalibrationVoltageNumber,
@@ -135,7 +214,9 @@ CONFIG_SCHEMA = (
                 ),
                 cv.Required(CONF_CALIBRATION_STATUS): text_sensor.text_sensor_schema(),
             }),
+            cv.Optional(CONF_ADC, default={}): ADC_SCHEMA,
             cv.Optional(CONF_MEASUREMENTS, default={}): MEASUREMENTS_SCHEMA,
+            cv.Optional(CONF_TELEMETRY): TELEMETRY_SCHEMA,
             cv.Optional(CONF_STATUS, default={}): cv.Schema({
                 cv.Optional(CONF_CHARGING_STATUS): text_sensor.text_sensor_schema(),
                 cv.Optional(CONF_TEMPERATURE_STATUS): text_sensor.text_sensor_schema(),
@@ -144,6 +225,18 @@ CONFIG_SCHEMA = (
                 cv.Optional(CONF_CONFIGURATION_STATUS): text_sensor.text_sensor_schema(
                     entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
                 ),
+                cv.Optional(CONF_RECONFIGURE_LATENCY): sensor.sensor_schema(
+                    unit_of_measurement=UNIT_MILLISECOND,
+                    accuracy_decimals=1,
+                    state_class=STATE_CLASS_MEASUREMENT,
+                    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+                ),
+                cv.Optional(CONF_INTERRUPT_LATENCY): sensor.sensor_schema(
+                    unit_of_measurement=UNIT_MILLISECOND,
+                    accuracy_decimals=2,
+                    state_class=STATE_CLASS_MEASUREMENT,
+                    entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+                ),
             }),
             cv.Optional(CONF_CONTROLS, default={}): cv.Schema({
                 cv.Optional(CONF_CHARGE_ENABLE): switch_.switch_schema(BQ25756ChargeEnableSwitch, entity_category=ENTITY_CATEGORY_CONFIG),
@@ -152,15 +245,32 @@ CONFIG_SCHEMA = (
         }
     )
     .extend(cv.polling_component_schema("1s"))
-    .extend(i2c.i2c_device_schema(default_address=0x6B))
+    .extend(i2c.i2c_device_schema(default_address=0x6B)),
+    validate_adc_channels,
 )
 
 
+CALIBRATION_PREFERENCE_KEY = 0xB2575601
+
+
+def _calibration_preference_key(config):
+    # The first charger keeps the original key so an existing feedback
+    # calibration is restored after a second charger is added.
+    chargers = CORE.config.get("bq25756", [])
+    if not chargers or chargers[0][CONF_ID].id == config[CONF_ID].id:
+        return CALIBRATION_PREFERENCE_KEY
+    return CALIBRATION_PREFERENCE_KEY ^ zlib.crc32(config[CONF_ID].id.encode())
+
+
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
     await cg.register_component(var, config)
     await i2c.register_i2c_device(var, config)
 
+    if CONF_INTERRUPT_PIN in config:
+        interrupt_pin = await cg.gpio_pin_expression(config[CONF_INTERRUPT_PIN])
+        cg.add(var.set_interrupt_pin(interrupt_pin))
+
     charging = config[CONF_CHARGING]
     cg.add(var.set_disable_ce_pin(True))
     cg.add(var.set_disable_ilim_hiz_pin(True))
@@ -177,6 +287,14 @@ async def to_code(config):
     if CONF_INPUT_CURRENT_LIMIT in charging:
         cg.add(var.set_input_current_dpm_limit_ma(round(charging[CONF_INPUT_CURRENT_LIMIT] * 1000)))
 
+    adc = config[CONF_ADC]
+    cg.add(var.set_configured_adc_profile(
+        ADC_MODES[adc[CONF_MODE]],
+        ADC_RESOLUTIONS[adc[CONF_RESOLUTION]],
+        adc[CONF_AVERAGING],
+        sum(ADC_CHANNELS[channel] for channel in set(adc[CONF_CHANNELS])),
+    ))
+
     measurements = config[CONF_MEASUREMENTS]
     if CONF_INPUT_CURRENT in measurements:
         sens = await sensor.new_sensor(measurements[CONF_INPUT_CURRENT])
@@ -193,6 +311,22 @@ async def to_code(config):
     if CONF_TEMPERATURE_PERCENT in measurements:
         sens = await sensor.new_sensor(measurements[CONF_TEMPERATURE_PERCENT])
         cg.add(var.set_ts_percent_sensor(sens))
+    if CONF_TELEMETRY in config:
+        telemetry = config[CONF_TELEMETRY]
+        cg.add(var.set_telemetry_window_ms(telemetry[CONF_WINDOW]))
+        for key, setter in (
+            (CONF_INPUT_POWER, var.set_input_power_sensor),
+            (CONF_OUTPUT_POWER, var.set_output_power_sensor),
+            (CONF_EFFICIENCY, var.set_efficiency_sensor),
+            (CONF_INPUT_ENERGY, var.set_input_energy_sensor),
+            (CONF_OUTPUT_ENERGY, var.set_output_energy_sensor),
+        ):
+            if key in telemetry:
+                sens = await sensor.new_sensor(telemetry[key])
+                cg.add(setter(sens))
+        if CONF_SUMMARY in telemetry:
+            ts = await text_sensor.new_text_sensor(telemetry[CONF_SUMMARY])
+            cg.add(var.set_telemetry_summary_text_sensor(ts))
     status = config[CONF_STATUS]
     if CONF_CHARGING_STATUS in status:
         ts = await text_sensor.new_text_sensor(status[CONF_CHARGING_STATUS])
@@ -209,6 +343,12 @@ async def to_code(config):
     if CONF_CONFIGURATION_STATUS in status:
         ts = await text_sensor.new_text_sensor(status[CONF_CONFIGURATION_STATUS])
         cg.add(var.set_configuration_status_text_sensor(ts))
+    if CONF_RECONFIGURE_LATENCY in status:
+        sens = await sensor.new_sensor(status[CONF_RECONFIGURE_LATENCY])
+        cg.add(var.set_reconfigure_latency_sensor(sens))
+    if CONF_INTERRUPT_LATENCY in status:
+        sens = await sensor.new_sensor(status[CONF_INTERRUPT_LATENCY])
+        cg.add(var.set_interrupt_latency_sensor(sens))
 
     controls = config[CONF_CONTROLS]
     if CONF_CHARGE_ENABLE in controls:
@@ -222,6 +362,7 @@ async def to_code(config):
     if CONF_CALIBRATION in config:
         calibration = config[CONF_CALIBRATION]
         cg.add(var.set_restore_calibration(calibration[CONF_RESTORE]))
+        cg.add(var.set_calibration_preference_key(_calibration_preference_key(config)))
         voltage_number = await number.new_number(
             calibration[CONF_MEASURED_VOLTAGE], min_value=0.0, max_value=100.0, step=0.001
         )
@@ -12,7 +12,13 @@ namespace bq25756 {
 
 namespace {
 static const char *const TAG = "bq25756";
-static constexpr uint32_t CALIBRATION_PREFERENCE_KEY = 0xB2575601;
+
+// Publishes only when the text differs from the last published value.
+void publish_text(text_sensor::TextSensor *sensor, ::component_common::PublishGuard &guard, const char *text) {
+  if (sensor != nullptr && guard.changed(text)) {
+    sensor->publish_state(text);
+  }
+}
 }  // namespace
 
 BQ25756Component::BQ25756Component() : service_(this) {}
@@ -26,7 +32,18 @@ bool BQ25756Component::set_watchdog_code(uint8_t code) {
   return this->service_.set_watchdog_code(code);
 }
 
+void IRAM_ATTR BQ25756Component::interrupt_isr_(BQ25756Component *component) {
+  component->interrupt_us_ = micros();
+  component->interrupt_pending_ = true;
+}
+
 void BQ25756Component::setup() {
+  if (this->interrupt_pin_ != nullptr) {
+    this->interrupt_pin_->setup();
+    this->interrupt_pin_->attach_interrupt(BQ25756Component::interrupt_isr_, this, gpio::INTERRUPT_FALLING_EDGE);
+  }
+  this->telemetry_.set_poll_interval_ms(this->get_update_interval());
+  this->telemetry_.start(millis());
   this->initialized_ = false;
   this->next_init_retry_ms_ = 0;
   this->next_configuration_audit_ms_ = 0;
@@ -51,7 +68,7 @@ void BQ25756Component::setup() {
 bool BQ25756Component::load_calibration_() {
   this->calibration_restored_ = false;
   if (global_preferences == nullptr) return false;
-  this->calibration_preference_ = global_preferences->make_preference<FeedbackCalibration>(CALIBRATION_PREFERENCE_KEY);
+  this->calibration_preference_ = global_preferences->make_preference<FeedbackCalibration>(this->calibration_preference_key_);
   this->calibration_preference_valid_ = true;
   if (!this->restore_calibration_) return true;
   FeedbackCalibration calibration{};
@@ -70,15 +87,11 @@ bool BQ25756Component::save_calibration_() {
 }
 
 void BQ25756Component::publish_calibration_status_(const char *status) {
-  if (this->calibration_status_text_sensor_ != nullptr) {
-    this->calibration_status_text_sensor_->publish_state(status);
-  }
+  publish_text(this->calibration_status_text_sensor_, this->calibration_status_guard_, status);
 }
 
 void BQ25756Component::publish_configuration_status_(const char *status) {
-  if (this->configuration_status_text_sensor_ != nullptr) {
-    this->configuration_status_text_sensor_->publish_state(status);
-  }
+  publish_text(this->configuration_status_text_sensor_, this->configuration_status_guard_, status);
 }
 
 bool BQ25756Component::apply_battery_target_() {
@@ -119,7 +132,7 @@ bool BQ25756Component::calibrate_feedback(float measured_battery_voltage_v) {
   ::bq25756_core::Measurements measurements{};
   ::bq25756_core::AdcConfigurationState adc_state{};
   const ::bq25756_core::MeasurementReadResult measurement_result =
-    this->service_.read_measurements(measurements, true, ::bq25756_core::REG2B_ADC_CONTINUOUS_15_BIT, adc_state);
+    this->service_.read_measurements(measurements, ::bq25756_core::ADC_PROFILE_CALIBRATION, adc_state);
   if (measurement_result == ::bq25756_core::MeasurementReadResult::CONFIGURATION_CHANGED) {
     // Enabling VFB starts a new ADC conversion.  Read it only after that
     // conversion has completed, rather than reporting a false calibration
@@ -287,6 +300,8 @@ bool BQ25756Component::audit_configured_state_() {
   }
 
   ESP_LOGW(TAG, "Charger configuration drift detected; repairing configured registers");
+  // Drift usually means the charger was reset, which also reverts REG2B/2C.
+  this->service_.invalidate_adc_configuration();
   if ((this->disable_watchdog_ && !this->set_watchdog_code(0)) || !this->ensure_adc_enabled_() ||
       !this->apply_configured_limits_() || !this->apply_battery_target_() ||
       !this->apply_configured_pin_overrides_() ||
@@ -332,31 +347,69 @@ void BQ25756Component::update() {
     return;
   }
 
+  if (this->adc_profile_.one_shot) {
+    // The result arrives in finish_adc_conversion_(); the rest of the poll
+    // does not depend on it.
+    if (!this->adc_conversion_pending_) {
+      this->start_adc_conversion_(status);
+    }
+  } else if (!this->poll_measurements_(status)) {
+    return;
+  }
+
+  if (this->vfb_reg_target_sensor_ != nullptr || this->vbat_ov_rising_pack_sensor_ != nullptr ||
+      this->vbat_ov_falling_pack_sensor_ != nullptr) {
+    ::bq25756_core::Reg16Value vfb_reg{};
+    if (!this->service_.read_u16_le(::bq25756_core::REG00_CHARGE_VOLTAGE_LIMIT, vfb_reg)) {
+      ESP_LOGW(TAG, "Failed reading REG0x00 for VFB/VBAT_OV threshold diagnostics");
+    } else {
+      const float vfb_reg_mv = ::bq25756_core::vfb_reg_target_mv(vfb_reg.raw_le);
+      const float vbat_ov_rising_fb_mv = vfb_reg_mv * ::bq25756_core::VBAT_OV_RISING_MULTIPLIER;
+      const float vbat_ov_falling_fb_mv = vfb_reg_mv * ::bq25756_core::VBAT_OV_FALLING_MULTIPLIER;
+      if (this->has_fb_to_pack_voltage_scale_) {
+        const float target_pack_mv = vfb_reg_mv * this->fb_to_pack_voltage_scale_;
+        const float rising_pack_mv = vbat_ov_rising_fb_mv * this->fb_to_pack_voltage_scale_;
+        const float falling_pack_mv = vbat_ov_falling_fb_mv * this->fb_to_pack_voltage_scale_;
+        if (this->vfb_reg_target_sensor_ != nullptr) {
+          this->vfb_reg_target_sensor_->publish_state(target_pack_mv);
+        }
+        if (this->vbat_ov_rising_pack_sensor_ != nullptr) {
+          this->vbat_ov_rising_pack_sensor_->publish_state(rising_pack_mv);
+        }
+        if (this->vbat_ov_falling_pack_sensor_ != nullptr) {
+          this->vbat_ov_falling_pack_sensor_->publish_state(falling_pack_mv);
+        }
+      }
+    }
+  }
+
+  this->publish_status_texts_(status);
+  this->publish_control_states_();
+  this->status_clear_warning();
+}
+
+bool BQ25756Component::poll_measurements_(const ::bq25756_core::Status &status) {
   ::bq25756_core::Measurements measurements;
   ::bq25756_core::AdcConfigurationState adc_state{};
   const ::bq25756_core::MeasurementReadResult measurement_result =
-    this->service_.read_measurements(measurements, false, ::bq25756_core::REG2B_ADC_CONTINUOUS_15_BIT, adc_state);
+    this->service_.read_measurements(measurements, this->adc_profile_, adc_state);
   if (measurement_result == ::bq25756_core::MeasurementReadResult::CONFIGURATION_CHANGED) {
     this->log_adc_configuration_(adc_state, ::bq25756_core::AdcEnsureResult::REPAIRED);
     ESP_LOGD(TAG, "ADC configuration changed; waiting for a new conversion");
-    return;
+    this->on_charger_poll_(status, nullptr, this->adc_reset_detected_(adc_state));
+    return false;
   }
   if (measurement_result == ::bq25756_core::MeasurementReadResult::CONFIGURATION_VERIFY_MISMATCH) {
     this->log_adc_configuration_(adc_state, ::bq25756_core::AdcEnsureResult::VERIFICATION_MISMATCH);
     this->status_set_warning();
-    return;
+    return false;
   }
   if (measurement_result != ::bq25756_core::MeasurementReadResult::OK) {
     ESP_LOGW(TAG, "ADC I2C measurement read failed");
     this->status_set_warning();
-    return;
+    return false;
   }
 
-  this->maybe_log_event_(
-    status.status1, status.status2, status.status3, status.fault, measurements.iac_ma, measurements.ibat_ma,
-    measurements.vac_mv, measurements.vbat_mv
-  );
-
   ESP_LOGD(TAG, "STATUS[21..24]=%02X %02X %02X %02X", status.status1, status.status2, status.status3, status.fault);
   ESP_LOGD(
     TAG,
@@ -385,6 +438,95 @@ void BQ25756Component::update() {
     measurements.ts.msb
   );
 
+  this->process_measurements_(status, measurements);
+  return true;
+}
+
+void BQ25756Component::loop() {
+  if (!this->interrupt_pending_) {
+    return;
+  }
+  const uint32_t interrupt_us = this->interrupt_us_;
+  this->interrupt_pending_ = false;
+  if (this->initialized_) {
+    this->service_interrupt_(interrupt_us);
+  }
+}
+
+void BQ25756Component::service_interrupt_(uint32_t interrupt_us) {
+  ::bq25756_core::Status status;
+  if (!this->service_.read_status(status)) {
+    ESP_LOGW(TAG, "Failed reading charger status after INT");
+    return;
+  }
+  if (!::bq25756_core::status_flags_set(status)) {
+    // A background poll already cleared the flags; the status is current.
+    this->publish_status_texts_(status);
+    return;
+  }
+
+  ::bq25756_core::Measurements measurements;
+  const bool read_measurements = ::bq25756_core::status_flags_affect_measurements(status);
+  if (read_measurements && this->adc_profile_.one_shot) {
+    // The last one-shot result predates the change; convert afresh.
+    this->on_charger_poll_(status, nullptr, false);
+    if (!this->adc_conversion_pending_) {
+      this->start_adc_conversion_(status);
+    }
+  } else if (read_measurements) {
+    ::bq25756_core::AdcConfigurationState adc_state{};
+    const ::bq25756_core::MeasurementReadResult result =
+        this->service_.read_measurements(measurements, this->adc_profile_, adc_state);
+    if (result == ::bq25756_core::MeasurementReadResult::CONFIGURATION_CHANGED) {
+      this->log_adc_configuration_(adc_state, ::bq25756_core::AdcEnsureResult::REPAIRED);
+      this->on_charger_poll_(status, nullptr, this->adc_reset_detected_(adc_state));
+    } else if (result == ::bq25756_core::MeasurementReadResult::OK) {
+      this->process_measurements_(status, measurements);
+    } else {
+      ESP_LOGW(TAG, "ADC read after INT failed");
+      this->on_charger_poll_(status, nullptr, false);
+    }
+  } else {
+    this->on_charger_poll_(status, nullptr, false);
+  }
+  this->publish_status_texts_(status);
+
+  const float latency_ms = static_cast<float>(micros() - interrupt_us) / 1000.0f;
+  ESP_LOGD(TAG, "INT flags=%02X %02X %02X serviced in %.2f ms%s", status.flag1, status.flag2, status.fault_flag,
+           latency_ms, read_measurements ? " with ADC" : "");
+  if (this->interrupt_latency_sensor_ != nullptr) {
+    this->interrupt_latency_sensor_->publish_state(latency_ms);
+  }
+}
+
+void BQ25756Component::process_measurements_(const ::bq25756_core::Status &status,
+                                             const ::bq25756_core::Measurements &measurements) {
+  this->on_charger_poll_(status, &measurements, false);
+  this->maybe_log_event_(status.status1, status.status2, status.status3, status.fault, measurements.iac_ma,
+                         measurements.ibat_ma, measurements.vac_mv, measurements.vbat_mv);
+  this->publish_measurements_(measurements);
+  this->record_telemetry_(status, measurements);
+  this->refresh_charger_snapshot_(status, measurements);
+}
+
+void BQ25756Component::refresh_charger_snapshot_(const ::bq25756_core::Status &status,
+                                                 const ::bq25756_core::Measurements &measurements) {
+  ::bq25756_core::ControlStates controls{};
+  controls.charge_enabled = this->latest_snapshot().enabled;
+  auto snapshot = ::bq25756_core::make_charger_snapshot(status, measurements, controls, 0, millis());
+  if (this->adc_profile_.one_shot) {
+    // Measured: the first channel converted right after the start.
+    snapshot.conversion_latency_us = this->adc_conversion_latency_us_;
+    snapshot.sample_age_us = micros() - this->adc_conversion_started_us_;
+  } else {
+    // Continuous: each channel refreshes once per cycle.
+    snapshot.conversion_latency_us = ::bq25756_core::adc_profile_cycle_us(this->adc_profile_);
+    snapshot.sample_age_us = snapshot.conversion_latency_us;
+  }
+  this->publish_snapshot_(snapshot);
+}
+
+void BQ25756Component::publish_measurements_(const ::bq25756_core::Measurements &measurements) {
   if (this->iac_current_sensor_ != nullptr) {
     this->iac_current_sensor_->publish_state(measurements.iac_ma);
   }
@@ -400,42 +542,66 @@ void BQ25756Component::update() {
   if (this->ts_percent_sensor_ != nullptr) {
     this->ts_percent_sensor_->publish_state(measurements.ts_percent);
   }
+}
 
-  if (this->vfb_reg_target_sensor_ != nullptr || this->vbat_ov_rising_pack_sensor_ != nullptr ||
-      this->vbat_ov_falling_pack_sensor_ != nullptr) {
-    ::bq25756_core::Reg16Value vfb_reg{};
-    if (!this->service_.read_u16_le(::bq25756_core::REG00_CHARGE_VOLTAGE_LIMIT, vfb_reg)) {
-      ESP_LOGW(TAG, "Failed reading REG0x00 for VFB/VBAT_OV threshold diagnostics");
-    } else {
-      const float vfb_reg_mv = ::bq25756_core::vfb_reg_target_mv(vfb_reg.raw_le);
-      const float vbat_ov_rising_fb_mv = vfb_reg_mv * ::bq25756_core::VBAT_OV_RISING_MULTIPLIER;
-      const float vbat_ov_falling_fb_mv = vfb_reg_mv * ::bq25756_core::VBAT_OV_FALLING_MULTIPLIER;
-      if (this->has_fb_to_pack_voltage_scale_) {
-        const float target_pack_mv = vfb_reg_mv * this->fb_to_pack_voltage_scale_;
-        const float rising_pack_mv = vbat_ov_rising_fb_mv * this->fb_to_pack_voltage_scale_;
-        const float falling_pack_mv = vbat_ov_falling_fb_mv * this->fb_to_pack_voltage_scale_;
-        if (this->vfb_reg_target_sensor_ != nullptr) {
-          this->vfb_reg_target_sensor_->publish_state(target_pack_mv);
-        }
-        if (this->vbat_ov_rising_pack_sensor_ != nullptr) {
-          this->vbat_ov_rising_pack_sensor_->publish_state(rising_pack_mv);
-        }
-        if (this->vbat_ov_falling_pack_sensor_ != nullptr) {
-          this->vbat_ov_falling_pack_sensor_->publish_state(falling_pack_mv);
-        }
-      }
-    }
+void BQ25756Component::record_telemetry_(const ::bq25756_core::Status &status,
+                                         const ::bq25756_core::Measurements &measurements) {
+  if (this->telemetry_window_ms_ == 0) {
+    return;
   }
+  const uint32_t now = millis();
+  this->telemetry_.add(now, status, measurements);
+  if (this->telemetry_.window_elapsed(now, this->telemetry_window_ms_)) {
+    this->publish_telemetry_(this->telemetry_.take_window(now));
+  }
+}
 
-  this->publish_status_texts_(status);
-  this->publish_control_states_();
-  this->status_clear_warning();
+void BQ25756Component::publish_telemetry_(const ::bq25756_core::TelemetryWindow &window) {
+  using ::bq25756_core::TelemetryChannel;
+  const auto &input_power = window.channel(TelemetryChannel::INPUT_POWER);
+  const auto &output_power = window.channel(TelemetryChannel::OUTPUT_POWER);
+  if (this->input_power_sensor_ != nullptr) {
+    this->input_power_sensor_->publish_state(input_power.mean);
+  }
+  if (this->output_power_sensor_ != nullptr) {
+    this->output_power_sensor_->publish_state(output_power.mean);
+  }
+  if (this->efficiency_sensor_ != nullptr) {
+    this->efficiency_sensor_->publish_state(window.has_efficiency ? window.efficiency * 100.0f : NAN);
+  }
+  if (this->input_energy_sensor_ != nullptr) {
+    this->input_energy_sensor_->publish_state(static_cast<float>(this->telemetry_.total_input_energy_wh()));
+  }
+  if (this->output_energy_sensor_ != nullptr) {
+    this->output_energy_sensor_->publish_state(static_cast<float>(this->telemetry_.total_output_energy_wh()));
+  }
+  if (this->telemetry_summary_text_sensor_ == nullptr) {
+    return;
+  }
+
+  char summary[224];
+  int n = std::snprintf(summary, sizeof(summary), "in %.1f W [%.1f..%.1f], out %.1f W [%.1f..%.1f], %u samples",
+                        input_power.mean, input_power.min, input_power.max, output_power.mean, output_power.min,
+                        output_power.max, static_cast<unsigned>(window.samples));
+  if (window.has_efficiency && n > 0 && static_cast<size_t>(n) < sizeof(summary)) {
+    n += std::snprintf(summary + n, sizeof(summary) - n, ", eff %.1f%%", window.efficiency * 100.0f);
+  }
+  for (size_t state = 0; state < window.charge_state_ms.size(); state++) {
+    if (window.charge_state_ms[state] == 0 || n <= 0 || static_cast<size_t>(n) >= sizeof(summary)) {
+      continue;
+    }
+    n += std::snprintf(summary + n, sizeof(summary) - n, ", %s %us",
+                       ::bq25756_core::charge_status_to_string(static_cast<uint8_t>(state)),
+                       static_cast<unsigned>(window.charge_state_ms[state] / 1000));
+  }
+  this->telemetry_summary_text_sensor_->publish_state(summary);
 }
 
 void BQ25756Component::dump_config() {
   ESP_LOGCONFIG(TAG, "BQ25756:");
   LOG_I2C_DEVICE(this);
   LOG_UPDATE_INTERVAL(this);
+  LOG_PIN("  Interrupt Pin: ", this->interrupt_pin_);
   ESP_LOGCONFIG(TAG, "  disable_watchdog: %s", this->disable_watchdog_ ? "true" : "false");
   ESP_LOGCONFIG(TAG, "  event_logging: %s", this->event_logging_ ? "true" : "false");
   ESP_LOGCONFIG(TAG, "  charging.control: %s", this->disable_ce_pin_ ? "i2c" : "pins");
@@ -454,6 +620,11 @@ void BQ25756Component::dump_config() {
   if (this->has_fb_to_pack_voltage_scale_) {
     ESP_LOGCONFIG(TAG, "  charging.battery_voltage.feedback_to_battery_ratio: %.6f", this->fb_to_pack_voltage_scale_);
   }
+  ESP_LOGCONFIG(TAG, "  adc: %s, %u-bit%s, channels=0x%02X, cycle %u us",
+                this->adc_profile_.one_shot ? "one-shot" : "continuous",
+                15U - static_cast<unsigned>(this->adc_profile_.resolution),
+                this->adc_profile_.averaging ? ", averaged" : "", this->adc_profile_.channels,
+                static_cast<unsigned>(::bq25756_core::adc_profile_cycle_us(this->adc_profile_)));
   LOG_SENSOR("  ", "IAC Current", this->iac_current_sensor_);
   LOG_SENSOR("  ", "IBAT Current", this->ibat_current_sensor_);
   LOG_SENSOR("  ", "VAC Voltage", this->vac_voltage_sensor_);
@@ -462,6 +633,18 @@ void BQ25756Component::dump_config() {
   LOG_SENSOR("  ", "Charge Voltage Target", this->vfb_reg_target_sensor_);
   LOG_SENSOR("  ", "Battery Overvoltage Rising", this->vbat_ov_rising_pack_sensor_);
   LOG_SENSOR("  ", "Battery Overvoltage Falling", this->vbat_ov_falling_pack_sensor_);
+  LOG_SENSOR("  ", "Interrupt Latency", this->interrupt_latency_sensor_);
+  if (this->telemetry_window_ms_ > 0) {
+    ESP_LOGCONFIG(TAG, "  telemetry.window: %u ms", static_cast<unsigned>(this->telemetry_window_ms_));
+    ESP_LOGCONFIG(TAG, "  telemetry.max_integration_gap: %u ms",
+                  static_cast<unsigned>(this->telemetry_.max_integration_gap_ms()));
+  }
+  LOG_SENSOR("  ", "Input Power", this->input_power_sensor_);
+  LOG_SENSOR("  ", "Output Power", this->output_power_sensor_);
+  LOG_SENSOR("  ", "Efficiency", this->efficiency_sensor_);
+  LOG_SENSOR("  ", "Input Energy", this->input_energy_sensor_);
+  LOG_SENSOR("  ", "Output Energy", this->output_energy_sensor_);
+  LOG_TEXT_SENSOR("  ", "Telemetry Summary", this->telemetry_summary_text_sensor_);
   LOG_TEXT_SENSOR("  ", "Charge Status", this->charge_status_text_sensor_);
   LOG_TEXT_SENSOR("  ", "TS Status", this->ts_status_text_sensor_);
   LOG_TEXT_SENSOR("  ", "MPPT Status", this->mppt_status_text_sensor_);
@@ -537,37 +720,19 @@ void BQ25756Component::publish_status_texts_(const ::bq25756_core::Status &statu
   const bool thermal_shutdown = (status.fault & 0x08) != 0;
   const bool drv_sup_fault = (status.fault & 0x02) != 0;
 
-  if (this->charge_status_text_sensor_ != nullptr) {
-    this->charge_status_text_sensor_->publish_state(::bq25756_core::charge_status_to_string(status.status1 & 0x07));
-  }
-  if (this->ts_status_text_sensor_ != nullptr) {
-    this->ts_status_text_sensor_->publish_state(::bq25756_core::ts_status_to_string((status.status2 >> 4) & 0x07));
-  }
-  if (this->mppt_status_text_sensor_ != nullptr) {
-    this->mppt_status_text_sensor_->publish_state(::bq25756_core::mppt_status_to_string(status.status2 & 0x03));
-  }
+  publish_text(this->charge_status_text_sensor_, this->charge_status_guard_,
+               ::bq25756_core::charge_status_to_string(status.status1 & 0x07));
+  publish_text(this->ts_status_text_sensor_, this->ts_status_guard_,
+               ::bq25756_core::ts_status_to_string((status.status2 >> 4) & 0x07));
+  publish_text(this->mppt_status_text_sensor_, this->mppt_status_guard_,
+               ::bq25756_core::mppt_status_to_string(status.status2 & 0x03));
 
   if (this->status_flags_text_sensor_ != nullptr) {
-    char flags[192];
-    size_t n = 0;
+    ::component_common::FixedString<191> flags;
     auto append_flag = [&](const char *name, bool active) {
-      if (!active || n >= sizeof(flags)) {
-        return;
-      }
-      if (n > 0) {
-        int written = std::snprintf(flags + n, sizeof(flags) - n, ",");
-        if (written <= 0 || static_cast<size_t>(written) >= (sizeof(flags) - n)) {
-          n = sizeof(flags) - 1;
-          return;
-        }
-        n += static_cast<size_t>(written);
+      if (active) {
+        flags.append_item(name, ",");
       }
-      int written = std::snprintf(flags + n, sizeof(flags) - n, "%s", name);
-      if (written <= 0 || static_cast<size_t>(written) >= (sizeof(flags) - n)) {
-        n = sizeof(flags) - 1;
-        return;
-      }
-      n += static_cast<size_t>(written);
     };
 
     append_flag("wd_expired", watchdog_expired);
@@ -586,11 +751,7 @@ void BQ25756Component::publish_status_texts_(const ::bq25756_core::Status &statu
       append_flag("pg_low", true);
     }
 
-    if (n == 0) {
-      this->status_flags_text_sensor_->publish_state("none");
-    } else {
-      this->status_flags_text_sensor_->publish_state(flags);
-    }
+    publish_text(this->status_flags_text_sensor_, this->status_flags_guard_, flags.empty() ? "none" : flags.c_str());
   }
 }
 
@@ -605,6 +766,11 @@ void BQ25756Component::publish_control_states_() {
     return;
   }
 
+  if (this->latest_snapshot().enabled != states.charge_enabled) {
+    auto snapshot = this->latest_snapshot();
+    snapshot.enabled = states.charge_enabled;
+    this->publish_snapshot_(snapshot);
+  }
   if (this->charge_enable_switch_ != nullptr) {
     this->charge_enable_switch_->publish_state(states.charge_enabled);
   }
@@ -615,7 +781,7 @@ bool BQ25756Component::ensure_adc_enabled_() {
   // Feedback calibration always needs this ADC channel, even when its optional
   // diagnostic sensor is not exposed to Home Assistant.
   const ::bq25756_core::AdcEnsureResult result =
-    this->service_.ensure_adc_enabled(true, ::bq25756_core::REG2B_ADC_CONTINUOUS_15_BIT, adc_state);
+    this->service_.ensure_adc_enabled(::bq25756_core::ADC_PROFILE_CALIBRATION, adc_state);
   if (result == ::bq25756_core::AdcEnsureResult::IO_ERROR ||
       result == ::bq25756_core::AdcEnsureResult::VERIFICATION_MISMATCH) {
     this->log_adc_configuration_(adc_state, result);
@@ -627,6 +793,82 @@ bool BQ25756Component::ensure_adc_enabled_() {
   return true;
 }
 
+void BQ25756Component::set_adc_profile(const ::bq25756_core::AdcProfile &profile) {
+  if (::bq25756_core::adc_profile_reg2b(profile) == ::bq25756_core::adc_profile_reg2b(this->adc_profile_) &&
+      ::bq25756_core::adc_profile_reg2c(profile) == ::bq25756_core::adc_profile_reg2c(this->adc_profile_)) {
+    return;
+  }
+  ESP_LOGD(TAG, "ADC profile: %s, %u-bit%s, channels=0x%02X, cycle %u us", profile.one_shot ? "one-shot" : "continuous",
+           15U - static_cast<unsigned>(profile.resolution), profile.averaging ? ", averaged" : "",
+           profile.channels, static_cast<unsigned>(::bq25756_core::adc_profile_cycle_us(profile)));
+  this->adc_profile_ = profile;
+  this->adc_profile_switching_ = true;
+  this->adc_conversion_pending_ = false;
+  this->cancel_timeout("bq25756_adc_conversion");
+}
+
+bool BQ25756Component::adc_reset_detected_(const ::bq25756_core::AdcConfigurationState &adc_state) {
+  const bool switching = this->adc_profile_switching_;
+  this->adc_profile_switching_ = false;
+  return !switching && !this->adc_profile_.one_shot && (adc_state.old_reg2b & ::bq25756_core::REG2B_ADC_EN_MASK) == 0;
+}
+
+void BQ25756Component::start_adc_conversion_(const ::bq25756_core::Status &status) {
+  ::bq25756_core::AdcConfigurationState adc_state{};
+  const ::bq25756_core::AdcEnsureResult result = this->service_.start_adc_conversion(this->adc_profile_, adc_state);
+  if (result == ::bq25756_core::AdcEnsureResult::IO_ERROR ||
+      result == ::bq25756_core::AdcEnsureResult::VERIFICATION_MISMATCH) {
+    this->log_adc_configuration_(adc_state, result);
+    this->status_set_warning();
+    return;
+  }
+  if (result == ::bq25756_core::AdcEnsureResult::REPAIRED) {
+    this->log_adc_configuration_(adc_state, result);
+    this->adc_profile_switching_ = false;
+  }
+  this->adc_conversion_pending_ = true;
+  this->adc_conversion_polls_ = 0;
+  this->adc_conversion_started_us_ = micros();
+  this->adc_conversion_status_ = status;
+  const uint32_t cycle_ms = (::bq25756_core::adc_profile_cycle_us(this->adc_profile_) + 999U) / 1000U;
+  this->set_timeout("bq25756_adc_conversion", cycle_ms, [this]() { this->finish_adc_conversion_(); });
+}
+
+void BQ25756Component::finish_adc_conversion_() {
+  bool done = false;
+  if (!this->service_.read_adc_conversion_done(done)) {
+    ESP_LOGW(TAG, "Failed reading one-shot ADC state");
+    this->adc_conversion_pending_ = false;
+    this->status_set_warning();
+    return;
+  }
+  if (!done) {
+    if (++this->adc_conversion_polls_ >= ADC_CONVERSION_MAX_POLLS) {
+      ESP_LOGW(TAG, "One-shot ADC conversion did not complete");
+      this->adc_conversion_pending_ = false;
+      this->service_.invalidate_adc_configuration();
+      return;
+    }
+    this->set_timeout("bq25756_adc_conversion", ADC_CONVERSION_POLL_MS, [this]() { this->finish_adc_conversion_(); });
+    return;
+  }
+  this->adc_conversion_pending_ = false;
+  this->adc_conversion_latency_us_ = micros() - this->adc_conversion_started_us_;
+
+  ::bq25756_core::Measurements measurements;
+  ::bq25756_core::AdcConfigurationState adc_state{};
+  if (this->service_.read_measurements(measurements, this->adc_profile_, adc_state) !=
+      ::bq25756_core::MeasurementReadResult::OK) {
+    // A fault or I/O error since the start dropped the verification; the
+    // next start re-applies the profile.
+    ESP_LOGW(TAG, "One-shot ADC result read failed");
+    return;
+  }
+  ESP_LOGD(TAG, "One-shot ADC conversion done in %.1f ms",
+           static_cast<float>(this->adc_conversion_latency_us_) / 1000.0f);
+  this->process_measurements_(this->adc_conversion_status_, measurements);
+}
+
 void BQ25756Component::log_adc_configuration_(
   const ::bq25756_core::AdcConfigurationState &state, ::bq25756_core::AdcEnsureResult result
 ) {
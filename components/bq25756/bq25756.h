@@ -6,7 +6,9 @@
 
 #include "bq25756_bus.h"
 #include "bq25756_service.h"
+#include "bq25756_telemetry_service.h"
 #include "../component_common/charger.h"
+#include "../component_common/fixed_string.h"
 #include "../component_common/status.h"
 
 #include "esphome/components/button/button.h"
@@ -16,6 +18,7 @@
 #include "esphome/components/switch/switch.h"
 #include "esphome/components/text_sensor/text_sensor.h"
 #include "esphome/core/component.h"
+#include "esphome/core/gpio.h"
 #include "esphome/core/preferences.h"
 
 namespace esphome {
@@ -71,6 +74,7 @@ class BQ25756Component : public PollingComponent,
   }
   void set_battery_target_voltage(float voltage_v) { battery_target_voltage_v_ = voltage_v; }
   void set_restore_calibration(bool restore) { restore_calibration_ = restore; }
+  void set_calibration_preference_key(uint32_t key) { calibration_preference_key_ = key; }
   void set_calibration_voltage_number(number::Number *number) { calibration_voltage_number_ = number; }
   void set_calibration_status_text_sensor(text_sensor::TextSensor *sensor) {
     calibration_status_text_sensor_ = sensor;
@@ -122,6 +126,28 @@ class BQ25756Component : public PollingComponent,
   void set_status_flags_text_sensor(text_sensor::TextSensor *sensor) {
     status_flags_text_sensor_ = sensor;
   }
+  // Window-rate telemetry; a zero window disables the aggregator.
+  void set_telemetry_window_ms(uint32_t window_ms) { telemetry_window_ms_ = window_ms; }
+  void set_input_power_sensor(sensor::Sensor *sensor) { input_power_sensor_ = sensor; }
+  void set_output_power_sensor(sensor::Sensor *sensor) { output_power_sensor_ = sensor; }
+  void set_efficiency_sensor(sensor::Sensor *sensor) { efficiency_sensor_ = sensor; }
+  void set_input_energy_sensor(sensor::Sensor *sensor) { input_energy_sensor_ = sensor; }
+  void set_output_energy_sensor(sensor::Sensor *sensor) { output_energy_sensor_ = sensor; }
+  void set_telemetry_summary_text_sensor(text_sensor::TextSensor *sensor) { telemetry_summary_text_sensor_ = sensor; }
+  // Configured ADC profile (codegen); `resolution` is the REG2B.ADC_SAMPLE code.
+  void set_configured_adc_profile(bool one_shot, uint8_t resolution, bool averaging, uint8_t channels) {
+    configured_adc_profile_ = {one_shot, static_cast<::bq25756_core::AdcResolution>(resolution), averaging, channels};
+    adc_profile_ = configured_adc_profile_;
+  }
+  // Runtime switch, e.g. to ADC_PROFILE_FAST_CURRENT around a CC/CV handoff.
+  // Applied on the next measurement read.
+  void set_adc_profile(const ::bq25756_core::AdcProfile &profile);
+  void restore_adc_profile() { this->set_adc_profile(this->configured_adc_profile_); }
+  const ::bq25756_core::AdcProfile &adc_profile() const { return adc_profile_; }
+  // Optional INT line (active low, open drain). Each flag pulse triggers a
+  // status read from loop(); update() remains the background poll.
+  void set_interrupt_pin(InternalGPIOPin *pin) { interrupt_pin_ = pin; }
+  void set_interrupt_latency_sensor(sensor::Sensor *sensor) { interrupt_latency_sensor_ = sensor; }
 
   void set_charge_enable_switch(switch_::Switch *sw) {
     charge_enable_switch_ = sw;
@@ -130,7 +156,6 @@ class BQ25756Component : public PollingComponent,
   bool set_charge_enabled(bool enabled);
 
   ::component_common::ChargerCapabilities capabilities() const override;
-  ::component_common::ChargerSnapshot snapshot() const override;
   bool request_enabled(bool enabled) override;
 
   bool set_watchdog_code(uint8_t code);
@@ -139,6 +164,7 @@ class BQ25756Component : public PollingComponent,
   void log_charge_enable_precheck_(bool requested_on);
 
   void setup() override;
+  void loop() override;
   void update() override;
   void dump_config() override;
 
@@ -148,7 +174,27 @@ class BQ25756Component : public PollingComponent,
   bool dump_registers_0x00_0x3D();
 
  protected:
+  static void interrupt_isr_(BQ25756Component *component);
+  // Reads status and flags in one burst and the ADC block only when a flag
+  // changed the power path, then publishes and times the change.
+  void service_interrupt_(uint32_t interrupt_us);
+  // Continuous profiles: read and process the ADC block. False ends the poll.
+  bool poll_measurements_(const ::bq25756_core::Status &status);
+  // One-shot profiles: start a conversion, then poll for ADC_EN to clear
+  // after the nominal conversion time and process the result.
+  void start_adc_conversion_(const ::bq25756_core::Status &status);
+  void finish_adc_conversion_();
+  // Shared tail of every successful measurement read.
+  void process_measurements_(const ::bq25756_core::Status &status, const ::bq25756_core::Measurements &measurements);
+  // REG2B.ADC_EN found cleared counts as a register reset only for a
+  // continuous profile the driver did not just switch away from.
+  bool adc_reset_detected_(const ::bq25756_core::AdcConfigurationState &adc_state);
+  void publish_measurements_(const ::bq25756_core::Measurements &measurements);
+  void record_telemetry_(const ::bq25756_core::Status &status, const ::bq25756_core::Measurements &measurements);
+  void publish_telemetry_(const ::bq25756_core::TelemetryWindow &window);
   void publish_status_texts_(const ::bq25756_core::Status &status);
+  // Publishes the ChargerInterface snapshot of every processed measurement
+  // read; consumers never trigger bus traffic.
   void refresh_charger_snapshot_(const ::bq25756_core::Status &status,
                                  const ::bq25756_core::Measurements &measurements);
   void publish_control_states_();
@@ -157,6 +203,10 @@ class BQ25756Component : public PollingComponent,
   bool apply_configured_pin_overrides_();
   bool configured_state_matches_();
   virtual bool audit_configured_state_();
+  // Called once per poll after the status burst and either the ADC burst or
+  // an ADC setup repair; `adc_reset` means REG2B.ADC_EN was found cleared.
+  virtual void on_charger_poll_(const ::bq25756_core::Status & /*status*/,
+                                const ::bq25756_core::Measurements * /*measurements*/, bool /*adc_reset*/) {}
   bool ensure_adc_enabled_();
   void log_adc_configuration_(const ::bq25756_core::AdcConfigurationState &state,
                               ::bq25756_core::AdcEnsureResult result);
@@ -170,8 +220,16 @@ class BQ25756Component : public PollingComponent,
       float iac_ma, float ibat_ma, float vac_mv, float vbat_mv);
 
   ::bq25756_core::Bq25756Service service_;
-  ::component_common::ChargerSnapshot charger_snapshot_{};
-  uint32_t charger_snapshot_sequence_{0};
+  ::bq25756_core::AdcProfile configured_adc_profile_{};
+  ::bq25756_core::AdcProfile adc_profile_{};
+  bool adc_profile_switching_{false};
+  bool adc_conversion_pending_{false};
+  uint8_t adc_conversion_polls_{0};
+  uint32_t adc_conversion_started_us_{0};
+  uint32_t adc_conversion_latency_us_{0};
+  ::bq25756_core::Status adc_conversion_status_{};
+  static constexpr uint8_t ADC_CONVERSION_MAX_POLLS = 10;
+  static constexpr uint32_t ADC_CONVERSION_POLL_MS = 2;
 
   sensor::Sensor *iac_current_sensor_{nullptr};
   sensor::Sensor *ibat_current_sensor_{nullptr};
@@ -190,6 +248,25 @@ class BQ25756Component : public PollingComponent,
   text_sensor::TextSensor *status_flags_text_sensor_{nullptr};
   text_sensor::TextSensor *calibration_status_text_sensor_{nullptr};
   text_sensor::TextSensor *configuration_status_text_sensor_{nullptr};
+  ::component_common::PublishGuard charge_status_guard_{};
+  ::component_common::PublishGuard ts_status_guard_{};
+  ::component_common::PublishGuard mppt_status_guard_{};
+  ::component_common::PublishGuard status_flags_guard_{};
+  ::component_common::PublishGuard calibration_status_guard_{};
+  ::component_common::PublishGuard configuration_status_guard_{};
+
+  ::bq25756_core::TelemetryAggregator telemetry_{};
+  uint32_t telemetry_window_ms_{0};
+  sensor::Sensor *input_power_sensor_{nullptr};
+  sensor::Sensor *output_power_sensor_{nullptr};
+  sensor::Sensor *efficiency_sensor_{nullptr};
+  sensor::Sensor *input_energy_sensor_{nullptr};
+  sensor::Sensor *output_energy_sensor_{nullptr};
+  text_sensor::TextSensor *telemetry_summary_text_sensor_{nullptr};
+  sensor::Sensor *interrupt_latency_sensor_{nullptr};
+  InternalGPIOPin *interrupt_pin_{nullptr};
+  volatile bool interrupt_pending_{false};
+  volatile uint32_t interrupt_us_{0};
 
   switch_::Switch *charge_enable_switch_{nullptr};
   number::Number *calibration_voltage_number_{nullptr};
@@ -221,6 +298,7 @@ class BQ25756Component : public PollingComponent,
   bool restore_calibration_{true};
   bool calibration_restored_{false};
   decltype(global_preferences->make_preference<FeedbackCalibration>(0)) calibration_preference_{};
+  uint32_t calibration_preference_key_{0xB2575601u};
   bool calibration_preference_valid_{false};
   bool has_last_event_status_{false};
   uint8_t last_status1_{0};
@@ -234,21 +312,35 @@ class BQ25756Component : public PollingComponent,
 class BQ25756ComponentImpl : public BQ25756Component {
  public:
   void setup() override;
+  void loop() override;
   void update() override;
   bool read_registers(uint8_t reg, uint8_t *data, size_t len) override;
   bool write_registers(uint8_t reg, const uint8_t *data, size_t len) override;
 
+  void set_reconfigure_latency_sensor(sensor::Sensor *sensor) { this->reconfigure_latency_sensor_ = sensor; }
+
  protected:
   ::bq25756_core::Bq25756RegisterConfig build_register_config_() const;
   bool sync_register_config_();
   void set_connection_state_(::component_common::ConnectionState state);
   void set_disconnected_();
+  // Input/battery plug-in, watchdog expiry or a register reset: push the
+  // register config again in this poll, timed from the start of the poll.
+  void on_charger_poll_(const ::bq25756_core::Status &status,
+                        const ::bq25756_core::Measurements *measurements, bool adc_reset) override;
+  void request_reconfigure_(const char *reason);
 
   // The base implementation predates the complete register config and performs
   // a partial timer-driven audit. The concrete component intentionally disables
   // that path because full sync is driven by connection-state transitions.
   bool audit_configured_state_() override { return true; }
 
+  sensor::Sensor *reconfigure_latency_sensor_{nullptr};
+  ::bq25756_core::ConnectionEventDetector connection_events_{};
+  uint32_t poll_started_us_{0};
+  uint32_t reconfigure_requested_us_{0};
+  bool reconfigure_pending_{false};
+
   bool io_failed_this_cycle_{false};
   bool register_config_synced_{false};
   uint8_t consecutive_failed_cycles_{0};
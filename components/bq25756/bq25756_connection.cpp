@@ -62,9 +62,15 @@ BQ25756ComponentImpl::build_register_config_() const {
         static_cast<uint8_t>(~::bq25756_core::REG19_EN_PFM_MASK));
   }
 
-  // Normal telemetry does not need VFB. Calibration temporarily enables it.
-  config.adc_control = ::bq25756_core::REG2B_ADC_CONTINUOUS_15_BIT;
-  config.adc_channel_control = ::bq25756_core::REG2C_VFB_ADC_DIS_MASK;
+  // The active ADC profile, so a restore does not look like a profile
+  // change. Normal profiles leave VFB off; calibration temporarily enables
+  // it. A one-shot profile is restored idle, without starting a conversion.
+  config.adc_control = ::bq25756_core::adc_profile_reg2b(this->adc_profile_);
+  if (this->adc_profile_.one_shot) {
+    config.adc_control = static_cast<uint8_t>(config.adc_control &
+                                              ~::bq25756_core::REG2B_ADC_EN_MASK);
+  }
+  config.adc_channel_control = ::bq25756_core::adc_profile_reg2c(this->adc_profile_);
   return config;
 }
 
@@ -75,8 +81,8 @@ void BQ25756ComponentImpl::set_connection_state_(
   }
 
   ESP_LOGI(TAG, "Connection state: %s -> %s",
-           ::component_common::connection_state_to_string(this->connection_state_).data(),
-           ::component_common::connection_state_to_string(state).data());
+           ::component_common::connection_state_to_string(this->connection_state_),
+           ::component_common::connection_state_to_string(state));
   this->connection_state_ = state;
 
   if (state == ::component_common::ConnectionState::DISCONNECTED) {
@@ -87,18 +93,22 @@ void BQ25756ComponentImpl::set_connection_state_(
 }
 
 bool BQ25756ComponentImpl::sync_register_config_() {
-  // A newly connected device may be at reset defaults. Keep charging disabled
-  // until the complete desired register configuration has been verified.
-  if (!this->service_.set_charge_enabled(false)) {
-    ESP_LOGW(TAG, "Cannot sync register config: failed to disable charging");
-    return false;
-  }
-
+  // A newly connected device may be at reset defaults. The burst restore
+  // pushes the complete desired register configuration, keeping the charge,
+  // HIZ and reverse-mode requests, before it is verified; per-register
+  // reconcile is only the fallback when the read-back does not match.
   const auto image = ::bq25756_core::make_register_config_image(
       this->build_register_config_());
   ::bq25756_core::ConfigurationReconcileResult result{};
-  const bool synced =
-      this->service_.reconcile_configuration(image, true, result);
+  bool synced = this->service_.restore_configuration(image, result);
+  if (result.io_ok && !synced) {
+    ESP_LOGW(TAG,
+             "Register config restore left %u mismatch(es) from 0x%02X; "
+             "reconciling per register",
+             static_cast<unsigned>(result.remaining_mismatch_count),
+             static_cast<unsigned>(result.first_mismatch_address));
+    synced = this->service_.reconcile_configuration(image, true, result);
+  }
 
   if (!result.io_ok) {
     ESP_LOGW(TAG, "Register config sync failed during register I/O");
@@ -117,19 +127,47 @@ bool BQ25756ComponentImpl::sync_register_config_() {
 
   this->register_config_synced_ = true;
   this->publish_configuration_status_("configured");
-  if (result.repaired) {
-    ESP_LOGI(TAG,
-             "Synced %u register(s) for the new connected session: "
-             "fingerprint=0x%08X",
-             static_cast<unsigned>(result.repaired_count),
-             static_cast<unsigned>(result.desired_fingerprint));
-  } else {
-    ESP_LOGD(TAG, "Register config already matched: fingerprint=0x%08X",
-             static_cast<unsigned>(result.desired_fingerprint));
+  const float latency_ms =
+      static_cast<float>(micros() - this->reconfigure_requested_us_) / 1000.0f;
+  ESP_LOGI(TAG,
+           "Synced %u register(s) %.1f ms after the triggering poll: "
+           "fingerprint=0x%08X",
+           static_cast<unsigned>(result.repaired_count), latency_ms,
+           static_cast<unsigned>(result.desired_fingerprint));
+  if (this->reconfigure_pending_ && this->reconfigure_latency_sensor_ != nullptr) {
+    this->reconfigure_latency_sensor_->publish_state(latency_ms);
   }
+  this->reconfigure_pending_ = false;
   return true;
 }
 
+void BQ25756ComponentImpl::request_reconfigure_(const char *reason) {
+  // Retries keep the first request time, so the latency covers them.
+  if (!this->reconfigure_pending_) {
+    this->reconfigure_pending_ = true;
+    this->reconfigure_requested_us_ = this->poll_started_us_;
+  }
+  if (this->register_config_synced_) {
+    ESP_LOGI(TAG, "Re-applying register config: %s", reason);
+  }
+  this->register_config_synced_ = false;
+}
+
+void BQ25756ComponentImpl::on_charger_poll_(
+    const ::bq25756_core::Status &status,
+    const ::bq25756_core::Measurements *measurements, bool adc_reset) {
+  const uint8_t events =
+      this->connection_events_.observe(status, measurements, adc_reset);
+  for (uint8_t event = ::bq25756_core::CONNECTION_EVENT_INPUT_PRESENT;
+       event <= ::bq25756_core::CONNECTION_EVENT_REGISTER_RESET;
+       event = static_cast<uint8_t>(event << 1)) {
+    if ((events & event) != 0) {
+      this->request_reconfigure_(
+          ::bq25756_core::connection_event_to_string(event));
+    }
+  }
+}
+
 void BQ25756ComponentImpl::set_disconnected_() {
   if (this->connection_state_ !=
       ::component_common::ConnectionState::DISCONNECTED) {
@@ -141,7 +179,14 @@ void BQ25756ComponentImpl::set_disconnected_() {
 
   this->initialized_ = false;
   this->register_config_synced_ = false;
-  this->charger_snapshot_.valid = false;
+  this->reconfigure_pending_ = false;
+  this->adc_conversion_pending_ = false;
+  this->connection_events_.reset();
+  if (this->latest_snapshot().valid) {
+    auto snapshot = this->latest_snapshot();
+    snapshot.valid = false;
+    this->publish_snapshot_(snapshot);
+  }
   this->next_init_retry_ms_ = millis() + INIT_RETRY_INTERVAL_MS;
   this->set_connection_state_(
       ::component_common::ConnectionState::DISCONNECTED);
@@ -149,6 +194,7 @@ void BQ25756ComponentImpl::set_disconnected_() {
 }
 
 void BQ25756ComponentImpl::setup() {
+  this->poll_started_us_ = micros();
   this->io_failed_this_cycle_ = false;
   this->register_config_synced_ = false;
   this->consecutive_failed_cycles_ = 0;
@@ -166,6 +212,7 @@ void BQ25756ComponentImpl::setup() {
 
   this->set_connection_state_(
       ::component_common::ConnectionState::CONNECTED);
+  this->request_reconfigure_("setup");
   if (!this->sync_register_config_()) {
     if (this->io_failed_this_cycle_) {
       this->set_disconnected_();
@@ -179,7 +226,25 @@ void BQ25756ComponentImpl::setup() {
   this->status_clear_warning();
 }
 
+void BQ25756ComponentImpl::loop() {
+  if (!this->interrupt_pending_) {
+    return;
+  }
+  this->poll_started_us_ = this->interrupt_us_;
+  this->io_failed_this_cycle_ = false;
+  BQ25756Component::loop();
+
+  // An INT-reported event is re-applied right away; failures are left to the
+  // next update(), which owns retries and disconnect accounting.
+  if (this->initialized_ && !this->io_failed_this_cycle_ && !this->register_config_synced_ &&
+      this->connection_state_ == ::component_common::ConnectionState::CONNECTED &&
+      this->sync_register_config_()) {
+    this->status_clear_warning();
+  }
+}
+
 void BQ25756ComponentImpl::update() {
+  this->poll_started_us_ = micros();
   this->io_failed_this_cycle_ = false;
 
   if (this->connection_state_ ==
@@ -211,7 +276,7 @@ void BQ25756ComponentImpl::update() {
       ::component_common::ConnectionState::CONNECTED) {
     this->set_connection_state_(
         ::component_common::ConnectionState::CONNECTED);
-    this->register_config_synced_ = false;
+    this->request_reconfigure_("new connected session");
   }
 
   if (!this->register_config_synced_) {
@@ -26,6 +26,16 @@ bool charger_fault_active(const Status &status) {
          (status.fault & REG24_ACTIVE_FAULT_MASK) != 0;
 }
 
+bool status_flags_set(const Status &status) {
+  return (status.flag1 | status.flag2 | status.fault_flag) != 0;
+}
+
+bool status_flags_affect_measurements(const Status &status) {
+  return (status.flag1 & (REG25_IAC_DPM_FLAG_MASK | REG25_VAC_DPM_FLAG_MASK | REG25_CHARGE_FLAG_MASK)) != 0 ||
+         (status.flag2 & REG26_POWER_GOOD_FLAG_MASK) != 0 ||
+         (status.fault_flag & REG27_ACTIVE_FAULT_FLAG_MASK) != 0;
+}
+
 ::component_common::ChargerSnapshot make_charger_snapshot(
     const Status &status, const Measurements &measurements,
     const ControlStates &controls, uint32_t sequence, uint32_t timestamp_ms) {
@@ -103,6 +113,54 @@ const char *mppt_status_to_string(uint8_t mppt_status) {
   }
 }
 
+uint8_t ConnectionEventDetector::observe(const Status &status, const Measurements *measurements,
+                                        bool register_reset) {
+  uint8_t events = register_reset ? CONNECTION_EVENT_REGISTER_RESET : 0;
+  const bool input_present = (status.status2 & REG22_POWER_GOOD_STAT_MASK) != 0;
+  const bool watchdog_expired = (status.status1 & REG21_WATCHDOG_STAT_MASK) != 0;
+  if (this->has_baseline_) {
+    if (input_present && !this->input_present_) {
+      events |= CONNECTION_EVENT_INPUT_PRESENT;
+    }
+    if (watchdog_expired && !this->watchdog_expired_) {
+      events |= CONNECTION_EVENT_WATCHDOG_EXPIRED;
+    }
+  }
+  this->input_present_ = input_present;
+  this->watchdog_expired_ = watchdog_expired;
+  this->has_baseline_ = true;
+
+  if (measurements != nullptr) {
+    bool battery_present = this->battery_present_;
+    if (measurements->vbat_mv >= BATTERY_PRESENT_MV) {
+      battery_present = true;
+    } else if (measurements->vbat_mv < BATTERY_ABSENT_MV) {
+      battery_present = false;
+    }
+    if (this->battery_known_ && battery_present && !this->battery_present_) {
+      events |= CONNECTION_EVENT_BATTERY_PRESENT;
+    }
+    this->battery_present_ = battery_present;
+    this->battery_known_ = true;
+  }
+  return events;
+}
+
+const char *connection_event_to_string(uint8_t event) {
+  switch (event) {
+    case CONNECTION_EVENT_INPUT_PRESENT:
+      return "input_present";
+    case CONNECTION_EVENT_BATTERY_PRESENT:
+      return "battery_present";
+    case CONNECTION_EVENT_WATCHDOG_EXPIRED:
+      return "watchdog_expired";
+    case CONNECTION_EVENT_REGISTER_RESET:
+      return "register_reset";
+    default:
+      return "unknown";
+  }
+}
+
 Measurements decode_measurements(const Reg16Value &iac, const Reg16Value &ibat, const Reg16Value &vac,
                                  const Reg16Value &vbat, const Reg16Value &ts, const Reg16Value &vfb) {
   Measurements measurements;
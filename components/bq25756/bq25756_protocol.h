@@ -29,6 +29,10 @@ struct Status {
   uint8_t status2{0};
   uint8_t status3{0};
   uint8_t fault{0};
+  // REG25..27 as read together with the status bytes; reading clears them.
+  uint8_t flag1{0};
+  uint8_t flag2{0};
+  uint8_t fault_flag{0};
 };
 
 struct Measurements {
@@ -46,6 +50,83 @@ struct Measurements {
   float vfb_mv{0.0f};
 };
 
+// ADC channel selection; a set bit converts the channel. The bit order is the
+// order of the result block REG2D..REG3A.
+static constexpr uint8_t ADC_CHANNEL_IAC = 0x01;
+static constexpr uint8_t ADC_CHANNEL_IBAT = 0x02;
+static constexpr uint8_t ADC_CHANNEL_VAC = 0x04;
+static constexpr uint8_t ADC_CHANNEL_VBAT = 0x08;
+static constexpr uint8_t ADC_CHANNEL_TS = 0x10;
+static constexpr uint8_t ADC_CHANNEL_VFB = 0x20;
+static constexpr uint8_t ADC_CHANNELS_TELEMETRY =
+    ADC_CHANNEL_IAC | ADC_CHANNEL_IBAT | ADC_CHANNEL_VAC | ADC_CHANNEL_VBAT | ADC_CHANNEL_TS;
+static constexpr uint8_t ADC_CHANNELS_ALL = ADC_CHANNELS_TELEMETRY | ADC_CHANNEL_VFB;
+
+// REG2B.ADC_SAMPLE codes. Each step down halves the conversion time.
+enum class AdcResolution : uint8_t {
+  BITS_15 = 0,
+  BITS_14 = 1,
+  BITS_13 = 2,
+};
+
+// Nominal conversion time of one channel at 15-bit resolution.
+static constexpr uint32_t ADC_CONVERSION_15_BIT_US = 24000;
+
+// Runtime ADC mode. Continuous profiles keep converting the enabled channels
+// round-robin; one-shot profiles convert each enabled channel once per start
+// and clear REG2B.ADC_EN when done. Fewer channels and a lower resolution
+// shorten the cycle, i.e. how stale a result can be.
+struct AdcProfile {
+  bool one_shot{false};
+  AdcResolution resolution{AdcResolution::BITS_15};
+  bool averaging{false};
+  uint8_t channels{ADC_CHANNELS_TELEMETRY};
+};
+
+// Default telemetry: every channel except VFB, continuous at 15 bits.
+static constexpr AdcProfile ADC_PROFILE_TELEMETRY{};
+// Feedback calibration additionally needs VFB.
+static constexpr AdcProfile ADC_PROFILE_CALIBRATION{.channels = ADC_CHANNELS_ALL};
+// Charge-phase control: IBAT and VBAT only at 13 bits, a 12 ms cycle instead
+// of 120 ms.
+static constexpr AdcProfile ADC_PROFILE_FAST_CURRENT{
+    .resolution = AdcResolution::BITS_13, .channels = ADC_CHANNEL_IBAT | ADC_CHANNEL_VBAT};
+
+// REG2B with ADC_EN set; for one-shot profiles that write starts a conversion.
+constexpr uint8_t adc_profile_reg2b(const AdcProfile &profile) {
+  return static_cast<uint8_t>(REG2B_ADC_EN_MASK | (profile.one_shot ? REG2B_ADC_RATE_MASK : 0) |
+                              ((static_cast<uint8_t>(profile.resolution) << 4) & REG2B_ADC_SAMPLE_MASK) |
+                              (profile.averaging ? REG2B_ADC_AVG_MASK : 0));
+}
+
+// Owned REG2C bits: a disable bit for every channel the profile leaves out.
+constexpr uint8_t adc_profile_reg2c(const AdcProfile &profile) {
+  uint8_t value = 0;
+  if ((profile.channels & ADC_CHANNEL_IAC) == 0) value |= REG2C_IAC_ADC_DIS_MASK;
+  if ((profile.channels & ADC_CHANNEL_IBAT) == 0) value |= REG2C_IBAT_ADC_DIS_MASK;
+  if ((profile.channels & ADC_CHANNEL_VAC) == 0) value |= REG2C_VAC_ADC_DIS_MASK;
+  if ((profile.channels & ADC_CHANNEL_VBAT) == 0) value |= REG2C_VBAT_ADC_DIS_MASK;
+  if ((profile.channels & ADC_CHANNEL_TS) == 0) value |= REG2C_TS_ADC_DIS_MASK;
+  if ((profile.channels & ADC_CHANNEL_VFB) == 0) value |= REG2C_VFB_ADC_DIS_MASK;
+  return value;
+}
+
+// One pass over the enabled channels: the continuous refresh period of each
+// channel, or the duration of a one-shot conversion.
+constexpr uint32_t adc_profile_cycle_us(const AdcProfile &profile) {
+  uint32_t channels = 0;
+  for (uint8_t bits = static_cast<uint8_t>(profile.channels & ADC_CHANNELS_ALL); bits != 0;
+       bits = static_cast<uint8_t>(bits & (bits - 1))) {
+    channels++;
+  }
+  return channels * (ADC_CONVERSION_15_BIT_US >> static_cast<uint8_t>(profile.resolution));
+}
+
+static_assert(adc_profile_reg2b(ADC_PROFILE_TELEMETRY) == REG2B_ADC_CONTINUOUS_15_BIT);
+static_assert(adc_profile_reg2c(ADC_PROFILE_TELEMETRY) == REG2C_VFB_ADC_DIS_MASK);
+static_assert(adc_profile_cycle_us(ADC_PROFILE_TELEMETRY) == 120000);
+static_assert(adc_profile_cycle_us(ADC_PROFILE_FAST_CURRENT) == 12000);
+
 struct ControlStates {
   bool charge_enabled{false};
   bool hiz_mode{false};
@@ -64,11 +145,48 @@ struct ChargePrecheckSnapshot {
   bool en_rev{false};
 };
 
+// Charger-side events after which the register configuration may be back at
+// reset defaults. The BQ25756 has no POR flag; REG2B.ADC_EN reading cleared
+// while the driver keeps it set is the reset evidence.
+static constexpr uint8_t CONNECTION_EVENT_INPUT_PRESENT = 0x01;
+static constexpr uint8_t CONNECTION_EVENT_BATTERY_PRESENT = 0x02;
+static constexpr uint8_t CONNECTION_EVENT_WATCHDOG_EXPIRED = 0x04;
+static constexpr uint8_t CONNECTION_EVENT_REGISTER_RESET = 0x08;
+
+// Rising-edge detector over successive polls. Input presence is PG_STAT,
+// battery presence a VBAT ADC threshold with hysteresis. The first
+// observation after reset() only sets the baseline.
+class ConnectionEventDetector {
+ public:
+  static constexpr float BATTERY_PRESENT_MV = 2000.0f;
+  static constexpr float BATTERY_ABSENT_MV = 1000.0f;
+
+  // `measurements` may be null when the ADC result was not read this poll.
+  uint8_t observe(const Status &status, const Measurements *measurements, bool register_reset);
+  void reset() {
+    this->has_baseline_ = false;
+    this->battery_known_ = false;
+  }
+
+ private:
+  bool has_baseline_{false};
+  bool battery_known_{false};
+  bool input_present_{false};
+  bool battery_present_{false};
+  bool watchdog_expired_{false};
+};
+
+const char *connection_event_to_string(uint8_t event);
 const char *charge_status_to_string(uint8_t charge_status);
 const char *ts_status_to_string(uint8_t ts_status);
 const char *mppt_status_to_string(uint8_t mppt_status);
 ::component_common::ChargerState decode_charger_state(uint8_t status1);
 bool charger_fault_active(const Status &status);
+bool status_flags_set(const Status &status);
+// Flags that change the power path (input power good, DPM, charge state or a
+// fault) make the ADC block worth reading; TS, watchdog and other flags only
+// change the status bytes.
+bool status_flags_affect_measurements(const Status &status);
 ::component_common::ChargerSnapshot make_charger_snapshot(
     const Status &status, const Measurements &measurements,
     const ControlStates &controls, uint32_t sequence, uint32_t timestamp_ms);
@@ -527,6 +527,14 @@ static constexpr uint8_t REG24_ACTIVE_FAULT_MASK =
     REG24_IBAT_OCP_FAULT_MASK | REG24_VBAT_OV_FAULT_MASK |
     REG24_THERMAL_SHUTDOWN_FAULT_MASK |
     REG24_CHARGE_TIMER_FAULT_MASK | REG24_DRIVER_SUPPLY_FAULT_MASK;
+// REG25..27 latch a status change until read and pulse INT when unmasked.
+static constexpr uint8_t REG25_IAC_DPM_FLAG_MASK = 0x40;
+static constexpr uint8_t REG25_VAC_DPM_FLAG_MASK = 0x20;
+static constexpr uint8_t REG25_WATCHDOG_FLAG_MASK = 0x08;
+static constexpr uint8_t REG25_CHARGE_FLAG_MASK = 0x01;
+static constexpr uint8_t REG26_POWER_GOOD_FLAG_MASK = 0x80;
+static constexpr uint8_t REG26_TS_FLAG_MASK = 0x10;
+static constexpr uint8_t REG27_ACTIVE_FAULT_FLAG_MASK = REG24_ACTIVE_FAULT_MASK;
 
 static constexpr uint8_t REG2B_ADC_EN_MASK = 0x80;
 static constexpr uint8_t REG2B_ADC_RATE_MASK = 0x40;
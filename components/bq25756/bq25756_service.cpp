@@ -1,7 +1,69 @@
 #include "bq25756_service.h"
 
+#include <cmath>
+
 namespace bq25756_core {
 
+namespace {
+
+// REG21..REG27 (status and flags) and the ADC result block REG2D..REG3A are
+// contiguous, so a poll reads each with one transaction. REG35/36 inside the
+// ADC block are reserved and skipped when decoding.
+constexpr size_t STATUS_BLOCK_LEN = REG27_FAULT_FLAG - REG21_CHARGER_STATUS_1 + 1;
+constexpr size_t ADC_BLOCK_LEN = REG39_VFB_ADC + 2 - REG2D_IAC_ADC;
+constexpr size_t CONTROL_BLOCK_LEN = REG19_POWER_PATH_CONTROL - REG15_TIMER_CONTROL + 1;
+
+// The register-config layout is fixed, so its burst plan is too: six runs,
+// the longest REG10..REG1E. Reserved gaps between runs are never written.
+constexpr size_t CONFIG_BURST_MAX_LEN = 16;
+constexpr auto CONFIG_BURSTS =
+    component_common::plan_register_image_bursts(DEFAULT_CONFIGURATION_IMAGE, CONFIG_BURST_MAX_LEN);
+static_assert(CONFIG_BURSTS.count == 6, "BQ25756 register config should restore in six bursts");
+
+constexpr bool burst_contains(const component_common::RegisterImageBurst &burst, uint8_t reg) {
+  return reg >= burst.address && reg < burst.address + burst.length;
+}
+
+constexpr uint8_t REG17_RUNTIME_MASK =
+    static_cast<uint8_t>(register_info(RegisterId::CHARGER_CONTROL).masks.runtime);
+constexpr uint8_t REG19_RUNTIME_MASK =
+    static_cast<uint8_t>(register_info(RegisterId::POWER_PATH_CONTROL).masks.runtime);
+static_assert(REG19_POWER_PATH_CONTROL == REG17_CHARGER_CONTROL + 2, "REG17..REG19 are read as one block");
+
+Reg16Value reg16_at(const uint8_t *block, uint8_t block_base, uint8_t reg) {
+  const uint8_t *raw = block + (reg - block_base);
+  Reg16Value value{};
+  value.lsb = raw[0];
+  value.msb = raw[1];
+  value.raw_le = static_cast<uint16_t>(raw[0]) | (static_cast<uint16_t>(raw[1]) << 8);
+  return value;
+}
+
+// The burst stops after the last enabled channel, so a profile without TS and
+// VFB reads 8 bytes instead of 14.
+constexpr size_t adc_block_len(uint8_t channels) {
+  constexpr uint8_t CHANNEL_REGS[] = {REG2D_IAC_ADC, REG2F_IBAT_ADC, REG31_VAC_ADC,
+                                      REG33_VBAT_ADC, REG37_TS_ADC, REG39_VFB_ADC};
+  size_t len = 0;
+  for (size_t i = 0; i < sizeof(CHANNEL_REGS); i++) {
+    if ((channels & (1U << i)) != 0) {
+      len = CHANNEL_REGS[i] + 2 - REG2D_IAC_ADC;
+    }
+  }
+  return len;
+}
+static_assert(adc_block_len(ADC_CHANNELS_ALL) == ADC_BLOCK_LEN);
+static_assert(adc_block_len(ADC_CHANNEL_IBAT | ADC_CHANNEL_VBAT) == 8);
+
+// Only the configuration bits of REG2B are compared. A one-shot profile never
+// keeps ADC_EN set: it is the start/busy bit of the conversion in flight.
+constexpr uint8_t adc_compare_mask(const AdcProfile &profile) {
+  return profile.one_shot ? static_cast<uint8_t>(REG2B_ADC_PERSISTENT_MASK & ~REG2B_ADC_EN_MASK)
+                          : REG2B_ADC_PERSISTENT_MASK;
+}
+
+}  // namespace
+
 bool Bq25756Service::read_byte(uint8_t reg, uint8_t& value) {
   return this->read_bytes(reg, &value, 1);
 }
@@ -54,12 +116,14 @@ bool Bq25756Service::probe(uint8_t& part_info) {
 }
 
 bool Bq25756Service::set_charge_enabled(bool enabled) {
+  this->reg17_request_.record(REG17_EN_CHG_MASK, enabled);
   return this->update_register_bits(
     REG17_CHARGER_CONTROL, REG17_EN_CHG_MASK, enabled ? REG17_EN_CHG_MASK : 0x00
   );
 }
 
 bool Bq25756Service::set_hiz_mode(bool enabled) {
+  this->reg17_request_.record(REG17_EN_HIZ_MASK, enabled);
   return this->update_register_bits(
     REG17_CHARGER_CONTROL, REG17_EN_HIZ_MASK, enabled ? REG17_EN_HIZ_MASK : 0x00
   );
@@ -72,6 +136,7 @@ bool Bq25756Service::set_pfm_enabled(bool enabled) {
 }
 
 bool Bq25756Service::set_reverse_mode(bool enabled) {
+  this->reg19_request_.record(REG19_EN_REV_MASK, enabled);
   return this->update_register_bits(
     REG19_POWER_PATH_CONTROL, REG19_EN_REV_MASK, enabled ? REG19_EN_REV_MASK : 0x00
   );
@@ -91,50 +156,96 @@ bool Bq25756Service::reset_watchdog() {
 }
 
 bool Bq25756Service::read_status(Status& status) {
-  return this->read_byte(REG21_CHARGER_STATUS_1, status.status1) &&
-         this->read_byte(REG22_CHARGER_STATUS_2, status.status2) &&
-         this->read_byte(REG23_CHARGER_STATUS_3, status.status3) &&
-         this->read_byte(REG24_FAULT_STATUS, status.fault);
+  uint8_t block[STATUS_BLOCK_LEN] = {};
+  if (!this->read_bytes(REG21_CHARGER_STATUS_1, block, sizeof(block))) {
+    return false;
+  }
+  status.status1 = block[REG21_CHARGER_STATUS_1 - REG21_CHARGER_STATUS_1];
+  status.status2 = block[REG22_CHARGER_STATUS_2 - REG21_CHARGER_STATUS_1];
+  status.status3 = block[REG23_CHARGER_STATUS_3 - REG21_CHARGER_STATUS_1];
+  status.fault = block[REG24_FAULT_STATUS - REG21_CHARGER_STATUS_1];
+  status.flag1 = block[REG25_CHARGER_FLAG_1 - REG21_CHARGER_STATUS_1];
+  status.flag2 = block[REG26_CHARGER_FLAG_2 - REG21_CHARGER_STATUS_1];
+  status.fault_flag = block[REG27_FAULT_FLAG - REG21_CHARGER_STATUS_1];
+  const bool watchdog_expired = (status.status1 & REG21_WATCHDOG_STAT_MASK) != 0;
+  if ((status.fault & ~this->last_fault_status_) != 0 || (watchdog_expired && !this->last_watchdog_expired_)) {
+    this->adc_verified_ = false;
+  }
+  this->last_fault_status_ = status.fault;
+  this->last_watchdog_expired_ = watchdog_expired;
+  return true;
 }
 
 MeasurementReadResult Bq25756Service::read_measurements(
-  Measurements& measurements, bool include_vfb, uint8_t requested_adc_config, AdcConfigurationState& adc_state
+  Measurements& measurements, const AdcProfile& profile, AdcConfigurationState& adc_state
 ) {
-  const AdcEnsureResult adc_result =
-    this->ensure_adc_enabled(include_vfb, requested_adc_config, adc_state);
-  if (adc_result == AdcEnsureResult::REPAIRED) {
-    return MeasurementReadResult::CONFIGURATION_CHANGED;
+  if (!this->adc_profile_verified_(profile)) {
+    const AdcEnsureResult adc_result = this->ensure_adc_enabled(profile, adc_state);
+    if (adc_result == AdcEnsureResult::REPAIRED) {
+      return MeasurementReadResult::CONFIGURATION_CHANGED;
+    }
+    if (adc_result == AdcEnsureResult::IO_ERROR) {
+      return MeasurementReadResult::IO_ERROR;
+    }
+    if (adc_result == AdcEnsureResult::VERIFICATION_MISMATCH) {
+      return MeasurementReadResult::CONFIGURATION_VERIFY_MISMATCH;
+    }
   }
-  if (adc_result == AdcEnsureResult::IO_ERROR) {
+
+  uint8_t block[ADC_BLOCK_LEN] = {};
+  const size_t len = adc_block_len(profile.channels);
+  if (len != 0 && !this->read_bytes(REG2D_IAC_ADC, block, len)) {
+    this->adc_verified_ = false;
     return MeasurementReadResult::IO_ERROR;
   }
-  if (adc_result == AdcEnsureResult::VERIFICATION_MISMATCH) {
-    return MeasurementReadResult::CONFIGURATION_VERIFY_MISMATCH;
+  measurements = decode_measurements(
+    reg16_at(block, REG2D_IAC_ADC, REG2D_IAC_ADC), reg16_at(block, REG2D_IAC_ADC, REG2F_IBAT_ADC),
+    reg16_at(block, REG2D_IAC_ADC, REG31_VAC_ADC), reg16_at(block, REG2D_IAC_ADC, REG33_VBAT_ADC),
+    reg16_at(block, REG2D_IAC_ADC, REG37_TS_ADC), reg16_at(block, REG2D_IAC_ADC, REG39_VFB_ADC)
+  );
+  // Disabled channels hold stale or reset values; report them as unknown.
+  if ((profile.channels & ADC_CHANNEL_IAC) == 0) measurements.iac_ma = NAN;
+  if ((profile.channels & ADC_CHANNEL_IBAT) == 0) measurements.ibat_ma = NAN;
+  if ((profile.channels & ADC_CHANNEL_VAC) == 0) measurements.vac_mv = NAN;
+  if ((profile.channels & ADC_CHANNEL_VBAT) == 0) measurements.vbat_mv = NAN;
+  if ((profile.channels & ADC_CHANNEL_TS) == 0) measurements.ts_percent = NAN;
+  if ((profile.channels & ADC_CHANNEL_VFB) == 0) measurements.vfb_mv = NAN;
+  return MeasurementReadResult::OK;
+}
+
+AdcEnsureResult Bq25756Service::start_adc_conversion(const AdcProfile& profile, AdcConfigurationState& adc_state) {
+  AdcEnsureResult result = AdcEnsureResult::OK;
+  if (!this->adc_profile_verified_(profile)) {
+    result = this->ensure_adc_enabled(profile, adc_state);
+    if (result == AdcEnsureResult::IO_ERROR || result == AdcEnsureResult::VERIFICATION_MISMATCH) {
+      return result;
+    }
+  }
+  if (!this->write_byte(REG2B_ADC_CONTROL, adc_profile_reg2b(profile))) {
+    this->adc_verified_ = false;
+    return AdcEnsureResult::IO_ERROR;
   }
+  return result;
+}
 
-  Reg16Value iac{};
-  Reg16Value ibat{};
-  Reg16Value vac{};
-  Reg16Value vbat{};
-  Reg16Value ts{};
-  Reg16Value vfb{};
-  if (!this->read_u16_le(REG2D_IAC_ADC, iac) || !this->read_u16_le(REG2F_IBAT_ADC, ibat) ||
-      !this->read_u16_le(REG31_VAC_ADC, vac) || !this->read_u16_le(REG33_VBAT_ADC, vbat) ||
-      !this->read_u16_le(REG37_TS_ADC, ts) || (include_vfb && !this->read_u16_le(REG39_VFB_ADC, vfb))) {
-    return MeasurementReadResult::IO_ERROR;
+bool Bq25756Service::read_adc_conversion_done(bool& done) {
+  uint8_t reg2b = 0;
+  if (!this->read_byte(REG2B_ADC_CONTROL, reg2b)) {
+    this->adc_verified_ = false;
+    return false;
   }
-  measurements = decode_measurements(iac, ibat, vac, vbat, ts, vfb);
-  return MeasurementReadResult::OK;
+  done = (reg2b & REG2B_ADC_EN_MASK) == 0;
+  return true;
 }
 
 bool Bq25756Service::read_control_states(ControlStates& states) {
-  uint8_t reg15 = 0;
-  uint8_t reg17 = 0;
-  uint8_t reg19 = 0;
-  if (!this->read_byte(REG15_TIMER_CONTROL, reg15) || !this->read_byte(REG17_CHARGER_CONTROL, reg17) ||
-      !this->read_byte(REG19_POWER_PATH_CONTROL, reg19)) {
+  uint8_t block[CONTROL_BLOCK_LEN] = {};
+  if (!this->read_bytes(REG15_TIMER_CONTROL, block, sizeof(block))) {
     return false;
   }
+  const uint8_t reg15 = block[REG15_TIMER_CONTROL - REG15_TIMER_CONTROL];
+  const uint8_t reg17 = block[REG17_CHARGER_CONTROL - REG15_TIMER_CONTROL];
+  const uint8_t reg19 = block[REG19_POWER_PATH_CONTROL - REG15_TIMER_CONTROL];
 
   states.charge_enabled = (reg17 & REG17_EN_CHG_MASK) != 0;
   states.hiz_mode = (reg17 & REG17_EN_HIZ_MASK) != 0;
@@ -143,9 +254,8 @@ bool Bq25756Service::read_control_states(ControlStates& states) {
   return true;
 }
 
-AdcEnsureResult Bq25756Service::ensure_adc_enabled(
-  bool include_vfb, uint8_t requested_adc_config, AdcConfigurationState& adc_state
-) {
+AdcEnsureResult Bq25756Service::ensure_adc_enabled(const AdcProfile& profile, AdcConfigurationState& adc_state) {
+  this->adc_verified_ = false;
   uint8_t current[2] = {0, 0};
   if (!this->read_bytes(REG2B_ADC_CONTROL, current, sizeof(current))) {
     return AdcEnsureResult::IO_ERROR;
@@ -154,19 +264,17 @@ AdcEnsureResult Bq25756Service::ensure_adc_enabled(
   adc_state.old_reg2b = current[0];
   adc_state.old_reg2c = current[1];
 
-  adc_state.persistent_reg2b = static_cast<uint8_t>(requested_adc_config & REG2B_ADC_PERSISTENT_MASK);
-  adc_state.requested_reg2c = static_cast<uint8_t>(adc_state.old_reg2c & ~REG2C_ADC_CHANNEL_OWNED_MASK);
+  const uint8_t compare_mask = adc_compare_mask(profile);
+  // A one-shot profile is written idle; start_adc_conversion() sets ADC_EN.
+  adc_state.persistent_reg2b = static_cast<uint8_t>(adc_profile_reg2b(profile) & compare_mask);
+  adc_state.requested_reg2c = static_cast<uint8_t>(
+      (adc_state.old_reg2c & ~REG2C_ADC_CHANNEL_OWNED_MASK) | adc_profile_reg2c(profile));
 
-  if (!include_vfb) {
-    adc_state.requested_reg2c =
-      static_cast<uint8_t>(adc_state.requested_reg2c | REG2C_VFB_ADC_DIS_MASK);
-  }
-
-  const bool reg2b_changed =
-    (adc_state.old_reg2b & REG2B_ADC_PERSISTENT_MASK) != adc_state.persistent_reg2b;
+  const bool reg2b_changed = (adc_state.old_reg2b & compare_mask) != adc_state.persistent_reg2b;
   const bool reg2c_changed = adc_state.requested_reg2c != adc_state.old_reg2c;
   if (!reg2b_changed && !reg2c_changed) {
     adc_state.transient_reg2b = adc_state.persistent_reg2b;
+    this->mark_adc_verified_(profile);
     return AdcEnsureResult::OK;
   }
 
@@ -185,10 +293,11 @@ AdcEnsureResult Bq25756Service::ensure_adc_enabled(
     return AdcEnsureResult::IO_ERROR;
   }
 
-  if ((verify[0] & REG2B_ADC_PERSISTENT_MASK) != adc_state.persistent_reg2b ||
+  if ((verify[0] & compare_mask) != adc_state.persistent_reg2b ||
       verify[1] != adc_state.requested_reg2c) {
     return AdcEnsureResult::VERIFICATION_MISMATCH;
   }
+  this->mark_adc_verified_(profile);
   return AdcEnsureResult::REPAIRED;
 }
 
@@ -243,8 +352,7 @@ bool Bq25756Service::read_charge_precheck(ChargePrecheckSnapshot& snapshot) {
   AdcConfigurationState adc_state{};
   if (!this->read_byte(REG17_CHARGER_CONTROL, snapshot.reg17) ||
       !this->read_byte(REG19_POWER_PATH_CONTROL, snapshot.reg19) || !this->read_status(snapshot.status) ||
-      this->read_measurements(snapshot.measurements, false, REG2B_ADC_CONTINUOUS_15_BIT,
-                              adc_state) != MeasurementReadResult::OK) {
+      this->read_measurements(snapshot.measurements, ADC_PROFILE_TELEMETRY, adc_state) != MeasurementReadResult::OK) {
     return false;
   }
 
@@ -344,4 +452,90 @@ bool Bq25756Service::reconcile_configuration(
   return result.io_ok && result.matches;
 }
 
+bool Bq25756Service::restore_configuration(const Bq25756ConfigurationImage &image,
+                                           ConfigurationReconcileResult &result) {
+  result = {};
+  result.desired_fingerprint = component_common::configuration_fingerprint(image);
+
+  // Charging, HIZ and reverse mode are not configuration: they keep what the
+  // charger holds, with any state requested through the setters laid over it.
+  uint8_t control[REG19_POWER_PATH_CONTROL - REG17_CHARGER_CONTROL + 1] = {};
+  if (!this->read_bytes(REG17_CHARGER_CONTROL, control, sizeof(control))) {
+    result.io_ok = false;
+    result.matches = false;
+    return false;
+  }
+  const uint8_t reg17_runtime = this->reg17_request_.apply(control[0], REG17_RUNTIME_MASK);
+  const uint8_t reg19_runtime =
+      this->reg19_request_.apply(control[REG19_POWER_PATH_CONTROL - REG17_CHARGER_CONTROL], REG19_RUNTIME_MASK);
+  uint32_t reg17_written = 0;
+
+  for (uint8_t pass = 0; pass < 2; pass++) {
+    for (size_t index = 0; index < CONFIG_BURSTS.count; index++) {
+      const auto &burst = CONFIG_BURSTS.bursts[index];
+      if (burst_contains(burst, REG17_CHARGER_CONTROL) != (pass == 0)) {
+        continue;
+      }
+      uint8_t raw[CONFIG_BURST_MAX_LEN] = {};
+      size_t offset = 0;
+      for (size_t entry = burst.first_entry; entry < burst.first_entry + burst.entry_count; entry++) {
+        uint32_t value = component_common::register_image_write_value(image[entry]);
+        if (image[entry].address == REG17_CHARGER_CONTROL) {
+          // Charging stays off until the limits below are in place.
+          value |= reg17_runtime & ~REG17_EN_CHG_MASK;
+          reg17_written = value;
+        } else if (image[entry].address == REG19_POWER_PATH_CONTROL) {
+          value |= reg19_runtime;
+        }
+        for (uint8_t byte = 0; byte < image[entry].width; byte++) {
+          raw[offset++] = static_cast<uint8_t>((value >> (byte * 8U)) & 0xFFU);
+        }
+      }
+      if (!this->write_bytes(static_cast<uint8_t>(burst.address), raw, burst.length)) {
+        result.io_ok = false;
+        result.matches = false;
+        return false;
+      }
+    }
+  }
+  if ((reg17_runtime & REG17_EN_CHG_MASK) != 0 &&
+      !this->write_byte(REG17_CHARGER_CONTROL, static_cast<uint8_t>(reg17_written | REG17_EN_CHG_MASK))) {
+    result.io_ok = false;
+    result.matches = false;
+    return false;
+  }
+  // REG2B/2C were rewritten with the image's ADC setup.
+  this->invalidate_adc_configuration();
+  result.repaired = true;
+  result.repaired_count = image.size();
+
+  result.observed_fingerprint = component_common::FNV1A_OFFSET_BASIS;
+  for (size_t index = 0; index < CONFIG_BURSTS.count; index++) {
+    const auto &burst = CONFIG_BURSTS.bursts[index];
+    uint8_t raw[CONFIG_BURST_MAX_LEN] = {};
+    if (!this->read_bytes(static_cast<uint8_t>(burst.address), raw, burst.length)) {
+      result.io_ok = false;
+      result.matches = false;
+      return false;
+    }
+    size_t offset = 0;
+    for (size_t entry = burst.first_entry; entry < burst.first_entry + burst.entry_count; entry++) {
+      uint32_t actual = 0;
+      for (uint8_t byte = 0; byte < image[entry].width; byte++) {
+        actual |= static_cast<uint32_t>(raw[offset++]) << (byte * 8U);
+      }
+      result.observed_fingerprint =
+          component_common::fingerprint_register_value(result.observed_fingerprint, image[entry], actual);
+      if (!component_common::register_value_matches(actual, image[entry].value, image[entry].mask)) {
+        if (result.remaining_mismatch_count == 0) {
+          result.first_mismatch_address = image[entry].address;
+        }
+        result.matches = false;
+        result.remaining_mismatch_count++;
+      }
+    }
+  }
+  return result.matches;
+}
+
 }  // namespace bq25756_core
@@ -61,13 +61,26 @@ class Bq25756Service {
   bool set_reverse_mode(bool enabled);
   bool set_watchdog_code(uint8_t code);
   bool reset_watchdog();
+  // REG21..REG27 in one burst, clearing the flags. A newly set fault bit or
+  // watchdog expiry marks the ADC configuration for re-verification on the
+  // next measurement read.
   bool read_status(Status &status);
-  MeasurementReadResult read_measurements(Measurements &measurements, bool include_vfb,
-                                           uint8_t requested_adc_config,
+  // The enabled channels of `profile` in one burst that ends after the last
+  // of them; disabled channels decode as NAN. REG2B/2C are verified only on
+  // the first read, after invalidate_adc_configuration(), a status fault, an
+  // I/O error or a profile change. For a one-shot profile this returns the
+  // result of the last completed conversion.
+  MeasurementReadResult read_measurements(Measurements &measurements, const AdcProfile &profile,
                                            AdcConfigurationState &adc_state);
   bool read_control_states(ControlStates &states);
-  AdcEnsureResult ensure_adc_enabled(bool include_vfb, uint8_t requested_adc_config,
-                                     AdcConfigurationState &adc_state);
+  AdcEnsureResult ensure_adc_enabled(const AdcProfile &profile, AdcConfigurationState &adc_state);
+  // One-shot profiles: applies the profile if needed, then sets ADC_EN to
+  // convert every enabled channel once. The charger clears ADC_EN when done.
+  AdcEnsureResult start_adc_conversion(const AdcProfile &profile, AdcConfigurationState &adc_state);
+  bool read_adc_conversion_done(bool &done);
+  // Call after a charger reset or any event that may have rewritten REG2B/2C.
+  void invalidate_adc_configuration() { this->adc_verified_ = false; }
+  bool adc_configuration_verified() const { return this->adc_verified_; }
   bool apply_limits(bool has_charge_voltage_limit_mv, uint16_t charge_voltage_limit_mv,
                     bool has_charge_current_limit_ma, uint16_t charge_current_limit_ma,
                     bool has_input_current_dpm_limit_ma, uint16_t input_current_dpm_limit_ma,
@@ -77,12 +90,49 @@ class Bq25756Service {
   bool read_charge_precheck(ChargePrecheckSnapshot &snapshot);
   bool reconcile_configuration(const Bq25756ConfigurationImage &image, bool repair,
                                ConfigurationReconcileResult &result);
+  // Restore for a charger that may be at reset defaults: every image
+  // register is written whole, one burst per contiguous address run, then
+  // the same runs are read back once to verify. The REG17..REG19 runtime
+  // bits are read first and kept, overridden by the last charge, HIZ and
+  // reverse-mode requests. The REG17 burst goes first with charging off, and
+  // charging is re-enabled by one more write once the limits are in place.
+  bool restore_configuration(const Bq25756ConfigurationImage &image,
+                             ConfigurationReconcileResult &result);
 
  private:
   bool read_register_value_(const component_common::RegisterImageEntry &entry, uint32_t &value);
   bool write_register_value_(const component_common::RegisterImageEntry &entry, uint32_t value);
+  bool adc_profile_verified_(const AdcProfile &profile) const {
+    return this->adc_verified_ && this->adc_verified_reg2b_ == adc_profile_reg2b(profile) &&
+           this->adc_verified_reg2c_ == adc_profile_reg2c(profile);
+  }
+  void mark_adc_verified_(const AdcProfile &profile) {
+    this->adc_verified_ = true;
+    this->adc_verified_reg2b_ = adc_profile_reg2b(profile);
+    this->adc_verified_reg2c_ = adc_profile_reg2c(profile);
+  }
+
+  // Runtime bits last requested through the setters, kept across restores.
+  struct RuntimeRequest {
+    void record(uint8_t bit, bool enabled) {
+      this->mask |= bit;
+      this->bits = static_cast<uint8_t>(enabled ? (this->bits | bit) : (this->bits & ~bit));
+    }
+    uint8_t apply(uint8_t current, uint8_t runtime_mask) const {
+      return static_cast<uint8_t>(((current & ~this->mask) | (this->bits & this->mask)) & runtime_mask);
+    }
+    uint8_t mask{0};
+    uint8_t bits{0};
+  };
 
   RegisterBus *bus_{nullptr};
+  RuntimeRequest reg17_request_;
+  RuntimeRequest reg19_request_;
+  bool adc_verified_{false};
+  uint8_t adc_verified_reg2b_{0};
+  uint8_t adc_verified_reg2c_{0};
+  uint8_t last_fault_status_{0};
+  bool last_watchdog_expired_{false};
 };
 
 }  // namespace bq25756_core
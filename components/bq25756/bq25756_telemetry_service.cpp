@@ -0,0 +1,103 @@
+#include "bq25756_telemetry_service.h"
+
+#include <cmath>
+
+namespace bq25756_core {
+
+namespace {
+
+constexpr float MS_PER_HOUR = 3600000.0f;
+
+}  // namespace
+
+void TelemetryAccumulator::add(float value) {
+  if (this->count_ == 0 || value < this->min_) {
+    this->min_ = value;
+  }
+  if (this->count_ == 0 || value > this->max_) {
+    this->max_ = value;
+  }
+  this->sum_ += value;
+  this->count_++;
+}
+
+TelemetryStats TelemetryAccumulator::stats() const {
+  TelemetryStats stats{};
+  if (this->count_ == 0) {
+    return stats;
+  }
+  stats.min = this->min_;
+  stats.max = this->max_;
+  stats.mean = this->sum_ / static_cast<float>(this->count_);
+  stats.count = this->count_;
+  return stats;
+}
+
+void TelemetryAggregator::start(uint32_t now_ms) {
+  for (auto &accumulator : this->accumulators_) {
+    accumulator.reset();
+  }
+  this->charge_state_ms_.fill(0);
+  this->window_start_ms_ = now_ms;
+  this->samples_ = 0;
+  this->input_energy_wh_ = 0.0f;
+  this->output_energy_wh_ = 0.0f;
+}
+
+void TelemetryAggregator::add(uint32_t now_ms, const Status &status, const Measurements &measurements) {
+  const float input_v = measurements.vac_mv / 1000.0f;
+  const float input_a = measurements.iac_ma / 1000.0f;
+  const float output_v = measurements.vbat_mv / 1000.0f;
+  const float output_a = measurements.ibat_ma / 1000.0f;
+  const float input_w = input_v * input_a;
+  const float output_w = output_v * output_a;
+  // An ADC profile without one of the power channels leaves it NAN.
+  if (!std::isfinite(input_w) || !std::isfinite(output_w)) {
+    return;
+  }
+
+  const std::array<float, TELEMETRY_CHANNEL_COUNT> values{{input_v, input_a, output_v, output_a, input_w, output_w}};
+  for (size_t i = 0; i < TELEMETRY_CHANNEL_COUNT; i++) {
+    this->accumulators_[i].add(values[i]);
+  }
+  this->samples_++;
+
+  if (this->has_previous_) {
+    const uint32_t dt_ms = now_ms - this->previous_ms_;
+    if (dt_ms <= this->max_gap_ms_) {
+      const float hours = static_cast<float>(dt_ms) / MS_PER_HOUR;
+      const float input_wh = (this->previous_input_w_ + input_w) * 0.5f * hours;
+      const float output_wh = (this->previous_output_w_ + output_w) * 0.5f * hours;
+      this->input_energy_wh_ += input_wh;
+      this->output_energy_wh_ += output_wh;
+      this->total_input_energy_wh_ += input_wh;
+      this->total_output_energy_wh_ += output_wh;
+      this->charge_state_ms_[this->previous_charge_state_] += dt_ms;
+    }
+  }
+  this->has_previous_ = true;
+  this->previous_ms_ = now_ms;
+  this->previous_input_w_ = input_w;
+  this->previous_output_w_ = output_w;
+  this->previous_charge_state_ = static_cast<uint8_t>(status.status1 & REG21_CHARGE_STAT_MASK);
+}
+
+TelemetryWindow TelemetryAggregator::take_window(uint32_t now_ms) {
+  TelemetryWindow window{};
+  window.duration_ms = now_ms - this->window_start_ms_;
+  window.samples = this->samples_;
+  for (size_t i = 0; i < TELEMETRY_CHANNEL_COUNT; i++) {
+    window.channels[i] = this->accumulators_[i].stats();
+  }
+  window.input_energy_wh = this->input_energy_wh_;
+  window.output_energy_wh = this->output_energy_wh_;
+  window.has_efficiency = this->input_energy_wh_ >= MIN_EFFICIENCY_INPUT_WH && this->output_energy_wh_ > 0.0f;
+  if (window.has_efficiency) {
+    window.efficiency = this->output_energy_wh_ / this->input_energy_wh_;
+  }
+  window.charge_state_ms = this->charge_state_ms_;
+  this->start(now_ms);
+  return window;
+}
+
+}  // namespace bq25756_core
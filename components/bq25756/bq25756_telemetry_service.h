@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "bq25756_protocol.h"
+
+namespace bq25756_core {
+
+static constexpr size_t CHARGE_STATE_COUNT = 8;
+
+enum class TelemetryChannel : uint8_t {
+  INPUT_VOLTAGE = 0,
+  INPUT_CURRENT,
+  OUTPUT_VOLTAGE,
+  OUTPUT_CURRENT,
+  INPUT_POWER,
+  OUTPUT_POWER,
+  COUNT,
+};
+
+static constexpr size_t TELEMETRY_CHANNEL_COUNT = static_cast<size_t>(TelemetryChannel::COUNT);
+
+// Volts, amps and watts over one window.
+struct TelemetryStats {
+  float min{0.0f};
+  float max{0.0f};
+  float mean{0.0f};
+  uint32_t count{0};
+};
+
+class TelemetryAccumulator {
+ public:
+  void add(float value);
+  void reset() { *this = TelemetryAccumulator{}; }
+  TelemetryStats stats() const;
+
+ protected:
+  float min_{0.0f};
+  float max_{0.0f};
+  float sum_{0.0f};
+  uint32_t count_{0};
+};
+
+struct TelemetryWindow {
+  uint32_t duration_ms{0};
+  uint32_t samples{0};
+  std::array<TelemetryStats, TELEMETRY_CHANNEL_COUNT> channels{};
+  float input_energy_wh{0.0f};
+  float output_energy_wh{0.0f};
+  // Output over input energy; false when the window moved too little input
+  // energy or ran in reverse mode.
+  bool has_efficiency{false};
+  float efficiency{0.0f};
+  // Integrated time per REG21 CHARGE_STAT code.
+  std::array<uint32_t, CHARGE_STATE_COUNT> charge_state_ms{};
+
+  const TelemetryStats &channel(TelemetryChannel id) const { return this->channels[static_cast<size_t>(id)]; }
+};
+
+// Integrates input (VAC * IAC) and output (VBAT * IBAT) power between polls
+// with the trapezoid rule and reduces each channel to min/max/mean, so the
+// component can publish at a window rate instead of per poll. Energy totals
+// run across windows; the charge-state time of each interval is attributed to
+// the state read at its start.
+class TelemetryAggregator {
+ public:
+  // Polls further apart than the integration gap, e.g. across a disconnect,
+  // are not integrated; the next sample starts a new interval. The gap is
+  // this default or two and a half poll intervals, whichever is longer, so
+  // one late or missed poll is still integrated.
+  static constexpr uint32_t DEFAULT_MAX_INTEGRATION_GAP_MS = 5000;
+  static constexpr float MIN_EFFICIENCY_INPUT_WH = 0.001f;
+
+  void set_poll_interval_ms(uint32_t interval_ms) {
+    const uint64_t gap_ms = static_cast<uint64_t>(interval_ms) * 5 / 2;
+    this->max_gap_ms_ = gap_ms > UINT32_MAX                       ? UINT32_MAX
+                        : gap_ms > DEFAULT_MAX_INTEGRATION_GAP_MS ? static_cast<uint32_t>(gap_ms)
+                                                                  : DEFAULT_MAX_INTEGRATION_GAP_MS;
+  }
+  uint32_t max_integration_gap_ms() const { return this->max_gap_ms_; }
+
+  void start(uint32_t now_ms);
+  // Samples missing a power channel (NAN) are skipped.
+  void add(uint32_t now_ms, const Status &status, const Measurements &measurements);
+  bool window_elapsed(uint32_t now_ms, uint32_t window_ms) const {
+    return now_ms - this->window_start_ms_ >= window_ms;
+  }
+  // Closes the current window at now_ms and opens the next one.
+  TelemetryWindow take_window(uint32_t now_ms);
+
+  double total_input_energy_wh() const { return this->total_input_energy_wh_; }
+  double total_output_energy_wh() const { return this->total_output_energy_wh_; }
+
+ protected:
+  std::array<TelemetryAccumulator, TELEMETRY_CHANNEL_COUNT> accumulators_{};
+  std::array<uint32_t, CHARGE_STATE_COUNT> charge_state_ms_{};
+  uint32_t max_gap_ms_{DEFAULT_MAX_INTEGRATION_GAP_MS};
+  uint32_t window_start_ms_{0};
+  uint32_t samples_{0};
+  float input_energy_wh_{0.0f};
+  float output_energy_wh_{0.0f};
+  double total_input_energy_wh_{0.0};
+  double total_output_energy_wh_{0.0};
+  bool has_previous_{false};
+  uint32_t previous_ms_{0};
+  float previous_input_w_{0.0f};
+  float previous_output_w_{0.0f};
+  uint8_t previous_charge_state_{0};
+};
+
+}  // namespace bq25756_core
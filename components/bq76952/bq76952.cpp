@@ -127,8 +127,9 @@ void BQ76952Component::publish_connection_state(component_common::ConnectionStat
 }
 
 void BQ76952Component::publish_snapshot(const ::bq76952_core::Snapshot &snapshot) {
-  if (this->state_sensor_ != nullptr) {
-    this->state_sensor_->publish_state(::bq76952_core::operating_state_to_string(snapshot.operating_state));
+  const char *state = ::bq76952_core::operating_state_to_string(snapshot.operating_state);
+  if (this->state_sensor_ != nullptr && this->state_guard_.changed(state)) {
+    this->state_sensor_->publish_state(state);
   }
   this->publish_faults(snapshot);
   if (this->capacity_calibration_status_sensor_ != nullptr) {
@@ -192,7 +193,9 @@ void BQ76952Component::publish_faults(const ::bq76952_core::Snapshot &snapshot)
   if (this->fault_sensor_ != nullptr) {
     char faults[256];
     ::bq76952_core::format_faults(snapshot.active_faults, faults, sizeof(faults));
-    this->fault_sensor_->publish_state(faults);
+    if (this->fault_guard_.changed(faults)) {
+      this->fault_sensor_->publish_state(faults);
+    }
   }
 }
 
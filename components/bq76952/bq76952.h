@@ -8,6 +8,7 @@
 #include "esphome/components/text_sensor/text_sensor.h"
 #include "esphome/core/component.h"
 
+#include "../component_common/fixed_string.h"
 #include "bq76952_config.h"
 #include "bq76952_i2c_transport.h"
 #include "bq76952_service.h"
@@ -74,6 +75,8 @@ class BQ76952Component : public PollingComponent, public BQ76952I2CTransport {
   text_sensor::TextSensor *state_sensor_{nullptr};
   text_sensor::TextSensor *fault_sensor_{nullptr};
   text_sensor::TextSensor *capacity_calibration_status_sensor_{nullptr};
+  component_common::PublishGuard state_guard_{};
+  component_common::PublishGuard fault_guard_{};
 
   switch_::Switch *output_enabled_switch_{nullptr};
 };
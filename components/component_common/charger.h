@@ -36,14 +36,39 @@ struct ChargerSnapshot {
   bool power_good{false};
   bool fault_active{false};
   bool valid{false};
+  // ADC timing at timestamp_ms: the oldest any measurement may be, and how
+  // long one conversion of the sampled channels takes. Zero when unknown.
+  uint32_t sample_age_us{0};
+  uint32_t conversion_latency_us{0};
 };
 
+// Chargers publish a snapshot from their own poll; consumers read it in place
+// and use the sequence number to skip work until the next one. Reading never
+// touches the bus.
 class ChargerInterface {
  public:
   virtual ~ChargerInterface() = default;
   virtual ChargerCapabilities capabilities() const = 0;
-  virtual ChargerSnapshot snapshot() const = 0;
   virtual bool request_enabled(bool enabled) = 0;
+
+  // Overwritten in place by the next publish; valid for the charger's lifetime.
+  const ChargerSnapshot &latest_snapshot() const { return this->latest_snapshot_; }
+  ChargerSnapshot snapshot() const { return this->latest_snapshot_; }
+  // Sequence 0 means nothing was published yet.
+  uint32_t sample_sequence() const { return this->latest_snapshot_.sequence; }
+  bool has_new_sample(uint32_t seen_sequence) const { return this->latest_snapshot_.sequence != seen_sequence; }
+
+ protected:
+  // Stamps the next sequence number; any change a consumer should see,
+  // including loss of validity, is published this way.
+  void publish_snapshot_(const ChargerSnapshot &snapshot) {
+    const uint32_t sequence = this->latest_snapshot_.sequence + 1U;
+    this->latest_snapshot_ = snapshot;
+    this->latest_snapshot_.sequence = sequence == 0 ? 1U : sequence;
+  }
+
+ private:
+  ChargerSnapshot latest_snapshot_{};
 };
 
 inline const char *charger_state_to_string(ChargerState state) {
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace component_common {
+
+// Reflected CRC-32 (polynomial 0xEDB88320), bit by bit so no table is kept.
+// Seed with 0xFFFFFFFF and invert the final value for the standard checksum.
+inline uint32_t crc32_update(uint32_t crc, const void *data, size_t size) {
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  for (size_t index = 0; index < size; ++index) {
+    crc ^= bytes[index];
+    for (int bit = 0; bit < 8; ++bit) {
+      crc = (crc >> 1) ^ (0xEDB88320U & (0U - (crc & 1U)));
+    }
+  }
+  return crc;
+}
+
+// Feed records field by field so struct padding never reaches the checksum.
+template<typename T> uint32_t crc32_field(uint32_t crc, const T &value) {
+  return crc32_update(crc, &value, sizeof(value));
+}
+
+}  // namespace component_common
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstdarg>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string_view>
+
+#include "register_manifest.h"
+
+namespace component_common {
+
+// NUL-terminated text built in place in a fixed array. It never allocates:
+// appends beyond the capacity are cut at the last byte that fits and
+// `truncated()` reports it.
+template<size_t Capacity> class FixedString {
+  static_assert(Capacity > 0, "FixedString needs room for text");
+
+ public:
+  FixedString() = default;
+  explicit FixedString(const char *text) { this->append(text); }
+
+  static constexpr size_t capacity() { return Capacity; }
+
+  void clear() {
+    this->length_ = 0;
+    this->truncated_ = false;
+    this->data_[0] = '\0';
+  }
+
+  FixedString &append(std::string_view text) {
+    const size_t room = Capacity - this->length_;
+    const size_t count = text.size() < room ? text.size() : room;
+    if (count != 0)
+      std::memcpy(this->data_ + this->length_, text.data(), count);
+    this->length_ += count;
+    this->data_[this->length_] = '\0';
+    if (count != text.size())
+      this->truncated_ = true;
+    return *this;
+  }
+
+  FixedString &append(const char *text) { return this->append(std::string_view(text == nullptr ? "" : text)); }
+
+  FixedString &append(char c) { return this->append(std::string_view(&c, 1)); }
+
+  // A list item, preceded by `separator` unless the text is still empty.
+  FixedString &append_item(std::string_view item, std::string_view separator) {
+    if (this->length_ != 0)
+      this->append(separator);
+    return this->append(item);
+  }
+
+  FixedString &appendf(const char *format, ...) __attribute__((format(printf, 2, 3))) {
+    const size_t room = Capacity - this->length_;
+    va_list args;
+    va_start(args, format);
+    const int written = std::vsnprintf(this->data_ + this->length_, room + 1, format, args);
+    va_end(args);
+    if (written < 0) {
+      this->data_[this->length_] = '\0';
+      this->truncated_ = true;
+    } else if (static_cast<size_t>(written) > room) {
+      this->length_ = Capacity;
+      this->truncated_ = true;
+    } else {
+      this->length_ += static_cast<size_t>(written);
+    }
+    return *this;
+  }
+
+  const char *c_str() const { return this->data_; }
+  std::string_view view() const { return std::string_view(this->data_, this->length_); }
+  size_t size() const { return this->length_; }
+  bool empty() const { return this->length_ == 0; }
+  bool truncated() const { return this->truncated_; }
+
+  bool operator==(std::string_view other) const { return this->view() == other; }
+  bool operator!=(std::string_view other) const { return this->view() != other; }
+
+ private:
+  char data_[Capacity + 1]{};
+  size_t length_{0};
+  bool truncated_{false};
+};
+
+// FNV-1a, the same hash as the register configuration fingerprints.
+constexpr uint32_t text_fingerprint(std::string_view text) {
+  uint32_t fingerprint = FNV1A_OFFSET_BASIS;
+  for (const char c : text)
+    fingerprint = fingerprint_append_byte(fingerprint, static_cast<uint8_t>(c));
+  return fingerprint;
+}
+
+// Remembers a 32-bit hash of the last text published to one entity so an
+// unchanged value is not published again. A hash collision suppresses one
+// real change, which the next different value corrects.
+class PublishGuard {
+ public:
+  // True, recording the text, when it differs from the last one accepted.
+  bool changed(std::string_view text) {
+    const uint32_t fingerprint = text_fingerprint(text);
+    if (this->has_value_ && fingerprint == this->fingerprint_)
+      return false;
+    this->fingerprint_ = fingerprint;
+    this->has_value_ = true;
+    return true;
+  }
+
+  bool has_value() const { return this->has_value_; }
+  // Forces the next text through, e.g. after the entity was cleared elsewhere.
+  void reset() { this->has_value_ = false; }
+
+ private:
+  uint32_t fingerprint_{0};
+  bool has_value_{false};
+};
+
+}  // namespace component_common
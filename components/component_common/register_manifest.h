@@ -160,6 +160,51 @@ constexpr bool register_value_matches(uint32_t actual, uint32_t desired,
   return (actual & mask) == (desired & mask);
 }
 
+// Full register value for a write-only restore: the image value with command
+// bits cleared. Bits outside the image mask are written as given, so the image
+// value must carry the reset defaults for them.
+constexpr uint32_t register_image_write_value(const RegisterImageEntry &entry) {
+  return entry.value & ~entry.command_mask & register_width_mask(entry.width);
+}
+
+// Consecutive image entries whose registers are adjacent, transferred as one
+// multi-byte transaction.
+struct RegisterImageBurst {
+  uint16_t address{0};
+  uint8_t length{0};
+  uint8_t first_entry{0};
+  uint8_t entry_count{0};
+};
+
+template<size_t N>
+struct RegisterImageBurstPlan {
+  std::array<RegisterImageBurst, N> bursts{};
+  size_t count{0};
+};
+
+// Groups an address-ordered image into the fewest bursts of at most
+// max_length bytes. Gaps between entries are never written.
+template<size_t N>
+constexpr RegisterImageBurstPlan<N> plan_register_image_bursts(
+    const std::array<RegisterImageEntry, N> &image, size_t max_length) {
+  RegisterImageBurstPlan<N> plan{};
+  for (size_t index = 0; index < N; index++) {
+    const auto &entry = image[index];
+    if (plan.count > 0) {
+      auto &last = plan.bursts[plan.count - 1];
+      if (static_cast<uint32_t>(last.address) + last.length == entry.address &&
+          static_cast<size_t>(last.length) + entry.width <= max_length) {
+        last.length = static_cast<uint8_t>(last.length + entry.width);
+        last.entry_count++;
+        continue;
+      }
+    }
+    plan.bursts[plan.count++] = {entry.address, entry.width,
+                                 static_cast<uint8_t>(index), 1};
+  }
+  return plan;
+}
+
 constexpr uint32_t FNV1A_OFFSET_BASIS = 2166136261UL;
 constexpr uint32_t FNV1A_PRIME = 16777619UL;
 
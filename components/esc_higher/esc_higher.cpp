@@ -33,6 +33,15 @@ void publish_text(text_sensor::TextSensor* sensor, const std::string& value) {
     sensor->publish_state(value);
 }
 
+void publish_text(GuardedTextSensor& text, const char* value) {
+  if (text.sensor != nullptr && text.guard.changed(value))
+    text.sensor->publish_state(value);
+}
+
+template<size_t N> void publish_text(GuardedTextSensor& text, const ::component_common::FixedString<N>& value) {
+  publish_text(text, value.c_str());
+}
+
 // Wire format: flat packed, no padding, little-endian (123 bytes total)
 constexpr size_t MOTOR_CONFIG_WIRE_SIZE = 123;
 constexpr size_t MOTOR_CONFIG_WIRE_CRC_OFFSET = 118;
@@ -66,19 +75,22 @@ uint32_t crc32_ieee_continue_(uint32_t crc, const uint8_t* data, size_t len) {
   return crc;
 }
 
-std::string current_fault_text_(uint8_t esc_state, uint8_t fault_detail, uint16_t current_faults,
-                                uint16_t status_flags, uint8_t bringup_state, uint8_t bringup_result) {
+NameListText current_fault_text_(uint8_t esc_state, uint8_t fault_detail, uint16_t current_faults,
+                                 uint16_t status_flags, uint8_t bringup_state, uint8_t bringup_result) {
   if (current_faults != 0)
     return fault_bitmask_to_names(current_faults);
+  NameListText out;
   if ((status_flags & (1u << 2)) != 0)
-    return "watchdog_timeout";
-  if (fault_detail != 0)
-    return fault_detail_to_cstr(fault_detail);
-  if ((bringup_state == 3 || bringup_state == 4) && bringup_result != 0 && bringup_result != 17)
-    return std::string("bringup_") + bringup_result_to_cstr(bringup_result);
-  if (esc_state == 4)
-    return "fault";
-  return "none";
+    out.append("watchdog_timeout");
+  else if (fault_detail != 0)
+    out.append(fault_detail_to_cstr(fault_detail));
+  else if ((bringup_state == 3 || bringup_state == 4) && bringup_result != 0 && bringup_result != 17)
+    out.append("bringup_").append(bringup_result_to_cstr(bringup_result));
+  else if (esc_state == 4)
+    out.append("fault");
+  else
+    out.append("none");
+  return out;
 }
 
 }  // namespace
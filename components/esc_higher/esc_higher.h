@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "esc_higher_registers.h"
+#include "../component_common/fixed_string.h"
 
 #include "esphome/components/button/button.h"
 #include "esphome/components/i2c/i2c.h"
@@ -22,6 +23,13 @@ namespace esc_higher {
 
 class ESCHigherComponent;
 
+// A text entity and the hash of the text last published to it; status and
+// telemetry both carry the state texts, so most polls repeat them.
+struct GuardedTextSensor {
+  text_sensor::TextSensor* sensor{nullptr};
+  ::component_common::PublishGuard guard{};
+};
+
 class ESCHigherStartButton : public button::Button, public Parented<ESCHigherComponent> {
  public:
   void press_action() override;
@@ -361,46 +369,46 @@ class ESCHigherComponent : public PollingComponent, public i2c::I2CDevice {
   }
 
   void set_esc_state_text_sensor(text_sensor::TextSensor* s) {
-    esc_state_text_sensor_ = s;
+    esc_state_text_sensor_.sensor = s;
   }
   void set_last_cmd_error_text_sensor(text_sensor::TextSensor* s) {
-    last_cmd_error_text_sensor_ = s;
+    last_cmd_error_text_sensor_.sensor = s;
   }
   void set_fault_detail_text_sensor(text_sensor::TextSensor* s) {
-    fault_detail_text_sensor_ = s;
+    fault_detail_text_sensor_.sensor = s;
   }
   void set_current_fault_text_sensor(text_sensor::TextSensor* s) {
-    current_fault_text_sensor_ = s;
+    current_fault_text_sensor_.sensor = s;
   }
   void set_status_flags_text_sensor(text_sensor::TextSensor* s) {
-    status_flags_text_sensor_ = s;
+    status_flags_text_sensor_.sensor = s;
   }
   void set_current_faults_text_sensor(text_sensor::TextSensor* s) {
-    current_faults_text_sensor_ = s;
+    current_faults_text_sensor_.sensor = s;
   }
   void set_occurred_faults_text_sensor(text_sensor::TextSensor* s) {
-    occurred_faults_text_sensor_ = s;
+    occurred_faults_text_sensor_.sensor = s;
   }
   void set_capabilities_text_sensor(text_sensor::TextSensor* s) {
-    capabilities_text_sensor_ = s;
+    capabilities_text_sensor_.sensor = s;
   }
   void set_mc_state_text_sensor(text_sensor::TextSensor* s) {
-    mc_state_text_sensor_ = s;
+    mc_state_text_sensor_.sensor = s;
   }
   void set_bringup_state_text_sensor(text_sensor::TextSensor* s) {
-    bringup_state_text_sensor_ = s;
+    bringup_state_text_sensor_.sensor = s;
   }
   void set_bringup_result_text_sensor(text_sensor::TextSensor* s) {
-    bringup_result_text_sensor_ = s;
+    bringup_result_text_sensor_.sensor = s;
   }
   void set_bringup_test_id_text_sensor(text_sensor::TextSensor* s) {
-    bringup_test_id_text_sensor_ = s;
+    bringup_test_id_text_sensor_.sensor = s;
   }
   void set_bringup_current_faults_text_sensor(text_sensor::TextSensor* s) {
-    bringup_current_faults_text_sensor_ = s;
+    bringup_current_faults_text_sensor_.sensor = s;
   }
   void set_bringup_occurred_faults_text_sensor(text_sensor::TextSensor* s) {
-    bringup_occurred_faults_text_sensor_ = s;
+    bringup_occurred_faults_text_sensor_.sensor = s;
   }
   void set_debug_log_text_sensor(text_sensor::TextSensor* s) {
     debug_log_text_sensor_ = s;
@@ -591,20 +599,20 @@ class ESCHigherComponent : public PollingComponent, public i2c::I2CDevice {
   sensor::Sensor* debug_phase_ib_ma_sensor_{nullptr};
   sensor::Sensor* debug_phase_ic_ma_sensor_{nullptr};
 
-  text_sensor::TextSensor* esc_state_text_sensor_{nullptr};
-  text_sensor::TextSensor* last_cmd_error_text_sensor_{nullptr};
-  text_sensor::TextSensor* fault_detail_text_sensor_{nullptr};
-  text_sensor::TextSensor* current_fault_text_sensor_{nullptr};
-  text_sensor::TextSensor* status_flags_text_sensor_{nullptr};
-  text_sensor::TextSensor* current_faults_text_sensor_{nullptr};
-  text_sensor::TextSensor* occurred_faults_text_sensor_{nullptr};
-  text_sensor::TextSensor* mc_state_text_sensor_{nullptr};
-  text_sensor::TextSensor* capabilities_text_sensor_{nullptr};
-  text_sensor::TextSensor* bringup_state_text_sensor_{nullptr};
-  text_sensor::TextSensor* bringup_result_text_sensor_{nullptr};
-  text_sensor::TextSensor* bringup_test_id_text_sensor_{nullptr};
-  text_sensor::TextSensor* bringup_current_faults_text_sensor_{nullptr};
-  text_sensor::TextSensor* bringup_occurred_faults_text_sensor_{nullptr};
+  GuardedTextSensor esc_state_text_sensor_{};
+  GuardedTextSensor last_cmd_error_text_sensor_{};
+  GuardedTextSensor fault_detail_text_sensor_{};
+  GuardedTextSensor current_fault_text_sensor_{};
+  GuardedTextSensor status_flags_text_sensor_{};
+  GuardedTextSensor current_faults_text_sensor_{};
+  GuardedTextSensor occurred_faults_text_sensor_{};
+  GuardedTextSensor mc_state_text_sensor_{};
+  GuardedTextSensor capabilities_text_sensor_{};
+  GuardedTextSensor bringup_state_text_sensor_{};
+  GuardedTextSensor bringup_result_text_sensor_{};
+  GuardedTextSensor bringup_test_id_text_sensor_{};
+  GuardedTextSensor bringup_current_faults_text_sensor_{};
+  GuardedTextSensor bringup_occurred_faults_text_sensor_{};
   text_sensor::TextSensor* debug_log_text_sensor_{nullptr};
   select::Select* bringup_test_select_{nullptr};
 };
@@ -2,8 +2,8 @@
 
 #include <cstddef>
 #include <cstdint>
-#include <string>
 
+#include "../component_common/fixed_string.h"
 #include "esphome/components/i2c/i2c.h"
 
 namespace esphome {
@@ -357,41 +357,41 @@ static const FaultMapEntry FAULT_MAP[] = {
   {0x0400, "driver_protection"},
 };
 
-static std::string bitmask_to_names(uint16_t v, const char* const* names, size_t count) {
-  if (v == 0)
-    return "none";
-  std::string out;
+// Every status-flag or fault name joined with '|' fits in 160 characters.
+using NameListText = ::component_common::FixedString<160>;
+
+static NameListText bitmask_to_names(uint16_t v, const char* const* names, size_t count) {
+  NameListText out;
+  if (v == 0) {
+    out.append("none");
+    return out;
+  }
   for (size_t i = 0; i < count; i++) {
     if ((v & (1U << i)) == 0)
       continue;
-    if (!out.empty())
-      out += "|";
-    out += names[i];
+    out.append_item(names[i], "|");
   }
   if (out.empty())
-    out = "unknown_bits";
+    out.append("unknown_bits");
   return out;
 }
 
-static std::string fault_bitmask_to_names(uint16_t v) {
-  if (v == 0)
-    return "none";
-  std::string out;
+static NameListText fault_bitmask_to_names(uint16_t v) {
+  NameListText out;
+  if (v == 0) {
+    out.append("none");
+    return out;
+  }
   uint16_t known = 0;
   for (size_t i = 0; i < (sizeof(FAULT_MAP) / sizeof(FAULT_MAP[0])); i++) {
     if ((v & FAULT_MAP[i].bit) == 0)
       continue;
     known |= FAULT_MAP[i].bit;
-    if (!out.empty())
-      out += "|";
-    out += FAULT_MAP[i].name;
+    out.append_item(FAULT_MAP[i].name, "|");
   }
-  if ((v & static_cast<uint16_t>(~known)) != 0) {
-    if (!out.empty())
-      out += "|";
-    out += "unknown_bits";
-  }
-  return out.empty() ? "unknown_bits" : out;
+  if ((v & static_cast<uint16_t>(~known)) != 0)
+    out.append_item("unknown_bits", "|");
+  return out;
 }
 
 }  // namespace esc_higher
@@ -5,9 +5,13 @@ from esphome.const import (
     CONF_ID,
     DEVICE_CLASS_CURRENT,
     DEVICE_CLASS_POWER,
+    DEVICE_CLASS_DURATION,
     DEVICE_CLASS_VOLTAGE,
+    ENTITY_CATEGORY_DIAGNOSTIC,
     STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
     UNIT_AMPERE,
+    UNIT_MILLISECOND,
     UNIT_VOLT,
     UNIT_WATT,
 )
@@ -33,10 +37,47 @@ CONF_AVAILABLE_PDOS = "available_pdos"
 CONF_VOLTAGE_SELECT = "voltage_select"
 CONF_HARD_RESET_BUTTON = "hard_reset_button"
 CONF_REFRESH_CAPABILITIES_BUTTON = "refresh_capabilities_button"
+CONF_AUTO_REREQUEST = "auto_rerequest"
+CONF_NEGOTIATION_TIMEOUT = "negotiation_timeout"
+CONF_CONTRACT_STATE = "contract_state"
+CONF_NEGOTIATION_COUNT = "negotiation_count"
+CONF_NEGOTIATION_FAILURE_COUNT = "negotiation_failure_count"
+CONF_CONTRACT_LOSS_COUNT = "contract_loss_count"
+CONF_VOLTAGE_CHANGE_COUNT = "voltage_change_count"
+CONF_NEGOTIATION_LATENCY = "negotiation_latency"
+CONF_MAX_NEGOTIATION_LATENCY = "max_negotiation_latency"
 
 VOLTAGE_OPTIONS = ["5V", "9V", "12V", "15V", "18V", "20V"]
 
 
+def _count_sensor_schema():
+    return sensor.sensor_schema(
+        accuracy_decimals=0,
+        state_class=STATE_CLASS_TOTAL_INCREASING,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    )
+
+
+def _latency_sensor_schema():
+    return sensor.sensor_schema(
+        unit_of_measurement=UNIT_MILLISECOND,
+        accuracy_decimals=0,
+        device_class=DEVICE_CLASS_DURATION,
+        state_class=STATE_CLASS_MEASUREMENT,
+        entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+    )
+
+
+CONTRACT_SENSORS = {
+    CONF_NEGOTIATION_COUNT: ("set_negotiation_count_sensor", _count_sensor_schema),
+    CONF_NEGOTIATION_FAILURE_COUNT: ("set_negotiation_failure_count_sensor", _count_sensor_schema),
+    CONF_CONTRACT_LOSS_COUNT: ("set_contract_loss_count_sensor", _count_sensor_schema),
+    CONF_VOLTAGE_CHANGE_COUNT: ("set_voltage_change_count_sensor", _count_sensor_schema),
+    CONF_NEGOTIATION_LATENCY: ("set_negotiation_latency_sensor", _latency_sensor_schema),
+    CONF_MAX_NEGOTIATION_LATENCY: ("set_max_negotiation_latency_sensor", _latency_sensor_schema),
+}
+
+
 def _voltage_option(value):
     value = cv.string(value).upper().replace(" ", "")
     if value not in VOLTAGE_OPTIONS:
@@ -50,6 +91,11 @@ CONFIG_SCHEMA = (
             cv.GenerateID(): cv.declare_id(HUSB238Component),
             cv.Optional(CONF_REQUEST_VOLTAGE): _voltage_option,
             cv.Optional(CONF_REQUEST_ON_BOOT, default=True): cv.boolean,
+            cv.Optional(CONF_AUTO_REREQUEST, default=False): cv.boolean,
+            cv.Optional(CONF_NEGOTIATION_TIMEOUT, default="2s"): cv.All(
+                cv.positive_time_period_milliseconds,
+                cv.Range(min=cv.TimePeriod(milliseconds=100), max=cv.TimePeriod(seconds=30)),
+            ),
             cv.Optional(CONF_VOLTAGE): sensor.sensor_schema(
                 unit_of_measurement=UNIT_VOLT,
                 accuracy_decimals=1,
@@ -81,6 +127,10 @@ CONFIG_SCHEMA = (
             cv.Optional(CONF_REFRESH_CAPABILITIES_BUTTON): button.button_schema(
                 HUSB238RefreshCapabilitiesButton
             ),
+            cv.Optional(CONF_CONTRACT_STATE): text_sensor.text_sensor_schema(
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC
+            ),
+            **{cv.Optional(key): schema() for key, (_, schema) in CONTRACT_SENSORS.items()},
         }
     )
     .extend(cv.polling_component_schema("5s"))
@@ -94,6 +144,8 @@ async def to_code(config):
     await i2c.register_i2c_device(var, config)
 
     cg.add(var.set_request_on_boot(config[CONF_REQUEST_ON_BOOT]))
+    cg.add(var.set_auto_rerequest(config[CONF_AUTO_REREQUEST]))
+    cg.add(var.set_negotiation_timeout(config[CONF_NEGOTIATION_TIMEOUT].total_milliseconds))
 
     if CONF_REQUEST_VOLTAGE in config:
         cg.add(var.set_initial_request_voltage(int(config[CONF_REQUEST_VOLTAGE].rstrip("V"))))
@@ -126,6 +178,15 @@ async def to_code(config):
         sens = await text_sensor.new_text_sensor(config[CONF_AVAILABLE_PDOS])
         cg.add(var.set_available_pdos_text_sensor(sens))
 
+    if CONF_CONTRACT_STATE in config:
+        sens = await text_sensor.new_text_sensor(config[CONF_CONTRACT_STATE])
+        cg.add(var.set_contract_state_text_sensor(sens))
+
+    for key, (setter, _) in CONTRACT_SENSORS.items():
+        if key in config:
+            sens = await sensor.new_sensor(config[key])
+            cg.add(getattr(var, setter)(sens))
+
     if CONF_VOLTAGE_SELECT in config:
         sel = await select.new_select(config[CONF_VOLTAGE_SELECT], options=VOLTAGE_OPTIONS)
         cg.add(sel.set_parent(var))
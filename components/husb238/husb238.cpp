@@ -12,6 +12,15 @@ static const char *const TAG = "husb238";
 
 static constexpr uint32_t BOOT_REQUEST_DELAY_MS = 3000;
 
+// Publishes only when the text differs from the last published value.
+static void publish_text(text_sensor::TextSensor *sensor, ::component_common::PublishGuard &guard, const char *text) {
+  if (sensor != nullptr && guard.changed(text))
+    sensor->publish_state(text);
+}
+// Status poll period while a request is outstanding; it bounds the
+// resolution of the measured negotiation latency.
+static constexpr uint32_t NEGOTIATION_POLL_MS = 20;
+
 HUSB238Component::HUSB238Component() : service_(this) {}
 
 void HUSB238Component::setup() {
@@ -36,6 +45,8 @@ void HUSB238Component::dump_config() {
   LOG_I2C_DEVICE(this);
   LOG_UPDATE_INTERVAL(this);
   ESP_LOGCONFIG(TAG, "  Request on boot: %s", YESNO(this->request_on_boot_));
+  ESP_LOGCONFIG(TAG, "  Auto re-request: %s", YESNO(this->contract_monitor_.auto_rerequest()));
+  ESP_LOGCONFIG(TAG, "  Negotiation timeout: %ums", static_cast<unsigned>(this->contract_monitor_.timeout_ms()));
   if (this->initial_request_voltage_ != 0) {
     ESP_LOGCONFIG(TAG, "  Initial request voltage: %uV", this->initial_request_voltage_);
   }
@@ -46,6 +57,13 @@ void HUSB238Component::dump_config() {
   LOG_BINARY_SENSOR("  ", "CC2 Connected", this->cc2_connected_binary_sensor_);
   LOG_TEXT_SENSOR("  ", "PD Response", this->pd_response_text_sensor_);
   LOG_TEXT_SENSOR("  ", "Available PDOs", this->available_pdos_text_sensor_);
+  LOG_TEXT_SENSOR("  ", "Contract State", this->contract_state_text_sensor_);
+  LOG_SENSOR("  ", "Negotiation Count", this->negotiation_count_sensor_);
+  LOG_SENSOR("  ", "Negotiation Failure Count", this->negotiation_failure_count_sensor_);
+  LOG_SENSOR("  ", "Contract Loss Count", this->contract_loss_count_sensor_);
+  LOG_SENSOR("  ", "Voltage Change Count", this->voltage_change_count_sensor_);
+  LOG_SENSOR("  ", "Negotiation Latency", this->negotiation_latency_sensor_);
+  LOG_SENSOR("  ", "Max Negotiation Latency", this->max_negotiation_latency_sensor_);
 }
 
 void HUSB238Component::update() {
@@ -56,7 +74,14 @@ void HUSB238Component::update() {
   }
   this->status_clear_warning();
 
+  this->process_contract_(status);
   this->maybe_run_boot_request_(status.attached);
+  if (!this->boot_request_pending_ && this->contract_monitor_.should_rerequest(millis())) {
+    ESP_LOGW(TAG, "Contract is %s at %uV; re-requesting %uV",
+             ::husb238_core::contract_state_to_string(this->contract_monitor_.state()), status.voltage,
+             this->contract_monitor_.target_voltage());
+    this->request_voltage(this->contract_monitor_.target_voltage());
+  }
 
   if (this->voltage_sensor_ != nullptr)
     this->voltage_sensor_->publish_state(status.voltage);
@@ -68,13 +93,14 @@ void HUSB238Component::update() {
     this->attached_binary_sensor_->publish_state(status.attached);
   if (this->cc2_connected_binary_sensor_ != nullptr)
     this->cc2_connected_binary_sensor_->publish_state(status.attached && status.cc2_connected);
-  if (this->pd_response_text_sensor_ != nullptr)
-    this->pd_response_text_sensor_->publish_state(::husb238_core::pd_response_to_string(status.pd_response));
+  publish_text(this->pd_response_text_sensor_, this->pd_response_guard_,
+               ::husb238_core::pd_response_to_string(status.pd_response));
 
   ::husb238_core::SourcePdo pdos[6] = {};
   const bool pdo_ok = this->service_.read_source_pdos(pdos, 6);
   if (pdo_ok && this->available_pdos_text_sensor_ != nullptr) {
-    this->available_pdos_text_sensor_->publish_state(this->build_available_pdos_string_(pdos));
+    publish_text(this->available_pdos_text_sensor_, this->available_pdos_guard_,
+                 this->build_available_pdos_text_(pdos).c_str());
   }
 
   if (status.voltage != 0) {
@@ -93,6 +119,9 @@ bool HUSB238Component::request_voltage(uint8_t voltage) {
   if (!this->service_.request_voltage(voltage))
     return false;
 
+  this->contract_monitor_.on_request(voltage, millis());
+  this->schedule_negotiation_poll_();
+  this->publish_contract_();
   this->publish_voltage_select_(voltage);
   ESP_LOGI(TAG, "Requested %uV PDO", voltage);
   return true;
@@ -125,6 +154,69 @@ void HUSB238Component::maybe_run_boot_request_(bool attached) {
   this->boot_request_pending_ = false;
 }
 
+void HUSB238Component::process_contract_(const ::husb238_core::Status &status) {
+  const auto event = this->contract_monitor_.update(status, millis());
+  const auto &stats = this->contract_monitor_.stats();
+  switch (event) {
+    case ::husb238_core::ContractEvent::NONE:
+      return;
+    case ::husb238_core::ContractEvent::ACCEPTED:
+      ESP_LOGI(TAG, "%uV contract accepted after %ums", status.voltage, static_cast<unsigned>(stats.last_latency_ms));
+      break;
+    case ::husb238_core::ContractEvent::REJECTED:
+      ESP_LOGW(TAG, "%uV request rejected: %s", this->contract_monitor_.target_voltage(),
+               ::husb238_core::pd_response_to_string(status.pd_response));
+      break;
+    case ::husb238_core::ContractEvent::TIMED_OUT:
+      ESP_LOGW(TAG, "%uV request not accepted within %ums; source reports %uV", this->contract_monitor_.target_voltage(),
+               static_cast<unsigned>(this->contract_monitor_.timeout_ms()), status.voltage);
+      break;
+    case ::husb238_core::ContractEvent::CONTRACT_LOST:
+      ESP_LOGW(TAG, "Source dropped the contract; fell back to 5V");
+      break;
+    case ::husb238_core::ContractEvent::VOLTAGE_CHANGED:
+      ESP_LOGW(TAG, "Contract voltage changed unexpectedly to %uV", status.voltage);
+      break;
+    default:
+      ESP_LOGD(TAG, "Source %s", ::husb238_core::contract_event_to_string(event));
+      break;
+  }
+  this->publish_contract_();
+}
+
+void HUSB238Component::schedule_negotiation_poll_() {
+  this->set_timeout("husb238_negotiation", NEGOTIATION_POLL_MS, [this]() { this->poll_negotiation_(); });
+}
+
+void HUSB238Component::poll_negotiation_() {
+  if (!this->contract_monitor_.pending())
+    return;
+
+  ::husb238_core::Status status;
+  if (this->service_.read_status(&status))
+    this->process_contract_(status);
+  if (this->contract_monitor_.pending())
+    this->schedule_negotiation_poll_();
+}
+
+void HUSB238Component::publish_contract_() {
+  const auto &stats = this->contract_monitor_.stats();
+  publish_text(this->contract_state_text_sensor_, this->contract_state_guard_,
+               ::husb238_core::contract_state_to_string(this->contract_monitor_.state()));
+  if (this->negotiation_count_sensor_ != nullptr)
+    this->negotiation_count_sensor_->publish_state(stats.accepted);
+  if (this->negotiation_failure_count_sensor_ != nullptr)
+    this->negotiation_failure_count_sensor_->publish_state(stats.failures());
+  if (this->contract_loss_count_sensor_ != nullptr)
+    this->contract_loss_count_sensor_->publish_state(stats.contract_losses);
+  if (this->voltage_change_count_sensor_ != nullptr)
+    this->voltage_change_count_sensor_->publish_state(stats.voltage_changes);
+  if (stats.accepted != 0 && this->negotiation_latency_sensor_ != nullptr)
+    this->negotiation_latency_sensor_->publish_state(stats.last_latency_ms);
+  if (stats.accepted != 0 && this->max_negotiation_latency_sensor_ != nullptr)
+    this->max_negotiation_latency_sensor_->publish_state(stats.max_latency_ms);
+}
+
 bool HUSB238Component::read_register(uint8_t reg, uint8_t *value) {
   if (!this->read_byte(reg, value)) {
     ESP_LOGW(TAG, "I2C read failed at register 0x%02X", reg);
@@ -149,26 +241,27 @@ void HUSB238Component::publish_voltage_select_(uint8_t voltage) {
 
   char text[8];
   std::snprintf(text, sizeof(text), "%uV", voltage);
-  this->voltage_select_->publish_state(text);
+  if (this->voltage_select_guard_.changed(text))
+    this->voltage_select_->publish_state(text);
 }
 
-std::string HUSB238Component::build_available_pdos_string_(const ::husb238_core::SourcePdo *pdos) const {
-  std::string out;
+HUSB238Component::PdoListText HUSB238Component::build_available_pdos_text_(
+    const ::husb238_core::SourcePdo *pdos) const {
+  PdoListText out;
 
   for (uint8_t i = 0; i < 6; i++) {
     const ::husb238_core::SourcePdo &pdo = pdos[i];
     if (!pdo.available)
       continue;
 
-    char item[24];
-    std::snprintf(item, sizeof(item), "%uV %.2fA", pdo.voltage, pdo.current);
-
     if (!out.empty())
-      out += ", ";
-    out += item;
+      out.append(", ");
+    out.appendf("%uV %.2fA", pdo.voltage, pdo.current);
   }
 
-  return out.empty() ? "none" : out;
+  if (out.empty())
+    out.append("none");
+  return out;
 }
 
 void HUSB238VoltageSelect::control(const std::string &value) {
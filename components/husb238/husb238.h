@@ -5,6 +5,7 @@
 
 #include "husb238_bus.h"
 #include "husb238_service.h"
+#include "../component_common/fixed_string.h"
 
 #include "esphome/components/binary_sensor/binary_sensor.h"
 #include "esphome/components/button/button.h"
@@ -34,6 +35,8 @@ class HUSB238Component : public PollingComponent, public i2c::I2CDevice, public
 
   void set_initial_request_voltage(uint8_t voltage) { this->initial_request_voltage_ = voltage; }
   void set_request_on_boot(bool request_on_boot) { this->request_on_boot_ = request_on_boot; }
+  void set_auto_rerequest(bool auto_rerequest) { this->contract_monitor_.set_auto_rerequest(auto_rerequest); }
+  void set_negotiation_timeout(uint32_t timeout_ms) { this->contract_monitor_.set_timeout_ms(timeout_ms); }
 
   void set_voltage_sensor(sensor::Sensor *sensor) { this->voltage_sensor_ = sensor; }
   void set_current_sensor(sensor::Sensor *sensor) { this->current_sensor_ = sensor; }
@@ -43,6 +46,13 @@ class HUSB238Component : public PollingComponent, public i2c::I2CDevice, public
   void set_pd_response_text_sensor(text_sensor::TextSensor *sensor) { this->pd_response_text_sensor_ = sensor; }
   void set_available_pdos_text_sensor(text_sensor::TextSensor *sensor) { this->available_pdos_text_sensor_ = sensor; }
   void set_voltage_select(HUSB238VoltageSelect *select) { this->voltage_select_ = select; }
+  void set_contract_state_text_sensor(text_sensor::TextSensor *sensor) { this->contract_state_text_sensor_ = sensor; }
+  void set_negotiation_count_sensor(sensor::Sensor *sensor) { this->negotiation_count_sensor_ = sensor; }
+  void set_negotiation_failure_count_sensor(sensor::Sensor *sensor) { this->negotiation_failure_count_sensor_ = sensor; }
+  void set_contract_loss_count_sensor(sensor::Sensor *sensor) { this->contract_loss_count_sensor_ = sensor; }
+  void set_voltage_change_count_sensor(sensor::Sensor *sensor) { this->voltage_change_count_sensor_ = sensor; }
+  void set_negotiation_latency_sensor(sensor::Sensor *sensor) { this->negotiation_latency_sensor_ = sensor; }
+  void set_max_negotiation_latency_sensor(sensor::Sensor *sensor) { this->max_negotiation_latency_sensor_ = sensor; }
 
   bool request_voltage(uint8_t voltage);
   bool request_source_capabilities();
@@ -50,11 +60,18 @@ class HUSB238Component : public PollingComponent, public i2c::I2CDevice, public
 
  protected:
   void publish_voltage_select_(uint8_t voltage);
-  std::string build_available_pdos_string_(const ::husb238_core::SourcePdo *pdos) const;
+  // Six "20V 5.00A" items with separators fit in 64 characters.
+  using PdoListText = ::component_common::FixedString<64>;
+  PdoListText build_available_pdos_text_(const ::husb238_core::SourcePdo *pdos) const;
 
   void maybe_run_boot_request_(bool attached);
+  void process_contract_(const ::husb238_core::Status &status);
+  void schedule_negotiation_poll_();
+  void poll_negotiation_();
+  void publish_contract_();
 
   ::husb238_core::HusbService service_;
+  ::husb238_core::ContractMonitor contract_monitor_;
   uint8_t initial_request_voltage_{0};
   bool request_on_boot_{true};
   bool boot_request_pending_{false};
@@ -68,6 +85,17 @@ class HUSB238Component : public PollingComponent, public i2c::I2CDevice, public
   text_sensor::TextSensor *pd_response_text_sensor_{nullptr};
   text_sensor::TextSensor *available_pdos_text_sensor_{nullptr};
   HUSB238VoltageSelect *voltage_select_{nullptr};
+  ::component_common::PublishGuard pd_response_guard_;
+  ::component_common::PublishGuard available_pdos_guard_;
+  ::component_common::PublishGuard voltage_select_guard_;
+  ::component_common::PublishGuard contract_state_guard_;
+  text_sensor::TextSensor *contract_state_text_sensor_{nullptr};
+  sensor::Sensor *negotiation_count_sensor_{nullptr};
+  sensor::Sensor *negotiation_failure_count_sensor_{nullptr};
+  sensor::Sensor *contract_loss_count_sensor_{nullptr};
+  sensor::Sensor *voltage_change_count_sensor_{nullptr};
+  sensor::Sensor *negotiation_latency_sensor_{nullptr};
+  sensor::Sensor *max_negotiation_latency_sensor_{nullptr};
 };
 
 class HUSB238VoltageSelect : public select::Select {
@@ -2,6 +2,16 @@
 
 namespace husb238_core {
 
+namespace {
+
+constexpr uint8_t PD_RESPONSE_SUCCESS = 0x01;
+
+bool pd_response_rejected(uint8_t code) { return code == 0x03 || code == 0x04 || code == 0x05; }
+
+bool time_reached(uint32_t now_ms, uint32_t due_ms) { return static_cast<int32_t>(now_ms - due_ms) >= 0; }
+
+}  // namespace
+
 bool HusbService::read_register_(registers::RegisterId id, uint8_t *value) {
   return this->bus_ != nullptr && value != nullptr &&
          this->bus_->read_register(registers::register_address(id), value);
@@ -70,4 +80,173 @@ bool HusbService::hard_reset() {
   return this->write_command_(registers::CommandId::HARD_RESET);
 }
 
+void ContractMonitor::on_request(uint8_t voltage, uint32_t now_ms) {
+  if (this->target_voltage_ != voltage)
+    this->retry_delay_ms_ = RETRY_INITIAL_MS;
+  this->target_voltage_ = voltage;
+  this->request_started_ms_ = now_ms;
+  this->request_pd_response_ = this->last_pd_response_;
+  this->request_voltage_ = this->last_voltage_;
+  this->response_fresh_ = false;
+  this->state_ = ContractState::PENDING;
+  this->stats_.requests++;
+}
+
+ContractEvent ContractMonitor::update(const Status &status, uint32_t now_ms) {
+  this->last_pd_response_ = status.attached ? status.pd_response : 0;
+  this->last_voltage_ = status.attached ? status.voltage : 0;
+  if (!status.attached) {
+    const bool was_attached = this->state_ != ContractState::DETACHED;
+    this->state_ = ContractState::DETACHED;
+    this->contract_voltage_ = 0;
+    return was_attached ? ContractEvent::DETACHED : ContractEvent::NONE;
+  }
+
+  switch (this->state_) {
+    case ContractState::DETACHED:
+      this->contract_voltage_ = status.voltage;
+      // A fresh attach starts the backoff over.
+      this->retry_delay_ms_ = RETRY_INITIAL_MS;
+      this->retry_due_ms_ = now_ms;
+      this->state_ = this->target_voltage_ != 0 && status.voltage == this->target_voltage_
+                         ? ContractState::ESTABLISHED
+                         : ContractState::ATTACHED;
+      return ContractEvent::ATTACHED;
+
+    case ContractState::PENDING:
+      return this->settle_pending_(status, now_ms);
+
+    case ContractState::ESTABLISHED:
+      if (status.voltage == this->contract_voltage_)
+        return ContractEvent::NONE;
+      this->state_ = ContractState::LOST;
+      this->contract_voltage_ = status.voltage;
+      this->schedule_retry_(now_ms);
+      // Without a contract the HUSB238 reports the Type-C 5 V fallback.
+      if (status.voltage == 5) {
+        this->stats_.contract_losses++;
+        return ContractEvent::CONTRACT_LOST;
+      }
+      this->stats_.voltage_changes++;
+      return ContractEvent::VOLTAGE_CHANGED;
+
+    case ContractState::ATTACHED:
+    case ContractState::FAILED:
+    case ContractState::LOST: {
+      const bool changed = status.voltage != this->contract_voltage_;
+      this->contract_voltage_ = status.voltage;
+      if (this->target_voltage_ != 0 && status.voltage == this->target_voltage_) {
+        // The source came back to the requested voltage on its own.
+        this->state_ = ContractState::ESTABLISHED;
+        this->retry_delay_ms_ = RETRY_INITIAL_MS;
+        return ContractEvent::NONE;
+      }
+      if (changed && this->state_ == ContractState::ATTACHED) {
+        this->stats_.voltage_changes++;
+        return ContractEvent::VOLTAGE_CHANGED;
+      }
+      return ContractEvent::NONE;
+    }
+  }
+  return ContractEvent::NONE;
+}
+
+ContractEvent ContractMonitor::settle_pending_(const Status &status, uint32_t now_ms) {
+  if (status.pd_response != this->request_pd_response_ || status.voltage != this->request_voltage_)
+    this->response_fresh_ = true;
+  const uint32_t elapsed_ms = now_ms - this->request_started_ms_;
+  const uint32_t settle_ms = this->timeout_ms_ < RESPONSE_SETTLE_MS ? this->timeout_ms_ : RESPONSE_SETTLE_MS;
+  if (!this->response_fresh_ && elapsed_ms < settle_ms)
+    return ContractEvent::NONE;
+
+  if (status.voltage == this->target_voltage_ && status.pd_response == PD_RESPONSE_SUCCESS) {
+    const uint32_t latency_ms = elapsed_ms;
+    this->stats_.last_latency_ms = latency_ms;
+    if (this->stats_.accepted == 0 || latency_ms < this->stats_.min_latency_ms)
+      this->stats_.min_latency_ms = latency_ms;
+    if (latency_ms > this->stats_.max_latency_ms)
+      this->stats_.max_latency_ms = latency_ms;
+    this->stats_.total_latency_ms += latency_ms;
+    this->stats_.accepted++;
+    this->contract_voltage_ = status.voltage;
+    this->retry_delay_ms_ = RETRY_INITIAL_MS;
+    this->state_ = ContractState::ESTABLISHED;
+    return ContractEvent::ACCEPTED;
+  }
+
+  this->contract_voltage_ = status.voltage;
+  if (pd_response_rejected(status.pd_response)) {
+    this->stats_.rejected++;
+    this->state_ = ContractState::FAILED;
+    this->schedule_retry_(now_ms);
+    return ContractEvent::REJECTED;
+  }
+  if (elapsed_ms >= this->timeout_ms_) {
+    this->stats_.timeouts++;
+    this->state_ = ContractState::FAILED;
+    this->schedule_retry_(now_ms);
+    return ContractEvent::TIMED_OUT;
+  }
+  return ContractEvent::NONE;
+}
+
+void ContractMonitor::schedule_retry_(uint32_t now_ms) {
+  this->retry_due_ms_ = now_ms + this->retry_delay_ms_;
+  this->retry_delay_ms_ = this->retry_delay_ms_ >= RETRY_MAX_MS / 2 ? RETRY_MAX_MS : this->retry_delay_ms_ * 2;
+}
+
+bool ContractMonitor::should_rerequest(uint32_t now_ms) const {
+  if (!this->auto_rerequest_ || this->target_voltage_ == 0)
+    return false;
+  switch (this->state_) {
+    case ContractState::FAILED:
+    case ContractState::LOST:
+      return time_reached(now_ms, this->retry_due_ms_);
+    case ContractState::ATTACHED:
+      return this->contract_voltage_ != this->target_voltage_ && time_reached(now_ms, this->retry_due_ms_);
+    default:
+      return false;
+  }
+}
+
+const char *contract_state_to_string(ContractState state) {
+  switch (state) {
+    case ContractState::DETACHED:
+      return "detached";
+    case ContractState::ATTACHED:
+      return "attached";
+    case ContractState::PENDING:
+      return "pending";
+    case ContractState::ESTABLISHED:
+      return "established";
+    case ContractState::FAILED:
+      return "failed";
+    case ContractState::LOST:
+      return "lost";
+  }
+  return "unknown";
+}
+
+const char *contract_event_to_string(ContractEvent event) {
+  switch (event) {
+    case ContractEvent::NONE:
+      return "none";
+    case ContractEvent::ATTACHED:
+      return "attached";
+    case ContractEvent::DETACHED:
+      return "detached";
+    case ContractEvent::ACCEPTED:
+      return "accepted";
+    case ContractEvent::REJECTED:
+      return "rejected";
+    case ContractEvent::TIMED_OUT:
+      return "timed_out";
+    case ContractEvent::CONTRACT_LOST:
+      return "contract_lost";
+    case ContractEvent::VOLTAGE_CHANGED:
+      return "voltage_changed";
+  }
+  return "unknown";
+}
+
 }  // namespace husb238_core
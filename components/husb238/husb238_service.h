@@ -9,6 +9,103 @@
 
 namespace husb238_core {
 
+enum class ContractState : uint8_t {
+  DETACHED,
+  // Attached on a contract that was not requested: the source default, or
+  // one that differs from the requested voltage after a reattach.
+  ATTACHED,
+  PENDING,
+  ESTABLISHED,
+  // A request was rejected or timed out.
+  FAILED,
+  // The established contract dropped to 5 V or moved to another voltage.
+  LOST,
+};
+
+enum class ContractEvent : uint8_t {
+  NONE,
+  ATTACHED,
+  DETACHED,
+  ACCEPTED,
+  REJECTED,
+  TIMED_OUT,
+  CONTRACT_LOST,
+  VOLTAGE_CHANGED,
+};
+
+struct ContractStats {
+  uint32_t requests{0};
+  uint32_t accepted{0};
+  uint32_t rejected{0};
+  uint32_t timeouts{0};
+  uint32_t contract_losses{0};
+  uint32_t voltage_changes{0};
+  uint32_t last_latency_ms{0};
+  uint32_t min_latency_ms{0};
+  uint32_t max_latency_ms{0};
+  uint64_t total_latency_ms{0};
+
+  uint32_t failures() const { return this->rejected + this->timeouts; }
+  uint32_t average_latency_ms() const {
+    return this->accepted == 0 ? 0 : static_cast<uint32_t>(this->total_latency_ms / this->accepted);
+  }
+};
+
+// Tracks the PD contract from successive status reads. It owns no bus: the
+// caller reports each request and each status read with a millisecond
+// timestamp, so latency resolution is the caller's status poll period.
+class ContractMonitor {
+ public:
+  static constexpr uint32_t DEFAULT_TIMEOUT_MS = 2000;
+  static constexpr uint32_t RETRY_INITIAL_MS = 1000;
+  static constexpr uint32_t RETRY_MAX_MS = 30000;
+  // PD_RESPONSE and the contract voltage keep the previous negotiation's
+  // result until the new one lands. A pending request only trusts them once
+  // either has changed since the request, or after this long unchanged;
+  // PD lets a source take up to 550 ms (tPSTransition) to switch voltage.
+  static constexpr uint32_t RESPONSE_SETTLE_MS = 500;
+
+  void set_timeout_ms(uint32_t timeout_ms) { this->timeout_ms_ = timeout_ms; }
+  void set_auto_rerequest(bool auto_rerequest) { this->auto_rerequest_ = auto_rerequest; }
+  uint32_t timeout_ms() const { return this->timeout_ms_; }
+  bool auto_rerequest() const { return this->auto_rerequest_; }
+
+  void on_request(uint8_t voltage, uint32_t now_ms);
+  ContractEvent update(const Status &status, uint32_t now_ms);
+  // True when auto re-request is enabled, a voltage was requested, the
+  // source is attached without that contract, and the retry backoff expired.
+  bool should_rerequest(uint32_t now_ms) const;
+
+  ContractState state() const { return this->state_; }
+  uint8_t target_voltage() const { return this->target_voltage_; }
+  uint8_t contract_voltage() const { return this->contract_voltage_; }
+  bool pending() const { return this->state_ == ContractState::PENDING; }
+  const ContractStats &stats() const { return this->stats_; }
+
+ private:
+  ContractEvent settle_pending_(const Status &status, uint32_t now_ms);
+  void schedule_retry_(uint32_t now_ms);
+
+  ContractState state_{ContractState::DETACHED};
+  ContractStats stats_{};
+  uint32_t timeout_ms_{DEFAULT_TIMEOUT_MS};
+  bool auto_rerequest_{false};
+  uint8_t target_voltage_{0};
+  uint8_t contract_voltage_{0};
+  uint32_t request_started_ms_{0};
+  // Last status seen, and its value when the pending request was made.
+  uint8_t last_pd_response_{0};
+  uint8_t last_voltage_{0};
+  uint8_t request_pd_response_{0};
+  uint8_t request_voltage_{0};
+  bool response_fresh_{false};
+  uint32_t retry_delay_ms_{RETRY_INITIAL_MS};
+  uint32_t retry_due_ms_{0};
+};
+
+const char *contract_state_to_string(ContractState state);
+const char *contract_event_to_string(ContractEvent event);
+
 class HusbService {
  public:
   explicit HusbService(RegisterBus *bus) : bus_(bus) {}
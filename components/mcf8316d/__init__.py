@@ -1,6 +1,12 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import binary_sensor, button, i2c, number, select, sensor, switch as switch_, text_sensor
+from esphome.components.mcf83xx_facade import (
+    FAMILY_SCHEMA,
+    register_family_config,
+    tuning_config_hash,
+    validate_watchdog_tickle,
+)
 from esphome.const import (
     CONF_ID,
     DEVICE_CLASS_VOLTAGE,
@@ -11,7 +17,7 @@ from esphome.const import (
 )
 
 DEPENDENCIES = ["i2c"]
-AUTO_LOAD = ["mcf83xx_common", "sensor", "binary_sensor", "switch", "number", "select", "button", "text_sensor"]
+AUTO_LOAD = ["mcf83xx_common", "mcf83xx_facade", "sensor", "binary_sensor", "switch", "number", "select", "button", "text_sensor"]
 
 mcf8316d_ns = cg.esphome_ns.namespace("mcf8316d")
 MCF8316DComponent = mcf8316d_ns.class_("MCF8316DComponent", cg.PollingComponent, i2c.I2CDevice)
@@ -26,7 +32,6 @@ MCF8316DRunStartupSweepButton = mcf8316d_ns.class_("MCF8316DRunStartupSweepButto
 MCF8316DRunScopeProbeTestButton = mcf8316d_ns.class_("MCF8316DRunScopeProbeTestButton", button.Button)
 
 CONF_INTER_BYTE_DELAY_US = "inter_byte_delay_us"
-CONF_AUTO_TICKLE_WATCHDOG = "auto_tickle_watchdog"
 
 CONF_BRAKE = "brake"
 CONF_DIRECTION = "direction"
@@ -44,15 +49,19 @@ CONF_DUTY_CMD_PERCENT = "duty_cmd_percent"
 CONF_VOLT_MAG_PERCENT = "volt_mag_percent"
 CONF_FAULT_SUMMARY = "fault_summary"
 CONF_ALGORITHM_STATE = "algorithm_state"
+CONF_STARTUP_SWEEP_SUMMARY = "startup_sweep_summary"
+CONF_SCOPE_PROBE_RESULT = "scope_probe_result"
 
 DIRECTION_OPTIONS = ["hardware", "cw", "ccw"]
 
-CONFIG_SCHEMA = (
+TUNING_PREFERENCE_KEY = 0x8316D001
+
+
+CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(MCF8316DComponent),
             cv.Optional(CONF_INTER_BYTE_DELAY_US, default=100): cv.positive_int,
-            cv.Optional(CONF_AUTO_TICKLE_WATCHDOG, default=False): cv.boolean,
             cv.Optional(CONF_BRAKE): switch_.switch_schema(
                 MCF8316DBrakeSwitch,
                 entity_category=ENTITY_CATEGORY_CONFIG,
@@ -110,10 +119,14 @@ CONFIG_SCHEMA = (
             ),
             cv.Optional(CONF_FAULT_SUMMARY): text_sensor.text_sensor_schema(),
             cv.Optional(CONF_ALGORITHM_STATE): text_sensor.text_sensor_schema(),
+            cv.Optional(CONF_STARTUP_SWEEP_SUMMARY): text_sensor.text_sensor_schema(),
+            cv.Optional(CONF_SCOPE_PROBE_RESULT): text_sensor.text_sensor_schema(),
         }
     )
+    .extend(FAMILY_SCHEMA)
     .extend(cv.polling_component_schema("250ms"))
-    .extend(i2c.i2c_device_schema(default_address=0x01))
+    .extend(i2c.i2c_device_schema(default_address=0x01)),
+    validate_watchdog_tickle,
 )
 
 
@@ -123,7 +136,8 @@ async def to_code(config):
     await i2c.register_i2c_device(var, config)
 
     cg.add(var.set_inter_byte_delay_us(config[CONF_INTER_BYTE_DELAY_US]))
-    cg.add(var.set_auto_tickle_watchdog(config[CONF_AUTO_TICKLE_WATCHDOG]))
+    await register_family_config(var, config, TUNING_PREFERENCE_KEY)
+    cg.add(var.set_tuning_config_hash(tuning_config_hash(config)))
 
     if CONF_BRAKE in config:
         sw = await switch_.new_switch(config[CONF_BRAKE])
@@ -196,3 +210,11 @@ async def to_code(config):
     if CONF_ALGORITHM_STATE in config:
         sens = await text_sensor.new_text_sensor(config[CONF_ALGORITHM_STATE])
         cg.add(var.set_algorithm_state_text_sensor(sens))
+
+    if CONF_STARTUP_SWEEP_SUMMARY in config:
+        sens = await text_sensor.new_text_sensor(config[CONF_STARTUP_SWEEP_SUMMARY])
+        cg.add(var.set_startup_sweep_summary_text_sensor(sens))
+
+    if CONF_SCOPE_PROBE_RESULT in config:
+        sens = await text_sensor.new_text_sensor(config[CONF_SCOPE_PROBE_RESULT])
+        cg.add(var.set_scope_probe_result_text_sensor(sens))
@@ -1,7 +1,5 @@
 #include "mcf8316d.h"
 
-#include "../mcf83xx_common/protocol.h"
-
 #include <cmath>
 #include <cstdio>
 #include <vector>
@@ -20,12 +18,49 @@ namespace {
 
 constexpr uint32_t LOCK_MODE_AUTO_RECOVERY_MIN = 3u;
 
-constexpr uint8_t STARTUP_COMMS_ATTEMPTS = 20u;
-constexpr uint32_t STARTUP_COMMS_RETRY_DELAY_MS = 250u;
-constexpr uint32_t DEFERRED_COMMS_RETRY_INTERVAL_MS = 1000u;
-constexpr uint32_t DEFERRED_SCAN_INTERVAL_MS = 5000u;
-constexpr uint8_t I2C_SCAN_ADDRESS_MIN = 0x00u;
-constexpr uint8_t I2C_SCAN_ADDRESS_MAX = 0x7Eu;
+constexpr mcf83xx_facade::FaultName GATE_FAULT_NAMES[] = {
+  {GATE_FAULT_OCP, "DRV_OCP"},
+  {GATE_FAULT_OVP, "DRV_OVP"},
+  {GATE_FAULT_OTW, "DRV_OTW"},
+  {GATE_FAULT_OTS, "DRV_OTS"},
+  {GATE_FAULT_OCP_HA, "DRV_OCP_HA"},
+  {GATE_FAULT_OCP_LA, "DRV_OCP_LA"},
+  {GATE_FAULT_OCP_HB, "DRV_OCP_HB"},
+  {GATE_FAULT_OCP_LB, "DRV_OCP_LB"},
+  {GATE_FAULT_OCP_HC, "DRV_OCP_HC"},
+  {GATE_FAULT_OCP_LC, "DRV_OCP_LC"},
+  {GATE_FAULT_BUCK_OCP, "DRV_BUCK_OCP"},
+  {GATE_FAULT_BUCK_UV, "DRV_BUCK_UV"},
+  {GATE_FAULT_VCP_UV, "DRV_VCP_UV"},
+};
+
+constexpr mcf83xx_facade::FaultName CONTROLLER_FAULT_NAMES[] = {
+  {FAULT_IPD_FREQ, "IPD_FREQ_FAULT"},
+  {FAULT_IPD_T1, "IPD_T1_FAULT"},
+  {FAULT_IPD_T2, "IPD_T2_FAULT"},
+  {FAULT_MPET_IPD, "MPET_IPD_FAULT"},
+  {FAULT_MPET_BEMF, "MPET_BEMF_FAULT"},
+  {FAULT_WATCHDOG, "WATCHDOG_FAULT"},
+  {FAULT_NO_MTR, "NO_MTR"},
+  {FAULT_MTR_LCK, "MTR_LCK"},
+  {FAULT_LOCK_LIMIT, "LOCK_LIMIT"},
+  {FAULT_HW_LOCK_LIMIT, "HW_LOCK_LIMIT"},
+  {FAULT_ABN_SPEED, "ABN_SPEED"},
+  {FAULT_ABN_BEMF, "ABN_BEMF"},
+  {FAULT_MTR_UNDER_VOLTAGE, "MTR_UNDER_VOLTAGE"},
+  {FAULT_MTR_OVER_VOLTAGE, "MTR_OVER_VOLTAGE"},
+  {FAULT_SPEED_LOOP_SATURATION, "SPEED_LOOP_SATURATION"},
+  {FAULT_CURRENT_LOOP_SATURATION, "CURRENT_LOOP_SATURATION"},
+  {FAULT_MAX_SPEED_SATURATION, "MAX_SPEED_SATURATION"},
+  {FAULT_BUS_POWER_LIMIT_SATURATION, "BUS_POWER_LIMIT_SATURATION"},
+  {FAULT_EEPROM_WRITE_LOCK_SET, "EEPROM_WRITE_LOCK_SET"},
+  {FAULT_EEPROM_READ_LOCK_SET, "EEPROM_READ_LOCK_SET"},
+  {FAULT_I2C_CRC, "I2C_CRC_FAULT_STATUS"},
+  {FAULT_EEPROM_ERR, "EEPROM_ERR_STATUS"},
+  {FAULT_BOOT_STL, "BOOT_STL_FAULT"},
+  {FAULT_CPU_RESET, "CPU_RESET_FAULT_STATUS"},
+  {FAULT_WWDT, "WWDT_FAULT_STATUS"},
+};
 
 }  // namespace
 
@@ -107,36 +142,29 @@ void MCF8316DRunScopeProbeTestButton::press_action() {
 void MCF8316DComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up mcf8316d");
   this->normal_operation_ready_ = false;
-  this->deferred_comms_last_retry_ms_ = 0u;
-  this->deferred_comms_last_scan_ms_ = 0u;
+  this->poll_.set_schedule(this->poll_schedule_);
+  this->tuning_store_.load();
 
-  if (!this->scan_i2c_bus_()) {
-    ESP_LOGW(TAG, "I2C scan failed; continuing with communication retries");
-    this->status_set_warning();
-  }
-  if (!this->establish_communications_(
-        STARTUP_COMMS_ATTEMPTS, STARTUP_COMMS_RETRY_DELAY_MS, true
-      )) {
-    ESP_LOGW(
-      TAG,
-      "Unable to establish communications with I2C device 0x%02X during setup; deferring normal "
-      "operation",
-      this->address_
-    );
-    this->status_set_warning();
+  // Bring-up runs from loop(); the first step here lets a responsive device
+  // be ready by the end of setup() without ever waiting on a silent one.
+  this->comms_.start(this->address_, millis());
+  this->process_comms_bringup_();
+}
+
+void MCF8316DComponent::loop() {
+  if (!this->normal_operation_ready_) {
+    this->process_comms_bringup_();
     return;
   }
-
-  this->status_clear_warning();
-  this->normal_operation_ready_ = true;
-  this->apply_post_comms_setup_();
+  this->watchdog_.service(this->service_, TAG, millis());
+  this->tuning_.loop();
 }
 
 void MCF8316DComponent::update() {
   if (!this->normal_operation_ready_) {
-    this->process_deferred_startup_();
     return;
   }
+  this->watchdog_.service(this->service_, TAG, millis());
 
   uint32_t gate_fault_status = 0;
   uint32_t algo_status = 0;
@@ -145,16 +173,18 @@ void MCF8316DComponent::update() {
   bool fault_active = false;
   bool fault_state_valid = false;
 
-  const bool algo_ok = this->read_reg32(RegisterId::ALGO_STATUS, algo_status);
+  this->poll_.poll(this->service_, millis(), false);
+  this->diagnostics_.begin(this->poll_);
+  const bool algo_ok = this->diagnostics_.value(RegisterId::ALGO_STATUS, algo_status);
   if (algo_ok) {
     this->publish_algo_status_(algo_status);
   }
-  const bool gate_ok = this->read_reg32(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_fault_status);
+  const bool gate_ok = this->diagnostics_.value(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_fault_status);
   if (gate_ok) {
     fault_active |= (gate_fault_status & GATE_DRIVER_FAULT_ACTIVE_MASK) != 0;
     fault_state_valid = true;
   }
-  const bool controller_ok = this->read_reg32(RegisterId::CONTROLLER_FAULT_STATUS, fault_status);
+  const bool controller_ok = this->diagnostics_.value(RegisterId::CONTROLLER_FAULT_STATUS, fault_status);
   if (controller_ok) {
     fault_active |= (fault_status & CONTROLLER_FAULT_ACTIVE_MASK) != 0;
     fault_state_valid = true;
@@ -193,7 +223,7 @@ void MCF8316DComponent::update() {
                                     run_state_diag_active || control_diag_active ||
                                     this->tuning_.needs_algorithm_state();
   if (need_algorithm_state) {
-    if (this->read_reg16(RegisterId::ALGORITHM_STATE, algorithm_state)) {
+    if (this->read_algorithm_state_(algorithm_state)) {
       algorithm_state_valid = true;
       const char* const state_name = this->algorithm_state_to_string_(algorithm_state);
       if (this->algorithm_state_text_sensor_ != nullptr) {
@@ -271,7 +301,7 @@ void MCF8316DComponent::update() {
     this->last_buck_diag_log_ms_ = 0;
   }
 
-  if (this->read_reg32(RegisterId::VM_VOLTAGE, vm_voltage_raw) && this->vm_voltage_sensor_ != nullptr) {
+  if (this->poll_.fresh(RegisterId::VM_VOLTAGE, vm_voltage_raw) && this->vm_voltage_sensor_ != nullptr) {
     const uint32_t vm_adc_code_8 = (vm_voltage_raw & VM_VOLTAGE_ADC_MASK) >> VM_VOLTAGE_ADC_SHIFT;
     const uint32_t vm_adc_code_q11 = (vm_voltage_raw & VM_VOLTAGE_Q11_MASK) >> VM_VOLTAGE_Q11_SHIFT;
     const float vm_v = static_cast<float>(vm_adc_code_q11) * (60.0f / 2048.0f);
@@ -289,9 +319,10 @@ void MCF8316DComponent::update() {
     }
   }
 
-  if (this->auto_tickle_watchdog_ && (millis() - this->last_watchdog_tickle_ms_ >= 500U)) {
-    this->pulse_watchdog_tickle();
+  if (this->poll_.polled(::mcf8316d_core::PollTier::SLOW)) {
+    this->watchdog_.publish_stats();
   }
+  this->diagnostics_.end();
 }
 
 void MCF8316DComponent::dump_config() {
@@ -306,180 +337,28 @@ void MCF8316DComponent::dump_config() {
       TAG, "  Note: inter-byte delay is currently not applied with ESPHome I2C transactions"
     );
   }
-  ESP_LOGCONFIG(TAG, "  Auto tickle watchdog: %s", YESNO(this->auto_tickle_watchdog_));
+  this->watchdog_.dump_config(TAG);
   ESP_LOGCONFIG(
-    TAG,
-    "  Startup comm gate: scan 0x%02X..0x%02X, attempts=%u, retry=%ums, deferred_retry=%ums",
-    static_cast<unsigned>(I2C_SCAN_ADDRESS_MIN),
-    static_cast<unsigned>(I2C_SCAN_ADDRESS_MAX),
-    static_cast<unsigned>(STARTUP_COMMS_ATTEMPTS),
-    static_cast<unsigned>(STARTUP_COMMS_RETRY_DELAY_MS),
-    static_cast<unsigned>(DEFERRED_COMMS_RETRY_INTERVAL_MS)
+    TAG, "  Poll schedule: status every update, VM every %ums", static_cast<unsigned>(this->poll_schedule_.slow_interval_ms)
   );
+  this->comms_.dump_config(TAG);
 }
 
-const char* MCF8316DComponent::i2c_error_to_string_(i2c::ErrorCode error_code) const {
-  switch (error_code) {
-    case i2c::ERROR_OK:
-      return "ok";
-    case i2c::ERROR_INVALID_ARGUMENT:
-      return "invalid_argument";
-    case i2c::ERROR_NOT_ACKNOWLEDGED:
-      return "not_acknowledged";
-    case i2c::ERROR_TIMEOUT:
-      return "timeout";
-    case i2c::ERROR_NOT_INITIALIZED:
-      return "not_initialized";
-    case i2c::ERROR_TOO_LARGE:
-      return "too_large";
-    case i2c::ERROR_UNKNOWN:
-      return "unknown";
-    case i2c::ERROR_CRC:
-      return "crc";
-    default:
-      return "other";
-  }
-}
-
-bool MCF8316DComponent::probe_device_ack_(i2c::ErrorCode& error_code) const {
-  if (this->bus_ == nullptr) {
-    error_code = i2c::ERROR_NOT_INITIALIZED;
-    return false;
-  }
-
-  error_code = this->bus_->write_readv(this->address_, nullptr, 0, nullptr, 0);
-  return error_code == i2c::ERROR_OK;
-}
-
-bool MCF8316DComponent::scan_i2c_bus_() {
-  if (this->bus_ == nullptr) {
-    ESP_LOGW(TAG, "I2C scan skipped: bus is not initialized");
-    return false;
-  }
-
-  std::string discovered;
-  uint8_t device_count = 0;
-  bool target_found = false;
-  for (uint8_t address = I2C_SCAN_ADDRESS_MIN; address <= I2C_SCAN_ADDRESS_MAX; address++) {
-    const i2c::ErrorCode err = this->bus_->write_readv(address, nullptr, 0, nullptr, 0);
-    if (err == i2c::ERROR_OK) {
-      char addr_text[8];
-      std::snprintf(addr_text, sizeof(addr_text), "0x%02X", address);
-      if (!discovered.empty()) {
-        discovered += ", ";
-      }
-      discovered += addr_text;
-      device_count++;
-      if (address == this->address_) {
-        target_found = true;
-      }
-    }
-    arch_feed_wdt();
-  }
-
-  if (device_count == 0u) {
-    ESP_LOGW(
-      TAG,
-      "I2C scan found no ACKing devices in range 0x%02X..0x%02X",
-      static_cast<unsigned>(I2C_SCAN_ADDRESS_MIN),
-      static_cast<unsigned>(I2C_SCAN_ADDRESS_MAX)
-    );
-  } else {
-    ESP_LOGI(
-      TAG,
-      "I2C scan found %u device(s): %s",
-      static_cast<unsigned>(device_count),
-      discovered.c_str()
-    );
-  }
-
-  if (target_found) {
-    ESP_LOGI(TAG, "I2C target 0x%02X was found during scan", this->address_);
-  } else {
-    ESP_LOGW(TAG, "I2C target 0x%02X was not found during scan", this->address_);
-  }
-
-  return device_count > 0u;
-}
-
-bool MCF8316DComponent::establish_communications_(
-  uint8_t attempts, uint32_t retry_delay_ms, bool log_retry_delays
-) {
-  if (attempts == 0u) {
-    return false;
-  }
-
-  for (uint8_t attempt = 1u; attempt <= attempts; attempt++) {
-    i2c::ErrorCode ack_error = i2c::ERROR_UNKNOWN;
-    if (!this->probe_device_ack_(ack_error)) {
-      ESP_LOGW(
-        TAG,
-        "Comms attempt %u/%u: address 0x%02X probe failed: %s (%d)",
-        static_cast<unsigned>(attempt),
-        static_cast<unsigned>(attempts),
-        this->address_,
-        this->i2c_error_to_string_(ack_error),
-        static_cast<int>(ack_error)
-      );
-    } else if (this->read_probe_and_publish_()) {
-      ESP_LOGI(
-        TAG,
-        "I2C communications established with 0x%02X (attempt %u/%u)",
-        this->address_,
-        static_cast<unsigned>(attempt),
-        static_cast<unsigned>(attempts)
-      );
-      return true;
-    } else {
-      ESP_LOGW(
-        TAG,
-        "Comms attempt %u/%u: address 0x%02X ACKed but register probe failed",
-        static_cast<unsigned>(attempt),
-        static_cast<unsigned>(attempts),
-        this->address_
-      );
-    }
-
-    if (attempt < attempts && retry_delay_ms > 0u) {
-      if (log_retry_delays) {
-        ESP_LOGW(TAG, "Retrying communications in %ums", static_cast<unsigned>(retry_delay_ms));
-      }
-      delay(retry_delay_ms);
-    }
-  }
-
-  return false;
-}
-
-void MCF8316DComponent::process_deferred_startup_() {
-  const uint32_t now = millis();
-  const bool should_scan = this->deferred_comms_last_scan_ms_ == 0u ||
-                           (now - this->deferred_comms_last_scan_ms_) >= DEFERRED_SCAN_INTERVAL_MS;
-  if (should_scan) {
-    if (!this->scan_i2c_bus_()) {
-      ESP_LOGW(TAG, "Deferred I2C scan failed; keeping deferred retry mode");
-      this->status_set_warning();
-    }
-    this->deferred_comms_last_scan_ms_ = now;
-  }
+bool MCF8316DComponent::ack_address(uint8_t address) { return this->comms_.ack(this->bus_, address); }
 
-  if (this->deferred_comms_last_retry_ms_ != 0u && (now - this->deferred_comms_last_retry_ms_) < DEFERRED_COMMS_RETRY_INTERVAL_MS) {
-    return;
-  }
-  this->deferred_comms_last_retry_ms_ = now;
+bool MCF8316DComponent::probe_target() { return this->read_probe_and_publish_(); }
 
-  if (!this->establish_communications_(1u, 0u, false)) {
-    this->status_set_warning();
-    return;
+void MCF8316DComponent::process_comms_bringup_() {
+  if (this->comms_.step(*this, *this, TAG, millis())) {
+    this->normal_operation_ready_ = true;
+    this->apply_post_comms_setup_();
   }
-
-  ESP_LOGI(TAG, "I2C communications recovered; entering normal operation");
-  this->status_clear_warning();
-  this->normal_operation_ready_ = true;
-  this->apply_post_comms_setup_();
 }
 
 void MCF8316DComponent::apply_post_comms_setup_() {
+  this->poll_.reset();
+  this->watchdog_.start(millis());
+
   if (this->speed_number_ != nullptr) {
     this->speed_number_->publish_state(0.0f);
   }
@@ -502,6 +381,7 @@ void MCF8316DComponent::apply_post_comms_setup_() {
   }
 
   this->tuning_.apply_post_comms_setup();
+  this->tuning_store_.warm_start(this->service_, TAG);
 }
 
 bool MCF8316DComponent::read_reg32(RegisterId id, uint32_t& value) {
@@ -521,47 +401,15 @@ bool MCF8316DComponent::update_bits32(RegisterId id, uint32_t mask, uint32_t val
 }
 
 bool MCF8316DComponent::read_register32(uint16_t offset, uint32_t *value) {
-  if (value == nullptr) {
-    return false;
-  }
-  const auto command = ::mcf83xx_common::make_control_frame(
-      true, offset, ::mcf83xx_common::RegisterWidth::BITS_32);
-  uint8_t rx[4] = {0, 0, 0, 0};
-  const i2c::ErrorCode err = this->write_read(command.data(), command.size(), rx, sizeof(rx));
-  if (err != i2c::ERROR_OK) {
-    ESP_LOGW(TAG, "read_reg32(0x%04X) failed: i2c error %d", offset, static_cast<int>(err));
-    return false;
-  }
-  *value = ::mcf83xx_common::decode_read32(rx);
-  return true;
+  return mcf83xx_facade::read_register32(this->bus_, this->address_, TAG, offset, value);
 }
 
 bool MCF8316DComponent::read_register16(uint16_t offset, uint16_t *value) {
-  if (value == nullptr) {
-    return false;
-  }
-  const auto command = ::mcf83xx_common::make_control_frame(
-      true, offset, ::mcf83xx_common::RegisterWidth::BITS_16);
-  uint8_t rx[2] = {0, 0};
-  const i2c::ErrorCode err = this->write_read(command.data(), command.size(), rx, sizeof(rx));
-  if (err != i2c::ERROR_OK) {
-    ESP_LOGW(TAG, "read_reg16(0x%04X) failed: i2c error %d", offset, static_cast<int>(err));
-    return false;
-  }
-  *value = ::mcf83xx_common::decode_read16(rx);
-  return true;
+  return mcf83xx_facade::read_register16(this->bus_, this->address_, TAG, offset, value);
 }
 
 bool MCF8316DComponent::write_register32(uint16_t offset, uint32_t value) {
-  const auto frame = ::mcf83xx_common::make_write32_frame(offset, value);
-  const i2c::ErrorCode err = this->write(frame.data(), frame.size());
-  if (err != i2c::ERROR_OK) {
-    ESP_LOGW(
-      TAG, "write_reg32(0x%04X, 0x%08X) failed: i2c error %d", offset, value, static_cast<int>(err)
-    );
-    return false;
-  }
-  return true;
+  return mcf83xx_facade::write_register32(this->bus_, this->address_, TAG, offset, value);
 }
 
 void MCF8316DComponent::delay_microseconds(uint32_t delay_us) {
@@ -619,7 +467,7 @@ bool MCF8316DComponent::set_speed_percent(float speed_percent) {
     return false;
   }
 
-  const float clamped = clamp(speed_percent, 0.0f, 100.0f);
+  const float clamped = ::mcf83xx_common::clamp_speed_percent(speed_percent);
   if (this->speed_number_ != nullptr) {
     this->speed_number_->publish_state(clamped);
   }
@@ -632,16 +480,28 @@ void MCF8316DComponent::pulse_clear_faults() {
   uint32_t ctrl_before = 0;
   uint32_t gate_after = 0;
   uint32_t ctrl_after = 0;
-  const bool gate_before_ok = this->read_reg32(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_before);
-  const bool ctrl_before_ok = this->read_reg32(RegisterId::CONTROLLER_FAULT_STATUS, ctrl_before);
-
-  if (!this->service_.pulse_clear_faults()) {
+  // Tuning flows clear faults from inside update(); the snapshot taken after
+  // CLR_FLT then serves the rest of that update.
+  const bool in_update = this->diagnostics_.active();
+  this->diagnostics_.begin();
+  this->diagnostics_.require(this->service_, ::mcf8316d_core::DIAGNOSTIC_STATUS);
+  const bool gate_before_ok = this->diagnostics_.value(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_before);
+  const bool ctrl_before_ok = this->diagnostics_.value(RegisterId::CONTROLLER_FAULT_STATUS, ctrl_before);
+
+  const bool pulsed = this->service_.pulse_clear_faults();
+  // CLR_FLT changes the status registers, so the rest is a new snapshot.
+  this->diagnostics_.begin();
+  if (!pulsed) {
     ESP_LOGW(TAG, "Failed to pulse CLR_FLT");
+    if (!in_update) {
+      this->diagnostics_.end();
+    }
     return;
   }
 
-  const bool gate_after_ok = this->read_reg32(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_after);
-  const bool ctrl_after_ok = this->read_reg32(RegisterId::CONTROLLER_FAULT_STATUS, ctrl_after);
+  this->diagnostics_.require(this->service_, ::mcf8316d_core::DIAGNOSTIC_STATUS);
+  const bool gate_after_ok = this->diagnostics_.value(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_after);
+  const bool ctrl_after_ok = this->diagnostics_.value(RegisterId::CONTROLLER_FAULT_STATUS, ctrl_after);
 
   if (gate_before_ok || ctrl_before_ok || gate_after_ok || ctrl_after_ok) {
     ESP_LOGI(
@@ -675,16 +535,13 @@ void MCF8316DComponent::pulse_clear_faults() {
     ESP_LOGW(TAG, "CLR_FLT did not clear buck faults; condition likely still active");
     this->log_buck_fault_diagnostics_("clear_faults", gate_after);
   }
-}
-
-void MCF8316DComponent::pulse_watchdog_tickle() {
-  ESP_LOGD(TAG, "Pulsing watchdog tickle");
-  if (!this->service_.pulse_watchdog_tickle()) {
-    ESP_LOGW(TAG, "Failed to pulse watchdog tickle");
+  if (!in_update) {
+    this->diagnostics_.end();
   }
-  this->last_watchdog_tickle_ms_ = millis();
 }
 
+void MCF8316DComponent::pulse_watchdog_tickle() { this->watchdog_.pulse(this->service_, TAG, millis()); }
+
 bool MCF8316DComponent::apply_startup_tune_profile() { return this->tuning_.apply_startup_tune_profile(); }
 
 bool MCF8316DComponent::apply_hw_lock_report_only_profile() {
@@ -705,9 +562,11 @@ bool MCF8316DComponent::read_probe_and_publish_() {
   bool fault_state_valid = false;
   bool ok = true;
 
-  const bool gate_ok = this->read_reg32(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_fault_status);
-  const bool algo_ok = this->read_reg32(RegisterId::ALGO_STATUS, algo_status);
-  const bool controller_ok = this->read_reg32(RegisterId::CONTROLLER_FAULT_STATUS, fault_status);
+  this->diagnostics_.begin();
+  this->diagnostics_.require(this->service_, ::mcf8316d_core::DIAGNOSTIC_STATUS);
+  const bool gate_ok = this->diagnostics_.value(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_fault_status);
+  const bool algo_ok = this->diagnostics_.value(RegisterId::ALGO_STATUS, algo_status);
+  const bool controller_ok = this->diagnostics_.value(RegisterId::CONTROLLER_FAULT_STATUS, fault_status);
   ok &= algo_ok;
   ok &= gate_ok;
   ok &= controller_ok;
@@ -730,6 +589,7 @@ bool MCF8316DComponent::read_probe_and_publish_() {
   if (fault_state_valid && this->fault_active_binary_sensor_ != nullptr) {
     this->fault_active_binary_sensor_->publish_state(fault_active);
   }
+  this->diagnostics_.end();
 
   return ok;
 }
@@ -741,125 +601,26 @@ void MCF8316DComponent::publish_faults_(
   uint32_t fault_status,
   bool controller_fault_valid
 ) {
-  std::vector<std::string> faults;
-  bool gate_detail_found = false;
-  bool controller_detail_found = false;
+  mcf83xx_facade::FaultSummaryText summary;
   if (gate_fault_valid) {
-    if (gate_fault_status & GATE_FAULT_OCP)
-      faults.emplace_back("DRV_OCP"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_OVP)
-      faults.emplace_back("DRV_OVP"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_OTW)
-      faults.emplace_back("DRV_OTW"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_OTS)
-      faults.emplace_back("DRV_OTS"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_OCP_HA)
-      faults.emplace_back("DRV_OCP_HA"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_OCP_LA)
-      faults.emplace_back("DRV_OCP_LA"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_OCP_HB)
-      faults.emplace_back("DRV_OCP_HB"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_OCP_LB)
-      faults.emplace_back("DRV_OCP_LB"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_OCP_HC)
-      faults.emplace_back("DRV_OCP_HC"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_OCP_LC)
-      faults.emplace_back("DRV_OCP_LC"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_BUCK_OCP)
-      faults.emplace_back("DRV_BUCK_OCP"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_BUCK_UV)
-      faults.emplace_back("DRV_BUCK_UV"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_VCP_UV)
-      faults.emplace_back("DRV_VCP_UV"), gate_detail_found = true;
-    if ((gate_fault_status & GATE_DRIVER_FAULT_ACTIVE_MASK) != 0 && !gate_detail_found) {
-      faults.emplace_back("DRV_FAULT_ACTIVE");
-    }
+    mcf83xx_facade::append_fault_names(
+      summary, gate_fault_status, GATE_FAULT_NAMES, GATE_DRIVER_FAULT_ACTIVE_MASK, "DRV_FAULT_ACTIVE"
+    );
   }
   if (controller_fault_valid) {
-    if (fault_status & FAULT_IPD_FREQ)
-      faults.emplace_back("IPD_FREQ_FAULT"), controller_detail_found = true;
-    if (fault_status & FAULT_IPD_T1)
-      faults.emplace_back("IPD_T1_FAULT"), controller_detail_found = true;
-    if (fault_status & FAULT_IPD_T2)
-      faults.emplace_back("IPD_T2_FAULT"), controller_detail_found = true;
-    if (fault_status & FAULT_MPET_IPD)
-      faults.emplace_back("MPET_IPD_FAULT"), controller_detail_found = true;
-    if (fault_status & FAULT_MPET_BEMF)
-      faults.emplace_back("MPET_BEMF_FAULT"), controller_detail_found = true;
-    if (fault_status & FAULT_WATCHDOG)
-      faults.emplace_back("WATCHDOG_FAULT"), controller_detail_found = true;
-    if (fault_status & FAULT_NO_MTR)
-      faults.emplace_back("NO_MTR"), controller_detail_found = true;
-    if (fault_status & FAULT_MTR_LCK)
-      faults.emplace_back("MTR_LCK"), controller_detail_found = true;
-    if (fault_status & FAULT_LOCK_LIMIT)
-      faults.emplace_back("LOCK_LIMIT"), controller_detail_found = true;
-    if (fault_status & FAULT_HW_LOCK_LIMIT)
-      faults.emplace_back("HW_LOCK_LIMIT"), controller_detail_found = true;
-    if (fault_status & FAULT_ABN_SPEED)
-      faults.emplace_back("ABN_SPEED"), controller_detail_found = true;
-    if (fault_status & FAULT_ABN_BEMF)
-      faults.emplace_back("ABN_BEMF"), controller_detail_found = true;
-    if (fault_status & FAULT_MTR_UNDER_VOLTAGE)
-      faults.emplace_back("MTR_UNDER_VOLTAGE"), controller_detail_found = true;
-    if (fault_status & FAULT_MTR_OVER_VOLTAGE)
-      faults.emplace_back("MTR_OVER_VOLTAGE"), controller_detail_found = true;
-    if (fault_status & FAULT_SPEED_LOOP_SATURATION)
-      faults.emplace_back("SPEED_LOOP_SATURATION"), controller_detail_found = true;
-    if (fault_status & FAULT_CURRENT_LOOP_SATURATION)
-      faults.emplace_back("CURRENT_LOOP_SATURATION"), controller_detail_found = true;
-    if (fault_status & FAULT_MAX_SPEED_SATURATION)
-      faults.emplace_back("MAX_SPEED_SATURATION"), controller_detail_found = true;
-    if (fault_status & FAULT_BUS_POWER_LIMIT_SATURATION)
-      faults.emplace_back("BUS_POWER_LIMIT_SATURATION"), controller_detail_found = true;
-    if (fault_status & FAULT_EEPROM_WRITE_LOCK_SET)
-      faults.emplace_back("EEPROM_WRITE_LOCK_SET"), controller_detail_found = true;
-    if (fault_status & FAULT_EEPROM_READ_LOCK_SET)
-      faults.emplace_back("EEPROM_READ_LOCK_SET"), controller_detail_found = true;
-    if (fault_status & FAULT_I2C_CRC)
-      faults.emplace_back("I2C_CRC_FAULT_STATUS"), controller_detail_found = true;
-    if (fault_status & FAULT_EEPROM_ERR)
-      faults.emplace_back("EEPROM_ERR_STATUS"), controller_detail_found = true;
-    if (fault_status & FAULT_BOOT_STL)
-      faults.emplace_back("BOOT_STL_FAULT"), controller_detail_found = true;
-    if (fault_status & FAULT_CPU_RESET)
-      faults.emplace_back("CPU_RESET_FAULT_STATUS"), controller_detail_found = true;
-    if (fault_status & FAULT_WWDT)
-      faults.emplace_back("WWDT_FAULT_STATUS"), controller_detail_found = true;
-    if ((fault_status & CONTROLLER_FAULT_ACTIVE_MASK) != 0 && !controller_detail_found) {
-      faults.emplace_back("CTRL_FAULT_ACTIVE");
-    }
-  }
-
-  std::string summary = "none";
-  if (!faults.empty()) {
-    summary.clear();
-    for (size_t i = 0; i < faults.size(); i++) {
-      if (i != 0) {
-        summary += ",";
-      }
-      summary += faults[i];
-    }
-  }
-
-  if (this->fault_summary_text_sensor_ != nullptr) {
-    this->fault_summary_text_sensor_->publish_state(summary);
-  }
-  if (summary != this->last_fault_summary_) {
-    if (summary == "none") {
-      ESP_LOGI(TAG, "Faults cleared");
-    } else {
-      ESP_LOGW(TAG, "Active faults: %s", summary.c_str());
-    }
-    this->last_fault_summary_ = summary;
+    mcf83xx_facade::append_fault_names(
+      summary, fault_status, CONTROLLER_FAULT_NAMES, CONTROLLER_FAULT_ACTIVE_MASK, "CTRL_FAULT_ACTIVE"
+    );
   }
+  mcf83xx_facade::publish_fault_summary(summary, this->fault_summary_guard_, this->fault_summary_text_sensor_, TAG);
 }
 
 void MCF8316DComponent::log_buck_fault_diagnostics_(
   const char* context, uint32_t gate_fault_status
 ) {
   uint32_t gd_config2 = 0;
-  const bool gd_ok = this->read_reg32(RegisterId::GD_CONFIG2, gd_config2);
+  this->diagnostics_.require(this->service_, ::mcf8316d_core::DIAGNOSTIC_BUCK);
+  const bool gd_ok = this->diagnostics_.value(RegisterId::GD_CONFIG2, gd_config2);
 
   const bool buck_ocp = (gate_fault_status & GATE_FAULT_BUCK_OCP) != 0;
   const bool buck_uv = (gate_fault_status & GATE_FAULT_BUCK_UV) != 0;
@@ -939,8 +700,9 @@ void MCF8316DComponent::log_buck_fault_diagnostics_(
 void MCF8316DComponent::log_lock_limit_diagnostics_(
   const char* context, uint32_t controller_fault_status
 ) {
-  uint16_t algorithm_state = 0;
-  uint16_t csa_gain_feedback = 0;
+  using namespace ::mcf8316d_core;
+  uint32_t algorithm_state = 0;
+  uint32_t csa_gain_feedback = 0;
   uint32_t algo_status = 0;
   uint32_t algo_debug1 = 0;
   uint32_t algo_debug2 = 0;
@@ -954,20 +716,24 @@ void MCF8316DComponent::log_lock_limit_diagnostics_(
   uint32_t isd_config = 0;
   uint32_t rev_drive_config = 0;
 
-  const bool state_ok = this->read_reg16(RegisterId::ALGORITHM_STATE, algorithm_state);
-  const bool csa_fb_ok = this->read_reg16(RegisterId::CSA_GAIN_FEEDBACK, csa_gain_feedback);
-  const bool algo_ok = this->read_reg32(RegisterId::ALGO_STATUS, algo_status);
-  const bool dbg1_ok = this->read_reg32(RegisterId::ALGO_DEBUG1, algo_debug1);
-  const bool dbg2_ok = this->read_reg32(RegisterId::ALGO_DEBUG2, algo_debug2);
-  const bool cl1_ok = this->read_reg32(RegisterId::CLOSED_LOOP1, closed_loop1);
-  const bool dev2_ok = this->read_reg32(RegisterId::DEVICE_CONFIG2, device_config2);
-  const bool fault_cfg_ok = this->read_reg32(RegisterId::FAULT_CONFIG1, fault_config1);
-  const bool fault_cfg2_ok = this->read_reg32(RegisterId::FAULT_CONFIG2, fault_config2);
-  const bool gd1_ok = this->read_reg32(RegisterId::GD_CONFIG1, gd_config1);
-  const bool startup1_ok = this->read_reg32(RegisterId::MOTOR_STARTUP1, startup1);
-  const bool startup2_ok = this->read_reg32(RegisterId::MOTOR_STARTUP2, startup2);
-  const bool isd_ok = this->read_reg32(RegisterId::ISD_CONFIG, isd_config);
-  const bool rev_ok = this->read_reg32(RegisterId::REV_DRIVE_CONFIG, rev_drive_config);
+  // The MPET entry registers are read here too, for the log below.
+  this->diagnostics_.require(
+    this->service_, DIAGNOSTIC_ALGORITHM_STATE | DIAGNOSTIC_LOCK_LIMIT | DIAGNOSTIC_MPET_ENTRY
+  );
+  const bool state_ok = this->diagnostics_.value(RegisterId::ALGORITHM_STATE, algorithm_state);
+  const bool csa_fb_ok = this->diagnostics_.value(RegisterId::CSA_GAIN_FEEDBACK, csa_gain_feedback);
+  const bool algo_ok = this->diagnostics_.value(RegisterId::ALGO_STATUS, algo_status);
+  const bool dbg1_ok = this->diagnostics_.value(RegisterId::ALGO_DEBUG1, algo_debug1);
+  const bool dbg2_ok = this->diagnostics_.value(RegisterId::ALGO_DEBUG2, algo_debug2);
+  const bool cl1_ok = this->diagnostics_.value(RegisterId::CLOSED_LOOP1, closed_loop1);
+  const bool dev2_ok = this->diagnostics_.value(RegisterId::DEVICE_CONFIG2, device_config2);
+  const bool fault_cfg_ok = this->diagnostics_.value(RegisterId::FAULT_CONFIG1, fault_config1);
+  const bool fault_cfg2_ok = this->diagnostics_.value(RegisterId::FAULT_CONFIG2, fault_config2);
+  const bool gd1_ok = this->diagnostics_.value(RegisterId::GD_CONFIG1, gd_config1);
+  const bool startup1_ok = this->diagnostics_.value(RegisterId::MOTOR_STARTUP1, startup1);
+  const bool startup2_ok = this->diagnostics_.value(RegisterId::MOTOR_STARTUP2, startup2);
+  const bool isd_ok = this->diagnostics_.value(RegisterId::ISD_CONFIG, isd_config);
+  const bool rev_ok = this->diagnostics_.value(RegisterId::REV_DRIVE_CONFIG, rev_drive_config);
 
   ESP_LOGW(
     TAG,
@@ -977,7 +743,7 @@ void MCF8316DComponent::log_lock_limit_diagnostics_(
     context,
     controller_fault_status,
     static_cast<unsigned>(algorithm_state),
-    this->algorithm_state_to_string_(algorithm_state),
+    this->algorithm_state_to_string_(static_cast<uint16_t>(algorithm_state)),
     algo_status,
     algo_debug1,
     algo_debug2,
@@ -1270,12 +1036,11 @@ bool MCF8316DComponent::should_force_speed_shutdown_(
   const uint32_t motor_lock_faults =
     FAULT_MTR_LCK | FAULT_ABN_SPEED | FAULT_ABN_BEMF | FAULT_NO_MTR;
   uint32_t fault_config1 = 0;
-  bool fault_config1_valid = false;
-  if ((remaining_faults & (FAULT_LOCK_LIMIT | motor_lock_faults)) != 0u) {
-    fault_config1_valid = this->read_reg32(RegisterId::FAULT_CONFIG1, fault_config1);
-    if (!fault_config1_valid) {
-      return true;
-    }
+  uint32_t fault_config2 = 0;
+  this->diagnostics_.require(this->service_, ::mcf8316d_core::DIAGNOSTIC_LOCK_MODE);
+  if ((remaining_faults & (FAULT_LOCK_LIMIT | motor_lock_faults)) != 0u &&
+      !this->diagnostics_.value(RegisterId::FAULT_CONFIG1, fault_config1)) {
+    return true;
   }
 
   if ((remaining_faults & FAULT_LOCK_LIMIT) != 0u) {
@@ -1295,8 +1060,7 @@ bool MCF8316DComponent::should_force_speed_shutdown_(
   }
 
   if ((remaining_faults & FAULT_HW_LOCK_LIMIT) != 0u) {
-    uint32_t fault_config2 = 0;
-    if (!this->read_reg32(RegisterId::FAULT_CONFIG2, fault_config2)) {
+    if (!this->diagnostics_.value(RegisterId::FAULT_CONFIG2, fault_config2)) {
       return true;
     }
     const uint32_t hw_lock_mode = (fault_config2 & FAULT_CONFIG2_HW_LOCK_ILIMIT_MODE_MASK) >>
@@ -1332,10 +1096,11 @@ void MCF8316DComponent::log_control_diagnostics_(
   uint32_t peri_config1 = 0;
   uint32_t algo_debug1 = 0;
   uint32_t isd_config = 0;
-  const bool pin_ok = this->read_reg32(RegisterId::PIN_CONFIG, pin_config);
-  const bool peri_ok = this->read_reg32(RegisterId::PERI_CONFIG1, peri_config1);
-  const bool dbg1_ok = this->read_reg32(RegisterId::ALGO_DEBUG1, algo_debug1);
-  const bool isd_ok = this->read_reg32(RegisterId::ISD_CONFIG, isd_config);
+  this->diagnostics_.require(this->service_, ::mcf8316d_core::DIAGNOSTIC_CONTROL);
+  const bool pin_ok = this->diagnostics_.value(RegisterId::PIN_CONFIG, pin_config);
+  const bool peri_ok = this->diagnostics_.value(RegisterId::PERI_CONFIG1, peri_config1);
+  const bool dbg1_ok = this->diagnostics_.value(RegisterId::ALGO_DEBUG1, algo_debug1);
+  const bool isd_ok = this->diagnostics_.value(RegisterId::ISD_CONFIG, isd_config);
 
   const uint32_t brake_input_value =
     pin_ok ? ((pin_config & PIN_CONFIG_BRAKE_INPUT_MASK) >> 10) : 0u;
@@ -1361,7 +1126,7 @@ void MCF8316DComponent::log_control_diagnostics_(
 
   const float duty_percent = (static_cast<float>(duty_raw) / 4095.0f) * 100.0f;
   const float volt_mag_percent = (static_cast<float>(volt_mag_raw) * 100.0f) / 32768.0f;
-  const float digital_speed_percent = (static_cast<float>(digital_speed_raw) / 32767.0f) * 100.0f;
+  const float digital_speed_percent = ::mcf83xx_common::speed_code_to_percent(digital_speed_raw);
 
   ESP_LOGI(
     TAG,
@@ -1412,6 +1177,19 @@ void MCF8316DComponent::log_control_diagnostics_(
   }
 }
 
+bool MCF8316DComponent::read_algorithm_state_(uint16_t& algorithm_state) {
+  if (!this->diagnostics_.active()) {
+    return this->read_reg16(RegisterId::ALGORITHM_STATE, algorithm_state);
+  }
+  uint32_t value = 0;
+  this->diagnostics_.require(this->service_, ::mcf8316d_core::DIAGNOSTIC_ALGORITHM_STATE);
+  if (!this->diagnostics_.value(RegisterId::ALGORITHM_STATE, value)) {
+    return false;
+  }
+  algorithm_state = static_cast<uint16_t>(value);
+  return true;
+}
+
 void MCF8316DComponent::publish_algo_status_(uint32_t algo_status) {
   const uint16_t duty_raw = (algo_status & ALGO_STATUS_DUTY_CMD_MASK) >> ALGO_STATUS_DUTY_CMD_SHIFT;
   const uint16_t volt_mag_raw =
@@ -1435,17 +1213,9 @@ void MCF8316DComponent::publish_algo_status_(uint32_t algo_status) {
 }
 
 void MCF8316DComponent::handle_fault_shutdown_(bool fault_active) {
-  if (!fault_active) {
-    this->fault_latched_ = false;
-    return;
+  if (mcf83xx_facade::latch_fault_shutdown(fault_active, this->fault_latched_, TAG)) {
+    (void)this->set_speed_percent(0.0f);
   }
-  if (this->fault_latched_) {
-    return;
-  }
-
-  this->fault_latched_ = true;
-  ESP_LOGW(TAG, "Fault detected, forcing speed command to 0%%");
-  (void)this->set_speed_percent(0.0f);
 }
 
 }  // namespace mcf8316d
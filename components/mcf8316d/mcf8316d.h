@@ -12,8 +12,13 @@
 #include "esphome/components/switch/switch.h"
 #include "esphome/components/text_sensor/text_sensor.h"
 #include "esphome/core/component.h"
+#include "esphome/core/preferences.h"
 
+#include "../component_common/fixed_string.h"
+#include "../mcf83xx_facade/facade.h"
 #include "mcf8316d_bus.h"
+#include "mcf8316d_diagnostics.h"
+#include "mcf8316d_poll_service.h"
 #include "mcf8316d_protocol.h"
 #include "mcf8316d_service.h"
 #include "mcf8316d_tuning.h"
@@ -124,10 +129,12 @@ class MCF8316DRunScopeProbeTestButton : public button::Button {
 
 class MCF8316DComponent : public PollingComponent,
                           public i2c::I2CDevice,
-                          public ::mcf8316d_core::RegisterBus {
+                          public ::mcf8316d_core::RegisterBus,
+                          public ::mcf83xx_common::CommsProbe {
  public:
   MCF8316DComponent();
   void setup() override;
+  void loop() override;
   void update() override;
   void dump_config() override;
 
@@ -136,6 +143,9 @@ class MCF8316DComponent : public PollingComponent,
   bool write_register32(uint16_t offset, uint32_t value) override;
   void delay_microseconds(uint32_t delay_us) override;
 
+  bool ack_address(uint8_t address) override;
+  bool probe_target() override;
+
   bool read_reg32(RegisterId id, uint32_t& value);
   bool read_reg16(RegisterId id, uint16_t& value);
   bool write_reg32(RegisterId id, uint32_t value);
@@ -155,7 +165,34 @@ class MCF8316DComponent : public PollingComponent,
     inter_byte_delay_us_ = inter_byte_delay_us;
   }
   void set_auto_tickle_watchdog(bool auto_tickle_watchdog) {
-    auto_tickle_watchdog_ = auto_tickle_watchdog;
+    watchdog_.set_enabled(auto_tickle_watchdog);
+  }
+  void set_watchdog_tickle_interval_ms(uint32_t interval_ms) {
+    watchdog_.set_interval_ms(interval_ms);
+  }
+  void set_watchdog_timeout_ms(uint32_t timeout_ms) {
+    watchdog_.set_timeout_ms(timeout_ms);
+  }
+  void set_slow_poll_interval_ms(uint32_t interval_ms) {
+    poll_schedule_.slow_interval_ms = interval_ms;
+  }
+  void set_comms_backoff_ms(uint32_t initial_ms, uint32_t max_ms) {
+    comms_.set_backoff_ms(initial_ms, max_ms);
+  }
+  void set_comms_deadline_ms(uint32_t deadline_ms) {
+    comms_.set_deadline_ms(deadline_ms);
+  }
+  void set_comms_scan_range(uint8_t first_address, uint8_t last_address) {
+    comms_.set_scan_range(first_address, last_address);
+  }
+  void set_persist_tuning_results(bool persist_tuning_results) {
+    tuning_store_.set_persist(persist_tuning_results);
+  }
+  void set_tuning_preference_key(uint32_t key) {
+    tuning_store_.set_preference_key(key);
+  }
+  void set_tuning_config_hash(uint32_t config_hash) {
+    tuning_store_.set_config_hash(config_hash);
   }
 
   void set_brake_switch(MCF8316DBrakeSwitch* sw) {
@@ -182,23 +219,37 @@ class MCF8316DComponent : public PollingComponent,
   void set_volt_mag_percent_sensor(sensor::Sensor* s) {
     volt_mag_percent_sensor_ = s;
   }
+  void set_tuning_time_saved_sensor(sensor::Sensor* s) {
+    tuning_store_.set_time_saved_sensor(s);
+  }
+  void set_time_to_first_ack_sensor(sensor::Sensor* s) {
+    comms_.set_time_to_first_ack_sensor(s);
+  }
+  void set_watchdog_tickle_jitter_sensor(sensor::Sensor* s) {
+    watchdog_.set_jitter_sensor(s);
+  }
+  void set_watchdog_margin_sensor(sensor::Sensor* s) {
+    watchdog_.set_margin_sensor(s);
+  }
   void set_fault_summary_text_sensor(text_sensor::TextSensor* s) {
     fault_summary_text_sensor_ = s;
   }
   void set_algorithm_state_text_sensor(text_sensor::TextSensor* s) {
     algorithm_state_text_sensor_ = s;
   }
+  void set_startup_sweep_summary_text_sensor(text_sensor::TextSensor* s) {
+    startup_sweep_summary_text_sensor_ = s;
+  }
+  void set_scope_probe_result_text_sensor(text_sensor::TextSensor* s) {
+    scope_probe_result_text_sensor_ = s;
+  }
 
  protected:
   friend class MCF8316DTuningController;
 
   bool read_probe_and_publish_();
-  bool establish_communications_(uint8_t attempts, uint32_t retry_delay_ms, bool log_retry_delays);
-  bool probe_device_ack_(i2c::ErrorCode& error_code) const;
-  bool scan_i2c_bus_();
-  void process_deferred_startup_();
+  void process_comms_bringup_();
   void apply_post_comms_setup_();
-  const char* i2c_error_to_string_(i2c::ErrorCode error_code) const;
   void publish_faults_(
     uint32_t gate_fault_status,
     bool gate_fault_valid,
@@ -206,6 +257,8 @@ class MCF8316DComponent : public PollingComponent,
     bool controller_fault_valid
   );
   void publish_algo_status_(uint32_t algo_status);
+  // ALGORITHM_STATE from the diagnostic snapshot while one is active.
+  bool read_algorithm_state_(uint16_t& algorithm_state);
   void log_buck_fault_diagnostics_(const char* context, uint32_t gate_fault_status);
   void log_lock_limit_diagnostics_(const char* context, uint32_t controller_fault_status);
   void log_control_diagnostics_(
@@ -227,8 +280,7 @@ class MCF8316DComponent : public PollingComponent,
   void handle_fault_shutdown_(bool fault_active);
 
   uint32_t inter_byte_delay_us_{100};
-  bool auto_tickle_watchdog_{false};
-  uint32_t last_watchdog_tickle_ms_{0};
+  mcf83xx_facade::WatchdogTickler watchdog_;
   uint32_t last_lock_limit_diag_log_ms_{0};
   uint32_t last_buck_diag_log_ms_{0};
   uint32_t last_vm_diag_log_ms_{0};
@@ -238,12 +290,15 @@ class MCF8316DComponent : public PollingComponent,
   bool fault_latched_{false};
   bool allow_retry_notice_active_{false};
   bool normal_operation_ready_{false};
-  uint32_t deferred_comms_last_retry_ms_{0};
-  uint32_t deferred_comms_last_scan_ms_{0};
+  mcf83xx_facade::CommsLink comms_;
   uint16_t last_run_state_diag_value_{0xFFFFu};
   uint16_t last_control_diag_state_{0xFFFFu};
-  std::string last_fault_summary_{"none"};
+  ::component_common::PublishGuard fault_summary_guard_{};
   ::mcf8316d_core::MCF8316DService service_;
+  ::mcf8316d_core::PollSchedule poll_schedule_{};
+  ::mcf8316d_core::MCF8316DPollService poll_;
+  ::mcf8316d_core::MCF8316DDiagnosticSnapshot diagnostics_;
+  mcf83xx_facade::TuningStore tuning_store_{0x8316D001u};
   MCF8316DTuningController tuning_;
 
   MCF8316DBrakeSwitch* brake_switch_{nullptr};
@@ -256,6 +311,8 @@ class MCF8316DComponent : public PollingComponent,
   sensor::Sensor* volt_mag_percent_sensor_{nullptr};
   text_sensor::TextSensor* fault_summary_text_sensor_{nullptr};
   text_sensor::TextSensor* algorithm_state_text_sensor_{nullptr};
+  text_sensor::TextSensor* startup_sweep_summary_text_sensor_{nullptr};
+  text_sensor::TextSensor* scope_probe_result_text_sensor_{nullptr};
 };
 
 }  // namespace mcf8316d
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../mcf83xx_common/diagnostic_snapshot.h"
+#include "mcf8316d_poll_service.h"
+#include "mcf8316d_registers.h"
+
+namespace mcf8316d_core {
+
+// Register groups the fault shutdown decision and the diagnostic logs
+// consume. A register shared by several groups is still read once per poll.
+using mcf83xx_common::DiagnosticGroups;
+
+inline constexpr DiagnosticGroups DIAGNOSTIC_STATUS = 1U << 0;
+inline constexpr DiagnosticGroups DIAGNOSTIC_ALGORITHM_STATE = 1U << 1;
+// FAULT_CONFIG1/2 lock modes, which decide whether a lock fault forces the
+// speed command to zero.
+inline constexpr DiagnosticGroups DIAGNOSTIC_LOCK_MODE = 1U << 2;
+inline constexpr DiagnosticGroups DIAGNOSTIC_LOCK_LIMIT = 1U << 3;
+inline constexpr DiagnosticGroups DIAGNOSTIC_CONTROL = 1U << 4;
+inline constexpr DiagnosticGroups DIAGNOSTIC_BUCK = 1U << 5;
+// ALGO_DEBUG2 MPET bits and the CLOSED_LOOP2..4 fields whose zero values
+// force MPET on a non-zero speed command.
+inline constexpr DiagnosticGroups DIAGNOSTIC_MPET_ENTRY = 1U << 6;
+inline constexpr DiagnosticGroups DIAGNOSTIC_MPET = 1U << 7;
+
+constexpr DiagnosticGroups diagnostic_groups(regs::RegisterId id) {
+  switch (id) {
+    case regs::RegisterId::CONTROLLER_FAULT_STATUS:
+    case regs::RegisterId::GATE_DRIVER_FAULT_STATUS:
+    case regs::RegisterId::ALGO_STATUS:
+      return DIAGNOSTIC_STATUS;
+    case regs::RegisterId::ALGORITHM_STATE:
+      return DIAGNOSTIC_ALGORITHM_STATE;
+    case regs::RegisterId::FAULT_CONFIG1:
+    case regs::RegisterId::FAULT_CONFIG2:
+      return DIAGNOSTIC_LOCK_MODE | DIAGNOSTIC_LOCK_LIMIT;
+    case regs::RegisterId::CSA_GAIN_FEEDBACK:
+    case regs::RegisterId::CLOSED_LOOP1:
+    case regs::RegisterId::DEVICE_CONFIG2:
+    case regs::RegisterId::GD_CONFIG1:
+    case regs::RegisterId::MOTOR_STARTUP1:
+    case regs::RegisterId::MOTOR_STARTUP2:
+    case regs::RegisterId::REV_DRIVE_CONFIG:
+      return DIAGNOSTIC_LOCK_LIMIT;
+    case regs::RegisterId::ALGO_DEBUG1:
+    case regs::RegisterId::ISD_CONFIG:
+      return DIAGNOSTIC_LOCK_LIMIT | DIAGNOSTIC_CONTROL;
+    case regs::RegisterId::PIN_CONFIG:
+    case regs::RegisterId::PERI_CONFIG1:
+      return DIAGNOSTIC_CONTROL;
+    case regs::RegisterId::GD_CONFIG2:
+      return DIAGNOSTIC_BUCK;
+    case regs::RegisterId::ALGO_DEBUG2:
+      return DIAGNOSTIC_LOCK_LIMIT | DIAGNOSTIC_MPET_ENTRY;
+    case regs::RegisterId::CLOSED_LOOP2:
+    case regs::RegisterId::CLOSED_LOOP3:
+    case regs::RegisterId::CLOSED_LOOP4:
+      return DIAGNOSTIC_MPET_ENTRY;
+    case regs::RegisterId::ALGO_STATUS_MPET:
+    case regs::RegisterId::MTR_PARAMS:
+      return DIAGNOSTIC_MPET;
+    default:
+      return 0;
+  }
+}
+
+struct MCF8316DDiagnosticTables : MCF8316DPollTables {
+  static constexpr DiagnosticGroups groups(RegisterId id) { return diagnostic_groups(id); }
+};
+
+// The shared MCx83xx diagnostic snapshot over the MCF8316D group table. The
+// logs decode the raw values they print, so there is no fields struct.
+using MCF8316DDiagnosticSnapshot = mcf83xx_common::DiagnosticSnapshot<MCF8316DDiagnosticTables>;
+
+}  // namespace mcf8316d_core
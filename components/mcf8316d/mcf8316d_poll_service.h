@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../mcf83xx_common/poll_service.h"
+#include "mcf8316d_registers.h"
+#include "mcf8316d_service.h"
+
+namespace mcf8316d_core {
+
+using mcf83xx_common::PollSchedule;
+using mcf83xx_common::PollTier;
+using mcf83xx_common::PollTierStats;
+
+// The component publishes no speed sensors, so its speed tier is empty and
+// never due; the startup sweep reads SPEED_FDBK itself while it runs.
+constexpr PollTier poll_tier(regs::RegisterId id) {
+  switch (id) {
+    case regs::RegisterId::CONTROLLER_FAULT_STATUS:
+    case regs::RegisterId::GATE_DRIVER_FAULT_STATUS:
+    case regs::RegisterId::ALGO_STATUS:
+      return PollTier::STATUS;
+    case regs::RegisterId::VM_VOLTAGE:
+      return PollTier::SLOW;
+    default:
+      return PollTier::NONE;
+  }
+}
+
+struct MCF8316DPollTables {
+  using RegisterId = regs::RegisterId;
+  static constexpr size_t REGISTER_COUNT = regs::REGISTER_COUNT;
+  static constexpr const auto &DEFINITIONS = regs::REGISTER_DEFINITIONS;
+  static constexpr PollTier tier(RegisterId id) { return poll_tier(id); }
+  static constexpr RegisterId SPEED_FEEDBACK = RegisterId::COUNT;
+};
+
+// The shared MCx83xx tiered poll over the MCF8316D register table.
+using MCF8316DPollService = mcf83xx_common::PollService<MCF8316DPollTables>;
+
+inline constexpr const auto &POLL_TIER_REGISTERS = MCF8316DPollService::TIER_REGISTERS;
+
+}  // namespace mcf8316d_core
@@ -86,4 +86,18 @@ const char *direction_input_to_string(uint32_t direction_input_value) {
   }
 }
 
+float decode_max_speed_hz(uint16_t code) { return static_cast<float>(code & 0x3FFFu) / 6.0f; }
+
+float decode_speed_hz(int32_t raw, float max_speed_hz) {
+  return static_cast<float>(raw) * (1.0f / 134217728.0f) * max_speed_hz;
+}
+
+float decode_fg_speed_hz(uint32_t raw, float max_speed_hz) {
+  return static_cast<float>(raw) * (1.0f / 134217728.0f) * max_speed_hz;
+}
+
+float decode_speed_percent(int32_t raw) { return static_cast<float>(raw) * (100.0f / 134217728.0f); }
+
+float decode_current_amps(int32_t raw) { return static_cast<float>(raw) * (1.0f / 134217728.0f) * (10.0f / 8.0f); }
+
 }  // namespace mcf8316d_core
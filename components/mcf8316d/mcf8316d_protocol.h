@@ -33,8 +33,19 @@ inline constexpr uint32_t ALGO_DEBUG1_FORCE_IPD_EN_MASK = (1u << 12);
 inline constexpr uint32_t ALGO_DEBUG1_FORCE_ISD_EN_MASK = (1u << 11);
 inline constexpr uint32_t ALGO_DEBUG1_FORCE_ALIGN_ANGLE_SRC_SEL_MASK = (1u << 10);
 
-inline constexpr uint32_t ALGO_CTRL1_CLR_FLT_MASK = (1u << 0);
-inline constexpr uint32_t ALGO_CTRL1_WATCHDOG_TICKLE_MASK = (1u << 1);
+inline constexpr uint32_t ALGO_CTRL1_EEPROM_WRT_MASK = (1u << 31);
+inline constexpr uint32_t ALGO_CTRL1_EEPROM_READ_MASK = (1u << 30);
+inline constexpr uint32_t ALGO_CTRL1_CLR_FLT_MASK = (1u << 29);
+inline constexpr uint32_t ALGO_CTRL1_CLR_FLT_RETRY_COUNT_MASK = (1u << 28);
+inline constexpr uint32_t ALGO_CTRL1_EEPROM_WRITE_ACCESS_KEY_MASK = (0xFFu << 20);
+inline constexpr uint32_t ALGO_CTRL1_WATCHDOG_TICKLE_MASK = (1u << 10);
+inline constexpr uint32_t ALGO_CTRL1_STL_CMD_MASK = (1u << 9);
+// One-shot command fields; a write that only means to tickle must leave them 0.
+// STL_CMD starts a self test, so it is never carried over either.
+inline constexpr uint32_t ALGO_CTRL1_COMMAND_MASK = ALGO_CTRL1_EEPROM_WRT_MASK | ALGO_CTRL1_EEPROM_READ_MASK |
+                                                    ALGO_CTRL1_CLR_FLT_MASK | ALGO_CTRL1_CLR_FLT_RETRY_COUNT_MASK |
+                                                    ALGO_CTRL1_EEPROM_WRITE_ACCESS_KEY_MASK |
+                                                    ALGO_CTRL1_WATCHDOG_TICKLE_MASK | ALGO_CTRL1_STL_CMD_MASK;
 
 inline constexpr uint32_t ALGO_DEBUG2_MPET_CMD_MASK = (1u << 5);
 inline constexpr uint32_t ALGO_DEBUG2_MPET_R_MASK = (1u << 4);
@@ -210,4 +221,16 @@ const char *algorithm_state_to_string(uint16_t state);
 const char *brake_input_to_string(uint32_t brake_input_value);
 const char *direction_input_to_string(uint32_t direction_input_value);
 
+// CLOSED_LOOP4.MAX_SPEED is electrical Hz times 6 over its whole range.
+float decode_max_speed_hz(uint16_t code);
+// SPEED_FDBK is signed, FG_SPEED_FDBK unsigned; both are Q27 fractions of
+// MAX_SPEED.
+float decode_speed_hz(int32_t raw, float max_speed_hz);
+float decode_fg_speed_hz(uint32_t raw, float max_speed_hz);
+// SPEED_FDBK as a signed percentage of MAX_SPEED, without reading MAX_SPEED.
+float decode_speed_percent(int32_t raw);
+// BUS_CURRENT and PHASE_CURRENT_A/B/C: signed Q27 times 10/8 A (Tables 9-27
+// to 9-30).
+float decode_current_amps(int32_t raw);
+
 }  // namespace mcf8316d_core
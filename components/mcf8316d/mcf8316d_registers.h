@@ -19,6 +19,11 @@ enum class RegisterId : uint8_t {
   ALGO_DEBUG1,
   ALGO_DEBUG2,
   ALGORITHM_STATE,
+  FG_SPEED_FDBK,
+  BUS_CURRENT,
+  PHASE_CURRENT_A,
+  PHASE_CURRENT_B,
+  PHASE_CURRENT_C,
   ISD_CONFIG,
   REV_DRIVE_CONFIG,
   MOTOR_STARTUP1,
@@ -38,6 +43,7 @@ enum class RegisterId : uint8_t {
   CSA_GAIN_FEEDBACK,
   VOLTAGE_GAIN_FEEDBACK,
   VM_VOLTAGE,
+  SPEED_FDBK,
   COUNT,
 };
 
@@ -56,6 +62,11 @@ inline constexpr std::array<RegisterInfo, REGISTER_COUNT> REGISTER_DEFINITIONS{{
     {.id = RegisterId::ALGO_DEBUG1, .name = "algorithm_debug_1", .address = 0x00EC, .width = RegisterWidth::U32},
     {.id = RegisterId::ALGO_DEBUG2, .name = "algorithm_debug_2", .address = 0x00EE, .width = RegisterWidth::U32},
     {.id = RegisterId::ALGORITHM_STATE, .name = "algorithm_state", .address = 0x018E, .width = RegisterWidth::U16, .masks = {.status = 0xFFFF}},
+    {.id = RegisterId::FG_SPEED_FDBK, .name = "fg_speed_feedback", .address = 0x0194, .width = RegisterWidth::U32, .masks = {.status = 0xFFFFFFFF}},
+    {.id = RegisterId::BUS_CURRENT, .name = "bus_current", .address = 0x040C, .width = RegisterWidth::U32, .masks = {.status = 0xFFFFFFFF}},
+    {.id = RegisterId::PHASE_CURRENT_A, .name = "phase_current_a", .address = 0x0444, .width = RegisterWidth::U32, .masks = {.status = 0xFFFFFFFF}},
+    {.id = RegisterId::PHASE_CURRENT_B, .name = "phase_current_b", .address = 0x0446, .width = RegisterWidth::U32, .masks = {.status = 0xFFFFFFFF}},
+    {.id = RegisterId::PHASE_CURRENT_C, .name = "phase_current_c", .address = 0x0448, .width = RegisterWidth::U32, .masks = {.status = 0xFFFFFFFF}},
     {.id = RegisterId::ISD_CONFIG, .name = "isd_config", .address = 0x0080, .width = RegisterWidth::U32},
     {.id = RegisterId::REV_DRIVE_CONFIG, .name = "reverse_drive_config", .address = 0x0082, .width = RegisterWidth::U32},
     {.id = RegisterId::MOTOR_STARTUP1, .name = "motor_startup_1", .address = 0x0084, .width = RegisterWidth::U32},
@@ -75,6 +86,7 @@ inline constexpr std::array<RegisterInfo, REGISTER_COUNT> REGISTER_DEFINITIONS{{
     {.id = RegisterId::CSA_GAIN_FEEDBACK, .name = "csa_gain_feedback", .address = 0x046C, .width = RegisterWidth::U16, .masks = {.status = 0xFFFF}},
     {.id = RegisterId::VOLTAGE_GAIN_FEEDBACK, .name = "voltage_gain_feedback", .address = 0x0477, .width = RegisterWidth::U16, .masks = {.status = 0xFFFF}},
     {.id = RegisterId::VM_VOLTAGE, .name = "vm_voltage", .address = 0x047C, .width = RegisterWidth::U32, .masks = {.status = 0xFFFFFFFF}},
+    {.id = RegisterId::SPEED_FDBK, .name = "speed_feedback", .address = 0x0782, .width = RegisterWidth::U32, .masks = {.status = 0xFFFFFFFF}},
 }};
 
 static_assert(component_common::register_definitions_have_all_ids_once(REGISTER_DEFINITIONS),
@@ -0,0 +1,116 @@
+#include "mcf8316d_scope_capture.h"
+
+#include <cmath>
+
+namespace mcf8316d_core {
+
+namespace {
+
+float channel_value(const ScopeSample &sample, ScopeChannel channel) {
+  switch (channel) {
+    case ScopeChannel::SPEED:
+      return sample.speed_percent;
+    case ScopeChannel::DUTY:
+      return sample.duty_percent;
+    case ScopeChannel::VM:
+    default:
+      return sample.vm_volts;
+  }
+}
+
+}  // namespace
+
+ScopeChannelStats reduce_scope_channel(const ScopeSample *samples, size_t count, ScopeChannel channel, float band) {
+  ScopeChannelStats stats{};
+  if (samples == nullptr || count == 0u) {
+    return stats;
+  }
+
+  const size_t tail = count / 4u > 0u ? count / 4u : 1u;
+  float tail_sum = 0.0f;
+  for (size_t i = count - tail; i < count; i++) {
+    tail_sum += channel_value(samples[i], channel);
+  }
+  const float final_value = tail_sum / static_cast<float>(tail);
+
+  size_t settle_index = count;
+  while (settle_index > 0u && std::fabs(channel_value(samples[settle_index - 1u], channel) - final_value) <= band) {
+    settle_index--;
+  }
+  stats.settled = settle_index <= count - tail;
+  const size_t first = stats.settled ? settle_index : count - tail;
+  if (stats.settled) {
+    stats.settle_ms = samples[settle_index].t_ms;
+  }
+
+  float sum = 0.0f;
+  stats.min = channel_value(samples[first], channel);
+  stats.max = stats.min;
+  for (size_t i = first; i < count; i++) {
+    const float value = channel_value(samples[i], channel);
+    sum += value;
+    if (value < stats.min) {
+      stats.min = value;
+    }
+    if (value > stats.max) {
+      stats.max = value;
+    }
+  }
+  stats.mean = sum / static_cast<float>(count - first);
+  stats.ripple = stats.max - stats.min;
+  return stats;
+}
+
+void ScopeCapture::start(uint32_t now_ms, uint32_t interval_ms) {
+  this->count_ = 0u;
+  this->start_ms_ = now_ms;
+  this->interval_ms_ = interval_ms > 0u ? interval_ms : DEFAULT_INTERVAL_MS;
+  this->next_slot_ = 0u;
+  this->missed_ = 0u;
+}
+
+bool ScopeCapture::due(uint32_t now_ms) const {
+  return !this->full() && (now_ms - this->start_ms_) >= this->next_slot_ * this->interval_ms_;
+}
+
+bool ScopeCapture::add(uint32_t now_ms, float speed_percent, float duty_percent, float vm_volts, bool fault) {
+  if (!this->due(now_ms)) {
+    return false;
+  }
+  const uint32_t slot = (now_ms - this->start_ms_) / this->interval_ms_;
+  this->missed_ = static_cast<uint16_t>(this->missed_ + (slot - this->next_slot_));
+  ScopeSample &sample = this->samples_[this->count_++];
+  sample.t_ms = slot * this->interval_ms_;
+  sample.speed_percent = speed_percent;
+  sample.duty_percent = duty_percent;
+  sample.vm_volts = vm_volts;
+  sample.fault = fault;
+  this->next_slot_ = slot + 1u;
+  return true;
+}
+
+ScopeStageResult ScopeCapture::reduce(const ScopeStageLimits &limits) const {
+  ScopeStageResult result{};
+  result.samples = static_cast<uint16_t>(this->count_);
+  result.missed = this->missed_;
+
+  size_t clean = this->count_;
+  for (size_t i = 0; i < this->count_; i++) {
+    if (this->samples_[i].fault) {
+      result.fault = true;
+      result.fault_ms = this->samples_[i].t_ms;
+      clean = i;
+      break;
+    }
+  }
+
+  const ScopeSample *samples = this->samples_.data();
+  result.speed = reduce_scope_channel(samples, clean, ScopeChannel::SPEED, limits.speed_band_percent);
+  result.duty = reduce_scope_channel(samples, clean, ScopeChannel::DUTY, limits.duty_band_percent);
+  result.vm = reduce_scope_channel(samples, clean, ScopeChannel::VM, limits.vm_band_volts);
+  result.pass = !result.fault && result.speed.settled && result.speed.settle_ms <= limits.max_settle_ms &&
+                result.speed.ripple <= limits.max_speed_ripple_percent;
+  return result;
+}
+
+}  // namespace mcf8316d_core
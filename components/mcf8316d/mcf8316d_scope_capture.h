@@ -0,0 +1,98 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace mcf8316d_core {
+
+// One capture point: the estimated speed from SPEED_FDBK next to the speed
+// loop's duty command from ALGO_STATUS, so a stage shows both what the motor
+// did and what the controller asked for.
+struct ScopeSample {
+  // Slot time since stage start: slot index * sample interval.
+  uint32_t t_ms{0u};
+  // SPEED_FDBK magnitude in percent of MAX_SPEED.
+  float speed_percent{0.0f};
+  float duty_percent{0.0f};
+  float vm_volts{0.0f};
+  bool fault{false};
+};
+
+enum class ScopeChannel : uint8_t {
+  SPEED = 0,
+  DUTY,
+  VM,
+};
+
+struct ScopeChannelStats {
+  // Mean and peak-to-peak over the settled samples, or over the last quarter
+  // of the capture when the channel never settled.
+  float mean{0.0f};
+  float ripple{0.0f};
+  float min{0.0f};
+  float max{0.0f};
+  bool settled{false};
+  // Slot time from which every later sample stays in the settle band.
+  uint32_t settle_ms{0u};
+};
+
+// Reduces one channel of `count` samples. The settle band is +/- `band`
+// around the mean of the last quarter of the capture; the channel is settled
+// when at least that whole quarter stays inside it.
+ScopeChannelStats reduce_scope_channel(const ScopeSample *samples, size_t count, ScopeChannel channel, float band);
+
+struct ScopeStageLimits {
+  float speed_band_percent{2.0f};
+  float duty_band_percent{2.0f};
+  float vm_band_volts{0.5f};
+  uint32_t max_settle_ms{4000u};
+  float max_speed_ripple_percent{5.0f};
+};
+
+struct ScopeStageResult {
+  uint16_t samples{0u};
+  // Slots that passed without a sample, e.g. while the loop was blocked.
+  uint16_t missed{0u};
+  bool fault{false};
+  uint32_t fault_ms{0u};
+  ScopeChannelStats speed{};
+  ScopeChannelStats duty{};
+  ScopeChannelStats vm{};
+  // No fault, and the speed settled within max_settle_ms with at most
+  // max_speed_ripple_percent peak-to-peak.
+  bool pass{false};
+};
+
+// Fixed-size per-stage capture. Samples land on a fixed slot grid from the
+// stage start, so two runs of the same stage are directly comparable; a
+// slot is taken at most once and late samples keep their own slot.
+class ScopeCapture {
+ public:
+  static constexpr size_t CAPACITY = 80u;
+  static constexpr uint32_t DEFAULT_INTERVAL_MS = 100u;
+
+  void start(uint32_t now_ms, uint32_t interval_ms = DEFAULT_INTERVAL_MS);
+  // True when the next slot is due and the buffer has room.
+  bool due(uint32_t now_ms) const;
+  // Stores a sample in the slot for `now_ms`; false when not due or full.
+  bool add(uint32_t now_ms, float speed_percent, float duty_percent, float vm_volts, bool fault);
+
+  size_t size() const { return this->count_; }
+  bool full() const { return this->count_ >= CAPACITY; }
+  uint32_t interval_ms() const { return this->interval_ms_; }
+  const ScopeSample &sample(size_t index) const { return this->samples_[index]; }
+
+  // Samples from the first fault on are excluded from the channel stats.
+  ScopeStageResult reduce(const ScopeStageLimits &limits) const;
+
+ protected:
+  std::array<ScopeSample, CAPACITY> samples_{};
+  size_t count_{0u};
+  uint32_t start_ms_{0u};
+  uint32_t interval_ms_{DEFAULT_INTERVAL_MS};
+  uint32_t next_slot_{0u};
+  uint16_t missed_{0u};
+};
+
+}  // namespace mcf8316d_core
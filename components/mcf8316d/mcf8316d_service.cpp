@@ -6,6 +6,31 @@ namespace mcf8316d_core {
 
 using namespace regs;
 
+namespace {
+
+constexpr uint32_t TUNING_DEVICE_ID = 0x8316D000U;
+
+// Settings that shape startup and closed-loop behaviour. Brake, direction and
+// speed registers are left out: they change at runtime.
+constexpr mcf83xx_common::FingerprintRegister TUNING_FINGERPRINT_REGISTERS[] = {
+    {register_address(RegisterId::ISD_CONFIG), ~TUNED_ISD_CONFIG_MASK},
+    {register_address(RegisterId::REV_DRIVE_CONFIG), 0xFFFFFFFFU},
+    {register_address(RegisterId::MOTOR_STARTUP1), ~TUNED_MOTOR_STARTUP1_MASK},
+    {register_address(RegisterId::MOTOR_STARTUP2), ~TUNED_MOTOR_STARTUP2_MASK},
+    {register_address(RegisterId::CLOSED_LOOP1), ~TUNED_CLOSED_LOOP1_MASK},
+    {register_address(RegisterId::CLOSED_LOOP2), 0xFFFFFFFFU},
+    {register_address(RegisterId::CLOSED_LOOP3), 0xFFFFFFFFU},
+    {register_address(RegisterId::CLOSED_LOOP4), ~TUNED_CLOSED_LOOP4_MASK},
+    {register_address(RegisterId::FAULT_CONFIG1), ~TUNED_FAULT_CONFIG1_MASK},
+    {register_address(RegisterId::FAULT_CONFIG2), ~TUNED_FAULT_CONFIG2_MASK},
+    {register_address(RegisterId::DEVICE_CONFIG1), 0xFFFFFFFFU},
+    {register_address(RegisterId::DEVICE_CONFIG2), ~TUNED_DEVICE_CONFIG2_MASK},
+    {register_address(RegisterId::GD_CONFIG1), ~TUNED_GD_CONFIG1_MASK},
+    {register_address(RegisterId::GD_CONFIG2), 0xFFFFFFFFU},
+};
+
+}  // namespace
+
 bool MCF8316DService::read_reg32(RegisterId id, uint32_t &value) const {
   return this->registers_.read32(register_address(id), value);
 }
@@ -66,12 +91,9 @@ bool MCF8316DService::write_speed_command_percent(float speed_percent) const {
   if (std::isnan(speed_percent)) {
     return false;
   }
-  const float clamped = speed_percent < 0.0f ? 0.0f : (speed_percent > 100.0f ? 100.0f : speed_percent);
-  const uint16_t digital_speed_ctrl = static_cast<uint16_t>(lroundf((clamped / 100.0f) * 32767.0f));
-  uint32_t value = ALGO_DEBUG1_OVERRIDE_MASK;
-  value |= (static_cast<uint32_t>(digital_speed_ctrl) << 16) & ALGO_DEBUG1_DIGITAL_SPEED_CTRL_MASK;
+  const uint16_t digital_speed_ctrl = mcf83xx_common::speed_percent_to_code(speed_percent);
   return this->update_bits32(
-    RegisterId::ALGO_DEBUG1, ALGO_DEBUG1_OVERRIDE_MASK | ALGO_DEBUG1_DIGITAL_SPEED_CTRL_MASK, value
+    RegisterId::ALGO_DEBUG1, mcf83xx_common::SPEED_COMMAND_MASK, mcf83xx_common::speed_command_value(digital_speed_ctrl)
   );
 }
 
@@ -79,8 +101,72 @@ bool MCF8316DService::pulse_clear_faults() const {
   return this->registers_.pulse_bits32(register_address(RegisterId::ALGO_CTRL1), ALGO_CTRL1_CLR_FLT_MASK, 2000U, 2000U);
 }
 
-bool MCF8316DService::pulse_watchdog_tickle() const {
-  return this->registers_.pulse_bits32(register_address(RegisterId::ALGO_CTRL1), ALGO_CTRL1_WATCHDOG_TICKLE_MASK);
+bool MCF8316DService::read_watchdog_tickle_base(uint32_t &algo_ctrl1) const {
+  if (!this->read_reg32(RegisterId::ALGO_CTRL1, algo_ctrl1)) {
+    return false;
+  }
+  algo_ctrl1 &= ~ALGO_CTRL1_COMMAND_MASK;
+  return true;
+}
+
+bool MCF8316DService::tickle_watchdog(uint32_t algo_ctrl1_base) const {
+  // The device clears WATCHDOG_TICKLE itself, so no second write is needed.
+  return this->write_reg32(
+    RegisterId::ALGO_CTRL1, (algo_ctrl1_base & ~ALGO_CTRL1_COMMAND_MASK) | ALGO_CTRL1_WATCHDOG_TICKLE_MASK
+  );
+}
+
+bool MCF8316DService::read_configuration_fingerprint(uint32_t config_hash, uint32_t &fingerprint) const {
+  return mcf83xx_common::read_configuration_fingerprint(
+      this->registers_, TUNING_DEVICE_ID, config_hash, TUNING_FINGERPRINT_REGISTERS,
+      sizeof(TUNING_FINGERPRINT_REGISTERS) / sizeof(TUNING_FINGERPRINT_REGISTERS[0]), fingerprint);
+}
+
+bool MCF8316DService::record_tuned_field(mcf83xx_common::TuningRecord &record, RegisterId id, uint32_t mask) const {
+  uint32_t value = 0;
+  return this->read_reg32(id, value) && mcf83xx_common::add_tuned_field(record, register_address(id), mask, value);
+}
+
+bool MCF8316DService::apply_tuning_record(const mcf83xx_common::TuningRecord &record) const {
+  return mcf83xx_common::apply_tuning_record(this->registers_, record);
+}
+
+float read_max_speed_hz(const MCF8316DService &service, float fallback_max_speed_hz) {
+  uint32_t closed_loop4 = 0;
+  if (service.read_reg32(RegisterId::CLOSED_LOOP4, closed_loop4)) {
+    return decode_max_speed_hz(
+      static_cast<uint16_t>((closed_loop4 & CLOSED_LOOP4_MAX_SPEED_MASK) >> CLOSED_LOOP4_MAX_SPEED_SHIFT));
+  }
+  return fallback_max_speed_hz;
+}
+
+bool read_speed_pair_hz(const MCF8316DService &service, float max_speed_hz, float &fdbk_hz, float &fg_hz) {
+  if (max_speed_hz <= 0.0f) {
+    return false;
+  }
+  uint32_t raw_fdbk = 0;
+  uint32_t raw_fg = 0;
+  if (!service.read_reg32(RegisterId::SPEED_FDBK, raw_fdbk) || !service.read_reg32(RegisterId::FG_SPEED_FDBK, raw_fg)) {
+    return false;
+  }
+  fdbk_hz = decode_speed_hz(static_cast<int32_t>(raw_fdbk), max_speed_hz);
+  fg_hz = decode_fg_speed_hz(raw_fg, max_speed_hz);
+  return true;
+}
+
+bool read_phase_current_peak_amps(const MCF8316DService &service, float &amps) {
+  static constexpr RegisterId PHASES[] = {
+      RegisterId::PHASE_CURRENT_A, RegisterId::PHASE_CURRENT_B, RegisterId::PHASE_CURRENT_C};
+  float peak = 0.0f;
+  for (const RegisterId phase : PHASES) {
+    uint32_t raw = 0;
+    if (!service.read_reg32(phase, raw)) {
+      return false;
+    }
+    peak = std::fmax(peak, std::fabs(decode_current_amps(static_cast<int32_t>(raw))));
+  }
+  amps = peak;
+  return true;
 }
 
 }  // namespace mcf8316d_core
@@ -4,11 +4,41 @@
 #include <string>
 
 #include "../mcf83xx_common/register_access.h"
+#include "../mcf83xx_common/speed_command.h"
+#include "../mcf83xx_common/tuning_record.h"
 #include "mcf8316d_bus.h"
 #include "mcf8316d_protocol.h"
 
 namespace mcf8316d_core {
 
+// The speed command uses the family ALGO_DEBUG1 encoding.
+static_assert(regs::ALGO_DEBUG1_OVERRIDE_MASK == mcf83xx_common::SPEED_OVERRIDE_MASK);
+static_assert(regs::ALGO_DEBUG1_DIGITAL_SPEED_CTRL_MASK == mcf83xx_common::DIGITAL_SPEED_CTRL_MASK);
+
+// Register fields the startup tune profile and current sweep write. A
+// persisted tuning result owns them, so the configuration fingerprint leaves
+// them out.
+inline constexpr uint32_t TUNED_FAULT_CONFIG1_MASK =
+  regs::FAULT_CONFIG1_HW_LOCK_ILIMIT_MASK | regs::FAULT_CONFIG1_LOCK_ILIMIT_MODE_MASK |
+  regs::FAULT_CONFIG1_LOCK_ILIMIT_DEG_MASK | regs::FAULT_CONFIG1_LCK_RETRY_MASK | regs::FAULT_CONFIG1_MTR_LCK_MODE_MASK;
+inline constexpr uint32_t TUNED_FAULT_CONFIG2_MASK = regs::FAULT_CONFIG2_HW_LOCK_ILIMIT_DEG_MASK |
+                                                     regs::FAULT_CONFIG2_HW_LOCK_ILIMIT_MODE_MASK |
+                                                     regs::FAULT_CONFIG2_LOCK2_EN_MASK;
+inline constexpr uint32_t TUNED_MOTOR_STARTUP1_MASK = regs::MOTOR_STARTUP1_MTR_STARTUP_MASK |
+                                                      regs::MOTOR_STARTUP1_ALIGN_TIME_MASK |
+                                                      regs::MOTOR_STARTUP1_ALIGN_OR_SLOW_CURRENT_ILIMIT_MASK;
+inline constexpr uint32_t TUNED_MOTOR_STARTUP2_MASK =
+  regs::MOTOR_STARTUP2_OL_ILIMIT_MASK | regs::MOTOR_STARTUP2_AUTO_HANDOFF_EN_MASK |
+  regs::MOTOR_STARTUP2_OPN_CL_HANDOFF_THR_MASK | regs::MOTOR_STARTUP2_ALIGN_ANGLE_MASK |
+  regs::MOTOR_STARTUP2_SLOW_FIRST_CYC_FREQ_MASK | regs::MOTOR_STARTUP2_FIRST_CYCLE_FREQ_SEL_MASK;
+inline constexpr uint32_t TUNED_CLOSED_LOOP1_MASK = regs::CLOSED_LOOP1_PWM_FREQ_OUT_MASK;
+inline constexpr uint32_t TUNED_DEVICE_CONFIG2_MASK = regs::DEVICE_CONFIG2_DYNAMIC_CSA_GAIN_EN_MASK;
+inline constexpr uint32_t TUNED_GD_CONFIG1_MASK = regs::GD_CONFIG1_CSA_GAIN_MASK;
+inline constexpr uint32_t TUNED_ISD_CONFIG_MASK = regs::ISD_CONFIG_ISD_EN_MASK | regs::ISD_CONFIG_BRAKE_EN_MASK |
+                                                  regs::ISD_CONFIG_RESYNC_EN_MASK | regs::ISD_CONFIG_BRK_CONFIG_MASK |
+                                                  regs::ISD_CONFIG_BRK_TIME_MASK;
+inline constexpr uint32_t TUNED_CLOSED_LOOP4_MASK = regs::CLOSED_LOOP4_MAX_SPEED_MASK;
+
 class MCF8316DService {
  public:
   explicit MCF8316DService(RegisterBus *bus) : registers_(bus) {}
@@ -24,10 +54,31 @@ class MCF8316DService {
   bool read_direction_input(uint8_t &direction_input_code) const;
   bool write_speed_command_percent(float speed_percent) const;
   bool pulse_clear_faults() const;
-  bool pulse_watchdog_tickle() const;
+  // ALGO_CTRL1 without its one-shot command fields: the image a tickle
+  // rewrites so FORCED_ALIGN_ANGLE and STL_KEY keep their values.
+  bool read_watchdog_tickle_base(uint32_t &algo_ctrl1) const;
+  // Tickles the external watchdog with a single ALGO_CTRL1 write.
+  bool tickle_watchdog(uint32_t algo_ctrl1_base) const;
+
+  // Fingerprint persisted tuning results are keyed by: the startup and
+  // closed-loop configuration registers minus the tuned fields, seeded with
+  // `config_hash`. Read after the configured settings are applied.
+  bool read_configuration_fingerprint(uint32_t config_hash, uint32_t &fingerprint) const;
+  // Adds the current `mask` bits of `id` to `record`.
+  bool record_tuned_field(mcf83xx_common::TuningRecord &record, RegisterId id, uint32_t mask) const;
+  bool apply_tuning_record(const mcf83xx_common::TuningRecord &record) const;
 
  private:
   mcf83xx_common::RegisterAccess registers_;
 };
 
+// MAX_SPEED from CLOSED_LOOP4, or `fallback_max_speed_hz` when it cannot be read.
+float read_max_speed_hz(const MCF8316DService &service, float fallback_max_speed_hz);
+// Estimator speed feedback and FG speed in Hz.
+bool read_speed_pair_hz(const MCF8316DService &service, float max_speed_hz, float &fdbk_hz, float &fg_hz);
+// Largest phase-current magnitude across A/B/C. In a balanced three-phase
+// set it is always between 0.87 and 1.0 of the peak, so single samples track
+// the current amplitude without phase alignment.
+bool read_phase_current_peak_amps(const MCF8316DService &service, float &amps);
+
 }  // namespace mcf8316d_core
@@ -0,0 +1,242 @@
+#include "mcf8316d_startup_search.h"
+
+#include <cmath>
+
+namespace mcf8316d_core {
+
+namespace {
+
+constexpr uint16_t ALGORITHM_STATE_CLOSED_LOOP_UNALIGNED = 0x0008u;
+constexpr uint16_t ALGORITHM_STATE_CLOSED_LOOP_ALIGNED = 0x0009u;
+
+constexpr float CURRENT_THRESHOLD_A[STARTUP_CURRENT_CODE_COUNT] = {
+  0.125f, 0.25f, 0.5f, 1.0f, 1.5f, 2.0f, 2.5f, 3.0f, 3.5f, 4.0f, 4.5f, 5.0f, 5.5f, 6.0f, 7.0f, 8.0f,
+};
+
+bool closed_loop_state(uint16_t state) {
+  return state == ALGORITHM_STATE_CLOSED_LOOP_UNALIGNED || state == ALGORITHM_STATE_CLOSED_LOOP_ALIGNED;
+}
+
+}  // namespace
+
+float startup_current_code_to_amps(uint8_t code) { return CURRENT_THRESHOLD_A[code & 0xFu]; }
+
+const char *startup_step_outcome_to_string(StartupStepOutcome outcome) {
+  switch (outcome) {
+    case StartupStepOutcome::PASS:
+      return "PASS";
+    case StartupStepOutcome::LOCK:
+      return "LOCK";
+    case StartupStepOutcome::STALL:
+      return "STALL";
+    case StartupStepOutcome::FAULT:
+      return "FAULT";
+    default:
+      return "UNKNOWN";
+  }
+}
+
+int32_t score_startup_step(const StartupStepResult &result) {
+  if (result.outcome != StartupStepOutcome::PASS) {
+    return std::numeric_limits<int32_t>::min();
+  }
+  const float penalty = static_cast<float>(result.reach_ms) + result.current_overshoot_amps * 200.0f +
+                        result.speed_ripple_percent * 50.0f + startup_current_code_to_amps(result.code) * 100.0f;
+  return -static_cast<int32_t>(std::lround(penalty));
+}
+
+void StartupStepMonitor::start(uint8_t code, uint32_t now_ms) {
+  this->result_ = StartupStepResult{};
+  this->result_.code = code;
+  this->done_ = false;
+  this->start_ms_ = now_ms;
+  this->reached_ = false;
+  this->reached_at_ms_ = 0u;
+  this->current_peak_ = 0.0f;
+  this->settled_current_sum_ = 0.0f;
+  this->settled_speed_min_ = 0.0f;
+  this->settled_speed_max_ = 0.0f;
+  this->settled_speed_sum_ = 0.0f;
+  this->settled_count_ = 0u;
+}
+
+bool StartupStepMonitor::sample(uint32_t now_ms, bool algorithm_state_valid, uint16_t algorithm_state,
+                                bool fault_active, bool controller_valid, uint32_t controller_fault_status,
+                                bool feedback_valid, float speed_hz, float phase_current_amps) {
+  if (this->done_) {
+    return true;
+  }
+  if (fault_active) {
+    this->result_.controller_fault_status = controller_valid ? controller_fault_status : 0u;
+    const bool lock = controller_valid && (controller_fault_status & STARTUP_LOCK_FAULT_MASK) != 0u;
+    this->finish_(lock ? StartupStepOutcome::LOCK : StartupStepOutcome::FAULT);
+    return true;
+  }
+
+  if (!this->reached_) {
+    if (algorithm_state_valid && closed_loop_state(algorithm_state)) {
+      this->reached_ = true;
+      this->reached_at_ms_ = now_ms;
+      this->result_.reach_ms = now_ms - this->start_ms_;
+      this->current_peak_ = feedback_valid ? phase_current_amps : 0.0f;
+    } else if (now_ms - this->start_ms_ >= REACH_TIMEOUT_MS) {
+      this->finish_(StartupStepOutcome::STALL);
+      return true;
+    }
+    return false;
+  }
+
+  if (algorithm_state_valid && !closed_loop_state(algorithm_state)) {
+    this->finish_(StartupStepOutcome::STALL);
+    return true;
+  }
+  const uint32_t window_ms = now_ms - this->reached_at_ms_;
+  if (feedback_valid) {
+    if (phase_current_amps > this->current_peak_) {
+      this->current_peak_ = phase_current_amps;
+    }
+    if (window_ms >= SCORE_WINDOW_MS / 2u) {
+      // Direction does not matter for stability.
+      const float speed = std::fabs(speed_hz);
+      if (this->settled_count_ == 0u || speed < this->settled_speed_min_) {
+        this->settled_speed_min_ = speed;
+      }
+      if (this->settled_count_ == 0u || speed > this->settled_speed_max_) {
+        this->settled_speed_max_ = speed;
+      }
+      this->settled_speed_sum_ += speed;
+      this->settled_current_sum_ += phase_current_amps;
+      this->settled_count_++;
+    }
+  }
+  if (window_ms < SCORE_WINDOW_MS) {
+    return false;
+  }
+
+  if (this->settled_count_ > 0u) {
+    const float count = static_cast<float>(this->settled_count_);
+    const float settled_current = this->settled_current_sum_ / count;
+    const float settled_speed = this->settled_speed_sum_ / count;
+    this->result_.current_overshoot_amps =
+      this->current_peak_ > settled_current ? this->current_peak_ - settled_current : 0.0f;
+    this->result_.settled_speed_hz = settled_speed;
+    if (settled_speed > 0.0f) {
+      this->result_.speed_ripple_percent =
+        (this->settled_speed_max_ - this->settled_speed_min_) * 100.0f / settled_speed;
+    }
+  }
+  this->finish_(StartupStepOutcome::PASS);
+  return true;
+}
+
+void StartupStepMonitor::finish_(StartupStepOutcome outcome) {
+  this->result_.outcome = outcome;
+  this->result_.score = score_startup_step(this->result_);
+  this->done_ = true;
+}
+
+void StartupCurrentSearch::start(const StartupSearchConfig &config) {
+  this->config_ = config;
+  if (this->config_.max_code >= STARTUP_CURRENT_CODE_COUNT) {
+    this->config_.max_code = STARTUP_CURRENT_CODE_COUNT - 1u;
+  }
+  if (this->config_.min_code > this->config_.max_code) {
+    this->config_.min_code = this->config_.max_code;
+  }
+  this->results_.fill(StartupStepResult{});
+  this->evaluated_.fill(false);
+  this->evaluations_ = 0u;
+  this->aborted_ = false;
+}
+
+void StartupCurrentSearch::record(const StartupStepResult &result) {
+  const uint8_t code = result.code & 0xFu;
+  if (!this->evaluated_[code]) {
+    this->evaluations_++;
+  }
+  this->results_[code] = result;
+  this->evaluated_[code] = true;
+  if (result.outcome == StartupStepOutcome::FAULT) {
+    this->aborted_ = true;
+  }
+}
+
+bool StartupCurrentSearch::next_code(uint8_t &code) const {
+  if (this->aborted_) {
+    return false;
+  }
+
+  // Lowest passing code: lower bound over [min_code, max_code].
+  uint8_t lo = this->config_.min_code;
+  uint8_t hi = static_cast<uint8_t>(this->config_.max_code + 1u);
+  while (lo < hi) {
+    const uint8_t mid = static_cast<uint8_t>(lo + (hi - lo) / 2u);
+    if (!this->evaluated_[mid]) {
+      code = mid;
+      return true;
+    }
+    if (this->passed_(mid)) {
+      hi = mid;
+    } else {
+      lo = static_cast<uint8_t>(mid + 1u);
+    }
+  }
+  if (lo > this->config_.max_code || !this->config_.refine) {
+    return false;
+  }
+
+  // Golden-section over [lowest pass, max_code]; ties keep the lower current.
+  uint8_t a = lo;
+  uint8_t c = this->config_.max_code;
+  while (static_cast<uint8_t>(c - a) > 2u) {
+    const uint8_t span = static_cast<uint8_t>(c - a);
+    const uint8_t x1 = static_cast<uint8_t>(a + (span * 382u + 500u) / 1000u);
+    uint8_t x2 = static_cast<uint8_t>(a + c - x1);
+    if (x2 <= x1) {
+      x2 = static_cast<uint8_t>(x1 + 1u);
+    }
+    if (!this->evaluated_[x1]) {
+      code = x1;
+      return true;
+    }
+    if (!this->evaluated_[x2]) {
+      code = x2;
+      return true;
+    }
+    if (this->score_(x1) >= this->score_(x2)) {
+      c = x2;
+    } else {
+      a = x1;
+    }
+  }
+  for (uint8_t candidate = a; candidate <= c; candidate++) {
+    if (!this->evaluated_[candidate]) {
+      code = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool StartupCurrentSearch::best(uint8_t &code) const {
+  bool found = false;
+  for (uint8_t candidate = 0u; candidate < STARTUP_CURRENT_CODE_COUNT; candidate++) {
+    if (this->passed_(candidate) && (!found || this->score_(candidate) > this->score_(code))) {
+      code = candidate;
+      found = true;
+    }
+  }
+  return found;
+}
+
+bool StartupCurrentSearch::lowest_pass(uint8_t &code) const {
+  for (uint8_t candidate = 0u; candidate < STARTUP_CURRENT_CODE_COUNT; candidate++) {
+    if (this->passed_(candidate)) {
+      code = candidate;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace mcf8316d_core
@@ -0,0 +1,129 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "mcf8316d_protocol.h"
+
+namespace mcf8316d_core {
+
+// ALIGN_OR_SLOW_CURRENT_ILIMIT / OL_ILIMIT are 4-bit current-threshold codes.
+inline constexpr size_t STARTUP_CURRENT_CODE_COUNT = 16u;
+
+float startup_current_code_to_amps(uint8_t code);
+
+// Lock and stall faults end a startup step as soon as they latch.
+inline constexpr uint32_t STARTUP_LOCK_FAULT_MASK = regs::FAULT_LOCK_LIMIT | regs::FAULT_HW_LOCK_LIMIT |
+                                                    regs::FAULT_MTR_LCK | regs::FAULT_ABN_SPEED |
+                                                    regs::FAULT_ABN_BEMF | regs::FAULT_NO_MTR;
+
+enum class StartupStepOutcome : uint8_t {
+  PASS = 0,
+  // Lock or stall fault.
+  LOCK,
+  // No closed loop within the reach timeout, or closed loop lost while scored.
+  STALL,
+  // Any other fault; ends the whole search.
+  FAULT,
+};
+
+const char *startup_step_outcome_to_string(StartupStepOutcome outcome);
+
+struct StartupStepResult {
+  uint8_t code{0u};
+  StartupStepOutcome outcome{StartupStepOutcome::STALL};
+  // Time from the speed command to closed loop.
+  uint32_t reach_ms{0u};
+  // Phase-current peak after handoff above its settled mean.
+  float current_overshoot_amps{0.0f};
+  // Settled SPEED_FDBK peak-to-peak as a percentage of its settled mean.
+  float speed_ripple_percent{0.0f};
+  float settled_speed_hz{0.0f};
+  uint32_t controller_fault_status{0u};
+  int32_t score{std::numeric_limits<int32_t>::min()};
+};
+
+// Higher is better. Every term is in milliseconds of handoff delay: 1 A of
+// current overshoot costs 200, 1% speed ripple 50 and each amp of current
+// limit 100, so a gentler current wins between otherwise similar starts.
+int32_t score_startup_step(const StartupStepResult &result);
+
+// Classifies one sweep step from periodic update() samples.
+class StartupStepMonitor {
+ public:
+  static constexpr uint32_t REACH_TIMEOUT_MS = 4000u;
+  // Scoring time after closed-loop entry; its second half counts as settled.
+  static constexpr uint32_t SCORE_WINDOW_MS = 1500u;
+
+  void start(uint8_t code, uint32_t now_ms);
+  // Feeds one sample; true once the step has an outcome. `speed_hz` is
+  // SPEED_FDBK and `phase_current_amps` the largest phase-current magnitude;
+  // both are ignored unless `feedback_valid`.
+  bool sample(uint32_t now_ms, bool algorithm_state_valid, uint16_t algorithm_state, bool fault_active,
+              bool controller_valid, uint32_t controller_fault_status, bool feedback_valid, float speed_hz,
+              float phase_current_amps);
+  bool done() const { return this->done_; }
+  const StartupStepResult &result() const { return this->result_; }
+
+ protected:
+  void finish_(StartupStepOutcome outcome);
+
+  StartupStepResult result_{};
+  bool done_{true};
+  uint32_t start_ms_{0u};
+  bool reached_{false};
+  uint32_t reached_at_ms_{0u};
+  float current_peak_{0.0f};
+  float settled_current_sum_{0.0f};
+  float settled_speed_min_{0.0f};
+  float settled_speed_max_{0.0f};
+  float settled_speed_sum_{0.0f};
+  uint16_t settled_count_{0u};
+};
+
+struct StartupSearchConfig {
+  uint8_t min_code{3u};   // 1.0A
+  uint8_t max_code{10u};  // 4.5A
+  // Golden-section refinement of the score above the lowest passing code.
+  bool refine{true};
+};
+
+// Startup current-limit search. Bisection finds the lowest passing code,
+// assuming more current never stops a motor that started; golden-section
+// steps then look for the best score between it and max_code, assuming the
+// score is unimodal there. The next code is recomputed from the recorded
+// results, so the search holds no state beyond them.
+class StartupCurrentSearch {
+ public:
+  void start(const StartupSearchConfig &config);
+  // Next code to run; false once the search is over.
+  bool next_code(uint8_t &code) const;
+  void record(const StartupStepResult &result);
+
+  const StartupSearchConfig &config() const { return this->config_; }
+  bool evaluated(uint8_t code) const { return code < STARTUP_CURRENT_CODE_COUNT && this->evaluated_[code]; }
+  const StartupStepResult &result(uint8_t code) const { return this->results_[code & 0xFu]; }
+  uint8_t evaluations() const { return this->evaluations_; }
+  // True when a FAULT step ended the search.
+  bool aborted() const { return this->aborted_; }
+  // Best-scoring passing code so far; ties go to the lower current.
+  bool best(uint8_t &code) const;
+  // Lowest passing code so far.
+  bool lowest_pass(uint8_t &code) const;
+
+ protected:
+  bool passed_(uint8_t code) const {
+    return this->evaluated_[code] && this->results_[code].outcome == StartupStepOutcome::PASS;
+  }
+  int32_t score_(uint8_t code) const { return this->results_[code].score; }
+
+  StartupSearchConfig config_{};
+  std::array<StartupStepResult, STARTUP_CURRENT_CODE_COUNT> results_{};
+  std::array<bool, STARTUP_CURRENT_CODE_COUNT> evaluated_{};
+  uint8_t evaluations_{0u};
+  bool aborted_{false};
+};
+
+}  // namespace mcf8316d_core
@@ -1,5 +1,9 @@
 #include "mcf8316d_tuning.h"
 
+#include <cmath>
+#include <cstdio>
+#include <string>
+
 #include "mcf8316d.h"
 
 #include "esphome/core/hal.h"
@@ -45,20 +49,15 @@ constexpr uint32_t LOCK_DISABLED_MODE = 7u;
 constexpr uint32_t DEBUG_ALIGN_MTR_STARTUP = 0u;  // Align startup
 constexpr uint32_t DEBUG_ALIGN_TIME = 2u;         // 100 ms align
 
-constexpr uint8_t STARTUP_SWEEP_STEP_COUNT = 4u;
+constexpr uint8_t STARTUP_SWEEP_MIN_CODE = 3u;   // 1.0A
+constexpr uint8_t STARTUP_SWEEP_MAX_CODE = 10u;  // 4.5A
 constexpr float STARTUP_SWEEP_SPEED_PERCENT = 21.0f;
-constexpr uint32_t STARTUP_SWEEP_STEP_TIMEOUT_MS = 2000u;
 constexpr uint32_t STARTUP_SWEEP_INTER_STEP_DELAY_MS = 1200u;
 constexpr uint32_t STARTUP_SWEEP_CLEAR_RETRY_MS = 250u;
 
-constexpr uint8_t SCOPE_PROBE_STAGE_COUNT = 3u;
 constexpr uint32_t SCOPE_PROBE_INTER_STAGE_DELAY_MS = 1500u;
 constexpr uint32_t SCOPE_PROBE_CLEAR_RETRY_MS = 250u;
 
-constexpr uint16_t ALGORITHM_STATE_OPEN_LOOP = 0x0007u;
-constexpr uint16_t ALGORITHM_STATE_CLOSED_LOOP_UNALIGNED = 0x0008u;
-constexpr uint16_t ALGORITHM_STATE_CLOSED_LOOP_ALIGNED = 0x0009u;
-
 }  // namespace
 
 bool MCF8316DTuningController::apply_startup_tune_profile() {
@@ -85,24 +84,29 @@ bool MCF8316DTuningController::apply_startup_tune_profile() {
   }
 
   auto apply_masked_bits =
-    [this](const char *label, uint16_t reg, uint32_t mask, uint32_t value) {
+    [this](const char *label, RegisterId reg, uint32_t mask, uint32_t value) {
       uint32_t before = 0;
       if (!this->parent_->read_reg32(reg, before)) {
-        ESP_LOGW(TUNING_TAG, "%s read failed (reg=0x%04X)", label, reg);
+        ESP_LOGW(TUNING_TAG, "%s read failed (reg=0x%04X)", label, register_address(reg));
         return false;
       }
 
       const uint32_t next = (before & ~mask) | (value & mask);
       if (next != before && !this->parent_->write_reg32(reg, next)) {
         ESP_LOGW(
-          TUNING_TAG, "%s write failed (reg=0x%04X): 0x%08X -> 0x%08X", label, reg, before, next
+          TUNING_TAG,
+          "%s write failed (reg=0x%04X): 0x%08X -> 0x%08X",
+          label,
+          register_address(reg),
+          before,
+          next
         );
         return false;
       }
 
       uint32_t after = 0;
       if (!this->parent_->read_reg32(reg, after)) {
-        ESP_LOGW(TUNING_TAG, "%s verify read failed (reg=0x%04X)", label, reg);
+        ESP_LOGW(TUNING_TAG, "%s verify read failed (reg=0x%04X)", label, register_address(reg));
         return false;
       }
       ESP_LOGI(TUNING_TAG, "%s: 0x%08X -> 0x%08X", label, before, after);
@@ -113,7 +117,7 @@ bool MCF8316DTuningController::apply_startup_tune_profile() {
           TUNING_TAG,
           "%s verify mismatch (reg=0x%04X): expected mask=0x%08X actual mask=0x%08X",
           label,
-          reg,
+          register_address(reg),
           (value & mask),
           (after & mask)
         );
@@ -123,10 +127,8 @@ bool MCF8316DTuningController::apply_startup_tune_profile() {
 
   ok &= apply_masked_bits(
     "FAULT_CONFIG1 tuning",
-    register_address(RegisterId::FAULT_CONFIG1),
-    FAULT_CONFIG1_HW_LOCK_ILIMIT_MASK | FAULT_CONFIG1_LOCK_ILIMIT_MODE_MASK |
-      FAULT_CONFIG1_LOCK_ILIMIT_DEG_MASK | FAULT_CONFIG1_LCK_RETRY_MASK |
-      FAULT_CONFIG1_MTR_LCK_MODE_MASK,
+    RegisterId::FAULT_CONFIG1,
+    ::mcf8316d_core::TUNED_FAULT_CONFIG1_MASK,
     (STARTUP_TUNE_HW_LOCK_ILIMIT << FAULT_CONFIG1_HW_LOCK_ILIMIT_SHIFT) |
       (STARTUP_TUNE_LOCK_ILIMIT_MODE << FAULT_CONFIG1_LOCK_ILIMIT_MODE_SHIFT) |
       (STARTUP_TUNE_LOCK_ILIMIT_DEG << FAULT_CONFIG1_LOCK_ILIMIT_DEG_SHIFT) |
@@ -135,18 +137,16 @@ bool MCF8316DTuningController::apply_startup_tune_profile() {
   );
   ok &= apply_masked_bits(
     "FAULT_CONFIG2 tuning",
-    register_address(RegisterId::FAULT_CONFIG2),
-    FAULT_CONFIG2_HW_LOCK_ILIMIT_DEG_MASK | FAULT_CONFIG2_HW_LOCK_ILIMIT_MODE_MASK |
-      FAULT_CONFIG2_LOCK2_EN_MASK,
+    RegisterId::FAULT_CONFIG2,
+    ::mcf8316d_core::TUNED_FAULT_CONFIG2_MASK,
     (STARTUP_TUNE_HW_LOCK_ILIMIT_DEG << FAULT_CONFIG2_HW_LOCK_ILIMIT_DEG_SHIFT) |
       (STARTUP_TUNE_HW_LOCK_ILIMIT_MODE << FAULT_CONFIG2_HW_LOCK_ILIMIT_MODE_SHIFT) |
       (STARTUP_TUNE_LOCK2_EN ? FAULT_CONFIG2_LOCK2_EN_MASK : 0u)
   );
   ok &= apply_masked_bits(
     "MOTOR_STARTUP1 tuning",
-    register_address(RegisterId::MOTOR_STARTUP1),
-    MOTOR_STARTUP1_MTR_STARTUP_MASK | MOTOR_STARTUP1_ALIGN_TIME_MASK |
-      MOTOR_STARTUP1_ALIGN_OR_SLOW_CURRENT_ILIMIT_MASK,
+    RegisterId::MOTOR_STARTUP1,
+    ::mcf8316d_core::TUNED_MOTOR_STARTUP1_MASK,
     (STARTUP_TUNE_MTR_STARTUP << MOTOR_STARTUP1_MTR_STARTUP_SHIFT) |
       (STARTUP_TUNE_ALIGN_TIME << MOTOR_STARTUP1_ALIGN_TIME_SHIFT) |
       (STARTUP_TUNE_ALIGN_OR_SLOW_CURRENT_ILIMIT
@@ -154,10 +154,8 @@ bool MCF8316DTuningController::apply_startup_tune_profile() {
   );
   ok &= apply_masked_bits(
     "MOTOR_STARTUP2 tuning",
-    register_address(RegisterId::MOTOR_STARTUP2),
-    MOTOR_STARTUP2_OL_ILIMIT_MASK | MOTOR_STARTUP2_AUTO_HANDOFF_EN_MASK |
-      MOTOR_STARTUP2_OPN_CL_HANDOFF_THR_MASK | MOTOR_STARTUP2_ALIGN_ANGLE_MASK |
-      MOTOR_STARTUP2_SLOW_FIRST_CYC_FREQ_MASK | MOTOR_STARTUP2_FIRST_CYCLE_FREQ_SEL_MASK,
+    RegisterId::MOTOR_STARTUP2,
+    ::mcf8316d_core::TUNED_MOTOR_STARTUP2_MASK,
     (STARTUP_TUNE_OL_ILIMIT << MOTOR_STARTUP2_OL_ILIMIT_SHIFT) |
       (STARTUP_TUNE_AUTO_HANDOFF_EN << MOTOR_STARTUP2_AUTO_HANDOFF_EN_SHIFT) |
       (STARTUP_TUNE_OPN_CL_HANDOFF_THR << MOTOR_STARTUP2_OPN_CL_HANDOFF_THR_SHIFT) |
@@ -167,27 +165,26 @@ bool MCF8316DTuningController::apply_startup_tune_profile() {
   );
   ok &= apply_masked_bits(
     "CLOSED_LOOP1 tuning",
-    register_address(RegisterId::CLOSED_LOOP1),
-    CLOSED_LOOP1_PWM_FREQ_OUT_MASK,
+    RegisterId::CLOSED_LOOP1,
+    ::mcf8316d_core::TUNED_CLOSED_LOOP1_MASK,
     (STARTUP_TUNE_PWM_FREQ_OUT << CLOSED_LOOP1_PWM_FREQ_OUT_SHIFT)
   );
   ok &= apply_masked_bits(
     "DEVICE_CONFIG2 tuning",
-    register_address(RegisterId::DEVICE_CONFIG2),
-    DEVICE_CONFIG2_DYNAMIC_CSA_GAIN_EN_MASK,
+    RegisterId::DEVICE_CONFIG2,
+    ::mcf8316d_core::TUNED_DEVICE_CONFIG2_MASK,
     STARTUP_TUNE_DYNAMIC_CSA_GAIN_EN ? DEVICE_CONFIG2_DYNAMIC_CSA_GAIN_EN_MASK : 0u
   );
   ok &= apply_masked_bits(
     "GD_CONFIG1 tuning",
-    register_address(RegisterId::GD_CONFIG1),
-    GD_CONFIG1_CSA_GAIN_MASK,
+    RegisterId::GD_CONFIG1,
+    ::mcf8316d_core::TUNED_GD_CONFIG1_MASK,
     (STARTUP_TUNE_CSA_GAIN << GD_CONFIG1_CSA_GAIN_SHIFT)
   );
   ok &= apply_masked_bits(
     "ISD_CONFIG tuning",
-    register_address(RegisterId::ISD_CONFIG),
-    ISD_CONFIG_ISD_EN_MASK | ISD_CONFIG_BRAKE_EN_MASK | ISD_CONFIG_RESYNC_EN_MASK |
-      ISD_CONFIG_BRK_CONFIG_MASK | ISD_CONFIG_BRK_TIME_MASK,
+    RegisterId::ISD_CONFIG,
+    ::mcf8316d_core::TUNED_ISD_CONFIG_MASK,
     (STARTUP_TUNE_ISD_EN ? ISD_CONFIG_ISD_EN_MASK : 0u) |
       (STARTUP_TUNE_BRAKE_EN ? ISD_CONFIG_BRAKE_EN_MASK : 0u) |
       (STARTUP_TUNE_RESYNC_EN ? ISD_CONFIG_RESYNC_EN_MASK : 0u) |
@@ -196,8 +193,8 @@ bool MCF8316DTuningController::apply_startup_tune_profile() {
   );
   ok &= apply_masked_bits(
     "CLOSED_LOOP4 tuning",
-    register_address(RegisterId::CLOSED_LOOP4),
-    CLOSED_LOOP4_MAX_SPEED_MASK,
+    RegisterId::CLOSED_LOOP4,
+    ::mcf8316d_core::TUNED_CLOSED_LOOP4_MASK,
     (STARTUP_TUNE_MAX_SPEED << CLOSED_LOOP4_MAX_SPEED_SHIFT)
   );
 
@@ -351,12 +348,13 @@ bool MCF8316DTuningController::start_startup_current_sweep() {
     this->scope_probe_stage_pending_ = false;
   }
   if (this->startup_sweep_active_) {
-    ESP_LOGW(TUNING_TAG, "Startup current sweep already active; restarting from step 1");
+    ESP_LOGW(TUNING_TAG, "Startup current sweep already active; restarting search");
   } else {
     ESP_LOGI(
       TUNING_TAG,
-      "Starting startup current sweep (%u steps)",
-      static_cast<unsigned>(STARTUP_SWEEP_STEP_COUNT)
+      "Starting startup current search over %.3gA..%.3gA",
+      this->current_limit_code_to_amps_(STARTUP_SWEEP_MIN_CODE),
+      this->current_limit_code_to_amps_(STARTUP_SWEEP_MAX_CODE)
     );
   }
 
@@ -366,8 +364,9 @@ bool MCF8316DTuningController::start_startup_current_sweep() {
 
   this->startup_sweep_active_ = true;
   this->startup_sweep_step_pending_ = false;
-  this->startup_sweep_step_index_ = 0u;
-  this->startup_sweep_pass_count_ = 0u;
+  this->startup_search_.start({STARTUP_SWEEP_MIN_CODE, STARTUP_SWEEP_MAX_CODE, true});
+  this->startup_sweep_step_count_ = 0u;
+  this->startup_sweep_started_ms_ = millis();
   this->startup_sweep_step_start_ms_ = 0u;
   this->startup_sweep_next_step_due_ms_ = 0u;
   return this->begin_startup_sweep_step_();
@@ -396,13 +395,18 @@ bool MCF8316DTuningController::start_scope_probe_test() {
   this->scope_probe_test_active_ = true;
   this->scope_probe_stage_pending_ = false;
   this->scope_probe_stage_index_ = 0u;
+  this->scope_probe_results_.fill(::mcf8316d_core::ScopeStageResult{});
   this->scope_probe_stage_start_ms_ = 0u;
   this->scope_probe_next_stage_due_ms_ = 0u;
   return this->begin_scope_probe_stage_();
 }
 
-bool MCF8316DTuningController::needs_algorithm_state() const {
-  return this->startup_sweep_active_ || this->scope_probe_test_active_;
+bool MCF8316DTuningController::needs_algorithm_state() const { return this->startup_sweep_active_; }
+
+void MCF8316DTuningController::loop() {
+  if (this->scope_probe_test_active_) {
+    this->process_scope_probe_test_();
+  }
 }
 
 void MCF8316DTuningController::update(
@@ -423,15 +427,6 @@ void MCF8316DTuningController::update(
     controller_fault_status,
     volt_mag_raw
   );
-  this->process_scope_probe_test_(
-    algorithm_state_valid,
-    algorithm_state,
-    fault_active,
-    fault_state_valid,
-    controller_valid,
-    controller_fault_status,
-    volt_mag_raw
-  );
 
   const bool mpet_fault_active =
     controller_valid && ((controller_fault_status & (FAULT_MPET_IPD | FAULT_MPET_BEMF)) != 0);
@@ -646,20 +641,31 @@ void MCF8316DTuningController::log_mpet_diagnostics_(const char *context) {
   uint32_t algo_debug2 = 0;
   uint32_t algo_status_mpet = 0;
   uint32_t mtr_params = 0;
-  uint16_t algorithm_state = 0;
-
-  const bool ctrl_ok = this->parent_->read_reg32(RegisterId::CONTROLLER_FAULT_STATUS, ctrl_fault);
-  const bool dbg2_ok = this->parent_->read_reg32(RegisterId::ALGO_DEBUG2, algo_debug2);
-  const bool mpet_ok = this->parent_->read_reg32(RegisterId::ALGO_STATUS_MPET, algo_status_mpet);
-  const bool mtr_ok = this->parent_->read_reg32(RegisterId::MTR_PARAMS, mtr_params);
-  const bool state_ok = this->parent_->read_reg16(RegisterId::ALGORITHM_STATE, algorithm_state);
+  uint32_t algorithm_state = 0;
+
+  // Outside update() (setup) this takes a snapshot of its own.
+  ::mcf8316d_core::MCF8316DDiagnosticSnapshot &diagnostics = this->parent_->diagnostics_;
+  const bool own_snapshot = !diagnostics.active();
+  if (own_snapshot) {
+    diagnostics.begin();
+  }
+  diagnostics.require(
+    this->parent_->service_,
+    ::mcf8316d_core::DIAGNOSTIC_STATUS | ::mcf8316d_core::DIAGNOSTIC_ALGORITHM_STATE |
+      ::mcf8316d_core::DIAGNOSTIC_MPET_ENTRY | ::mcf8316d_core::DIAGNOSTIC_MPET
+  );
+  const bool ctrl_ok = diagnostics.value(RegisterId::CONTROLLER_FAULT_STATUS, ctrl_fault);
+  const bool dbg2_ok = diagnostics.value(RegisterId::ALGO_DEBUG2, algo_debug2);
+  const bool mpet_ok = diagnostics.value(RegisterId::ALGO_STATUS_MPET, algo_status_mpet);
+  const bool mtr_ok = diagnostics.value(RegisterId::MTR_PARAMS, mtr_params);
+  const bool state_ok = diagnostics.value(RegisterId::ALGORITHM_STATE, algorithm_state);
 
   ESP_LOGI(
     TUNING_TAG,
     "[%s] MPET diag: state=0x%04X(%s) ctrl=0x%08X dbg2=0x%08X mpet=0x%08X mtr=0x%08X",
     context,
     static_cast<unsigned>(algorithm_state),
-    this->parent_->algorithm_state_to_string_(algorithm_state),
+    this->parent_->algorithm_state_to_string_(static_cast<uint16_t>(algorithm_state)),
     ctrl_fault,
     algo_debug2,
     algo_status_mpet,
@@ -723,6 +729,9 @@ void MCF8316DTuningController::log_mpet_diagnostics_(const char *context) {
       YESNO(state_ok)
     );
   }
+  if (own_snapshot) {
+    diagnostics.end();
+  }
 }
 
 void MCF8316DTuningController::log_mpet_entry_conditions(const char *context, uint32_t algo_debug2) {
@@ -730,9 +739,11 @@ void MCF8316DTuningController::log_mpet_entry_conditions(const char *context, ui
   uint32_t closed_loop3 = 0;
   uint32_t closed_loop4 = 0;
 
-  const bool cl2_ok = this->parent_->read_reg32(RegisterId::CLOSED_LOOP2, closed_loop2);
-  const bool cl3_ok = this->parent_->read_reg32(RegisterId::CLOSED_LOOP3, closed_loop3);
-  const bool cl4_ok = this->parent_->read_reg32(RegisterId::CLOSED_LOOP4, closed_loop4);
+  ::mcf8316d_core::MCF8316DDiagnosticSnapshot &diagnostics = this->parent_->diagnostics_;
+  diagnostics.require(this->parent_->service_, ::mcf8316d_core::DIAGNOSTIC_MPET_ENTRY);
+  const bool cl2_ok = diagnostics.value(RegisterId::CLOSED_LOOP2, closed_loop2);
+  const bool cl3_ok = diagnostics.value(RegisterId::CLOSED_LOOP3, closed_loop3);
+  const bool cl4_ok = diagnostics.value(RegisterId::CLOSED_LOOP4, closed_loop4);
 
   if (cl2_ok && cl3_ok && cl4_ok) {
     const uint32_t motor_res = static_cast<uint32_t>(
@@ -847,6 +858,7 @@ bool MCF8316DTuningController::begin_scope_probe_stage_() {
     this->scope_probe_test_active_ = false;
     this->scope_probe_stage_pending_ = false;
     (void) this->parent_->set_speed_percent(0.0f);
+    this->publish_scope_probe_result_();
     return true;
   }
 
@@ -887,36 +899,42 @@ bool MCF8316DTuningController::begin_scope_probe_stage_() {
   }
 
   this->scope_probe_stage_start_ms_ = millis();
+  this->scope_capture_.start(this->scope_probe_stage_start_ms_);
   ESP_LOGI(
     TUNING_TAG,
-    "[scope_probe] Stage %u/%u start: speed=%.1f%% hold=%ums",
+    "[scope_probe] Stage %u/%u start: speed=%.1f%% hold=%ums sample=%ums",
     static_cast<unsigned>(this->scope_probe_stage_index_ + 1u),
     static_cast<unsigned>(SCOPE_PROBE_STAGE_COUNT),
     speed_percent,
-    static_cast<unsigned>(hold_ms)
+    static_cast<unsigned>(hold_ms),
+    static_cast<unsigned>(this->scope_capture_.interval_ms())
   );
   return true;
 }
 
-void MCF8316DTuningController::process_scope_probe_test_(
-  bool algorithm_state_valid,
-  uint16_t algorithm_state,
-  bool fault_active,
-  bool fault_state_valid,
-  bool controller_valid,
-  uint32_t controller_fault_status,
-  uint16_t volt_mag_raw
-) {
-  if (!this->scope_probe_test_active_) {
-    return;
+bool MCF8316DTuningController::read_scope_probe_fault_(bool &fault_active, uint32_t &controller_fault_status) {
+  uint32_t gate_fault_status = 0;
+  const bool gate_ok = this->parent_->read_reg32(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_fault_status);
+  const bool controller_ok = this->parent_->read_reg32(RegisterId::CONTROLLER_FAULT_STATUS, controller_fault_status);
+  if (!controller_ok) {
+    controller_fault_status = 0u;
   }
+  fault_active = (gate_ok && (gate_fault_status & GATE_DRIVER_FAULT_ACTIVE_MASK) != 0u) ||
+                 (controller_ok && (controller_fault_status & CONTROLLER_FAULT_ACTIVE_MASK) != 0u);
+  return gate_ok || controller_ok;
+}
 
+// Runs from loop() so the capture keeps its 100 ms grid whatever the
+// component update interval is. Each sample costs four register reads.
+void MCF8316DTuningController::process_scope_probe_test_() {
   const uint32_t now = millis();
   if (this->scope_probe_stage_pending_) {
     if (now < this->scope_probe_next_stage_due_ms_) {
       return;
     }
-    if (fault_state_valid && fault_active) {
+    bool fault_active = false;
+    uint32_t controller_fault_status = 0;
+    if (this->read_scope_probe_fault_(fault_active, controller_fault_status) && fault_active) {
       ESP_LOGI(
         TUNING_TAG,
         "[scope_probe] waiting for fault clear before stage %u",
@@ -932,68 +950,115 @@ void MCF8316DTuningController::process_scope_probe_test_(
   }
 
   const uint32_t elapsed_ms = now - this->scope_probe_stage_start_ms_;
-  const uint32_t hold_ms = this->scope_probe_stage_hold_ms_(this->scope_probe_stage_index_);
-  const float speed_percent = this->scope_probe_stage_speed_percent_(this->scope_probe_stage_index_);
-  const float volt_mag_percent = (static_cast<float>(volt_mag_raw) * 100.0f) / 32768.0f;
-
-  if (fault_state_valid && fault_active) {
-    const uint32_t ctrl_fault_word = controller_valid ? controller_fault_status : 0u;
-    ESP_LOGW(
-      TUNING_TAG,
-      "[scope_probe] Stage %u FAULT: speed=%.1f%% elapsed=%ums ctrl_fault=0x%08X ctrl_valid=%s "
-      "state=%s volt_mag=%.1f%%",
-      static_cast<unsigned>(this->scope_probe_stage_index_ + 1u),
-      speed_percent,
-      static_cast<unsigned>(elapsed_ms),
-      ctrl_fault_word,
-      YESNO(controller_valid),
-      algorithm_state_valid ? this->parent_->algorithm_state_to_string_(algorithm_state) : "UNKNOWN",
-      volt_mag_percent
-    );
-    (void) this->parent_->set_speed_percent(0.0f);
-    this->scope_probe_stage_index_++;
-    this->scope_probe_stage_pending_ = true;
-    this->scope_probe_next_stage_due_ms_ = now + SCOPE_PROBE_INTER_STAGE_DELAY_MS;
+  if (elapsed_ms >= this->scope_probe_stage_hold_ms_(this->scope_probe_stage_index_) || this->scope_capture_.full()) {
+    this->finish_scope_probe_stage_(now);
+    return;
+  }
+  if (!this->scope_capture_.due(now)) {
     return;
   }
 
-  if (elapsed_ms >= hold_ms) {
-    ESP_LOGI(
+  uint32_t algo_status = 0;
+  uint32_t speed_fdbk_raw = 0;
+  if (!this->parent_->read_reg32(RegisterId::ALGO_STATUS, algo_status) ||
+      !this->parent_->read_reg32(RegisterId::SPEED_FDBK, speed_fdbk_raw)) {
+    // The slot passes unsampled and shows up as missed in the stage result.
+    return;
+  }
+  bool fault_active = false;
+  uint32_t controller_fault_status = 0;
+  (void) this->read_scope_probe_fault_(fault_active, controller_fault_status);
+  uint32_t vm_voltage_raw = 0;
+  float vm_v = 0.0f;
+  if (this->parent_->read_reg32(RegisterId::VM_VOLTAGE, vm_voltage_raw)) {
+    vm_v = static_cast<float>((vm_voltage_raw & VM_VOLTAGE_Q11_MASK) >> VM_VOLTAGE_Q11_SHIFT) * (60.0f / 2048.0f);
+  }
+  const uint16_t duty_raw = (algo_status & ALGO_STATUS_DUTY_CMD_MASK) >> ALGO_STATUS_DUTY_CMD_SHIFT;
+  const float duty_percent = (static_cast<float>(duty_raw) / 4095.0f) * 100.0f;
+  const float speed_percent =
+    std::fabs(::mcf8316d_core::decode_speed_percent(static_cast<int32_t>(speed_fdbk_raw)));
+  (void) this->scope_capture_.add(now, speed_percent, duty_percent, vm_v, fault_active);
+
+  if (fault_active) {
+    ESP_LOGW(
       TUNING_TAG,
-      "[scope_probe] Stage %u complete: speed=%.1f%% elapsed=%ums state=%s volt_mag=%.1f%%",
+      "[scope_probe] Stage %u FAULT: speed=%.1f%% elapsed=%ums ctrl_fault=0x%08X speed_fdbk=%.1f%%",
       static_cast<unsigned>(this->scope_probe_stage_index_ + 1u),
-      speed_percent,
+      this->scope_probe_stage_speed_percent_(this->scope_probe_stage_index_),
       static_cast<unsigned>(elapsed_ms),
-      algorithm_state_valid ? this->parent_->algorithm_state_to_string_(algorithm_state) : "UNKNOWN",
-      volt_mag_percent
+      controller_fault_status,
+      speed_percent
     );
-    (void) this->parent_->set_speed_percent(0.0f);
-    this->scope_probe_stage_index_++;
-    this->scope_probe_stage_pending_ = true;
-    this->scope_probe_next_stage_due_ms_ = now + SCOPE_PROBE_INTER_STAGE_DELAY_MS;
+    this->finish_scope_probe_stage_(now);
   }
 }
 
-uint32_t MCF8316DTuningController::startup_sweep_current_code_(uint8_t step_index) const {
-  switch (step_index) {
-    case 0:
-      return 3u;
-    case 1:
-      return 4u;
-    case 2:
-      return 5u;
-    case 3:
-    default:
-      return 6u;
+void MCF8316DTuningController::finish_scope_probe_stage_(uint32_t now) {
+  const ::mcf8316d_core::ScopeStageResult result = this->scope_capture_.reduce(::mcf8316d_core::ScopeStageLimits{});
+  this->scope_probe_results_[this->scope_probe_stage_index_] = result;
+  ESP_LOGI(
+    TUNING_TAG,
+    "[scope_probe] Stage %u %s: speed=%.1f%% samples=%u missed=%u speed_fdbk=%.1f%% ripple=%.1f%% "
+    "settle=%s%ums duty=%.1f%% ripple=%.1f%% vm=%.2fV min=%.2fV",
+    static_cast<unsigned>(this->scope_probe_stage_index_ + 1u),
+    result.pass ? "PASS" : "FAIL",
+    this->scope_probe_stage_speed_percent_(this->scope_probe_stage_index_),
+    static_cast<unsigned>(result.samples),
+    static_cast<unsigned>(result.missed),
+    result.speed.mean,
+    result.speed.ripple,
+    result.speed.settled ? "" : "never/",
+    static_cast<unsigned>(result.speed.settle_ms),
+    result.duty.mean,
+    result.duty.ripple,
+    result.vm.mean,
+    result.vm.min
+  );
+  (void) this->parent_->set_speed_percent(0.0f);
+  this->scope_probe_stage_index_++;
+  this->scope_probe_stage_pending_ = true;
+  this->scope_probe_next_stage_due_ms_ = now + SCOPE_PROBE_INTER_STAGE_DELAY_MS;
+}
+
+// Text sensor state: "<PASS|FAIL> | <speed>%:<PASS|FAIL|FAULT> s=<mean>/<ripple>
+// t=<settle ms|-> vm=<mean>/<min> ..." with one group per stage; s is the
+// SPEED_FDBK channel.
+void MCF8316DTuningController::publish_scope_probe_result_() {
+  bool pass = true;
+  std::string summary;
+  char text[64];
+  for (uint8_t stage = 0; stage < SCOPE_PROBE_STAGE_COUNT; stage++) {
+    const ::mcf8316d_core::ScopeStageResult &result = this->scope_probe_results_[stage];
+    pass = pass && result.pass;
+    char settle[12];
+    if (result.speed.settled) {
+      std::snprintf(settle, sizeof(settle), "%u", static_cast<unsigned>(result.speed.settle_ms));
+    } else {
+      std::snprintf(settle, sizeof(settle), "-");
+    }
+    std::snprintf(
+      text,
+      sizeof(text),
+      " | %.0f%%:%s s=%.1f/%.1f t=%s vm=%.1f/%.1f",
+      this->scope_probe_stage_speed_percent_(stage),
+      result.fault ? "FAULT" : (result.pass ? "PASS" : "FAIL"),
+      result.speed.mean,
+      result.speed.ripple,
+      settle,
+      result.vm.mean,
+      result.vm.min
+    );
+    summary += text;
+  }
+  summary.insert(0, pass ? "PASS" : "FAIL");
+  ESP_LOGI(TUNING_TAG, "[scope_probe] Result: %s", summary.c_str());
+  if (this->parent_->scope_probe_result_text_sensor_ != nullptr) {
+    this->parent_->scope_probe_result_text_sensor_->publish_state(summary);
   }
 }
 
 float MCF8316DTuningController::current_limit_code_to_amps_(uint32_t current_limit_code) const {
-  static const float kCurrentThresholdA[16] = {
-    0.125f, 0.25f, 0.5f, 1.0f, 1.5f, 2.0f, 2.5f, 3.0f,
-    3.5f,   4.0f,  4.5f, 5.0f, 5.5f, 6.0f, 7.0f, 8.0f,
-  };
-  return kCurrentThresholdA[current_limit_code & 0xFu];
+  return ::mcf8316d_core::startup_current_code_to_amps(static_cast<uint8_t>(current_limit_code));
 }
 
 bool MCF8316DTuningController::apply_startup_sweep_current_limits_(uint32_t current_limit_code) {
@@ -1001,7 +1066,7 @@ bool MCF8316DTuningController::apply_startup_sweep_current_limits_(uint32_t curr
     (current_limit_code << MOTOR_STARTUP1_ALIGN_OR_SLOW_CURRENT_ILIMIT_SHIFT);
   const uint32_t s2_value = (current_limit_code << MOTOR_STARTUP2_OL_ILIMIT_SHIFT);
   if (!this->parent_->update_bits32(
-        register_address(RegisterId::MOTOR_STARTUP1), MOTOR_STARTUP1_ALIGN_OR_SLOW_CURRENT_ILIMIT_MASK, s1_value
+        RegisterId::MOTOR_STARTUP1, MOTOR_STARTUP1_ALIGN_OR_SLOW_CURRENT_ILIMIT_MASK, s1_value
       )) {
     ESP_LOGW(TUNING_TAG, "Startup sweep MOTOR_STARTUP1 write failed");
     return false;
@@ -1035,46 +1100,153 @@ bool MCF8316DTuningController::apply_startup_sweep_current_limits_(uint32_t curr
   return true;
 }
 
+// The search leaves its last step applied; settle on the best-scoring
+// current instead and persist it together with the startup tune profile.
+void MCF8316DTuningController::commit_startup_sweep_() {
+  uint8_t best_code = 0;
+  if (!this->startup_search_.best(best_code)) {
+    ESP_LOGW(TUNING_TAG, "Startup current search found no passing current limit; result not stored");
+    return;
+  }
+  ESP_LOGI(
+    TUNING_TAG,
+    "Startup current search selected current_limit=%u (%.3gA) after %u steps",
+    static_cast<unsigned>(best_code),
+    this->current_limit_code_to_amps_(best_code),
+    static_cast<unsigned>(this->startup_search_.evaluations())
+  );
+  if (!this->apply_startup_sweep_current_limits_(best_code)) {
+    return;
+  }
+
+  ::mcf83xx_common::TuningRecord record{};
+  if (!this->parent_->tuning_store_.begin_update(record)) {
+    return;
+  }
+  const ::mcf8316d_core::MCF8316DService &service = this->parent_->service_;
+  const bool recorded =
+    service.record_tuned_field(record, RegisterId::FAULT_CONFIG1, ::mcf8316d_core::TUNED_FAULT_CONFIG1_MASK) &&
+    service.record_tuned_field(record, RegisterId::FAULT_CONFIG2, ::mcf8316d_core::TUNED_FAULT_CONFIG2_MASK) &&
+    service.record_tuned_field(record, RegisterId::MOTOR_STARTUP1, ::mcf8316d_core::TUNED_MOTOR_STARTUP1_MASK) &&
+    service.record_tuned_field(record, RegisterId::MOTOR_STARTUP2, ::mcf8316d_core::TUNED_MOTOR_STARTUP2_MASK) &&
+    service.record_tuned_field(record, RegisterId::CLOSED_LOOP1, ::mcf8316d_core::TUNED_CLOSED_LOOP1_MASK) &&
+    service.record_tuned_field(record, RegisterId::DEVICE_CONFIG2, ::mcf8316d_core::TUNED_DEVICE_CONFIG2_MASK) &&
+    service.record_tuned_field(record, RegisterId::GD_CONFIG1, ::mcf8316d_core::TUNED_GD_CONFIG1_MASK) &&
+    service.record_tuned_field(record, RegisterId::ISD_CONFIG, ::mcf8316d_core::TUNED_ISD_CONFIG_MASK) &&
+    service.record_tuned_field(record, RegisterId::CLOSED_LOOP4, ::mcf8316d_core::TUNED_CLOSED_LOOP4_MASK);
+  if (!recorded) {
+    ESP_LOGW(TUNING_TAG, "Startup current search: failed to read back result; not stored");
+    return;
+  }
+  this->parent_->tuning_store_.store(
+    record, ::mcf83xx_common::TuningResultKind::STARTUP, millis() - this->startup_sweep_started_ms_, TUNING_TAG
+  );
+}
+
+// One log line per tried code in current order, plus a compact text sensor
+// state: "best=<A> steps=<n> | <A>:<outcome>[:<reach ms>/<score>] ...".
+void MCF8316DTuningController::publish_startup_sweep_summary_() {
+  using ::mcf8316d_core::StartupStepOutcome;
+  uint8_t best_code = 0;
+  const bool best_valid = this->startup_search_.best(best_code);
+  char text[32];
+  std::string summary;
+  if (best_valid) {
+    std::snprintf(text, sizeof(text), "best=%.3gA", this->current_limit_code_to_amps_(best_code));
+    summary = text;
+  } else {
+    summary = "best=none";
+  }
+  std::snprintf(text, sizeof(text), " steps=%u |", static_cast<unsigned>(this->startup_search_.evaluations()));
+  summary += text;
+
+  ESP_LOGI(TUNING_TAG, "[startup_sweep] Summary (%s):", this->startup_search_.aborted() ? "aborted" : "complete");
+  ESP_LOGI(TUNING_TAG, "[startup_sweep]   current  outcome  reach_ms  overshoot  ripple  score");
+  for (uint8_t code = 0; code < ::mcf8316d_core::STARTUP_CURRENT_CODE_COUNT; code++) {
+    if (!this->startup_search_.evaluated(code)) {
+      continue;
+    }
+    const ::mcf8316d_core::StartupStepResult &result = this->startup_search_.result(code);
+    const bool passed = result.outcome == StartupStepOutcome::PASS;
+    ESP_LOGI(
+      TUNING_TAG,
+      "[startup_sweep]   %5.3gA  %-7s  %8u  %8.2fA  %5.1f%%  %6ld%s",
+      this->current_limit_code_to_amps_(code),
+      ::mcf8316d_core::startup_step_outcome_to_string(result.outcome),
+      static_cast<unsigned>(result.reach_ms),
+      result.current_overshoot_amps,
+      result.speed_ripple_percent,
+      passed ? static_cast<long>(result.score) : 0L,
+      best_valid && code == best_code ? "  <- best" : ""
+    );
+    if (passed) {
+      std::snprintf(
+        text,
+        sizeof(text),
+        " %.3gA:PASS:%u/%ld",
+        this->current_limit_code_to_amps_(code),
+        static_cast<unsigned>(result.reach_ms),
+        static_cast<long>(result.score)
+      );
+    } else {
+      std::snprintf(
+        text,
+        sizeof(text),
+        " %.3gA:%s",
+        this->current_limit_code_to_amps_(code),
+        ::mcf8316d_core::startup_step_outcome_to_string(result.outcome)
+      );
+    }
+    summary += text;
+  }
+  if (this->parent_->startup_sweep_summary_text_sensor_ != nullptr) {
+    this->parent_->startup_sweep_summary_text_sensor_->publish_state(summary);
+  }
+}
+
 bool MCF8316DTuningController::begin_startup_sweep_step_() {
   if (!this->startup_sweep_active_) {
     return false;
   }
 
-  if (this->startup_sweep_step_index_ >= STARTUP_SWEEP_STEP_COUNT) {
+  uint8_t current_limit_code = 0;
+  if (!this->startup_search_.next_code(current_limit_code)) {
     ESP_LOGI(
       TUNING_TAG,
-      "Startup current sweep finished: %u/%u steps reached open/closed loop",
-      static_cast<unsigned>(this->startup_sweep_pass_count_),
-      static_cast<unsigned>(STARTUP_SWEEP_STEP_COUNT)
+      "Startup current search finished after %u steps%s",
+      static_cast<unsigned>(this->startup_search_.evaluations()),
+      this->startup_search_.aborted() ? " (aborted on fault)" : ""
     );
     this->startup_sweep_active_ = false;
     this->startup_sweep_step_pending_ = false;
     (void) this->parent_->set_speed_percent(0.0f);
+    this->publish_startup_sweep_summary_();
+    this->commit_startup_sweep_();
     return true;
   }
 
-  const uint32_t current_limit_code = this->startup_sweep_current_code_(this->startup_sweep_step_index_);
+  this->startup_sweep_step_count_++;
   const float current_limit_a = this->current_limit_code_to_amps_(current_limit_code);
 
   if (!this->parent_->set_speed_percent(0.0f)) {
     ESP_LOGW(
       TUNING_TAG,
       "Startup sweep step %u failed to set speed to 0%% before configuring",
-      static_cast<unsigned>(this->startup_sweep_step_index_ + 1u)
+      static_cast<unsigned>(this->startup_sweep_step_count_)
     );
   }
   if (!this->parent_->set_direction_mode("cw")) {
     ESP_LOGW(
       TUNING_TAG,
       "Startup sweep step %u failed to force direction cw",
-      static_cast<unsigned>(this->startup_sweep_step_index_ + 1u)
+      static_cast<unsigned>(this->startup_sweep_step_count_)
     );
   }
   if (!this->parent_->set_brake_override(false)) {
     ESP_LOGW(
       TUNING_TAG,
       "Startup sweep step %u failed to force brake OFF",
-      static_cast<unsigned>(this->startup_sweep_step_index_ + 1u)
+      static_cast<unsigned>(this->startup_sweep_step_count_)
     );
   }
 
@@ -1082,7 +1254,7 @@ bool MCF8316DTuningController::begin_startup_sweep_step_() {
     ESP_LOGW(
       TUNING_TAG,
       "Startup sweep step %u failed to apply current limits",
-      static_cast<unsigned>(this->startup_sweep_step_index_ + 1u)
+      static_cast<unsigned>(this->startup_sweep_step_count_)
     );
     this->startup_sweep_active_ = false;
     return false;
@@ -1093,19 +1265,22 @@ bool MCF8316DTuningController::begin_startup_sweep_step_() {
     ESP_LOGW(
       TUNING_TAG,
       "Startup sweep step %u failed to set speed to %.1f%%",
-      static_cast<unsigned>(this->startup_sweep_step_index_ + 1u),
+      static_cast<unsigned>(this->startup_sweep_step_count_),
       STARTUP_SWEEP_SPEED_PERCENT
     );
     this->startup_sweep_active_ = false;
     return false;
   }
+  this->startup_sweep_max_speed_hz_ = ::mcf8316d_core::read_max_speed_hz(
+    this->parent_->service_, ::mcf8316d_core::decode_max_speed_hz(static_cast<uint16_t>(STARTUP_TUNE_MAX_SPEED))
+  );
   this->startup_sweep_step_start_ms_ = millis();
+  this->startup_step_.start(current_limit_code, this->startup_sweep_step_start_ms_);
 
   ESP_LOGI(
     TUNING_TAG,
-    "[startup_sweep] Step %u/%u start: current_limit=%u (%.3gA), speed=%.1f%%",
-    static_cast<unsigned>(this->startup_sweep_step_index_ + 1u),
-    static_cast<unsigned>(STARTUP_SWEEP_STEP_COUNT),
+    "[startup_sweep] Step %u start: current_limit=%u (%.3gA), speed=%.1f%%",
+    static_cast<unsigned>(this->startup_sweep_step_count_),
     static_cast<unsigned>(current_limit_code),
     current_limit_a,
     STARTUP_SWEEP_SPEED_PERCENT
@@ -1128,6 +1303,7 @@ void MCF8316DTuningController::process_startup_sweep_(
   uint32_t controller_fault_status,
   uint16_t volt_mag_raw
 ) {
+  using ::mcf8316d_core::StartupStepOutcome;
   if (!this->startup_sweep_active_) {
     return;
   }
@@ -1138,11 +1314,7 @@ void MCF8316DTuningController::process_startup_sweep_(
       return;
     }
     if (fault_state_valid && fault_active) {
-      ESP_LOGI(
-        TUNING_TAG,
-        "[startup_sweep] waiting for fault clear before step %u",
-        static_cast<unsigned>(this->startup_sweep_step_index_ + 1u)
-      );
+      ESP_LOGI(TUNING_TAG, "[startup_sweep] waiting for fault clear before next step");
       this->parent_->pulse_clear_faults();
       this->startup_sweep_next_step_due_ms_ = now + STARTUP_SWEEP_CLEAR_RETRY_MS;
       return;
@@ -1152,67 +1324,66 @@ void MCF8316DTuningController::process_startup_sweep_(
     return;
   }
 
-  const uint32_t elapsed_ms = now - this->startup_sweep_step_start_ms_;
-  const uint32_t current_limit_code = this->startup_sweep_current_code_(this->startup_sweep_step_index_);
-  const float current_limit_a = this->current_limit_code_to_amps_(current_limit_code);
-  const float volt_mag_percent = (static_cast<float>(volt_mag_raw) * 100.0f) / 32768.0f;
-  const bool reached_drive_state =
-    algorithm_state_valid && ((algorithm_state == ALGORITHM_STATE_OPEN_LOOP) ||
-                              (algorithm_state == ALGORITHM_STATE_CLOSED_LOOP_UNALIGNED) ||
-                              (algorithm_state == ALGORITHM_STATE_CLOSED_LOOP_ALIGNED));
-
-  if (reached_drive_state && !fault_active && (volt_mag_raw > 0u)) {
-    ESP_LOGI(
-      TUNING_TAG,
-      "[startup_sweep] Step %u PASS: current_limit=%u (%.3gA), elapsed=%ums, state=%s, "
-      "volt_mag=%.1f%%",
-      static_cast<unsigned>(this->startup_sweep_step_index_ + 1u),
-      static_cast<unsigned>(current_limit_code),
-      current_limit_a,
-      static_cast<unsigned>(elapsed_ms),
-      this->parent_->algorithm_state_to_string_(algorithm_state),
-      volt_mag_percent
-    );
-    this->startup_sweep_pass_count_++;
-    this->startup_sweep_step_index_++;
-    this->schedule_startup_sweep_step_(STARTUP_SWEEP_INTER_STEP_DELAY_MS);
+  float speed_hz = 0.0f;
+  float fg_speed_hz = 0.0f;
+  float phase_current_a = 0.0f;
+  const bool feedback_valid =
+    ::mcf8316d_core::read_speed_pair_hz(
+      this->parent_->service_, this->startup_sweep_max_speed_hz_, speed_hz, fg_speed_hz
+    ) &&
+    ::mcf8316d_core::read_phase_current_peak_amps(this->parent_->service_, phase_current_a);
+  if (!feedback_valid) {
+    ESP_LOGW(TUNING_TAG, "[startup_sweep] failed to read speed/current feedback; sample not scored");
+  }
+  if (!this->startup_step_.sample(
+        now,
+        algorithm_state_valid,
+        algorithm_state,
+        fault_state_valid && fault_active,
+        controller_valid,
+        controller_fault_status,
+        feedback_valid,
+        speed_hz,
+        phase_current_a
+      )) {
     return;
   }
 
-  if (fault_state_valid && fault_active) {
-    const uint32_t ctrl_fault_word = controller_valid ? controller_fault_status : 0u;
-    ESP_LOGW(
+  const ::mcf8316d_core::StartupStepResult &result = this->startup_step_.result();
+  this->startup_search_.record(result);
+  const float current_limit_a = this->current_limit_code_to_amps_(result.code);
+  const float volt_mag_percent = (static_cast<float>(volt_mag_raw) * 100.0f) / 32768.0f;
+  if (result.outcome == StartupStepOutcome::PASS) {
+    ESP_LOGI(
       TUNING_TAG,
-      "[startup_sweep] Step %u FAIL: current_limit=%u (%.3gA), elapsed=%ums, ctrl_fault=0x%08X "
-      "ctrl_valid=%s state=%s volt_mag=%.1f%%",
-      static_cast<unsigned>(this->startup_sweep_step_index_ + 1u),
-      static_cast<unsigned>(current_limit_code),
+      "[startup_sweep] Step %u PASS: current_limit=%u (%.3gA), reach=%ums, overshoot=%.2fA, speed=%.1fHz "
+      "(fg=%.1fHz), ripple=%.1f%%, score=%ld",
+      static_cast<unsigned>(this->startup_sweep_step_count_),
+      static_cast<unsigned>(result.code),
       current_limit_a,
-      static_cast<unsigned>(elapsed_ms),
-      ctrl_fault_word,
-      YESNO(controller_valid),
-      algorithm_state_valid ? this->parent_->algorithm_state_to_string_(algorithm_state) : "UNKNOWN",
-      volt_mag_percent
+      static_cast<unsigned>(result.reach_ms),
+      result.current_overshoot_amps,
+      result.settled_speed_hz,
+      fg_speed_hz,
+      result.speed_ripple_percent,
+      static_cast<long>(result.score)
     );
-    this->startup_sweep_step_index_++;
-    this->schedule_startup_sweep_step_(STARTUP_SWEEP_INTER_STEP_DELAY_MS);
-    return;
-  }
-
-  if (elapsed_ms >= STARTUP_SWEEP_STEP_TIMEOUT_MS) {
+  } else {
     ESP_LOGW(
       TUNING_TAG,
-      "[startup_sweep] Step %u TIMEOUT: current_limit=%u (%.3gA), state=%s, volt_mag=%.1f%%, no "
-      "drive-state transition",
-      static_cast<unsigned>(this->startup_sweep_step_index_ + 1u),
-      static_cast<unsigned>(current_limit_code),
+      "[startup_sweep] Step %u %s: current_limit=%u (%.3gA), elapsed=%ums, ctrl_fault=0x%08X state=%s "
+      "volt_mag=%.1f%%",
+      static_cast<unsigned>(this->startup_sweep_step_count_),
+      ::mcf8316d_core::startup_step_outcome_to_string(result.outcome),
+      static_cast<unsigned>(result.code),
       current_limit_a,
+      static_cast<unsigned>(now - this->startup_sweep_step_start_ms_),
+      result.controller_fault_status,
       algorithm_state_valid ? this->parent_->algorithm_state_to_string_(algorithm_state) : "UNKNOWN",
       volt_mag_percent
     );
-    this->startup_sweep_step_index_++;
-    this->schedule_startup_sweep_step_(STARTUP_SWEEP_INTER_STEP_DELAY_MS);
   }
+  this->schedule_startup_sweep_step_(STARTUP_SWEEP_INTER_STEP_DELAY_MS);
 }
 
 }  // namespace mcf8316d
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <array>
 #include <cstdint>
 
+#include "mcf8316d_scope_capture.h"
+#include "mcf8316d_startup_search.h"
+
 namespace esphome {
 namespace mcf8316d {
 
@@ -9,6 +13,8 @@ class MCF8316DComponent;
 
 class MCF8316DTuningController {
  public:
+  static constexpr uint8_t SCOPE_PROBE_STAGE_COUNT = 3u;
+
   explicit MCF8316DTuningController(MCF8316DComponent *parent) : parent_(parent) {}
 
   bool apply_startup_tune_profile();
@@ -17,6 +23,8 @@ class MCF8316DTuningController {
   bool start_scope_probe_test();
   void apply_post_comms_setup();
   bool needs_algorithm_state() const;
+  // Samples the scope probe capture on its own grid, independent of update().
+  void loop();
   void update(
     bool algorithm_state_valid,
     uint16_t algorithm_state,
@@ -26,6 +34,7 @@ class MCF8316DTuningController {
     uint32_t controller_fault_status,
     uint16_t volt_mag_raw
   );
+  // Reads CLOSED_LOOP2..4 through the component's active diagnostic snapshot.
   void log_mpet_entry_conditions(const char *context, uint32_t algo_debug2);
 
  private:
@@ -34,6 +43,8 @@ class MCF8316DTuningController {
   void log_mpet_diagnostics_(const char *context);
   bool apply_startup_sweep_current_limits_(uint32_t current_limit_code);
   bool begin_startup_sweep_step_();
+  void commit_startup_sweep_();
+  void publish_startup_sweep_summary_();
   void schedule_startup_sweep_step_(uint32_t delay_ms);
   void process_startup_sweep_(
     bool algorithm_state_valid,
@@ -45,18 +56,12 @@ class MCF8316DTuningController {
     uint16_t volt_mag_raw
   );
   bool begin_scope_probe_stage_();
-  void process_scope_probe_test_(
-    bool algorithm_state_valid,
-    uint16_t algorithm_state,
-    bool fault_active,
-    bool fault_state_valid,
-    bool controller_valid,
-    uint32_t controller_fault_status,
-    uint16_t volt_mag_raw
-  );
+  void process_scope_probe_test_();
+  bool read_scope_probe_fault_(bool &fault_active, uint32_t &controller_fault_status);
+  void finish_scope_probe_stage_(uint32_t now);
+  void publish_scope_probe_result_();
   float scope_probe_stage_speed_percent_(uint8_t stage_index) const;
   uint32_t scope_probe_stage_hold_ms_(uint8_t stage_index) const;
-  uint32_t startup_sweep_current_code_(uint8_t step_index) const;
   float current_limit_code_to_amps_(uint32_t current_limit_code) const;
 
   MCF8316DComponent *parent_;
@@ -64,11 +69,17 @@ class MCF8316DTuningController {
   bool startup_sweep_step_pending_{false};
   bool scope_probe_test_active_{false};
   bool scope_probe_stage_pending_{false};
-  uint8_t startup_sweep_step_index_{0};
-  uint8_t startup_sweep_pass_count_{0};
+  ::mcf8316d_core::StartupCurrentSearch startup_search_{};
+  ::mcf8316d_core::StartupStepMonitor startup_step_{};
+  uint8_t startup_sweep_step_count_{0};
   uint8_t scope_probe_stage_index_{0};
+  ::mcf8316d_core::ScopeCapture scope_capture_{};
+  std::array<::mcf8316d_core::ScopeStageResult, SCOPE_PROBE_STAGE_COUNT> scope_probe_results_{};
+  uint32_t startup_sweep_started_ms_{0};
   uint32_t startup_sweep_step_start_ms_{0};
   uint32_t startup_sweep_next_step_due_ms_{0};
+  // MAX_SPEED the current step's SPEED_FDBK/FG_SPEED_FDBK are scaled by.
+  float startup_sweep_max_speed_hz_{0.0f};
   uint32_t scope_probe_stage_start_ms_{0};
   uint32_t scope_probe_next_stage_due_ms_{0};
   uint32_t last_mpet_diag_log_ms_{0};
@@ -1,17 +1,25 @@
 import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.components import binary_sensor, button, i2c, number, select, sensor, switch as switch_, text_sensor
+from esphome.components.mcf83xx_facade import (
+    FAMILY_SCHEMA,
+    register_family_config,
+    tuning_config_hash,
+    validate_watchdog_tickle,
+)
 from esphome.const import (
     CONF_ID,
     DEVICE_CLASS_VOLTAGE,
     ENTITY_CATEGORY_CONFIG,
+    ENTITY_CATEGORY_DIAGNOSTIC,
     STATE_CLASS_MEASUREMENT,
+    STATE_CLASS_TOTAL_INCREASING,
     UNIT_PERCENT,
     UNIT_VOLT,
 )
 
 DEPENDENCIES = ["i2c"]
-AUTO_LOAD = ["mcf83xx_common", "sensor", "binary_sensor", "switch", "number", "select", "button", "text_sensor"]
+AUTO_LOAD = ["mcf83xx_common", "mcf83xx_facade", "sensor", "binary_sensor", "switch", "number", "select", "button", "text_sensor"]
 
 mcf8329a_ns = cg.esphome_ns.namespace("mcf8329a")
 MCF8329AComponent = mcf8329a_ns.class_("MCF8329AComponent", cg.PollingComponent, i2c.I2CDevice)
@@ -23,7 +31,6 @@ MCF8329AWatchdogTickleButton = mcf8329a_ns.class_("MCF8329AWatchdogTickleButton"
 MCF8329ATuneInitialParamsButton = mcf8329a_ns.class_("MCF8329ATuneInitialParamsButton", button.Button)
 MCF8329ARunMPETButton = mcf8329a_ns.class_("MCF8329ARunMPETButton", button.Button)
 
-CONF_AUTO_TICKLE_WATCHDOG = "auto_tickle_watchdog"
 CONF_CLEAR_MPET_ON_STARTUP = "clear_mpet_on_startup"
 CONF_ALLOW_UNSAFE_CURRENT_LIMITS = "allow_unsafe_current_limits"
 CONF_MOTOR_BEMF_CONST = "motor_bemf_const"
@@ -68,8 +75,16 @@ CONF_SPEED_LOOP_KP_CODE = "speed_loop_kp_code"
 CONF_SPEED_LOOP_KI_CODE = "speed_loop_ki_code"
 CONF_SPEED_RAMP_UP_PERCENT_PER_S = "speed_ramp_up_percent_per_s"
 CONF_SPEED_RAMP_DOWN_PERCENT_PER_S = "speed_ramp_down_percent_per_s"
+CONF_SPEED_RAMP_MODE = "speed_ramp_mode"
 CONF_START_BOOST_PERCENT = "start_boost_percent"
 CONF_START_BOOST_HOLD_MS = "start_boost_hold_ms"
+CONF_SPEED_POLL_INTERVAL = "speed_poll_interval"
+CONF_INITIAL_TUNE = "initial_tune"
+CONF_TUNE_OPEN_LOOP_ACCEL_HZ_PER_S = "open_loop_accel_hz_per_s"
+CONF_TUNE_HANDOFF_PERCENT = "handoff_percent"
+CONF_TUNE_FINE_PASSES = "fine_passes"
+CONF_TUNE_EARLY_TERMINATION = "early_termination"
+TUNE_GRID_MAX_CODES = 6
 
 CONF_BRAKE = "brake"
 CONF_DIRECTION = "direction"
@@ -88,6 +103,9 @@ CONF_MOTOR_BEMF_CONSTANT = "motor_bemf_constant"
 CONF_SPEED_FDBK_HZ = "speed_fdbk_hz"
 CONF_SPEED_REF_OPEN_LOOP_HZ = "speed_ref_open_loop_hz"
 CONF_FG_SPEED_FDBK_HZ = "fg_speed_fdbk_hz"
+CONF_STATUS_POLL_TRANSACTIONS = "status_poll_transactions"
+CONF_SPEED_POLL_TRANSACTIONS = "speed_poll_transactions"
+CONF_SLOW_POLL_TRANSACTIONS = "slow_poll_transactions"
 
 BRAKE_MODE_OPTIONS = {
     "hiz": 0,
@@ -143,6 +161,11 @@ DIRECTION_MODE_OPTIONS = {
     "ccw": "ccw",
 }
 
+SPEED_RAMP_MODE_OPTIONS = {
+    "software": False,
+    "hardware": True,
+}
+
 CSA_GAIN_V_PER_V_TO_CODE = {
     5: 0,
     10: 1,
@@ -678,12 +701,13 @@ def encode_open_loop_limit_source(value):
 
 
 RUNTIME_SETTER_SPECS = (
-    (CONF_AUTO_TICKLE_WATCHDOG, "set_auto_tickle_watchdog", None),
     (CONF_CLEAR_MPET_ON_STARTUP, "set_clear_mpet_on_startup", None),
     (CONF_SPEED_RAMP_UP_PERCENT_PER_S, "set_speed_ramp_up_percent_per_s", None),
     (CONF_SPEED_RAMP_DOWN_PERCENT_PER_S, "set_speed_ramp_down_percent_per_s", None),
+    (CONF_SPEED_RAMP_MODE, "set_speed_ramp_hardware", None),
     (CONF_START_BOOST_PERCENT, "set_start_boost_percent", None),
     (CONF_START_BOOST_HOLD_MS, "set_start_boost_hold_ms", None),
+    (CONF_SPEED_POLL_INTERVAL, "set_speed_poll_interval_ms", lambda value: value.total_milliseconds),
 )
 
 REQUIRED_MOTOR_SETTER_SPECS = (
@@ -800,9 +824,15 @@ SENSOR_SETTER_SPECS = (
     (CONF_SPEED_FDBK_HZ, "set_speed_fdbk_hz_sensor"),
     (CONF_SPEED_REF_OPEN_LOOP_HZ, "set_speed_ref_open_loop_hz_sensor"),
     (CONF_FG_SPEED_FDBK_HZ, "set_fg_speed_fdbk_hz_sensor"),
+    (CONF_STATUS_POLL_TRANSACTIONS, "set_status_poll_transactions_sensor"),
+    (CONF_SPEED_POLL_TRANSACTIONS, "set_speed_poll_transactions_sensor"),
+    (CONF_SLOW_POLL_TRANSACTIONS, "set_slow_poll_transactions_sensor"),
 )
 
 
+TUNING_PREFERENCE_KEY = 0x8329A001
+
+
 def apply_codegen_setters(var, config, setter_specs, optional):
     for conf_key, setter_name, transform in setter_specs:
         if optional and conf_key not in config:
@@ -821,16 +851,49 @@ async def attach_optional_entities(var, config, entity_specs, factory):
         cg.add(getattr(var, setter_name)(entity))
 
 
+INITIAL_TUNE_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_TUNE_OPEN_LOOP_ACCEL_HZ_PER_S): cv.All(
+            cv.ensure_list(validate_open_loop_accel_hz_per_s),
+            cv.Length(min=1, max=TUNE_GRID_MAX_CODES),
+        ),
+        cv.Optional(CONF_TUNE_HANDOFF_PERCENT): cv.All(
+            cv.ensure_list(validate_open_to_closed_handoff_percent),
+            cv.Length(min=1, max=TUNE_GRID_MAX_CODES),
+        ),
+        cv.Optional(CONF_TUNE_FINE_PASSES, default=2): cv.int_range(min=0, max=4),
+        cv.Optional(CONF_TUNE_EARLY_TERMINATION, default=True): cv.boolean,
+    }
+)
+
+
+def validate_initial_tune_grid(config):
+    has_accel = CONF_TUNE_OPEN_LOOP_ACCEL_HZ_PER_S in config
+    has_handoff = CONF_TUNE_HANDOFF_PERCENT in config
+    if has_accel != has_handoff:
+        raise cv.Invalid(
+            f"{CONF_TUNE_OPEN_LOOP_ACCEL_HZ_PER_S} and {CONF_TUNE_HANDOFF_PERCENT} "
+            "must be set together to define the coarse tune grid"
+        )
+    return config
+
+
 CONFIG_SCHEMA = cv.All(
     cv.Schema(
         {
             cv.GenerateID(): cv.declare_id(MCF8329AComponent),
-            cv.Optional(CONF_AUTO_TICKLE_WATCHDOG, default=False): cv.boolean,
             cv.Optional(CONF_CLEAR_MPET_ON_STARTUP, default=True): cv.boolean,
             cv.Optional(CONF_SPEED_RAMP_UP_PERCENT_PER_S, default=0.0): cv.float_range(min=0.0),
             cv.Optional(CONF_SPEED_RAMP_DOWN_PERCENT_PER_S, default=0.0): cv.float_range(min=0.0),
+            cv.Optional(CONF_SPEED_RAMP_MODE, default="software"): cv.enum(
+                SPEED_RAMP_MODE_OPTIONS, lower=True
+            ),
             cv.Optional(CONF_START_BOOST_PERCENT, default=0.0): cv.float_range(min=0.0, max=100.0),
             cv.Optional(CONF_START_BOOST_HOLD_MS, default=0): cv.int_range(min=0),
+            cv.Optional(
+                CONF_SPEED_POLL_INTERVAL, default="0ms"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_INITIAL_TUNE): cv.All(INITIAL_TUNE_SCHEMA, validate_initial_tune_grid),
             cv.Optional(CONF_ALLOW_UNSAFE_CURRENT_LIMITS, default=False): cv.boolean,
             cv.Required(CONF_MOTOR_BEMF_CONST): cv.int_range(min=1, max=255),
             cv.Optional(CONF_MOTOR_RES_CODE): cv.int_range(min=1, max=255),
@@ -941,11 +1004,28 @@ CONFIG_SCHEMA = cv.All(
                 accuracy_decimals=1,
                 state_class=STATE_CLASS_MEASUREMENT,
             ),
+            cv.Optional(CONF_STATUS_POLL_TRANSACTIONS): sensor.sensor_schema(
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_TOTAL_INCREASING,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            ),
+            cv.Optional(CONF_SPEED_POLL_TRANSACTIONS): sensor.sensor_schema(
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_TOTAL_INCREASING,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            ),
+            cv.Optional(CONF_SLOW_POLL_TRANSACTIONS): sensor.sensor_schema(
+                accuracy_decimals=0,
+                state_class=STATE_CLASS_TOTAL_INCREASING,
+                entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+            ),
         }
     )
+    .extend(FAMILY_SCHEMA)
     .extend(cv.polling_component_schema("250ms"))
     .extend(i2c.i2c_device_schema(default_address=0x01)),
     validate_tuning_prerequisites,
+    validate_watchdog_tickle,
     validate_safety_guardrails,
 )
 
@@ -959,6 +1039,20 @@ async def to_code(config):
     apply_codegen_setters(var, config, REQUIRED_MOTOR_SETTER_SPECS, optional=False)
     apply_codegen_setters(var, config, OPTIONAL_MOTOR_SETTER_SPECS, optional=True)
 
+    if CONF_INITIAL_TUNE in config:
+        tune_config = config[CONF_INITIAL_TUNE]
+        for value in tune_config.get(CONF_TUNE_OPEN_LOOP_ACCEL_HZ_PER_S, []):
+            cg.add(var.add_tune_accel_code(OPEN_LOOP_ACCEL_HZ_PER_S_TO_CODE[value]))
+        for value in tune_config.get(CONF_TUNE_HANDOFF_PERCENT, []):
+            cg.add(var.add_tune_handoff_code(OPEN_TO_CLOSED_HANDOFF_PERCENT_TO_CODE[value]))
+        cg.add(var.set_tune_fine_passes(tune_config[CONF_TUNE_FINE_PASSES]))
+        cg.add(var.set_tune_early_termination(tune_config[CONF_TUNE_EARLY_TERMINATION]))
+
+    await register_family_config(var, config, TUNING_PREFERENCE_KEY)
+    # The initial_tune grid bounds what a stored startup result could have
+    # chosen, so its entries count towards the hash too.
+    cg.add(var.set_tuning_config_hash(tuning_config_hash(config, nested_keys=(CONF_INITIAL_TUNE,))))
+
     if CONF_BRAKE in config:
         sw = await switch_.new_switch(config[CONF_BRAKE])
         cg.add(sw.set_parent(var))
@@ -1,6 +1,5 @@
 #include "mcf8329a.h"
 
-#include "../mcf83xx_common/protocol.h"
 #include "mcf8329a_tables.h"
 #include "mcf8329a_tuning.h"
 
@@ -21,6 +20,38 @@ namespace tables = ::mcf8329a_core::tables;
 
 static const char* const TAG = "mcf8329a";
 static constexpr uint32_t FIXED_INTER_BYTE_DELAY_US = 100u;
+
+namespace {
+
+constexpr mcf83xx_facade::FaultName GATE_FAULT_NAMES[] = {
+  {GATE_FAULT_OTS, "DRV_OTS"},
+  {GATE_FAULT_OCP_VDS, "DRV_OCP_VDS"},
+  {GATE_FAULT_OCP_SNS, "DRV_OCP_SNS"},
+  {GATE_FAULT_BST_UV, "DRV_BST_UV"},
+  {GATE_FAULT_GVDD_UV, "DRV_GVDD_UV"},
+  {GATE_FAULT_DRV_OFF, "DRV_OFF"},
+};
+
+constexpr mcf83xx_facade::FaultName CONTROLLER_FAULT_NAMES[] = {
+  {FAULT_IPD_FREQ, "IPD_FREQ_FAULT"},
+  {FAULT_IPD_T1, "IPD_T1_FAULT"},
+  {FAULT_BUS_CURRENT_LIMIT, "BUS_CURRENT_LIMIT"},
+  {FAULT_MPET_BEMF, "MPET_BEMF_FAULT"},
+  {FAULT_ABN_SPEED, "ABN_SPEED"},
+  {FAULT_ABN_BEMF, "ABN_BEMF"},
+  {FAULT_NO_MTR, "NO_MTR"},
+  {FAULT_MTR_LCK, "MTR_LCK"},
+  {FAULT_LOCK_LIMIT, "LOCK_LIMIT"},
+  {FAULT_HW_LOCK_LIMIT, "HW_LOCK_LIMIT"},
+  {FAULT_DCBUS_UNDER_VOLTAGE, "DCBUS_UNDER_VOLTAGE"},
+  {FAULT_DCBUS_OVER_VOLTAGE, "DCBUS_OVER_VOLTAGE"},
+  {FAULT_SPEED_LOOP_SATURATION, "SPEED_LOOP_SATURATION"},
+  {FAULT_CURRENT_LOOP_SATURATION, "CURRENT_LOOP_SATURATION"},
+  {FAULT_WATCHDOG, "WATCHDOG_FAULT"},
+};
+
+}  // namespace
+
 MCF8329AComponent::MCF8329AComponent() : service_(this) {}
 
 MCF8329AComponent::~MCF8329AComponent() {
@@ -98,51 +129,42 @@ void MCF8329AComponent::start_mpet_characterization() {
 void MCF8329AComponent::setup() {
   ESP_LOGCONFIG(TAG, "Setting up mcf8329a");
   this->normal_operation_ready_ = false;
-  this->deferred_comms_last_retry_ms_ = 0u;
-  this->deferred_comms_last_scan_ms_ = 0u;
   this->algorithm_state_valid_ = false;
   this->algorithm_state_read_error_latched_ = false;
   this->last_algorithm_state_ = 0xFFFFu;
-  this->startup_profile_last_check_ms_ = 0u;
   this->startup_profile_last_recovery_ms_ = 0u;
-  this->speed_target_percent_ = 0.0f;
   this->speed_applied_percent_ = 0.0f;
-  this->speed_target_active_ = false;
-  this->start_boost_active_ = false;
-  this->start_boost_until_ms_ = 0u;
-  this->last_ramp_update_ms_ = 0u;
+  this->speed_ramp_.set_config(this->speed_ramp_config_);
+  this->speed_ramp_.cancel();
+  this->poll_.set_schedule(this->poll_schedule_);
+  this->poll_.set_register_enabled(RegisterId::MTR_PARAMS, this->motor_bemf_constant_sensor_ != nullptr);
+  // Only the reset check consumes CLOSED_LOOP3.
+  this->poll_.set_register_enabled(RegisterId::CLOSED_LOOP3, this->cfg_motor_bemf_const_set_);
   if (this->tuning_controller_ == nullptr) {
     this->tuning_controller_ = new MCF8329ATuningController(this);
   }
   this->tuning_controller_->reset();
+  this->tuning_store_.load();
 
-  if (!this->scan_i2c_bus_()) {
-    ESP_LOGW(TAG, "I2C scan failed; continuing with communication retries");
-    this->status_set_warning();
-  }
-  if (!this->establish_communications_(
-        STARTUP_COMMS_ATTEMPTS, STARTUP_COMMS_RETRY_DELAY_MS, true
-      )) {
-    ESP_LOGW(
-      TAG,
-      "Unable to establish communications with I2C device 0x%02X during setup; deferring normal "
-      "operation",
-      this->address_
-    );
-    this->status_set_warning();
+  // Bring-up runs from loop(); the first step here lets a responsive device
+  // be ready by the end of setup() without ever waiting on a silent one.
+  this->comms_.start(this->address_, millis());
+  this->process_comms_bringup_();
+}
+
+void MCF8329AComponent::loop() {
+  if (!this->normal_operation_ready_) {
+    this->process_comms_bringup_();
     return;
   }
-
-  this->status_clear_warning();
-  this->normal_operation_ready_ = true;
-  this->apply_post_comms_setup_();
+  this->watchdog_.service(this->service_, TAG, millis());
 }
 
 void MCF8329AComponent::update() {
   if (!this->normal_operation_ready_) {
-    this->process_deferred_startup_();
     return;
   }
+  this->watchdog_.service(this->service_, TAG, millis());
 
   const uint32_t now = millis();
   uint32_t gate_fault_status = 0;
@@ -152,28 +174,34 @@ void MCF8329AComponent::update() {
   bool fault_active = false;
   bool fault_state_valid = false;
 
-  const bool algo_ok = this->read_reg32(RegisterId::ALGO_STATUS, algo_status);
+  const bool speed_commanded = this->speed_applied_percent_ > 0.1f || this->speed_ramp_.active();
+  this->poll_.poll(this->service_, now, speed_commanded);
+  this->diagnostics_.begin(this->poll_);
+  this->require_diagnostics_(::mcf8329a_core::DIAGNOSTIC_ALGORITHM_STATE);
+
+  const bool algo_ok = this->diagnostics_.value(RegisterId::ALGO_STATUS, algo_status);
   if (algo_ok) {
     this->publish_algo_status_(algo_status);
-    this->log_algorithm_state_transition_(algo_status, "update");
+    this->log_algorithm_state_transition_("update");
   }
 
   this->recover_from_mcf_reset_if_needed_();
 
-  const bool gate_ok = this->read_reg32(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_fault_status);
+  const bool gate_ok = this->diagnostics_.value(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_fault_status);
   if (gate_ok) {
     fault_active |= (gate_fault_status & GATE_DRIVER_FAULT_ACTIVE_MASK) != 0;
     fault_state_valid = true;
   }
 
-  const bool controller_ok = this->read_reg32(RegisterId::CONTROLLER_FAULT_STATUS, controller_fault_status);
+  const bool controller_ok =
+    this->diagnostics_.value(RegisterId::CONTROLLER_FAULT_STATUS, controller_fault_status);
   if (controller_ok) {
     fault_active |= (controller_fault_status & CONTROLLER_FAULT_ACTIVE_MASK) != 0;
     fault_state_valid = true;
   }
 
   if (gate_ok || controller_ok) {
-    this->publish_faults_(gate_fault_status, gate_ok, controller_fault_status, controller_ok);
+    this->publish_faults_();
   }
 
   if (fault_state_valid) {
@@ -195,7 +223,7 @@ void MCF8329AComponent::update() {
 
   if (this->motor_bemf_constant_sensor_ != nullptr) {
     uint32_t mtr_params = 0;
-    if (this->read_reg32(RegisterId::MTR_PARAMS, mtr_params)) {
+    if (this->poll_.fresh(RegisterId::MTR_PARAMS, mtr_params)) {
       const uint32_t motor_bemf_const =
         (mtr_params & MTR_PARAMS_MOTOR_BEMF_CONST_MASK) >> MTR_PARAMS_MOTOR_BEMF_CONST_SHIFT;
       this->motor_bemf_constant_sensor_->publish_state(static_cast<float>(motor_bemf_const));
@@ -203,14 +231,12 @@ void MCF8329AComponent::update() {
   }
 
   const bool speed_diag_due =
-    (now - this->last_speed_diag_log_ms_ >= 500U) &&
-    (this->speed_applied_percent_ > 0.1f || this->speed_target_active_);
-  if (this->speed_fdbk_hz_sensor_ != nullptr || this->speed_ref_open_loop_hz_sensor_ != nullptr ||
-      this->fg_speed_fdbk_hz_sensor_ != nullptr || speed_diag_due) {
+    (now - this->last_speed_diag_log_ms_ >= 500U) && speed_commanded;
+  if (this->poll_.polled(::mcf8329a_core::PollTier::SPEED)) {
     uint32_t closed_loop4 = 0;
     float max_speed_hz =
       this->cfg_max_speed_set_ ? this->service_.decode_max_speed_hz(this->cfg_max_speed_code_) : 0.0f;
-    if (this->read_reg32(RegisterId::CLOSED_LOOP4, closed_loop4)) {
+    if (this->poll_.cached(RegisterId::CLOSED_LOOP4, closed_loop4)) {
       const uint16_t max_speed_code = static_cast<uint16_t>(
         (closed_loop4 & CLOSED_LOOP4_MAX_SPEED_MASK) >> CLOSED_LOOP4_MAX_SPEED_SHIFT
       );
@@ -228,19 +254,19 @@ void MCF8329AComponent::update() {
       bool speed_ref_open_loop_ok = false;
       bool fg_speed_fdbk_ok = false;
 
-      if (this->read_reg32(RegisterId::SPEED_FDBK, raw_speed_fdbk)) {
+      if (this->poll_.fresh(RegisterId::SPEED_FDBK, raw_speed_fdbk)) {
         speed_fdbk_hz =
           this->service_.decode_speed_hz(static_cast<int32_t>(raw_speed_fdbk), max_speed_hz);
         speed_fdbk_ok = true;
       }
 
-      if (this->read_reg32(RegisterId::SPEED_REF_OPEN_LOOP, raw_speed_ref_open_loop)) {
+      if (this->poll_.fresh(RegisterId::SPEED_REF_OPEN_LOOP, raw_speed_ref_open_loop)) {
         speed_ref_open_loop_hz =
           this->service_.decode_speed_hz(static_cast<int32_t>(raw_speed_ref_open_loop), max_speed_hz);
         speed_ref_open_loop_ok = true;
       }
 
-      if (this->read_reg32(RegisterId::FG_SPEED_FDBK, raw_fg_speed_fdbk)) {
+      if (this->poll_.fresh(RegisterId::FG_SPEED_FDBK, raw_fg_speed_fdbk)) {
         fg_speed_fdbk_hz = this->service_.decode_fg_speed_hz(raw_fg_speed_fdbk, max_speed_hz);
         fg_speed_fdbk_ok = true;
       }
@@ -275,7 +301,7 @@ void MCF8329AComponent::update() {
     }
   }
 
-  if (this->read_reg32(RegisterId::VM_VOLTAGE, vm_voltage_raw)) {
+  if (this->poll_.fresh(RegisterId::VM_VOLTAGE, vm_voltage_raw)) {
     const float vm_voltage = this->service_.decode_vm_voltage(vm_voltage_raw);
     if (this->vm_voltage_sensor_ != nullptr) {
       this->vm_voltage_sensor_->publish_state(vm_voltage);
@@ -286,8 +312,25 @@ void MCF8329AComponent::update() {
     }
   }
 
-  if (this->auto_tickle_watchdog_ && (now - this->last_watchdog_tickle_ms_ >= 500U)) {
-    this->pulse_watchdog_tickle();
+  if (this->poll_.polled(::mcf8329a_core::PollTier::SLOW)) {
+    this->publish_poll_stats_();
+    this->watchdog_.publish_stats();
+  }
+  this->diagnostics_.end();
+}
+
+void MCF8329AComponent::publish_poll_stats_() {
+  using ::mcf8329a_core::PollTier;
+  static constexpr PollTier TIERS[] = {PollTier::STATUS, PollTier::SPEED, PollTier::SLOW};
+  sensor::Sensor* const sensors[] = {
+    this->status_poll_transactions_sensor_,
+    this->speed_poll_transactions_sensor_,
+    this->slow_poll_transactions_sensor_,
+  };
+  for (size_t i = 0; i < sizeof(TIERS) / sizeof(TIERS[0]); i++) {
+    if (sensors[i] != nullptr) {
+      sensors[i]->publish_state(static_cast<float>(this->poll_.stats(TIERS[i]).transactions));
+    }
   }
 }
 
@@ -307,7 +350,16 @@ void MCF8329AComponent::dump_config() {
     TAG,
     "  MCx83xx I2C requirement: >=100us byte gap. Use i2c.frequency <=50kHz and verify comms."
   );
-  ESP_LOGCONFIG(TAG, "  Auto tickle watchdog: %s", YESNO(this->auto_tickle_watchdog_));
+  this->watchdog_.dump_config(TAG);
+  ESP_LOGCONFIG(
+    TAG, "  Speed ramp: %s", this->speed_ramp_config_.hardware ? "hardware (CLOSED_LOOP1)" : "software"
+  );
+  ESP_LOGCONFIG(
+    TAG,
+    "  Poll schedule: status every update, speed every %ums while running, slow every %ums",
+    static_cast<unsigned>(this->poll_schedule_.speed_interval_ms),
+    static_cast<unsigned>(this->poll_schedule_.slow_interval_ms)
+  );
   ESP_LOGCONFIG(TAG, "  Clear MPET bits on startup: %s", YESNO(this->clear_mpet_on_startup_));
   ESP_LOGCONFIG(
     TAG, "  MPET timeout override: %us", static_cast<unsigned>(this->mpet_timeout_ms_ / 1000u)
@@ -697,184 +749,28 @@ void MCF8329AComponent::dump_config() {
   ESP_LOGCONFIG(
     TAG,
     "  Speed command shaping: ramp_up=%.2f%%/s ramp_down=%.2f%%/s boost=%.1f%% hold=%ums",
-    this->speed_ramp_up_percent_per_s_,
-    this->speed_ramp_down_percent_per_s_,
-    this->start_boost_percent_,
-    static_cast<unsigned>(this->start_boost_hold_ms_)
-  );
-  ESP_LOGCONFIG(
-    TAG,
-    "  Motor config comm gate: scan 0x%02X..0x%02X, attempts=%u, retry=%ums, deferred_retry=%ums",
-    static_cast<unsigned>(I2C_SCAN_ADDRESS_MIN),
-    static_cast<unsigned>(I2C_SCAN_ADDRESS_MAX),
-    static_cast<unsigned>(STARTUP_COMMS_ATTEMPTS),
-    static_cast<unsigned>(STARTUP_COMMS_RETRY_DELAY_MS),
-    static_cast<unsigned>(DEFERRED_COMMS_RETRY_INTERVAL_MS)
+    this->speed_ramp_config_.up_percent_per_s,
+    this->speed_ramp_config_.down_percent_per_s,
+    this->speed_ramp_config_.start_boost_percent,
+    static_cast<unsigned>(this->speed_ramp_config_.start_boost_hold_ms)
   );
+  this->comms_.dump_config(TAG);
 }
 
-const char* MCF8329AComponent::i2c_error_to_string_(i2c::ErrorCode error_code) const {
-  switch (error_code) {
-    case i2c::ERROR_OK:
-      return "ok";
-    case i2c::ERROR_INVALID_ARGUMENT:
-      return "invalid_argument";
-    case i2c::ERROR_NOT_ACKNOWLEDGED:
-      return "not_acknowledged";
-    case i2c::ERROR_TIMEOUT:
-      return "timeout";
-    case i2c::ERROR_NOT_INITIALIZED:
-      return "not_initialized";
-    case i2c::ERROR_TOO_LARGE:
-      return "too_large";
-    case i2c::ERROR_UNKNOWN:
-      return "unknown";
-    case i2c::ERROR_CRC:
-      return "crc";
-    default:
-      return "other";
-  }
-}
-
-bool MCF8329AComponent::probe_device_ack_(i2c::ErrorCode& error_code) const {
-  if (this->bus_ == nullptr) {
-    error_code = i2c::ERROR_NOT_INITIALIZED;
-    return false;
-  }
-
-  error_code = this->bus_->write_readv(this->address_, nullptr, 0, nullptr, 0);
-  return error_code == i2c::ERROR_OK;
-}
-
-bool MCF8329AComponent::scan_i2c_bus_() {
-  if (this->bus_ == nullptr) {
-    ESP_LOGW(TAG, "I2C scan skipped: bus is not initialized");
-    return false;
-  }
-
-  std::string discovered;
-  uint8_t device_count = 0;
-  bool target_found = false;
-  for (uint8_t address = I2C_SCAN_ADDRESS_MIN; address <= I2C_SCAN_ADDRESS_MAX; address++) {
-    const i2c::ErrorCode err = this->bus_->write_readv(address, nullptr, 0, nullptr, 0);
-    if (err == i2c::ERROR_OK) {
-      char addr_text[8];
-      std::snprintf(addr_text, sizeof(addr_text), "0x%02X", address);
-      if (!discovered.empty()) {
-        discovered += ", ";
-      }
-      discovered += addr_text;
-      device_count++;
-      if (address == this->address_) {
-        target_found = true;
-      }
-    }
-    arch_feed_wdt();
-  }
-
-  if (device_count == 0u) {
-    ESP_LOGW(
-      TAG,
-      "I2C scan found no ACKing devices in range 0x%02X..0x%02X",
-      static_cast<unsigned>(I2C_SCAN_ADDRESS_MIN),
-      static_cast<unsigned>(I2C_SCAN_ADDRESS_MAX)
-    );
-  } else {
-    ESP_LOGI(
-      TAG,
-      "I2C scan found %u device(s): %s",
-      static_cast<unsigned>(device_count),
-      discovered.c_str()
-    );
-  }
-
-  if (target_found) {
-    ESP_LOGI(TAG, "I2C target 0x%02X was found during scan", this->address_);
-  } else {
-    ESP_LOGW(TAG, "I2C target 0x%02X was not found during scan", this->address_);
-  }
-
-  return device_count > 0u;
-}
-
-bool MCF8329AComponent::establish_communications_(
-  uint8_t attempts, uint32_t retry_delay_ms, bool log_retry_delays
-) {
-  if (attempts == 0u) {
-    return false;
-  }
-
-  for (uint8_t attempt = 1u; attempt <= attempts; attempt++) {
-    i2c::ErrorCode ack_error = i2c::ERROR_UNKNOWN;
-    if (!this->probe_device_ack_(ack_error)) {
-      ESP_LOGW(
-        TAG,
-        "Comms attempt %u/%u: address 0x%02X probe failed: %s (%d)",
-        static_cast<unsigned>(attempt),
-        static_cast<unsigned>(attempts),
-        this->address_,
-        this->i2c_error_to_string_(ack_error),
-        static_cast<int>(ack_error)
-      );
-    } else if (this->read_probe_and_publish_()) {
-      ESP_LOGI(
-        TAG,
-        "I2C communications established with 0x%02X (attempt %u/%u)",
-        this->address_,
-        static_cast<unsigned>(attempt),
-        static_cast<unsigned>(attempts)
-      );
-      return true;
-    } else {
-      ESP_LOGW(
-        TAG,
-        "Comms attempt %u/%u: address 0x%02X ACKed but register probe failed",
-        static_cast<unsigned>(attempt),
-        static_cast<unsigned>(attempts),
-        this->address_
-      );
-    }
-
-    if (attempt < attempts && retry_delay_ms > 0u) {
-      if (log_retry_delays) {
-        ESP_LOGW(TAG, "Retrying communications in %ums", static_cast<unsigned>(retry_delay_ms));
-      }
-      delay(retry_delay_ms);
-    }
-  }
-
-  return false;
-}
-
-void MCF8329AComponent::process_deferred_startup_() {
-  const uint32_t now = millis();
-  const bool should_scan = this->deferred_comms_last_scan_ms_ == 0u ||
-                           (now - this->deferred_comms_last_scan_ms_) >= DEFERRED_SCAN_INTERVAL_MS;
-  if (should_scan) {
-    if (!this->scan_i2c_bus_()) {
-      ESP_LOGW(TAG, "Deferred I2C scan failed; keeping deferred retry mode");
-      this->status_set_warning();
-    }
-    this->deferred_comms_last_scan_ms_ = now;
-  }
+bool MCF8329AComponent::ack_address(uint8_t address) { return this->comms_.ack(this->bus_, address); }
 
-  if (this->deferred_comms_last_retry_ms_ != 0u && (now - this->deferred_comms_last_retry_ms_) < DEFERRED_COMMS_RETRY_INTERVAL_MS) {
-    return;
-  }
-  this->deferred_comms_last_retry_ms_ = now;
+bool MCF8329AComponent::probe_target() { return this->read_probe_and_publish_(); }
 
-  if (!this->establish_communications_(1u, 0u, false)) {
-    this->status_set_warning();
-    return;
+void MCF8329AComponent::process_comms_bringup_() {
+  if (this->comms_.step(*this, *this, TAG, millis())) {
+    this->normal_operation_ready_ = true;
+    this->apply_post_comms_setup_();
   }
-
-  ESP_LOGI(TAG, "I2C communications recovered; entering normal operation");
-  this->status_clear_warning();
-  this->normal_operation_ready_ = true;
-  this->apply_post_comms_setup_();
 }
 
 void MCF8329AComponent::apply_post_comms_setup_() {
+  this->poll_.reset();
+  this->watchdog_.start(millis());
   if (this->tuning_controller_ != nullptr) {
     this->tuning_controller_->reset();
   }
@@ -917,6 +813,8 @@ void MCF8329AComponent::apply_post_comms_setup_() {
       this->pulse_clear_faults();
     }
   }
+
+  this->tuning_store_.warm_start(this->service_, TAG);
 }
 
 void MCF8329AComponent::recover_from_mcf_reset_if_needed_() {
@@ -924,17 +822,12 @@ void MCF8329AComponent::recover_from_mcf_reset_if_needed_() {
     return;
   }
 
-  const uint32_t now = millis();
-  if (this->startup_profile_last_check_ms_ != 0u &&
-      (now - this->startup_profile_last_check_ms_) < STARTUP_PROFILE_CHECK_INTERVAL_MS) {
-    return;
-  }
-  this->startup_profile_last_check_ms_ = now;
-
+  // Runs at the slow poll interval on the values that tier just read, so
+  // the check costs no transactions of its own.
   uint32_t closed_loop3 = 0;
   uint32_t closed_loop4 = 0;
-  if (!this->read_reg32(RegisterId::CLOSED_LOOP3, closed_loop3) ||
-      !this->read_reg32(RegisterId::CLOSED_LOOP4, closed_loop4)) {
+  if (!this->poll_.fresh(RegisterId::CLOSED_LOOP3, closed_loop3) ||
+      !this->poll_.fresh(RegisterId::CLOSED_LOOP4, closed_loop4)) {
     return;
   }
 
@@ -951,6 +844,7 @@ void MCF8329AComponent::recover_from_mcf_reset_if_needed_() {
     return;
   }
 
+  const uint32_t now = millis();
   if (this->startup_profile_last_recovery_ms_ != 0u &&
       (now - this->startup_profile_last_recovery_ms_) < STARTUP_PROFILE_RECOVERY_COOLDOWN_MS) {
     return;
@@ -1388,6 +1282,30 @@ bool MCF8329AComponent::apply_motor_config_() {
     ESP_LOGI(TAG, "CLOSED_LOOP4 motor cfg: 0x%08X -> 0x%08X", closed_loop4, closed_loop4_next);
   }
 
+  if (this->speed_ramp_config_.hardware) {
+    // CL_ACC/CL_DEC are Hz/s in speed mode; ramp rates are percent of MAX_SPEED per second.
+    // MAX_SPEED comes from the CLOSED_LOOP4 value just applied, so the
+    // device's own value is used when max_speed_hz is not configured.
+    const auto codes = ::mcf8329a_core::closed_loop_ramp_codes(
+      closed_loop4_next, this->speed_ramp_config_.up_percent_per_s, this->speed_ramp_config_.down_percent_per_s
+    );
+    const uint8_t acc_code = codes.acc;
+    const uint8_t dec_code = codes.dec;
+    if (this->service_.set_closed_loop_ramp(acc_code, dec_code)) {
+      ESP_LOGI(
+        TAG,
+        "CLOSED_LOOP1 hardware ramp: CL_ACC=%u (%.1fHz/s) CL_DEC=%u (%.1fHz/s), 0=no limit",
+        static_cast<unsigned>(acc_code),
+        ::mcf8329a_core::decode_closed_loop_rate_hz_per_s(acc_code),
+        static_cast<unsigned>(dec_code),
+        ::mcf8329a_core::decode_closed_loop_rate_hz_per_s(dec_code)
+      );
+    } else {
+      ESP_LOGW(TAG, "Failed to program CLOSED_LOOP1 hardware ramp");
+      ok = false;
+    }
+  }
+
   uint32_t gd_config1_effective = gd_config1_next;
   uint32_t gd_config2_effective = gd_config2_next;
   if (!this->read_reg32(RegisterId::GD_CONFIG1, gd_config1_effective)) {
@@ -1649,59 +1567,25 @@ bool MCF8329AComponent::read_reg16(RegisterId id, uint16_t& value) {
 }
 
 bool MCF8329AComponent::write_reg32(RegisterId id, uint32_t value) {
+  this->poll_.invalidate(id);
   return this->service_.write_reg32(id, value);
 }
 
 bool MCF8329AComponent::update_bits32(RegisterId id, uint32_t mask, uint32_t value) {
+  this->poll_.invalidate(id);
   return this->service_.update_bits32(id, mask, value);
 }
 
 bool MCF8329AComponent::read_register32(uint16_t offset, uint32_t *value) {
-  if (value == nullptr || this->bus_ == nullptr) {
-    return false;
-  }
-  const auto command = ::mcf83xx_common::make_control_frame(
-      true, offset, ::mcf83xx_common::RegisterWidth::BITS_32);
-  uint8_t rx[4] = {0, 0, 0, 0};
-  const i2c::ErrorCode err = this->write_read(command.data(), command.size(), rx, sizeof(rx));
-  if (err != i2c::ERROR_OK) {
-    ESP_LOGW(TAG, "read_reg32(0x%04X) failed: i2c error %d", offset, static_cast<int>(err));
-    return false;
-  }
-  *value = ::mcf83xx_common::decode_read32(rx);
-  return true;
+  return mcf83xx_facade::read_register32(this->bus_, this->address_, TAG, offset, value);
 }
 
 bool MCF8329AComponent::read_register16(uint16_t offset, uint16_t *value) {
-  if (value == nullptr || this->bus_ == nullptr) {
-    return false;
-  }
-  const auto command = ::mcf83xx_common::make_control_frame(
-      true, offset, ::mcf83xx_common::RegisterWidth::BITS_16);
-  uint8_t rx[2] = {0, 0};
-  const i2c::ErrorCode err = this->write_read(command.data(), command.size(), rx, sizeof(rx));
-  if (err != i2c::ERROR_OK) {
-    ESP_LOGW(TAG, "read_reg16(0x%04X) failed: i2c error %d", offset, static_cast<int>(err));
-    return false;
-  }
-  *value = ::mcf83xx_common::decode_read16(rx);
-  return true;
+  return mcf83xx_facade::read_register16(this->bus_, this->address_, TAG, offset, value);
 }
 
 bool MCF8329AComponent::write_register32(uint16_t offset, uint32_t value) {
-  if (this->bus_ == nullptr) {
-    return false;
-  }
-
-  const auto frame = ::mcf83xx_common::make_write32_frame(offset, value);
-  const i2c::ErrorCode err = this->write(frame.data(), frame.size());
-  if (err != i2c::ERROR_OK) {
-    ESP_LOGW(
-      TAG, "write_reg32(0x%04X, 0x%08X) failed: i2c error %d", offset, value, static_cast<int>(err)
-    );
-    return false;
-  }
-  return true;
+  return mcf83xx_facade::write_register32(this->bus_, this->address_, TAG, offset, value);
 }
 
 void MCF8329AComponent::delay_microseconds(uint32_t delay_us) {
@@ -1753,15 +1637,10 @@ bool MCF8329AComponent::set_direction_mode(const std::string& direction_mode) {
 }
 
 bool MCF8329AComponent::apply_speed_command_(float speed_percent, const char* reason, bool publish_number) {
-  float clamped = speed_percent;
-  if (std::isnan(clamped)) {
+  if (std::isnan(speed_percent)) {
     return false;
   }
-  if (clamped < 0.0f) {
-    clamped = 0.0f;
-  } else if (clamped > 100.0f) {
-    clamped = 100.0f;
-  }
+  const float clamped = ::mcf83xx_common::clamp_speed_percent(speed_percent);
 
   if (clamped > 0.0f && this->severe_fault_speed_lockout_) {
     ESP_LOGE(
@@ -1772,7 +1651,7 @@ bool MCF8329AComponent::apply_speed_command_(float speed_percent, const char* re
     return false;
   }
 
-  const uint16_t digital_speed_ctrl = static_cast<uint16_t>(lroundf((clamped / 100.0f) * 32767.0f));
+  const uint16_t digital_speed_ctrl = ::mcf83xx_common::speed_percent_to_code(clamped);
 
   if (clamped > 0.0f && this->clear_mpet_on_startup_) {
     (void)this->clear_mpet_bits_("speed_cmd");
@@ -1812,75 +1691,28 @@ bool MCF8329AComponent::apply_speed_command_(float speed_percent, const char* re
 }
 
 void MCF8329AComponent::process_speed_command_ramp_() {
-  if (!this->speed_target_active_) {
+  if (!this->speed_ramp_.active()) {
     return;
   }
   if (this->severe_fault_speed_lockout_) {
-    this->speed_target_active_ = false;
-    this->start_boost_active_ = false;
-    this->start_boost_until_ms_ = 0u;
-    this->last_ramp_update_ms_ = 0u;
+    this->speed_ramp_.cancel();
     return;
   }
 
-  const uint32_t now = millis();
-  if (this->last_ramp_update_ms_ == 0u) {
-    this->last_ramp_update_ms_ = now;
-  }
-  float dt = static_cast<float>(now - this->last_ramp_update_ms_) / 1000.0f;
-  if (dt < 0.0f) {
-    dt = 0.0f;
-  }
-  if (dt == 0.0f && std::fabs(this->speed_target_percent_ - this->speed_applied_percent_) > 0.0f) {
-    dt = 0.01f;
-  }
-  this->last_ramp_update_ms_ = now;
-
-  float desired = this->speed_target_percent_;
-  if (this->start_boost_active_) {
-    if (this->start_boost_hold_ms_ == 0u || now >= this->start_boost_until_ms_) {
-      this->start_boost_active_ = false;
-    } else {
-      desired = std::max(desired, this->start_boost_percent_);
-    }
-  }
-
-  float next = this->speed_applied_percent_;
-  if (desired > this->speed_applied_percent_) {
-    if (this->speed_ramp_up_percent_per_s_ <= 0.0f) {
-      next = desired;
-    } else {
-      next = std::min(desired, this->speed_applied_percent_ + (this->speed_ramp_up_percent_per_s_ * dt));
-    }
-  } else if (desired < this->speed_applied_percent_) {
-    if (this->speed_ramp_down_percent_per_s_ <= 0.0f) {
-      next = desired;
-    } else {
-      next = std::max(desired, this->speed_applied_percent_ - (this->speed_ramp_down_percent_per_s_ * dt));
-    }
-  }
-
-  if (std::fabs(next - this->speed_applied_percent_) > 0.001f) {
+  // In hardware ramp mode CLOSED_LOOP1 slews the reference, so only the
+  // start boost is timed here and each change is a single write.
+  float next = 0.0f;
+  if (this->speed_ramp_.step(this->speed_applied_percent_, millis(), next)) {
     (void)this->apply_speed_command_(next, "ramp_step", false);
   }
-
-  if (!this->start_boost_active_ && std::fabs(this->speed_target_percent_ - this->speed_applied_percent_) <= 0.05f) {
-    this->speed_target_active_ = false;
-    this->last_ramp_update_ms_ = 0u;
-  }
+  this->speed_ramp_.settle(this->speed_applied_percent_);
 }
 
 bool MCF8329AComponent::set_speed_percent(float speed_percent, const char* reason) {
   if (std::isnan(speed_percent)) {
     return false;
   }
-
-  float clamped = speed_percent;
-  if (clamped < 0.0f) {
-    clamped = 0.0f;
-  } else if (clamped > 100.0f) {
-    clamped = 100.0f;
-  }
+  const float clamped = ::mcf83xx_common::clamp_speed_percent(speed_percent);
 
   if (clamped > 0.0f && this->severe_fault_speed_lockout_) {
     ESP_LOGE(
@@ -1891,40 +1723,9 @@ bool MCF8329AComponent::set_speed_percent(float speed_percent, const char* reaso
     return false;
   }
 
-  if (clamped == 0.0f) {
-    this->speed_target_percent_ = 0.0f;
-    this->speed_target_active_ = false;
-    this->start_boost_active_ = false;
-    this->start_boost_until_ms_ = 0u;
-    this->last_ramp_update_ms_ = 0u;
-    return this->apply_speed_command_(0.0f, reason, true);
-  }
-
-  const bool ramp_enabled =
-    this->speed_ramp_up_percent_per_s_ > 0.0f || this->speed_ramp_down_percent_per_s_ > 0.0f;
-  const bool start_boost_enabled =
-    this->start_boost_percent_ > clamped && this->start_boost_hold_ms_ > 0u &&
-    this->speed_applied_percent_ <= 0.05f;
-
-  if (!ramp_enabled && !start_boost_enabled) {
-    this->speed_target_active_ = false;
-    this->start_boost_active_ = false;
-    this->start_boost_until_ms_ = 0u;
-    this->last_ramp_update_ms_ = 0u;
+  if (!this->speed_ramp_.start(clamped, this->speed_applied_percent_, millis())) {
     return this->apply_speed_command_(clamped, reason, true);
   }
-
-  this->speed_target_percent_ = clamped;
-  this->speed_target_active_ = true;
-  if (start_boost_enabled) {
-    this->start_boost_active_ = true;
-    this->start_boost_until_ms_ = millis() + this->start_boost_hold_ms_;
-  } else {
-    this->start_boost_active_ = false;
-    this->start_boost_until_ms_ = 0u;
-  }
-
-  this->last_ramp_update_ms_ = millis();
   this->process_speed_command_ramp_();
 
   if (this->speed_number_ != nullptr) {
@@ -1940,19 +1741,25 @@ void MCF8329AComponent::pulse_clear_faults() {
   uint32_t ctrl_before = 0;
   uint32_t gate_after = 0;
   uint32_t ctrl_after = 0;
-  const bool gate_before_ok = this->read_reg32(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_before);
-  const bool ctrl_before_ok = this->read_reg32(RegisterId::CONTROLLER_FAULT_STATUS, ctrl_before);
+  this->diagnostics_.begin();
+  this->diagnostics_.require(this->service_, ::mcf8329a_core::DIAGNOSTIC_STATUS);
+  const bool gate_before_ok = this->diagnostics_.value(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_before);
+  const bool ctrl_before_ok = this->diagnostics_.value(RegisterId::CONTROLLER_FAULT_STATUS, ctrl_before);
 
   // MPET_BEMF fault condition can remain true while MPET bits are set.
   (void)this->clear_mpet_bits_("clear_faults");
 
   if (!this->service_.pulse_clear_faults()) {
     ESP_LOGW(TAG, "Failed to pulse CLR_FLT");
+    this->diagnostics_.end();
     return;
   }
 
-  const bool gate_after_ok = this->read_reg32(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_after);
-  const bool ctrl_after_ok = this->read_reg32(RegisterId::CONTROLLER_FAULT_STATUS, ctrl_after);
+  // CLR_FLT changes the status registers, so the rest is a new snapshot.
+  this->diagnostics_.begin();
+  this->require_diagnostics_(0);
+  const bool gate_after_ok = this->diagnostics_.value(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_after);
+  const bool ctrl_after_ok = this->diagnostics_.value(RegisterId::CONTROLLER_FAULT_STATUS, ctrl_after);
 
   if (gate_before_ok || ctrl_before_ok || gate_after_ok || ctrl_after_ok) {
     ESP_LOGI(
@@ -1966,7 +1773,7 @@ void MCF8329AComponent::pulse_clear_faults() {
   }
 
   if (gate_after_ok || ctrl_after_ok) {
-    this->publish_faults_(gate_after, gate_after_ok, ctrl_after, ctrl_after_ok);
+    this->publish_faults_();
     bool fault_active = false;
     if (gate_after_ok) {
       fault_active |= (gate_after & GATE_DRIVER_FAULT_ACTIVE_MASK) != 0;
@@ -1983,15 +1790,10 @@ void MCF8329AComponent::pulse_clear_faults() {
       ESP_LOGI(TAG, "Safety lockout cleared after faults were cleared");
     }
   }
+  this->diagnostics_.end();
 }
 
-void MCF8329AComponent::pulse_watchdog_tickle() {
-  ESP_LOGD(TAG, "Pulsing watchdog tickle");
-  if (!this->service_.pulse_watchdog_tickle()) {
-    ESP_LOGW(TAG, "Failed to pulse watchdog tickle");
-  }
-  this->last_watchdog_tickle_ms_ = millis();
-}
+void MCF8329AComponent::pulse_watchdog_tickle() { this->watchdog_.pulse(this->service_, TAG, millis()); }
 
 bool MCF8329AComponent::read_probe_and_publish_() {
   uint32_t gate_fault_status = 0;
@@ -2001,9 +1803,12 @@ bool MCF8329AComponent::read_probe_and_publish_() {
   bool fault_state_valid = false;
   bool ok = true;
 
-  const bool gate_ok = this->read_reg32(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_fault_status);
-  const bool algo_ok = this->read_reg32(RegisterId::ALGO_STATUS, algo_status);
-  const bool controller_ok = this->read_reg32(RegisterId::CONTROLLER_FAULT_STATUS, controller_fault_status);
+  this->diagnostics_.begin();
+  this->require_diagnostics_(::mcf8329a_core::DIAGNOSTIC_ALGORITHM_STATE);
+  const bool gate_ok = this->diagnostics_.value(RegisterId::GATE_DRIVER_FAULT_STATUS, gate_fault_status);
+  const bool algo_ok = this->diagnostics_.value(RegisterId::ALGO_STATUS, algo_status);
+  const bool controller_ok =
+    this->diagnostics_.value(RegisterId::CONTROLLER_FAULT_STATUS, controller_fault_status);
   ok &= algo_ok;
   ok &= gate_ok;
   ok &= controller_ok;
@@ -2019,14 +1824,15 @@ bool MCF8329AComponent::read_probe_and_publish_() {
 
   if (algo_ok) {
     this->publish_algo_status_(algo_status);
-    this->log_algorithm_state_transition_(algo_status, "probe");
+    this->log_algorithm_state_transition_("probe");
   }
   if (gate_ok || controller_ok) {
-    this->publish_faults_(gate_fault_status, gate_ok, controller_fault_status, controller_ok);
+    this->publish_faults_();
   }
   if (fault_state_valid && this->fault_active_binary_sensor_ != nullptr) {
     this->fault_active_binary_sensor_->publish_state(fault_active);
   }
+  this->diagnostics_.end();
 
   return ok;
 }
@@ -2050,89 +1856,59 @@ bool MCF8329AComponent::clear_mpet_bits_(const char* context) {
   return true;
 }
 
-void MCF8329AComponent::publish_faults_(
-  uint32_t gate_fault_status,
-  bool gate_fault_valid,
-  uint32_t controller_fault_status,
-  bool controller_fault_valid
-) {
-  std::vector<std::string> faults;
-  bool gate_detail_found = false;
-  bool controller_detail_found = false;
-  const bool mpet_bemf_active =
-    controller_fault_valid && ((controller_fault_status & FAULT_MPET_BEMF) != 0u);
-  const bool hw_lock_active =
-    controller_fault_valid && ((controller_fault_status & FAULT_HW_LOCK_LIMIT) != 0u);
-
-  if (gate_fault_valid) {
-    if (gate_fault_status & GATE_FAULT_OTS)
-      faults.emplace_back("DRV_OTS"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_OCP_VDS)
-      faults.emplace_back("DRV_OCP_VDS"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_OCP_SNS)
-      faults.emplace_back("DRV_OCP_SNS"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_BST_UV)
-      faults.emplace_back("DRV_BST_UV"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_GVDD_UV)
-      faults.emplace_back("DRV_GVDD_UV"), gate_detail_found = true;
-    if (gate_fault_status & GATE_FAULT_DRV_OFF)
-      faults.emplace_back("DRV_OFF"), gate_detail_found = true;
-    if ((gate_fault_status & GATE_DRIVER_FAULT_ACTIVE_MASK) != 0 && !gate_detail_found) {
-      faults.emplace_back("DRV_FAULT_ACTIVE");
-    }
+void MCF8329AComponent::require_diagnostics_(::mcf8329a_core::DiagnosticGroups groups) {
+  using namespace ::mcf8329a_core;
+  // Status comes from the poll in update(); the fault groups depend on it.
+  this->diagnostics_.require(this->service_, DIAGNOSTIC_STATUS);
+  const DiagnosticFields& fields = this->diagnostics_.fields();
+  if (!fields.algo_status_valid) {
+    groups &= static_cast<DiagnosticGroups>(~DIAGNOSTIC_ALGORITHM_STATE);
   }
+  if (fields.mpet_bemf_active && !this->mpet_bemf_fault_latched_) {
+    groups |= DIAGNOSTIC_MPET_BEMF;
+  }
+  if (fields.hw_lock_active && !this->hw_lock_fault_latched_) {
+    groups |= DIAGNOSTIC_HW_LOCK;
+  }
+  this->diagnostics_.require(this->service_, groups);
+}
 
-  if (controller_fault_valid) {
-    if (controller_fault_status & FAULT_IPD_FREQ)
-      faults.emplace_back("IPD_FREQ_FAULT"), controller_detail_found = true;
-    if (controller_fault_status & FAULT_IPD_T1)
-      faults.emplace_back("IPD_T1_FAULT"), controller_detail_found = true;
-    if (controller_fault_status & FAULT_BUS_CURRENT_LIMIT)
-      faults.emplace_back("BUS_CURRENT_LIMIT"), controller_detail_found = true;
-    if (controller_fault_status & FAULT_MPET_BEMF)
-      faults.emplace_back("MPET_BEMF_FAULT"), controller_detail_found = true;
-    if (controller_fault_status & FAULT_ABN_SPEED)
-      faults.emplace_back("ABN_SPEED"), controller_detail_found = true;
-    if (controller_fault_status & FAULT_ABN_BEMF)
-      faults.emplace_back("ABN_BEMF"), controller_detail_found = true;
-    if (controller_fault_status & FAULT_NO_MTR)
-      faults.emplace_back("NO_MTR"), controller_detail_found = true;
-    if (controller_fault_status & FAULT_MTR_LCK)
-      faults.emplace_back("MTR_LCK"), controller_detail_found = true;
-    if (controller_fault_status & FAULT_LOCK_LIMIT)
-      faults.emplace_back("LOCK_LIMIT"), controller_detail_found = true;
-    if (controller_fault_status & FAULT_HW_LOCK_LIMIT)
-      faults.emplace_back("HW_LOCK_LIMIT"), controller_detail_found = true;
-    if (controller_fault_status & FAULT_DCBUS_UNDER_VOLTAGE)
-      faults.emplace_back("DCBUS_UNDER_VOLTAGE"), controller_detail_found = true;
-    if (controller_fault_status & FAULT_DCBUS_OVER_VOLTAGE)
-      faults.emplace_back("DCBUS_OVER_VOLTAGE"), controller_detail_found = true;
-    if (controller_fault_status & FAULT_SPEED_LOOP_SATURATION)
-      faults.emplace_back("SPEED_LOOP_SATURATION"), controller_detail_found = true;
-    if (controller_fault_status & FAULT_CURRENT_LOOP_SATURATION)
-      faults.emplace_back("CURRENT_LOOP_SATURATION"), controller_detail_found = true;
-    if (controller_fault_status & FAULT_WATCHDOG)
-      faults.emplace_back("WATCHDOG_FAULT"), controller_detail_found = true;
-    if ((controller_fault_status & CONTROLLER_FAULT_ACTIVE_MASK) != 0 && !controller_detail_found) {
-      faults.emplace_back("CTRL_FAULT_ACTIVE");
-    }
+bool MCF8329AComponent::read_algorithm_state_(uint16_t& algo_state) {
+  if (!this->diagnostics_.active()) {
+    return this->read_reg16(RegisterId::ALGORITHM_STATE, algo_state);
+  }
+  this->diagnostics_.require(this->service_, ::mcf8329a_core::DIAGNOSTIC_ALGORITHM_STATE);
+  if (!this->diagnostics_.complete(::mcf8329a_core::DIAGNOSTIC_ALGORITHM_STATE)) {
+    return false;
   }
+  algo_state = this->diagnostics_.fields().algorithm_state;
+  return true;
+}
 
-  std::string summary = "none";
-  if (!faults.empty()) {
-    summary.clear();
-    for (size_t i = 0; i < faults.size(); i++) {
-      if (i != 0) {
-        summary += ", ";
-      }
-      summary += faults[i];
-    }
+void MCF8329AComponent::publish_faults_() {
+  const ::mcf8329a_core::DiagnosticFields& diag = this->diagnostics_.fields();
+  const uint32_t gate_fault_status = diag.gate_fault_status;
+  const bool gate_fault_valid = diag.gate_fault_valid;
+  const uint32_t controller_fault_status = diag.controller_fault_status;
+  const bool controller_fault_valid = diag.controller_fault_valid;
+  mcf83xx_facade::FaultSummaryText summary;
+  const bool mpet_bemf_active = diag.mpet_bemf_active;
+  const bool hw_lock_active = diag.hw_lock_active;
+
+  if (gate_fault_valid) {
+    mcf83xx_facade::append_fault_names(
+      summary, gate_fault_status, GATE_FAULT_NAMES, GATE_DRIVER_FAULT_ACTIVE_MASK, "DRV_FAULT_ACTIVE"
+    );
   }
 
-  if (this->current_fault_text_sensor_ != nullptr) {
-    this->current_fault_text_sensor_->publish_state(summary);
+  if (controller_fault_valid) {
+    mcf83xx_facade::append_fault_names(
+      summary, controller_fault_status, CONTROLLER_FAULT_NAMES, CONTROLLER_FAULT_ACTIVE_MASK, "CTRL_FAULT_ACTIVE"
+    );
   }
 
+  mcf83xx_facade::publish_fault_summary(summary, this->fault_summary_guard_, this->current_fault_text_sensor_, TAG);
+
   if (mpet_bemf_active) {
     if (!this->mpet_bemf_fault_latched_) {
       this->mpet_bemf_fault_latched_ = true;
@@ -2150,107 +1926,46 @@ void MCF8329AComponent::publish_faults_(
   } else {
     this->hw_lock_fault_latched_ = false;
   }
-
-  if (summary != this->last_fault_summary_) {
-    if (summary == "none") {
-      ESP_LOGI(TAG, "Faults cleared");
-    } else {
-      ESP_LOGW(TAG, "Active faults: %s", summary.c_str());
-    }
-    this->last_fault_summary_ = summary;
-  }
 }
 
 void MCF8329AComponent::log_mpet_bemf_diagnostics_() {
-  uint32_t algo_debug1 = 0;
-  uint32_t algo_debug2 = 0;
-  uint32_t pin_config = 0;
-  uint32_t closed_loop2 = 0;
-  uint32_t mtr_params = 0;
-  uint32_t closed_loop3 = 0;
-  uint32_t closed_loop4 = 0;
+  using namespace ::mcf8329a_core;
+  const DiagnosticFields& diag = this->diagnostics_.fields();
 
-  const bool algo_debug1_ok = this->read_reg32(RegisterId::ALGO_DEBUG1, algo_debug1);
-  const bool algo_debug2_ok = this->read_reg32(RegisterId::ALGO_DEBUG2, algo_debug2);
-  const bool pin_config_ok = this->read_reg32(RegisterId::PIN_CONFIG, pin_config);
-  const bool closed_loop2_ok = this->read_reg32(RegisterId::CLOSED_LOOP2, closed_loop2);
-  const bool mtr_params_ok = this->read_reg32(RegisterId::MTR_PARAMS, mtr_params);
-  const bool closed_loop3_ok = this->read_reg32(RegisterId::CLOSED_LOOP3, closed_loop3);
-  const bool closed_loop4_ok = this->read_reg32(RegisterId::CLOSED_LOOP4, closed_loop4);
-
-  float speed_cmd_percent = -1.0f;
-  if (algo_debug1_ok) {
-    const uint16_t digital_speed_ctrl =
-      static_cast<uint16_t>((algo_debug1 & ALGO_DEBUG1_DIGITAL_SPEED_CTRL_MASK) >> 16);
-    speed_cmd_percent = (static_cast<float>(digital_speed_ctrl) * 100.0f) / 32767.0f;
-  }
-
-  const uint32_t brake_input =
-    pin_config_ok ? ((pin_config & PIN_CONFIG_BRAKE_INPUT_MASK) >> 2) : 0u;
-  const uint32_t motor_bemf_const =
-    mtr_params_ok
-      ? ((mtr_params & MTR_PARAMS_MOTOR_BEMF_CONST_MASK) >> MTR_PARAMS_MOTOR_BEMF_CONST_SHIFT)
-      : 0u;
-  const uint32_t configured_motor_res =
-    closed_loop2_ok ? ((closed_loop2 & CLOSED_LOOP2_MOTOR_RES_MASK) >> CLOSED_LOOP2_MOTOR_RES_SHIFT)
-                    : 0u;
-  const uint32_t configured_motor_ind =
-    closed_loop2_ok ? ((closed_loop2 & CLOSED_LOOP2_MOTOR_IND_MASK) >> CLOSED_LOOP2_MOTOR_IND_SHIFT)
-                    : 0u;
-  const uint32_t configured_bemf_const =
-    closed_loop3_ok
-      ? ((closed_loop3 & CLOSED_LOOP3_MOTOR_BEMF_CONST_MASK) >> CLOSED_LOOP3_MOTOR_BEMF_CONST_SHIFT)
-      : 0u;
-  const uint32_t configured_spd_loop_kp =
-    (closed_loop3_ok && closed_loop4_ok)
-      ? ((((closed_loop3 & CLOSED_LOOP3_SPD_LOOP_KP_MSB_MASK) >> CLOSED_LOOP3_SPD_LOOP_KP_MSB_SHIFT)
-          << 7) |
-         ((closed_loop4 & CLOSED_LOOP4_SPD_LOOP_KP_LSB_MASK) >> CLOSED_LOOP4_SPD_LOOP_KP_LSB_SHIFT))
-      : 0u;
-  const uint32_t configured_spd_loop_ki =
-    closed_loop4_ok
-      ? ((closed_loop4 & CLOSED_LOOP4_SPD_LOOP_KI_MASK) >> CLOSED_LOOP4_SPD_LOOP_KI_SHIFT)
-      : 0u;
-  const uint16_t configured_max_speed_code =
-    closed_loop4_ok ? static_cast<uint16_t>(
-                        (closed_loop4 & CLOSED_LOOP4_MAX_SPEED_MASK) >> CLOSED_LOOP4_MAX_SPEED_SHIFT
-                      )
-                    : 0u;
-  const float configured_max_speed_hz = this->service_.decode_max_speed_hz(configured_max_speed_code);
-
-  if (algo_debug1_ok && algo_debug2_ok && pin_config_ok && closed_loop2_ok && mtr_params_ok && closed_loop3_ok && closed_loop4_ok) {
+  if (this->diagnostics_.complete(DIAGNOSTIC_MPET_BEMF)) {
     ESP_LOGW(
       TAG,
       "MPET_BEMF diag: speed_cmd=%.1f%% brake=%s mpet(cmd=%s ke=%s mech=%s write_shadow=%s) "
       "measured_bemf=%u configured_bemf=0x%02X configured_mres=%u configured_mind=%u "
       "configured_spd_kp=%u configured_spd_ki=%u configured_max_speed=%.1fHz(code=%u)",
-      speed_cmd_percent,
-      this->brake_input_to_string_(brake_input),
-      YESNO((algo_debug2 & ALGO_DEBUG2_MPET_CMD_MASK) != 0u),
-      YESNO((algo_debug2 & ALGO_DEBUG2_MPET_KE_MASK) != 0u),
-      YESNO((algo_debug2 & ALGO_DEBUG2_MPET_MECH_MASK) != 0u),
-      YESNO((algo_debug2 & ALGO_DEBUG2_MPET_WRITE_SHADOW_MASK) != 0u),
-      static_cast<unsigned>(motor_bemf_const),
-      static_cast<unsigned>(configured_bemf_const),
-      static_cast<unsigned>(configured_motor_res),
-      static_cast<unsigned>(configured_motor_ind),
-      static_cast<unsigned>(configured_spd_loop_kp),
-      static_cast<unsigned>(configured_spd_loop_ki),
-      configured_max_speed_hz,
-      static_cast<unsigned>(configured_max_speed_code)
+      diag.speed_cmd_percent,
+      this->brake_input_to_string_(diag.brake_input),
+      YESNO(diag.mpet_cmd),
+      YESNO(diag.mpet_ke),
+      YESNO(diag.mpet_mech),
+      YESNO(diag.mpet_write_shadow),
+      static_cast<unsigned>(diag.measured_bemf_const),
+      static_cast<unsigned>(diag.configured_bemf_const),
+      static_cast<unsigned>(diag.configured_motor_res),
+      static_cast<unsigned>(diag.configured_motor_ind),
+      static_cast<unsigned>(diag.configured_spd_loop_kp),
+      static_cast<unsigned>(diag.configured_spd_loop_ki),
+      diag.configured_max_speed_hz,
+      static_cast<unsigned>(diag.configured_max_speed_code)
     );
   } else {
+    uint32_t unused = 0;
     ESP_LOGW(
       TAG,
       "MPET_BEMF diag: read failure ad1=%s ad2=%s pin_cfg=%s cl2=%s mtr_params=%s closed_loop3=%s "
       "closed_loop4=%s",
-      YESNO(algo_debug1_ok),
-      YESNO(algo_debug2_ok),
-      YESNO(pin_config_ok),
-      YESNO(closed_loop2_ok),
-      YESNO(mtr_params_ok),
-      YESNO(closed_loop3_ok),
-      YESNO(closed_loop4_ok)
+      YESNO(this->diagnostics_.value(RegisterId::ALGO_DEBUG1, unused)),
+      YESNO(this->diagnostics_.value(RegisterId::ALGO_DEBUG2, unused)),
+      YESNO(this->diagnostics_.value(RegisterId::PIN_CONFIG, unused)),
+      YESNO(this->diagnostics_.value(RegisterId::CLOSED_LOOP2, unused)),
+      YESNO(this->diagnostics_.value(RegisterId::MTR_PARAMS, unused)),
+      YESNO(this->diagnostics_.value(RegisterId::CLOSED_LOOP3, unused)),
+      YESNO(this->diagnostics_.value(RegisterId::CLOSED_LOOP4, unused))
     );
   }
 
@@ -2262,57 +1977,13 @@ void MCF8329AComponent::log_mpet_bemf_diagnostics_() {
 }
 
 void MCF8329AComponent::log_hw_lock_diagnostics_() {
-  uint32_t algo_debug1 = 0;
-  uint32_t fault_config1 = 0;
-  uint32_t fault_config2 = 0;
+  using namespace ::mcf8329a_core;
+  const DiagnosticFields& diag = this->diagnostics_.fields();
 
-  const bool algo_debug1_ok = this->read_reg32(RegisterId::ALGO_DEBUG1, algo_debug1);
-  const bool fault_config1_ok = this->read_reg32(RegisterId::FAULT_CONFIG1, fault_config1);
-  const bool fault_config2_ok = this->read_reg32(RegisterId::FAULT_CONFIG2, fault_config2);
-
-  float speed_cmd_percent = -1.0f;
-  if (algo_debug1_ok) {
-    const uint16_t digital_speed_ctrl =
-      static_cast<uint16_t>((algo_debug1 & ALGO_DEBUG1_DIGITAL_SPEED_CTRL_MASK) >> 16);
-    speed_cmd_percent = (static_cast<float>(digital_speed_ctrl) * 100.0f) / 32767.0f;
-  }
-
-  if (algo_debug1_ok && fault_config1_ok && fault_config2_ok) {
-    const uint8_t ilimit = static_cast<uint8_t>(
-      (fault_config1 & FAULT_CONFIG1_ILIMIT_MASK) >> FAULT_CONFIG1_ILIMIT_SHIFT
-    );
-    const uint8_t hw_lock_ilimit = static_cast<uint8_t>(
-      (fault_config1 & FAULT_CONFIG1_HW_LOCK_ILIMIT_MASK) >> FAULT_CONFIG1_HW_LOCK_ILIMIT_SHIFT
-    );
-    const uint8_t lock_ilimit = static_cast<uint8_t>(
-      (fault_config1 & FAULT_CONFIG1_LOCK_ILIMIT_MASK) >> FAULT_CONFIG1_LOCK_ILIMIT_SHIFT
-    );
-    const uint8_t lock_mode = static_cast<uint8_t>(
-      (fault_config1 & FAULT_CONFIG1_LOCK_ILIMIT_MODE_MASK) >> FAULT_CONFIG1_LOCK_ILIMIT_MODE_SHIFT
-    );
-    const uint8_t mtr_lock_mode = static_cast<uint8_t>(
-      (fault_config1 & FAULT_CONFIG1_MTR_LCK_MODE_MASK) >> FAULT_CONFIG1_MTR_LCK_MODE_SHIFT
-    );
-    const uint8_t hw_lock_mode = static_cast<uint8_t>(
-      (fault_config2 & FAULT_CONFIG2_HW_LOCK_ILIMIT_MODE_MASK) >>
-      FAULT_CONFIG2_HW_LOCK_ILIMIT_MODE_SHIFT
-    );
-    const uint8_t lck_retry = static_cast<uint8_t>(
-      (fault_config1 & FAULT_CONFIG1_LCK_RETRY_MASK) >> FAULT_CONFIG1_LCK_RETRY_SHIFT
-    );
-    const bool lock1_en = (fault_config2 & FAULT_CONFIG2_LOCK1_EN_MASK) != 0u;
-    const bool lock2_en = (fault_config2 & FAULT_CONFIG2_LOCK2_EN_MASK) != 0u;
-    const bool lock3_en = (fault_config2 & FAULT_CONFIG2_LOCK3_EN_MASK) != 0u;
-    const uint8_t lock_abn_speed = static_cast<uint8_t>(
-      (fault_config2 & FAULT_CONFIG2_LOCK_ABN_SPEED_MASK) >> FAULT_CONFIG2_LOCK_ABN_SPEED_SHIFT
-    );
-    const uint8_t abnormal_bemf_threshold = static_cast<uint8_t>(
-      (fault_config2 & FAULT_CONFIG2_ABNORMAL_BEMF_THR_MASK) >>
-      FAULT_CONFIG2_ABNORMAL_BEMF_THR_SHIFT
-    );
-    const uint8_t no_motor_threshold = static_cast<uint8_t>(
-      (fault_config2 & FAULT_CONFIG2_NO_MTR_THR_MASK) >> FAULT_CONFIG2_NO_MTR_THR_SHIFT
-    );
+  if (this->diagnostics_.complete(DIAGNOSTIC_HW_LOCK)) {
+    const uint8_t ilimit = diag.ilimit;
+    const uint8_t lock_ilimit = diag.lock_ilimit;
+    const uint8_t hw_lock_ilimit = diag.hw_lock_ilimit;
 
     ESP_LOGW(
       TAG,
@@ -2320,27 +1991,27 @@ void MCF8329AComponent::log_hw_lock_diagnostics_() {
       "hw_lock_ilimit=%u(%u%%) "
       "lock_mode=%u(%s) mtr_lock_mode=%u(%s) hw_lock_mode=%u(%s) lck_retry=%u(%s) "
       "lock1=%s lock2=%s lock3=%s lock_abn_speed=%s abn_bemf_thr=%s no_mtr_thr=%s",
-      speed_cmd_percent,
+      diag.speed_cmd_percent,
       static_cast<unsigned>(ilimit),
       static_cast<unsigned>(tables::LOCK_ILIMIT_PERCENT[ilimit & 0x0Fu]),
       static_cast<unsigned>(lock_ilimit),
       static_cast<unsigned>(tables::LOCK_ILIMIT_PERCENT[lock_ilimit & 0x0Fu]),
       static_cast<unsigned>(hw_lock_ilimit),
       static_cast<unsigned>(tables::LOCK_ILIMIT_PERCENT[hw_lock_ilimit & 0x0Fu]),
-      static_cast<unsigned>(lock_mode),
-      this->lock_mode_to_string_(lock_mode),
-      static_cast<unsigned>(mtr_lock_mode),
-      this->lock_mode_to_string_(mtr_lock_mode),
-      static_cast<unsigned>(hw_lock_mode),
-      this->lock_mode_to_string_(hw_lock_mode),
-      static_cast<unsigned>(lck_retry),
-      this->lock_retry_time_to_string_(lck_retry),
-      YESNO(lock1_en),
-      YESNO(lock2_en),
-      YESNO(lock3_en),
-      tables::LOCK_ABN_SPEED_THRESHOLD_LABELS[lock_abn_speed & 0x7u],
-      tables::ABNORMAL_BEMF_THRESHOLD_LABELS[abnormal_bemf_threshold & 0x7u],
-      tables::NO_MOTOR_THRESHOLD_LABELS[no_motor_threshold & 0x7u]
+      static_cast<unsigned>(diag.lock_mode),
+      this->lock_mode_to_string_(diag.lock_mode),
+      static_cast<unsigned>(diag.mtr_lock_mode),
+      this->lock_mode_to_string_(diag.mtr_lock_mode),
+      static_cast<unsigned>(diag.hw_lock_mode),
+      this->lock_mode_to_string_(diag.hw_lock_mode),
+      static_cast<unsigned>(diag.lck_retry),
+      this->lock_retry_time_to_string_(diag.lck_retry),
+      YESNO(diag.lock1_en),
+      YESNO(diag.lock2_en),
+      YESNO(diag.lock3_en),
+      tables::LOCK_ABN_SPEED_THRESHOLD_LABELS[diag.lock_abn_speed & 0x7u],
+      tables::ABNORMAL_BEMF_THRESHOLD_LABELS[diag.abnormal_bemf_threshold & 0x7u],
+      tables::NO_MOTOR_THRESHOLD_LABELS[diag.no_motor_threshold & 0x7u]
     );
 
     const bool limits_at_guardrail =
@@ -2360,12 +2031,13 @@ void MCF8329AComponent::log_hw_lock_diagnostics_() {
       );
     }
   } else {
+    uint32_t unused = 0;
     ESP_LOGW(
       TAG,
       "HW_LOCK_LIMIT diag: read failure ad1=%s fault_cfg1=%s fault_cfg2=%s",
-      YESNO(algo_debug1_ok),
-      YESNO(fault_config1_ok),
-      YESNO(fault_config2_ok)
+      YESNO(this->diagnostics_.value(RegisterId::ALGO_DEBUG1, unused)),
+      YESNO(this->diagnostics_.value(RegisterId::FAULT_CONFIG1, unused)),
+      YESNO(this->diagnostics_.value(RegisterId::FAULT_CONFIG2, unused))
     );
     ESP_LOGW(
       TAG,
@@ -2395,9 +2067,10 @@ const char* MCF8329AComponent::algorithm_state_to_string_(uint16_t state) const
   return ::mcf8329a_core::algorithm_state_to_string(state);
 }
 
-void MCF8329AComponent::log_algorithm_state_transition_(uint32_t algo_status, const char* context) {
+void MCF8329AComponent::log_algorithm_state_transition_(const char* context) {
+  using namespace ::mcf8329a_core;
   uint16_t algo_state = 0;
-  if (!this->read_reg16(RegisterId::ALGORITHM_STATE, algo_state)) {
+  if (!this->read_algorithm_state_(algo_state)) {
     if (!this->algorithm_state_read_error_latched_) {
       ESP_LOGW(TAG, "Unable to read ALGORITHM_STATE for %s logging", context);
       this->algorithm_state_read_error_latched_ = true;
@@ -2410,20 +2083,13 @@ void MCF8329AComponent::log_algorithm_state_transition_(uint32_t algo_status, co
     return;
   }
 
-  const uint16_t duty_raw =
-    static_cast<uint16_t>((algo_status & ALGO_STATUS_DUTY_CMD_MASK) >> ALGO_STATUS_DUTY_CMD_SHIFT);
-  const uint16_t volt_mag_raw =
-    static_cast<uint16_t>((algo_status & ALGO_STATUS_VOLT_MAG_MASK) >> ALGO_STATUS_VOLT_MAG_SHIFT);
-  const float duty_percent = (static_cast<float>(duty_raw) / 4095.0f) * 100.0f;
-  const float volt_mag_percent = (static_cast<float>(volt_mag_raw) * 100.0f) / 32768.0f;
-  const bool sys_enable = (algo_status & ALGO_STATUS_SYS_ENABLE_FLAG_MASK) != 0u;
-  float speed_cmd_percent = -1.0f;
-  uint32_t algo_debug1 = 0;
-  if (this->read_reg32(RegisterId::ALGO_DEBUG1, algo_debug1)) {
-    const uint16_t digital_speed_ctrl =
-      static_cast<uint16_t>((algo_debug1 & ALGO_DEBUG1_DIGITAL_SPEED_CTRL_MASK) >> 16);
-    speed_cmd_percent = (static_cast<float>(digital_speed_ctrl) * 100.0f) / 32767.0f;
-  }
+  // Already read when a fault diagnostic fired in this poll.
+  this->diagnostics_.require(this->service_, DIAGNOSTIC_SPEED_COMMAND);
+  const DiagnosticFields& diag = this->diagnostics_.fields();
+  const float speed_cmd_percent = diag.speed_cmd_percent;
+  const float duty_percent = diag.duty_percent;
+  const float volt_mag_percent = diag.volt_mag_percent;
+  const bool sys_enable = diag.sys_enable;
 
   if (!this->algorithm_state_valid_) {
     ESP_LOGI(
@@ -2500,12 +2166,7 @@ void MCF8329AComponent::publish_algo_status_(uint32_t algo_status) {
 void MCF8329AComponent::handle_fault_shutdown_(
   bool fault_active, uint32_t controller_fault_status, bool controller_fault_valid
 ) {
-  if (!fault_active) {
-    this->fault_latched_ = false;
-    return;
-  }
-
-  if (this->severe_current_fault_active_(controller_fault_status, controller_fault_valid)) {
+  if (fault_active && this->severe_current_fault_active_(controller_fault_status, controller_fault_valid)) {
     if (!this->severe_fault_speed_lockout_) {
       this->severe_fault_speed_lockout_ = true;
       ESP_LOGE(
@@ -2516,13 +2177,9 @@ void MCF8329AComponent::handle_fault_shutdown_(
     }
   }
 
-  if (this->fault_latched_) {
-    return;
+  if (mcf83xx_facade::latch_fault_shutdown(fault_active, this->fault_latched_, TAG)) {
+    (void)this->set_speed_percent(0.0f, "fault_shutdown");
   }
-
-  this->fault_latched_ = true;
-  ESP_LOGW(TAG, "Fault detected, forcing speed command to 0%%");
-  (void)this->set_speed_percent(0.0f, "fault_shutdown");
 }
 
 bool MCF8329AComponent::severe_current_fault_active_(
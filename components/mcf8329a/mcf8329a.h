@@ -12,10 +12,16 @@
 #include "esphome/components/switch/switch.h"
 #include "esphome/components/text_sensor/text_sensor.h"
 #include "esphome/core/component.h"
+#include "esphome/core/preferences.h"
 
+#include "../component_common/fixed_string.h"
+#include "../mcf83xx_facade/facade.h"
 #include "mcf8329a_bus.h"
+#include "mcf8329a_diagnostics.h"
+#include "mcf8329a_poll_service.h"
 #include "mcf8329a_protocol.h"
 #include "mcf8329a_service.h"
+#include "mcf8329a_tuning_service.h"
 
 namespace esphome {
 namespace mcf8329a {
@@ -102,14 +108,19 @@ class MCF8329ARunMPETButton : public button::Button {
 
 class MCF8329AComponent : public PollingComponent,
                           public i2c::I2CDevice,
-                          public ::mcf8329a_core::RegisterBus {
+                          public ::mcf8329a_core::RegisterBus,
+                          public ::mcf83xx_common::CommsProbe {
  public:
   MCF8329AComponent();
   ~MCF8329AComponent();
   void setup() override;
+  void loop() override;
   void update() override;
   void dump_config() override;
 
+  bool ack_address(uint8_t address) override;
+  bool probe_target() override;
+
   bool read_register32(uint16_t offset, uint32_t *value) override;
   bool read_register16(uint16_t offset, uint16_t *value) override;
   bool write_register32(uint16_t offset, uint32_t value) override;
@@ -129,7 +140,13 @@ class MCF8329AComponent : public PollingComponent,
   void start_mpet_characterization();
 
   void set_auto_tickle_watchdog(bool auto_tickle_watchdog) {
-    auto_tickle_watchdog_ = auto_tickle_watchdog;
+    watchdog_.set_enabled(auto_tickle_watchdog);
+  }
+  void set_watchdog_tickle_interval_ms(uint32_t interval_ms) {
+    watchdog_.set_interval_ms(interval_ms);
+  }
+  void set_watchdog_timeout_ms(uint32_t timeout_ms) {
+    watchdog_.set_timeout_ms(timeout_ms);
   }
   void set_clear_mpet_on_startup(bool clear_mpet_on_startup) {
     clear_mpet_on_startup_ = clear_mpet_on_startup;
@@ -295,16 +312,49 @@ class MCF8329AComponent : public PollingComponent,
     cfg_speed_loop_ki_code_set_ = true;
   }
   void set_speed_ramp_up_percent_per_s(float speed_ramp_up_percent_per_s) {
-    speed_ramp_up_percent_per_s_ = speed_ramp_up_percent_per_s;
+    speed_ramp_config_.up_percent_per_s = speed_ramp_up_percent_per_s;
   }
   void set_speed_ramp_down_percent_per_s(float speed_ramp_down_percent_per_s) {
-    speed_ramp_down_percent_per_s_ = speed_ramp_down_percent_per_s;
+    speed_ramp_config_.down_percent_per_s = speed_ramp_down_percent_per_s;
   }
   void set_start_boost_percent(float start_boost_percent) {
-    start_boost_percent_ = start_boost_percent;
+    speed_ramp_config_.start_boost_percent = start_boost_percent;
   }
   void set_start_boost_hold_ms(uint32_t start_boost_hold_ms) {
-    start_boost_hold_ms_ = start_boost_hold_ms;
+    speed_ramp_config_.start_boost_hold_ms = start_boost_hold_ms;
+  }
+  void set_speed_ramp_hardware(bool speed_ramp_hardware) {
+    speed_ramp_config_.hardware = speed_ramp_hardware;
+  }
+  void set_speed_poll_interval_ms(uint32_t speed_poll_interval_ms) {
+    poll_schedule_.speed_interval_ms = speed_poll_interval_ms;
+  }
+  void set_slow_poll_interval_ms(uint32_t slow_poll_interval_ms) {
+    poll_schedule_.slow_interval_ms = slow_poll_interval_ms;
+  }
+  void add_tune_accel_code(uint8_t code) {
+    ::mcf8329a_core::add_tune_grid_code(tune_search_.accel_codes, tune_search_.accel_code_count, code);
+  }
+  void add_tune_handoff_code(uint8_t code) {
+    ::mcf8329a_core::add_tune_grid_code(tune_search_.handoff_codes, tune_search_.handoff_code_count, code);
+  }
+  void set_tune_fine_passes(uint8_t fine_passes) {
+    tune_search_.fine_passes = fine_passes;
+  }
+  void set_tune_early_termination(bool early_termination) {
+    tune_search_.early_termination = early_termination;
+  }
+  void set_persist_tuning_results(bool persist_tuning_results) {
+    tuning_store_.set_persist(persist_tuning_results);
+  }
+  void set_tuning_preference_key(uint32_t key) {
+    tuning_store_.set_preference_key(key);
+  }
+  void set_tuning_config_hash(uint32_t config_hash) {
+    tuning_store_.set_config_hash(config_hash);
+  }
+  const ::mcf8329a_core::PollTierStats& poll_stats(::mcf8329a_core::PollTier tier) const {
+    return poll_.stats(tier);
   }
 
   void set_brake_switch(MCF8329ABrakeSwitch* sw) {
@@ -343,6 +393,36 @@ class MCF8329AComponent : public PollingComponent,
   void set_fg_speed_fdbk_hz_sensor(sensor::Sensor* s) {
     fg_speed_fdbk_hz_sensor_ = s;
   }
+  void set_status_poll_transactions_sensor(sensor::Sensor* s) {
+    status_poll_transactions_sensor_ = s;
+  }
+  void set_speed_poll_transactions_sensor(sensor::Sensor* s) {
+    speed_poll_transactions_sensor_ = s;
+  }
+  void set_slow_poll_transactions_sensor(sensor::Sensor* s) {
+    slow_poll_transactions_sensor_ = s;
+  }
+  void set_tuning_time_saved_sensor(sensor::Sensor* s) {
+    tuning_store_.set_time_saved_sensor(s);
+  }
+  void set_time_to_first_ack_sensor(sensor::Sensor* s) {
+    comms_.set_time_to_first_ack_sensor(s);
+  }
+  void set_watchdog_tickle_jitter_sensor(sensor::Sensor* s) {
+    watchdog_.set_jitter_sensor(s);
+  }
+  void set_watchdog_margin_sensor(sensor::Sensor* s) {
+    watchdog_.set_margin_sensor(s);
+  }
+  void set_comms_backoff_ms(uint32_t initial_ms, uint32_t max_ms) {
+    comms_.set_backoff_ms(initial_ms, max_ms);
+  }
+  void set_comms_deadline_ms(uint32_t deadline_ms) {
+    comms_.set_deadline_ms(deadline_ms);
+  }
+  void set_comms_scan_range(uint8_t first_address, uint8_t last_address) {
+    comms_.set_scan_range(first_address, last_address);
+  }
   void set_current_fault_text_sensor(text_sensor::TextSensor* s) {
     current_fault_text_sensor_ = s;
   }
@@ -351,14 +431,10 @@ class MCF8329AComponent : public PollingComponent,
   friend class MCF8329ATuningController;
 
   bool read_probe_and_publish_();
-  bool establish_communications_(uint8_t attempts, uint32_t retry_delay_ms, bool log_retry_delays);
-  bool probe_device_ack_(i2c::ErrorCode& error_code) const;
-  bool scan_i2c_bus_();
-  void process_deferred_startup_();
+  void process_comms_bringup_();
   void apply_post_comms_setup_();
   void recover_from_mcf_reset_if_needed_();
   bool apply_motor_config_();
-  const char* i2c_error_to_string_(i2c::ErrorCode error_code) const;
   const char* mode_to_string_(uint8_t mode) const;
   const char* align_time_to_string_(uint8_t code) const;
   const char* brake_mode_to_string_(uint8_t code) const;
@@ -369,16 +445,17 @@ class MCF8329AComponent : public PollingComponent,
   bool clear_mpet_bits_(const char* context);
   bool apply_speed_command_(float speed_percent, const char* reason, bool publish_number = true);
   void process_speed_command_ramp_();
+  void publish_poll_stats_();
+
+  // The diagnostics below read registers only through `diagnostics_`.
+  // require_diagnostics_() fills it in one ordered pass with the status
+  // registers, `groups`, and the groups a newly latched fault logs.
+  void require_diagnostics_(::mcf8329a_core::DiagnosticGroups groups);
+  bool read_algorithm_state_(uint16_t& algo_state);
   void log_mpet_bemf_diagnostics_();
   void log_hw_lock_diagnostics_();
-
-  void publish_faults_(
-    uint32_t gate_fault_status,
-    bool gate_fault_valid,
-    uint32_t controller_fault_status,
-    bool controller_fault_valid
-  );
-  void log_algorithm_state_transition_(uint32_t algo_status, const char* context);
+  void publish_faults_();
+  void log_algorithm_state_transition_(const char* context);
   void publish_algo_status_(uint32_t algo_status);
   const char* brake_input_to_string_(uint32_t brake_input_value) const;
   const char* direction_input_to_string_(uint32_t direction_input_value) const;
@@ -390,16 +467,8 @@ class MCF8329AComponent : public PollingComponent,
   );
 
 
-  static constexpr uint8_t STARTUP_COMMS_ATTEMPTS = 20u;
-  static constexpr uint32_t STARTUP_COMMS_RETRY_DELAY_MS = 250u;
-  static constexpr uint32_t DEFERRED_COMMS_RETRY_INTERVAL_MS = 1000u;
-  static constexpr uint32_t DEFERRED_SCAN_INTERVAL_MS = 5000u;
-  static constexpr uint32_t STARTUP_PROFILE_CHECK_INTERVAL_MS = 1000u;
   static constexpr uint32_t STARTUP_PROFILE_RECOVERY_COOLDOWN_MS = 3000u;
-  static constexpr uint8_t I2C_SCAN_ADDRESS_MIN = 0x00u;
-  static constexpr uint8_t I2C_SCAN_ADDRESS_MAX = 0x7Eu;
 
-  bool auto_tickle_watchdog_{false};
   bool clear_mpet_on_startup_{true};
   bool cfg_mpet_use_dedicated_params_set_{false};
   bool cfg_mpet_open_loop_curr_ref_set_{false};
@@ -478,26 +547,18 @@ class MCF8329AComponent : public PollingComponent,
   uint8_t cfg_hw_lock_ilimit_deglitch_{0};
   uint16_t cfg_speed_loop_kp_code_{0};
   uint16_t cfg_speed_loop_ki_code_{0};
-  float speed_ramp_up_percent_per_s_{0.0f};
-  float speed_ramp_down_percent_per_s_{0.0f};
-  float start_boost_percent_{0.0f};
-  uint32_t start_boost_hold_ms_{0u};
+  ::mcf83xx_common::SpeedRampConfig speed_ramp_config_{};
   uint32_t mpet_timeout_ms_{120000u};
-  float speed_target_percent_{0.0f};
+  ::mcf83xx_common::SpeedCommandRamp speed_ramp_;
   float speed_applied_percent_{0.0f};
-  bool speed_target_active_{false};
-  bool start_boost_active_{false};
-  uint32_t start_boost_until_ms_{0u};
-  uint32_t last_ramp_update_ms_{0u};
   std::string cfg_direction_mode_{"hardware"};
-  uint32_t last_watchdog_tickle_ms_{0};
+  mcf83xx_facade::WatchdogTickler watchdog_;
   uint32_t last_vm_diag_log_ms_{0};
   uint32_t last_speed_diag_log_ms_{0};
   bool fault_latched_{false};
   bool normal_operation_ready_{false};
-  uint32_t deferred_comms_last_retry_ms_{0};
-  uint32_t deferred_comms_last_scan_ms_{0};
-  std::string last_fault_summary_{"none"};
+  mcf83xx_facade::CommsLink comms_;
+  ::component_common::PublishGuard fault_summary_guard_{};
   std::string motor_config_summary_{"default"};
   bool mpet_bemf_fault_latched_{false};
   bool hw_lock_fault_latched_{false};
@@ -505,9 +566,13 @@ class MCF8329AComponent : public PollingComponent,
   bool algorithm_state_valid_{false};
   bool algorithm_state_read_error_latched_{false};
   uint16_t last_algorithm_state_{0xFFFFu};
-  uint32_t startup_profile_last_check_ms_{0u};
   uint32_t startup_profile_last_recovery_ms_{0u};
   ::mcf8329a_core::MCF8329AService service_;
+  ::mcf8329a_core::PollSchedule poll_schedule_{};
+  ::mcf8329a_core::MCF8329APollService poll_;
+  ::mcf8329a_core::MCF8329ADiagnosticSnapshot diagnostics_;
+  ::mcf8329a_core::TuneSearchConfig tune_search_{};
+  mcf83xx_facade::TuningStore tuning_store_{0x8329A001u};
   MCF8329ATuningController* tuning_controller_{nullptr};
 
   MCF8329ABrakeSwitch* brake_switch_{nullptr};
@@ -522,6 +587,9 @@ class MCF8329AComponent : public PollingComponent,
   sensor::Sensor* speed_fdbk_hz_sensor_{nullptr};
   sensor::Sensor* speed_ref_open_loop_hz_sensor_{nullptr};
   sensor::Sensor* fg_speed_fdbk_hz_sensor_{nullptr};
+  sensor::Sensor* status_poll_transactions_sensor_{nullptr};
+  sensor::Sensor* speed_poll_transactions_sensor_{nullptr};
+  sensor::Sensor* slow_poll_transactions_sensor_{nullptr};
   text_sensor::TextSensor* current_fault_text_sensor_{nullptr};
 };
 
@@ -0,0 +1,107 @@
+#include "mcf8329a_diagnostics.h"
+
+namespace mcf8329a_core {
+
+using namespace regs;
+
+namespace {
+
+template<typename T> T field(uint32_t value, uint32_t mask, uint32_t shift) {
+  return static_cast<T>((value & mask) >> shift);
+}
+
+}  // namespace
+
+void MCF8329ADiagnosticSnapshot::begin() {
+  this->Base::begin();
+  this->fields_ = DiagnosticFields{};
+}
+
+void MCF8329ADiagnosticSnapshot::begin(const MCF8329APollService &poll) {
+  this->Base::begin(poll);
+  this->decode_();
+}
+
+void MCF8329ADiagnosticSnapshot::require(const MCF8329AService &service, DiagnosticGroups groups) {
+  if (this->Base::require(service, groups)) {
+    this->decode_();
+  }
+}
+
+void MCF8329ADiagnosticSnapshot::decode_() {
+  DiagnosticFields &f = this->fields_;
+  const auto valid = [this](RegisterId id) { return this->valid(id); };
+  const auto raw = [this](RegisterId id) { return this->raw(id); };
+
+  f.gate_fault_valid = valid(RegisterId::GATE_DRIVER_FAULT_STATUS);
+  f.gate_fault_status = f.gate_fault_valid ? raw(RegisterId::GATE_DRIVER_FAULT_STATUS) : 0U;
+  f.controller_fault_valid = valid(RegisterId::CONTROLLER_FAULT_STATUS);
+  f.controller_fault_status = f.controller_fault_valid ? raw(RegisterId::CONTROLLER_FAULT_STATUS) : 0U;
+  f.fault_active = (f.gate_fault_status & GATE_DRIVER_FAULT_ACTIVE_MASK) != 0U ||
+                   (f.controller_fault_status & CONTROLLER_FAULT_ACTIVE_MASK) != 0U;
+  f.mpet_bemf_active = (f.controller_fault_status & FAULT_MPET_BEMF) != 0U;
+  f.hw_lock_active = (f.controller_fault_status & FAULT_HW_LOCK_LIMIT) != 0U;
+
+  f.algo_status_valid = valid(RegisterId::ALGO_STATUS);
+  f.algo_status = f.algo_status_valid ? raw(RegisterId::ALGO_STATUS) : 0U;
+  const uint16_t duty_raw = field<uint16_t>(f.algo_status, ALGO_STATUS_DUTY_CMD_MASK, ALGO_STATUS_DUTY_CMD_SHIFT);
+  const uint16_t volt_mag_raw =
+    field<uint16_t>(f.algo_status, ALGO_STATUS_VOLT_MAG_MASK, ALGO_STATUS_VOLT_MAG_SHIFT);
+  f.duty_percent = (static_cast<float>(duty_raw) / 4095.0f) * 100.0f;
+  f.volt_mag_percent = (static_cast<float>(volt_mag_raw) * 100.0f) / 32768.0f;
+  f.sys_enable = (f.algo_status & ALGO_STATUS_SYS_ENABLE_FLAG_MASK) != 0U;
+
+  f.algorithm_state = static_cast<uint16_t>(raw(RegisterId::ALGORITHM_STATE));
+
+  f.speed_cmd_percent = -1.0f;
+  if (valid(RegisterId::ALGO_DEBUG1)) {
+    const uint16_t digital_speed_ctrl =
+      field<uint16_t>(raw(RegisterId::ALGO_DEBUG1), ALGO_DEBUG1_DIGITAL_SPEED_CTRL_MASK, 16);
+    f.speed_cmd_percent = mcf83xx_common::speed_code_to_percent(digital_speed_ctrl);
+  }
+
+  const uint32_t algo_debug2 = raw(RegisterId::ALGO_DEBUG2);
+  f.mpet_cmd = (algo_debug2 & ALGO_DEBUG2_MPET_CMD_MASK) != 0U;
+  f.mpet_ke = (algo_debug2 & ALGO_DEBUG2_MPET_KE_MASK) != 0U;
+  f.mpet_mech = (algo_debug2 & ALGO_DEBUG2_MPET_MECH_MASK) != 0U;
+  f.mpet_write_shadow = (algo_debug2 & ALGO_DEBUG2_MPET_WRITE_SHADOW_MASK) != 0U;
+  f.brake_input = field<uint32_t>(raw(RegisterId::PIN_CONFIG), PIN_CONFIG_BRAKE_INPUT_MASK, 2);
+  f.measured_bemf_const =
+    field<uint32_t>(raw(RegisterId::MTR_PARAMS), MTR_PARAMS_MOTOR_BEMF_CONST_MASK, MTR_PARAMS_MOTOR_BEMF_CONST_SHIFT);
+
+  const uint32_t closed_loop2 = raw(RegisterId::CLOSED_LOOP2);
+  const uint32_t closed_loop3 = raw(RegisterId::CLOSED_LOOP3);
+  const uint32_t closed_loop4 = raw(RegisterId::CLOSED_LOOP4);
+  f.configured_motor_res = field<uint32_t>(closed_loop2, CLOSED_LOOP2_MOTOR_RES_MASK, CLOSED_LOOP2_MOTOR_RES_SHIFT);
+  f.configured_motor_ind = field<uint32_t>(closed_loop2, CLOSED_LOOP2_MOTOR_IND_MASK, CLOSED_LOOP2_MOTOR_IND_SHIFT);
+  f.configured_bemf_const =
+    field<uint32_t>(closed_loop3, CLOSED_LOOP3_MOTOR_BEMF_CONST_MASK, CLOSED_LOOP3_MOTOR_BEMF_CONST_SHIFT);
+  f.configured_spd_loop_kp =
+    (field<uint32_t>(closed_loop3, CLOSED_LOOP3_SPD_LOOP_KP_MSB_MASK, CLOSED_LOOP3_SPD_LOOP_KP_MSB_SHIFT) << 7) |
+    field<uint32_t>(closed_loop4, CLOSED_LOOP4_SPD_LOOP_KP_LSB_MASK, CLOSED_LOOP4_SPD_LOOP_KP_LSB_SHIFT);
+  f.configured_spd_loop_ki = field<uint32_t>(closed_loop4, CLOSED_LOOP4_SPD_LOOP_KI_MASK, CLOSED_LOOP4_SPD_LOOP_KI_SHIFT);
+  f.configured_max_speed_code = field<uint16_t>(closed_loop4, CLOSED_LOOP4_MAX_SPEED_MASK, CLOSED_LOOP4_MAX_SPEED_SHIFT);
+  f.configured_max_speed_hz = decode_max_speed_hz(f.configured_max_speed_code);
+
+  const uint32_t fault_config1 = raw(RegisterId::FAULT_CONFIG1);
+  const uint32_t fault_config2 = raw(RegisterId::FAULT_CONFIG2);
+  f.ilimit = field<uint8_t>(fault_config1, FAULT_CONFIG1_ILIMIT_MASK, FAULT_CONFIG1_ILIMIT_SHIFT);
+  f.hw_lock_ilimit = field<uint8_t>(fault_config1, FAULT_CONFIG1_HW_LOCK_ILIMIT_MASK, FAULT_CONFIG1_HW_LOCK_ILIMIT_SHIFT);
+  f.lock_ilimit = field<uint8_t>(fault_config1, FAULT_CONFIG1_LOCK_ILIMIT_MASK, FAULT_CONFIG1_LOCK_ILIMIT_SHIFT);
+  f.lock_mode =
+    field<uint8_t>(fault_config1, FAULT_CONFIG1_LOCK_ILIMIT_MODE_MASK, FAULT_CONFIG1_LOCK_ILIMIT_MODE_SHIFT);
+  f.mtr_lock_mode = field<uint8_t>(fault_config1, FAULT_CONFIG1_MTR_LCK_MODE_MASK, FAULT_CONFIG1_MTR_LCK_MODE_SHIFT);
+  f.lck_retry = field<uint8_t>(fault_config1, FAULT_CONFIG1_LCK_RETRY_MASK, FAULT_CONFIG1_LCK_RETRY_SHIFT);
+  f.hw_lock_mode =
+    field<uint8_t>(fault_config2, FAULT_CONFIG2_HW_LOCK_ILIMIT_MODE_MASK, FAULT_CONFIG2_HW_LOCK_ILIMIT_MODE_SHIFT);
+  f.lock1_en = (fault_config2 & FAULT_CONFIG2_LOCK1_EN_MASK) != 0U;
+  f.lock2_en = (fault_config2 & FAULT_CONFIG2_LOCK2_EN_MASK) != 0U;
+  f.lock3_en = (fault_config2 & FAULT_CONFIG2_LOCK3_EN_MASK) != 0U;
+  f.lock_abn_speed =
+    field<uint8_t>(fault_config2, FAULT_CONFIG2_LOCK_ABN_SPEED_MASK, FAULT_CONFIG2_LOCK_ABN_SPEED_SHIFT);
+  f.abnormal_bemf_threshold =
+    field<uint8_t>(fault_config2, FAULT_CONFIG2_ABNORMAL_BEMF_THR_MASK, FAULT_CONFIG2_ABNORMAL_BEMF_THR_SHIFT);
+  f.no_motor_threshold = field<uint8_t>(fault_config2, FAULT_CONFIG2_NO_MTR_THR_MASK, FAULT_CONFIG2_NO_MTR_THR_SHIFT);
+}
+
+}  // namespace mcf8329a_core
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../mcf83xx_common/diagnostic_snapshot.h"
+#include "mcf8329a_poll_service.h"
+#include "mcf8329a_registers.h"
+#include "mcf8329a_service.h"
+
+namespace mcf8329a_core {
+
+// Register groups the fault publisher and diagnostic logs consume. A register
+// shared by several groups is still read once per poll.
+using mcf83xx_common::DiagnosticGroups;
+
+inline constexpr DiagnosticGroups DIAGNOSTIC_STATUS = 1U << 0;
+inline constexpr DiagnosticGroups DIAGNOSTIC_ALGORITHM_STATE = 1U << 1;
+inline constexpr DiagnosticGroups DIAGNOSTIC_SPEED_COMMAND = 1U << 2;
+inline constexpr DiagnosticGroups DIAGNOSTIC_MPET_BEMF = 1U << 3;
+inline constexpr DiagnosticGroups DIAGNOSTIC_HW_LOCK = 1U << 4;
+
+constexpr DiagnosticGroups diagnostic_groups(regs::RegisterId id) {
+  switch (id) {
+    case regs::RegisterId::CONTROLLER_FAULT_STATUS:
+    case regs::RegisterId::GATE_DRIVER_FAULT_STATUS:
+    case regs::RegisterId::ALGO_STATUS:
+      return DIAGNOSTIC_STATUS;
+    case regs::RegisterId::ALGORITHM_STATE:
+      return DIAGNOSTIC_ALGORITHM_STATE;
+    case regs::RegisterId::ALGO_DEBUG1:
+      return DIAGNOSTIC_SPEED_COMMAND | DIAGNOSTIC_MPET_BEMF | DIAGNOSTIC_HW_LOCK;
+    case regs::RegisterId::ALGO_DEBUG2:
+    case regs::RegisterId::PIN_CONFIG:
+    case regs::RegisterId::MTR_PARAMS:
+    case regs::RegisterId::CLOSED_LOOP2:
+    case regs::RegisterId::CLOSED_LOOP3:
+    case regs::RegisterId::CLOSED_LOOP4:
+      return DIAGNOSTIC_MPET_BEMF;
+    case regs::RegisterId::FAULT_CONFIG1:
+    case regs::RegisterId::FAULT_CONFIG2:
+      return DIAGNOSTIC_HW_LOCK;
+    default:
+      return 0;
+  }
+}
+
+// Fields decoded from the snapshot registers. A field is meaningful only when
+// MCF8329ADiagnosticSnapshot::complete() holds for its group.
+struct DiagnosticFields {
+  // DIAGNOSTIC_STATUS; each register is usable on its own.
+  bool gate_fault_valid{false};
+  bool controller_fault_valid{false};
+  bool algo_status_valid{false};
+  uint32_t gate_fault_status{0};
+  uint32_t controller_fault_status{0};
+  uint32_t algo_status{0};
+  bool fault_active{false};
+  bool mpet_bemf_active{false};
+  bool hw_lock_active{false};
+  float duty_percent{0.0f};
+  float volt_mag_percent{0.0f};
+  bool sys_enable{false};
+
+  // DIAGNOSTIC_ALGORITHM_STATE
+  uint16_t algorithm_state{0};
+
+  // DIAGNOSTIC_SPEED_COMMAND; -1 until ALGO_DEBUG1 is read.
+  float speed_cmd_percent{-1.0f};
+
+  // DIAGNOSTIC_MPET_BEMF
+  bool mpet_cmd{false};
+  bool mpet_ke{false};
+  bool mpet_mech{false};
+  bool mpet_write_shadow{false};
+  uint32_t brake_input{0};
+  uint32_t measured_bemf_const{0};
+  uint32_t configured_bemf_const{0};
+  uint32_t configured_motor_res{0};
+  uint32_t configured_motor_ind{0};
+  uint32_t configured_spd_loop_kp{0};
+  uint32_t configured_spd_loop_ki{0};
+  uint16_t configured_max_speed_code{0};
+  float configured_max_speed_hz{0.0f};
+
+  // DIAGNOSTIC_HW_LOCK
+  uint8_t ilimit{0};
+  uint8_t lock_ilimit{0};
+  uint8_t hw_lock_ilimit{0};
+  uint8_t lock_mode{0};
+  uint8_t mtr_lock_mode{0};
+  uint8_t hw_lock_mode{0};
+  uint8_t lck_retry{0};
+  bool lock1_en{false};
+  bool lock2_en{false};
+  bool lock3_en{false};
+  uint8_t lock_abn_speed{0};
+  uint8_t abnormal_bemf_threshold{0};
+  uint8_t no_motor_threshold{0};
+};
+
+struct MCF8329ADiagnosticTables : MCF8329APollTables {
+  static constexpr DiagnosticGroups groups(RegisterId id) { return diagnostic_groups(id); }
+};
+
+// The shared MCx83xx diagnostic snapshot over the MCF8329A group table, with
+// the snapshot registers decoded into fields() after every read.
+class MCF8329ADiagnosticSnapshot : public mcf83xx_common::DiagnosticSnapshot<MCF8329ADiagnosticTables> {
+ public:
+  void begin(const MCF8329APollService &poll);
+  void begin();
+  void require(const MCF8329AService &service, DiagnosticGroups groups);
+
+  const DiagnosticFields &fields() const { return this->fields_; }
+
+ protected:
+  using Base = mcf83xx_common::DiagnosticSnapshot<MCF8329ADiagnosticTables>;
+
+  void decode_();
+
+  DiagnosticFields fields_{};
+};
+
+}  // namespace mcf8329a_core
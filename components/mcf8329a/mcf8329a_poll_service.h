@@ -0,0 +1,49 @@
+#pragma once
+
+#include <cstdint>
+
+#include "../mcf83xx_common/poll_service.h"
+#include "mcf8329a_registers.h"
+#include "mcf8329a_service.h"
+
+namespace mcf8329a_core {
+
+using mcf83xx_common::POLL_TIER_COUNT;
+using mcf83xx_common::PollSchedule;
+using mcf83xx_common::PollTier;
+using mcf83xx_common::PollTierStats;
+
+constexpr PollTier poll_tier(regs::RegisterId id) {
+  switch (id) {
+    case regs::RegisterId::CONTROLLER_FAULT_STATUS:
+    case regs::RegisterId::GATE_DRIVER_FAULT_STATUS:
+    case regs::RegisterId::ALGO_STATUS:
+      return PollTier::STATUS;
+    case regs::RegisterId::FG_SPEED_FDBK:
+    case regs::RegisterId::SPEED_REF_OPEN_LOOP:
+    case regs::RegisterId::SPEED_FDBK:
+      return PollTier::SPEED;
+    case regs::RegisterId::MTR_PARAMS:
+    case regs::RegisterId::CLOSED_LOOP3:
+    case regs::RegisterId::CLOSED_LOOP4:
+    case regs::RegisterId::VM_VOLTAGE:
+      return PollTier::SLOW;
+    default:
+      return PollTier::NONE;
+  }
+}
+
+struct MCF8329APollTables {
+  using RegisterId = regs::RegisterId;
+  static constexpr size_t REGISTER_COUNT = regs::REGISTER_COUNT;
+  static constexpr const auto &DEFINITIONS = regs::REGISTER_DEFINITIONS;
+  static constexpr PollTier tier(RegisterId id) { return poll_tier(id); }
+  static constexpr RegisterId SPEED_FEEDBACK = RegisterId::SPEED_FDBK;
+};
+
+// The shared MCx83xx tiered poll over the MCF8329A register table.
+using MCF8329APollService = mcf83xx_common::PollService<MCF8329APollTables>;
+
+inline constexpr const auto &POLL_TIER_REGISTERS = MCF8329APollService::TIER_REGISTERS;
+
+}  // namespace mcf8329a_core
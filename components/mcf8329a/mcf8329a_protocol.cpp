@@ -33,6 +33,28 @@ float decode_open_to_closed_handoff_percent(uint8_t code) {
   return tables::OPEN_TO_CLOSED_HANDOFF_PERCENT[code & 0x1Fu];
 }
 
+float decode_closed_loop_rate_hz_per_s(uint8_t code) {
+  const uint8_t clamped = code & 0x1Fu;
+  if (clamped == regs::CLOSED_LOOP_RATE_NO_LIMIT_CODE) {
+    return 0.0f;
+  }
+  return tables::CLOSED_LOOP_RATE_HZ_PER_S[clamped];
+}
+
+uint8_t encode_closed_loop_rate_code(float hz_per_s) {
+  if (!(hz_per_s > 0.0f)) {
+    return regs::CLOSED_LOOP_RATE_NO_LIMIT_CODE;
+  }
+  uint8_t code = 0;
+  for (uint8_t i = 1; i < regs::CLOSED_LOOP_RATE_NO_LIMIT_CODE; i++) {
+    if (tables::CLOSED_LOOP_RATE_HZ_PER_S[i] > hz_per_s) {
+      break;
+    }
+    code = i;
+  }
+  return code;
+}
+
 const char *mode_to_string(uint8_t mode) {
   switch (mode) {
     case 0:
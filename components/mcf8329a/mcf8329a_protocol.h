@@ -21,8 +21,17 @@ inline constexpr uint32_t PERI_CONFIG1_DIR_INPUT_CCW = (0x2u << 19);
 inline constexpr uint32_t ALGO_DEBUG1_OVERRIDE_MASK = (1u << 31);
 inline constexpr uint32_t ALGO_DEBUG1_DIGITAL_SPEED_CTRL_MASK = (0x7FFFu << 16);
 
+inline constexpr uint32_t ALGO_CTRL1_EEPROM_WRT_MASK = (1u << 31);
+inline constexpr uint32_t ALGO_CTRL1_EEPROM_READ_MASK = (1u << 30);
 inline constexpr uint32_t ALGO_CTRL1_CLR_FLT_MASK = (1u << 29);
+inline constexpr uint32_t ALGO_CTRL1_CLR_FLT_RETRY_COUNT_MASK = (1u << 28);
+inline constexpr uint32_t ALGO_CTRL1_EEPROM_WRITE_ACCESS_KEY_MASK = (0xFFu << 20);
 inline constexpr uint32_t ALGO_CTRL1_WATCHDOG_TICKLE_MASK = (1u << 10);
+// One-shot command fields; a write that only means to tickle must leave them 0.
+inline constexpr uint32_t ALGO_CTRL1_COMMAND_MASK = ALGO_CTRL1_EEPROM_WRT_MASK | ALGO_CTRL1_EEPROM_READ_MASK |
+                                                    ALGO_CTRL1_CLR_FLT_MASK | ALGO_CTRL1_CLR_FLT_RETRY_COUNT_MASK |
+                                                    ALGO_CTRL1_EEPROM_WRITE_ACCESS_KEY_MASK |
+                                                    ALGO_CTRL1_WATCHDOG_TICKLE_MASK;
 inline constexpr uint32_t ALGO_DEBUG2_MPET_CMD_MASK = (1u << 5);
 inline constexpr uint32_t ALGO_DEBUG2_MPET_KE_MASK = (1u << 2);
 inline constexpr uint32_t ALGO_DEBUG2_MPET_MECH_MASK = (1u << 1);
@@ -64,6 +73,13 @@ inline constexpr uint32_t MOTOR_STARTUP2_OPN_CL_HANDOFF_THR_SHIFT = 13;
 inline constexpr uint32_t MOTOR_STARTUP2_THETA_ERROR_RAMP_RATE_MASK = (0x7u << 0);
 inline constexpr uint32_t MOTOR_STARTUP2_THETA_ERROR_RAMP_RATE_SHIFT = 0;
 
+inline constexpr uint32_t CLOSED_LOOP1_CL_ACC_MASK = (0x1Fu << 25);
+inline constexpr uint32_t CLOSED_LOOP1_CL_ACC_SHIFT = 25;
+inline constexpr uint32_t CLOSED_LOOP1_CL_DEC_CONFIG_MASK = (1u << 24);
+inline constexpr uint32_t CLOSED_LOOP1_CL_DEC_MASK = (0x1Fu << 19);
+inline constexpr uint32_t CLOSED_LOOP1_CL_DEC_SHIFT = 19;
+inline constexpr uint8_t CLOSED_LOOP_RATE_NO_LIMIT_CODE = 0x1Fu;
+
 inline constexpr uint32_t CLOSED_LOOP2_MTR_STOP_MASK = (0x7u << 28);
 inline constexpr uint32_t CLOSED_LOOP2_MTR_STOP_SHIFT = 28;
 inline constexpr uint32_t CLOSED_LOOP2_MTR_STOP_BRK_TIME_MASK = (0xFu << 24);
@@ -167,6 +183,11 @@ float decode_speed_hz(int32_t raw, float max_speed_hz);
 float decode_fg_speed_hz(uint32_t raw, float max_speed_hz);
 float decode_open_loop_accel_hz_per_s(uint8_t code);
 float decode_open_to_closed_handoff_percent(uint8_t code);
+// Returns 0 for CLOSED_LOOP_RATE_NO_LIMIT_CODE.
+float decode_closed_loop_rate_hz_per_s(uint8_t code);
+// Fastest CL_ACC/CL_DEC code that does not exceed `hz_per_s` (the slowest
+// code for smaller rates); non-positive rates select "no limit".
+uint8_t encode_closed_loop_rate_code(float hz_per_s);
 const char *mode_to_string(uint8_t mode);
 const char *align_time_to_string(uint8_t code);
 const char *brake_mode_to_string(uint8_t code);
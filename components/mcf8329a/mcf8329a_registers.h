@@ -23,6 +23,7 @@ enum class RegisterId : uint8_t {
   PERI_CONFIG1,
   MOTOR_STARTUP1,
   MOTOR_STARTUP2,
+  CLOSED_LOOP1,
   CLOSED_LOOP2,
   CLOSED_LOOP3,
   CLOSED_LOOP4,
@@ -58,6 +59,7 @@ inline constexpr std::array<RegisterInfo, REGISTER_COUNT> REGISTER_DEFINITIONS{{
     {.id = RegisterId::PERI_CONFIG1, .name = "peripheral_config_1", .address = 0x00AA, .width = RegisterWidth::U32},
     {.id = RegisterId::MOTOR_STARTUP1, .name = "motor_startup_1", .address = 0x0084, .width = RegisterWidth::U32},
     {.id = RegisterId::MOTOR_STARTUP2, .name = "motor_startup_2", .address = 0x0086, .width = RegisterWidth::U32},
+    {.id = RegisterId::CLOSED_LOOP1, .name = "closed_loop_1", .address = 0x0088, .width = RegisterWidth::U32},
     {.id = RegisterId::CLOSED_LOOP2, .name = "closed_loop_2", .address = 0x008A, .width = RegisterWidth::U32},
     {.id = RegisterId::CLOSED_LOOP3, .name = "closed_loop_3", .address = 0x008C, .width = RegisterWidth::U32},
     {.id = RegisterId::CLOSED_LOOP4, .name = "closed_loop_4", .address = 0x008E, .width = RegisterWidth::U32},
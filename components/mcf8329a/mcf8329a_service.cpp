@@ -4,6 +4,39 @@ namespace mcf8329a_core {
 
 using namespace regs;
 
+ClosedLoopRampCodes closed_loop_ramp_codes(uint32_t closed_loop4, float up_percent_per_s, float down_percent_per_s) {
+  const uint16_t max_speed_code =
+    static_cast<uint16_t>((closed_loop4 & CLOSED_LOOP4_MAX_SPEED_MASK) >> CLOSED_LOOP4_MAX_SPEED_SHIFT);
+  const float max_speed_hz = decode_max_speed_hz(max_speed_code);
+  return {
+    .acc = encode_closed_loop_rate_code(up_percent_per_s * max_speed_hz / 100.0f),
+    .dec = encode_closed_loop_rate_code(down_percent_per_s * max_speed_hz / 100.0f),
+  };
+}
+
+namespace {
+
+constexpr uint32_t TUNING_DEVICE_ID = 0x8329A000U;
+
+// Settings that shape startup and closed-loop behaviour. Brake, direction and
+// speed registers are left out: they change at runtime.
+constexpr mcf83xx_common::FingerprintRegister TUNING_FINGERPRINT_REGISTERS[] = {
+    {register_address(RegisterId::MOTOR_STARTUP1), 0xFFFFFFFFU},
+    {register_address(RegisterId::MOTOR_STARTUP2), ~TUNED_MOTOR_STARTUP2_MASK},
+    {register_address(RegisterId::CLOSED_LOOP1), 0xFFFFFFFFU},
+    {register_address(RegisterId::CLOSED_LOOP2), 0xFFFFFFFFU},
+    {register_address(RegisterId::CLOSED_LOOP3), ~TUNED_CLOSED_LOOP3_MASK},
+    {register_address(RegisterId::CLOSED_LOOP4), ~TUNED_CLOSED_LOOP4_MASK},
+    {register_address(RegisterId::FAULT_CONFIG1), ~TUNED_FAULT_CONFIG1_MASK},
+    {register_address(RegisterId::FAULT_CONFIG2), ~TUNED_FAULT_CONFIG2_MASK},
+    {register_address(RegisterId::GD_CONFIG1), 0xFFFFFFFFU},
+    {register_address(RegisterId::GD_CONFIG2), 0xFFFFFFFFU},
+    {register_address(RegisterId::INT_ALGO_1), 0xFFFFFFFFU},
+    {register_address(RegisterId::INT_ALGO_2), ~TUNED_INT_ALGO_2_MASK},
+};
+
+}  // namespace
+
 bool MCF8329AService::read_reg32(RegisterId id, uint32_t &value) const {
   return this->registers_.read32(register_address(id), value);
 }
@@ -85,11 +118,8 @@ bool MCF8329AService::read_direction_input(uint8_t &direction_input_code) const
 }
 
 bool MCF8329AService::write_speed_command_raw(uint16_t digital_speed_ctrl) const {
-  const uint16_t clamped = digital_speed_ctrl & 0x7FFFu;
-  const uint32_t value =
-    ALGO_DEBUG1_OVERRIDE_MASK | ((static_cast<uint32_t>(clamped) << 16) & ALGO_DEBUG1_DIGITAL_SPEED_CTRL_MASK);
   return this->update_bits32(
-    RegisterId::ALGO_DEBUG1, ALGO_DEBUG1_OVERRIDE_MASK | ALGO_DEBUG1_DIGITAL_SPEED_CTRL_MASK, value
+    RegisterId::ALGO_DEBUG1, mcf83xx_common::SPEED_COMMAND_MASK, mcf83xx_common::speed_command_value(digital_speed_ctrl)
   );
 }
 
@@ -97,6 +127,14 @@ bool MCF8329AService::release_speed_override() const {
   return this->update_bits32(RegisterId::ALGO_DEBUG1, ALGO_DEBUG1_OVERRIDE_MASK, 0u);
 }
 
+bool MCF8329AService::set_closed_loop_ramp(uint8_t acc_code, uint8_t dec_code) const {
+  const uint32_t value = ((static_cast<uint32_t>(acc_code) << CLOSED_LOOP1_CL_ACC_SHIFT) & CLOSED_LOOP1_CL_ACC_MASK) |
+                         ((static_cast<uint32_t>(dec_code) << CLOSED_LOOP1_CL_DEC_SHIFT) & CLOSED_LOOP1_CL_DEC_MASK);
+  return this->update_bits32(
+    RegisterId::CLOSED_LOOP1, CLOSED_LOOP1_CL_ACC_MASK | CLOSED_LOOP1_CL_DEC_CONFIG_MASK | CLOSED_LOOP1_CL_DEC_MASK, value
+  );
+}
+
 bool MCF8329AService::set_mpet_characterization_bits() const {
   return this->update_bits32(RegisterId::ALGO_DEBUG2, ALGO_DEBUG2_MPET_RUN_MASK, ALGO_DEBUG2_MPET_RUN_MASK);
 }
@@ -110,8 +148,19 @@ bool MCF8329AService::pulse_clear_faults() const {
   return this->registers_.pulse_bits32(register_address(RegisterId::ALGO_CTRL1), ALGO_CTRL1_CLR_FLT_MASK, 2000U, 2000U);
 }
 
-bool MCF8329AService::pulse_watchdog_tickle() const {
-  return this->registers_.pulse_bits32(register_address(RegisterId::ALGO_CTRL1), ALGO_CTRL1_WATCHDOG_TICKLE_MASK);
+bool MCF8329AService::read_watchdog_tickle_base(uint32_t &algo_ctrl1) const {
+  if (!this->read_reg32(RegisterId::ALGO_CTRL1, algo_ctrl1)) {
+    return false;
+  }
+  algo_ctrl1 &= ~ALGO_CTRL1_COMMAND_MASK;
+  return true;
+}
+
+bool MCF8329AService::tickle_watchdog(uint32_t algo_ctrl1_base) const {
+  // The device clears WATCHDOG_TICKLE itself, so no second write is needed.
+  return this->write_reg32(
+    RegisterId::ALGO_CTRL1, (algo_ctrl1_base & ~ALGO_CTRL1_COMMAND_MASK) | ALGO_CTRL1_WATCHDOG_TICKLE_MASK
+  );
 }
 
 bool MCF8329AService::clear_mpet_bits(bool *changed, uint32_t *before, uint32_t *after) const {
@@ -147,4 +196,19 @@ bool MCF8329AService::clear_mpet_bits(bool *changed, uint32_t *before, uint32_t
   return true;
 }
 
+bool MCF8329AService::read_configuration_fingerprint(uint32_t config_hash, uint32_t &fingerprint) const {
+  return mcf83xx_common::read_configuration_fingerprint(
+      this->registers_, TUNING_DEVICE_ID, config_hash, TUNING_FINGERPRINT_REGISTERS,
+      sizeof(TUNING_FINGERPRINT_REGISTERS) / sizeof(TUNING_FINGERPRINT_REGISTERS[0]), fingerprint);
+}
+
+bool MCF8329AService::record_tuned_field(mcf83xx_common::TuningRecord &record, RegisterId id, uint32_t mask) const {
+  uint32_t value = 0;
+  return this->read_reg32(id, value) && mcf83xx_common::add_tuned_field(record, register_address(id), mask, value);
+}
+
+bool MCF8329AService::apply_tuning_record(const mcf83xx_common::TuningRecord &record) const {
+  return mcf83xx_common::apply_tuning_record(this->registers_, record);
+}
+
 }  // namespace mcf8329a_core
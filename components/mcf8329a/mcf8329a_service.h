@@ -3,11 +3,46 @@
 #include <cstdint>
 
 #include "../mcf83xx_common/register_access.h"
+#include "../mcf83xx_common/speed_command.h"
+#include "../mcf83xx_common/tuning_record.h"
 #include "mcf8329a_bus.h"
 #include "mcf8329a_protocol.h"
 
 namespace mcf8329a_core {
 
+// The speed command encoding and ramp are shared with the rest of the family.
+using mcf83xx_common::speed_command_step;
+using mcf83xx_common::speed_ramp_step;
+static_assert(regs::ALGO_DEBUG1_OVERRIDE_MASK == mcf83xx_common::SPEED_OVERRIDE_MASK);
+static_assert(regs::ALGO_DEBUG1_DIGITAL_SPEED_CTRL_MASK == mcf83xx_common::DIGITAL_SPEED_CTRL_MASK);
+
+// CL_ACC/CL_DEC codes for ramp rates in percent of MAX_SPEED per second,
+// with MAX_SPEED taken from a CLOSED_LOOP4 value.
+struct ClosedLoopRampCodes {
+  uint8_t acc{0};
+  uint8_t dec{0};
+};
+ClosedLoopRampCodes closed_loop_ramp_codes(uint32_t closed_loop4, float up_percent_per_s, float down_percent_per_s);
+
+// Register fields the initial tune and MPET write. A persisted tuning result
+// owns them, so the configuration fingerprint leaves them out.
+inline constexpr uint32_t TUNED_FAULT_CONFIG1_MASK = regs::FAULT_CONFIG1_ILIMIT_MASK |
+                                                     regs::FAULT_CONFIG1_LOCK_ILIMIT_MASK |
+                                                     regs::FAULT_CONFIG1_HW_LOCK_ILIMIT_MASK |
+                                                     regs::FAULT_CONFIG1_LOCK_ILIMIT_DEG_MASK;
+inline constexpr uint32_t TUNED_FAULT_CONFIG2_MASK =
+  regs::FAULT_CONFIG2_HW_LOCK_ILIMIT_DEG_MASK | regs::FAULT_CONFIG2_LOCK2_EN_MASK;
+inline constexpr uint32_t TUNED_MOTOR_STARTUP2_MASK =
+  regs::MOTOR_STARTUP2_OL_ILIMIT_MASK | regs::MOTOR_STARTUP2_OL_ACC_A1_MASK | regs::MOTOR_STARTUP2_OL_ACC_A2_MASK |
+  regs::MOTOR_STARTUP2_AUTO_HANDOFF_EN_MASK | regs::MOTOR_STARTUP2_OPN_CL_HANDOFF_THR_MASK |
+  regs::MOTOR_STARTUP2_THETA_ERROR_RAMP_RATE_MASK;
+inline constexpr uint32_t TUNED_INT_ALGO_2_MASK = regs::INT_ALGO_2_CL_SLOW_ACC_MASK;
+inline constexpr uint32_t TUNED_CLOSED_LOOP3_MASK =
+  regs::CLOSED_LOOP3_MOTOR_BEMF_CONST_MASK | regs::CLOSED_LOOP3_CURR_LOOP_KP_MASK |
+  regs::CLOSED_LOOP3_CURR_LOOP_KI_MASK | regs::CLOSED_LOOP3_SPD_LOOP_KP_MSB_MASK;
+inline constexpr uint32_t TUNED_CLOSED_LOOP4_MASK =
+  regs::CLOSED_LOOP4_SPD_LOOP_KP_LSB_MASK | regs::CLOSED_LOOP4_SPD_LOOP_KI_MASK;
+
 class MCF8329AService {
  public:
   explicit MCF8329AService(RegisterBus *bus) : registers_(bus, 100U) {}
@@ -30,12 +65,27 @@ class MCF8329AService {
   bool read_direction_input(uint8_t &direction_input_code) const;
   bool write_speed_command_raw(uint16_t digital_speed_ctrl) const;
   bool release_speed_override() const;
+  // Programs the device's closed-loop reference slew (CLOSED_LOOP1.CL_ACC /
+  // CL_DEC) so a single speed write ramps in firmware.
+  bool set_closed_loop_ramp(uint8_t acc_code, uint8_t dec_code) const;
   bool set_mpet_characterization_bits() const;
   bool write_mpet_results_to_shadow() const;
   bool pulse_clear_faults() const;
-  bool pulse_watchdog_tickle() const;
+  // ALGO_CTRL1 without its one-shot command fields: the image a tickle
+  // rewrites so FORCED_ALIGN_ANGLE and FLUX_MODE_REFERENCE keep their values.
+  bool read_watchdog_tickle_base(uint32_t &algo_ctrl1) const;
+  // Tickles the external watchdog with a single ALGO_CTRL1 write.
+  bool tickle_watchdog(uint32_t algo_ctrl1_base) const;
   bool clear_mpet_bits(bool *changed = nullptr, uint32_t *before = nullptr, uint32_t *after = nullptr) const;
 
+  // Fingerprint persisted tuning results are keyed by: the startup and
+  // closed-loop configuration registers minus the tuned fields, seeded with
+  // `config_hash`. Read after the configured settings are applied.
+  bool read_configuration_fingerprint(uint32_t config_hash, uint32_t &fingerprint) const;
+  // Adds the current `mask` bits of `id` to `record`.
+  bool record_tuned_field(mcf83xx_common::TuningRecord &record, RegisterId id, uint32_t mask) const;
+  bool apply_tuning_record(const mcf83xx_common::TuningRecord &record) const;
+
  private:
   mcf83xx_common::RegisterAccess registers_;
 };
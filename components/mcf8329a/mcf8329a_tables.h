@@ -223,5 +223,14 @@ static constexpr float MPET_OPEN_LOOP_SLEW_HZ_PER_S[8] = {
   0.1f, 0.5f, 1.0f, 2.0f, 3.0f, 5.0f, 10.0f, 20.0f,
 };
 
+// Key: CLOSED_LOOP1.CL_ACC / CL_DEC field code [0..30]; code 31 is "no limit".
+// Value: reference slew rate in Hz/s (speed mode).
+static constexpr float CLOSED_LOOP_RATE_HZ_PER_S[31] = {
+  0.5f,    1.0f,    2.5f,    5.0f,    7.5f,    10.0f,   20.0f,   40.0f,
+  60.0f,   80.0f,   100.0f,  200.0f,  300.0f,  400.0f,  500.0f,  600.0f,
+  700.0f,  800.0f,  900.0f,  1000.0f, 2000.0f, 4000.0f, 6000.0f, 8000.0f,
+  10000.0f,20000.0f,30000.0f,40000.0f,50000.0f,60000.0f,70000.0f,
+};
+
 }  // namespace tables
 }  // namespace mcf8329a_core
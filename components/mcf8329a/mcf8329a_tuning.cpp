@@ -2,6 +2,7 @@
 
 #include "mcf8329a.h"
 #include "mcf8329a_tables.h"
+#include "mcf8329a_tuning_service.h"
 
 #include <algorithm>
 #include <cmath>
@@ -18,66 +19,20 @@ namespace mcf8329a {
 
 using namespace ::mcf8329a_core::regs;
 namespace tables = ::mcf8329a_core::tables;
+using ::mcf8329a_core::TuneCandidate;
+using ::mcf8329a_core::TuneEvent;
+using ::mcf8329a_core::TuneEventType;
+using ::mcf8329a_core::TuneStage;
 
 static const char* const TUNING_TAG = "mcf8329a";
-struct InitialTuneCandidate {
-  uint8_t phase_ilimit_code;
-  uint8_t lock_ilimit_code;
-  uint8_t hw_lock_ilimit_code;
-  uint8_t open_loop_ilimit_code;
-  uint8_t open_loop_accel_a1_code;
-  uint8_t open_loop_accel_a2_code;
-  uint8_t handoff_code;
-  uint8_t theta_error_ramp_code;
-  uint8_t cl_slow_acc_code;
-  uint8_t lock_ilimit_deglitch_code;
-  uint8_t hw_lock_ilimit_deglitch_code;
-  bool auto_handoff_enable;
-  bool abn_bemf_lock_enable;
-};
-
-static const InitialTuneCandidate TUNING_INITIAL_TUNE_CANDIDATES[] = {
-  // Baseline: manual handoff at 14%, higher OL accel (250Hz/s).
-  {6u, 6u, 6u, 3u, 10u, 0u, 13u, 2u, 4u, 8u, 7u, false, false},
-  // Faster OL accel variant (500Hz/s) at same handoff.
-  {6u, 6u, 6u, 3u, 11u, 0u, 13u, 2u, 4u, 8u, 7u, false, false},
-  // Slightly later handoff with baseline accel.
-  {6u, 6u, 6u, 3u, 10u, 0u, 15u, 2u, 4u, 8u, 7u, false, false},
-  // Conservative fallback: lower accel with earlier handoff.
-  {6u, 6u, 6u, 3u, 9u, 0u, 11u, 2u, 4u, 8u, 7u, false, false},
-};
-static constexpr size_t TUNING_INITIAL_TUNE_CANDIDATE_COUNT =
-  sizeof(TUNING_INITIAL_TUNE_CANDIDATES) / sizeof(TUNING_INITIAL_TUNE_CANDIDATES[0]);
 
-struct MCF8329ATuningController::Impl {
+struct MCF8329ATuningController::Impl : public ::mcf8329a_core::TuneActuator,
+                                        public ::mcf8329a_core::TuneObserver {
  public:
-  explicit Impl(MCF8329AComponent* parent) : parent_(parent) {}
+  explicit Impl(MCF8329AComponent* parent) : parent_(parent), initial_tune_(this, this) {}
 
   void reset() {
-    this->initial_tune_active_ = false;
-    this->initial_tune_stage_ = InitialTuneStage::IDLE;
-    this->initial_tune_candidate_index_ = 0u;
-    this->initial_tune_stage_started_ms_ = 0u;
-    this->initial_tune_waiting_fault_recovery_ = false;
-    this->initial_tune_mpet_wait_logged_ = false;
-    this->initial_tune_last_fault_clear_ms_ = 0u;
-    this->initial_tune_closed_loop_seen_ = false;
-    this->initial_tune_closed_loop_seen_ms_ = 0u;
-    this->current_candidate_start_ms_ = 0u;
-    this->current_candidate_reach_ms_ = INITIAL_TUNE_MONITOR_TIMEOUT_MS;
-    this->current_candidate_monitor_timeout_ms_ = INITIAL_TUNE_MONITOR_TIMEOUT_MS;
-    this->current_candidate_open_loop_dwell_timeout_ms_ = INITIAL_TUNE_MONITOR_TIMEOUT_MS;
-    this->handoff_unstable_counter_ = 0u;
-    this->handoff_stable_counter_ = 0u;
-    this->handoff_telemetry_miss_counter_ = 0u;
-    this->refinement_active_ = false;
-    this->refinement_candidate_index_ = 0u;
-    this->refinement_candidate_count_ = 0u;
-    this->refinement_best_candidate_valid_ = false;
-    this->refinement_best_score_ = std::numeric_limits<int32_t>::min();
-    this->refinement_best_reach_ms_ = INITIAL_TUNE_MONITOR_TIMEOUT_MS;
-    this->current_candidate_metrics_ = CandidateQualityMetrics{};
-    this->refinement_best_metrics_ = CandidateQualityMetrics{};
+    this->initial_tune_.reset();
     this->mpet_characterization_active_ = false;
     this->mpet_characterization_started_ms_ = 0u;
     this->mpet_last_status_log_ms_ = 0u;
@@ -111,38 +66,9 @@ struct MCF8329ATuningController::Impl {
       );
     }
 
-    this->initial_tune_active_ = true;
-    this->initial_tune_stage_ = InitialTuneStage::APPLY;
-    this->initial_tune_candidate_index_ = 0u;
-    this->initial_tune_stage_started_ms_ = millis();
-    this->initial_tune_waiting_fault_recovery_ = false;
-    this->initial_tune_mpet_wait_logged_ = false;
-    this->initial_tune_last_fault_clear_ms_ = 0u;
-    this->initial_tune_closed_loop_seen_ = false;
-    this->initial_tune_closed_loop_seen_ms_ = 0u;
-    this->current_candidate_start_ms_ = 0u;
-    this->current_candidate_reach_ms_ = INITIAL_TUNE_MONITOR_TIMEOUT_MS;
-    this->current_candidate_monitor_timeout_ms_ = INITIAL_TUNE_MONITOR_TIMEOUT_MS;
-    this->current_candidate_open_loop_dwell_timeout_ms_ = INITIAL_TUNE_MONITOR_TIMEOUT_MS;
-    this->handoff_unstable_counter_ = 0u;
-    this->handoff_stable_counter_ = 0u;
-    this->handoff_telemetry_miss_counter_ = 0u;
-    this->refinement_active_ = false;
-    this->refinement_candidate_index_ = 0u;
-    this->refinement_candidate_count_ = 0u;
-    this->refinement_best_candidate_valid_ = false;
-    this->refinement_best_score_ = std::numeric_limits<int32_t>::min();
-    this->refinement_best_reach_ms_ = INITIAL_TUNE_MONITOR_TIMEOUT_MS;
-    this->current_candidate_metrics_ = CandidateQualityMetrics{};
-    this->refinement_best_metrics_ = CandidateQualityMetrics{};
-
-    ESP_LOGI(
-      TUNING_TAG,
-      "Initial tune started: %u discovery candidate(s), target speed %.1f%%",
-      static_cast<unsigned>(TUNING_INITIAL_TUNE_CANDIDATE_COUNT),
-      INITIAL_TUNE_SPEED_PERCENT
-    );
-    ESP_LOGI(TUNING_TAG, "Initial tune will run a refinement sweep after first success (manual-handoff candidates)");
+    this->initial_tune_.set_fallback_max_speed_hz(this->fallback_max_speed_hz_());
+    this->initial_tune_.set_search(this->parent_->tune_search_);
+    this->initial_tune_.start(millis());
   }
 
   void start_mpet_characterization() {
@@ -150,7 +76,7 @@ struct MCF8329ATuningController::Impl {
       ESP_LOGW(TUNING_TAG, "MPET characterization requested before communications are ready");
       return;
     }
-    if (this->initial_tune_active_) {
+    if (this->initial_tune_.active()) {
       ESP_LOGW(TUNING_TAG, "MPET characterization blocked while initial tuning is active");
       return;
     }
@@ -216,87 +142,274 @@ struct MCF8329ATuningController::Impl {
       return;
     }
     const uint32_t now = millis();
-    if (this->initial_tune_active_) {
-      this->process_initial_tune_(fault_active, now);
+    if (this->initial_tune_.active()) {
+      this->initial_tune_.update(this->parent_->service_, fault_active, now);
     }
     if (this->mpet_characterization_active_) {
       this->process_mpet_characterization_(fault_active, now);
     }
   }
 
+  bool start_motor(float percent, const char* reason) override {
+    return this->parent_->apply_speed_command_(percent, reason, true);
+  }
+
+  void stop_motor(const char* reason) override { this->clear_runtime_speed_command_(reason); }
+
+  void clear_faults() override { this->parent_->pulse_clear_faults(); }
+
+  void clear_mpet_bits(const char* reason) override { (void)this->parent_->clear_mpet_bits_(reason); }
+
+  bool speed_locked_out() const override { return this->parent_->severe_fault_speed_lockout_; }
+
+  void on_tune_event(const TuneEvent& event) override {
+    const char* phase = event.refinement ? "fine" : "coarse";
+    const unsigned number = event.candidate_number;
+    const unsigned count = event.candidate_count;
+    switch (event.type) {
+      case TuneEventType::STARTED:
+        ESP_LOGI(
+          TUNING_TAG,
+          "Initial tune started: %u coarse candidate(s), target speed %.1f%%",
+          count,
+          ::mcf8329a_core::MCF8329AInitialTuneService::SPEED_PERCENT
+        );
+        ESP_LOGI(
+          TUNING_TAG,
+          "Initial tune will run up to %u fine pass(es) around the best candidate; early termination %s",
+          static_cast<unsigned>(this->initial_tune_.search().fine_passes),
+          ONOFF(this->initial_tune_.search().early_termination)
+        );
+        break;
+      case TuneEventType::CANDIDATE_APPLY:
+        ESP_LOGI(TUNING_TAG, "Initial tune %s candidate %u/%u", phase, number, count);
+        this->log_tune_candidate_(*event.candidate, "Initial tune candidate values:");
+        break;
+      case TuneEventType::WAITING_MPET_EXIT:
+        ESP_LOGI(
+          TUNING_TAG,
+          "Initial tune waiting for MPET state to exit: 0x%04X(%s)",
+          static_cast<unsigned>(event.algo_state),
+          this->parent_->algorithm_state_to_string_(event.algo_state)
+        );
+        break;
+      case TuneEventType::MONITOR_STARTED:
+        ESP_LOGI(
+          TUNING_TAG,
+          "Initial tune %s candidate %u/%u monitor timeout=%ums open_loop_dwell_timeout=%ums",
+          phase,
+          number,
+          count,
+          static_cast<unsigned>(event.monitor_timeout_ms),
+          static_cast<unsigned>(event.dwell_timeout_ms)
+        );
+        break;
+      case TuneEventType::CLOSED_LOOP_ENTERED:
+        ESP_LOGI(
+          TUNING_TAG,
+          "Initial tune %s candidate %u/%u entered %s (reach=%ums)",
+          phase,
+          number,
+          count,
+          this->parent_->algorithm_state_to_string_(event.algo_state),
+          static_cast<unsigned>(event.reach_ms)
+        );
+        break;
+      case TuneEventType::UNSTABLE_SAMPLE:
+        ESP_LOGW(
+          TUNING_TAG,
+          "Initial tune handoff guard: unstable sample %u/%u cmd=%.1fHz ref_ol=%.1fHz fdbk=%.1fHz fg=%.1fHz",
+          static_cast<unsigned>(event.sample),
+          static_cast<unsigned>(event.sample_limit),
+          event.commanded_hz,
+          event.ref_ol_hz,
+          event.fdbk_hz,
+          event.fg_hz
+        );
+        break;
+      case TuneEventType::TELEMETRY_MISS:
+        ESP_LOGW(
+          TUNING_TAG,
+          "Initial tune handoff guard: speed telemetry unavailable sample %u/%u",
+          static_cast<unsigned>(event.sample),
+          static_cast<unsigned>(event.sample_limit)
+        );
+        break;
+      case TuneEventType::CANDIDATE_SUCCEEDED:
+        ESP_LOGI(
+          TUNING_TAG,
+          "Initial tune candidate success: reach=%ums score=%d accel=%.2fHz/s handoff=%.1f%% "
+          "handoff_samples=%u avg_track=%.1fHz avg_mismatch=%.1fHz peak_ratio=%.2f",
+          static_cast<unsigned>(event.reach_ms),
+          static_cast<int>(event.score),
+          this->parent_->service_.decode_open_loop_accel_hz_per_s(event.candidate->open_loop_accel_a1_code),
+          this->parent_->service_.decode_open_to_closed_handoff_percent(event.candidate->handoff_code),
+          static_cast<unsigned>(event.metrics->sample_count),
+          ::mcf8329a_core::candidate_avg_tracking_error_hz(*event.metrics),
+          ::mcf8329a_core::candidate_avg_mismatch_error_hz(*event.metrics),
+          event.metrics->peak_speed_ratio
+        );
+        break;
+      case TuneEventType::CANDIDATE_FAILED:
+        ESP_LOGW(TUNING_TAG, "Initial tune %s candidate %u/%u failed: %s", phase, number, count, event.reason);
+        break;
+      case TuneEventType::CANDIDATE_PRUNED:
+        ESP_LOGI(
+          TUNING_TAG,
+          "Initial tune %s candidate %u/%u stopped early: best achievable score %d %s",
+          phase,
+          number,
+          count,
+          static_cast<int>(event.score),
+          event.reason
+        );
+        break;
+      case TuneEventType::REFINEMENT_STARTED:
+        ESP_LOGI(
+          TUNING_TAG,
+          "Initial tune best so far reached closed-loop in %ums (score=%d); starting fine pass %u (%u candidate(s))",
+          static_cast<unsigned>(event.reach_ms),
+          static_cast<int>(event.score),
+          static_cast<unsigned>(event.pass),
+          count
+        );
+        break;
+      case TuneEventType::COOLDOWN_SKIPPED:
+        ESP_LOGD(TUNING_TAG, "Initial tune skipping cooldown: candidate never drove the motor");
+        break;
+      case TuneEventType::WAITING_FAULT_RECOVERY:
+        ESP_LOGW(
+          TUNING_TAG,
+          "Initial tune waiting for fault recovery before retrying candidate: "
+          "fault_active=%s lockout=%s",
+          YESNO(event.fault_active),
+          YESNO(event.locked_out)
+        );
+        break;
+      case TuneEventType::FAULT_RECOVERED:
+        ESP_LOGI(TUNING_TAG, "Initial tune fault recovery complete; resuming candidate sweep");
+        break;
+      case TuneEventType::TUNE_SUCCEEDED:
+        this->log_tune_report_(event);
+        this->log_tune_candidate_(
+          *event.candidate,
+          "Initial tune success: copy these keys into your YAML under mcf8329a:"
+        );
+        this->commit_initial_tune_(*event.candidate);
+        break;
+      case TuneEventType::TUNE_FAILED:
+        ESP_LOGW(
+          TUNING_TAG,
+          "Initial tune failed: no coarse candidate reached closed-loop at %.1f%% command",
+          ::mcf8329a_core::MCF8329AInitialTuneService::SPEED_PERCENT
+        );
+        this->log_tune_report_(event);
+        break;
+    }
+  }
+
  private:
-  enum class InitialTuneStage : uint8_t {
-    IDLE = 0,
-    APPLY = 1,
-    START = 2,
-    MONITOR = 3,
-    COOLDOWN = 4,
-  };
-
-  struct CandidateQualityMetrics {
-    uint16_t sample_count{0u};
-    uint16_t telemetry_miss_count{0u};
-    uint16_t unstable_count{0u};
-    float tracking_error_sum_hz{0.0f};
-    float mismatch_error_sum_hz{0.0f};
-    float peak_speed_ratio{0.0f};
-  };
-
-  static constexpr float INITIAL_TUNE_SPEED_PERCENT = 11.0f;
-  static constexpr uint32_t INITIAL_TUNE_SETTLE_MS = 250u;
-  static constexpr uint32_t INITIAL_TUNE_MONITOR_TIMEOUT_MS = 7000u;
-  static constexpr uint32_t INITIAL_TUNE_MONITOR_TIMEOUT_MIN_MS = 7000u;
-  static constexpr uint32_t INITIAL_TUNE_MONITOR_TIMEOUT_MAX_MS = 45000u;
-  static constexpr float INITIAL_TUNE_MONITOR_TIMEOUT_SCALE = 1.6f;
-  static constexpr uint32_t INITIAL_TUNE_MONITOR_TIMEOUT_MARGIN_MS = 2500u;
-  static constexpr uint32_t INITIAL_TUNE_OPEN_LOOP_DWELL_TIMEOUT_MIN_MS = 2000u;
-  static constexpr uint32_t INITIAL_TUNE_OPEN_LOOP_DWELL_TIMEOUT_MAX_MS = 12000u;
-  static constexpr float INITIAL_TUNE_OPEN_LOOP_DWELL_TIMEOUT_SCALE = 1.3f;
-  static constexpr uint32_t INITIAL_TUNE_OPEN_LOOP_DWELL_TIMEOUT_MARGIN_MS = 1200u;
-  static constexpr uint32_t INITIAL_TUNE_SUCCESS_HOLD_MS = 800u;
-  static constexpr uint32_t INITIAL_TUNE_HANDOFF_GUARD_GRACE_MS = 250u;
-  static constexpr uint32_t INITIAL_TUNE_COOLDOWN_MS = 700u;
-  static constexpr uint32_t INITIAL_TUNE_FAULT_RECOVERY_PULSE_INTERVAL_MS = 500u;
-  static constexpr uint32_t INITIAL_TUNE_MPET_EXIT_TIMEOUT_MS = 3000u;
   // Large low-kV motors can spend a long dwell in KE measurement.
   static constexpr uint32_t DEFAULT_MPET_RUN_TIMEOUT_MS = 120000u;
   static constexpr uint32_t MPET_STATUS_LOG_INTERVAL_MS = 1000u;
-  static constexpr uint8_t MAX_REFINED_CANDIDATES = 6u;
-  static constexpr int32_t ACCEL_A1_BONUS_SCORE = 40;
-  static constexpr float SCORE_TRACKING_ERROR_WEIGHT = 90.0f;
-  static constexpr float SCORE_MISMATCH_ERROR_WEIGHT = 120.0f;
-  static constexpr float SCORE_OVERSPEED_RATIO_WEIGHT = 4500.0f;
-  static constexpr int32_t SCORE_UNSTABLE_SAMPLE_PENALTY = 1800;
-  static constexpr int32_t SCORE_TELEMETRY_MISS_PENALTY = 700;
-  static constexpr int32_t SCORE_NO_SAMPLE_PENALTY = 25000;
-  static constexpr uint8_t HANDOFF_UNSTABLE_REJECT_COUNT = 2u;
-  static constexpr uint8_t HANDOFF_STABLE_ACCEPT_COUNT = 2u;
-  static constexpr uint8_t HANDOFF_TELEMETRY_MISS_REJECT_COUNT = 3u;
-
-  bool is_closed_loop_state_(uint16_t algo_state) const {
-    return algo_state == 0x0008u || algo_state == 0x0009u;
+
+  float fallback_max_speed_hz_() const {
+    return this->parent_->cfg_max_speed_set_
+             ? this->parent_->service_.decode_max_speed_hz(this->parent_->cfg_max_speed_code_)
+             : 0.0f;
   }
 
-  bool is_mpet_state_(uint16_t algo_state) const {
-    return algo_state >= 0x000Fu && algo_state <= 0x0018u;
+  void log_tune_report_(const TuneEvent& event) const {
+    const ::mcf8329a_core::TuneReport& report = this->initial_tune_.report();
+    if (event.type == TuneEventType::TUNE_SUCCEEDED) {
+      ESP_LOGI(
+        TUNING_TAG,
+        "Initial tune success: best candidate reach=%ums score=%d handoff_samples=%u avg_track=%.1fHz "
+        "avg_mismatch=%.1fHz peak_ratio=%.2f",
+        static_cast<unsigned>(event.reach_ms),
+        static_cast<int>(event.score),
+        static_cast<unsigned>(event.metrics->sample_count),
+        ::mcf8329a_core::candidate_avg_tracking_error_hz(*event.metrics),
+        ::mcf8329a_core::candidate_avg_mismatch_error_hz(*event.metrics),
+        event.metrics->peak_speed_ratio
+      );
+    }
+    ESP_LOGI(
+      TUNING_TAG,
+      "Initial tune took %ums over %u candidate(s) (%u stopped early, %u cooldown(s) skipped), motor on %ums",
+      static_cast<unsigned>(report.total_ms),
+      static_cast<unsigned>(report.candidates_applied),
+      static_cast<unsigned>(report.candidates_pruned),
+      static_cast<unsigned>(report.cooldowns_skipped),
+      static_cast<unsigned>(report.motor_on_ms)
+    );
+    for (size_t i = static_cast<size_t>(TuneStage::APPLY); i < ::mcf8329a_core::TUNE_STAGE_COUNT; i++) {
+      ESP_LOGI(
+        TUNING_TAG,
+        "  stage %-8s %6ums, motor on %6ums",
+        ::mcf8329a_core::tune_stage_to_string(static_cast<TuneStage>(i)),
+        static_cast<unsigned>(report.stage_ms[i]),
+        static_cast<unsigned>(report.stage_motor_on_ms[i])
+      );
+    }
+    for (size_t i = 0; i < ::mcf8329a_core::TUNE_PASS_COUNT; i++) {
+      ESP_LOGI(
+        TUNING_TAG,
+        "  pass  %-8s %6ums, motor on %6ums",
+        i == static_cast<size_t>(::mcf8329a_core::TunePass::COARSE) ? "coarse" : "fine",
+        static_cast<unsigned>(report.pass_ms[i]),
+        static_cast<unsigned>(report.pass_motor_on_ms[i])
+      );
+    }
+  }
+
+  // The sweep leaves the last evaluated candidate in the registers; put the
+  // winner back before it is persisted.
+  void commit_initial_tune_(const TuneCandidate& best) {
+    if (!::mcf8329a_core::apply_tune_candidate(this->parent_->service_, best)) {
+      ESP_LOGW(TUNING_TAG, "Initial tune: failed to apply the best candidate");
+      return;
+    }
+    ::mcf83xx_common::TuningRecord record{};
+    if (!this->parent_->tuning_store_.begin_update(record)) {
+      return;
+    }
+    if (!::mcf8329a_core::record_tune_candidate_fields(this->parent_->service_, record)) {
+      ESP_LOGW(TUNING_TAG, "Initial tune: failed to read back the best candidate; result not stored");
+      return;
+    }
+    this->parent_->tuning_store_.store(
+      record, ::mcf83xx_common::TuningResultKind::STARTUP, this->initial_tune_.report().total_ms, TUNING_TAG
+    );
+  }
+
+  void commit_mpet_(uint32_t elapsed_ms) {
+    ::mcf83xx_common::TuningRecord record{};
+    if (!this->parent_->tuning_store_.begin_update(record)) {
+      return;
+    }
+    const ::mcf8329a_core::MCF8329AService& service = this->parent_->service_;
+    if (!service.record_tuned_field(record, RegisterId::CLOSED_LOOP3, ::mcf8329a_core::TUNED_CLOSED_LOOP3_MASK) ||
+        !service.record_tuned_field(record, RegisterId::CLOSED_LOOP4, ::mcf8329a_core::TUNED_CLOSED_LOOP4_MASK)) {
+      ESP_LOGW(TUNING_TAG, "MPET: failed to read back results; result not stored");
+      return;
+    }
+    this->parent_->tuning_store_.store(record, ::mcf83xx_common::TuningResultKind::MPET, elapsed_ms, TUNING_TAG);
   }
 
   bool read_algorithm_state_(uint16_t& algo_state) const {
     if (this->parent_ == nullptr) {
       return false;
     }
-    return this->parent_->read_reg16(RegisterId::ALGORITHM_STATE, algo_state);
+    // Inside update() this is the diagnostic snapshot's read of the poll.
+    return this->parent_->read_algorithm_state_(algo_state);
   }
 
   void clear_runtime_speed_command_(const char* reason) {
     if (this->parent_ == nullptr) {
       return;
     }
-    this->parent_->speed_target_percent_ = 0.0f;
-    this->parent_->speed_target_active_ = false;
-    this->parent_->start_boost_active_ = false;
-    this->parent_->start_boost_until_ms_ = 0u;
-    this->parent_->last_ramp_update_ms_ = 0u;
+    this->parent_->speed_ramp_.cancel();
     (void)this->parent_->apply_speed_command_(0.0f, reason, true);
   }
 
@@ -390,84 +503,7 @@ struct MCF8329ATuningController::Impl {
     ESP_LOGI(TUNING_TAG, "MPET: restored SPD_LOOP_KP/KI after unsuccessful characterization");
   }
 
-  bool apply_tune_candidate_(const InitialTuneCandidate& candidate) {
-    if (this->parent_ == nullptr) {
-      return false;
-    }
-
-    const uint32_t fault_cfg1_mask = FAULT_CONFIG1_ILIMIT_MASK |
-                                     FAULT_CONFIG1_LOCK_ILIMIT_MASK |
-                                     FAULT_CONFIG1_HW_LOCK_ILIMIT_MASK |
-                                     FAULT_CONFIG1_LOCK_ILIMIT_DEG_MASK;
-    const uint32_t fault_cfg1_value =
-      ((static_cast<uint32_t>(candidate.phase_ilimit_code) << FAULT_CONFIG1_ILIMIT_SHIFT) &
-       FAULT_CONFIG1_ILIMIT_MASK) |
-      ((static_cast<uint32_t>(candidate.lock_ilimit_code) <<
-        FAULT_CONFIG1_LOCK_ILIMIT_SHIFT) &
-       FAULT_CONFIG1_LOCK_ILIMIT_MASK) |
-      ((static_cast<uint32_t>(candidate.hw_lock_ilimit_code) <<
-        FAULT_CONFIG1_HW_LOCK_ILIMIT_SHIFT) &
-       FAULT_CONFIG1_HW_LOCK_ILIMIT_MASK) |
-      ((static_cast<uint32_t>(candidate.lock_ilimit_deglitch_code) <<
-        FAULT_CONFIG1_LOCK_ILIMIT_DEG_SHIFT) &
-       FAULT_CONFIG1_LOCK_ILIMIT_DEG_MASK);
-    if (!this->parent_->update_bits32(RegisterId::FAULT_CONFIG1, fault_cfg1_mask, fault_cfg1_value)) {
-      return false;
-    }
-
-    const uint32_t fault_cfg2_mask = FAULT_CONFIG2_HW_LOCK_ILIMIT_DEG_MASK |
-                                     FAULT_CONFIG2_LOCK2_EN_MASK;
-    uint32_t fault_cfg2_value =
-      ((static_cast<uint32_t>(candidate.hw_lock_ilimit_deglitch_code) <<
-        FAULT_CONFIG2_HW_LOCK_ILIMIT_DEG_SHIFT) &
-       FAULT_CONFIG2_HW_LOCK_ILIMIT_DEG_MASK);
-    if (candidate.abn_bemf_lock_enable) {
-      fault_cfg2_value |= FAULT_CONFIG2_LOCK2_EN_MASK;
-    }
-    if (!this->parent_->update_bits32(RegisterId::FAULT_CONFIG2, fault_cfg2_mask, fault_cfg2_value)) {
-      return false;
-    }
-
-    const uint32_t startup2_mask = MOTOR_STARTUP2_OL_ILIMIT_MASK |
-                                   MOTOR_STARTUP2_OL_ACC_A1_MASK |
-                                   MOTOR_STARTUP2_OL_ACC_A2_MASK |
-                                   MOTOR_STARTUP2_AUTO_HANDOFF_EN_MASK |
-                                   MOTOR_STARTUP2_OPN_CL_HANDOFF_THR_MASK |
-                                   MOTOR_STARTUP2_THETA_ERROR_RAMP_RATE_MASK;
-    uint32_t startup2_value =
-      ((static_cast<uint32_t>(candidate.open_loop_ilimit_code) <<
-        MOTOR_STARTUP2_OL_ILIMIT_SHIFT) &
-       MOTOR_STARTUP2_OL_ILIMIT_MASK) |
-      ((static_cast<uint32_t>(candidate.open_loop_accel_a1_code) <<
-        MOTOR_STARTUP2_OL_ACC_A1_SHIFT) &
-       MOTOR_STARTUP2_OL_ACC_A1_MASK) |
-      ((static_cast<uint32_t>(candidate.open_loop_accel_a2_code) <<
-        MOTOR_STARTUP2_OL_ACC_A2_SHIFT) &
-       MOTOR_STARTUP2_OL_ACC_A2_MASK) |
-      ((static_cast<uint32_t>(candidate.handoff_code) <<
-        MOTOR_STARTUP2_OPN_CL_HANDOFF_THR_SHIFT) &
-       MOTOR_STARTUP2_OPN_CL_HANDOFF_THR_MASK) |
-      ((static_cast<uint32_t>(candidate.theta_error_ramp_code) <<
-        MOTOR_STARTUP2_THETA_ERROR_RAMP_RATE_SHIFT) &
-       MOTOR_STARTUP2_THETA_ERROR_RAMP_RATE_MASK);
-    if (candidate.auto_handoff_enable) {
-      startup2_value |= MOTOR_STARTUP2_AUTO_HANDOFF_EN_MASK;
-    }
-    if (!this->parent_->update_bits32(RegisterId::MOTOR_STARTUP2, startup2_mask, startup2_value)) {
-      return false;
-    }
-
-    const uint32_t int_algo2_value =
-      (static_cast<uint32_t>(candidate.cl_slow_acc_code) << INT_ALGO_2_CL_SLOW_ACC_SHIFT) &
-      INT_ALGO_2_CL_SLOW_ACC_MASK;
-    return this->parent_->update_bits32(
-      register_address(RegisterId::INT_ALGO_2),
-      INT_ALGO_2_CL_SLOW_ACC_MASK,
-      int_algo2_value
-    );
-  }
-
-  void log_tune_candidate_(const InitialTuneCandidate& candidate, const char* prefix) const {
+  void log_tune_candidate_(const TuneCandidate& candidate, const char* prefix) const {
     ESP_LOGI(TUNING_TAG, "%s", prefix);
     ESP_LOGI(
       TUNING_TAG,
@@ -534,686 +570,13 @@ struct MCF8329ATuningController::Impl {
     ESP_LOGI(TUNING_TAG, "  abn_bemf_lock_enable: %s", candidate.abn_bemf_lock_enable ? "true" : "false");
   }
 
-  bool candidates_equal_(const InitialTuneCandidate& a, const InitialTuneCandidate& b) const {
-    return a.phase_ilimit_code == b.phase_ilimit_code && a.lock_ilimit_code == b.lock_ilimit_code &&
-           a.hw_lock_ilimit_code == b.hw_lock_ilimit_code &&
-           a.open_loop_ilimit_code == b.open_loop_ilimit_code &&
-           a.open_loop_accel_a1_code == b.open_loop_accel_a1_code &&
-           a.open_loop_accel_a2_code == b.open_loop_accel_a2_code && a.handoff_code == b.handoff_code &&
-           a.theta_error_ramp_code == b.theta_error_ramp_code &&
-           a.cl_slow_acc_code == b.cl_slow_acc_code &&
-           a.lock_ilimit_deglitch_code == b.lock_ilimit_deglitch_code &&
-           a.hw_lock_ilimit_deglitch_code == b.hw_lock_ilimit_deglitch_code &&
-           a.auto_handoff_enable == b.auto_handoff_enable &&
-           a.abn_bemf_lock_enable == b.abn_bemf_lock_enable;
-  }
-
-  void append_refined_candidate_(const InitialTuneCandidate& candidate) {
-    if (this->refinement_candidate_count_ >= MAX_REFINED_CANDIDATES) {
-      return;
-    }
-    for (uint8_t i = 0u; i < this->refinement_candidate_count_; i++) {
-      if (this->candidates_equal_(this->refinement_candidates_[i], candidate)) {
-        return;
-      }
-    }
-    this->refinement_candidates_[this->refinement_candidate_count_++] = candidate;
-  }
-
-  float candidate_avg_tracking_error_hz_(const CandidateQualityMetrics& metrics) const {
-    if (metrics.sample_count == 0u) {
-      return 999.0f;
-    }
-    return metrics.tracking_error_sum_hz / static_cast<float>(metrics.sample_count);
-  }
-
-  float candidate_avg_mismatch_error_hz_(const CandidateQualityMetrics& metrics) const {
-    if (metrics.sample_count == 0u) {
-      return 999.0f;
-    }
-    return metrics.mismatch_error_sum_hz / static_cast<float>(metrics.sample_count);
-  }
-
-  void reset_candidate_quality_metrics_() {
-    this->current_candidate_metrics_ = CandidateQualityMetrics{};
-  }
-
-  void record_candidate_quality_sample_(float commanded_hz, float fdbk_hz, float fg_hz, bool unstable) {
-    const float commanded_abs = std::fabs(commanded_hz);
-    const float fdbk_abs = std::fabs(fdbk_hz);
-    const float fg_abs = std::fabs(fg_hz);
-    const float command_basis = std::max(20.0f, commanded_abs);
-    const float pair_avg = (fdbk_abs + fg_abs) * 0.5f;
-    const float pair_max = std::max(fdbk_abs, fg_abs);
-
-    if (this->current_candidate_metrics_.sample_count < std::numeric_limits<uint16_t>::max()) {
-      this->current_candidate_metrics_.sample_count++;
-    }
-    this->current_candidate_metrics_.tracking_error_sum_hz += std::fabs(pair_avg - command_basis);
-    this->current_candidate_metrics_.mismatch_error_sum_hz += std::fabs(fdbk_abs - fg_abs);
-
-    const float speed_ratio = pair_max / command_basis;
-    if (speed_ratio > this->current_candidate_metrics_.peak_speed_ratio) {
-      this->current_candidate_metrics_.peak_speed_ratio = speed_ratio;
-    }
-    if (unstable && this->current_candidate_metrics_.unstable_count < std::numeric_limits<uint16_t>::max()) {
-      this->current_candidate_metrics_.unstable_count++;
-    }
-  }
-
-  void record_candidate_quality_telemetry_miss_() {
-    if (this->current_candidate_metrics_.telemetry_miss_count < std::numeric_limits<uint16_t>::max()) {
-      this->current_candidate_metrics_.telemetry_miss_count++;
-    }
-  }
-
-  int32_t score_candidate_(
-    const InitialTuneCandidate& candidate, uint32_t reach_ms, const CandidateQualityMetrics& metrics
-  ) const {
-    const float avg_tracking_hz = this->candidate_avg_tracking_error_hz_(metrics);
-    const float avg_mismatch_hz = this->candidate_avg_mismatch_error_hz_(metrics);
-    const float overspeed_ratio = std::max(0.0f, metrics.peak_speed_ratio - 1.10f);
-    const float quality_penalty = (avg_tracking_hz * SCORE_TRACKING_ERROR_WEIGHT) +
-                                  (avg_mismatch_hz * SCORE_MISMATCH_ERROR_WEIGHT) +
-                                  (overspeed_ratio * SCORE_OVERSPEED_RATIO_WEIGHT);
-
-    int32_t score = -static_cast<int32_t>(reach_ms);
-    score -= static_cast<int32_t>(quality_penalty + 0.5f);
-    score -= static_cast<int32_t>(metrics.unstable_count) * SCORE_UNSTABLE_SAMPLE_PENALTY;
-    score -= static_cast<int32_t>(metrics.telemetry_miss_count) * SCORE_TELEMETRY_MISS_PENALTY;
-    if (metrics.sample_count == 0u) {
-      score -= SCORE_NO_SAMPLE_PENALTY;
-    }
-    score += static_cast<int32_t>(candidate.open_loop_accel_a1_code) * ACCEL_A1_BONUS_SCORE;
-    return score;
-  }
-
   bool read_speed_triplet_hz_(float& ref_ol_hz, float& fdbk_hz, float& fg_hz, float& max_speed_hz) const {
     if (this->parent_ == nullptr) {
       return false;
     }
-
-    uint32_t closed_loop4 = 0;
-    max_speed_hz = this->parent_->cfg_max_speed_set_
-                     ? this->parent_->service_.decode_max_speed_hz(this->parent_->cfg_max_speed_code_)
-                     : 0.0f;
-    if (this->parent_->read_reg32(RegisterId::CLOSED_LOOP4, closed_loop4)) {
-      const uint16_t max_speed_code = static_cast<uint16_t>(
-        (closed_loop4 & CLOSED_LOOP4_MAX_SPEED_MASK) >>
-        CLOSED_LOOP4_MAX_SPEED_SHIFT
-      );
-      max_speed_hz = this->parent_->service_.decode_max_speed_hz(max_speed_code);
-    }
-    if (max_speed_hz <= 0.0f) {
-      return false;
-    }
-
-    uint32_t raw_ref = 0;
-    uint32_t raw_fdbk = 0;
-    uint32_t raw_fg = 0;
-    if (!this->parent_->read_reg32(RegisterId::SPEED_REF_OPEN_LOOP, raw_ref) ||
-        !this->parent_->read_reg32(RegisterId::SPEED_FDBK, raw_fdbk) ||
-        !this->parent_->read_reg32(RegisterId::FG_SPEED_FDBK, raw_fg)) {
-      return false;
-    }
-
-    ref_ol_hz = this->parent_->service_.decode_speed_hz(static_cast<int32_t>(raw_ref), max_speed_hz);
-    fdbk_hz = this->parent_->service_.decode_speed_hz(static_cast<int32_t>(raw_fdbk), max_speed_hz);
-    fg_hz = this->parent_->service_.decode_fg_speed_hz(raw_fg, max_speed_hz);
-    return true;
-  }
-
-  bool handoff_feedback_unstable_(float commanded_hz, float fdbk_hz, float fg_hz) const {
-    const float commanded_abs = std::fabs(commanded_hz);
-    const float fdbk_abs = std::fabs(fdbk_hz);
-    const float fg_abs = std::fabs(fg_hz);
-    const float command_basis = std::max(20.0f, commanded_abs);
-
-    const bool severe_overspeed = fdbk_abs > (command_basis * 2.2f) && fg_abs > (command_basis * 2.2f);
-
-    const float pair_max = std::max(fdbk_abs, fg_abs);
-    const bool fdbk_fg_mismatch =
-      pair_max > 20.0f && std::fabs(fdbk_abs - fg_abs) > std::max(35.0f, pair_max * 0.55f);
-
-    return severe_overspeed || fdbk_fg_mismatch;
-  }
-
-  bool handoff_feedback_stable_(float commanded_hz, float fdbk_hz, float fg_hz) const {
-    const float commanded_abs = std::fabs(commanded_hz);
-    const float fdbk_abs = std::fabs(fdbk_hz);
-    const float fg_abs = std::fabs(fg_hz);
-    const float command_basis = std::max(20.0f, commanded_abs);
-
-    const float min_expected = command_basis * 0.2f;
-    const float max_expected = command_basis * 1.9f;
-    const bool both_in_expected_band = fdbk_abs >= min_expected && fg_abs >= min_expected &&
-                                       fdbk_abs <= max_expected && fg_abs <= max_expected;
-
-    const float pair_max = std::max(fdbk_abs, fg_abs);
-    const bool pair_consistent = pair_max <= 20.0f || std::fabs(fdbk_abs - fg_abs) <= std::max(25.0f, pair_max * 0.45f);
-
-    return both_in_expected_band && pair_consistent;
-  }
-
-  bool estimate_handoff_time_ms_(const InitialTuneCandidate& candidate, float& est_handoff_ms) const {
-    est_handoff_ms = 0.0f;
-    if (this->parent_ == nullptr) {
-      return false;
-    }
-
-    float max_speed_hz = this->parent_->cfg_max_speed_set_
-                           ? this->parent_->service_.decode_max_speed_hz(this->parent_->cfg_max_speed_code_)
-                           : 0.0f;
-    uint32_t closed_loop4 = 0;
-    if (this->parent_->read_reg32(RegisterId::CLOSED_LOOP4, closed_loop4)) {
-      const uint16_t max_speed_code = static_cast<uint16_t>(
-        (closed_loop4 & CLOSED_LOOP4_MAX_SPEED_MASK) >>
-        CLOSED_LOOP4_MAX_SPEED_SHIFT
-      );
-      max_speed_hz = this->parent_->service_.decode_max_speed_hz(max_speed_code);
-    }
-    if (max_speed_hz <= 0.0f) {
-      return false;
-    }
-
-    const float handoff_percent =
-      this->parent_->service_.decode_open_to_closed_handoff_percent(candidate.handoff_code & 0x1Fu);
-    const float handoff_hz = max_speed_hz * handoff_percent / 100.0f;
-    const float ol_accel_hz_per_s =
-      this->parent_->service_.decode_open_loop_accel_hz_per_s(candidate.open_loop_accel_a1_code);
-    if (ol_accel_hz_per_s <= 0.0f) {
-      return false;
-    }
-
-    est_handoff_ms = (handoff_hz / ol_accel_hz_per_s) * 1000.0f;
-    return std::isfinite(est_handoff_ms) && est_handoff_ms >= 0.0f;
-  }
-
-  uint32_t candidate_open_loop_dwell_timeout_ms_(const InitialTuneCandidate& candidate) const {
-    float est_handoff_ms = 0.0f;
-    if (!this->estimate_handoff_time_ms_(candidate, est_handoff_ms)) {
-      return INITIAL_TUNE_MONITOR_TIMEOUT_MS;
-    }
-    const float timeout_ms = est_handoff_ms * INITIAL_TUNE_OPEN_LOOP_DWELL_TIMEOUT_SCALE +
-                             static_cast<float>(INITIAL_TUNE_OPEN_LOOP_DWELL_TIMEOUT_MARGIN_MS);
-    const float timeout_clamped_ms = std::clamp(
-      timeout_ms,
-      static_cast<float>(INITIAL_TUNE_OPEN_LOOP_DWELL_TIMEOUT_MIN_MS),
-      static_cast<float>(INITIAL_TUNE_OPEN_LOOP_DWELL_TIMEOUT_MAX_MS)
-    );
-    return static_cast<uint32_t>(timeout_clamped_ms + 0.5f);
-  }
-
-  uint32_t candidate_monitor_timeout_ms_(const InitialTuneCandidate& candidate) const {
-    float est_handoff_ms = 0.0f;
-    if (!this->estimate_handoff_time_ms_(candidate, est_handoff_ms)) {
-      return INITIAL_TUNE_MONITOR_TIMEOUT_MS;
-    }
-
-    const float est_to_handoff_ms = est_handoff_ms * INITIAL_TUNE_MONITOR_TIMEOUT_SCALE;
-    const float timeout_ms =
-      est_to_handoff_ms + static_cast<float>(INITIAL_TUNE_SUCCESS_HOLD_MS + INITIAL_TUNE_MONITOR_TIMEOUT_MARGIN_MS);
-    const float timeout_clamped_ms = std::clamp(
-      timeout_ms,
-      static_cast<float>(INITIAL_TUNE_MONITOR_TIMEOUT_MIN_MS),
-      static_cast<float>(INITIAL_TUNE_MONITOR_TIMEOUT_MAX_MS)
+    return ::mcf8329a_core::read_speed_triplet_hz(
+      this->parent_->service_, this->fallback_max_speed_hz_(), ref_ol_hz, fdbk_hz, fg_hz, max_speed_hz
     );
-    return static_cast<uint32_t>(timeout_clamped_ms + 0.5f);
-  }
-
-  bool active_pass_is_refinement_() const {
-    return this->refinement_active_;
-  }
-
-  uint8_t active_candidate_index_() const {
-    return this->active_pass_is_refinement_() ? this->refinement_candidate_index_
-                                              : this->initial_tune_candidate_index_;
-  }
-
-  uint8_t active_candidate_count_() const {
-    return this->active_pass_is_refinement_() ? this->refinement_candidate_count_
-                                              : static_cast<uint8_t>(TUNING_INITIAL_TUNE_CANDIDATE_COUNT);
-  }
-
-  bool active_candidates_exhausted_() const {
-    return this->active_candidate_index_() >= this->active_candidate_count_();
-  }
-
-  const InitialTuneCandidate& active_candidate_() const {
-    if (this->active_pass_is_refinement_()) {
-      return this->refinement_candidates_[this->refinement_candidate_index_];
-    }
-    return TUNING_INITIAL_TUNE_CANDIDATES[this->initial_tune_candidate_index_];
-  }
-
-  void advance_active_candidate_() {
-    if (this->active_pass_is_refinement_()) {
-      this->refinement_candidate_index_++;
-    } else {
-      this->initial_tune_candidate_index_++;
-    }
-  }
-
-  bool begin_refinement_(
-    const InitialTuneCandidate& baseline,
-    uint32_t baseline_reach_ms,
-    const CandidateQualityMetrics& baseline_metrics
-  ) {
-    this->refinement_active_ = false;
-    this->refinement_candidate_index_ = 0u;
-    this->refinement_candidate_count_ = 0u;
-    this->refinement_best_candidate_valid_ = true;
-    this->refinement_best_candidate_ = baseline;
-    this->refinement_best_reach_ms_ = baseline_reach_ms;
-    this->refinement_best_metrics_ = baseline_metrics;
-    this->refinement_best_score_ = this->score_candidate_(baseline, baseline_reach_ms, baseline_metrics);
-
-    this->append_refined_candidate_(baseline);  // index 0 baseline marker (already known successful)
-
-    InitialTuneCandidate candidate = baseline;
-    candidate.open_loop_accel_a1_code =
-      static_cast<uint8_t>(std::min<int>(15, static_cast<int>(baseline.open_loop_accel_a1_code) + 1));
-    this->append_refined_candidate_(candidate);
-
-    candidate = baseline;
-    candidate.handoff_code = static_cast<uint8_t>(
-      std::min<int>(31, static_cast<int>(baseline.handoff_code) + 2)
-    );
-    this->append_refined_candidate_(candidate);
-
-    candidate = baseline;
-    candidate.handoff_code =
-      static_cast<uint8_t>(std::max<int>(0, static_cast<int>(baseline.handoff_code) - 2));
-    this->append_refined_candidate_(candidate);
-
-    if (baseline.open_loop_accel_a1_code > 0u) {
-      candidate = baseline;
-      candidate.open_loop_accel_a1_code = static_cast<uint8_t>(baseline.open_loop_accel_a1_code - 1u);
-      this->append_refined_candidate_(candidate);
-    }
-
-    if (this->refinement_candidate_count_ <= 1u) {
-      return false;
-    }
-
-    this->refinement_active_ = true;
-    this->refinement_candidate_index_ = 0u;
-
-    ESP_LOGI(
-      TUNING_TAG,
-      "Initial tune baseline reached closed-loop in %ums; starting refinement sweep (%u variant candidate(s))",
-      static_cast<unsigned>(baseline_reach_ms),
-      static_cast<unsigned>(this->refinement_candidate_count_ - 1u)
-    );
-    return true;
-  }
-
-  void record_successful_candidate_(
-    const InitialTuneCandidate& candidate,
-    uint32_t reach_ms,
-    const CandidateQualityMetrics& metrics
-  ) {
-    const float avg_tracking_hz = this->candidate_avg_tracking_error_hz_(metrics);
-    const float avg_mismatch_hz = this->candidate_avg_mismatch_error_hz_(metrics);
-    const int32_t score = this->score_candidate_(candidate, reach_ms, metrics);
-    ESP_LOGI(
-      TUNING_TAG,
-      "Initial tune candidate success: reach=%ums score=%d accel=%.2fHz/s handoff=%.1f%% "
-      "handoff_samples=%u avg_track=%.1fHz avg_mismatch=%.1fHz peak_ratio=%.2f",
-      static_cast<unsigned>(reach_ms),
-      static_cast<int>(score),
-      this->parent_->service_.decode_open_loop_accel_hz_per_s(candidate.open_loop_accel_a1_code),
-      this->parent_->service_.decode_open_to_closed_handoff_percent(candidate.handoff_code),
-      static_cast<unsigned>(metrics.sample_count),
-      avg_tracking_hz,
-      avg_mismatch_hz,
-      metrics.peak_speed_ratio
-    );
-    if (!this->refinement_best_candidate_valid_ || score > this->refinement_best_score_) {
-      this->refinement_best_candidate_valid_ = true;
-      this->refinement_best_candidate_ = candidate;
-      this->refinement_best_reach_ms_ = reach_ms;
-      this->refinement_best_score_ = score;
-      this->refinement_best_metrics_ = metrics;
-    }
-  }
-
-  void finalize_initial_tune_success_() {
-    this->initial_tune_active_ = false;
-    this->initial_tune_stage_ = InitialTuneStage::IDLE;
-    this->initial_tune_waiting_fault_recovery_ = false;
-    this->initial_tune_last_fault_clear_ms_ = 0u;
-    this->initial_tune_closed_loop_seen_ = false;
-    this->handoff_unstable_counter_ = 0u;
-    this->handoff_stable_counter_ = 0u;
-    this->handoff_telemetry_miss_counter_ = 0u;
-    this->current_candidate_metrics_ = CandidateQualityMetrics{};
-
-    if (!this->refinement_best_candidate_valid_) {
-      ESP_LOGW(TUNING_TAG, "Initial tune ended without a successful candidate result");
-      return;
-    }
-
-    ESP_LOGI(
-      TUNING_TAG,
-      "Initial tune success: best candidate reach=%ums score=%d handoff_samples=%u avg_track=%.1fHz "
-      "avg_mismatch=%.1fHz peak_ratio=%.2f",
-      static_cast<unsigned>(this->refinement_best_reach_ms_),
-      static_cast<int>(this->refinement_best_score_),
-      static_cast<unsigned>(this->refinement_best_metrics_.sample_count),
-      this->candidate_avg_tracking_error_hz_(this->refinement_best_metrics_),
-      this->candidate_avg_mismatch_error_hz_(this->refinement_best_metrics_),
-      this->refinement_best_metrics_.peak_speed_ratio
-    );
-    this->log_tune_candidate_(
-      this->refinement_best_candidate_,
-      "Initial tune success: copy these keys into your YAML under mcf8329a:"
-    );
-  }
-
-  void fail_initial_tune_candidate_(const char* reason, uint32_t now) {
-    const char* phase = this->active_pass_is_refinement_() ? "refinement" : "discovery";
-    ESP_LOGW(
-      TUNING_TAG,
-      "Initial tune %s candidate %u/%u failed: %s",
-      phase,
-      static_cast<unsigned>(this->active_candidate_index_() + 1u),
-      static_cast<unsigned>(this->active_candidate_count_()),
-      reason
-    );
-    this->clear_runtime_speed_command_("initial_tune_fail");
-    this->parent_->pulse_clear_faults();
-    this->initial_tune_waiting_fault_recovery_ = false;
-    this->initial_tune_last_fault_clear_ms_ = 0u;
-    this->initial_tune_closed_loop_seen_ = false;
-    this->handoff_unstable_counter_ = 0u;
-    this->handoff_stable_counter_ = 0u;
-    this->handoff_telemetry_miss_counter_ = 0u;
-    this->current_candidate_metrics_ = CandidateQualityMetrics{};
-    this->initial_tune_stage_ = InitialTuneStage::COOLDOWN;
-    this->initial_tune_stage_started_ms_ = now;
-  }
-
-  void finalize_initial_tune_failure_() {
-    this->initial_tune_active_ = false;
-    this->initial_tune_stage_ = InitialTuneStage::IDLE;
-    this->initial_tune_waiting_fault_recovery_ = false;
-    this->initial_tune_last_fault_clear_ms_ = 0u;
-    this->initial_tune_closed_loop_seen_ = false;
-    this->handoff_unstable_counter_ = 0u;
-    this->handoff_stable_counter_ = 0u;
-    this->handoff_telemetry_miss_counter_ = 0u;
-    this->current_candidate_metrics_ = CandidateQualityMetrics{};
-    ESP_LOGW(
-      TUNING_TAG,
-      "Initial tune failed: no discovery candidate reached closed-loop at %.1f%% command",
-      INITIAL_TUNE_SPEED_PERCENT
-    );
-  }
-
-  void process_initial_tune_(bool fault_active, uint32_t now) {
-    if (this->active_candidates_exhausted_()) {
-      if (this->active_pass_is_refinement_()) {
-        this->finalize_initial_tune_success_();
-      } else {
-        this->finalize_initial_tune_failure_();
-      }
-      return;
-    }
-
-    const InitialTuneCandidate& candidate = this->active_candidate_();
-    const char* phase = this->active_pass_is_refinement_() ? "refinement" : "discovery";
-
-    switch (this->initial_tune_stage_) {
-      case InitialTuneStage::APPLY: {
-        ESP_LOGI(
-          TUNING_TAG,
-          "Initial tune %s candidate %u/%u",
-          phase,
-          static_cast<unsigned>(this->active_candidate_index_() + 1u),
-          static_cast<unsigned>(this->active_candidate_count_())
-        );
-        if (!this->apply_tune_candidate_(candidate)) {
-          this->fail_initial_tune_candidate_("register write failed", now);
-          return;
-        }
-        this->log_tune_candidate_(candidate, "Initial tune candidate values:");
-        this->initial_tune_stage_ = InitialTuneStage::START;
-        this->initial_tune_stage_started_ms_ = now;
-        return;
-      }
-
-      case InitialTuneStage::START: {
-        if ((now - this->initial_tune_stage_started_ms_) < INITIAL_TUNE_SETTLE_MS) {
-          return;
-        }
-        uint16_t algo_state = 0;
-        if (this->read_algorithm_state_(algo_state) && this->is_mpet_state_(algo_state)) {
-          (void)this->parent_->clear_mpet_bits_("initial_tune_wait");
-          if (!this->initial_tune_mpet_wait_logged_) {
-            ESP_LOGI(
-              TUNING_TAG,
-              "Initial tune waiting for MPET state to exit: 0x%04X(%s)",
-              static_cast<unsigned>(algo_state),
-              this->parent_->algorithm_state_to_string_(algo_state)
-            );
-            this->initial_tune_mpet_wait_logged_ = true;
-          }
-          if ((now - this->initial_tune_stage_started_ms_) < INITIAL_TUNE_MPET_EXIT_TIMEOUT_MS) {
-            return;
-          }
-          this->fail_initial_tune_candidate_("MPET state did not exit", now);
-          return;
-        }
-        this->initial_tune_mpet_wait_logged_ = false;
-        if (!this->parent_->apply_speed_command_(INITIAL_TUNE_SPEED_PERCENT, "initial_tune_start", true)) {
-          this->fail_initial_tune_candidate_("speed command failed", now);
-          return;
-        }
-        this->initial_tune_stage_ = InitialTuneStage::MONITOR;
-        this->initial_tune_stage_started_ms_ = now;
-        this->current_candidate_start_ms_ = now;
-        this->current_candidate_open_loop_dwell_timeout_ms_ =
-          this->candidate_open_loop_dwell_timeout_ms_(candidate);
-        this->current_candidate_monitor_timeout_ms_ = std::max(
-          this->candidate_monitor_timeout_ms_(candidate),
-          this->current_candidate_open_loop_dwell_timeout_ms_ + INITIAL_TUNE_SUCCESS_HOLD_MS + 1000u
-        );
-        this->current_candidate_reach_ms_ = this->current_candidate_monitor_timeout_ms_;
-        this->initial_tune_closed_loop_seen_ = false;
-        this->initial_tune_closed_loop_seen_ms_ = 0u;
-        this->handoff_unstable_counter_ = 0u;
-        this->handoff_stable_counter_ = 0u;
-        this->handoff_telemetry_miss_counter_ = 0u;
-        this->reset_candidate_quality_metrics_();
-        ESP_LOGI(
-          TUNING_TAG,
-          "Initial tune %s candidate %u/%u monitor timeout=%ums open_loop_dwell_timeout=%ums",
-          phase,
-          static_cast<unsigned>(this->active_candidate_index_() + 1u),
-          static_cast<unsigned>(this->active_candidate_count_()),
-          static_cast<unsigned>(this->current_candidate_monitor_timeout_ms_),
-          static_cast<unsigned>(this->current_candidate_open_loop_dwell_timeout_ms_)
-        );
-        return;
-      }
-
-      case InitialTuneStage::MONITOR: {
-        if (fault_active) {
-          this->fail_initial_tune_candidate_("fault asserted", now);
-          return;
-        }
-
-        uint16_t algo_state = 0;
-        if (this->read_algorithm_state_(algo_state) && this->is_closed_loop_state_(algo_state)) {
-          if (!this->initial_tune_closed_loop_seen_) {
-            this->initial_tune_closed_loop_seen_ = true;
-            this->initial_tune_closed_loop_seen_ms_ = now;
-            this->current_candidate_reach_ms_ =
-              now >= this->current_candidate_start_ms_ ? (now - this->current_candidate_start_ms_) : 0u;
-            this->handoff_unstable_counter_ = 0u;
-            this->handoff_stable_counter_ = 0u;
-            this->handoff_telemetry_miss_counter_ = 0u;
-            this->reset_candidate_quality_metrics_();
-            ESP_LOGI(
-              TUNING_TAG,
-              "Initial tune %s candidate %u/%u entered %s (reach=%ums)",
-              phase,
-              static_cast<unsigned>(this->active_candidate_index_() + 1u),
-              static_cast<unsigned>(this->active_candidate_count_()),
-              this->parent_->algorithm_state_to_string_(algo_state),
-              static_cast<unsigned>(this->current_candidate_reach_ms_)
-            );
-          } else if ((now - this->initial_tune_closed_loop_seen_ms_) >= INITIAL_TUNE_HANDOFF_GUARD_GRACE_MS) {
-            float ref_ol_hz = 0.0f;
-            float fdbk_hz = 0.0f;
-            float fg_hz = 0.0f;
-            float max_speed_hz = 0.0f;
-            if (this->read_speed_triplet_hz_(ref_ol_hz, fdbk_hz, fg_hz, max_speed_hz)) {
-              this->handoff_telemetry_miss_counter_ = 0u;
-              const float commanded_hz =
-                (std::fabs(this->parent_->speed_applied_percent_) / 100.0f) * max_speed_hz;
-              const bool handoff_unstable = this->handoff_feedback_unstable_(commanded_hz, fdbk_hz, fg_hz);
-              this->record_candidate_quality_sample_(commanded_hz, fdbk_hz, fg_hz, handoff_unstable);
-              if (!handoff_unstable) {
-                this->handoff_unstable_counter_ = 0u;
-                if (this->handoff_feedback_stable_(commanded_hz, fdbk_hz, fg_hz)) {
-                  if (this->handoff_stable_counter_ < 0xFFu) {
-                    this->handoff_stable_counter_++;
-                  }
-                } else {
-                  this->handoff_stable_counter_ = 0u;
-                }
-              } else {
-                this->handoff_unstable_counter_++;
-                this->handoff_stable_counter_ = 0u;
-                ESP_LOGW(
-                  TUNING_TAG,
-                  "Initial tune handoff guard: unstable sample %u/%u cmd=%.1fHz ref_ol=%.1fHz fdbk=%.1fHz fg=%.1fHz",
-                  static_cast<unsigned>(this->handoff_unstable_counter_),
-                  static_cast<unsigned>(HANDOFF_UNSTABLE_REJECT_COUNT),
-                  commanded_hz,
-                  ref_ol_hz,
-                  fdbk_hz,
-                  fg_hz
-                );
-                if (this->handoff_unstable_counter_ >= HANDOFF_UNSTABLE_REJECT_COUNT) {
-                  this->fail_initial_tune_candidate_("handoff feedback unstable", now);
-                  return;
-                }
-              }
-            } else {
-              this->handoff_stable_counter_ = 0u;
-              if (this->handoff_telemetry_miss_counter_ < 0xFFu) {
-                this->handoff_telemetry_miss_counter_++;
-              }
-              this->record_candidate_quality_telemetry_miss_();
-              ESP_LOGW(
-                TUNING_TAG,
-                "Initial tune handoff guard: speed telemetry unavailable sample %u/%u",
-                static_cast<unsigned>(this->handoff_telemetry_miss_counter_),
-                static_cast<unsigned>(HANDOFF_TELEMETRY_MISS_REJECT_COUNT)
-              );
-              if (this->handoff_telemetry_miss_counter_ >= HANDOFF_TELEMETRY_MISS_REJECT_COUNT) {
-                this->fail_initial_tune_candidate_("handoff telemetry unavailable", now);
-                return;
-              }
-            }
-          }
-
-          if ((now - this->initial_tune_closed_loop_seen_ms_) >= INITIAL_TUNE_SUCCESS_HOLD_MS) {
-            if (this->handoff_stable_counter_ < HANDOFF_STABLE_ACCEPT_COUNT) {
-              return;
-            }
-            const CandidateQualityMetrics candidate_metrics = this->current_candidate_metrics_;
-            this->clear_runtime_speed_command_("initial_tune_success");
-            this->record_successful_candidate_(candidate, this->current_candidate_reach_ms_, candidate_metrics);
-
-            if (!this->active_pass_is_refinement_()) {
-              const bool has_refinement =
-                this->begin_refinement_(candidate, this->current_candidate_reach_ms_, candidate_metrics);
-              if (!has_refinement) {
-                this->finalize_initial_tune_success_();
-                return;
-              }
-            }
-
-            this->initial_tune_closed_loop_seen_ = false;
-            this->initial_tune_stage_ = InitialTuneStage::COOLDOWN;
-            this->initial_tune_stage_started_ms_ = now;
-            return;
-          }
-        } else {
-          this->initial_tune_closed_loop_seen_ = false;
-          this->initial_tune_closed_loop_seen_ms_ = 0u;
-          this->handoff_unstable_counter_ = 0u;
-          this->handoff_stable_counter_ = 0u;
-          this->handoff_telemetry_miss_counter_ = 0u;
-          this->reset_candidate_quality_metrics_();
-        }
-
-        if (!this->initial_tune_closed_loop_seen_ &&
-            (now - this->current_candidate_start_ms_) >= this->current_candidate_open_loop_dwell_timeout_ms_) {
-          this->fail_initial_tune_candidate_("open-loop dwell timeout (heating guard)", now);
-          return;
-        }
-
-        if ((now - this->initial_tune_stage_started_ms_) >= this->current_candidate_monitor_timeout_ms_) {
-          this->fail_initial_tune_candidate_("timeout waiting for closed-loop", now);
-          return;
-        }
-        return;
-      }
-
-      case InitialTuneStage::COOLDOWN: {
-        if ((now - this->initial_tune_stage_started_ms_) < INITIAL_TUNE_COOLDOWN_MS) {
-          return;
-        }
-        if (this->parent_ != nullptr && (fault_active || this->parent_->severe_fault_speed_lockout_)) {
-          if (!this->initial_tune_waiting_fault_recovery_) {
-            this->initial_tune_waiting_fault_recovery_ = true;
-            ESP_LOGW(
-              TUNING_TAG,
-              "Initial tune waiting for fault recovery before retrying candidate: "
-              "fault_active=%s lockout=%s",
-              YESNO(fault_active),
-              YESNO(this->parent_->severe_fault_speed_lockout_)
-            );
-          }
-          if (this->initial_tune_last_fault_clear_ms_ == 0u ||
-              (now - this->initial_tune_last_fault_clear_ms_) >=
-                INITIAL_TUNE_FAULT_RECOVERY_PULSE_INTERVAL_MS) {
-            this->parent_->pulse_clear_faults();
-            this->initial_tune_last_fault_clear_ms_ = now;
-          }
-          if (fault_active || this->parent_->severe_fault_speed_lockout_) {
-            return;
-          }
-        }
-        if (this->initial_tune_waiting_fault_recovery_) {
-          ESP_LOGI(TUNING_TAG, "Initial tune fault recovery complete; resuming candidate sweep");
-          this->initial_tune_waiting_fault_recovery_ = false;
-          this->initial_tune_last_fault_clear_ms_ = 0u;
-        }
-        this->advance_active_candidate_();
-        if (this->active_candidates_exhausted_()) {
-          if (this->active_pass_is_refinement_()) {
-            this->finalize_initial_tune_success_();
-          } else {
-            this->finalize_initial_tune_failure_();
-          }
-          return;
-        }
-        this->initial_tune_stage_ = InitialTuneStage::APPLY;
-        this->initial_tune_stage_started_ms_ = now;
-        return;
-      }
-
-      case InitialTuneStage::IDLE:
-      default:
-        this->initial_tune_active_ = false;
-        return;
-    }
   }
 
   void log_mpet_results_() const {
@@ -1458,6 +821,7 @@ struct MCF8329ATuningController::Impl {
       this->log_mpet_summary_("done", now, algo_state, algo_state_ok);
       ESP_LOGI(TUNING_TAG, "MPET characterization completed successfully");
       this->log_mpet_results_();
+      this->commit_mpet_(now - this->mpet_characterization_started_ms_);
       return;
     }
 
@@ -1500,32 +864,7 @@ struct MCF8329ATuningController::Impl {
   }
 
   MCF8329AComponent* parent_{nullptr};
-  bool initial_tune_active_{false};
-  InitialTuneStage initial_tune_stage_{InitialTuneStage::IDLE};
-  uint8_t initial_tune_candidate_index_{0u};
-  uint32_t initial_tune_stage_started_ms_{0u};
-  bool initial_tune_waiting_fault_recovery_{false};
-  bool initial_tune_mpet_wait_logged_{false};
-  uint32_t initial_tune_last_fault_clear_ms_{0u};
-  bool initial_tune_closed_loop_seen_{false};
-  uint32_t initial_tune_closed_loop_seen_ms_{0u};
-  uint32_t current_candidate_start_ms_{0u};
-  uint32_t current_candidate_reach_ms_{INITIAL_TUNE_MONITOR_TIMEOUT_MS};
-  uint32_t current_candidate_monitor_timeout_ms_{INITIAL_TUNE_MONITOR_TIMEOUT_MS};
-  uint32_t current_candidate_open_loop_dwell_timeout_ms_{INITIAL_TUNE_MONITOR_TIMEOUT_MS};
-  uint8_t handoff_unstable_counter_{0u};
-  uint8_t handoff_stable_counter_{0u};
-  uint8_t handoff_telemetry_miss_counter_{0u};
-  CandidateQualityMetrics current_candidate_metrics_{};
-  bool refinement_active_{false};
-  uint8_t refinement_candidate_index_{0u};
-  uint8_t refinement_candidate_count_{0u};
-  InitialTuneCandidate refinement_candidates_[MAX_REFINED_CANDIDATES]{};
-  bool refinement_best_candidate_valid_{false};
-  InitialTuneCandidate refinement_best_candidate_{};
-  CandidateQualityMetrics refinement_best_metrics_{};
-  int32_t refinement_best_score_{std::numeric_limits<int32_t>::min()};
-  uint32_t refinement_best_reach_ms_{INITIAL_TUNE_MONITOR_TIMEOUT_MS};
+  ::mcf8329a_core::MCF8329AInitialTuneService initial_tune_;
   bool mpet_characterization_active_{false};
   uint32_t mpet_characterization_started_ms_{0u};
   uint32_t mpet_last_status_log_ms_{0u};
@@ -0,0 +1,782 @@
+#include "mcf8329a_tuning_service.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace mcf8329a_core {
+
+using namespace regs;
+
+namespace {
+
+constexpr int32_t ACCEL_A1_BONUS_SCORE = 40;
+constexpr float SCORE_TRACKING_ERROR_WEIGHT = 90.0f;
+constexpr float SCORE_MISMATCH_ERROR_WEIGHT = 120.0f;
+constexpr float SCORE_OVERSPEED_RATIO_WEIGHT = 4500.0f;
+constexpr int32_t SCORE_UNSTABLE_SAMPLE_PENALTY = 1800;
+constexpr int32_t SCORE_TELEMETRY_MISS_PENALTY = 700;
+constexpr int32_t SCORE_NO_SAMPLE_PENALTY = 25000;
+
+bool is_closed_loop_state(uint16_t algo_state) { return algo_state == 0x0008u || algo_state == 0x0009u; }
+
+bool is_mpet_state(uint16_t algo_state) { return algo_state >= 0x000Fu && algo_state <= 0x0018u; }
+
+uint32_t field(uint8_t code, uint32_t shift, uint32_t mask) { return (static_cast<uint32_t>(code) << shift) & mask; }
+
+}  // namespace
+
+bool tune_candidates_equal(const TuneCandidate &a, const TuneCandidate &b) {
+  return a.phase_ilimit_code == b.phase_ilimit_code && a.lock_ilimit_code == b.lock_ilimit_code &&
+         a.hw_lock_ilimit_code == b.hw_lock_ilimit_code && a.open_loop_ilimit_code == b.open_loop_ilimit_code &&
+         a.open_loop_accel_a1_code == b.open_loop_accel_a1_code &&
+         a.open_loop_accel_a2_code == b.open_loop_accel_a2_code && a.handoff_code == b.handoff_code &&
+         a.theta_error_ramp_code == b.theta_error_ramp_code && a.cl_slow_acc_code == b.cl_slow_acc_code &&
+         a.lock_ilimit_deglitch_code == b.lock_ilimit_deglitch_code &&
+         a.hw_lock_ilimit_deglitch_code == b.hw_lock_ilimit_deglitch_code &&
+         a.auto_handoff_enable == b.auto_handoff_enable && a.abn_bemf_lock_enable == b.abn_bemf_lock_enable;
+}
+
+bool apply_tune_candidate(const MCF8329AService &service, const TuneCandidate &candidate) {
+  const uint32_t fault_cfg1_value =
+    field(candidate.phase_ilimit_code, FAULT_CONFIG1_ILIMIT_SHIFT, FAULT_CONFIG1_ILIMIT_MASK) |
+    field(candidate.lock_ilimit_code, FAULT_CONFIG1_LOCK_ILIMIT_SHIFT, FAULT_CONFIG1_LOCK_ILIMIT_MASK) |
+    field(candidate.hw_lock_ilimit_code, FAULT_CONFIG1_HW_LOCK_ILIMIT_SHIFT, FAULT_CONFIG1_HW_LOCK_ILIMIT_MASK) |
+    field(candidate.lock_ilimit_deglitch_code, FAULT_CONFIG1_LOCK_ILIMIT_DEG_SHIFT,
+          FAULT_CONFIG1_LOCK_ILIMIT_DEG_MASK);
+  if (!service.update_bits32(RegisterId::FAULT_CONFIG1, TUNED_FAULT_CONFIG1_MASK, fault_cfg1_value)) {
+    return false;
+  }
+
+  uint32_t fault_cfg2_value = field(candidate.hw_lock_ilimit_deglitch_code, FAULT_CONFIG2_HW_LOCK_ILIMIT_DEG_SHIFT,
+                                    FAULT_CONFIG2_HW_LOCK_ILIMIT_DEG_MASK);
+  if (candidate.abn_bemf_lock_enable) {
+    fault_cfg2_value |= FAULT_CONFIG2_LOCK2_EN_MASK;
+  }
+  if (!service.update_bits32(RegisterId::FAULT_CONFIG2, TUNED_FAULT_CONFIG2_MASK, fault_cfg2_value)) {
+    return false;
+  }
+
+  uint32_t startup2_value =
+    field(candidate.open_loop_ilimit_code, MOTOR_STARTUP2_OL_ILIMIT_SHIFT, MOTOR_STARTUP2_OL_ILIMIT_MASK) |
+    field(candidate.open_loop_accel_a1_code, MOTOR_STARTUP2_OL_ACC_A1_SHIFT, MOTOR_STARTUP2_OL_ACC_A1_MASK) |
+    field(candidate.open_loop_accel_a2_code, MOTOR_STARTUP2_OL_ACC_A2_SHIFT, MOTOR_STARTUP2_OL_ACC_A2_MASK) |
+    field(candidate.handoff_code, MOTOR_STARTUP2_OPN_CL_HANDOFF_THR_SHIFT, MOTOR_STARTUP2_OPN_CL_HANDOFF_THR_MASK) |
+    field(candidate.theta_error_ramp_code, MOTOR_STARTUP2_THETA_ERROR_RAMP_RATE_SHIFT,
+          MOTOR_STARTUP2_THETA_ERROR_RAMP_RATE_MASK);
+  if (candidate.auto_handoff_enable) {
+    startup2_value |= MOTOR_STARTUP2_AUTO_HANDOFF_EN_MASK;
+  }
+  if (!service.update_bits32(RegisterId::MOTOR_STARTUP2, TUNED_MOTOR_STARTUP2_MASK, startup2_value)) {
+    return false;
+  }
+
+  return service.update_bits32(RegisterId::INT_ALGO_2, TUNED_INT_ALGO_2_MASK,
+                               field(candidate.cl_slow_acc_code, INT_ALGO_2_CL_SLOW_ACC_SHIFT,
+                                     INT_ALGO_2_CL_SLOW_ACC_MASK));
+}
+
+bool record_tune_candidate_fields(const MCF8329AService &service, mcf83xx_common::TuningRecord &record) {
+  return service.record_tuned_field(record, RegisterId::FAULT_CONFIG1, TUNED_FAULT_CONFIG1_MASK) &&
+         service.record_tuned_field(record, RegisterId::FAULT_CONFIG2, TUNED_FAULT_CONFIG2_MASK) &&
+         service.record_tuned_field(record, RegisterId::MOTOR_STARTUP2, TUNED_MOTOR_STARTUP2_MASK) &&
+         service.record_tuned_field(record, RegisterId::INT_ALGO_2, TUNED_INT_ALGO_2_MASK);
+}
+
+float candidate_avg_tracking_error_hz(const CandidateQualityMetrics &metrics) {
+  if (metrics.sample_count == 0u) {
+    return 999.0f;
+  }
+  return metrics.tracking_error_sum_hz / static_cast<float>(metrics.sample_count);
+}
+
+float candidate_avg_mismatch_error_hz(const CandidateQualityMetrics &metrics) {
+  if (metrics.sample_count == 0u) {
+    return 999.0f;
+  }
+  return metrics.mismatch_error_sum_hz / static_cast<float>(metrics.sample_count);
+}
+
+void record_candidate_quality_sample(CandidateQualityMetrics &metrics, float commanded_hz, float fdbk_hz, float fg_hz,
+                                     bool unstable) {
+  const float commanded_abs = std::fabs(commanded_hz);
+  const float fdbk_abs = std::fabs(fdbk_hz);
+  const float fg_abs = std::fabs(fg_hz);
+  const float command_basis = std::max(20.0f, commanded_abs);
+  const float pair_avg = (fdbk_abs + fg_abs) * 0.5f;
+  const float pair_max = std::max(fdbk_abs, fg_abs);
+
+  if (metrics.sample_count < std::numeric_limits<uint16_t>::max()) {
+    metrics.sample_count++;
+  }
+  metrics.tracking_error_sum_hz += std::fabs(pair_avg - command_basis);
+  metrics.mismatch_error_sum_hz += std::fabs(fdbk_abs - fg_abs);
+
+  const float speed_ratio = pair_max / command_basis;
+  if (speed_ratio > metrics.peak_speed_ratio) {
+    metrics.peak_speed_ratio = speed_ratio;
+  }
+  if (unstable && metrics.unstable_count < std::numeric_limits<uint16_t>::max()) {
+    metrics.unstable_count++;
+  }
+}
+
+int32_t score_tune_candidate(const TuneCandidate &candidate, uint32_t reach_ms,
+                             const CandidateQualityMetrics &metrics) {
+  const float avg_tracking_hz = candidate_avg_tracking_error_hz(metrics);
+  const float avg_mismatch_hz = candidate_avg_mismatch_error_hz(metrics);
+  const float overspeed_ratio = std::max(0.0f, metrics.peak_speed_ratio - 1.10f);
+  const float quality_penalty = (avg_tracking_hz * SCORE_TRACKING_ERROR_WEIGHT) +
+                                (avg_mismatch_hz * SCORE_MISMATCH_ERROR_WEIGHT) +
+                                (overspeed_ratio * SCORE_OVERSPEED_RATIO_WEIGHT);
+
+  int32_t score = -static_cast<int32_t>(reach_ms);
+  score -= static_cast<int32_t>(quality_penalty + 0.5f);
+  score -= static_cast<int32_t>(metrics.unstable_count) * SCORE_UNSTABLE_SAMPLE_PENALTY;
+  score -= static_cast<int32_t>(metrics.telemetry_miss_count) * SCORE_TELEMETRY_MISS_PENALTY;
+  if (metrics.sample_count == 0u) {
+    score -= SCORE_NO_SAMPLE_PENALTY;
+  }
+  score += static_cast<int32_t>(candidate.open_loop_accel_a1_code) * ACCEL_A1_BONUS_SCORE;
+  return score;
+}
+
+bool handoff_feedback_unstable(float commanded_hz, float fdbk_hz, float fg_hz) {
+  const float commanded_abs = std::fabs(commanded_hz);
+  const float fdbk_abs = std::fabs(fdbk_hz);
+  const float fg_abs = std::fabs(fg_hz);
+  const float command_basis = std::max(20.0f, commanded_abs);
+
+  const bool severe_overspeed = fdbk_abs > (command_basis * 2.2f) && fg_abs > (command_basis * 2.2f);
+
+  const float pair_max = std::max(fdbk_abs, fg_abs);
+  const bool fdbk_fg_mismatch =
+    pair_max > 20.0f && std::fabs(fdbk_abs - fg_abs) > std::max(35.0f, pair_max * 0.55f);
+
+  return severe_overspeed || fdbk_fg_mismatch;
+}
+
+bool handoff_feedback_stable(float commanded_hz, float fdbk_hz, float fg_hz) {
+  const float commanded_abs = std::fabs(commanded_hz);
+  const float fdbk_abs = std::fabs(fdbk_hz);
+  const float fg_abs = std::fabs(fg_hz);
+  const float command_basis = std::max(20.0f, commanded_abs);
+
+  const float min_expected = command_basis * 0.2f;
+  const float max_expected = command_basis * 1.9f;
+  const bool both_in_expected_band =
+    fdbk_abs >= min_expected && fg_abs >= min_expected && fdbk_abs <= max_expected && fg_abs <= max_expected;
+
+  const float pair_max = std::max(fdbk_abs, fg_abs);
+  const bool pair_consistent =
+    pair_max <= 20.0f || std::fabs(fdbk_abs - fg_abs) <= std::max(25.0f, pair_max * 0.45f);
+
+  return both_in_expected_band && pair_consistent;
+}
+
+float read_max_speed_hz(const MCF8329AService &service, float fallback_max_speed_hz) {
+  uint32_t closed_loop4 = 0;
+  if (service.read_reg32(RegisterId::CLOSED_LOOP4, closed_loop4)) {
+    return service.decode_max_speed_hz(
+      static_cast<uint16_t>((closed_loop4 & CLOSED_LOOP4_MAX_SPEED_MASK) >> CLOSED_LOOP4_MAX_SPEED_SHIFT));
+  }
+  return fallback_max_speed_hz;
+}
+
+bool read_speed_triplet_hz(const MCF8329AService &service, float fallback_max_speed_hz, float &ref_ol_hz,
+                           float &fdbk_hz, float &fg_hz, float &max_speed_hz) {
+  max_speed_hz = read_max_speed_hz(service, fallback_max_speed_hz);
+  if (max_speed_hz <= 0.0f) {
+    return false;
+  }
+
+  uint32_t raw_ref = 0;
+  uint32_t raw_fdbk = 0;
+  uint32_t raw_fg = 0;
+  if (!service.read_reg32(RegisterId::SPEED_REF_OPEN_LOOP, raw_ref) ||
+      !service.read_reg32(RegisterId::SPEED_FDBK, raw_fdbk) ||
+      !service.read_reg32(RegisterId::FG_SPEED_FDBK, raw_fg)) {
+    return false;
+  }
+
+  ref_ol_hz = service.decode_speed_hz(static_cast<int32_t>(raw_ref), max_speed_hz);
+  fdbk_hz = service.decode_speed_hz(static_cast<int32_t>(raw_fdbk), max_speed_hz);
+  fg_hz = service.decode_fg_speed_hz(raw_fg, max_speed_hz);
+  return true;
+}
+
+const char *tune_stage_to_string(TuneStage stage) {
+  switch (stage) {
+    case TuneStage::IDLE:
+      return "idle";
+    case TuneStage::APPLY:
+      return "apply";
+    case TuneStage::START:
+      return "start";
+    case TuneStage::MONITOR:
+      return "monitor";
+    case TuneStage::COOLDOWN:
+      return "cooldown";
+    default:
+      return "unknown";
+  }
+}
+
+bool add_tune_grid_code(std::array<uint8_t, MAX_TUNE_GRID_CODES> &codes, uint8_t &count, uint8_t code) {
+  for (uint8_t i = 0u; i < count; i++) {
+    if (codes[i] == code) {
+      return true;
+    }
+  }
+  if (count >= codes.size()) {
+    return false;
+  }
+  codes[count++] = code;
+  return true;
+}
+
+void MCF8329AInitialTuneService::reset() {
+  const float fallback_max_speed_hz = this->fallback_max_speed_hz_;
+  const TuneSearchConfig search = this->search_;
+  TuneActuator *actuator = this->actuator_;
+  TuneObserver *observer = this->observer_;
+  *this = MCF8329AInitialTuneService(actuator, observer);
+  this->fallback_max_speed_hz_ = fallback_max_speed_hz;
+  this->search_ = search;
+}
+
+void MCF8329AInitialTuneService::start(uint32_t now_ms) {
+  this->reset();
+  this->begin_coarse_pass_();
+  this->active_ = true;
+  this->stage_ = TuneStage::APPLY;
+  this->stage_started_ms_ = now_ms;
+  this->accounted_ms_ = now_ms;
+  this->report_.started_ms = now_ms;
+  this->emit_(this->event_(TuneEventType::STARTED, now_ms));
+}
+
+TuneEvent MCF8329AInitialTuneService::event_(TuneEventType type, uint32_t now_ms) const {
+  TuneEvent event;
+  event.type = type;
+  event.now_ms = now_ms;
+  event.refinement = this->fine_pass_();
+  event.pass = this->pass_number_;
+  event.candidate_number = static_cast<uint8_t>(this->pass_index_ + 1u);
+  event.candidate_count = this->pass_count_;
+  return event;
+}
+
+void MCF8329AInitialTuneService::emit_(const TuneEvent &event) const {
+  if (this->observer_ != nullptr) {
+    this->observer_->on_tune_event(event);
+  }
+}
+
+void MCF8329AInitialTuneService::account_(uint32_t now_ms) {
+  const uint32_t elapsed = now_ms - this->accounted_ms_;
+  const size_t stage = static_cast<size_t>(this->stage_);
+  const size_t pass = static_cast<size_t>(this->fine_pass_() ? TunePass::FINE : TunePass::COARSE);
+  this->report_.stage_ms[stage] += elapsed;
+  this->report_.pass_ms[pass] += elapsed;
+  if (this->motor_on_) {
+    this->report_.stage_motor_on_ms[stage] += elapsed;
+    this->report_.pass_motor_on_ms[pass] += elapsed;
+    this->report_.motor_on_ms += elapsed;
+  }
+  this->accounted_ms_ = now_ms;
+}
+
+void MCF8329AInitialTuneService::enter_stage_(TuneStage stage, uint32_t now_ms) {
+  this->account_(now_ms);
+  this->stage_ = stage;
+  this->stage_started_ms_ = now_ms;
+}
+
+void MCF8329AInitialTuneService::set_motor_on_(bool on, const char *reason, uint32_t now_ms) {
+  this->account_(now_ms);
+  if (on) {
+    this->motor_on_ = this->actuator_->start_motor(SPEED_PERCENT, reason);
+    this->motor_driven_ = this->motor_on_;
+  } else {
+    this->actuator_->stop_motor(reason);
+    this->motor_on_ = false;
+  }
+}
+
+void MCF8329AInitialTuneService::reset_candidate_tracking_() {
+  this->closed_loop_seen_ = false;
+  this->closed_loop_seen_ms_ = 0u;
+  this->unstable_counter_ = 0u;
+  this->stable_counter_ = 0u;
+  this->telemetry_miss_counter_ = 0u;
+  this->candidate_metrics_ = CandidateQualityMetrics{};
+}
+
+bool MCF8329AInitialTuneService::estimate_handoff_time_ms_(const MCF8329AService &service,
+                                                           const TuneCandidate &candidate,
+                                                           float &est_handoff_ms) const {
+  est_handoff_ms = 0.0f;
+  const float max_speed_hz = read_max_speed_hz(service, this->fallback_max_speed_hz_);
+  if (max_speed_hz <= 0.0f) {
+    return false;
+  }
+
+  const float handoff_percent = service.decode_open_to_closed_handoff_percent(candidate.handoff_code & 0x1Fu);
+  const float handoff_hz = max_speed_hz * handoff_percent / 100.0f;
+  const float ol_accel_hz_per_s = service.decode_open_loop_accel_hz_per_s(candidate.open_loop_accel_a1_code);
+  if (ol_accel_hz_per_s <= 0.0f) {
+    return false;
+  }
+
+  est_handoff_ms = (handoff_hz / ol_accel_hz_per_s) * 1000.0f;
+  return std::isfinite(est_handoff_ms) && est_handoff_ms >= 0.0f;
+}
+
+uint32_t MCF8329AInitialTuneService::open_loop_dwell_timeout_ms_(const MCF8329AService &service,
+                                                                 const TuneCandidate &candidate) const {
+  float est_handoff_ms = 0.0f;
+  if (!this->estimate_handoff_time_ms_(service, candidate, est_handoff_ms)) {
+    return MONITOR_TIMEOUT_MS;
+  }
+  const float timeout_ms =
+    est_handoff_ms * OPEN_LOOP_DWELL_TIMEOUT_SCALE + static_cast<float>(OPEN_LOOP_DWELL_TIMEOUT_MARGIN_MS);
+  const float timeout_clamped_ms =
+    std::clamp(timeout_ms, static_cast<float>(OPEN_LOOP_DWELL_TIMEOUT_MIN_MS),
+               static_cast<float>(OPEN_LOOP_DWELL_TIMEOUT_MAX_MS));
+  return static_cast<uint32_t>(timeout_clamped_ms + 0.5f);
+}
+
+uint32_t MCF8329AInitialTuneService::monitor_timeout_ms_(const MCF8329AService &service,
+                                                         const TuneCandidate &candidate) const {
+  float est_handoff_ms = 0.0f;
+  if (!this->estimate_handoff_time_ms_(service, candidate, est_handoff_ms)) {
+    return MONITOR_TIMEOUT_MS;
+  }
+  const float timeout_ms = est_handoff_ms * MONITOR_TIMEOUT_SCALE +
+                           static_cast<float>(SUCCESS_HOLD_MS + MONITOR_TIMEOUT_MARGIN_MS);
+  const float timeout_clamped_ms = std::clamp(timeout_ms, static_cast<float>(MONITOR_TIMEOUT_MIN_MS),
+                                              static_cast<float>(MONITOR_TIMEOUT_MAX_MS));
+  return static_cast<uint32_t>(timeout_clamped_ms + 0.5f);
+}
+
+bool MCF8329AInitialTuneService::evaluated_(const TuneCandidate &candidate) const {
+  for (size_t i = 0u; i < this->evaluated_count_; i++) {
+    if (tune_candidates_equal(this->evaluated_candidates_[i], candidate)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void MCF8329AInitialTuneService::append_pass_candidate_(const TuneCandidate &candidate) {
+  if (this->pass_count_ >= this->pass_candidates_.size() || this->evaluated_(candidate)) {
+    return;
+  }
+  for (uint8_t i = 0u; i < this->pass_count_; i++) {
+    if (tune_candidates_equal(this->pass_candidates_[i], candidate)) {
+      return;
+    }
+  }
+  this->pass_candidates_[this->pass_count_++] = candidate;
+}
+
+void MCF8329AInitialTuneService::begin_coarse_pass_() {
+  this->pass_number_ = 0u;
+  this->pass_index_ = 0u;
+  this->pass_count_ = 0u;
+  if (this->search_.accel_code_count == 0u || this->search_.handoff_code_count == 0u) {
+    for (const TuneCandidate &candidate : TUNE_DISCOVERY_CANDIDATES) {
+      this->append_pass_candidate_(candidate);
+    }
+    return;
+  }
+  // Handoff outer, accel inner: neighbouring runs differ in accel only, and
+  // the earliest handoffs, which spend least time in open loop, go first.
+  for (uint8_t h = 0u; h < this->search_.handoff_code_count; h++) {
+    for (uint8_t a = 0u; a < this->search_.accel_code_count; a++) {
+      TuneCandidate candidate = TUNE_DISCOVERY_CANDIDATES[0];
+      candidate.open_loop_accel_a1_code = this->search_.accel_codes[a];
+      candidate.handoff_code = this->search_.handoff_codes[h];
+      this->append_pass_candidate_(candidate);
+    }
+  }
+}
+
+bool MCF8329AInitialTuneService::begin_fine_pass_(uint32_t now_ms) {
+  while (this->pass_number_ < this->search_.fine_passes) {
+    const uint8_t shift = this->pass_number_;
+    this->account_(now_ms);
+    this->pass_number_++;
+    this->pass_index_ = 0u;
+    this->pass_count_ = 0u;
+    const int accel_step = this->search_.fine_accel_step >> shift;
+    const int handoff_step = this->search_.fine_handoff_step >> shift;
+    if (accel_step == 0 && handoff_step == 0) {
+      return false;
+    }
+
+    const TuneCandidate &best = this->report_.best;
+    TuneCandidate candidate = best;
+    if (accel_step > 0) {
+      candidate.open_loop_accel_a1_code =
+        static_cast<uint8_t>(std::min<int>(15, static_cast<int>(best.open_loop_accel_a1_code) + accel_step));
+      this->append_pass_candidate_(candidate);
+    }
+    if (handoff_step > 0) {
+      candidate = best;
+      candidate.handoff_code =
+        static_cast<uint8_t>(std::min<int>(31, static_cast<int>(best.handoff_code) + handoff_step));
+      this->append_pass_candidate_(candidate);
+      candidate = best;
+      candidate.handoff_code =
+        static_cast<uint8_t>(std::max<int>(0, static_cast<int>(best.handoff_code) - handoff_step));
+      this->append_pass_candidate_(candidate);
+    }
+    if (accel_step > 0) {
+      candidate = best;
+      candidate.open_loop_accel_a1_code =
+        static_cast<uint8_t>(std::max<int>(0, static_cast<int>(best.open_loop_accel_a1_code) - accel_step));
+      this->append_pass_candidate_(candidate);
+    }
+
+    if (this->pass_count_ > 0u) {
+      TuneEvent event = this->event_(TuneEventType::REFINEMENT_STARTED, now_ms);
+      event.reach_ms = this->report_.best_reach_ms;
+      event.score = this->report_.best_score;
+      this->emit_(event);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool MCF8329AInitialTuneService::advance_candidate_(uint32_t now_ms) {
+  this->pass_index_++;
+  if (this->pass_index_ < this->pass_count_) {
+    return true;
+  }
+  return this->best_valid_ && this->begin_fine_pass_(now_ms);
+}
+
+int32_t MCF8329AInitialTuneService::score_upper_bound_(uint32_t now_ms) const {
+  // Best case from here on: perfect tracking for the rest of the hold. Before
+  // closed loop the reach time is at least the time spent so far; after it,
+  // the reach time and the bad samples already counted are final.
+  CandidateQualityMetrics best_case{};
+  best_case.sample_count = 1u;
+  uint32_t reach_ms = now_ms - this->candidate_start_ms_;
+  if (this->closed_loop_seen_) {
+    best_case.unstable_count = this->candidate_metrics_.unstable_count;
+    best_case.telemetry_miss_count = this->candidate_metrics_.telemetry_miss_count;
+    reach_ms = this->candidate_reach_ms_;
+  }
+  return score_tune_candidate(this->active_candidate_(), reach_ms, best_case);
+}
+
+void MCF8329AInitialTuneService::record_successful_candidate_(const TuneCandidate &candidate, uint32_t reach_ms,
+                                                              const CandidateQualityMetrics &metrics,
+                                                              uint32_t now_ms) {
+  const int32_t score = score_tune_candidate(candidate, reach_ms, metrics);
+  this->report_.candidates_succeeded++;
+
+  TuneEvent event = this->event_(TuneEventType::CANDIDATE_SUCCEEDED, now_ms);
+  event.candidate = &candidate;
+  event.metrics = &metrics;
+  event.reach_ms = reach_ms;
+  event.score = score;
+  this->emit_(event);
+
+  if (!this->best_valid_ || score > this->report_.best_score) {
+    this->best_valid_ = true;
+    this->report_.best = candidate;
+    this->report_.best_reach_ms = reach_ms;
+    this->report_.best_score = score;
+    this->report_.best_metrics = metrics;
+  }
+}
+
+void MCF8329AInitialTuneService::fail_candidate_(const char *reason, uint32_t now_ms) {
+  TuneEvent event = this->event_(TuneEventType::CANDIDATE_FAILED, now_ms);
+  event.candidate = &this->active_candidate_();
+  event.reason = reason;
+  this->emit_(event);
+
+  this->set_motor_on_(false, "initial_tune_fail", now_ms);
+  this->actuator_->clear_faults();
+  this->waiting_fault_recovery_ = false;
+  this->last_fault_clear_ms_ = 0u;
+  this->reset_candidate_tracking_();
+  this->enter_stage_(TuneStage::COOLDOWN, now_ms);
+}
+
+void MCF8329AInitialTuneService::prune_candidate_(int32_t bound, uint32_t now_ms) {
+  this->report_.candidates_pruned++;
+  TuneEvent event = this->event_(TuneEventType::CANDIDATE_PRUNED, now_ms);
+  event.candidate = &this->active_candidate_();
+  event.reason = "cannot beat best score";
+  event.score = bound;
+  this->emit_(event);
+
+  this->set_motor_on_(false, "initial_tune_prune", now_ms);
+  this->reset_candidate_tracking_();
+  this->enter_stage_(TuneStage::COOLDOWN, now_ms);
+}
+
+void MCF8329AInitialTuneService::finish_(uint32_t now_ms) {
+  this->enter_stage_(TuneStage::IDLE, now_ms);
+  this->active_ = false;
+  this->waiting_fault_recovery_ = false;
+  this->last_fault_clear_ms_ = 0u;
+  this->reset_candidate_tracking_();
+  this->report_.total_ms = now_ms - this->report_.started_ms;
+  this->report_.succeeded = this->best_valid_;
+
+  TuneEvent event = this->event_(this->best_valid_ ? TuneEventType::TUNE_SUCCEEDED : TuneEventType::TUNE_FAILED,
+                                 now_ms);
+  if (this->best_valid_) {
+    event.candidate = &this->report_.best;
+    event.metrics = &this->report_.best_metrics;
+    event.reach_ms = this->report_.best_reach_ms;
+    event.score = this->report_.best_score;
+  }
+  this->emit_(event);
+}
+
+void MCF8329AInitialTuneService::update(const MCF8329AService &service, bool fault_active, uint32_t now_ms) {
+  if (!this->active_) {
+    return;
+  }
+  if (this->pass_index_ >= this->pass_count_) {
+    this->finish_(now_ms);
+    return;
+  }
+
+  switch (this->stage_) {
+    case TuneStage::APPLY:
+      this->process_apply_(service, now_ms);
+      return;
+    case TuneStage::START:
+      this->process_start_(service, now_ms);
+      return;
+    case TuneStage::MONITOR:
+      this->process_monitor_(service, fault_active, now_ms);
+      return;
+    case TuneStage::COOLDOWN:
+      this->process_cooldown_(fault_active, now_ms);
+      return;
+    case TuneStage::IDLE:
+    default:
+      this->active_ = false;
+      return;
+  }
+}
+
+void MCF8329AInitialTuneService::process_apply_(const MCF8329AService &service, uint32_t now_ms) {
+  const TuneCandidate &candidate = this->active_candidate_();
+  this->motor_driven_ = false;
+  this->report_.candidates_applied++;
+  if (this->evaluated_count_ < this->evaluated_candidates_.size()) {
+    this->evaluated_candidates_[this->evaluated_count_++] = candidate;
+  }
+  TuneEvent event = this->event_(TuneEventType::CANDIDATE_APPLY, now_ms);
+  event.candidate = &candidate;
+  this->emit_(event);
+  if (!apply_tune_candidate(service, candidate)) {
+    this->fail_candidate_("register write failed", now_ms);
+    return;
+  }
+  this->enter_stage_(TuneStage::START, now_ms);
+}
+
+void MCF8329AInitialTuneService::process_start_(const MCF8329AService &service, uint32_t now_ms) {
+  if ((now_ms - this->stage_started_ms_) < SETTLE_MS) {
+    return;
+  }
+  uint16_t algo_state = 0;
+  if (service.read_reg16(RegisterId::ALGORITHM_STATE, algo_state) && is_mpet_state(algo_state)) {
+    this->actuator_->clear_mpet_bits("initial_tune_wait");
+    if (!this->mpet_wait_reported_) {
+      TuneEvent event = this->event_(TuneEventType::WAITING_MPET_EXIT, now_ms);
+      event.algo_state = algo_state;
+      this->emit_(event);
+      this->mpet_wait_reported_ = true;
+    }
+    if ((now_ms - this->stage_started_ms_) < MPET_EXIT_TIMEOUT_MS) {
+      return;
+    }
+    this->fail_candidate_("MPET state did not exit", now_ms);
+    return;
+  }
+  this->mpet_wait_reported_ = false;
+  this->set_motor_on_(true, "initial_tune_start", now_ms);
+  if (!this->motor_on_) {
+    this->fail_candidate_("speed command failed", now_ms);
+    return;
+  }
+  const TuneCandidate &candidate = this->active_candidate_();
+  this->enter_stage_(TuneStage::MONITOR, now_ms);
+  this->candidate_start_ms_ = now_ms;
+  this->candidate_dwell_timeout_ms_ = this->open_loop_dwell_timeout_ms_(service, candidate);
+  this->candidate_monitor_timeout_ms_ = std::max(this->monitor_timeout_ms_(service, candidate),
+                                                 this->candidate_dwell_timeout_ms_ + SUCCESS_HOLD_MS + 1000u);
+  this->candidate_reach_ms_ = this->candidate_monitor_timeout_ms_;
+  this->reset_candidate_tracking_();
+
+  TuneEvent event = this->event_(TuneEventType::MONITOR_STARTED, now_ms);
+  event.monitor_timeout_ms = this->candidate_monitor_timeout_ms_;
+  event.dwell_timeout_ms = this->candidate_dwell_timeout_ms_;
+  this->emit_(event);
+}
+
+void MCF8329AInitialTuneService::process_monitor_(const MCF8329AService &service, bool fault_active,
+                                                  uint32_t now_ms) {
+  if (fault_active) {
+    this->fail_candidate_("fault asserted", now_ms);
+    return;
+  }
+
+  uint16_t algo_state = 0;
+  if (service.read_reg16(RegisterId::ALGORITHM_STATE, algo_state) && is_closed_loop_state(algo_state)) {
+    if (!this->closed_loop_seen_) {
+      this->reset_candidate_tracking_();
+      this->closed_loop_seen_ = true;
+      this->closed_loop_seen_ms_ = now_ms;
+      this->candidate_reach_ms_ =
+        now_ms >= this->candidate_start_ms_ ? (now_ms - this->candidate_start_ms_) : 0u;
+      TuneEvent event = this->event_(TuneEventType::CLOSED_LOOP_ENTERED, now_ms);
+      event.algo_state = algo_state;
+      event.reach_ms = this->candidate_reach_ms_;
+      this->emit_(event);
+    } else if ((now_ms - this->closed_loop_seen_ms_) >= HANDOFF_GUARD_GRACE_MS) {
+      float ref_ol_hz = 0.0f;
+      float fdbk_hz = 0.0f;
+      float fg_hz = 0.0f;
+      float max_speed_hz = 0.0f;
+      if (read_speed_triplet_hz(service, this->fallback_max_speed_hz_, ref_ol_hz, fdbk_hz, fg_hz, max_speed_hz)) {
+        this->telemetry_miss_counter_ = 0u;
+        const float commanded_hz = (SPEED_PERCENT / 100.0f) * max_speed_hz;
+        const bool unstable = handoff_feedback_unstable(commanded_hz, fdbk_hz, fg_hz);
+        record_candidate_quality_sample(this->candidate_metrics_, commanded_hz, fdbk_hz, fg_hz, unstable);
+        if (!unstable) {
+          this->unstable_counter_ = 0u;
+          if (handoff_feedback_stable(commanded_hz, fdbk_hz, fg_hz)) {
+            if (this->stable_counter_ < 0xFFu) {
+              this->stable_counter_++;
+            }
+          } else {
+            this->stable_counter_ = 0u;
+          }
+        } else {
+          this->unstable_counter_++;
+          this->stable_counter_ = 0u;
+          TuneEvent event = this->event_(TuneEventType::UNSTABLE_SAMPLE, now_ms);
+          event.sample = this->unstable_counter_;
+          event.sample_limit = HANDOFF_UNSTABLE_REJECT_COUNT;
+          event.commanded_hz = commanded_hz;
+          event.ref_ol_hz = ref_ol_hz;
+          event.fdbk_hz = fdbk_hz;
+          event.fg_hz = fg_hz;
+          this->emit_(event);
+          if (this->unstable_counter_ >= HANDOFF_UNSTABLE_REJECT_COUNT) {
+            this->fail_candidate_("handoff feedback unstable", now_ms);
+            return;
+          }
+        }
+      } else {
+        this->stable_counter_ = 0u;
+        if (this->telemetry_miss_counter_ < 0xFFu) {
+          this->telemetry_miss_counter_++;
+        }
+        if (this->candidate_metrics_.telemetry_miss_count < std::numeric_limits<uint16_t>::max()) {
+          this->candidate_metrics_.telemetry_miss_count++;
+        }
+        TuneEvent event = this->event_(TuneEventType::TELEMETRY_MISS, now_ms);
+        event.sample = this->telemetry_miss_counter_;
+        event.sample_limit = HANDOFF_TELEMETRY_MISS_REJECT_COUNT;
+        this->emit_(event);
+        if (this->telemetry_miss_counter_ >= HANDOFF_TELEMETRY_MISS_REJECT_COUNT) {
+          this->fail_candidate_("handoff telemetry unavailable", now_ms);
+          return;
+        }
+      }
+    }
+
+    if ((now_ms - this->closed_loop_seen_ms_) >= SUCCESS_HOLD_MS) {
+      if (this->stable_counter_ < HANDOFF_STABLE_ACCEPT_COUNT) {
+        return;
+      }
+      const TuneCandidate candidate = this->active_candidate_();
+      const CandidateQualityMetrics metrics = this->candidate_metrics_;
+      const uint32_t reach_ms = this->candidate_reach_ms_;
+      this->set_motor_on_(false, "initial_tune_success", now_ms);
+      this->record_successful_candidate_(candidate, reach_ms, metrics, now_ms);
+      this->reset_candidate_tracking_();
+      this->enter_stage_(TuneStage::COOLDOWN, now_ms);
+      return;
+    }
+  } else {
+    this->reset_candidate_tracking_();
+  }
+
+  if (this->search_.early_termination && this->best_valid_) {
+    const int32_t bound = this->score_upper_bound_(now_ms);
+    if (bound <= this->report_.best_score) {
+      this->prune_candidate_(bound, now_ms);
+      return;
+    }
+  }
+
+  if (!this->closed_loop_seen_ && (now_ms - this->candidate_start_ms_) >= this->candidate_dwell_timeout_ms_) {
+    this->fail_candidate_("open-loop dwell timeout (heating guard)", now_ms);
+    return;
+  }
+
+  if ((now_ms - this->stage_started_ms_) >= this->candidate_monitor_timeout_ms_) {
+    this->fail_candidate_("timeout waiting for closed-loop", now_ms);
+  }
+}
+
+void MCF8329AInitialTuneService::process_cooldown_(bool fault_active, uint32_t now_ms) {
+  // The cooldown lets the windings shed heat; a candidate that never got a
+  // speed command accepted has nothing to shed.
+  if (this->motor_driven_) {
+    if ((now_ms - this->stage_started_ms_) < COOLDOWN_MS) {
+      return;
+    }
+  } else if (!this->cooldown_skip_reported_) {
+    this->cooldown_skip_reported_ = true;
+    this->report_.cooldowns_skipped++;
+    this->emit_(this->event_(TuneEventType::COOLDOWN_SKIPPED, now_ms));
+  }
+  const bool locked_out = this->actuator_->speed_locked_out();
+  if (fault_active || locked_out) {
+    if (!this->waiting_fault_recovery_) {
+      this->waiting_fault_recovery_ = true;
+      TuneEvent event = this->event_(TuneEventType::WAITING_FAULT_RECOVERY, now_ms);
+      event.fault_active = fault_active;
+      event.locked_out = locked_out;
+      this->emit_(event);
+    }
+    if (this->last_fault_clear_ms_ == 0u ||
+        (now_ms - this->last_fault_clear_ms_) >= FAULT_RECOVERY_PULSE_INTERVAL_MS) {
+      this->actuator_->clear_faults();
+      this->last_fault_clear_ms_ = now_ms;
+    }
+    if (fault_active || this->actuator_->speed_locked_out()) {
+      return;
+    }
+  }
+  if (this->waiting_fault_recovery_) {
+    this->emit_(this->event_(TuneEventType::FAULT_RECOVERED, now_ms));
+    this->waiting_fault_recovery_ = false;
+    this->last_fault_clear_ms_ = 0u;
+  }
+  this->cooldown_skip_reported_ = false;
+  if (!this->advance_candidate_(now_ms)) {
+    this->finish_(now_ms);
+    return;
+  }
+  this->enter_stage_(TuneStage::APPLY, now_ms);
+}
+
+}  // namespace mcf8329a_core
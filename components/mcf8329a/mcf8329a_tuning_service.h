@@ -0,0 +1,335 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "mcf8329a_service.h"
+
+namespace mcf8329a_core {
+
+// Startup parameters swept by the initial tune, as raw register field codes.
+struct TuneCandidate {
+  uint8_t phase_ilimit_code;
+  uint8_t lock_ilimit_code;
+  uint8_t hw_lock_ilimit_code;
+  uint8_t open_loop_ilimit_code;
+  uint8_t open_loop_accel_a1_code;
+  uint8_t open_loop_accel_a2_code;
+  uint8_t handoff_code;
+  uint8_t theta_error_ramp_code;
+  uint8_t cl_slow_acc_code;
+  uint8_t lock_ilimit_deglitch_code;
+  uint8_t hw_lock_ilimit_deglitch_code;
+  bool auto_handoff_enable;
+  bool abn_bemf_lock_enable;
+};
+
+inline constexpr TuneCandidate TUNE_DISCOVERY_CANDIDATES[] = {
+  // Baseline: manual handoff at 14%, higher OL accel (250Hz/s).
+  {6u, 6u, 6u, 3u, 10u, 0u, 13u, 2u, 4u, 8u, 7u, false, false},
+  // Faster OL accel variant (500Hz/s) at same handoff.
+  {6u, 6u, 6u, 3u, 11u, 0u, 13u, 2u, 4u, 8u, 7u, false, false},
+  // Slightly later handoff with baseline accel.
+  {6u, 6u, 6u, 3u, 10u, 0u, 15u, 2u, 4u, 8u, 7u, false, false},
+  // Conservative fallback: lower accel with earlier handoff.
+  {6u, 6u, 6u, 3u, 9u, 0u, 11u, 2u, 4u, 8u, 7u, false, false},
+};
+inline constexpr size_t TUNE_DISCOVERY_CANDIDATE_COUNT =
+  sizeof(TUNE_DISCOVERY_CANDIDATES) / sizeof(TUNE_DISCOVERY_CANDIDATES[0]);
+
+bool tune_candidates_equal(const TuneCandidate &a, const TuneCandidate &b);
+// Writes the candidate into FAULT_CONFIG1/2, MOTOR_STARTUP2 and INT_ALGO_2.
+bool apply_tune_candidate(const MCF8329AService &service, const TuneCandidate &candidate);
+// Adds the candidate fields currently in those registers to `record`.
+bool record_tune_candidate_fields(const MCF8329AService &service, mcf83xx_common::TuningRecord &record);
+
+// Closed-loop quality accumulated after handoff, used to rank candidates
+// that all reached closed loop.
+struct CandidateQualityMetrics {
+  uint16_t sample_count{0u};
+  uint16_t telemetry_miss_count{0u};
+  uint16_t unstable_count{0u};
+  float tracking_error_sum_hz{0.0f};
+  float mismatch_error_sum_hz{0.0f};
+  float peak_speed_ratio{0.0f};
+};
+
+float candidate_avg_tracking_error_hz(const CandidateQualityMetrics &metrics);
+float candidate_avg_mismatch_error_hz(const CandidateQualityMetrics &metrics);
+void record_candidate_quality_sample(CandidateQualityMetrics &metrics, float commanded_hz, float fdbk_hz, float fg_hz,
+                                     bool unstable);
+// Higher is better: faster handoff, tighter tracking and fewer bad samples.
+int32_t score_tune_candidate(const TuneCandidate &candidate, uint32_t reach_ms,
+                             const CandidateQualityMetrics &metrics);
+bool handoff_feedback_unstable(float commanded_hz, float fdbk_hz, float fg_hz);
+bool handoff_feedback_stable(float commanded_hz, float fdbk_hz, float fg_hz);
+
+// MAX_SPEED from CLOSED_LOOP4, or `fallback_max_speed_hz` when it cannot be read.
+float read_max_speed_hz(const MCF8329AService &service, float fallback_max_speed_hz);
+// Open-loop reference, speed feedback and FG speed in Hz.
+bool read_speed_triplet_hz(const MCF8329AService &service, float fallback_max_speed_hz, float &ref_ol_hz,
+                           float &fdbk_hz, float &fg_hz, float &max_speed_hz);
+
+enum class TuneStage : uint8_t {
+  IDLE = 0,
+  APPLY,
+  START,
+  MONITOR,
+  COOLDOWN,
+  COUNT,
+};
+
+inline constexpr size_t TUNE_STAGE_COUNT = static_cast<size_t>(TuneStage::COUNT);
+
+const char *tune_stage_to_string(TuneStage stage);
+
+enum class TunePass : uint8_t {
+  COARSE = 0,
+  FINE,
+  COUNT,
+};
+
+inline constexpr size_t TUNE_PASS_COUNT = static_cast<size_t>(TunePass::COUNT);
+
+inline constexpr size_t MAX_TUNE_GRID_CODES = 6u;
+inline constexpr size_t MAX_TUNE_PASS_CANDIDATES = MAX_TUNE_GRID_CODES * MAX_TUNE_GRID_CODES;
+
+// Candidate search. Without grid codes the coarse pass is
+// TUNE_DISCOVERY_CANDIDATES; with them it is every accel x handoff pair on
+// top of the first discovery candidate's current limits.
+struct TuneSearchConfig {
+  std::array<uint8_t, MAX_TUNE_GRID_CODES> accel_codes{};
+  uint8_t accel_code_count{0u};
+  std::array<uint8_t, MAX_TUNE_GRID_CODES> handoff_codes{};
+  uint8_t handoff_code_count{0u};
+  // Fine passes after the coarse one; each halves both steps.
+  uint8_t fine_passes{2u};
+  uint8_t fine_accel_step{1u};
+  uint8_t fine_handoff_step{2u};
+  // Abort a candidate once it can no longer beat the best score so far.
+  bool early_termination{true};
+};
+
+// Adds `code` to a grid axis unless it is already there or the axis is full.
+bool add_tune_grid_code(std::array<uint8_t, MAX_TUNE_GRID_CODES> &codes, uint8_t &count, uint8_t code);
+
+// Motor control the sweep needs beyond register writes. The ESPHome facade
+// routes these through its speed command path; the replay harness drives a
+// recorded motor.
+class TuneActuator {
+ public:
+  virtual ~TuneActuator() = default;
+  // Commands `percent` immediately, without the software ramp.
+  virtual bool start_motor(float percent, const char *reason) = 0;
+  virtual void stop_motor(const char *reason) = 0;
+  virtual void clear_faults() = 0;
+  virtual void clear_mpet_bits(const char *reason) = 0;
+  // True while non-zero speed is refused after a severe fault.
+  virtual bool speed_locked_out() const = 0;
+};
+
+enum class TuneEventType : uint8_t {
+  STARTED = 0,
+  CANDIDATE_APPLY,
+  WAITING_MPET_EXIT,
+  MONITOR_STARTED,
+  CLOSED_LOOP_ENTERED,
+  UNSTABLE_SAMPLE,
+  TELEMETRY_MISS,
+  CANDIDATE_SUCCEEDED,
+  CANDIDATE_FAILED,
+  CANDIDATE_PRUNED,
+  REFINEMENT_STARTED,
+  COOLDOWN_SKIPPED,
+  WAITING_FAULT_RECOVERY,
+  FAULT_RECOVERED,
+  TUNE_SUCCEEDED,
+  TUNE_FAILED,
+};
+
+// One sweep decision. Only the fields relevant to `type` are set; pointers
+// are valid for the duration of the callback.
+struct TuneEvent {
+  TuneEventType type{TuneEventType::STARTED};
+  uint32_t now_ms{0u};
+  bool refinement{false};
+  // 0 for the coarse pass, then the fine pass number.
+  uint8_t pass{0u};
+  // 1-based position within the active pass, and the size of that pass.
+  uint8_t candidate_number{0u};
+  uint8_t candidate_count{0u};
+  const TuneCandidate *candidate{nullptr};
+  const CandidateQualityMetrics *metrics{nullptr};
+  const char *reason{nullptr};
+  uint16_t algo_state{0u};
+  uint32_t reach_ms{0u};
+  uint32_t monitor_timeout_ms{0u};
+  uint32_t dwell_timeout_ms{0u};
+  int32_t score{0};
+  uint8_t sample{0u};
+  uint8_t sample_limit{0u};
+  float commanded_hz{0.0f};
+  float ref_ol_hz{0.0f};
+  float fdbk_hz{0.0f};
+  float fg_hz{0.0f};
+  bool fault_active{false};
+  bool locked_out{false};
+};
+
+class TuneObserver {
+ public:
+  virtual ~TuneObserver() = default;
+  virtual void on_tune_event(const TuneEvent &event) = 0;
+};
+
+struct TuneReport {
+  uint32_t started_ms{0u};
+  uint32_t total_ms{0u};
+  // Time spent in each stage and pass, summed over all candidates, and the
+  // part of it with a speed command applied.
+  std::array<uint32_t, TUNE_STAGE_COUNT> stage_ms{};
+  std::array<uint32_t, TUNE_STAGE_COUNT> stage_motor_on_ms{};
+  std::array<uint32_t, TUNE_PASS_COUNT> pass_ms{};
+  std::array<uint32_t, TUNE_PASS_COUNT> pass_motor_on_ms{};
+  uint32_t motor_on_ms{0u};
+  uint8_t candidates_applied{0u};
+  uint8_t candidates_succeeded{0u};
+  uint8_t candidates_pruned{0u};
+  uint8_t cooldowns_skipped{0u};
+  bool succeeded{false};
+  TuneCandidate best{};
+  uint32_t best_reach_ms{0u};
+  int32_t best_score{std::numeric_limits<int32_t>::min()};
+  CandidateQualityMetrics best_metrics{};
+};
+
+// Initial-tune search. The coarse pass runs every grid candidate at a low
+// speed; fine passes then try neighbours of the best one with halving steps.
+// Once a candidate has succeeded, any other is aborted as soon as its best
+// achievable score cannot beat it. Time comes in through `now_ms` and
+// registers through the service, so a recorded trace can replay a whole tune
+// on the host.
+class MCF8329AInitialTuneService {
+ public:
+  explicit MCF8329AInitialTuneService(TuneActuator *actuator, TuneObserver *observer = nullptr)
+      : actuator_(actuator), observer_(observer) {}
+
+  static constexpr float SPEED_PERCENT = 11.0f;
+
+  // MAX_SPEED used when CLOSED_LOOP4 cannot be read.
+  void set_fallback_max_speed_hz(float max_speed_hz) { this->fallback_max_speed_hz_ = max_speed_hz; }
+  void set_search(const TuneSearchConfig &search) { this->search_ = search; }
+  const TuneSearchConfig &search() const { return this->search_; }
+
+  void start(uint32_t now_ms);
+  void reset();
+  // Advances the search; call from the periodic update while active().
+  void update(const MCF8329AService &service, bool fault_active, uint32_t now_ms);
+
+  bool active() const { return this->active_; }
+  TuneStage stage() const { return this->stage_; }
+  const TuneReport &report() const { return this->report_; }
+
+ protected:
+  static constexpr uint32_t SETTLE_MS = 250u;
+  static constexpr uint32_t MONITOR_TIMEOUT_MS = 7000u;
+  static constexpr uint32_t MONITOR_TIMEOUT_MIN_MS = 7000u;
+  static constexpr uint32_t MONITOR_TIMEOUT_MAX_MS = 45000u;
+  static constexpr float MONITOR_TIMEOUT_SCALE = 1.6f;
+  static constexpr uint32_t MONITOR_TIMEOUT_MARGIN_MS = 2500u;
+  static constexpr uint32_t OPEN_LOOP_DWELL_TIMEOUT_MIN_MS = 2000u;
+  static constexpr uint32_t OPEN_LOOP_DWELL_TIMEOUT_MAX_MS = 12000u;
+  static constexpr float OPEN_LOOP_DWELL_TIMEOUT_SCALE = 1.3f;
+  static constexpr uint32_t OPEN_LOOP_DWELL_TIMEOUT_MARGIN_MS = 1200u;
+  static constexpr uint32_t SUCCESS_HOLD_MS = 800u;
+  static constexpr uint32_t HANDOFF_GUARD_GRACE_MS = 250u;
+  static constexpr uint32_t COOLDOWN_MS = 700u;
+  static constexpr uint32_t FAULT_RECOVERY_PULSE_INTERVAL_MS = 500u;
+  static constexpr uint32_t MPET_EXIT_TIMEOUT_MS = 3000u;
+  static constexpr uint8_t HANDOFF_UNSTABLE_REJECT_COUNT = 2u;
+  static constexpr uint8_t HANDOFF_STABLE_ACCEPT_COUNT = 2u;
+  static constexpr uint8_t HANDOFF_TELEMETRY_MISS_REJECT_COUNT = 3u;
+  static constexpr size_t MAX_EVALUATED_CANDIDATES = 64u;
+
+  TuneEvent event_(TuneEventType type, uint32_t now_ms) const;
+  void emit_(const TuneEvent &event) const;
+  // Books the time since the last call against the current stage, pass and
+  // motor state; call before changing any of them.
+  void account_(uint32_t now_ms);
+  void enter_stage_(TuneStage stage, uint32_t now_ms);
+  void set_motor_on_(bool on, const char *reason, uint32_t now_ms);
+  void reset_candidate_tracking_();
+
+  bool estimate_handoff_time_ms_(const MCF8329AService &service, const TuneCandidate &candidate,
+                                 float &est_handoff_ms) const;
+  uint32_t open_loop_dwell_timeout_ms_(const MCF8329AService &service, const TuneCandidate &candidate) const;
+  uint32_t monitor_timeout_ms_(const MCF8329AService &service, const TuneCandidate &candidate) const;
+
+  bool fine_pass_() const { return this->pass_number_ > 0u; }
+  const TuneCandidate &active_candidate_() const { return this->pass_candidates_[this->pass_index_]; }
+  bool evaluated_(const TuneCandidate &candidate) const;
+  void append_pass_candidate_(const TuneCandidate &candidate);
+  void begin_coarse_pass_();
+  // Builds the next fine pass around the best candidate; false when no
+  // untried neighbour is left.
+  bool begin_fine_pass_(uint32_t now_ms);
+  // Moves to the next untried candidate, starting fine passes as needed;
+  // false when the search is over.
+  bool advance_candidate_(uint32_t now_ms);
+  // Score the current candidate can still reach at best, assuming every
+  // remaining sample is perfect.
+  int32_t score_upper_bound_(uint32_t now_ms) const;
+  void record_successful_candidate_(const TuneCandidate &candidate, uint32_t reach_ms,
+                                    const CandidateQualityMetrics &metrics, uint32_t now_ms);
+  void fail_candidate_(const char *reason, uint32_t now_ms);
+  void prune_candidate_(int32_t bound, uint32_t now_ms);
+  void finish_(uint32_t now_ms);
+
+  void process_apply_(const MCF8329AService &service, uint32_t now_ms);
+  void process_start_(const MCF8329AService &service, uint32_t now_ms);
+  void process_monitor_(const MCF8329AService &service, bool fault_active, uint32_t now_ms);
+  void process_cooldown_(bool fault_active, uint32_t now_ms);
+
+  TuneActuator *actuator_;
+  TuneObserver *observer_;
+  float fallback_max_speed_hz_{0.0f};
+  TuneSearchConfig search_{};
+
+  bool active_{false};
+  TuneStage stage_{TuneStage::IDLE};
+  uint32_t stage_started_ms_{0u};
+  uint32_t accounted_ms_{0u};
+  bool motor_on_{false};
+  // Set once the current candidate's speed command was accepted; a failure
+  // before that drove no current, so its cooldown is skipped.
+  bool motor_driven_{false};
+  bool cooldown_skip_reported_{false};
+  bool waiting_fault_recovery_{false};
+  bool mpet_wait_reported_{false};
+  uint32_t last_fault_clear_ms_{0u};
+  bool closed_loop_seen_{false};
+  uint32_t closed_loop_seen_ms_{0u};
+  uint32_t candidate_start_ms_{0u};
+  uint32_t candidate_reach_ms_{MONITOR_TIMEOUT_MS};
+  uint32_t candidate_monitor_timeout_ms_{MONITOR_TIMEOUT_MS};
+  uint32_t candidate_dwell_timeout_ms_{MONITOR_TIMEOUT_MS};
+  uint8_t unstable_counter_{0u};
+  uint8_t stable_counter_{0u};
+  uint8_t telemetry_miss_counter_{0u};
+  CandidateQualityMetrics candidate_metrics_{};
+
+  // 0 is the coarse pass; fine passes count up from 1.
+  uint8_t pass_number_{0u};
+  uint8_t pass_index_{0u};
+  uint8_t pass_count_{0u};
+  std::array<TuneCandidate, MAX_TUNE_PASS_CANDIDATES> pass_candidates_{};
+  std::array<TuneCandidate, MAX_EVALUATED_CANDIDATES> evaluated_candidates_{};
+  size_t evaluated_count_{0u};
+  bool best_valid_{false};
+
+  TuneReport report_{};
+};
+
+}  // namespace mcf8329a_core
@@ -0,0 +1,210 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace mcf83xx_common {
+
+// Loop-driven I2C link bring-up: an optional address scan, then target probes
+// with exponential backoff. Each step() costs at most one scan chunk or one
+// probe, so setup() and loop() never wait on the device. Past the deadline the
+// link counts as failed for boot and retries continue at the backoff ceiling.
+struct CommsBringupConfig {
+  // First retry delay; doubles after each failed attempt up to the ceiling.
+  uint32_t initial_backoff_ms{10};
+  uint32_t max_backoff_ms{1000};
+  uint32_t deadline_ms{5000};
+  bool scan{false};
+  uint8_t scan_first_address{0x08};
+  uint8_t scan_last_address{0x77};
+  uint8_t scan_addresses_per_step{8};
+  // Rescan interval after the deadline, when scanning is enabled.
+  uint32_t deferred_scan_interval_ms{5000};
+};
+
+// Bus access the bring-up drives; the chip component implements it.
+class CommsProbe {
+ public:
+  virtual ~CommsProbe() = default;
+
+  // True when `address` ACKs an empty transfer.
+  virtual bool ack_address(uint8_t address) = 0;
+  // True when the target answers its register probe.
+  virtual bool probe_target() = 0;
+};
+
+enum class CommsState : uint8_t {
+  IDLE = 0,
+  SCANNING,
+  CONNECTING,
+  // Deadline passed; retrying at max_backoff_ms.
+  DEFERRED,
+  ESTABLISHED,
+};
+
+enum class CommsEvent : uint8_t {
+  NONE = 0,
+  SCAN_DONE,
+  ATTEMPT_FAILED,
+  // Also a failed attempt: the one that crossed the deadline.
+  DEADLINE_EXPIRED,
+  ESTABLISHED,
+};
+
+struct CommsStep {
+  CommsEvent event{CommsEvent::NONE};
+  // For failed attempts: the address ACKed but the register probe failed.
+  bool acked{false};
+};
+
+class CommsBringup {
+ public:
+  void start(const CommsBringupConfig &config, uint8_t target_address, uint32_t now_ms) {
+    this->config_ = config;
+    if (this->config_.max_backoff_ms < this->config_.initial_backoff_ms) {
+      this->config_.max_backoff_ms = this->config_.initial_backoff_ms;
+    }
+    if (this->config_.scan_addresses_per_step == 0U) {
+      this->config_.scan_addresses_per_step = 1U;
+    }
+    this->target_ = target_address;
+    this->started_ms_ = now_ms;
+    this->last_attempt_ms_ = now_ms;
+    this->retry_delay_ms_ = 0;
+    this->backoff_ms_ = this->config_.initial_backoff_ms;
+    this->attempts_ = 0;
+    this->first_ack_valid_ = false;
+    this->first_ack_ms_ = 0;
+    this->established_ms_ = 0;
+    this->deferred_ = false;
+    this->found_.fill(0U);
+    this->found_count_ = 0;
+    if (this->config_.scan) {
+      this->begin_scan_(now_ms);
+    } else {
+      this->state_ = CommsState::CONNECTING;
+    }
+  }
+
+  CommsStep step(CommsProbe &probe, uint32_t now_ms) {
+    switch (this->state_) {
+      case CommsState::SCANNING:
+        return this->step_scan_(probe, now_ms);
+      case CommsState::CONNECTING:
+      case CommsState::DEFERRED:
+        if (this->deferred_ && this->config_.scan &&
+            (now_ms - this->last_scan_ms_) >= this->config_.deferred_scan_interval_ms) {
+          this->begin_scan_(now_ms);
+          return {};
+        }
+        if ((now_ms - this->last_attempt_ms_) < this->retry_delay_ms_) {
+          return {};
+        }
+        return this->attempt_(probe, now_ms);
+      default:
+        return {};
+    }
+  }
+
+  CommsState state() const { return this->state_; }
+  bool established() const { return this->state_ == CommsState::ESTABLISHED; }
+  uint8_t target_address() const { return this->target_; }
+  const CommsBringupConfig &config() const { return this->config_; }
+  uint32_t attempts() const { return this->attempts_; }
+  // Delay before the next attempt.
+  uint32_t retry_delay_ms() const { return this->retry_delay_ms_; }
+  // Time from start() until the target first ACKed, by scan or probe.
+  bool first_ack_ms(uint32_t &ms) const {
+    ms = this->first_ack_ms_;
+    return this->first_ack_valid_;
+  }
+  // Time from start() until the link was established.
+  uint32_t established_ms() const { return this->established_ms_; }
+
+  // Results of the latest completed or running scan.
+  bool scan_found(uint8_t address) const {
+    return address < 128U && (this->found_[address / 32U] & (1U << (address % 32U))) != 0U;
+  }
+  uint8_t scan_found_count() const { return this->found_count_; }
+
+ protected:
+  void begin_scan_(uint32_t now_ms) {
+    this->state_ = CommsState::SCANNING;
+    this->scan_next_ = this->config_.scan_first_address;
+    this->last_scan_ms_ = now_ms;
+    this->found_.fill(0U);
+    this->found_count_ = 0;
+  }
+
+  CommsStep step_scan_(CommsProbe &probe, uint32_t now_ms) {
+    const uint16_t last = this->config_.scan_last_address < 128U ? this->config_.scan_last_address : 127U;
+    for (uint8_t count = 0; count < this->config_.scan_addresses_per_step && this->scan_next_ <= last; count++) {
+      const uint8_t address = static_cast<uint8_t>(this->scan_next_++);
+      if (!probe.ack_address(address)) {
+        continue;
+      }
+      this->found_[address / 32U] |= 1U << (address % 32U);
+      this->found_count_++;
+      if (address == this->target_) {
+        this->note_ack_(now_ms);
+      }
+    }
+    if (this->scan_next_ <= last) {
+      return {};
+    }
+    this->last_scan_ms_ = now_ms;
+    this->state_ = this->deferred_ ? CommsState::DEFERRED : CommsState::CONNECTING;
+    return {CommsEvent::SCAN_DONE, false};
+  }
+
+  CommsStep attempt_(CommsProbe &probe, uint32_t now_ms) {
+    this->attempts_++;
+    this->last_attempt_ms_ = now_ms;
+    const bool acked = probe.ack_address(this->target_);
+    if (acked) {
+      this->note_ack_(now_ms);
+      if (probe.probe_target()) {
+        this->state_ = CommsState::ESTABLISHED;
+        this->established_ms_ = now_ms - this->started_ms_;
+        return {CommsEvent::ESTABLISHED, true};
+      }
+    }
+    if (!this->deferred_ && (now_ms - this->started_ms_) >= this->config_.deadline_ms) {
+      this->deferred_ = true;
+      this->state_ = CommsState::DEFERRED;
+      this->retry_delay_ms_ = this->config_.max_backoff_ms;
+      return {CommsEvent::DEADLINE_EXPIRED, acked};
+    }
+    this->retry_delay_ms_ = this->backoff_ms_;
+    this->backoff_ms_ = this->backoff_ms_ >= this->config_.max_backoff_ms / 2U ? this->config_.max_backoff_ms
+                                                                               : this->backoff_ms_ * 2U;
+    return {CommsEvent::ATTEMPT_FAILED, acked};
+  }
+
+  void note_ack_(uint32_t now_ms) {
+    if (!this->first_ack_valid_) {
+      this->first_ack_valid_ = true;
+      this->first_ack_ms_ = now_ms - this->started_ms_;
+    }
+  }
+
+  CommsBringupConfig config_{};
+  CommsState state_{CommsState::IDLE};
+  uint8_t target_{0};
+  bool deferred_{false};
+  uint32_t started_ms_{0};
+  uint32_t last_attempt_ms_{0};
+  uint32_t retry_delay_ms_{0};
+  uint32_t backoff_ms_{0};
+  uint32_t attempts_{0};
+  bool first_ack_valid_{false};
+  uint32_t first_ack_ms_{0};
+  uint32_t established_ms_{0};
+  uint16_t scan_next_{0};
+  uint32_t last_scan_ms_{0};
+  std::array<uint32_t, 4> found_{};
+  uint8_t found_count_{0};
+};
+
+}  // namespace mcf83xx_common
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../component_common/register_info.h"
+#include "poll_service.h"
+
+namespace mcf83xx_common {
+
+// Register groups a chip's fault publisher and diagnostic logs consume; each
+// chip defines its own group bits.
+using DiagnosticGroups = uint8_t;
+
+// Registers one update() diagnoses from, each read at most once per poll.
+// `Tables` provides everything PollService needs plus
+//   static constexpr DiagnosticGroups groups(RegisterId);
+// begin() adopts what the poll service just read; require() then reads the
+// missing registers of the requested groups in definition order. Call
+// require() once with every group known up front and again only for groups
+// that depend on a value it read.
+template<typename Tables> class DiagnosticSnapshot {
+ public:
+  using RegisterId = typename Tables::RegisterId;
+
+  // Starts a new poll with nothing read, for use outside update().
+  void begin() {
+    this->values_.fill(0);
+    this->valid_.fill(false);
+    this->attempted_.fill(false);
+    this->transactions_ = 0;
+    this->active_ = true;
+  }
+  // Starts a new poll seeded with the registers `poll` read fresh, so the
+  // status tier and any polled configuration cost nothing here. A register
+  // the poll failed to read is left to require(); that retry is the only way
+  // one register costs two transactions in a poll.
+  template<typename Poll> void begin(const Poll &poll) {
+    this->begin();
+    for (const auto &definition : Tables::DEFINITIONS) {
+      const size_t reg = index_(definition.id);
+      if (Tables::tier(definition.id) != PollTier::NONE && poll.fresh(definition.id, this->values_[reg])) {
+        this->attempted_[reg] = true;
+        this->valid_[reg] = true;
+      }
+    }
+  }
+  // Ends the poll; value() and complete() report nothing until begin().
+  void end() { this->active_ = false; }
+  bool active() const { return this->active_; }
+
+  // Reads every register of `groups` not yet attempted this poll and returns
+  // true if it read any. Failed reads are not retried before the next
+  // begin(). `Service` provides read_reg32() and read_reg16() by RegisterId.
+  template<typename Service> bool require(const Service &service, DiagnosticGroups groups) {
+    bool read = false;
+    for (const auto &definition : Tables::DEFINITIONS) {
+      const size_t reg = index_(definition.id);
+      if ((Tables::groups(definition.id) & groups) == 0 || this->attempted_[reg]) {
+        continue;
+      }
+      this->attempted_[reg] = true;
+      this->transactions_++;
+      read = true;
+      if (definition.width == component_common::RegisterWidth::U16) {
+        uint16_t value = 0;
+        this->valid_[reg] = service.read_reg16(definition.id, value);
+        this->values_[reg] = this->valid_[reg] ? value : 0U;
+      } else {
+        uint32_t value = 0;
+        this->valid_[reg] = service.read_reg32(definition.id, value);
+        this->values_[reg] = this->valid_[reg] ? value : 0U;
+      }
+    }
+    return read;
+  }
+
+  bool value(RegisterId id, uint32_t &value) const {
+    if (!this->valid(id)) {
+      return false;
+    }
+    value = this->values_[index_(id)];
+    return true;
+  }
+  // True when `id` was read successfully this poll.
+  bool valid(RegisterId id) const { return this->active_ && this->valid_[index_(id)]; }
+  // Value read this poll, or 0 when it was not read successfully.
+  uint32_t raw(RegisterId id) const { return this->valid(id) ? this->values_[index_(id)] : 0U; }
+  // True when every register of `groups` was read successfully.
+  bool complete(DiagnosticGroups groups) const {
+    if (!this->active_) {
+      return false;
+    }
+    for (const auto &definition : Tables::DEFINITIONS) {
+      if ((Tables::groups(definition.id) & groups) != 0 && !this->valid_[index_(definition.id)]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  // Bus transactions issued since begin().
+  uint32_t transactions() const { return this->transactions_; }
+
+ protected:
+  static constexpr size_t index_(RegisterId id) { return static_cast<size_t>(id); }
+
+  std::array<uint32_t, Tables::REGISTER_COUNT> values_{};
+  std::array<bool, Tables::REGISTER_COUNT> valid_{};
+  std::array<bool, Tables::REGISTER_COUNT> attempted_{};
+  uint32_t transactions_{0};
+  bool active_{false};
+};
+
+}  // namespace mcf83xx_common
@@ -0,0 +1,229 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../component_common/register_info.h"
+
+namespace mcf83xx_common {
+
+// Register groups read by the periodic update. STATUS is read every cycle,
+// SPEED at the fast interval while the motor is running, and SLOW at the slow
+// interval or as soon as one of its registers is invalidated.
+enum class PollTier : uint8_t {
+  STATUS = 0,
+  SPEED,
+  SLOW,
+  COUNT,
+  NONE = COUNT,
+};
+
+inline constexpr size_t POLL_TIER_COUNT = static_cast<size_t>(PollTier::COUNT);
+
+struct PollSchedule {
+  // 0 polls the tier on every cycle it is eligible for.
+  uint32_t speed_interval_ms{0};
+  uint32_t slow_interval_ms{5000};
+};
+
+struct PollTierStats {
+  uint32_t cycles{0};
+  uint32_t transactions{0};
+  uint32_t failures{0};
+};
+
+// Per-chip poll table. `Tables` provides:
+//   using RegisterId;                      the chip's register enum
+//   static constexpr size_t REGISTER_COUNT;
+//   static constexpr auto &DEFINITIONS;    the chip's REGISTER_DEFINITIONS
+//   static constexpr PollTier tier(RegisterId);
+//   static constexpr RegisterId SPEED_FEEDBACK;  RegisterId::COUNT if none
+// Polled registers must be 32-bit.
+template<typename Tables> struct PollTierRegisters {
+  std::array<typename Tables::RegisterId, Tables::REGISTER_COUNT> ids{};
+  size_t count{0};
+};
+
+// Registers of one tier, in definition order.
+template<typename Tables> constexpr PollTierRegisters<Tables> poll_tier_registers(PollTier tier) {
+  PollTierRegisters<Tables> registers{};
+  for (const auto &definition : Tables::DEFINITIONS) {
+    if (Tables::tier(definition.id) == tier) {
+      registers.ids[registers.count++] = definition.id;
+    }
+  }
+  return registers;
+}
+
+template<typename Tables> constexpr bool poll_tiers_are_u32() {
+  for (const auto &definition : Tables::DEFINITIONS) {
+    if (Tables::tier(definition.id) != PollTier::NONE && definition.width != component_common::RegisterWidth::U32) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Reads the update() register set tier by tier and keeps the last value of
+// each polled register, so consumers read cached values instead of issuing
+// their own transactions. `Service` is the chip service; only its
+// read_reg32(RegisterId, uint32_t &) is used.
+template<typename Tables> class PollService {
+ public:
+  using RegisterId = typename Tables::RegisterId;
+
+  static constexpr std::array<PollTierRegisters<Tables>, POLL_TIER_COUNT> TIER_REGISTERS{{
+      poll_tier_registers<Tables>(PollTier::STATUS),
+      poll_tier_registers<Tables>(PollTier::SPEED),
+      poll_tier_registers<Tables>(PollTier::SLOW),
+  }};
+  static_assert(poll_tiers_are_u32<Tables>(), "MCx83xx polled registers must be 32-bit");
+
+  void set_schedule(const PollSchedule &schedule) { this->schedule_ = schedule; }
+  const PollSchedule &schedule() const { return this->schedule_; }
+  // Disabled registers are skipped by their tier; use it for values nothing
+  // consumes.
+  void set_register_enabled(RegisterId id, bool enabled) {
+    this->disabled_[index_(id)] = !enabled;
+    if (!enabled) {
+      this->valid_[index_(id)] = false;
+      this->fresh_[index_(id)] = false;
+    }
+  }
+
+  // Polls `tier` on the next cycle regardless of its interval.
+  void request(PollTier tier) {
+    if (tier != PollTier::NONE) {
+      this->requested_[index_(tier)] = true;
+    }
+  }
+  // Marks a cached value stale, e.g. after a write, and requests its tier.
+  void invalidate(RegisterId id) {
+    const PollTier tier = Tables::tier(id);
+    if (tier == PollTier::NONE) {
+      return;
+    }
+    this->valid_[index_(id)] = false;
+    this->request(tier);
+  }
+  // Forgets every cached value and requests all tiers.
+  void reset() {
+    this->valid_.fill(false);
+    this->fresh_.fill(false);
+    this->requested_.fill(true);
+  }
+
+  // Reads every tier that is due. `commanded` is true while a speed command
+  // is applied; the speed tier also keeps running until feedback reads zero.
+  template<typename Service> void poll(const Service &service, uint32_t now_ms, bool commanded) {
+    this->fresh_.fill(false);
+    this->polled_.fill(false);
+    // The speed tier is gated on the cached feedback, so decide every tier
+    // before reading any of them.
+    bool due[POLL_TIER_COUNT];
+    for (size_t i = 0; i < POLL_TIER_COUNT; i++) {
+      due[i] = this->due_(static_cast<PollTier>(i), now_ms, commanded);
+    }
+    for (size_t i = 0; i < POLL_TIER_COUNT; i++) {
+      if (due[i]) {
+        this->read_tier_(service, static_cast<PollTier>(i), now_ms);
+      }
+    }
+  }
+
+  // True while a speed command is applied or the last feedback was non-zero.
+  bool running(bool commanded) const {
+    if (commanded) {
+      return true;
+    }
+    if constexpr (Tables::SPEED_FEEDBACK == RegisterId::COUNT) {
+      return false;
+    } else {
+      const size_t speed = index_(Tables::SPEED_FEEDBACK);
+      return this->valid_[speed] && this->values_[speed] != 0u;
+    }
+  }
+  // True when the tier was read by the most recent poll().
+  bool polled(PollTier tier) const { return this->polled_[index_(tier)]; }
+  // Value read successfully by the most recent poll().
+  bool fresh(RegisterId id, uint32_t &value) const {
+    const size_t reg = index_(id);
+    if (!this->fresh_[reg]) {
+      return false;
+    }
+    value = this->values_[reg];
+    return true;
+  }
+  // Last value read successfully, however old.
+  bool cached(RegisterId id, uint32_t &value) const {
+    const size_t reg = index_(id);
+    if (!this->valid_[reg]) {
+      return false;
+    }
+    value = this->values_[reg];
+    return true;
+  }
+
+  const PollTierStats &stats(PollTier tier) const { return this->stats_[index_(tier)]; }
+
+ protected:
+  static constexpr size_t index_(PollTier tier) { return static_cast<size_t>(tier); }
+  static constexpr size_t index_(RegisterId id) { return static_cast<size_t>(id); }
+
+  bool due_(PollTier tier, uint32_t now_ms, bool commanded) const {
+    const size_t index = index_(tier);
+    switch (tier) {
+      case PollTier::STATUS:
+        return true;
+      case PollTier::SPEED:
+        if (TIER_REGISTERS[index].count == 0 || !this->running(commanded)) {
+          return false;
+        }
+        return this->requested_[index] ||
+               (now_ms - this->last_poll_ms_[index]) >= this->schedule_.speed_interval_ms;
+      case PollTier::SLOW:
+        return this->requested_[index] ||
+               (now_ms - this->last_poll_ms_[index]) >= this->schedule_.slow_interval_ms;
+      default:
+        return false;
+    }
+  }
+
+  template<typename Service> void read_tier_(const Service &service, PollTier tier, uint32_t now_ms) {
+    const size_t index = index_(tier);
+    PollTierStats &stats = this->stats_[index];
+    const PollTierRegisters<Tables> &registers = TIER_REGISTERS[index];
+    for (size_t i = 0; i < registers.count; i++) {
+      const size_t reg = index_(registers.ids[i]);
+      if (this->disabled_[reg]) {
+        continue;
+      }
+      uint32_t value = 0;
+      stats.transactions++;
+      if (service.read_reg32(registers.ids[i], value)) {
+        this->values_[reg] = value;
+        this->valid_[reg] = true;
+        this->fresh_[reg] = true;
+      } else {
+        stats.failures++;
+      }
+    }
+    stats.cycles++;
+    this->polled_[index] = true;
+    this->requested_[index] = false;
+    this->last_poll_ms_[index] = now_ms;
+  }
+
+  PollSchedule schedule_{};
+  std::array<uint32_t, Tables::REGISTER_COUNT> values_{};
+  std::array<bool, Tables::REGISTER_COUNT> valid_{};
+  std::array<bool, Tables::REGISTER_COUNT> fresh_{};
+  std::array<bool, Tables::REGISTER_COUNT> disabled_{};
+  std::array<bool, POLL_TIER_COUNT> requested_{{true, true, true}};
+  std::array<bool, POLL_TIER_COUNT> polled_{};
+  std::array<uint32_t, POLL_TIER_COUNT> last_poll_ms_{};
+  std::array<PollTierStats, POLL_TIER_COUNT> stats_{};
+};
+
+}  // namespace mcf83xx_common
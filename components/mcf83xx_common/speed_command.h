@@ -0,0 +1,164 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+
+namespace mcf83xx_common {
+
+// ALGO_DEBUG1 digital speed override, the same bits on every family member:
+// OVERRIDE (bit 31) selects DIGITAL_SPEED_CTRL (bits 30:16) as the speed
+// reference, in 1/32767 of MAX_SPEED.
+inline constexpr uint32_t SPEED_OVERRIDE_MASK = 1U << 31;
+inline constexpr uint32_t DIGITAL_SPEED_CTRL_SHIFT = 16;
+inline constexpr uint32_t DIGITAL_SPEED_CTRL_MAX = 0x7FFFU;
+inline constexpr uint32_t DIGITAL_SPEED_CTRL_MASK = DIGITAL_SPEED_CTRL_MAX << DIGITAL_SPEED_CTRL_SHIFT;
+inline constexpr uint32_t SPEED_COMMAND_MASK = SPEED_OVERRIDE_MASK | DIGITAL_SPEED_CTRL_MASK;
+
+constexpr float clamp_speed_percent(float percent) {
+  return percent < 0.0f ? 0.0f : (percent > 100.0f ? 100.0f : percent);
+}
+
+// DIGITAL_SPEED_CTRL code for a command in percent, clamped to 0..100. The
+// caller rejects NaN.
+inline uint16_t speed_percent_to_code(float percent) {
+  return static_cast<uint16_t>(lroundf((clamp_speed_percent(percent) / 100.0f) * 32767.0f));
+}
+
+constexpr float speed_code_to_percent(uint32_t code) {
+  return (static_cast<float>(code & DIGITAL_SPEED_CTRL_MAX) * 100.0f) / 32767.0f;
+}
+
+// ALGO_DEBUG1 bits under SPEED_COMMAND_MASK for an overridden speed command.
+constexpr uint32_t speed_command_value(uint16_t code) {
+  return SPEED_OVERRIDE_MASK | ((static_cast<uint32_t>(code) << DIGITAL_SPEED_CTRL_SHIFT) & DIGITAL_SPEED_CTRL_MASK);
+}
+
+// Next software-ramped speed command (percent) moving `applied` toward
+// `desired`; a non-positive rate jumps straight to `desired`.
+inline float speed_ramp_step(float applied, float desired, float up_percent_per_s, float down_percent_per_s,
+                             float dt_s) {
+  if (desired > applied) {
+    if (up_percent_per_s <= 0.0f) {
+      return desired;
+    }
+    const float next = applied + (up_percent_per_s * dt_s);
+    return next < desired ? next : desired;
+  }
+  if (desired < applied) {
+    if (down_percent_per_s <= 0.0f) {
+      return desired;
+    }
+    const float next = applied - (down_percent_per_s * dt_s);
+    return next > desired ? next : desired;
+  }
+  return applied;
+}
+
+// One update of the speed command ramp. With the hardware ramp CLOSED_LOOP1
+// slews the reference, so the command moves straight to `desired`.
+inline float speed_command_step(bool hardware_ramp, float applied, float desired, float up_percent_per_s,
+                                float down_percent_per_s, float dt_s) {
+  if (hardware_ramp) {
+    return speed_ramp_step(applied, desired, 0.0f, 0.0f, dt_s);
+  }
+  return speed_ramp_step(applied, desired, up_percent_per_s, down_percent_per_s, dt_s);
+}
+
+struct SpeedRampConfig {
+  // Percent of MAX_SPEED per second; 0 jumps straight to the target.
+  float up_percent_per_s{0.0f};
+  float down_percent_per_s{0.0f};
+  // CLOSED_LOOP1 slews the reference, so only the start boost is timed here.
+  bool hardware{false};
+  // Held for `start_boost_hold_ms` when starting from standstill below it.
+  float start_boost_percent{0.0f};
+  uint32_t start_boost_hold_ms{0};
+};
+
+// Loop-driven speed command ramp and start boost. The chip owns the write:
+// start() says whether a target needs stepping at all, step() yields each
+// command to write and settle() ends the ramp once the applied command
+// reaches the target.
+class SpeedCommandRamp {
+ public:
+  void set_config(const SpeedRampConfig &config) { this->config_ = config; }
+  const SpeedRampConfig &config() const { return this->config_; }
+
+  bool active() const { return this->active_; }
+  float target() const { return this->target_percent_; }
+
+  // Drops any pending target and boost.
+  void cancel() {
+    this->active_ = false;
+    this->boost_active_ = false;
+    this->boost_until_ms_ = 0;
+    this->last_update_ms_ = 0;
+  }
+
+  // Starts moving from `applied` toward `target` (already clamped). Returns
+  // false when neither the ramp nor the boost applies and the caller should
+  // write `target` directly; the ramp is then idle.
+  bool start(float target, float applied, uint32_t now_ms) {
+    const bool ramp_enabled =
+      !this->config_.hardware && (this->config_.up_percent_per_s > 0.0f || this->config_.down_percent_per_s > 0.0f);
+    const bool boost_enabled = this->config_.start_boost_percent > target && this->config_.start_boost_hold_ms > 0 &&
+                               applied <= 0.05f;
+    if (target <= 0.0f || (!ramp_enabled && !boost_enabled)) {
+      this->cancel();
+      return false;
+    }
+    this->target_percent_ = target;
+    this->active_ = true;
+    this->boost_active_ = boost_enabled;
+    this->boost_until_ms_ = boost_enabled ? now_ms + this->config_.start_boost_hold_ms : 0;
+    this->last_update_ms_ = now_ms;
+    return true;
+  }
+
+  // Command to write next, moving from `applied`. Returns false when there is
+  // nothing to write this time.
+  bool step(float applied, uint32_t now_ms, float &next) {
+    if (!this->active_) {
+      return false;
+    }
+    if (this->last_update_ms_ == 0) {
+      this->last_update_ms_ = now_ms;
+    }
+    float dt = static_cast<float>(now_ms - this->last_update_ms_) / 1000.0f;
+    if (dt == 0.0f && std::fabs(this->target_percent_ - applied) > 0.0f) {
+      dt = 0.01f;
+    }
+    this->last_update_ms_ = now_ms;
+
+    float desired = this->target_percent_;
+    if (this->boost_active_) {
+      if (this->config_.start_boost_hold_ms == 0 || now_ms >= this->boost_until_ms_) {
+        this->boost_active_ = false;
+      } else if (this->config_.start_boost_percent > desired) {
+        desired = this->config_.start_boost_percent;
+      }
+    }
+
+    next = speed_command_step(this->config_.hardware, applied, desired, this->config_.up_percent_per_s,
+                              this->config_.down_percent_per_s, dt);
+    return std::fabs(next - applied) > 0.001f;
+  }
+
+  // Ends the ramp once the boost is over and `applied` is at the target.
+  void settle(float applied) {
+    if (this->active_ && !this->boost_active_ && std::fabs(this->target_percent_ - applied) <= 0.05f) {
+      this->active_ = false;
+      this->last_update_ms_ = 0;
+    }
+  }
+
+ protected:
+  SpeedRampConfig config_{};
+  float target_percent_{0.0f};
+  uint32_t boost_until_ms_{0};
+  uint32_t last_update_ms_{0};
+  bool active_{false};
+  bool boost_active_{false};
+};
+
+}  // namespace mcf83xx_common
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "../component_common/bit_field.h"
+#include "../component_common/crc32.h"
+#include "register_access.h"
+
+namespace mcf83xx_common {
+
+// Persisted tuning result: the register fields a tuning run settled on, keyed
+// by a fingerprint of the configuration it ran against. The chip components
+// decide which registers are fingerprinted and which fields are recorded; this
+// layer only owns the record format and its mechanics.
+inline constexpr uint16_t TUNING_RECORD_VERSION = 1U;
+inline constexpr size_t MAX_TUNED_REGISTERS = 10U;
+
+// Tuning runs that can contribute to a record.
+enum class TuningResultKind : uint8_t {
+  STARTUP = 0,
+  MPET,
+  COUNT,
+};
+
+inline constexpr size_t TUNING_RESULT_KIND_COUNT = static_cast<size_t>(TuningResultKind::COUNT);
+
+struct TunedRegister {
+  uint16_t offset{0};
+  uint16_t reserved{0};
+  uint32_t mask{0};
+  uint32_t value{0};
+};
+
+struct TuningRecord {
+  uint16_t version{TUNING_RECORD_VERSION};
+  // Bit per TuningResultKind that contributed.
+  uint8_t kinds{0};
+  uint8_t count{0};
+  uint32_t fingerprint{0};
+  // Wall time of the latest run of each kind; a warm start saves their sum.
+  std::array<uint32_t, TUNING_RESULT_KIND_COUNT> tune_ms{};
+  std::array<TunedRegister, MAX_TUNED_REGISTERS> registers{};
+  // CRC-32 of every other field.
+  uint32_t crc{0};
+};
+
+// Configuration register a fingerprint covers; `mask` leaves out the fields a
+// tuning result itself owns so applying it does not change the fingerprint.
+struct FingerprintRegister {
+  uint16_t offset;
+  uint32_t mask;
+};
+
+// CRC-32 over the configuration a tuning result depends on: the masked
+// registers, read in the given order, seeded with `device_id` (separates chips
+// sharing register offsets) and `config_hash` (settings not visible in them).
+inline bool read_configuration_fingerprint(const RegisterAccess &access, uint32_t device_id, uint32_t config_hash,
+                                           const FingerprintRegister *registers, size_t count,
+                                           uint32_t &fingerprint) {
+  uint32_t crc = component_common::crc32_field(0xFFFFFFFFU, device_id);
+  crc = component_common::crc32_field(crc, config_hash);
+  for (size_t index = 0; index < count; ++index) {
+    uint32_t value = 0;
+    if (!access.read32(registers[index].offset, value)) {
+      return false;
+    }
+    crc = component_common::crc32_field(crc, registers[index].offset);
+    crc = component_common::crc32_field(crc, value & registers[index].mask);
+  }
+  fingerprint = ~crc;
+  return true;
+}
+
+inline uint32_t tuning_record_crc(const TuningRecord &record) {
+  uint32_t crc = 0xFFFFFFFFU;
+  crc = component_common::crc32_field(crc, record.version);
+  crc = component_common::crc32_field(crc, record.kinds);
+  crc = component_common::crc32_field(crc, record.count);
+  crc = component_common::crc32_field(crc, record.fingerprint);
+  for (uint32_t ms : record.tune_ms) {
+    crc = component_common::crc32_field(crc, ms);
+  }
+  for (const TunedRegister &reg : record.registers) {
+    crc = component_common::crc32_field(crc, reg.offset);
+    crc = component_common::crc32_field(crc, reg.reserved);
+    crc = component_common::crc32_field(crc, reg.mask);
+    crc = component_common::crc32_field(crc, reg.value);
+  }
+  return ~crc;
+}
+
+inline void seal_tuning_record(TuningRecord &record) { record.crc = tuning_record_crc(record); }
+
+inline bool tuning_record_valid(const TuningRecord &record) {
+  return record.version == TUNING_RECORD_VERSION && record.count != 0U && record.count <= MAX_TUNED_REGISTERS &&
+         record.crc == tuning_record_crc(record);
+}
+
+inline bool tuning_record_matches(const TuningRecord &record, uint32_t fingerprint) {
+  return tuning_record_valid(record) && record.fingerprint == fingerprint;
+}
+
+// Starts an empty record for `fingerprint`, or keeps `record` when it already
+// belongs to it, so results of several tuning runs on one configuration merge.
+inline void begin_tuning_record(TuningRecord &record, uint32_t fingerprint) {
+  if (tuning_record_matches(record, fingerprint)) {
+    return;
+  }
+  record = TuningRecord{};
+  record.fingerprint = fingerprint;
+}
+
+// Records the `mask` bits of `value` for `offset`, merging with fields already
+// recorded for the register. False when the record is full.
+inline bool add_tuned_field(TuningRecord &record, uint16_t offset, uint32_t mask, uint32_t value) {
+  for (size_t index = 0; index < record.count; ++index) {
+    TunedRegister &reg = record.registers[index];
+    if (reg.offset == offset) {
+      reg.mask |= mask;
+      reg.value = component_common::replace_masked(reg.value, mask, value);
+      return true;
+    }
+  }
+  if (record.count >= MAX_TUNED_REGISTERS) {
+    return false;
+  }
+  TunedRegister &reg = record.registers[record.count++];
+  reg.offset = offset;
+  reg.mask = mask;
+  reg.value = value & mask;
+  return true;
+}
+
+inline bool tuning_record_has(const TuningRecord &record, TuningResultKind kind) {
+  return (record.kinds & (1U << static_cast<uint8_t>(kind))) != 0U;
+}
+
+// Marks `kind` as contributing, replacing the time of any earlier run of it.
+inline void note_tuning_run(TuningRecord &record, TuningResultKind kind, uint32_t tune_ms) {
+  record.kinds = static_cast<uint8_t>(record.kinds | (1U << static_cast<uint8_t>(kind)));
+  record.tune_ms[static_cast<size_t>(kind)] = tune_ms;
+}
+
+inline uint32_t tuning_record_time_saved_ms(const TuningRecord &record) {
+  uint32_t total = 0;
+  for (uint32_t ms : record.tune_ms) {
+    total += ms;
+  }
+  return total;
+}
+
+// Writes every recorded field; stops at the first failed transaction.
+inline bool apply_tuning_record(const RegisterAccess &access, const TuningRecord &record) {
+  for (size_t index = 0; index < record.count; ++index) {
+    const TunedRegister &reg = record.registers[index];
+    if (!access.update_bits32(reg.offset, reg.mask, reg.value)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace mcf83xx_common
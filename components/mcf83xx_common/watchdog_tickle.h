@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstdint>
+
+namespace mcf83xx_common {
+
+// Loop-driven schedule for the I2C-mode external watchdog. Tickles are due one
+// period after the last successful one, whatever the poll interval, and every
+// tickle records how late it ran and how much of the device timeout was left.
+struct WatchdogTickleConfig {
+  uint32_t period_ms{500};
+  // Device timeout (EXT_WD_CONFIG); margin is measured against it.
+  uint32_t timeout_ms{1000};
+  // Delay before retrying a failed tickle.
+  uint32_t retry_ms{50};
+};
+
+struct WatchdogTickleStats {
+  uint32_t tickles{0};
+  uint32_t failures{0};
+  // Successful tickles that landed after the timeout had already run out.
+  uint32_t misses{0};
+  // Lateness against the period slot; a retry is measured against the slot
+  // the failed tickle missed.
+  uint32_t last_jitter_ms{0};
+  uint32_t max_jitter_ms{0};
+  uint64_t total_jitter_ms{0};
+  // Timeout left when a tickle landed; meaningful once `tickles` > 1.
+  uint32_t last_margin_ms{0};
+  uint32_t min_margin_ms{UINT32_MAX};
+};
+
+class WatchdogTickleScheduler {
+ public:
+  // The first tickle is due at `now_ms`.
+  void start(const WatchdogTickleConfig &config, uint32_t now_ms) {
+    this->config_ = config;
+    if (this->config_.period_ms == 0U) {
+      this->config_.period_ms = 1U;
+    }
+    this->scheduled_ms_ = now_ms;
+    this->due_ms_ = now_ms;
+    this->has_last_ok_ = false;
+    this->last_ok_ms_ = 0;
+    this->stats_ = WatchdogTickleStats{};
+    this->reset_window();
+    this->started_ = true;
+  }
+  void stop() { this->started_ = false; }
+  bool started() const { return this->started_; }
+
+  bool due(uint32_t now_ms) const {
+    return this->started_ && static_cast<int32_t>(now_ms - this->due_ms_) >= 0;
+  }
+  uint32_t due_ms() const { return this->due_ms_; }
+
+  // Records a tickle attempted at `now_ms` and schedules the next one.
+  void record(uint32_t now_ms, bool ok) {
+    if (!ok) {
+      this->stats_.failures++;
+      this->due_ms_ = now_ms + this->config_.retry_ms;
+      return;
+    }
+    const int32_t late = static_cast<int32_t>(now_ms - this->scheduled_ms_);
+    const uint32_t jitter = late > 0 ? static_cast<uint32_t>(late) : 0U;
+    this->stats_.tickles++;
+    this->stats_.last_jitter_ms = jitter;
+    this->stats_.total_jitter_ms += jitter;
+    if (jitter > this->stats_.max_jitter_ms) {
+      this->stats_.max_jitter_ms = jitter;
+    }
+    if (jitter > this->window_max_jitter_ms_) {
+      this->window_max_jitter_ms_ = jitter;
+    }
+    if (this->has_last_ok_) {
+      const uint32_t elapsed = now_ms - this->last_ok_ms_;
+      const uint32_t margin = elapsed < this->config_.timeout_ms ? this->config_.timeout_ms - elapsed : 0U;
+      if (elapsed >= this->config_.timeout_ms) {
+        this->stats_.misses++;
+      }
+      this->stats_.last_margin_ms = margin;
+      if (margin < this->stats_.min_margin_ms) {
+        this->stats_.min_margin_ms = margin;
+      }
+      if (margin < this->window_min_margin_ms_) {
+        this->window_min_margin_ms_ = margin;
+      }
+      this->window_margin_valid_ = true;
+    }
+    this->has_last_ok_ = true;
+    this->last_ok_ms_ = now_ms;
+    this->scheduled_ms_ = now_ms + this->config_.period_ms;
+    this->due_ms_ = this->scheduled_ms_;
+  }
+
+  const WatchdogTickleConfig &config() const { return this->config_; }
+  const WatchdogTickleStats &stats() const { return this->stats_; }
+  uint32_t mean_jitter_ms() const {
+    return this->stats_.tickles == 0U ? 0U : static_cast<uint32_t>(this->stats_.total_jitter_ms / this->stats_.tickles);
+  }
+
+  // Worst jitter and margin since the last reset_window(), for periodic
+  // publishing. The margin is unset until a tickle in the window had a
+  // successful predecessor.
+  uint32_t window_max_jitter_ms() const { return this->window_max_jitter_ms_; }
+  bool window_min_margin_ms(uint32_t &margin_ms) const {
+    margin_ms = this->window_min_margin_ms_;
+    return this->window_margin_valid_;
+  }
+  void reset_window() {
+    this->window_max_jitter_ms_ = 0;
+    this->window_min_margin_ms_ = UINT32_MAX;
+    this->window_margin_valid_ = false;
+  }
+
+ protected:
+  WatchdogTickleConfig config_{};
+  WatchdogTickleStats stats_{};
+  bool started_{false};
+  // Period slot of the next tickle; due_ms_ moves ahead of it only for retries.
+  uint32_t scheduled_ms_{0};
+  uint32_t due_ms_{0};
+  bool has_last_ok_{false};
+  uint32_t last_ok_ms_{0};
+  uint32_t window_max_jitter_ms_{0};
+  uint32_t window_min_margin_ms_{UINT32_MAX};
+  bool window_margin_valid_{false};
+};
+
+}  // namespace mcf83xx_common
@@ -0,0 +1,174 @@
+"""ESPHome-side plumbing and YAML options shared by TI MCx83xx motor-control components."""
+
+import zlib
+
+import esphome.codegen as cg
+import esphome.config_validation as cv
+from esphome.components import sensor
+from esphome.const import CONF_ID, ENTITY_CATEGORY_DIAGNOSTIC, UNIT_MILLISECOND, UNIT_SECOND
+
+AUTO_LOAD = ["component_common", "mcf83xx_common"]
+CODEOWNERS = ["@Toxicable"]
+
+CONF_AUTO_TICKLE_WATCHDOG = "auto_tickle_watchdog"
+CONF_WATCHDOG_TICKLE_INTERVAL = "watchdog_tickle_interval"
+CONF_WATCHDOG_TIMEOUT = "watchdog_timeout"
+CONF_SLOW_POLL_INTERVAL = "slow_poll_interval"
+CONF_PERSIST_TUNING_RESULTS = "persist_tuning_results"
+CONF_COMMUNICATIONS = "communications"
+CONF_RETRY_INITIAL_BACKOFF = "retry_initial_backoff"
+CONF_RETRY_MAX_BACKOFF = "retry_max_backoff"
+CONF_DEADLINE = "deadline"
+CONF_SCAN = "scan"
+CONF_FIRST_ADDRESS = "first_address"
+CONF_LAST_ADDRESS = "last_address"
+CONF_TUNING_TIME_SAVED = "tuning_time_saved"
+CONF_TIME_TO_FIRST_ACK = "time_to_first_ack"
+CONF_WATCHDOG_TICKLE_JITTER = "watchdog_tickle_jitter"
+CONF_WATCHDOG_MARGIN = "watchdog_margin"
+
+WATCHDOG_TIMEOUTS_MS = (1000, 2000, 5000, 10000)
+
+
+def validate_watchdog_timeout(value):
+    if value.total_milliseconds not in WATCHDOG_TIMEOUTS_MS:
+        raise cv.Invalid("watchdog_timeout must be one of 1s, 2s, 5s or 10s (EXT_WD_CONFIG)")
+    return value
+
+
+def validate_watchdog_tickle(config):
+    if config[CONF_WATCHDOG_TICKLE_INTERVAL] >= config[CONF_WATCHDOG_TIMEOUT]:
+        raise cv.Invalid(
+            f"{CONF_WATCHDOG_TICKLE_INTERVAL} must be shorter than {CONF_WATCHDOG_TIMEOUT}",
+            path=[CONF_WATCHDOG_TICKLE_INTERVAL],
+        )
+    return config
+
+
+def validate_scan_range(config):
+    if config[CONF_FIRST_ADDRESS] > config[CONF_LAST_ADDRESS]:
+        raise cv.Invalid(f"{CONF_FIRST_ADDRESS} must not be above {CONF_LAST_ADDRESS}")
+    return config
+
+
+def validate_retry_backoff(config):
+    if config[CONF_RETRY_INITIAL_BACKOFF] > config[CONF_RETRY_MAX_BACKOFF]:
+        raise cv.Invalid(f"{CONF_RETRY_INITIAL_BACKOFF} must not exceed {CONF_RETRY_MAX_BACKOFF}")
+    return config
+
+
+COMMUNICATIONS_SCHEMA = cv.All(
+    cv.Schema(
+        {
+            cv.Optional(
+                CONF_RETRY_INITIAL_BACKOFF, default="10ms"
+            ): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_RETRY_MAX_BACKOFF, default="1s"): cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_DEADLINE, default="5s"): cv.positive_time_period_milliseconds,
+            # Scanning is off unless this block is present.
+            cv.Optional(CONF_SCAN): cv.All(
+                cv.Schema(
+                    {
+                        cv.Optional(CONF_FIRST_ADDRESS, default=0x08): cv.int_range(min=0x00, max=0x7F),
+                        cv.Optional(CONF_LAST_ADDRESS, default=0x77): cv.int_range(min=0x00, max=0x7F),
+                    }
+                ),
+                validate_scan_range,
+            ),
+        }
+    ),
+    validate_retry_backoff,
+)
+
+# Options every MCx83xx component takes: watchdog tickling, the slow poll
+# tier, comms bring-up, tuning persistence and the diagnostics reporting on
+# them. Chip schemas extend this and add validate_watchdog_tickle.
+FAMILY_SCHEMA = cv.Schema(
+    {
+        cv.Optional(CONF_AUTO_TICKLE_WATCHDOG, default=False): cv.boolean,
+        cv.Optional(
+            CONF_WATCHDOG_TICKLE_INTERVAL, default="500ms"
+        ): cv.positive_time_period_milliseconds,
+        # Must match the device's EXT_WD_CONFIG timeout.
+        cv.Optional(CONF_WATCHDOG_TIMEOUT, default="1s"): cv.All(
+            cv.positive_time_period_milliseconds, validate_watchdog_timeout
+        ),
+        cv.Optional(
+            CONF_SLOW_POLL_INTERVAL, default="5s"
+        ): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_PERSIST_TUNING_RESULTS, default=True): cv.boolean,
+        cv.Optional(CONF_COMMUNICATIONS, default={}): COMMUNICATIONS_SCHEMA,
+        cv.Optional(CONF_TUNING_TIME_SAVED): sensor.sensor_schema(
+            unit_of_measurement=UNIT_SECOND,
+            accuracy_decimals=1,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_TIME_TO_FIRST_ACK): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            accuracy_decimals=0,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_WATCHDOG_TICKLE_JITTER): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            accuracy_decimals=0,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+        cv.Optional(CONF_WATCHDOG_MARGIN): sensor.sensor_schema(
+            unit_of_measurement=UNIT_MILLISECOND,
+            accuracy_decimals=0,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+)
+
+FAMILY_SENSOR_SETTERS = (
+    (CONF_TUNING_TIME_SAVED, "set_tuning_time_saved_sensor"),
+    (CONF_TIME_TO_FIRST_ACK, "set_time_to_first_ack_sensor"),
+    (CONF_WATCHDOG_TICKLE_JITTER, "set_watchdog_tickle_jitter_sensor"),
+    (CONF_WATCHDOG_MARGIN, "set_watchdog_margin_sensor"),
+)
+
+
+def tuning_config_hash(config, nested_keys=()):
+    # Scalar options also set the tuned fields the register fingerprint leaves
+    # out, so changing any of them invalidates a stored tuning result. Blocks
+    # named in `nested_keys` (such as a tune grid bounding what a stored result
+    # could have chosen) count entry by entry.
+    items = sorted(
+        (key, str(value))
+        for key, value in config.items()
+        if isinstance(value, (bool, int, float, str)) and key != CONF_PERSIST_TUNING_RESULTS
+    )
+    for key in nested_keys:
+        if key in config:
+            entries = sorted((entry, str(value)) for entry, value in config[key].items())
+            items.append((key, entries))
+    return zlib.crc32(repr(items).encode())
+
+
+async def register_family_config(var, config, tuning_preference_key):
+    cg.add(var.set_auto_tickle_watchdog(config[CONF_AUTO_TICKLE_WATCHDOG]))
+    cg.add(var.set_watchdog_tickle_interval_ms(config[CONF_WATCHDOG_TICKLE_INTERVAL].total_milliseconds))
+    cg.add(var.set_watchdog_timeout_ms(config[CONF_WATCHDOG_TIMEOUT].total_milliseconds))
+    cg.add(var.set_slow_poll_interval_ms(config[CONF_SLOW_POLL_INTERVAL].total_milliseconds))
+
+    comms_config = config[CONF_COMMUNICATIONS]
+    cg.add(
+        var.set_comms_backoff_ms(
+            comms_config[CONF_RETRY_INITIAL_BACKOFF].total_milliseconds,
+            comms_config[CONF_RETRY_MAX_BACKOFF].total_milliseconds,
+        )
+    )
+    cg.add(var.set_comms_deadline_ms(comms_config[CONF_DEADLINE].total_milliseconds))
+    if CONF_SCAN in comms_config:
+        scan_config = comms_config[CONF_SCAN]
+        cg.add(var.set_comms_scan_range(scan_config[CONF_FIRST_ADDRESS], scan_config[CONF_LAST_ADDRESS]))
+
+    # Keyed per instance so two controllers on one node keep separate records.
+    cg.add(var.set_persist_tuning_results(config[CONF_PERSIST_TUNING_RESULTS]))
+    cg.add(var.set_tuning_preference_key(tuning_preference_key ^ zlib.crc32(config[CONF_ID].id.encode())))
+
+    for conf_key, setter_name in FAMILY_SENSOR_SETTERS:
+        if conf_key in config:
+            sens = await sensor.new_sensor(config[conf_key])
+            cg.add(getattr(var, setter_name)(sens))
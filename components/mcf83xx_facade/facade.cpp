@@ -0,0 +1,376 @@
+#include "facade.h"
+
+#include <cstdio>
+#include <string>
+
+#include "../mcf83xx_common/protocol.h"
+
+namespace esphome {
+namespace mcf83xx_facade {
+
+const char *i2c_error_to_string(i2c::ErrorCode error_code) {
+  switch (error_code) {
+    case i2c::ERROR_OK:
+      return "ok";
+    case i2c::ERROR_INVALID_ARGUMENT:
+      return "invalid_argument";
+    case i2c::ERROR_NOT_ACKNOWLEDGED:
+      return "not_acknowledged";
+    case i2c::ERROR_TIMEOUT:
+      return "timeout";
+    case i2c::ERROR_NOT_INITIALIZED:
+      return "not_initialized";
+    case i2c::ERROR_TOO_LARGE:
+      return "too_large";
+    case i2c::ERROR_UNKNOWN:
+      return "unknown";
+    case i2c::ERROR_CRC:
+      return "crc";
+    default:
+      return "other";
+  }
+}
+
+bool read_register32(i2c::I2CBus *bus, uint8_t address, const char *tag, uint16_t offset, uint32_t *value) {
+  if (value == nullptr || bus == nullptr) {
+    return false;
+  }
+  const auto command = ::mcf83xx_common::make_control_frame(true, offset, ::mcf83xx_common::RegisterWidth::BITS_32);
+  uint8_t rx[4] = {0, 0, 0, 0};
+  const i2c::ErrorCode err = bus->write_readv(address, command.data(), command.size(), rx, sizeof(rx));
+  if (err != i2c::ERROR_OK) {
+    ESP_LOGW(tag, "read_reg32(0x%04X) failed: i2c error %d", offset, static_cast<int>(err));
+    return false;
+  }
+  *value = ::mcf83xx_common::decode_read32(rx);
+  return true;
+}
+
+bool read_register16(i2c::I2CBus *bus, uint8_t address, const char *tag, uint16_t offset, uint16_t *value) {
+  if (value == nullptr || bus == nullptr) {
+    return false;
+  }
+  const auto command = ::mcf83xx_common::make_control_frame(true, offset, ::mcf83xx_common::RegisterWidth::BITS_16);
+  uint8_t rx[2] = {0, 0};
+  const i2c::ErrorCode err = bus->write_readv(address, command.data(), command.size(), rx, sizeof(rx));
+  if (err != i2c::ERROR_OK) {
+    ESP_LOGW(tag, "read_reg16(0x%04X) failed: i2c error %d", offset, static_cast<int>(err));
+    return false;
+  }
+  *value = ::mcf83xx_common::decode_read16(rx);
+  return true;
+}
+
+bool write_register32(i2c::I2CBus *bus, uint8_t address, const char *tag, uint16_t offset, uint32_t value) {
+  if (bus == nullptr) {
+    return false;
+  }
+  const auto frame = ::mcf83xx_common::make_write32_frame(offset, value);
+  const i2c::ErrorCode err = bus->write_readv(address, frame.data(), frame.size(), nullptr, 0);
+  if (err != i2c::ERROR_OK) {
+    ESP_LOGW(tag, "write_reg32(0x%04X, 0x%08X) failed: i2c error %d", offset, value, static_cast<int>(err));
+    return false;
+  }
+  return true;
+}
+
+void CommsLink::start(uint8_t address, uint32_t now_ms) {
+  this->address_ = address;
+  this->first_ack_published_ = false;
+  this->bringup_.start(this->config_, address, now_ms);
+}
+
+bool CommsLink::ack(i2c::I2CBus *bus, uint8_t address) {
+  if (bus == nullptr) {
+    this->last_ack_error_ = i2c::ERROR_NOT_INITIALIZED;
+    return false;
+  }
+  this->last_ack_error_ = bus->write_readv(address, nullptr, 0, nullptr, 0);
+  return this->last_ack_error_ == i2c::ERROR_OK;
+}
+
+bool CommsLink::step(::mcf83xx_common::CommsProbe &probe, Component &component, const char *tag, uint32_t now_ms) {
+  using ::mcf83xx_common::CommsEvent;
+  const ::mcf83xx_common::CommsStep step = this->bringup_.step(probe, now_ms);
+
+  uint32_t first_ack_ms = 0;
+  if (!this->first_ack_published_ && this->bringup_.first_ack_ms(first_ack_ms)) {
+    this->first_ack_published_ = true;
+    if (this->time_to_first_ack_sensor_ != nullptr) {
+      this->time_to_first_ack_sensor_->publish_state(static_cast<float>(first_ack_ms));
+    }
+  }
+
+  switch (step.event) {
+    case CommsEvent::SCAN_DONE:
+      this->log_scan_results_(tag);
+      return false;
+    case CommsEvent::ATTEMPT_FAILED:
+    case CommsEvent::DEADLINE_EXPIRED:
+      if (step.acked) {
+        ESP_LOGW(
+          tag,
+          "Comms attempt %u: address 0x%02X ACKed but register probe failed",
+          static_cast<unsigned>(this->bringup_.attempts()),
+          this->address_
+        );
+      } else {
+        ESP_LOGW(
+          tag,
+          "Comms attempt %u: address 0x%02X probe failed: %s (%d)",
+          static_cast<unsigned>(this->bringup_.attempts()),
+          this->address_,
+          i2c_error_to_string(this->last_ack_error_),
+          static_cast<int>(this->last_ack_error_)
+        );
+      }
+      if (step.event == CommsEvent::DEADLINE_EXPIRED) {
+        ESP_LOGW(
+          tag,
+          "Unable to establish communications with I2C device 0x%02X within %ums; deferring normal "
+          "operation and retrying every %ums",
+          this->address_,
+          static_cast<unsigned>(this->bringup_.config().deadline_ms),
+          static_cast<unsigned>(this->bringup_.retry_delay_ms())
+        );
+        component.status_set_warning();
+      }
+      return false;
+    case CommsEvent::ESTABLISHED:
+      ESP_LOGI(
+        tag,
+        "I2C communications established with 0x%02X (attempt %u, %ums after setup)",
+        this->address_,
+        static_cast<unsigned>(this->bringup_.attempts()),
+        static_cast<unsigned>(this->bringup_.established_ms())
+      );
+      component.status_clear_warning();
+      return true;
+    default:
+      return false;
+  }
+}
+
+void CommsLink::dump_config(const char *tag) const {
+  ESP_LOGCONFIG(
+    tag,
+    "  Comms bring-up: backoff=%u..%ums deadline=%ums",
+    static_cast<unsigned>(this->config_.initial_backoff_ms),
+    static_cast<unsigned>(this->config_.max_backoff_ms),
+    static_cast<unsigned>(this->config_.deadline_ms)
+  );
+  if (this->config_.scan) {
+    ESP_LOGCONFIG(
+      tag,
+      "  Comms scan: 0x%02X..0x%02X",
+      static_cast<unsigned>(this->config_.scan_first_address),
+      static_cast<unsigned>(this->config_.scan_last_address)
+    );
+  }
+  if (this->bringup_.established()) {
+    uint32_t first_ack_ms = 0;
+    this->bringup_.first_ack_ms(first_ack_ms);
+    ESP_LOGCONFIG(
+      tag,
+      "  Comms established after %u attempt(s): first_ack=%ums established=%ums",
+      static_cast<unsigned>(this->bringup_.attempts()),
+      static_cast<unsigned>(first_ack_ms),
+      static_cast<unsigned>(this->bringup_.established_ms())
+    );
+  }
+}
+
+void CommsLink::log_scan_results_(const char *tag) const {
+  const ::mcf83xx_common::CommsBringupConfig &config = this->bringup_.config();
+  if (this->bringup_.scan_found_count() == 0u) {
+    ESP_LOGW(
+      tag,
+      "I2C scan found no ACKing devices in range 0x%02X..0x%02X",
+      static_cast<unsigned>(config.scan_first_address),
+      static_cast<unsigned>(config.scan_last_address)
+    );
+  } else {
+    std::string discovered;
+    for (uint16_t address = config.scan_first_address; address <= config.scan_last_address; address++) {
+      if (!this->bringup_.scan_found(static_cast<uint8_t>(address))) {
+        continue;
+      }
+      char addr_text[8];
+      std::snprintf(addr_text, sizeof(addr_text), "0x%02X", static_cast<unsigned>(address));
+      if (!discovered.empty()) {
+        discovered += ", ";
+      }
+      discovered += addr_text;
+    }
+    ESP_LOGI(
+      tag,
+      "I2C scan found %u device(s): %s",
+      static_cast<unsigned>(this->bringup_.scan_found_count()),
+      discovered.c_str()
+    );
+  }
+
+  if (this->address_ < config.scan_first_address || this->address_ > config.scan_last_address) {
+    return;
+  }
+  if (this->bringup_.scan_found(this->address_)) {
+    ESP_LOGI(tag, "I2C target 0x%02X was found during scan", this->address_);
+  } else {
+    ESP_LOGW(tag, "I2C target 0x%02X was not found during scan", this->address_);
+  }
+}
+
+void WatchdogTickler::publish_stats() {
+  if (!this->scheduler_.started()) {
+    return;
+  }
+  if (this->jitter_sensor_ != nullptr) {
+    this->jitter_sensor_->publish_state(static_cast<float>(this->scheduler_.window_max_jitter_ms()));
+  }
+  uint32_t margin_ms = 0;
+  if (this->margin_sensor_ != nullptr && this->scheduler_.window_min_margin_ms(margin_ms)) {
+    this->margin_sensor_->publish_state(static_cast<float>(margin_ms));
+  }
+  this->scheduler_.reset_window();
+}
+
+void WatchdogTickler::dump_config(const char *tag) const {
+  ESP_LOGCONFIG(tag, "  Auto tickle watchdog: %s", YESNO(this->enabled_));
+  if (this->enabled_) {
+    ESP_LOGCONFIG(
+      tag,
+      "  Watchdog tickle: every %ums, timeout %ums",
+      static_cast<unsigned>(this->config_.period_ms),
+      static_cast<unsigned>(this->config_.timeout_ms)
+    );
+  }
+}
+
+void WatchdogTickler::log_tickle_(const char *tag, bool ok) const {
+  const ::mcf83xx_common::WatchdogTickleStats &stats = this->scheduler_.stats();
+  if (!ok) {
+    ESP_LOGW(tag, "Watchdog tickle failed; retrying in %ums", static_cast<unsigned>(this->config_.retry_ms));
+  } else if (stats.tickles > 1U && stats.last_margin_ms == 0U) {
+    ESP_LOGW(
+      tag,
+      "Watchdog tickle landed %ums late, past the %ums timeout",
+      static_cast<unsigned>(stats.last_jitter_ms),
+      static_cast<unsigned>(this->config_.timeout_ms)
+    );
+  }
+}
+
+void TuningStore::load() {
+  if (!this->persist_ || global_preferences == nullptr) {
+    return;
+  }
+  this->preference_ = global_preferences->make_preference<::mcf83xx_common::TuningRecord>(this->preference_key_);
+  this->preference_valid_ = true;
+  if (!this->preference_.load(&this->record_)) {
+    this->record_ = ::mcf83xx_common::TuningRecord{};
+  }
+}
+
+bool TuningStore::should_warm_start_(const char *tag) const {
+  if (!this->preference_valid_) {
+    return false;
+  }
+  if (!this->fingerprint_valid_) {
+    ESP_LOGW(tag, "Failed to read configuration fingerprint; skipping tuning warm start");
+    return false;
+  }
+  if (!::mcf83xx_common::tuning_record_matches(this->record_, this->fingerprint_)) {
+    if (::mcf83xx_common::tuning_record_valid(this->record_)) {
+      ESP_LOGI(
+        tag,
+        "Stored tuning result is for another configuration (0x%08X, now 0x%08X); not applied",
+        static_cast<unsigned>(this->record_.fingerprint),
+        static_cast<unsigned>(this->fingerprint_)
+      );
+    }
+    return false;
+  }
+  return true;
+}
+
+void TuningStore::log_warm_start_(const char *tag) const {
+  const uint32_t saved_ms = ::mcf83xx_common::tuning_record_time_saved_ms(this->record_);
+  ESP_LOGI(
+    tag,
+    "Warm start: applied stored tuning result (fingerprint 0x%08X, startup=%s mpet=%s), saved %ums of tuning",
+    static_cast<unsigned>(this->fingerprint_),
+    YESNO(::mcf83xx_common::tuning_record_has(this->record_, ::mcf83xx_common::TuningResultKind::STARTUP)),
+    YESNO(::mcf83xx_common::tuning_record_has(this->record_, ::mcf83xx_common::TuningResultKind::MPET)),
+    static_cast<unsigned>(saved_ms)
+  );
+  if (this->time_saved_sensor_ != nullptr) {
+    this->time_saved_sensor_->publish_state(static_cast<float>(saved_ms) / 1000.0f);
+  }
+}
+
+bool TuningStore::begin_update(::mcf83xx_common::TuningRecord &record) const {
+  if (!this->preference_valid_ || !this->fingerprint_valid_) {
+    return false;
+  }
+  record = this->record_;
+  ::mcf83xx_common::begin_tuning_record(record, this->fingerprint_);
+  return true;
+}
+
+void TuningStore::store(
+  ::mcf83xx_common::TuningRecord &record, ::mcf83xx_common::TuningResultKind kind, uint32_t tune_ms, const char *tag
+) {
+  ::mcf83xx_common::note_tuning_run(record, kind, tune_ms);
+  ::mcf83xx_common::seal_tuning_record(record);
+  this->record_ = record;
+  // Tuning results are committed rarely, so flush right away rather than
+  // losing them to the next brownout.
+  if (!this->preference_.save(&this->record_) || !global_preferences->sync()) {
+    ESP_LOGW(tag, "Failed to persist tuning result");
+    return;
+  }
+  ESP_LOGI(
+    tag,
+    "Stored tuning result for configuration 0x%08X (%u register(s))",
+    static_cast<unsigned>(record.fingerprint),
+    static_cast<unsigned>(record.count)
+  );
+}
+
+void publish_fault_summary(
+  FaultSummaryText &summary, ::component_common::PublishGuard &guard, text_sensor::TextSensor *sensor, const char *tag
+) {
+  if (summary.empty()) {
+    summary.append("none");
+  }
+  const bool first_summary = !guard.has_value();
+  if (!guard.changed(summary.view())) {
+    return;
+  }
+  if (sensor != nullptr) {
+    sensor->publish_state(summary.c_str());
+  }
+  if (summary == "none") {
+    if (!first_summary) {
+      ESP_LOGI(tag, "Faults cleared");
+    }
+  } else {
+    ESP_LOGW(tag, "Active faults: %s", summary.c_str());
+  }
+}
+
+bool latch_fault_shutdown(bool fault_active, bool &latched, const char *tag) {
+  if (!fault_active) {
+    latched = false;
+    return false;
+  }
+  if (latched) {
+    return false;
+  }
+  latched = true;
+  ESP_LOGW(tag, "Fault detected, forcing speed command to 0%%");
+  return true;
+}
+
+}  // namespace mcf83xx_facade
+}  // namespace esphome
@@ -0,0 +1,229 @@
+#pragma once
+
+// ESPHome-side plumbing shared by the MCF8316D and MCF8329A components. It
+// logs and uses ESPHome types, so only the chip facades (mcf8316d.cpp,
+// mcf8329a.cpp) include it; host-pure cores and tests must not.
+
+#include <cstddef>
+#include <cstdint>
+
+#include "esphome/components/i2c/i2c.h"
+#include "esphome/components/sensor/sensor.h"
+#include "esphome/components/text_sensor/text_sensor.h"
+#include "esphome/core/component.h"
+#include "esphome/core/hal.h"
+#include "esphome/core/log.h"
+#include "esphome/core/preferences.h"
+
+#include "../component_common/fixed_string.h"
+#include "../mcf83xx_common/comms_bringup.h"
+#include "../mcf83xx_common/tuning_record.h"
+#include "../mcf83xx_common/watchdog_tickle.h"
+
+namespace esphome {
+namespace mcf83xx_facade {
+
+const char *i2c_error_to_string(i2c::ErrorCode error_code);
+
+// RegisterBus transport: one control-word transaction to `address`, logged
+// under `tag` on failure.
+bool read_register32(i2c::I2CBus *bus, uint8_t address, const char *tag, uint16_t offset, uint32_t *value);
+bool read_register16(i2c::I2CBus *bus, uint8_t address, const char *tag, uint16_t offset, uint16_t *value);
+bool write_register32(i2c::I2CBus *bus, uint8_t address, const char *tag, uint16_t offset, uint32_t value);
+
+// Owns the comms bring-up state and its logging; the chip stays the
+// CommsProbe and decides what entering normal operation means.
+class CommsLink {
+ public:
+  void set_backoff_ms(uint32_t initial_ms, uint32_t max_ms) {
+    this->config_.initial_backoff_ms = initial_ms;
+    this->config_.max_backoff_ms = max_ms;
+  }
+  void set_deadline_ms(uint32_t deadline_ms) { this->config_.deadline_ms = deadline_ms; }
+  void set_scan_range(uint8_t first_address, uint8_t last_address) {
+    this->config_.scan = true;
+    this->config_.scan_first_address = first_address;
+    this->config_.scan_last_address = last_address;
+  }
+  void set_time_to_first_ack_sensor(sensor::Sensor *s) { this->time_to_first_ack_sensor_ = s; }
+
+  void start(uint8_t address, uint32_t now_ms);
+  // CommsProbe::ack_address for a chip on `bus`.
+  bool ack(i2c::I2CBus *bus, uint8_t address);
+  // Runs one bring-up step and logs it, raising `component`'s warning status
+  // past the deadline; true on the step that establishes the link.
+  bool step(::mcf83xx_common::CommsProbe &probe, Component &component, const char *tag, uint32_t now_ms);
+  void dump_config(const char *tag) const;
+
+ protected:
+  void log_scan_results_(const char *tag) const;
+
+  ::mcf83xx_common::CommsBringupConfig config_{};
+  ::mcf83xx_common::CommsBringup bringup_;
+  uint8_t address_{0};
+  i2c::ErrorCode last_ack_error_{i2c::ERROR_OK};
+  bool first_ack_published_{false};
+  sensor::Sensor *time_to_first_ack_sensor_{nullptr};
+};
+
+// Owns the watchdog tickle schedule, the cached ALGO_CTRL1 tickle base and
+// the jitter/margin sensors. `Service` is the chip service providing
+// read_watchdog_tickle_base() and tickle_watchdog().
+class WatchdogTickler {
+ public:
+  void set_enabled(bool enabled) { this->enabled_ = enabled; }
+  void set_interval_ms(uint32_t interval_ms) { this->config_.period_ms = interval_ms; }
+  void set_timeout_ms(uint32_t timeout_ms) { this->config_.timeout_ms = timeout_ms; }
+  void set_jitter_sensor(sensor::Sensor *s) { this->jitter_sensor_ = s; }
+  void set_margin_sensor(sensor::Sensor *s) { this->margin_sensor_ = s; }
+
+  bool enabled() const { return this->enabled_; }
+
+  // Called once the link is (re)established; the tickle base is re-read.
+  void start(uint32_t now_ms) {
+    this->base_valid_ = false;
+    if (this->enabled_) {
+      this->scheduler_.start(this->config_, now_ms);
+    }
+  }
+
+  template<typename Service> bool tickle(Service &service) {
+    if (!this->base_valid_) {
+      if (!service.read_watchdog_tickle_base(this->base_)) {
+        return false;
+      }
+      this->base_valid_ = true;
+    }
+    return service.tickle_watchdog(this->base_);
+  }
+
+  // Manual tickle from the button; counts towards the schedule when it runs.
+  template<typename Service> void pulse(Service &service, const char *tag, uint32_t now_ms) {
+    ESP_LOGD(tag, "Pulsing watchdog tickle");
+    const bool ok = this->tickle(service);
+    if (!ok) {
+      ESP_LOGW(tag, "Failed to pulse watchdog tickle");
+    }
+    if (this->scheduler_.started()) {
+      this->scheduler_.record(now_ms, ok);
+    }
+  }
+
+  // Tickles when the schedule is due; called from loop() and ahead of the
+  // poll so a long update() cannot delay it.
+  template<typename Service> void service(Service &service, const char *tag, uint32_t now_ms) {
+    if (!this->enabled_ || !this->scheduler_.due(now_ms)) {
+      return;
+    }
+    const bool ok = this->tickle(service);
+    this->scheduler_.record(now_ms, ok);
+    this->log_tickle_(tag, ok);
+  }
+
+  void publish_stats();
+  void dump_config(const char *tag) const;
+
+ protected:
+  void log_tickle_(const char *tag, bool ok) const;
+
+  bool enabled_{false};
+  ::mcf83xx_common::WatchdogTickleConfig config_{};
+  ::mcf83xx_common::WatchdogTickleScheduler scheduler_;
+  // ALGO_CTRL1 image a tickle rewrites; read once per established link.
+  uint32_t base_{0};
+  bool base_valid_{false};
+  sensor::Sensor *jitter_sensor_{nullptr};
+  sensor::Sensor *margin_sensor_{nullptr};
+};
+
+// Owns the persisted TuningRecord and the fingerprint of the configuration it
+// is keyed by. `Service` provides read_configuration_fingerprint() and
+// apply_tuning_record().
+class TuningStore {
+ public:
+  explicit TuningStore(uint32_t preference_key) : preference_key_(preference_key) {}
+
+  void set_persist(bool persist) { this->persist_ = persist; }
+  void set_preference_key(uint32_t key) { this->preference_key_ = key; }
+  void set_config_hash(uint32_t config_hash) { this->config_hash_ = config_hash; }
+  void set_time_saved_sensor(sensor::Sensor *s) { this->time_saved_sensor_ = s; }
+
+  void load();
+
+  // Fingerprints the configuration just applied, before any stored result
+  // changes the tuned fields it leaves out anyway, then applies the stored
+  // record when it matches.
+  template<typename Service> void warm_start(Service &service, const char *tag) {
+    this->fingerprint_valid_ = service.read_configuration_fingerprint(this->config_hash_, this->fingerprint_);
+    if (!this->should_warm_start_(tag)) {
+      return;
+    }
+    if (!service.apply_tuning_record(this->record_)) {
+      ESP_LOGW(tag, "Failed to apply stored tuning result");
+      return;
+    }
+    this->log_warm_start_(tag);
+  }
+
+  // Seeds `record` for a tuning run on the current configuration; false when
+  // results are not persisted.
+  bool begin_update(::mcf83xx_common::TuningRecord &record) const;
+  void store(
+    ::mcf83xx_common::TuningRecord &record, ::mcf83xx_common::TuningResultKind kind, uint32_t tune_ms, const char *tag
+  );
+
+ protected:
+  bool should_warm_start_(const char *tag) const;
+  void log_warm_start_(const char *tag) const;
+
+  bool persist_{true};
+  uint32_t preference_key_;
+  uint32_t config_hash_{0u};
+  ESPPreferenceObject preference_{};
+  bool preference_valid_{false};
+  // Last record loaded or stored; the base later tuning runs merge into.
+  ::mcf83xx_common::TuningRecord record_{};
+  uint32_t fingerprint_{0u};
+  bool fingerprint_valid_{false};
+  sensor::Sensor *time_saved_sensor_{nullptr};
+};
+
+// Home Assistant keeps at most 255 characters of a state.
+using FaultSummaryText = ::component_common::FixedString<255>;
+
+struct FaultName {
+  uint32_t mask;
+  const char *name;
+};
+
+// Appends the name of every bit set in `status`; when none is known but
+// `active_mask` still flags a fault, appends `fallback` instead.
+template<size_t N>
+void append_fault_names(
+  FaultSummaryText &summary, uint32_t status, const FaultName (&names)[N], uint32_t active_mask, const char *fallback
+) {
+  bool found = false;
+  for (const FaultName &name : names) {
+    if ((status & name.mask) != 0u) {
+      summary.append_item(name.name, ", ");
+      found = true;
+    }
+  }
+  if (!found && (status & active_mask) != 0u) {
+    summary.append_item(fallback, ", ");
+  }
+}
+
+// Publishes `summary` ("none" when empty) on change and logs the transition.
+// The first summary is published but, matching the "none" baseline, only
+// logged when something is active.
+void publish_fault_summary(
+  FaultSummaryText &summary, ::component_common::PublishGuard &guard, text_sensor::TextSensor *sensor, const char *tag
+);
+
+// Latches one speed shutdown per fault episode; true when the caller must
+// force the speed command to 0% now.
+bool latch_fault_shutdown(bool fault_active, bool &latched, const char *tag);
+
+}  // namespace mcf83xx_facade
+}  // namespace esphome
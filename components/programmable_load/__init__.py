@@ -1,9 +1,12 @@
 AUTO_LOAD = ["button", "component_common", "number", "sensor", "text_sensor"]
+# Each block is one independent load channel with its own owner lock, faults,
+# procedures and optional charger.
+MULTI_CONF = True
 
 from ._types import (  # noqa: F401
     ChargerInterface,
     ProgrammableLoadComponent,
 )
-from ._schema import CONFIG_SCHEMA
+from ._schema import CONFIG_SCHEMA, FINAL_VALIDATE_SCHEMA
 from ._codegen import to_code
 from . import _actions  # noqa: F401
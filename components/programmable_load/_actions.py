@@ -3,7 +3,12 @@ import esphome.codegen as cg
 import esphome.config_validation as cv
 from esphome.const import CONF_ID
 
-from ._schema import _normalized_level, _positive, _positive_scale
+from ._schema import (
+    _calibration_profile,
+    _normalized_level,
+    _positive,
+    _positive_scale,
+)
 from ._types import *
 
 APPLY_CALIBRATION_SCHEMA = cv.Schema(
@@ -16,6 +21,7 @@ APPLY_CALIBRATION_SCHEMA = cv.Schema(
         cv.Required(CONF_OUTPUT_ZERO_LEVEL): cv.templatable(_normalized_level),
         cv.Required(CONF_OUTPUT_FULL_SCALE_CURRENT): cv.templatable(_positive),
         cv.Optional(CONF_PERSIST, default=True): cv.templatable(cv.boolean),
+        cv.Optional(CONF_PROFILE): cv.templatable(_calibration_profile),
     }
 )
 
@@ -57,6 +63,11 @@ async def apply_calibration_to_code(config, action_id, template_arg, args):
     cg.add(action.set_output_zero_level(output_zero_level))
     cg.add(action.set_output_full_scale_current(output_full_scale_current))
     cg.add(action.set_persist(persist))
+    if CONF_PROFILE in config:
+        profile = await cg.templatable(
+            config[CONF_PROFILE], args, cg.std_string
+        )
+        cg.add(action.set_profile(profile))
     return action
 
 
@@ -80,3 +91,27 @@ async def reset_calibration_to_code(config, action_id, template_arg, args):
     persist = await cg.templatable(config[CONF_PERSIST], args, cg.bool_)
     cg.add(action.set_persist(persist))
     return action
+
+
+SELECT_CALIBRATION_PROFILE_SCHEMA = cv.Schema(
+    {
+        cv.Required(CONF_ID): cv.use_id(ProgrammableLoadComponent),
+        cv.Required(CONF_PROFILE): cv.templatable(_calibration_profile),
+    }
+)
+
+
+@automation.register_action(
+    "programmable_load.select_calibration_profile",
+    SelectCalibrationProfileAction,
+    SELECT_CALIBRATION_PROFILE_SCHEMA,
+    synchronous=True,
+)
+async def select_calibration_profile_to_code(
+    config, action_id, template_arg, args
+):
+    parent = await cg.get_variable(config[CONF_ID])
+    action = cg.new_Pvariable(action_id, template_arg, parent)
+    profile = await cg.templatable(config[CONF_PROFILE], args, cg.std_string)
+    cg.add(action.set_profile(profile))
+    return action
@@ -1,9 +1,23 @@
+import zlib
+
 import esphome.codegen as cg
 from esphome.components import button, number, sensor, text_sensor
 from esphome.const import CONF_ID
+from esphome.core import CORE
 
 from ._types import *
 
+CALIBRATION_PREFERENCE_KEY = 0x504C4341
+
+
+def _calibration_preference_key(config):
+    # The first channel keeps the original key so calibration persisted by a
+    # single-channel build is still restored after adding a second channel.
+    channels = CORE.config.get(DOMAIN, [])
+    if not channels or channels[0][CONF_ID].id == config[CONF_ID].id:
+        return CALIBRATION_PREFERENCE_KEY
+    return CALIBRATION_PREFERENCE_KEY ^ zlib.crc32(config[CONF_ID].id.encode())
+
 
 async def to_code(config):
     var = cg.new_Pvariable(config[CONF_ID])
@@ -60,12 +74,28 @@ async def to_code(config):
         )
     )
     cg.add(var.set_restore_calibration(calibration[CONF_RESTORE]))
+    cg.add(var.set_calibration_profile(calibration[CONF_PROFILE]))
+    cg.add(
+        var.set_calibration_max_writes_per_hour(
+            calibration[CONF_MAX_WRITES_PER_HOUR]
+        )
+    )
+    cg.add(
+        var.set_calibration_preference_key(
+            _calibration_preference_key(config)
+        )
+    )
 
     if CONF_CALIBRATION_STATUS in calibration:
         value = await text_sensor.new_text_sensor(
             calibration[CONF_CALIBRATION_STATUS]
         )
         cg.add(var.set_calibration_status_sensor(value))
+    if CONF_ACTIVE_PROFILE in calibration:
+        value = await text_sensor.new_text_sensor(
+            calibration[CONF_ACTIVE_PROFILE]
+        )
+        cg.add(var.set_calibration_profile_sensor(value))
     if CONF_CURRENT_SCALE in calibration:
         value = await sensor.new_sensor(calibration[CONF_CURRENT_SCALE])
         cg.add(var.set_current_scale_sensor(value))
@@ -105,6 +135,12 @@ async def to_code(config):
     cg.add(var.set_proportional_gain(control[CONF_PROPORTIONAL_GAIN]))
     cg.add(var.set_integral_gain(control[CONF_INTEGRAL_GAIN]))
     cg.add(var.set_log_control_samples(control[CONF_LOG_CONTROL_SAMPLES]))
+    cg.add(var.set_log_control_summary(control[CONF_LOG_CONTROL_SUMMARY]))
+    cg.add(
+        var.set_control_sample_log_limit(
+            control[CONF_CONTROL_SAMPLE_LOG_LIMIT]
+        )
+    )
 
     cooling = config[CONF_COOLING]
     fan = await cg.get_variable(cooling[CONF_FAN_OUTPUT])
@@ -115,6 +151,44 @@ async def to_code(config):
             cooling[CONF_FAN_FULL_TEMPERATURE],
         )
     )
+    # Without an explicit target, regulate to the middle of the fan range.
+    target = cooling.get(
+        CONF_TARGET_TEMPERATURE,
+        (
+            cooling[CONF_FAN_START_TEMPERATURE]
+            + cooling[CONF_FAN_FULL_TEMPERATURE]
+        )
+        / 2.0,
+    )
+    cg.add(var.set_fan_target_temperature(target))
+    cg.add(var.set_fan_hysteresis(cooling[CONF_HYSTERESIS]))
+    cg.add(
+        var.set_fan_gains(
+            cooling[CONF_PROPORTIONAL_GAIN], cooling[CONF_INTEGRAL_GAIN]
+        )
+    )
+    cg.add(var.set_fan_minimum_duty(cooling[CONF_MINIMUM_DUTY]))
+    cg.add(
+        var.set_fan_kick_start(
+            cooling[CONF_KICK_START_DUTY],
+            cooling[CONF_KICK_START_TIME].total_milliseconds,
+        )
+    )
+    cg.add(var.set_fan_write_threshold(cooling[CONF_WRITE_THRESHOLD]))
+
+    if CONF_THERMAL_DERATING in config:
+        derating = config[CONF_THERMAL_DERATING]
+        cg.add(
+            var.set_thermal_derating(
+                derating[CONF_THERMAL_RESISTANCE],
+                derating[CONF_TIME_CONSTANT].total_milliseconds / 1000.0,
+                derating[CONF_HORIZON].total_milliseconds / 1000.0,
+                derating[CONF_MARGIN],
+            )
+        )
+        if CONF_DERATING in derating:
+            value = await sensor.new_sensor(derating[CONF_DERATING])
+            cg.add(var.set_thermal_derating_sensor(value))
 
     fault_policy = config[CONF_FAULT_POLICY]
     cg.add(var.set_fault_auto_clear(fault_policy[CONF_AUTO_CLEAR]))
@@ -1,4 +1,5 @@
 import esphome.config_validation as cv
+import esphome.final_validate as fv
 from esphome.components import button, number, output, sensor, text_sensor
 from esphome.const import (
     CONF_ID,
@@ -45,6 +46,17 @@ def _non_negative(value):
     return value
 
 
+def _calibration_profile(value):
+    # Profile names are stored in a 16-byte record field.
+    value = cv.string_strict(value)
+    if not 1 <= len(value) <= 15 or not value.isprintable() or not value.isascii():
+        raise cv.Invalid(
+            "calibration profile names must be 1 to 15 printable ASCII "
+            "characters"
+        )
+    return value
+
+
 def _normalized_level(value):
     value = cv.float_(value)
     if value < 0 or value >= 1:
@@ -95,12 +107,18 @@ OUTPUT_CALIBRATION_SCHEMA = cv.Schema(
 CALIBRATION_SCHEMA = cv.Schema(
     {
         cv.Optional(CONF_RESTORE, default=True): cv.boolean,
+        cv.Optional(CONF_PROFILE, default="default"): _calibration_profile,
+        cv.Optional(CONF_MAX_WRITES_PER_HOUR, default=6):
+            cv.int_range(min=1, max=60),
         cv.Optional(CONF_CURRENT, default={}): LINEAR_CALIBRATION_SCHEMA,
         cv.Optional(CONF_VOLTAGE, default={}): LINEAR_CALIBRATION_SCHEMA,
         cv.Required(CONF_OUTPUT): OUTPUT_CALIBRATION_SCHEMA,
         cv.Optional(CONF_CALIBRATION_STATUS): text_sensor.text_sensor_schema(
             entity_category=ENTITY_CATEGORY_DIAGNOSTIC
         ),
+        cv.Optional(CONF_ACTIVE_PROFILE): text_sensor.text_sensor_schema(
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC
+        ),
         cv.Optional(CONF_CURRENT_SCALE): sensor.sensor_schema(
             accuracy_decimals=6,
             entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
@@ -167,19 +185,29 @@ CONTROL_SCHEMA = cv.Schema(
         cv.Optional(CONF_PROPORTIONAL_GAIN, default=0.2): _positive,
         cv.Optional(CONF_INTEGRAL_GAIN, default=0.4): _non_negative,
         cv.Optional(CONF_LOG_CONTROL_SAMPLES, default=False): cv.boolean,
+        cv.Optional(CONF_LOG_CONTROL_SUMMARY, default=False): cv.boolean,
+        cv.Optional(CONF_CONTROL_SAMPLE_LOG_LIMIT, default=10):
+            cv.int_range(min=1, max=32),
     }
 )
 
 
 def _validate_cooling(config):
-    if (
-        config[CONF_FAN_FULL_TEMPERATURE]
-        <= config[CONF_FAN_START_TEMPERATURE]
-    ):
+    start = config[CONF_FAN_START_TEMPERATURE]
+    full = config[CONF_FAN_FULL_TEMPERATURE]
+    if full <= start:
         raise cv.Invalid(
             "fan_full_temperature must be greater than "
             "fan_start_temperature"
         )
+    target = config.get(CONF_TARGET_TEMPERATURE)
+    if target is not None and not start <= target < full:
+        raise cv.Invalid(
+            "target_temperature must be at least fan_start_temperature "
+            "and below fan_full_temperature"
+        )
+    if config[CONF_KICK_START_DUTY] < config[CONF_MINIMUM_DUTY]:
+        raise cv.Invalid("kick_start_duty must not be below minimum_duty")
     return config
 
 
@@ -189,11 +217,37 @@ COOLING_SCHEMA = cv.All(
             cv.Required(CONF_FAN_OUTPUT): cv.use_id(output.FloatOutput),
             cv.Optional(CONF_FAN_START_TEMPERATURE, default=35.0): cv.float_,
             cv.Optional(CONF_FAN_FULL_TEMPERATURE, default=70.0): cv.float_,
+            cv.Optional(CONF_TARGET_TEMPERATURE): cv.float_,
+            cv.Optional(CONF_HYSTERESIS, default=3.0): _non_negative,
+            cv.Optional(CONF_PROPORTIONAL_GAIN, default=0.05): _positive,
+            cv.Optional(CONF_INTEGRAL_GAIN, default=0.004): _non_negative,
+            cv.Optional(CONF_MINIMUM_DUTY, default=0.2): cv.percentage,
+            cv.Optional(CONF_KICK_START_DUTY, default=1.0): cv.percentage,
+            cv.Optional(CONF_KICK_START_TIME, default="1s"):
+                cv.positive_time_period_milliseconds,
+            cv.Optional(CONF_WRITE_THRESHOLD, default=0.02):
+                cv.float_range(min=0.0, max=0.5),
         }
     ),
     _validate_cooling,
 )
 
+THERMAL_DERATING_SCHEMA = cv.Schema(
+    {
+        cv.Required(CONF_THERMAL_RESISTANCE): _positive,
+        cv.Required(CONF_TIME_CONSTANT): cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_HORIZON, default="60s"):
+            cv.positive_time_period_milliseconds,
+        cv.Optional(CONF_MARGIN, default=5.0): _non_negative,
+        cv.Optional(CONF_DERATING): sensor.sensor_schema(
+            unit_of_measurement=UNIT_AMPERE,
+            accuracy_decimals=2,
+            device_class=DEVICE_CLASS_CURRENT,
+            entity_category=ENTITY_CATEGORY_DIAGNOSTIC,
+        ),
+    }
+)
+
 FAULT_POLICY_SCHEMA = cv.Schema(
     {
         cv.Optional(CONF_AUTO_CLEAR, default=False): cv.boolean,
@@ -288,6 +342,15 @@ def _validate_config(config):
             "hardware.maximum_voltage"
         )
 
+    if (
+        CONF_THERMAL_DERATING in config
+        and not config[CONF_MEASUREMENTS][CONF_TEMPERATURES]
+    ):
+        raise cv.Invalid(
+            "thermal_derating requires at least one "
+            "measurements.temperatures entry"
+        )
+
     maximum_current = config[CONF_LIMITS][CONF_MAXIMUM_CURRENT]
     output_full_scale = config[CONF_CALIBRATION][CONF_OUTPUT][
         CONF_FULL_SCALE_CURRENT
@@ -352,6 +415,7 @@ CONFIG_SCHEMA = cv.All(
             cv.Required(CONF_LIMITS): LIMITS_SCHEMA,
             cv.Optional(CONF_CONTROL, default={}): CONTROL_SCHEMA,
             cv.Required(CONF_COOLING): COOLING_SCHEMA,
+            cv.Optional(CONF_THERMAL_DERATING): THERMAL_DERATING_SCHEMA,
             cv.Optional(CONF_FAULT_POLICY, default={}): FAULT_POLICY_SCHEMA,
             cv.Required(CONF_MANUAL_CURRENT): number.number_schema(
                 ManualCurrentNumber,
@@ -366,3 +430,31 @@ CONFIG_SCHEMA = cv.All(
     ).extend(cv.COMPONENT_SCHEMA),
     _validate_config,
 )
+
+
+def _validate_exclusive_channel_hardware(config):
+    # Channels must not share a DAC, fan or charger: one channel's fault or
+    # procedure would otherwise drive hardware owned by another channel.
+    channels = fv.full_config.get().get(DOMAIN, [])
+    seen = {}
+    for channel in channels:
+        resources = [
+            ("hardware.dac", channel[CONF_HARDWARE][CONF_DAC]),
+            ("cooling.fan_output", channel[CONF_COOLING][CONF_FAN_OUTPUT]),
+        ]
+        cycle = channel[CONF_PROCEDURES].get(CONF_BATTERY_CYCLE)
+        if cycle is not None:
+            resources.append(
+                ("procedures.battery_cycle.charger", cycle[CONF_CHARGER])
+            )
+        for path, resource in resources:
+            owner = seen.setdefault(str(resource), channel[CONF_ID])
+            if owner != channel[CONF_ID]:
+                raise cv.Invalid(
+                    f"{path} '{resource}' is already used by programmable "
+                    f"load '{owner}'; each load channel needs its own"
+                )
+    return config
+
+
+FINAL_VALIDATE_SCHEMA = _validate_exclusive_channel_hardware
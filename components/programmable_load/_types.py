@@ -5,7 +5,8 @@ from esphome.components import button, number
 component_common_ns = cg.global_ns.namespace("component_common")
 ChargerInterface = component_common_ns.class_("ChargerInterface")
 
-programmable_load_ns = cg.esphome_ns.namespace("programmable_load")
+DOMAIN = "programmable_load"
+programmable_load_ns = cg.esphome_ns.namespace(DOMAIN)
 
 ProgrammableLoadComponent = programmable_load_ns.class_(
     "ProgrammableLoadComponent", cg.Component
@@ -25,6 +26,9 @@ ApplyCalibrationAction = programmable_load_ns.class_(
 ResetCalibrationAction = programmable_load_ns.class_(
     "ResetCalibrationAction", automation.Action
 )
+SelectCalibrationProfileAction = programmable_load_ns.class_(
+    "SelectCalibrationProfileAction", automation.Action
+)
 DcrTest = programmable_load_ns.class_("DcrTest")
 DcrStartButton = programmable_load_ns.class_(
     "DcrStartButton", button.Button
@@ -65,6 +69,9 @@ CONF_OUTPUT_ZERO_LEVEL = "output_zero_level"
 CONF_OUTPUT_FULL_SCALE_CURRENT = "output_full_scale_current"
 CONF_RESET_CALIBRATION = "reset"
 CONF_PERSIST = "persist"
+CONF_PROFILE = "profile"
+CONF_ACTIVE_PROFILE = "active_profile"
+CONF_MAX_WRITES_PER_HOUR = "max_writes_per_hour"
 
 CONF_LIMITS = "limits"
 CONF_MAXIMUM_CURRENT = "maximum_current"
@@ -81,11 +88,26 @@ CONF_FALL_RATE = "fall_rate"
 CONF_PROPORTIONAL_GAIN = "proportional_gain"
 CONF_INTEGRAL_GAIN = "integral_gain"
 CONF_LOG_CONTROL_SAMPLES = "log_control_samples"
+CONF_LOG_CONTROL_SUMMARY = "log_control_summary"
+CONF_CONTROL_SAMPLE_LOG_LIMIT = "control_sample_log_limit"
 
 CONF_COOLING = "cooling"
 CONF_FAN_OUTPUT = "fan_output"
 CONF_FAN_START_TEMPERATURE = "fan_start_temperature"
 CONF_FAN_FULL_TEMPERATURE = "fan_full_temperature"
+CONF_TARGET_TEMPERATURE = "target_temperature"
+CONF_HYSTERESIS = "hysteresis"
+CONF_MINIMUM_DUTY = "minimum_duty"
+CONF_KICK_START_DUTY = "kick_start_duty"
+CONF_KICK_START_TIME = "kick_start_time"
+CONF_WRITE_THRESHOLD = "write_threshold"
+
+CONF_THERMAL_DERATING = "thermal_derating"
+CONF_THERMAL_RESISTANCE = "thermal_resistance"
+CONF_TIME_CONSTANT = "time_constant"
+CONF_HORIZON = "horizon"
+CONF_MARGIN = "margin"
+CONF_DERATING = "derating"
 
 CONF_FAULT_POLICY = "fault_policy"
 CONF_AUTO_CLEAR = "auto_clear"
@@ -0,0 +1,251 @@
+#include "calibration_store.h"
+
+#include <cstring>
+
+#include "../component_common/crc32.h"
+#include "programmable_load_core.h"
+
+namespace programmable_load_core {
+
+namespace {
+
+static constexpr uint32_t ONE_HOUR_MS = 3600u * 1000u;
+
+bool same_calibration(const Calibration &a, const Calibration &b) {
+  return a.version == b.version && a.current.scale == b.current.scale &&
+         a.current.offset == b.current.offset &&
+         a.voltage.scale == b.voltage.scale &&
+         a.voltage.offset == b.voltage.offset &&
+         a.output.zero_level == b.output.zero_level &&
+         a.output.full_scale_current_a == b.output.full_scale_current_a;
+}
+
+}  // namespace
+
+uint32_t calibration_record_crc(const CalibrationRecord &record) {
+  // Field by field so struct padding never reaches the checksum.
+  uint32_t crc = 0xFFFFFFFFu;
+  crc = component_common::crc32_field(crc, record.version);
+  crc = component_common::crc32_field(crc, record.reserved);
+  crc = component_common::crc32_field(crc, record.sequence);
+  crc = component_common::crc32_update(crc, record.name, sizeof(record.name));
+  crc = component_common::crc32_field(crc, record.calibration.version);
+  crc = component_common::crc32_field(crc, record.calibration.current.scale);
+  crc = component_common::crc32_field(crc, record.calibration.current.offset);
+  crc = component_common::crc32_field(crc, record.calibration.voltage.scale);
+  crc = component_common::crc32_field(crc, record.calibration.voltage.offset);
+  crc = component_common::crc32_field(crc, record.calibration.output.zero_level);
+  crc = component_common::crc32_field(crc, record.calibration.output.full_scale_current_a);
+  return ~crc;
+}
+
+bool calibration_profile_name_valid(const char *name) {
+  if (name == nullptr || name[0] == '\0') return false;
+  for (std::size_t index = 0; index < CALIBRATION_PROFILE_NAME_SIZE; index++) {
+    const char value = name[index];
+    if (value == '\0') return true;
+    if (value < 0x20 || value > 0x7E) return false;
+  }
+  return false;
+}
+
+bool calibration_record_valid(const CalibrationRecord &record) {
+  return record.version == CALIBRATION_STORE_VERSION && record.sequence != 0 &&
+         record.crc == calibration_record_crc(record) &&
+         calibration_profile_name_valid(record.name) &&
+         calibration_valid(record.calibration);
+}
+
+bool CalibrationStore::restore(CalibrationStorage &storage, uint32_t now_ms) {
+  uint32_t newest = 0;
+  for (uint8_t slot = 0; slot < MAX_CALIBRATION_PROFILES; slot++) {
+    CalibrationRecord record{};
+    this->records_[slot] = {};
+    this->dirty_[slot] = false;
+    if (!storage.load_record(slot, &record)) continue;
+    if (!calibration_record_valid(record)) {
+      this->stats_.corrupt_records++;
+      continue;
+    }
+    this->records_[slot] = record;
+    if (record.sequence > newest) {
+      newest = record.sequence;
+      this->active_slot_ = slot;
+    }
+  }
+  this->next_sequence_ = newest + 1u;
+  if (this->has_active()) return true;
+
+  Calibration legacy{};
+  if (!storage.load_legacy(&legacy) || !calibration_valid(legacy)) return false;
+  this->stats_.migrated_v1 = true;
+  this->save(storage, DEFAULT_CALIBRATION_PROFILE, legacy, now_ms);
+  return this->has_active();
+}
+
+CalibrationSaveResult CalibrationStore::save(CalibrationStorage &storage,
+                                             const char *profile,
+                                             const Calibration &calibration,
+                                             uint32_t now_ms) {
+  if (!calibration_profile_name_valid(profile) || !calibration_valid(calibration))
+    return CalibrationSaveResult::FAILED;
+  int slot = this->find_slot_(profile);
+  if (slot >= 0 && slot == this->active_slot_ &&
+      same_calibration(this->records_[slot].calibration, calibration)) {
+    this->stats_.skipped_unchanged++;
+    return CalibrationSaveResult::UNCHANGED;
+  }
+  if (slot < 0) slot = this->allocate_slot_();
+  if (slot < 0) {
+    // Every other slot still holds a pending write; flush() frees them.
+    this->stats_.failed++;
+    return CalibrationSaveResult::FAILED;
+  }
+
+  const CalibrationRecord previous = this->records_[slot];
+  const bool previous_dirty = this->dirty_[slot];
+  const int previous_active = this->active_slot_;
+  CalibrationRecord &record = this->records_[slot];
+  record = {};
+  std::strncpy(record.name, profile, sizeof(record.name) - 1);
+  record.calibration = calibration;
+  record.sequence = this->next_sequence_++;
+  this->active_slot_ = slot;
+  const CalibrationSaveResult result = this->commit_(storage, slot, now_ms);
+  if (result == CalibrationSaveResult::FAILED) {
+    this->records_[slot] = previous;
+    this->dirty_[slot] = previous_dirty;
+    this->active_slot_ = previous_active;
+  }
+  return result;
+}
+
+bool CalibrationStore::select(CalibrationStorage &storage, const char *profile,
+                              uint32_t now_ms, CalibrationSaveResult *result) {
+  const int slot = this->find_slot_(profile);
+  if (slot < 0) return false;
+  CalibrationSaveResult outcome = CalibrationSaveResult::UNCHANGED;
+  if (slot != this->active_slot_) {
+    const uint32_t previous_sequence = this->records_[slot].sequence;
+    const bool previous_dirty = this->dirty_[slot];
+    const int previous_active = this->active_slot_;
+    this->records_[slot].sequence = this->next_sequence_++;
+    this->active_slot_ = slot;
+    outcome = this->commit_(storage, slot, now_ms);
+    if (outcome == CalibrationSaveResult::FAILED) {
+      this->records_[slot].sequence = previous_sequence;
+      this->dirty_[slot] = previous_dirty;
+      this->active_slot_ = previous_active;
+    }
+  } else {
+    this->stats_.skipped_unchanged++;
+  }
+  if (result != nullptr) *result = outcome;
+  return outcome != CalibrationSaveResult::FAILED;
+}
+
+CalibrationSaveResult CalibrationStore::flush(CalibrationStorage &storage,
+                                              uint32_t now_ms) {
+  CalibrationSaveResult result = CalibrationSaveResult::UNCHANGED;
+  while (true) {
+    int oldest = -1;
+    for (int slot = 0; slot < MAX_CALIBRATION_PROFILES; slot++) {
+      if (this->dirty_[slot] &&
+          (oldest < 0 ||
+           this->records_[slot].sequence < this->records_[oldest].sequence)) {
+        oldest = slot;
+      }
+    }
+    if (oldest < 0) return result;
+    if (!this->budget_available_(now_ms)) return CalibrationSaveResult::DEFERRED;
+    if (!this->write_(storage, oldest, now_ms)) return CalibrationSaveResult::FAILED;
+    result = CalibrationSaveResult::SAVED;
+  }
+}
+
+const char *CalibrationStore::active_name() const {
+  return this->has_active() ? this->records_[this->active_slot_].name : "";
+}
+
+const Calibration *CalibrationStore::active_calibration() const {
+  return this->has_active() ? &this->records_[this->active_slot_].calibration
+                            : nullptr;
+}
+
+const Calibration *CalibrationStore::find(const char *profile) const {
+  const int slot = this->find_slot_(profile);
+  return slot >= 0 ? &this->records_[slot].calibration : nullptr;
+}
+
+bool CalibrationStore::pending() const {
+  for (bool dirty : this->dirty_) {
+    if (dirty) return true;
+  }
+  return false;
+}
+
+int CalibrationStore::find_slot_(const char *profile) const {
+  if (!calibration_profile_name_valid(profile)) return -1;
+  for (int slot = 0; slot < MAX_CALIBRATION_PROFILES; slot++) {
+    if (this->records_[slot].sequence != 0 &&
+        std::strncmp(this->records_[slot].name, profile,
+                     CALIBRATION_PROFILE_NAME_SIZE) == 0) {
+      return slot;
+    }
+  }
+  return -1;
+}
+
+int CalibrationStore::allocate_slot_() const {
+  // Prefer an empty slot; otherwise reuse the least recently activated
+  // profile other than the active one. A profile whose deferred write has not
+  // reached flash yet is never evicted.
+  int candidate = -1;
+  for (int slot = 0; slot < MAX_CALIBRATION_PROFILES; slot++) {
+    if (this->records_[slot].sequence == 0) return slot;
+    if (slot == this->active_slot_ || this->dirty_[slot]) continue;
+    if (candidate < 0 ||
+        this->records_[slot].sequence < this->records_[candidate].sequence) {
+      candidate = slot;
+    }
+  }
+  return candidate;
+}
+
+bool CalibrationStore::budget_available_(uint32_t now_ms) const {
+  if (this->max_writes_per_hour_ == 0) return false;
+  if (this->stats_.writes < this->max_writes_per_hour_) return true;
+  const uint32_t oldest =
+      this->write_times_ms_[(this->stats_.writes - this->max_writes_per_hour_) %
+                            MAX_CALIBRATION_WRITES_PER_HOUR];
+  return (uint32_t) (now_ms - oldest) >= ONE_HOUR_MS;
+}
+
+bool CalibrationStore::write_(CalibrationStorage &storage, int slot,
+                              uint32_t now_ms) {
+  CalibrationRecord &record = this->records_[slot];
+  record.version = CALIBRATION_STORE_VERSION;
+  record.crc = calibration_record_crc(record);
+  if (!storage.save_record(static_cast<uint8_t>(slot), record)) {
+    this->stats_.failed++;
+    return false;
+  }
+  this->dirty_[slot] = false;
+  this->write_times_ms_[this->stats_.writes % MAX_CALIBRATION_WRITES_PER_HOUR] =
+      now_ms;
+  this->stats_.writes++;
+  return true;
+}
+
+CalibrationSaveResult CalibrationStore::commit_(CalibrationStorage &storage,
+                                                int slot, uint32_t now_ms) {
+  this->dirty_[slot] = true;
+  if (!this->budget_available_(now_ms)) {
+    this->stats_.deferred++;
+    return CalibrationSaveResult::DEFERRED;
+  }
+  return this->write_(storage, slot, now_ms) ? CalibrationSaveResult::SAVED
+                                             : CalibrationSaveResult::FAILED;
+}
+
+}  // namespace programmable_load_core
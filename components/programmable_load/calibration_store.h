@@ -0,0 +1,117 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "calibration.h"
+
+namespace programmable_load_core {
+
+// Persisted format version. Version 1 was one bare `Calibration` blob under the
+// channel's calibration key; version 2 stores CRC-protected named profiles.
+static constexpr uint16_t CALIBRATION_STORE_VERSION = 2;
+static constexpr uint8_t MAX_CALIBRATION_PROFILES = 4;
+static constexpr std::size_t CALIBRATION_PROFILE_NAME_SIZE = 16;
+static constexpr const char *DEFAULT_CALIBRATION_PROFILE = "default";
+static constexpr uint32_t MAX_CALIBRATION_WRITES_PER_HOUR = 60;
+
+// One persisted profile slot. The active profile is the valid record with the
+// newest sequence, so activating a profile costs one record write and a torn
+// write falls back to the previously active profile.
+struct CalibrationRecord {
+  uint16_t version{CALIBRATION_STORE_VERSION};
+  uint16_t reserved{0};
+  uint32_t sequence{0};
+  char name[CALIBRATION_PROFILE_NAME_SIZE]{};
+  Calibration calibration{};
+  // CRC-32 of every preceding byte.
+  uint32_t crc{0};
+};
+
+uint32_t calibration_record_crc(const CalibrationRecord &record);
+bool calibration_record_valid(const CalibrationRecord &record);
+bool calibration_profile_name_valid(const char *name);
+
+// Persistence backend. The ESPHome facade maps slots onto preferences; host
+// tests substitute an in-memory flash.
+class CalibrationStorage {
+ public:
+  virtual ~CalibrationStorage() = default;
+  virtual bool load_record(uint8_t slot, CalibrationRecord *record) = 0;
+  virtual bool save_record(uint8_t slot, const CalibrationRecord &record) = 0;
+  virtual bool load_legacy(Calibration *calibration) = 0;
+};
+
+enum class CalibrationSaveResult : uint8_t {
+  SAVED = 0,
+  // Identical to what is already persisted; no write issued.
+  UNCHANGED,
+  // Accepted in RAM; written by flush() once the hourly budget allows.
+  DEFERRED,
+  FAILED,
+};
+
+struct CalibrationStoreStats {
+  uint32_t writes{0};
+  uint32_t skipped_unchanged{0};
+  uint32_t deferred{0};
+  uint32_t failed{0};
+  uint32_t corrupt_records{0};
+  bool migrated_v1{false};
+};
+
+// Named calibration profiles with write coalescing. Identical saves are
+// skipped, and record writes are bounded by a per-hour budget; saves beyond
+// the budget stay pending in RAM until flush() can write them.
+class CalibrationStore {
+ public:
+  void set_max_writes_per_hour(uint32_t writes) {
+    this->max_writes_per_hour_ =
+        writes < MAX_CALIBRATION_WRITES_PER_HOUR ? writes
+                                                 : MAX_CALIBRATION_WRITES_PER_HOUR;
+  }
+
+  // Loads every slot, discarding records with a bad CRC, version or payload.
+  // With no valid record, a valid v1 blob is migrated into the default
+  // profile and written immediately. Returns true when a profile is active.
+  bool restore(CalibrationStorage &storage, uint32_t now_ms);
+
+  // Stores `calibration` under `profile` and makes it active, creating the
+  // profile in a free slot when needed. Fails when every slot is either
+  // active or waiting for a deferred write.
+  CalibrationSaveResult save(CalibrationStorage &storage, const char *profile,
+                             const Calibration &calibration, uint32_t now_ms);
+  // Makes an existing profile active. Returns false if it does not exist.
+  bool select(CalibrationStorage &storage, const char *profile,
+              uint32_t now_ms, CalibrationSaveResult *result);
+  // Writes pending slots, oldest first, while the budget allows. Call
+  // periodically.
+  CalibrationSaveResult flush(CalibrationStorage &storage, uint32_t now_ms);
+
+  bool has_active() const { return this->active_slot_ >= 0; }
+  const char *active_name() const;
+  const Calibration *active_calibration() const;
+  const Calibration *find(const char *profile) const;
+  bool pending() const;
+  const CalibrationStoreStats &stats() const { return this->stats_; }
+
+ protected:
+  int find_slot_(const char *profile) const;
+  int allocate_slot_() const;
+  // Sliding one-hour window: a write is allowed while fewer than the budget
+  // were issued in the preceding hour.
+  bool budget_available_(uint32_t now_ms) const;
+  bool write_(CalibrationStorage &storage, int slot, uint32_t now_ms);
+  CalibrationSaveResult commit_(CalibrationStorage &storage, int slot,
+                                uint32_t now_ms);
+
+  CalibrationRecord records_[MAX_CALIBRATION_PROFILES]{};
+  bool dirty_[MAX_CALIBRATION_PROFILES]{};
+  uint32_t next_sequence_{1};
+  int active_slot_{-1};
+  uint32_t max_writes_per_hour_{6};
+  uint32_t write_times_ms_[MAX_CALIBRATION_WRITES_PER_HOUR]{};
+  CalibrationStoreStats stats_{};
+};
+
+}  // namespace programmable_load_core
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "calibration_store.h"
 #include "programmable_load_core.h"
 
 namespace esphome {
@@ -8,16 +9,34 @@ namespace programmable_load {
 using ::programmable_load_core::ABSOLUTE_MAXIMUM_VOLTAGE_V;
 using ::programmable_load_core::CALIBRATION_VERSION;
 using ::programmable_load_core::Calibration;
+using ::programmable_load_core::CalibrationRecord;
+using ::programmable_load_core::CalibrationSaveResult;
 using ::programmable_load_core::CalibrationSource;
+using ::programmable_load_core::CalibrationStorage;
+using ::programmable_load_core::CalibrationStore;
+using ::programmable_load_core::ChannelControl;
 using ::programmable_load_core::ChargerCommand;
 using ::programmable_load_core::ChargerMeasurement;
+using ::programmable_load_core::ChargerSampleTracker;
 using ::programmable_load_core::ChargerState;
+using ::programmable_load_core::ControlAction;
+using ::programmable_load_core::ControlSample;
+using ::programmable_load_core::ControlSampleBuffer;
+using ::programmable_load_core::ControlSummary;
+using ::programmable_load_core::ControlSummaryAccumulator;
+using ::programmable_load_core::ControlTick;
+using ::programmable_load_core::ControlTickInput;
+using ::programmable_load_core::ControlTuning;
+using ::programmable_load_core::CurrentController;
+using ::programmable_load_core::FanController;
+using ::programmable_load_core::FanTuning;
 using ::programmable_load_core::Fault;
 using ::programmable_load_core::FaultFlags;
 using ::programmable_load_core::FaultPolicy;
 using ::programmable_load_core::HardwareLimits;
 using ::programmable_load_core::Limits;
 using ::programmable_load_core::LinearCalibration;
+using ::programmable_load_core::MAX_CALIBRATION_PROFILES;
 using ::programmable_load_core::Measurement;
 using ::programmable_load_core::OperationLock;
 using ::programmable_load_core::OperationOwner;
@@ -27,6 +46,8 @@ using ::programmable_load_core::ProcedureResult;
 using ::programmable_load_core::ProcedureStatus;
 using ::programmable_load_core::State;
 using ::programmable_load_core::StopReason;
+using ::programmable_load_core::ThermalDerating;
+using ::programmable_load_core::ThermalDeratingConfig;
 using ::programmable_load_core::calibration_source_to_string;
 using ::programmable_load_core::fault_flag;
 using ::programmable_load_core::fault_to_string;
@@ -13,6 +13,7 @@ namespace programmable_load {
 namespace {
 static const char *const TAG = "programmable_load";
 static constexpr uint32_t CHARGER_COMMAND_RETRY_MS = 1000;
+static constexpr uint32_t CONTROL_REPORT_INTERVAL_MS = 1000;
 
 bool finite_positive(float value) {
   return std::isfinite(value) && value > 0.0f;
@@ -40,17 +41,23 @@ void ProgrammableLoadComponent::setup() {
   this->configured_calibration_.version = CALIBRATION_VERSION;
   this->calibration_.version = CALIBRATION_VERSION;
   if (global_preferences != nullptr) {
-    this->calibration_preference_ =
-        global_preferences->make_preference<Calibration>(CALIBRATION_PREFERENCE_KEY);
-    this->calibration_preference_valid_ = true;
-    if (this->restore_calibration_) {
-      Calibration persisted{};
-      if (this->calibration_preference_.load(&persisted) &&
-          ::programmable_load_core::calibration_valid(persisted)) {
-        this->calibration_ = persisted;
-        this->calibration_source_ = CalibrationSource::RESTORED;
-        ESP_LOGI(TAG, "Restored programmable-load calibration");
-      }
+    this->calibration_storage_.init(this->calibration_preference_key_);
+    this->calibration_storage_valid_ = true;
+    this->calibration_store_.restore(this->calibration_storage_, millis());
+    const auto &stats = this->calibration_store_.stats();
+    if (stats.corrupt_records != 0) {
+      ESP_LOGW(TAG, "Discarded %u corrupt calibration record(s)",
+               (unsigned) stats.corrupt_records);
+    }
+    if (stats.migrated_v1) {
+      ESP_LOGI(TAG, "Migrated v1 calibration to profile '%s'",
+               this->calibration_store_.active_name());
+    }
+    if (this->restore_calibration_ && this->calibration_store_.has_active()) {
+      this->calibration_ = *this->calibration_store_.active_calibration();
+      this->calibration_source_ = CalibrationSource::RESTORED;
+      ESP_LOGI(TAG, "Restored programmable-load calibration profile '%s'",
+               this->calibration_store_.active_name());
     }
   }
 
@@ -90,6 +97,7 @@ void ProgrammableLoadComponent::setup() {
   }
   this->last_control_ms_ = now;
   this->last_fan_update_ms_ = now;
+  this->last_control_report_ms_ = now;
   ESP_LOGCONFIG(TAG, "Programmable load initialized");
 }
 
@@ -99,8 +107,9 @@ void ProgrammableLoadComponent::dump_config() {
   char faults[256];
   format_faults(this->faults_, faults, sizeof(faults));
   ESP_LOGCONFIG(TAG, "  Fault: %s", faults);
-  ESP_LOGCONFIG(TAG, "  Calibration: %s",
-                calibration_source_to_string(this->calibration_source_));
+  ESP_LOGCONFIG(TAG, "  Calibration: %s (profile '%s')",
+                calibration_source_to_string(this->calibration_source_),
+                this->calibration_profile());
   ESP_LOGCONFIG(TAG, "    Current: raw * %.7g + %.7g A",
                 this->calibration_.current.scale,
                 this->calibration_.current.offset);
@@ -116,6 +125,15 @@ void ProgrammableLoadComponent::dump_config() {
                 this->limits_.minimum_voltage_v, this->limits_.maximum_voltage_v);
   ESP_LOGCONFIG(TAG, "  Maximum current/power: %.3f A / %.1f W",
                 this->limits_.maximum_current_a, this->limits_.maximum_power_w);
+  if (this->thermal_derating_config_.enabled) {
+    ESP_LOGCONFIG(TAG,
+                  "  Thermal derating: %.3f degC/W, tau %.0f s, horizon %.0f s, "
+                  "margin %.1f degC",
+                  this->thermal_derating_config_.thermal_resistance_c_per_w,
+                  this->thermal_derating_config_.time_constant_s,
+                  this->thermal_derating_config_.horizon_s,
+                  this->thermal_derating_config_.margin_c);
+  }
   ESP_LOGCONFIG(TAG, "  Charger capability: %s",
                 this->charger_ != nullptr ? "configured" : "not configured");
   if (this->dac_output_ == nullptr) ESP_LOGE(TAG, "  DAC output is not configured");
@@ -125,10 +143,14 @@ void ProgrammableLoadComponent::dump_config() {
 
 void ProgrammableLoadComponent::loop() {
   const uint32_t now = millis();
-  if ((uint32_t) (now - this->last_control_ms_) < this->control_period_ms_) return;
+  const uint32_t elapsed_ms = now - this->last_control_ms_;
+  if (elapsed_ms < this->control_period_ms_) return;
   this->last_control_ms_ = now;
 
   this->update_measurement_();
+  this->thermal_derating_.update(this->thermal_derating_config_,
+                                 this->measurement_, this->limits_,
+                                 elapsed_ms / 1000.0f);
   this->update_charger_measurement_();
   this->update_faults_();
   if (this->state_ == State::RUNNING) {
@@ -138,9 +160,13 @@ void ProgrammableLoadComponent::loop() {
   } else {
     this->force_output_off_();
   }
-  if ((uint32_t) (now - this->last_fan_update_ms_) >= 500) {
-    this->last_fan_update_ms_ = now;
-    this->update_fan_();
+  if ((uint32_t) (now - this->last_fan_update_ms_) >= 500) this->update_fan_();
+  if ((uint32_t) (now - this->last_control_report_ms_) >=
+      CONTROL_REPORT_INTERVAL_MS) {
+    this->last_control_report_ms_ = now;
+    this->report_control_diagnostics_();
+    this->report_thermal_derating_();
+    this->flush_calibration_();
   }
 }
 
@@ -194,7 +220,7 @@ bool ProgrammableLoadComponent::start_procedure(Procedure *procedure) {
     return false;
   }
   this->apply_charger_command_(ChargerCommand::DISABLE);
-  const ProcedureContext context{this->measurement_, this->charger_measurement_};
+  const ProcedureContext context{this->measurement_, this->charger_measurement()};
   const ProcedureResult result = procedure->start(context);
   if (result.status == ProcedureStatus::FAILED) {
     this->trip_fault_(result.fault == Fault::NONE ? Fault::PROCEDURE_ERROR
@@ -289,25 +315,8 @@ void ProgrammableLoadComponent::update_measurement_() {
 }
 
 void ProgrammableLoadComponent::update_charger_measurement_() {
-  this->charger_measurement_ = {};
-  if (this->charger_ == nullptr) return;
-
-  const auto capabilities = this->charger_->capabilities();
-  if (!capabilities.enable_control || !capabilities.battery_current ||
-      !capabilities.battery_voltage || !capabilities.charge_state ||
-      !capabilities.power_good || !capabilities.fault_status) {
-    return;
-  }
-
-  this->charger_measurement_ = this->charger_->snapshot();
-  const uint32_t now = millis();
-  const bool fresh = this->charger_measurement_.timestamp_ms != 0 &&
-                     (uint32_t) (now - this->charger_measurement_.timestamp_ms) <=
-                         this->charger_sample_timeout_ms_;
-  this->charger_measurement_.valid =
-      this->charger_measurement_.valid && fresh &&
-      std::isfinite(this->charger_measurement_.current_a) &&
-      std::isfinite(this->charger_measurement_.voltage_v);
+  this->charger_samples_.update(this->charger_, millis(),
+                                this->charger_sample_timeout_ms_);
 }
 
 void ProgrammableLoadComponent::update_faults_() {
@@ -347,123 +356,141 @@ void ProgrammableLoadComponent::update_operation_() {
     this->trip_fault_(Fault::PROCEDURE_ERROR);
     return;
   }
-  const ProcedureContext context{this->measurement_, this->charger_measurement_};
+  const ProcedureContext context{this->measurement_, this->charger_measurement()};
   this->apply_procedure_result_(this->active_procedure_->update(context));
 }
 
 void ProgrammableLoadComponent::update_control_() {
-  const bool charger_enabled =
-      this->charger_measurement_.valid && this->charger_measurement_.enabled;
-  if (this->charger_commanded_enabled_ || charger_enabled) {
-    this->reset_control_();
-    this->force_output_off_();
-    if (this->charger_control_mismatch_()) {
-      this->trip_fault_(Fault::CHARGER_CONTROL_ERROR);
-    }
-    return;
-  }
-  if (this->charger_control_mismatch_()) {
-    this->trip_fault_(Fault::CHARGER_CONTROL_ERROR);
-    return;
-  }
-  const float current_limit = this->effective_current_limit_();
-  if (!std::isfinite(current_limit) || current_limit < 0.0f ||
-      !this->measurement_.current_valid) {
-    this->trip_fault_(Fault::CONTROL_ERROR);
-    return;
-  }
-  if (this->control_has_current_sample_ &&
-      this->current_sequence_ == this->last_control_current_sequence_) {
-    return;
-  }
-  const uint32_t current_timestamp_ms = this->current_updated_ms_;
-  const float dt_s = this->control_has_current_sample_
-                         ? static_cast<float>(current_timestamp_ms -
-                                              this->last_control_current_timestamp_ms_) /
-                               1000.0f
-                         : static_cast<float>(this->control_period_ms_) / 1000.0f;
-  this->last_control_current_sequence_ = this->current_sequence_;
-  this->last_control_current_timestamp_ms_ = current_timestamp_ms;
-  this->control_has_current_sample_ = true;
-  if (!std::isfinite(dt_s) || dt_s <= 0.0f || dt_s > 1.0f) {
-    return;
-  }
-
-  const float target = clampf(this->requested_current_a_, 0.0f, current_limit);
-  const float error = target - this->measurement_.current_a;
-  const float bounded_error = std::fabs(error) <= this->deadband_a_ ? 0.0f : error;
-  if (!std::isfinite(this->commanded_current_a_) ||
-      !std::isfinite(this->control_integrator_a_)) {
-    this->trip_fault_(Fault::CONTROL_ERROR);
-    return;
-  }
-
-  const float proportional = this->proportional_gain_ * bounded_error;
-  float desired = target + proportional + this->control_integrator_a_;
-  const bool saturated_low = desired < 0.0f;
-  const bool saturated_high = desired > current_limit;
-  if ((!saturated_low && !saturated_high) ||
-      (saturated_low && bounded_error > 0.0f) ||
-      (saturated_high && bounded_error < 0.0f)) {
-    this->control_integrator_a_ = clampf(
-        this->control_integrator_a_ +
-            this->integral_gain_per_s_ * bounded_error * dt_s,
-        -current_limit, current_limit);
-    desired = target + proportional + this->control_integrator_a_;
-  }
-  desired = clampf(desired, 0.0f, current_limit);
-  const float maximum_rise = this->rise_rate_a_per_s_ * dt_s;
-  const float maximum_fall = this->fall_rate_a_per_s_ * dt_s;
-  const float next = clampf(desired,
-                            this->commanded_current_a_ - maximum_fall,
-                            this->commanded_current_a_ + maximum_rise);
-  this->commanded_current_a_ = clampf(next, 0.0f, current_limit);
-  this->drive_output_(this->commanded_current_a_);
-  if (this->log_control_samples_) {
-    ESP_LOGI(TAG,
-             "PI sample=%u dt=%.3fs target=%.3fA measured=%.3fA error=%.3fA "
-             "p=%.3fA i=%.3fA desired=%.3fA command=%.3fA",
-             this->current_sequence_, dt_s, target,
-             this->measurement_.current_a, error, proportional,
-             this->control_integrator_a_, desired, this->commanded_current_a_);
+  ControlTickInput input{};
+  input.requested_a = this->requested_current_a_;
+  input.measured_a = this->measurement_.current_a;
+  input.measured_valid = this->measurement_.current_valid;
+  input.current_sequence = this->current_sequence_;
+  input.current_timestamp_ms = this->current_updated_ms_;
+  input.control_period_ms = this->control_period_ms_;
+  input.charger_active = this->charger_commanded_enabled_ ||
+                         (this->charger_measurement().valid &&
+                          this->charger_measurement().enabled);
+  input.charger_control_mismatch = this->charger_control_mismatch_();
+  if (!input.charger_active && !input.charger_control_mismatch)
+    input.current_limit_a = this->effective_current_limit_();
+
+  ControlSample sample{};
+  const ControlTick tick =
+      this->control_.tick(this->control_tuning_, input, &sample);
+  switch (tick.action) {
+    case ControlAction::HOLD:
+      return;
+    case ControlAction::OUTPUT_OFF:
+      this->force_output_off_();
+      return;
+    case ControlAction::TRIP:
+      this->trip_fault_(tick.fault);
+      return;
+    case ControlAction::DRIVE:
+      break;
+  }
+  this->drive_output_(this->control_.command_a());
+  if (this->log_control_summary_ || this->log_control_samples_) {
+    this->control_summary_.add(sample);
+    if (this->log_control_samples_) this->control_samples_.push(sample);
   }
 }
 
 void ProgrammableLoadComponent::reset_control_() {
-  this->commanded_current_a_ = 0.0f;
-  this->reset_control_integrator_();
+  this->control_.reset(this->current_sequence_, this->current_updated_ms_);
 }
 
 void ProgrammableLoadComponent::reset_control_integrator_() {
-  this->control_integrator_a_ = 0.0f;
   // Do not reuse the sample that preceded a target or ownership change.
   // The next command is produced only after the current sensor publishes again.
-  this->control_has_current_sample_ = true;
-  this->last_control_current_sequence_ = this->current_sequence_;
-  this->last_control_current_timestamp_ms_ = this->current_updated_ms_;
+  this->control_.reset_integrator(this->current_sequence_,
+                                  this->current_updated_ms_);
 }
 
 void ProgrammableLoadComponent::update_fan_() {
   if (this->fan_output_ == nullptr) return;
-  const float temperature = this->measurement_.maximum_temperature_c;
-  if (!std::isfinite(temperature)) {
-    this->fan_output_->set_level(this->state_ == State::IDLE ? 0.0f : 1.0f);
-  } else if (temperature <= this->fan_start_temperature_c_) {
-    this->fan_output_->set_level(0.0f);
-  } else if (temperature >= this->fan_full_temperature_c_) {
-    this->fan_output_->set_level(1.0f);
-  } else {
-    this->fan_output_->set_level(clampf(
-        (temperature - this->fan_start_temperature_c_) /
-            (this->fan_full_temperature_c_ - this->fan_start_temperature_c_),
-        0.0f, 1.0f));
+  const uint32_t now = millis();
+  const float dt_s = (uint32_t) (now - this->last_fan_update_ms_) / 1000.0f;
+  this->last_fan_update_ms_ = now;
+  // Without a usable temperature, fail safe: full cooling while the load can
+  // dissipate and off while idle.
+  if (this->fan_controller_.update(this->fan_tuning_, this->fan_temperature_c_(),
+                                   this->state_ == State::IDLE ? 0.0f : 1.0f,
+                                   now, dt_s)) {
+    this->fan_output_->set_level(this->fan_controller_.level());
+  }
+}
+
+float ProgrammableLoadComponent::fan_temperature_c_() const {
+  // Regulate on the hottest required input. Optional inputs only steer the
+  // fan when no input is marked required.
+  bool any_required = false;
+  float hottest = std::numeric_limits<float>::quiet_NaN();
+  for (const TemperatureInput &input : this->temperature_inputs_) {
+    if (input.required) {
+      if (input.sensor == nullptr || !input.sensor->has_state() ||
+          !std::isfinite(input.sensor->state)) {
+        return std::numeric_limits<float>::quiet_NaN();
+      }
+      if (!any_required || input.sensor->state > hottest) {
+        hottest = input.sensor->state;
+      }
+      any_required = true;
+    }
+  }
+  return any_required ? hottest : this->measurement_.maximum_temperature_c;
+}
+
+void ProgrammableLoadComponent::report_control_diagnostics_() {
+  const ControlSummary summary = this->control_summary_.take();
+  if (this->log_control_summary_ && summary.samples != 0) {
+    ESP_LOGI(TAG,
+             "PI summary n=%u error=%.3f/%.3f/%.3fA "
+             "command=%.3f/%.3f/%.3fA integrator=%.3f/%.3f/%.3fA "
+             "dt=%.3f/%.3f/%.3fs jitter=%.4fs (min/mean/max)",
+             (unsigned) summary.samples, summary.error_a.minimum,
+             summary.error_a.mean, summary.error_a.maximum,
+             summary.command_a.minimum, summary.command_a.mean,
+             summary.command_a.maximum, summary.integrator_a.minimum,
+             summary.integrator_a.mean, summary.integrator_a.maximum,
+             summary.dt_s.minimum, summary.dt_s.mean, summary.dt_s.maximum,
+             summary.dt_jitter_s);
+  }
+
+  // Stream at most the configured number of raw samples per report, the
+  // latest of those buffered. A full ring drops new samples instead of
+  // overwriting old ones, so after an overflow the log resumes from the
+  // samples recorded before it; both losses are reported as skipped.
+  uint32_t skipped = this->control_samples_.take_dropped();
+  const std::size_t pending = this->control_samples_.size();
+  std::size_t older = pending > this->control_sample_log_limit_
+                          ? pending - this->control_sample_log_limit_
+                          : 0;
+  ControlSample sample{};
+  for (std::size_t i = 0; i < pending && this->control_samples_.pop(&sample); i++) {
+    if (older != 0) {
+      older--;
+      skipped++;
+      continue;
+    }
+    ESP_LOGI(TAG,
+             "PI sample=%u t=%ums dt=%.3fs target=%.3fA measured=%.3fA "
+             "error=%.3fA p=%.3fA i=%.3fA command=%.3fA",
+             (unsigned) sample.sequence, (unsigned) sample.timestamp_ms,
+             sample.dt_s, sample.target_a, sample.measured_a, sample.error_a,
+             sample.proportional_a, sample.integrator_a, sample.command_a);
+  }
+  if (skipped != 0) {
+    ESP_LOGD(TAG, "PI samples not streamed: %u", (unsigned) skipped);
   }
 }
 
 FaultFlags ProgrammableLoadComponent::detect_running_faults_() const {
   return ::programmable_load_core::detect_safety_faults(
       this->measurement_, this->hardware_limits_, this->limits_,
-      this->deadband_a_, this->required_temperature_unavailable_(),
+      this->control_tuning_.deadband_a,
+      this->required_temperature_unavailable_(),
       this->charger_control_mismatch_());
 }
 
@@ -471,10 +498,11 @@ bool ProgrammableLoadComponent::fault_conditions_active_(
     FaultFlags faults) const {
   return ::programmable_load_core::fault_conditions_active(
       faults, this->measurement_, this->hardware_limits_, this->limits_,
-      this->deadband_a_, this->required_temperature_unavailable_(),
+      this->control_tuning_.deadband_a,
+      this->required_temperature_unavailable_(),
       this->charger_control_mismatch_(), this->charger_ != nullptr,
-      this->charger_measurement_.valid,
-      this->charger_measurement_.fault_active);
+      this->charger_measurement().valid,
+      this->charger_measurement().fault_active);
 }
 
 bool ProgrammableLoadComponent::required_temperature_unavailable_() const {
@@ -500,7 +528,7 @@ void ProgrammableLoadComponent::apply_procedure_result_(
   if (!std::isfinite(result.requested_current_a) ||
       result.requested_current_a < 0.0f ||
       (result.charger_command == ChargerCommand::ENABLE &&
-       result.requested_current_a > this->deadband_a_)) {
+       result.requested_current_a > this->control_tuning_.deadband_a)) {
     this->trip_fault_(Fault::PROCEDURE_ERROR);
     return;
   }
@@ -532,8 +560,8 @@ bool ProgrammableLoadComponent::apply_charger_command_(
     this->charger_command_changed_ms_ = now == 0 ? 1 : now;
     this->last_charger_command_attempt_ms_ = 0;
   }
-  if ((!this->charger_measurement_.valid ||
-       this->charger_measurement_.enabled != enabled) &&
+  if ((!this->charger_measurement().valid ||
+       this->charger_measurement().enabled != enabled) &&
       (this->last_charger_command_attempt_ms_ == 0 ||
        (uint32_t) (now - this->last_charger_command_attempt_ms_) >=
            CHARGER_COMMAND_RETRY_MS)) {
@@ -545,8 +573,8 @@ bool ProgrammableLoadComponent::apply_charger_command_(
 
 bool ProgrammableLoadComponent::charger_control_mismatch_() const {
   if (!this->charger_command_known_ || this->charger_ == nullptr ||
-      !this->charger_measurement_.valid ||
-      this->charger_measurement_.enabled == this->charger_commanded_enabled_) {
+      !this->charger_measurement().valid ||
+      this->charger_measurement().enabled == this->charger_commanded_enabled_) {
     return false;
   }
   return this->charger_command_changed_ms_ != 0 &&
@@ -600,12 +628,14 @@ void ProgrammableLoadComponent::trip_faults_(FaultFlags faults) {
 }
 
 void ProgrammableLoadComponent::publish_status_() {
-  if (this->state_sensor_ != nullptr)
-    this->state_sensor_->publish_state(state_to_string(this->state_));
+  const char *state = state_to_string(this->state_);
+  if (this->state_sensor_ != nullptr && this->state_guard_.changed(state))
+    this->state_sensor_->publish_state(state);
   if (this->fault_sensor_ != nullptr) {
     char faults[256];
     format_faults(this->faults_, faults, sizeof(faults));
-    this->fault_sensor_->publish_state(faults);
+    if (this->fault_guard_.changed(faults))
+      this->fault_sensor_->publish_state(faults);
   }
 }
 
@@ -613,6 +643,8 @@ void ProgrammableLoadComponent::publish_calibration_() {
   if (this->calibration_status_sensor_ != nullptr)
     this->calibration_status_sensor_->publish_state(
         calibration_source_to_string(this->calibration_source_));
+  if (this->calibration_profile_sensor_ != nullptr)
+    this->calibration_profile_sensor_->publish_state(this->calibration_profile());
   if (this->current_scale_sensor_ != nullptr)
     this->current_scale_sensor_->publish_state(this->calibration_.current.scale);
   if (this->current_offset_sensor_ != nullptr)
@@ -629,9 +661,35 @@ void ProgrammableLoadComponent::publish_calibration_() {
         this->calibration_.output.full_scale_current_a);
 }
 
-float ProgrammableLoadComponent::effective_current_limit_() const {
-  return ::programmable_load_core::effective_current_limit(
-      this->measurement_, this->limits_, this->calibration_);
+float ProgrammableLoadComponent::effective_current_limit_() {
+  return this->thermal_derating_.apply(
+      this->thermal_derating_config_, this->measurement_,
+      ::programmable_load_core::effective_current_limit(
+          this->measurement_, this->limits_, this->calibration_));
+}
+
+void ProgrammableLoadComponent::report_thermal_derating_() {
+  if (!this->thermal_derating_config_.enabled) return;
+  const float derating_a = this->state_ == State::RUNNING
+                               ? this->thermal_derating_.derating_a()
+                               : 0.0f;
+  const bool active = derating_a > 0.0f;
+  if (active != this->thermal_derating_active_) {
+    this->thermal_derating_active_ = active;
+    if (active) {
+      ESP_LOGI(TAG, "Thermal derating active: %.1f W allowed, limit reduced by %.2f A",
+               this->thermal_derating_.allowed_power_w(), derating_a);
+    } else {
+      ESP_LOGI(TAG, "Thermal derating released");
+    }
+  }
+  if (this->thermal_derating_sensor_ != nullptr &&
+      (!std::isfinite(this->reported_derating_a_) ||
+       std::fabs(derating_a - this->reported_derating_a_) >= 0.01f ||
+       (!active && this->reported_derating_a_ != 0.0f))) {
+    this->reported_derating_a_ = derating_a;
+    this->thermal_derating_sensor_->publish_state(derating_a);
+  }
 }
 
 void ProgrammableLoadComponent::drive_output_(float current_a) {
@@ -656,15 +714,48 @@ void ProgrammableLoadComponent::force_output_off_() {
   this->dac_output_->set_level(clampf(zero, 0.0f, 1.0f));
 }
 
-bool ProgrammableLoadComponent::save_calibration_() {
-  return this->calibration_preference_valid_ &&
-         this->calibration_preference_.save(&this->calibration_);
+bool ProgrammableLoadComponent::save_calibration_(const char *profile) {
+  if (!this->calibration_storage_valid_) return false;
+  switch (this->calibration_store_.save(this->calibration_storage_, profile,
+                                        this->calibration_, millis())) {
+    case CalibrationSaveResult::SAVED:
+      return true;
+    case CalibrationSaveResult::UNCHANGED:
+      ESP_LOGD(TAG, "Calibration unchanged; skipped flash write");
+      return true;
+    case CalibrationSaveResult::DEFERRED:
+      ESP_LOGW(TAG, "Calibration write budget exhausted; save deferred");
+      return true;
+    default:
+      return false;
+  }
+}
+
+void ProgrammableLoadComponent::flush_calibration_() {
+  if (!this->calibration_storage_valid_ || !this->calibration_store_.pending())
+    return;
+  const CalibrationSaveResult result =
+      this->calibration_store_.flush(this->calibration_storage_, millis());
+  if (result == CalibrationSaveResult::SAVED) {
+    ESP_LOGI(TAG, "Wrote deferred calibration");
+  } else if (result == CalibrationSaveResult::FAILED) {
+    ESP_LOGW(TAG, "Failed to write deferred calibration");
+  }
+}
+
+const char *ProgrammableLoadComponent::calibration_profile() const {
+  return this->calibration_store_.has_active()
+             ? this->calibration_store_.active_name()
+             : this->calibration_profile_;
 }
 
 bool ProgrammableLoadComponent::apply_calibration(
-    const Calibration &calibration, bool persist, CalibrationSource source) {
+    const Calibration &calibration, bool persist, CalibrationSource source,
+    const char *profile) {
   if (this->state_ != State::IDLE ||
-      !::programmable_load_core::calibration_valid(calibration)) {
+      !::programmable_load_core::calibration_valid(calibration) ||
+      (profile != nullptr &&
+       !::programmable_load_core::calibration_profile_name_valid(profile))) {
     ESP_LOGW(TAG, "Rejected calibration while busy or with invalid values");
     return false;
   }
@@ -673,7 +764,8 @@ bool ProgrammableLoadComponent::apply_calibration(
   this->calibration_ = calibration;
   this->calibration_source_ = source;
   this->force_output_off_();
-  if (persist && !this->save_calibration_()) {
+  if (persist && !this->save_calibration_(
+                     profile != nullptr ? profile : this->calibration_profile())) {
     this->calibration_ = previous;
     this->calibration_source_ = previous_source;
     this->force_output_off_();
@@ -681,8 +773,8 @@ bool ProgrammableLoadComponent::apply_calibration(
     return false;
   }
   this->publish_calibration_();
-  ESP_LOGI(TAG, "Applied programmable-load calibration (%s)",
-           calibration_source_to_string(source));
+  ESP_LOGI(TAG, "Applied programmable-load calibration (%s, profile '%s')",
+           calibration_source_to_string(source), this->calibration_profile());
   return true;
 }
 
@@ -691,6 +783,54 @@ bool ProgrammableLoadComponent::reset_calibration(bool persist) {
                                  CalibrationSource::CONFIGURED);
 }
 
+bool ProgrammableLoadComponent::select_calibration_profile(const char *profile) {
+  const Calibration *stored = this->calibration_store_.find(profile);
+  if (this->state_ != State::IDLE || stored == nullptr ||
+      !::programmable_load_core::calibration_valid(*stored)) {
+    ESP_LOGW(TAG, "Rejected calibration profile '%s' while busy or unknown",
+             profile != nullptr ? profile : "");
+    return false;
+  }
+  CalibrationSaveResult result = CalibrationSaveResult::FAILED;
+  const Calibration selected = *stored;
+  if (!this->calibration_store_.select(this->calibration_storage_, profile,
+                                       millis(), &result)) {
+    ESP_LOGW(TAG, "Failed to persist calibration profile selection");
+    return false;
+  }
+  if (result == CalibrationSaveResult::DEFERRED) {
+    ESP_LOGW(TAG, "Calibration write budget exhausted; selection deferred");
+  }
+  this->calibration_ = selected;
+  this->calibration_source_ = CalibrationSource::RESTORED;
+  this->force_output_off_();
+  this->publish_calibration_();
+  ESP_LOGI(TAG, "Selected calibration profile '%s'", this->calibration_profile());
+  return true;
+}
+
+void PreferenceCalibrationStorage::init(uint32_t key) {
+  this->legacy_ = global_preferences->make_preference<Calibration>(key);
+  for (uint8_t slot = 0; slot < MAX_CALIBRATION_PROFILES; slot++) {
+    this->slots_[slot] =
+        global_preferences->make_preference<CalibrationRecord>(key + 1u + slot);
+  }
+}
+
+bool PreferenceCalibrationStorage::load_record(uint8_t slot,
+                                               CalibrationRecord *record) {
+  return slot < MAX_CALIBRATION_PROFILES && this->slots_[slot].load(record);
+}
+
+bool PreferenceCalibrationStorage::save_record(uint8_t slot,
+                                               const CalibrationRecord &record) {
+  return slot < MAX_CALIBRATION_PROFILES && this->slots_[slot].save(&record);
+}
+
+bool PreferenceCalibrationStorage::load_legacy(Calibration *calibration) {
+  return this->legacy_.load(calibration);
+}
+
 void ManualCurrentNumber::control(float value) {
   if (this->parent_ == nullptr || !std::isfinite(value)) return;
   if (value <= 0.0f) {
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cmath>
 #include <cstdint>
+#include <string>
 #include <vector>
 
 #include "esphome/components/button/button.h"
@@ -13,6 +15,7 @@
 #include "esphome/core/preferences.h"
 
 #include "../component_common/charger.h"
+#include "../component_common/fixed_string.h"
 
 #include "load_types.h"
 #include "procedure.h"
@@ -25,6 +28,20 @@ struct TemperatureInput {
   bool required{false};
 };
 
+// Maps calibration store slots onto ESPHome preferences. The v1 blob stays at
+// the channel key; profile slots use the following keys.
+class PreferenceCalibrationStorage : public CalibrationStorage {
+ public:
+  void init(uint32_t key);
+  bool load_record(uint8_t slot, CalibrationRecord *record) override;
+  bool save_record(uint8_t slot, const CalibrationRecord &record) override;
+  bool load_legacy(Calibration *calibration) override;
+
+ protected:
+  ESPPreferenceObject legacy_{};
+  ESPPreferenceObject slots_[MAX_CALIBRATION_PROFILES]{};
+};
+
 class ProgrammableLoadComponent : public Component {
  public:
   void setup() override;
@@ -80,9 +97,27 @@ class ProgrammableLoadComponent : public Component {
   void set_restore_calibration(bool restore) {
     this->restore_calibration_ = restore;
   }
+  // Each load channel persists its calibration under its own key.
+  void set_calibration_preference_key(uint32_t key) {
+    this->calibration_preference_key_ = key;
+  }
+  // Profile that receives the configured coefficients when nothing has been
+  // persisted yet. The string must outlive the component.
+  void set_calibration_profile(const char *profile) {
+    this->calibration_profile_ = profile;
+  }
+  void set_calibration_max_writes_per_hour(uint32_t writes) {
+    this->calibration_store_.set_max_writes_per_hour(writes);
+  }
+  // `profile` selects the named profile to store into; nullptr stores into
+  // the active profile.
   bool apply_calibration(const Calibration &calibration, bool persist,
-                         CalibrationSource source = CalibrationSource::APPLIED);
+                         CalibrationSource source = CalibrationSource::APPLIED,
+                         const char *profile = nullptr);
   bool reset_calibration(bool persist);
+  // Activates a previously stored profile. Idle-only.
+  bool select_calibration_profile(const char *profile);
+  const char *calibration_profile() const;
   const Calibration &calibration() const { return this->calibration_; }
   CalibrationSource calibration_source() const {
     return this->calibration_source_;
@@ -90,6 +125,9 @@ class ProgrammableLoadComponent : public Component {
   void set_calibration_status_sensor(text_sensor::TextSensor *sensor) {
     this->calibration_status_sensor_ = sensor;
   }
+  void set_calibration_profile_sensor(text_sensor::TextSensor *sensor) {
+    this->calibration_profile_sensor_ = sensor;
+  }
   void set_current_scale_sensor(sensor::Sensor *sensor) {
     this->current_scale_sensor_ = sensor;
   }
@@ -131,25 +169,70 @@ class ProgrammableLoadComponent : public Component {
   void set_control_period_ms(uint32_t period_ms) {
     this->control_period_ms_ = period_ms;
   }
-  void set_deadband(float current_a) { this->deadband_a_ = current_a; }
+  void set_deadband(float current_a) {
+    this->control_tuning_.deadband_a = current_a;
+  }
   void set_rise_rate(float current_a_per_s) {
-    this->rise_rate_a_per_s_ = current_a_per_s;
+    this->control_tuning_.rise_rate_a_per_s = current_a_per_s;
   }
   void set_fall_rate(float current_a_per_s) {
-    this->fall_rate_a_per_s_ = current_a_per_s;
+    this->control_tuning_.fall_rate_a_per_s = current_a_per_s;
+  }
+  void set_proportional_gain(float gain) {
+    this->control_tuning_.proportional_gain = gain;
   }
-  void set_proportional_gain(float gain) { this->proportional_gain_ = gain; }
   void set_integral_gain(float gain_per_s) {
-    this->integral_gain_per_s_ = gain_per_s;
+    this->control_tuning_.integral_gain_per_s = gain_per_s;
   }
+  // Control diagnostics are recorded as binary samples and reported once per
+  // second, so observing the loop never formats text at loop rate.
   void set_log_control_samples(bool enabled) {
     this->log_control_samples_ = enabled;
   }
+  void set_log_control_summary(bool enabled) {
+    this->log_control_summary_ = enabled;
+  }
+  void set_control_sample_log_limit(uint32_t samples_per_report) {
+    this->control_sample_log_limit_ = samples_per_report;
+  }
 
   // Cooling policy.
   void set_fan_temperature_range(float start_c, float full_c) {
-    this->fan_start_temperature_c_ = start_c;
-    this->fan_full_temperature_c_ = full_c;
+    this->fan_tuning_.start_temperature_c = start_c;
+    this->fan_tuning_.full_temperature_c = full_c;
+  }
+  void set_fan_target_temperature(float target_c) {
+    this->fan_tuning_.target_temperature_c = target_c;
+  }
+  void set_fan_hysteresis(float hysteresis_c) {
+    this->fan_tuning_.hysteresis_c = hysteresis_c;
+  }
+  void set_fan_gains(float proportional_per_c, float integral_per_c_s) {
+    this->fan_tuning_.proportional_gain_per_c = proportional_per_c;
+    this->fan_tuning_.integral_gain_per_c_s = integral_per_c_s;
+  }
+  void set_fan_minimum_duty(float duty) { this->fan_tuning_.minimum_duty = duty; }
+  void set_fan_kick_start(float duty, uint32_t duration_ms) {
+    this->fan_tuning_.kick_start_duty = duty;
+    this->fan_tuning_.kick_start_ms = duration_ms;
+  }
+  void set_fan_write_threshold(float threshold) {
+    this->fan_tuning_.write_threshold = threshold;
+  }
+
+  // Optional predictive thermal derating of the current limit.
+  void set_thermal_derating(float thermal_resistance_c_per_w,
+                            float time_constant_s, float horizon_s,
+                            float margin_c) {
+    this->thermal_derating_config_.enabled = true;
+    this->thermal_derating_config_.thermal_resistance_c_per_w =
+        thermal_resistance_c_per_w;
+    this->thermal_derating_config_.time_constant_s = time_constant_s;
+    this->thermal_derating_config_.horizon_s = horizon_s;
+    this->thermal_derating_config_.margin_c = margin_c;
+  }
+  void set_thermal_derating_sensor(sensor::Sensor *sensor) {
+    this->thermal_derating_sensor_ = sensor;
   }
 
   // Fault policy. Auto-clear only changes FAULT -> IDLE after the original
@@ -187,7 +270,7 @@ class ProgrammableLoadComponent : public Component {
 
   const Measurement &measurement() const { return this->measurement_; }
   const ChargerMeasurement &charger_measurement() const {
-    return this->charger_measurement_;
+    return this->charger_samples_.measurement();
   }
   const HardwareLimits &hardware_limits() const {
     return this->hardware_limits_;
@@ -204,6 +287,8 @@ class ProgrammableLoadComponent : public Component {
   void reset_control_integrator_();
   void reset_control_history_();
   void update_fan_();
+  float fan_temperature_c_() const;
+  void report_control_diagnostics_();
 
   FaultFlags detect_running_faults_() const;
   bool fault_conditions_active_(FaultFlags faults) const;
@@ -217,11 +302,13 @@ class ProgrammableLoadComponent : public Component {
   void trip_faults_(FaultFlags faults);
   void publish_status_();
   void publish_calibration_();
-  float effective_current_limit_() const;
+  float effective_current_limit_();
+  void report_thermal_derating_();
   void drive_output_(float current_a);
   void force_output_off_();
 
-  bool save_calibration_();
+  bool save_calibration_(const char *profile);
+  void flush_calibration_();
 
   output::FloatOutput *dac_output_{nullptr};
   output::FloatOutput *fan_output_{nullptr};
@@ -234,19 +321,23 @@ class ProgrammableLoadComponent : public Component {
   number::Number *manual_current_number_{nullptr};
   text_sensor::TextSensor *state_sensor_{nullptr};
   text_sensor::TextSensor *fault_sensor_{nullptr};
+  ::component_common::PublishGuard state_guard_{};
+  ::component_common::PublishGuard fault_guard_{};
   text_sensor::TextSensor *calibration_status_sensor_{nullptr};
+  text_sensor::TextSensor *calibration_profile_sensor_{nullptr};
   sensor::Sensor *current_scale_sensor_{nullptr};
   sensor::Sensor *current_offset_sensor_{nullptr};
   sensor::Sensor *voltage_scale_sensor_{nullptr};
   sensor::Sensor *voltage_offset_sensor_{nullptr};
   sensor::Sensor *output_zero_level_sensor_{nullptr};
   sensor::Sensor *output_full_scale_current_sensor_{nullptr};
+  sensor::Sensor *thermal_derating_sensor_{nullptr};
 
   Procedure *active_procedure_{nullptr};
   OperationLock operation_lock_{};
 
   Measurement measurement_{};
-  ChargerMeasurement charger_measurement_{};
+  ChargerSampleTracker charger_samples_{};
   HardwareLimits hardware_limits_{};
   Limits limits_{};
   FaultPolicy fault_policy_{};
@@ -258,9 +349,8 @@ class ProgrammableLoadComponent : public Component {
   CalibrationSource calibration_source_{CalibrationSource::CONFIGURED};
 
   float requested_current_a_{0.0f};
-  float commanded_current_a_{0.0f};
-  float previous_control_error_a_{0.0f};
-  float control_integrator_a_{0.0f};
+  ControlTuning control_tuning_{};
+  ChannelControl control_{};
 
   bool restore_calibration_{true};
   uint32_t sample_timeout_ms_{250};
@@ -270,9 +360,6 @@ class ProgrammableLoadComponent : public Component {
   uint32_t voltage_updated_ms_{0};
   uint32_t measurement_sequence_{0};
   uint32_t current_sequence_{0};
-  uint32_t last_control_current_sequence_{0};
-  uint32_t last_control_current_timestamp_ms_{0};
-  bool control_has_current_sample_{false};
   bool current_seen_{false};
   bool voltage_seen_{false};
 
@@ -286,19 +373,25 @@ class ProgrammableLoadComponent : public Component {
   uint32_t last_control_ms_{0};
   uint32_t last_fan_update_ms_{0};
 
-  float deadband_a_{0.01f};
-  float rise_rate_a_per_s_{2.0f};
-  float fall_rate_a_per_s_{4.0f};
-  float proportional_gain_{0.2f};
-  float integral_gain_per_s_{0.4f};
   bool log_control_samples_{false};
-  float fan_start_temperature_c_{35.0f};
-  float fan_full_temperature_c_{70.0f};
+  bool log_control_summary_{false};
+  uint32_t control_sample_log_limit_{10};
+  uint32_t last_control_report_ms_{0};
+  ControlSummaryAccumulator control_summary_{};
+  ControlSampleBuffer<32> control_samples_{};
+  FanTuning fan_tuning_{};
+  FanController fan_controller_{};
+  ThermalDeratingConfig thermal_derating_config_{};
+  ThermalDerating thermal_derating_{};
+  bool thermal_derating_active_{false};
+  float reported_derating_a_{NAN};
 
   static constexpr uint32_t CALIBRATION_PREFERENCE_KEY = 0x504C4341u;
-  decltype(global_preferences->make_preference<Calibration>(0))
-      calibration_preference_{};
-  bool calibration_preference_valid_{false};
+  uint32_t calibration_preference_key_{CALIBRATION_PREFERENCE_KEY};
+  const char *calibration_profile_{::programmable_load_core::DEFAULT_CALIBRATION_PROFILE};
+  PreferenceCalibrationStorage calibration_storage_{};
+  CalibrationStore calibration_store_{};
+  bool calibration_storage_valid_{false};
 };
 
 class ManualCurrentNumber : public number::Number {
@@ -337,6 +430,7 @@ template<typename... Ts> class ApplyCalibrationAction : public Action<Ts...> {
   TEMPLATABLE_VALUE(float, output_zero_level)
   TEMPLATABLE_VALUE(float, output_full_scale_current)
   TEMPLATABLE_VALUE(bool, persist)
+  TEMPLATABLE_VALUE(std::string, profile)
 
   void set_parent(ProgrammableLoadComponent *parent) { this->parent_ = parent; }
 
@@ -349,7 +443,14 @@ template<typename... Ts> class ApplyCalibrationAction : public Action<Ts...> {
     calibration.output.zero_level = this->output_zero_level_.value(x...);
     calibration.output.full_scale_current_a =
         this->output_full_scale_current_.value(x...);
-    this->parent_->apply_calibration(calibration, this->persist_.value(x...));
+    if (this->profile_.has_value()) {
+      const std::string profile = this->profile_.value(x...);
+      this->parent_->apply_calibration(calibration, this->persist_.value(x...),
+                                       CalibrationSource::APPLIED,
+                                       profile.c_str());
+    } else {
+      this->parent_->apply_calibration(calibration, this->persist_.value(x...));
+    }
   }
 
  protected:
@@ -370,5 +471,21 @@ template<typename... Ts> class ResetCalibrationAction : public Action<Ts...> {
   ProgrammableLoadComponent *parent_{nullptr};
 };
 
+template<typename... Ts>
+class SelectCalibrationProfileAction : public Action<Ts...> {
+ public:
+  TEMPLATABLE_VALUE(std::string, profile)
+
+  void set_parent(ProgrammableLoadComponent *parent) { this->parent_ = parent; }
+
+  void play(Ts... x) override {
+    const std::string profile = this->profile_.value(x...);
+    this->parent_->select_calibration_profile(profile.c_str());
+  }
+
+ protected:
+  ProgrammableLoadComponent *parent_{nullptr};
+};
+
 }  // namespace programmable_load
 }  // namespace esphome
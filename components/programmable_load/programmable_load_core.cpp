@@ -12,6 +12,10 @@ bool finite_positive(float value) {
   return std::isfinite(value) && value > 0.0f;
 }
 
+float clampf(float value, float minimum, float maximum) {
+  return std::max(minimum, std::min(maximum, value));
+}
+
 void append_fault(const char *name, char *buffer, std::size_t size,
                   std::size_t &used, bool &first) {
   if (size == 0 || used >= size - 1) return;
@@ -25,6 +29,40 @@ void append_fault(const char *name, char *buffer, std::size_t size,
 
 }  // namespace
 
+bool ChargerSampleTracker::update(
+    const ::component_common::ChargerInterface *charger, uint32_t now_ms,
+    uint32_t timeout_ms) {
+  if (charger == nullptr) {
+    *this = ChargerSampleTracker{};
+    return false;
+  }
+
+  bool taken = false;
+  if (!this->has_sample_ || charger->has_new_sample(this->sequence_)) {
+    const auto capabilities = charger->capabilities();
+    const ChargerMeasurement &latest = charger->latest_snapshot();
+    this->has_sample_ = true;
+    this->sequence_ = latest.sequence;
+    if (capabilities.enable_control && capabilities.battery_current &&
+        capabilities.battery_voltage && capabilities.charge_state &&
+        capabilities.power_good && capabilities.fault_status) {
+      this->measurement_ = latest;
+      this->sample_valid_ = latest.valid && std::isfinite(latest.current_a) &&
+                            std::isfinite(latest.voltage_v);
+    } else {
+      this->measurement_ = {};
+      this->sample_valid_ = false;
+    }
+    taken = true;
+  }
+
+  const bool fresh = this->measurement_.timestamp_ms != 0 &&
+                     (uint32_t) (now_ms - this->measurement_.timestamp_ms) <=
+                         timeout_ms;
+  this->measurement_.valid = this->sample_valid_ && fresh;
+  return taken;
+}
+
 bool OperationLock::acquire_manual() {
   if (this->owner_ != OperationOwner::NONE) return false;
   this->owner_ = OperationOwner::MANUAL;
@@ -61,6 +99,218 @@ void OperationLock::force_release() {
   this->procedure_ = nullptr;
 }
 
+bool CurrentController::step(const ControlTuning &tuning, float requested_a,
+                             float measured_a, float current_limit_a,
+                             float dt_s, ControlSample *sample) {
+  if (!std::isfinite(this->command_a_) || !std::isfinite(this->integrator_a_))
+    return false;
+
+  const float target = clampf(requested_a, 0.0f, current_limit_a);
+  const float error = target - measured_a;
+  const float bounded_error =
+      std::fabs(error) <= tuning.deadband_a ? 0.0f : error;
+  const float proportional = tuning.proportional_gain * bounded_error;
+  float desired = target + proportional + this->integrator_a_;
+  const bool saturated_low = desired < 0.0f;
+  const bool saturated_high = desired > current_limit_a;
+  if ((!saturated_low && !saturated_high) ||
+      (saturated_low && bounded_error > 0.0f) ||
+      (saturated_high && bounded_error < 0.0f)) {
+    this->integrator_a_ = clampf(
+        this->integrator_a_ + tuning.integral_gain_per_s * bounded_error * dt_s,
+        -current_limit_a, current_limit_a);
+    desired = target + proportional + this->integrator_a_;
+  }
+  desired = clampf(desired, 0.0f, current_limit_a);
+  const float maximum_rise = tuning.rise_rate_a_per_s * dt_s;
+  const float maximum_fall = tuning.fall_rate_a_per_s * dt_s;
+  const float next = clampf(desired, this->command_a_ - maximum_fall,
+                            this->command_a_ + maximum_rise);
+  this->command_a_ = clampf(next, 0.0f, current_limit_a);
+
+  if (sample != nullptr) {
+    sample->dt_s = dt_s;
+    sample->target_a = target;
+    sample->measured_a = measured_a;
+    sample->error_a = error;
+    sample->proportional_a = proportional;
+    sample->integrator_a = this->integrator_a_;
+    sample->command_a = this->command_a_;
+  }
+  return true;
+}
+
+void CurrentController::reset() {
+  this->command_a_ = 0.0f;
+  this->integrator_a_ = 0.0f;
+}
+
+ControlTick ChannelControl::tick(const ControlTuning &tuning,
+                                 const ControlTickInput &input,
+                                 ControlSample *sample) {
+  if (input.charger_active) {
+    this->reset(input.current_sequence, input.current_timestamp_ms);
+    if (input.charger_control_mismatch)
+      return {ControlAction::TRIP, Fault::CHARGER_CONTROL_ERROR};
+    return {ControlAction::OUTPUT_OFF, Fault::NONE};
+  }
+  if (input.charger_control_mismatch)
+    return {ControlAction::TRIP, Fault::CHARGER_CONTROL_ERROR};
+  if (!std::isfinite(input.current_limit_a) || input.current_limit_a < 0.0f ||
+      !input.measured_valid) {
+    return {ControlAction::TRIP, Fault::CONTROL_ERROR};
+  }
+  if (this->has_sample_ && input.current_sequence == this->last_sequence_)
+    return {};
+
+  const float dt_s =
+      this->has_sample_
+          ? static_cast<float>(input.current_timestamp_ms - this->last_timestamp_ms_) / 1000.0f
+          : static_cast<float>(input.control_period_ms) / 1000.0f;
+  this->last_sequence_ = input.current_sequence;
+  this->last_timestamp_ms_ = input.current_timestamp_ms;
+  this->has_sample_ = true;
+  if (!std::isfinite(dt_s) || dt_s <= 0.0f || dt_s > 1.0f) return {};
+
+  if (sample != nullptr) {
+    sample->sequence = input.current_sequence;
+    sample->timestamp_ms = input.current_timestamp_ms;
+  }
+  if (!this->controller_.step(tuning, input.requested_a, input.measured_a,
+                              input.current_limit_a, dt_s, sample)) {
+    return {ControlAction::TRIP, Fault::CONTROL_ERROR};
+  }
+  return {ControlAction::DRIVE, Fault::NONE};
+}
+
+void ChannelControl::reset(uint32_t current_sequence,
+                           uint32_t current_timestamp_ms) {
+  this->controller_.reset();
+  this->reset_integrator(current_sequence, current_timestamp_ms);
+}
+
+void ChannelControl::reset_integrator(uint32_t current_sequence,
+                                      uint32_t current_timestamp_ms) {
+  this->controller_.reset_integrator();
+  this->has_sample_ = true;
+  this->last_sequence_ = current_sequence;
+  this->last_timestamp_ms_ = current_timestamp_ms;
+}
+
+bool FanController::update(const FanTuning &tuning, float temperature_c,
+                           float fallback_level, uint32_t now_ms,
+                           float dt_s) {
+  if (!std::isfinite(temperature_c)) {
+    this->running_ = fallback_level > 0.0f;
+    this->kicking_ = false;
+    this->integrator_ = 0.0f;
+    this->level_ = clampf(fallback_level, 0.0f, 1.0f);
+  } else {
+    if (!this->running_ && temperature_c >= tuning.start_temperature_c) {
+      this->running_ = true;
+      this->kicking_ = tuning.kick_start_ms != 0 &&
+                       tuning.kick_start_duty > tuning.minimum_duty;
+      this->kick_started_ms_ = now_ms;
+      this->integrator_ = 0.0f;
+    } else if (this->running_ &&
+               temperature_c <=
+                   tuning.start_temperature_c - tuning.hysteresis_c) {
+      this->running_ = false;
+      this->kicking_ = false;
+      this->integrator_ = 0.0f;
+    }
+    this->level_ = this->running_
+                       ? this->regulate_(tuning, temperature_c, dt_s)
+                       : 0.0f;
+    if (this->kicking_) {
+      if ((uint32_t) (now_ms - this->kick_started_ms_) < tuning.kick_start_ms) {
+        this->level_ = std::max(this->level_, tuning.kick_start_duty);
+      } else {
+        this->kicking_ = false;
+      }
+    }
+  }
+
+  const bool endpoint = this->level_ <= 0.0f || this->level_ >= 1.0f;
+  const float change = std::fabs(this->level_ - this->written_level_);
+  if (this->written_ &&
+      (endpoint ? change == 0.0f : change < tuning.write_threshold)) {
+    return false;
+  }
+  this->written_ = true;
+  this->written_level_ = this->level_;
+  this->writes_++;
+  return true;
+}
+
+float FanController::regulate_(const FanTuning &tuning, float temperature_c,
+                               float dt_s) {
+  if (temperature_c >= tuning.full_temperature_c) return 1.0f;
+  const float error = temperature_c - tuning.target_temperature_c;
+  const float proportional = tuning.proportional_gain_per_c * error;
+  const float desired = proportional + this->integrator_;
+  // Conditional integration: hold the integrator while the duty is pinned at
+  // a limit and the error would push it further into that limit.
+  const bool saturated_high = desired >= 1.0f && error > 0.0f;
+  const bool saturated_low = desired <= tuning.minimum_duty && error < 0.0f;
+  if (!saturated_high && !saturated_low) {
+    this->integrator_ = clampf(
+        this->integrator_ + tuning.integral_gain_per_c_s * error * dt_s, 0.0f,
+        1.0f);
+  }
+  return clampf(proportional + this->integrator_, tuning.minimum_duty, 1.0f);
+}
+
+void FanController::reset() {
+  this->running_ = false;
+  this->kicking_ = false;
+  this->written_ = false;
+  this->integrator_ = 0.0f;
+  this->level_ = 0.0f;
+  this->written_level_ = 0.0f;
+}
+
+void ControlSummaryAccumulator::add(const ControlSample &sample) {
+  const bool first = this->samples_ == 0;
+  add_value_(this->error_a_, sample.error_a, first);
+  add_value_(this->command_a_, sample.command_a, first);
+  add_value_(this->integrator_a_, sample.integrator_a, first);
+  add_value_(this->dt_s_, sample.dt_s, first);
+  this->dt_square_sum_ +=
+      static_cast<double>(sample.dt_s) * static_cast<double>(sample.dt_s);
+  this->samples_++;
+}
+
+ControlSummary ControlSummaryAccumulator::take() {
+  ControlSummary summary{};
+  summary.samples = this->samples_;
+  if (this->samples_ != 0) {
+    summary.error_a = statistic_(this->error_a_, this->samples_);
+    summary.command_a = statistic_(this->command_a_, this->samples_);
+    summary.integrator_a = statistic_(this->integrator_a_, this->samples_);
+    summary.dt_s = statistic_(this->dt_s_, this->samples_);
+    const double mean = this->dt_s_.sum / this->samples_;
+    const double variance = this->dt_square_sum_ / this->samples_ - mean * mean;
+    summary.dt_jitter_s =
+        variance > 0.0 ? static_cast<float>(std::sqrt(variance)) : 0.0f;
+  }
+  *this = ControlSummaryAccumulator{};
+  return summary;
+}
+
+void ControlSummaryAccumulator::add_value_(Range &range, float value,
+                                           bool first) {
+  if (first || value < range.minimum) range.minimum = value;
+  if (first || value > range.maximum) range.maximum = value;
+  range.sum += value;
+}
+
+ControlStatistic ControlSummaryAccumulator::statistic_(const Range &range,
+                                                       uint32_t samples) {
+  return {range.minimum, range.maximum,
+          static_cast<float>(range.sum / samples)};
+}
+
 const char *state_to_string(State state) {
   switch (state) {
     case State::IDLE: return "idle";
@@ -160,6 +410,66 @@ float effective_current_limit(const Measurement &measurement,
   return std::max(0.0f, limit);
 }
 
+void ThermalDerating::update(const ThermalDeratingConfig &config,
+                             const Measurement &measurement,
+                             const Limits &limits, float dt_s) {
+  this->allowed_power_valid_ = false;
+  if (!config.enabled || !finite_positive(config.thermal_resistance_c_per_w) ||
+      !finite_positive(config.time_constant_s) || !std::isfinite(dt_s) ||
+      dt_s <= 0.0f) {
+    return;
+  }
+  const float power_w =
+      measurement.current_valid && measurement.voltage_valid &&
+              std::isfinite(measurement.power_w)
+          ? std::fabs(measurement.power_w)
+          : 0.0f;
+  const float settled_rise_c = config.thermal_resistance_c_per_w * power_w;
+  this->rise_c_ += (settled_rise_c - this->rise_c_) *
+                   (1.0f - std::exp(-dt_s / config.time_constant_s));
+  if (!std::isfinite(this->rise_c_)) this->rise_c_ = 0.0f;
+  if (!std::isfinite(measurement.maximum_temperature_c)) return;
+
+  // Ambient is estimated as measured temperature minus modelled rise, so
+  //   T(h) = T + (R * P - rise) * (1 - exp(-h / tau)).
+  // Solving T(h) = threshold for P gives the allowed dissipation. Once the
+  // load settles at that power the measured temperature converges on the
+  // threshold even when R and tau are only approximate.
+  const float threshold_c = limits.maximum_temperature_c - config.margin_c;
+  const float approach =
+      1.0f - std::exp(-std::max(config.horizon_s, 0.0f) /
+                      config.time_constant_s);
+  if (approach <= 0.0f) return;
+  const float allowed_w =
+      (threshold_c - measurement.maximum_temperature_c) /
+          (config.thermal_resistance_c_per_w * approach) +
+      this->rise_c_ / config.thermal_resistance_c_per_w;
+  if (!std::isfinite(allowed_w)) return;
+  this->allowed_power_w_ = std::max(0.0f, allowed_w);
+  this->allowed_power_valid_ = true;
+}
+
+float ThermalDerating::apply(const ThermalDeratingConfig &config,
+                             const Measurement &measurement,
+                             float static_limit_a) {
+  this->derating_a_ = 0.0f;
+  if (!config.enabled || !this->allowed_power_valid_ ||
+      !measurement.voltage_valid || measurement.voltage_v <= 0.0f) {
+    return static_limit_a;
+  }
+  const float limit = std::min(
+      static_limit_a, this->allowed_power_w_ / std::fabs(measurement.voltage_v));
+  this->derating_a_ = static_limit_a - limit;
+  return limit;
+}
+
+void ThermalDerating::reset() {
+  this->rise_c_ = 0.0f;
+  this->allowed_power_w_ = 0.0f;
+  this->derating_a_ = 0.0f;
+  this->allowed_power_valid_ = false;
+}
+
 FaultFlags detect_safety_faults(const Measurement &measurement,
                                 const HardwareLimits &hardware_limits,
                                 const Limits &limits, float current_deadband_a,
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 
@@ -107,6 +108,24 @@ struct ProcedureContext {
   ChargerMeasurement charger{};
 };
 
+// Follows a charger's published snapshot by sequence number. The snapshot is
+// copied only when the charger published a new one; freshness against the
+// sample timestamp is re-evaluated on every call.
+class ChargerSampleTracker {
+ public:
+  // Returns true when a new sample was taken. A charger without the
+  // capabilities the load needs yields an invalid measurement.
+  bool update(const ::component_common::ChargerInterface *charger,
+              uint32_t now_ms, uint32_t timeout_ms);
+  const ChargerMeasurement &measurement() const { return this->measurement_; }
+
+ protected:
+  ChargerMeasurement measurement_{};
+  uint32_t sequence_{0};
+  bool has_sample_{false};
+  bool sample_valid_{false};
+};
+
 struct HardwareLimits {
   // Board-specific limit, additionally capped by
   // ABSOLUTE_MAXIMUM_VOLTAGE_V inside the core.
@@ -133,6 +152,278 @@ struct ProcedureResult {
   ChargerCommand charger_command{ChargerCommand::DISABLE};
 };
 
+struct ThermalDeratingConfig {
+  bool enabled{false};
+  // Heatsink-to-ambient resistance and time constant of the first-order
+  // model. Estimates need not be exact: the hottest measured temperature
+  // corrects the prediction every step.
+  float thermal_resistance_c_per_w{0.0f};
+  float time_constant_s{0.0f};
+  // How far ahead the trajectory is predicted, and how far below
+  // limits.maximum_temperature_c the prediction is held.
+  float horizon_s{60.0f};
+  float margin_c{5.0f};
+};
+
+// Predictive thermal derating. The model tracks the heatsink rise above
+// ambient driven by measured dissipation (V * I); the allowed power is the
+// constant dissipation whose predicted temperature at the horizon stays at the
+// derating threshold. Each load channel owns one instance.
+class ThermalDerating {
+ public:
+  void update(const ThermalDeratingConfig &config,
+              const Measurement &measurement, const Limits &limits,
+              float dt_s);
+  // Returns `static_limit_a` reduced to the allowed dissipation at the
+  // measured voltage and records the reduction.
+  float apply(const ThermalDeratingConfig &config,
+              const Measurement &measurement, float static_limit_a);
+  void reset();
+  float rise_c() const { return this->rise_c_; }
+  float allowed_power_w() const { return this->allowed_power_w_; }
+  // Most recent reduction below the static current limit, in amperes.
+  float derating_a() const { return this->derating_a_; }
+
+ protected:
+  float rise_c_{0.0f};
+  float allowed_power_w_{0.0f};
+  float derating_a_{0.0f};
+  bool allowed_power_valid_{false};
+};
+
+// One binary control-loop record. Recording a sample is a fixed-size copy so
+// diagnostics never format text inside the control path.
+struct ControlSample {
+  uint32_t sequence{0};
+  uint32_t timestamp_ms{0};
+  float dt_s{0.0f};
+  float target_a{0.0f};
+  float measured_a{0.0f};
+  float error_a{0.0f};
+  float proportional_a{0.0f};
+  float integrator_a{0.0f};
+  float command_a{0.0f};
+};
+
+struct ControlTuning {
+  float deadband_a{0.01f};
+  float rise_rate_a_per_s{2.0f};
+  float fall_rate_a_per_s{4.0f};
+  float proportional_gain{0.2f};
+  float integral_gain_per_s{0.4f};
+};
+
+// Feed-forward PI current controller with conditional integration and
+// slew-rate limiting. Each load channel owns one instance, so channels share
+// no controller state.
+class CurrentController {
+ public:
+  // Advances the controller by one distinct current sample. Returns false when
+  // the controller state is no longer finite; the caller must trip a control
+  // error. `sample` receives the binary diagnostic record of the step.
+  bool step(const ControlTuning &tuning, float requested_a, float measured_a,
+            float current_limit_a, float dt_s, ControlSample *sample);
+  void reset();
+  void reset_integrator() { this->integrator_a_ = 0.0f; }
+  float command_a() const { return this->command_a_; }
+  float integrator_a() const { return this->integrator_a_; }
+
+ protected:
+  float command_a_{0.0f};
+  float integrator_a_{0.0f};
+};
+
+// Inputs of one control tick, gathered by the component from its sensors,
+// limits and charger.
+struct ControlTickInput {
+  float requested_a{0.0f};
+  float measured_a{0.0f};
+  bool measured_valid{false};
+  // Ignored while a charger is active or mismatched.
+  float current_limit_a{0.0f};
+  // Sequence number and arrival time of the newest current sample.
+  uint32_t current_sequence{0};
+  uint32_t current_timestamp_ms{0};
+  // Step length assumed for the first sample after a reset.
+  uint32_t control_period_ms{0};
+  // The charger is commanded or reported enabled.
+  bool charger_active{false};
+  bool charger_control_mismatch{false};
+};
+
+enum class ControlAction : uint8_t {
+  // No new current sample; the output keeps its level.
+  HOLD = 0,
+  // Drive the output at command_a().
+  DRIVE,
+  // A charger owns the channel; the output must be off.
+  OUTPUT_OFF,
+  // Trip `fault`; the output must be off.
+  TRIP,
+};
+
+struct ControlTick {
+  ControlAction action{ControlAction::HOLD};
+  Fault fault{Fault::NONE};
+};
+
+// The per-channel control step run by the component loop: the charger
+// interlock, limit and sample checks, then one PI step for each distinct
+// current sample. Each load channel owns one instance.
+class ChannelControl {
+ public:
+  // `sample`, when not null, receives the diagnostic record of a DRIVE tick.
+  ControlTick tick(const ControlTuning &tuning, const ControlTickInput &input,
+                   ControlSample *sample);
+  // Restarts the controller. The current sample present at the reset is not
+  // reused; the next step waits for a newer one.
+  void reset(uint32_t current_sequence, uint32_t current_timestamp_ms);
+  void reset_integrator(uint32_t current_sequence,
+                        uint32_t current_timestamp_ms);
+  float command_a() const { return this->controller_.command_a(); }
+  const CurrentController &controller() const { return this->controller_; }
+
+ protected:
+  CurrentController controller_{};
+  uint32_t last_sequence_{0};
+  uint32_t last_timestamp_ms_{0};
+  bool has_sample_{false};
+};
+
+struct FanTuning {
+  // The fan switches on at the start temperature and off again once the
+  // regulated temperature falls hysteresis_c below it.
+  float start_temperature_c{35.0f};
+  // At or above this temperature the fan runs at full duty regardless of the
+  // PI state.
+  float full_temperature_c{70.0f};
+  float target_temperature_c{52.5f};
+  float hysteresis_c{3.0f};
+  float proportional_gain_per_c{0.05f};
+  float integral_gain_per_c_s{0.004f};
+  // Lowest duty that keeps the fan turning once it has started.
+  float minimum_duty{0.2f};
+  float kick_start_duty{1.0f};
+  uint32_t kick_start_ms{1000};
+  // Smallest level change worth an output write. Changes to fully off or
+  // fully on are always written.
+  float write_threshold{0.02f};
+};
+
+// PI regulator that holds the hottest temperature input at a target using the
+// fan. Each load channel owns one instance.
+class FanController {
+ public:
+  // Advances the controller by one fan period. A non-finite temperature means
+  // the regulated input is unavailable; `fallback_level` is then driven
+  // directly. Returns true when level() must be written to the output.
+  bool update(const FanTuning &tuning, float temperature_c,
+              float fallback_level, uint32_t now_ms, float dt_s);
+  void reset();
+  bool running() const { return this->running_; }
+  float level() const { return this->level_; }
+  float integrator() const { return this->integrator_; }
+  uint32_t writes() const { return this->writes_; }
+
+ protected:
+  float regulate_(const FanTuning &tuning, float temperature_c, float dt_s);
+
+  bool running_{false};
+  bool kicking_{false};
+  bool written_{false};
+  uint32_t kick_started_ms_{0};
+  uint32_t writes_{0};
+  float integrator_{0.0f};
+  float level_{0.0f};
+  float written_level_{0.0f};
+};
+
+struct ControlStatistic {
+  float minimum{0.0f};
+  float maximum{0.0f};
+  float mean{0.0f};
+};
+
+struct ControlSummary {
+  uint32_t samples{0};
+  ControlStatistic error_a{};
+  ControlStatistic command_a{};
+  ControlStatistic integrator_a{};
+  ControlStatistic dt_s{};
+  // Standard deviation of the sample interval within the window.
+  float dt_jitter_s{0.0f};
+};
+
+// Accumulates min/max/mean over one reporting window in O(1) per sample.
+class ControlSummaryAccumulator {
+ public:
+  void add(const ControlSample &sample);
+  // Returns the completed window and starts a new one.
+  ControlSummary take();
+  uint32_t samples() const { return this->samples_; }
+
+ protected:
+  struct Range {
+    float minimum{0.0f};
+    float maximum{0.0f};
+    double sum{0.0};
+  };
+  static void add_value_(Range &range, float value, bool first);
+  static ControlStatistic statistic_(const Range &range, uint32_t samples);
+
+  uint32_t samples_{0};
+  Range error_a_{};
+  Range command_a_{};
+  Range integrator_a_{};
+  Range dt_s_{};
+  double dt_square_sum_{0.0};
+};
+
+// Single-producer/single-consumer ring of binary control samples. The control
+// loop pushes and never blocks; when the reader falls behind, new samples are
+// dropped and counted rather than stalling or overwriting a sample in use.
+template<std::size_t Capacity> class ControlSampleBuffer {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "capacity must be a power of two");
+
+ public:
+  bool push(const ControlSample &sample) {
+    const uint32_t head = this->head_.load(std::memory_order_relaxed);
+    const uint32_t tail = this->tail_.load(std::memory_order_acquire);
+    if (head - tail >= Capacity) {
+      this->dropped_.fetch_add(1u, std::memory_order_relaxed);
+      return false;
+    }
+    this->samples_[head & (Capacity - 1)] = sample;
+    this->head_.store(head + 1u, std::memory_order_release);
+    return true;
+  }
+
+  bool pop(ControlSample *sample) {
+    const uint32_t tail = this->tail_.load(std::memory_order_relaxed);
+    const uint32_t head = this->head_.load(std::memory_order_acquire);
+    if (head == tail) return false;
+    *sample = this->samples_[tail & (Capacity - 1)];
+    this->tail_.store(tail + 1u, std::memory_order_release);
+    return true;
+  }
+
+  std::size_t size() const {
+    return this->head_.load(std::memory_order_acquire) -
+           this->tail_.load(std::memory_order_acquire);
+  }
+  uint32_t take_dropped() {
+    return this->dropped_.exchange(0u, std::memory_order_relaxed);
+  }
+  static constexpr std::size_t capacity() { return Capacity; }
+
+ protected:
+  ControlSample samples_[Capacity]{};
+  std::atomic<uint32_t> head_{0};
+  std::atomic<uint32_t> tail_{0};
+  std::atomic<uint32_t> dropped_{0};
+};
+
 const char *state_to_string(State state);
 const char *fault_to_string(Fault fault);
 const char *calibration_source_to_string(CalibrationSource source);
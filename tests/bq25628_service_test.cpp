@@ -1,34 +1,65 @@
 #include <array>
 #include <cassert>
 #include <cstddef>
+#include <cmath>
 #include <cstdint>
 #include <cstring>
+#include <string_view>
 
 #include "components/bq25628/bq25628_service.h"
 
 namespace {
 
+using bq25628_core::RegisterId;
+using bq25628_core::register_address;
+
 class FakeBus : public bq25628_core::RegisterBus {
  public:
   bool read_registers(uint8_t reg, uint8_t *data, size_t len) override {
+    ++read_count;
+    last_read_len = len;
     if (fail_reads || static_cast<size_t>(reg) + len > registers.size())
       return false;
     std::memcpy(data, registers.data() + reg, len);
+    // The flag registers REG0x20..0x22 clear on read.
+    for (size_t address = reg; address < static_cast<size_t>(reg) + len; address++) {
+      if (address >= register_address(RegisterId::CHARGER_FLAG_0) &&
+          address <= register_address(RegisterId::FAULT_FLAG_0))
+        registers[address] = 0;
+    }
     return true;
   }
 
   bool write_registers(uint8_t reg, const uint8_t *data, size_t len) override {
+    ++write_count;
     if (fail_writes || static_cast<size_t>(reg) + len > registers.size())
       return false;
     std::memcpy(registers.data() + reg, data, len);
     return true;
   }
 
+  size_t transactions() const { return read_count + write_count; }
+
   std::array<uint8_t, 256> registers{};
+  size_t read_count{0};
+  size_t last_read_len{0};
+  size_t write_count{0};
   bool fail_reads{false};
   bool fail_writes{false};
 };
 
+void write_u16(FakeBus &bus, RegisterId id, uint16_t value) {
+  bq25628_core::store_register_u16(value, bus.registers.data() + register_address(id));
+}
+
+uint16_t read_u16(const FakeBus &bus, RegisterId id) {
+  return bq25628_core::load_register_u16(bus.registers.data() + register_address(id));
+}
+
+uint8_t &reg(FakeBus &bus, RegisterId id) { return bus.registers[register_address(id)]; }
+
+bool near(float a, float b, float tolerance = 0.001f) { return std::fabs(a - b) < tolerance; }
+
 void test_register_manifest() {
   static_assert(bq25628_core::REGISTER_COUNT == 36);
   static_assert(bq25628_core::register_definitions_have_all_ids_once());
@@ -71,10 +102,238 @@ void test_battery_voltage_decode() {
   assert(voltage_v > 4.178f && voltage_v < 4.180f);
 }
 
+void test_status_decode_and_snapshot() {
+  FakeBus bus;
+  bq25628_core::Bq25628Service service(&bus);
+  namespace fields = bq25628_core::fields;
+
+  // Charging enabled, adapter present, taper, no faults.
+  reg(bus, RegisterId::CHARGER_CONTROL_0) = fields::ChargeEnable::encode(1);
+  reg(bus, RegisterId::CHARGER_STATUS_1) = fields::ChargeStatus::encode(2) | fields::VbusStatus::encode(4);
+  reg(bus, RegisterId::CHARGER_FLAG_1) = fields::ChargeStatusChanged::encode(1);
+
+  bq25628_core::Status status{};
+  assert(service.read_status(status));
+  assert(bus.read_count == 1 && bus.last_read_len == 13);
+  assert(bq25628_core::decode_charge_status(status) == bq25628_core::ChargeStatus::TAPER);
+  assert(bq25628_core::charge_enabled(status) && bq25628_core::power_good(status));
+  assert(bq25628_core::status_flags_set(status));
+  assert(bq25628_core::decode_charger_state(status) == component_common::ChargerState::TAPER_CV);
+  // The flags cleared on read.
+  assert(service.read_status(status));
+  assert(!bq25628_core::status_flags_set(status));
+
+  // Not charging while enabled with good input is termination.
+  reg(bus, RegisterId::CHARGER_STATUS_1) = fields::VbusStatus::encode(4);
+  assert(service.read_status(status));
+  assert(bq25628_core::decode_charger_state(status) == component_common::ChargerState::TERMINATION_DONE);
+  reg(bus, RegisterId::CHARGER_CONTROL_0) = 0;
+  assert(service.read_status(status));
+  assert(bq25628_core::decode_charger_state(status) == component_common::ChargerState::NOT_CHARGING);
+
+  char text[64];
+  assert(bq25628_core::format_faults(status, text, sizeof(text)) == 4);
+  assert(std::string_view(text) == "none");
+
+  // A VBUS fault drops power good; a cold TS suspends charging.
+  reg(bus, RegisterId::FAULT_STATUS_0) = fields::VbusFault::encode(1) | fields::TsStatus::encode(1);
+  assert(service.read_status(status));
+  assert(!bq25628_core::power_good(status));
+  assert(bq25628_core::charger_fault_active(status));
+  bq25628_core::format_faults(status, text, sizeof(text));
+  assert(std::string_view(text) == "vbus_overvoltage,ts_cold");
+  assert(bq25628_core::format_faults(status, text, 10) == 0);
+  assert(std::string_view(bq25628_core::ts_status_to_string(bq25628_core::decode_ts_status(status))) == "cold");
+
+  bq25628_core::Measurements measurements{};
+  measurements.vbat_v = 3.9f;
+  measurements.ibat_a = 0.5f;
+  // The ADC byte order is unconfirmed, so the snapshot carries status but is
+  // never a valid measurement. Confirming the order means flipping the flag
+  // and pinning the datasheet order in test_battery_voltage_decode.
+  static_assert(!bq25628_core::REGISTER_U16_BYTE_ORDER_CONFIRMED);
+  const auto snapshot = bq25628_core::make_charger_snapshot(status, measurements, 1234);
+  assert(!snapshot.valid && snapshot.fault_active && !snapshot.power_good && !snapshot.enabled);
+  assert(snapshot.timestamp_ms == 1234 && near(snapshot.voltage_v, 3.9f));
+  measurements.ibat_a = NAN;
+  assert(!bq25628_core::make_charger_snapshot(status, measurements, 1234).valid);
+}
+
+void test_measurement_block_decode() {
+  FakeBus bus;
+  bq25628_core::Bq25628Service service(&bus);
+
+  write_u16(bus, RegisterId::IBUS_ADC, static_cast<uint16_t>(750 << 1));     // 1.5 A
+  write_u16(bus, RegisterId::IBAT_ADC, static_cast<uint16_t>(-250 * 2));     // -0.5 A
+  write_u16(bus, RegisterId::VBUS_ADC, static_cast<uint16_t>(1260 << 1));    // 5.0 V
+  write_u16(bus, RegisterId::VPMID_ADC, static_cast<uint16_t>(1250 << 1));
+  write_u16(bus, RegisterId::VBAT_ADC, static_cast<uint16_t>(2100 << 1));
+  write_u16(bus, RegisterId::VSYS_ADC, static_cast<uint16_t>(1900 << 1));
+  write_u16(bus, RegisterId::TS_ADC, 520);
+  write_u16(bus, RegisterId::TDIE_ADC, 0x0FF6);  // -5 C
+
+  bq25628_core::Measurements measurements{};
+  assert(service.read_measurements(measurements));
+  assert(bus.read_count == 1 && bus.last_read_len == 16);
+  assert(near(measurements.ibus_a, 1.5f));
+  assert(near(measurements.ibat_a, -0.5f));
+  assert(near(measurements.vbus_v, 5.002f));
+  assert(near(measurements.vbat_v, 4.179f));
+  assert(near(measurements.vsys_v, 3.781f));
+  assert(near(measurements.ts_percent, 49.972f));
+  assert(near(measurements.tdie_c, -5.0f));
+
+  bus.fail_reads = true;
+  assert(!service.read_measurements(measurements));
+}
+
+void test_limit_encoding() {
+  namespace fields = bq25628_core::fields;
+  assert(fields::ChargeCurrentLimit::decode(bq25628_core::encode_charge_current_limit_ma(1000)) == 25);
+  assert(fields::ChargeCurrentLimit::decode(bq25628_core::encode_charge_current_limit_ma(5000)) == 50);
+  assert(fields::ChargeVoltageLimit::decode(bq25628_core::encode_charge_voltage_limit_mv(4200)) == 420);
+  assert(fields::InputCurrentLimit::decode(bq25628_core::encode_input_current_limit_ma(1500)) == 75);
+  assert(fields::InputVoltageLimit::decode(bq25628_core::encode_input_voltage_limit_mv(4400)) == 110);
+  assert(fields::InputVoltageLimit::decode(bq25628_core::encode_input_voltage_limit_mv(1000)) == 95);
+}
+
+// Setup reads the charger once, reconciles once, then costs nothing per poll
+// until the watchdog may have reset the registers.
+void test_configuration_transaction_budget() {
+  FakeBus bus;
+  bq25628_core::Bq25628Service service(&bus);
+  namespace fields = bq25628_core::fields;
+  write_u16(bus, RegisterId::CHARGE_VOLTAGE_LIMIT, bq25628_core::encode_charge_voltage_limit_mv(4200));
+  reg(bus, RegisterId::CHARGER_CONTROL_0) = fields::ChargeEnable::encode(1) | fields::Watchdog::encode(1);
+  reg(bus, RegisterId::TERMINATION_CONTROL) = 0x53;
+  // Reserved addresses in the gaps must never be touched.
+  bus.registers[0x0A] = 0xA5;
+  bus.registers[0x11] = 0xA5;
+
+  bq25628_core::Bq25628RegisterConfig config{};
+  assert(service.read_register_config(config));
+  assert(bus.read_count == 5 && bus.write_count == 0);
+  assert(config.charge_voltage_limit == bq25628_core::encode_charge_voltage_limit_mv(4200));
+  assert(config.termination_control == 0x53);
+
+  config.charger_control_0 = fields::Watchdog::replace(config.charger_control_0, 0);
+  config.adc_control = fields::AdcEnable::replace(config.adc_control, 1);
+  const auto image = bq25628_core::make_register_config_image(config);
+
+  // Two mismatched runs: a write and a verify read each after the first pass.
+  bq25628_core::ConfigurationReconcileResult result{};
+  size_t before = bus.transactions();
+  assert(service.ensure_configuration(image, result));
+  assert(bus.transactions() - before == 5 + 2 + 2);
+  assert(result.mismatch_count == 2 && result.repaired_count == 2 && result.repaired);
+  assert(result.read_only_mismatch_count == 0);
+  assert(result.desired_fingerprint == result.observed_fingerprint);
+  // Runtime EN_CHG survived the rewrite, and the WD_RST command was not sent.
+  assert(reg(bus, RegisterId::CHARGER_CONTROL_0) == fields::ChargeEnable::encode(1));
+  assert(bus.registers[0x0A] == 0xA5 && bus.registers[0x11] == 0xA5);
+
+  // Verified: steady-state polls spend two reads and no configuration I/O.
+  for (int i = 0; i < 5; i++) {
+    before = bus.transactions();
+    bq25628_core::Status status{};
+    bq25628_core::Measurements measurements{};
+    assert(service.read_status(status));
+    assert(service.ensure_configuration(image, result));
+    assert(result.skipped);
+    assert(service.read_measurements(measurements));
+    assert(bus.transactions() - before == 2);
+  }
+
+  // Charge enable is runtime state: toggling it is not drift.
+  before = bus.transactions();
+  assert(service.set_charge_enabled(false));
+  assert(bus.transactions() - before == 2);
+  assert(service.set_charge_enabled(false));
+  assert(bus.transactions() - before == 3);
+  service.invalidate_configuration();
+  assert(service.reconcile_configuration(image, false, result));
+  assert(result.mismatch_count == 0);
+
+  // A watchdog expiry flag means reset defaults: the next ensure reconciles.
+  reg(bus, RegisterId::CHARGER_FLAG_0) = fields::WatchdogExpired::encode(1);
+  reg(bus, RegisterId::CHARGER_CONTROL_0) = fields::Watchdog::encode(1);
+  bq25628_core::Status status{};
+  assert(service.read_status(status));
+  assert(!service.configuration_verified());
+  before = bus.transactions();
+  assert(service.ensure_configuration(image, result));
+  assert(!result.skipped && result.repaired_count == 1);
+  assert(bus.transactions() - before == 5 + 1 + 1);
+
+  // A changed image has a new fingerprint and is reconciled at once.
+  config.termination_control = 0x13;
+  const auto changed = bq25628_core::make_register_config_image(config);
+  assert(component_common::configuration_fingerprint(changed) != component_common::configuration_fingerprint(image));
+  assert(service.ensure_configuration(changed, result));
+  assert(!result.skipped && result.repaired_count == 1);
+
+  bus.fail_writes = true;
+  assert(!service.ensure_configuration(image, result));
+  assert(!result.io_ok && !service.configuration_verified());
+}
+
+// The 16-bit byte order is unconfirmed, so a limit that differs from the
+// image is reported but never written, even when its run is rewritten.
+void test_limit_registers_are_read_only() {
+  FakeBus bus;
+  bq25628_core::Bq25628Service service(&bus);
+  bus.registers[0x04] = 0x12;
+  bus.registers[0x05] = 0x34;
+  bus.registers[0x0E] = 0x56;
+  bus.registers[0x0F] = 0x78;
+
+  bq25628_core::Bq25628RegisterConfig config{};
+  assert(service.read_register_config(config));
+  assert(config.charge_voltage_limit == read_u16(bus, RegisterId::CHARGE_VOLTAGE_LIMIT));
+  config.charge_voltage_limit = bq25628_core::encode_charge_voltage_limit_mv(4400);
+  config.minimal_system_voltage ^= 0x0FC0;
+  config.precharge_control = 0x48;  // shares the REG0x0E run
+  const auto image = bq25628_core::make_register_config_image(config);
+
+  bq25628_core::ConfigurationReconcileResult result{};
+  const size_t before = bus.transactions();
+  assert(service.ensure_configuration(image, result));
+  assert(bus.transactions() - before == 5 + 1 + 1);
+  assert(result.mismatch_count == 1 && result.repaired_count == 1);
+  assert(result.read_only_mismatch_count == 2 && result.remaining_mismatch_count == 0);
+  assert(result.first_mismatch_address == register_address(RegisterId::PRECHARGE_CONTROL));
+  assert(result.desired_fingerprint != result.observed_fingerprint);
+  // The limit bytes are exactly as the charger held them.
+  assert(bus.registers[0x04] == 0x12 && bus.registers[0x05] == 0x34);
+  assert(bus.registers[0x0E] == 0x56 && bus.registers[0x0F] == 0x78);
+  assert(reg(bus, RegisterId::PRECHARGE_CONTROL) == 0x48);
+}
+
+void test_watchdog_reset_uses_status_read() {
+  FakeBus bus;
+  bq25628_core::Bq25628Service service(&bus);
+  namespace fields = bq25628_core::fields;
+  reg(bus, RegisterId::CHARGER_CONTROL_0) = fields::ChargeEnable::encode(1) | fields::Watchdog::encode(1);
+
+  bq25628_core::Status status{};
+  assert(service.read_status(status));
+  const size_t before = bus.transactions();
+  assert(service.reset_watchdog());
+  assert(bus.transactions() - before == 1);
+  assert(reg(bus, RegisterId::CHARGER_CONTROL_0) ==
+         (fields::ChargeEnable::encode(1) | fields::Watchdog::encode(1) | fields::WatchdogReset::encode(1)));
+}
+
 }  // namespace
 
 int main() {
   test_register_manifest();
   test_probe_and_adc_enable();
   test_battery_voltage_decode();
+  test_status_decode_and_snapshot();
+  test_measurement_block_decode();
+  test_limit_encoding();
+  test_configuration_transaction_budget();
+  test_limit_registers_are_read_only();
+  test_watchdog_reset_uses_status_read();
 }
@@ -1,5 +1,6 @@
 #include <array>
 #include <cassert>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
 #include <cstring>
@@ -13,10 +14,17 @@ class FakeBus : public bq25756_core::RegisterBus {
  public:
   bool read_registers(uint8_t reg, uint8_t *data, size_t len) override {
     ++read_count;
+    last_read_len = len;
     if (fail_reads || static_cast<size_t>(reg) + len > registers.size()) {
       return false;
     }
     std::memcpy(data, registers.data() + reg, len);
+    // The flag registers REG25..REG27 clear on read.
+    for (size_t address = reg; address < static_cast<size_t>(reg) + len; address++) {
+      if (address >= bq25756_core::REG25_CHARGER_FLAG_1 && address <= bq25756_core::REG27_FAULT_FLAG) {
+        registers[address] = 0;
+      }
+    }
     return true;
   }
 
@@ -31,6 +39,7 @@ class FakeBus : public bq25756_core::RegisterBus {
 
   std::array<uint8_t, 256> registers{};
   size_t read_count{0};
+  size_t last_read_len{0};
   size_t write_count{0};
   bool fail_reads{false};
   bool fail_writes{false};
@@ -129,6 +138,150 @@ void test_configuration_reconciliation_io_failure() {
   assert(!result.matches);
 }
 
+void test_configuration_restore_bursts() {
+  FakeBus bus;
+  bq25756_core::Bq25756Service service(&bus);
+  // Reset-like contents, plus reserved gap bytes that must stay untouched.
+  for (const auto &entry : bq25756_core::DEFAULT_CONFIGURATION_IMAGE) {
+    write_value(bus, entry.address, entry.width, 0);
+  }
+  // Charging enabled and reverse mode on, as the charger was before the event.
+  bus.registers[bq25756_core::REG17_CHARGER_CONTROL] = bq25756_core::REG17_EN_CHG_MASK;
+  bus.registers[bq25756_core::REG19_POWER_PATH_CONTROL] = bq25756_core::REG19_EN_REV_MASK;
+  bus.registers[0x04] = 0xA5;
+  bus.registers[0x0E] = 0xA5;
+  bus.registers[0x1F] = 0xA5;
+
+  auto config = bq25756_core::Bq25756Configuration{};
+  config.charge_current_limit = bq25756_core::encode_charge_current_limit_ma(5000);
+  config.timer_control = 0x0D;
+  const auto image = bq25756_core::make_configuration_image(config);
+
+  bq25756_core::ConfigurationReconcileResult result{};
+  assert(service.restore_configuration(image, result));
+  assert(result.io_ok);
+  assert(result.matches);
+  assert(result.repaired_count == image.size());
+  assert(result.desired_fingerprint == result.observed_fingerprint);
+  // One runtime read, six write bursts, the charge re-enable and six verify
+  // reads instead of per-register I/O.
+  assert(bus.write_count == 7);
+  assert(bus.read_count == 7);
+  assert(!service.adc_configuration_verified());
+
+  for (const auto &entry : image) {
+    const uint32_t runtime = entry.address == bq25756_core::REG17_CHARGER_CONTROL ? bq25756_core::REG17_EN_CHG_MASK
+                             : entry.address == bq25756_core::REG19_POWER_PATH_CONTROL
+                                 ? bq25756_core::REG19_EN_REV_MASK
+                                 : 0;
+    assert(read_value(bus, entry.address, entry.width) ==
+           (component_common::register_image_write_value(entry) | runtime));
+  }
+  assert(bus.registers[0x04] == 0xA5);
+  assert(bus.registers[0x0E] == 0xA5);
+  assert(bus.registers[0x1F] == 0xA5);
+
+  // A reset that cleared EN_CHG does not override the last charge request,
+  // and a request to stop charging survives a reset that set it.
+  assert(service.set_charge_enabled(true));
+  bus.registers[bq25756_core::REG17_CHARGER_CONTROL] = 0x00;
+  assert(service.restore_configuration(image, result) && result.matches);
+  assert((bus.registers[bq25756_core::REG17_CHARGER_CONTROL] & bq25756_core::REG17_EN_CHG_MASK) != 0);
+  assert(service.set_charge_enabled(false));
+  bus.registers[bq25756_core::REG17_CHARGER_CONTROL] = bq25756_core::REG17_EN_CHG_MASK;
+  const size_t writes_before = bus.write_count;
+  assert(service.restore_configuration(image, result) && result.matches);
+  assert((bus.registers[bq25756_core::REG17_CHARGER_CONTROL] & bq25756_core::REG17_EN_CHG_MASK) == 0);
+  assert(bus.write_count == writes_before + 6);
+
+  bus.fail_writes = true;
+  assert(!service.restore_configuration(image, result));
+  assert(!result.io_ok);
+  assert(bus.write_count == writes_before + 7);
+}
+
+void test_connection_events() {
+  bq25756_core::ConnectionEventDetector detector;
+  bq25756_core::Status status{};
+  bq25756_core::Measurements battery{};
+  battery.vbat_mv = 14800.0f;
+  bq25756_core::Measurements no_battery{};
+
+  // The first poll is only the baseline, even with input and battery present.
+  status.status2 = bq25756_core::REG22_POWER_GOOD_STAT_MASK;
+  assert(detector.observe(status, &battery, false) == 0);
+  assert(detector.observe(status, &battery, false) == 0);
+
+  status.status2 = 0;
+  assert(detector.observe(status, &no_battery, false) == 0);
+  status.status2 = bq25756_core::REG22_POWER_GOOD_STAT_MASK;
+  assert(detector.observe(status, &battery, false) ==
+         (bq25756_core::CONNECTION_EVENT_INPUT_PRESENT | bq25756_core::CONNECTION_EVENT_BATTERY_PRESENT));
+
+  // No ADC result leaves battery presence unchanged.
+  status.status1 = bq25756_core::REG21_WATCHDOG_STAT_MASK;
+  assert(detector.observe(status, nullptr, true) ==
+         (bq25756_core::CONNECTION_EVENT_WATCHDOG_EXPIRED | bq25756_core::CONNECTION_EVENT_REGISTER_RESET));
+  assert(detector.observe(status, &battery, false) == 0);
+
+  detector.reset();
+  status = {};
+  assert(detector.observe(status, nullptr, false) == 0);
+  // Battery presence needs its own baseline after a reset.
+  assert(detector.observe(status, &battery, false) == 0);
+}
+
+// Services a sequence of INT pulses the way the component does: one status
+// and flag burst, then the ADC block only for power-path flags.
+void test_interrupt_flag_sequence() {
+  FakeBus bus;
+  bq25756_core::Bq25756Service service(&bus);
+  bus.registers[bq25756_core::REG2B_ADC_CONTROL] = bq25756_core::REG2B_ADC_CONTINUOUS_15_BIT;
+  bus.registers[bq25756_core::REG2C_ADC_CHANNEL_CONTROL] = bq25756_core::REG2C_VFB_ADC_DIS_MASK;
+  bq25756_core::Status status{};
+  bq25756_core::Measurements measurements{};
+  bq25756_core::AdcConfigurationState adc_state{};
+  assert(service.read_measurements(measurements, bq25756_core::ADC_PROFILE_TELEMETRY, adc_state) ==
+         bq25756_core::MeasurementReadResult::OK);
+
+  auto service_interrupt = [&]() {
+    const size_t before = bus.read_count;
+    assert(service.read_status(status));
+    if (bq25756_core::status_flags_affect_measurements(status)) {
+      assert(service.read_measurements(measurements, bq25756_core::ADC_PROFILE_TELEMETRY, adc_state) == bq25756_core::MeasurementReadResult::OK);
+    }
+    return bus.read_count - before;
+  };
+
+  // Adapter plugged in: PG flag and status, then the ADC block.
+  bus.registers[bq25756_core::REG22_CHARGER_STATUS_2] = bq25756_core::REG22_POWER_GOOD_STAT_MASK;
+  bus.registers[bq25756_core::REG26_CHARGER_FLAG_2] = bq25756_core::REG26_POWER_GOOD_FLAG_MASK;
+  write_value(bus, bq25756_core::REG31_VAC_ADC, 2, 12000);
+  assert(service_interrupt() == 2);
+  assert(status.flag2 == bq25756_core::REG26_POWER_GOOD_FLAG_MASK);
+  assert(measurements.vac_mv == 24000.0f);
+  assert(bus.registers[bq25756_core::REG26_CHARGER_FLAG_2] == 0);
+
+  // The flags were cleared by that read; a spurious pulse sees none.
+  assert(service_interrupt() == 1);
+  assert(!bq25756_core::status_flags_set(status));
+
+  // A TS region change only needs the status bytes.
+  bus.registers[bq25756_core::REG22_CHARGER_STATUS_2] |= 0x10;
+  bus.registers[bq25756_core::REG26_CHARGER_FLAG_2] = bq25756_core::REG26_TS_FLAG_MASK;
+  assert(service_interrupt() == 1);
+  assert(bq25756_core::status_flags_set(status));
+
+  // A fault re-reads the ADC and re-verifies its setup once.
+  bus.registers[bq25756_core::REG24_FAULT_STATUS] = bq25756_core::REG24_VAC_OV_FAULT_MASK;
+  bus.registers[bq25756_core::REG27_FAULT_FLAG] = bq25756_core::REG24_VAC_OV_FAULT_MASK;
+  assert(service_interrupt() == 3);
+  assert(status.fault_flag == bq25756_core::REG24_VAC_OV_FAULT_MASK);
+
+  bus.registers[bq25756_core::REG25_CHARGER_FLAG_1] = bq25756_core::REG25_CHARGE_FLAG_MASK;
+  assert(service_interrupt() == 2);
+}
+
 void test_little_endian_register_io() {
   FakeBus bus;
   bq25756_core::Bq25756Service service(&bus);
@@ -231,8 +384,7 @@ void test_adc_reconciliation() {
   bus.registers[bq25756_core::REG2C_ADC_CHANNEL_CONTROL] = 0xFF;
 
   bq25756_core::AdcConfigurationState adc_state{};
-  assert(service.ensure_adc_enabled(
-             false, bq25756_core::REG2B_ADC_CONTINUOUS_15_BIT, adc_state) ==
+  assert(service.ensure_adc_enabled(bq25756_core::ADC_PROFILE_TELEMETRY, adc_state) ==
          bq25756_core::AdcEnsureResult::REPAIRED);
   assert(adc_state.old_reg2b == 0x7C);
   assert(adc_state.persistent_reg2b == 0x80);
@@ -242,16 +394,146 @@ void test_adc_reconciliation() {
   assert(bus.registers[bq25756_core::REG2C_ADC_CHANNEL_CONTROL] == 0x0B);
 }
 
+void test_poll_burst_transactions() {
+  FakeBus bus;
+  bq25756_core::Bq25756Service service(&bus);
+  bus.registers[bq25756_core::REG2B_ADC_CONTROL] = bq25756_core::REG2B_ADC_CONTINUOUS_15_BIT;
+  bus.registers[bq25756_core::REG2C_ADC_CHANNEL_CONTROL] = bq25756_core::REG2C_VFB_ADC_DIS_MASK;
+  bus.registers[bq25756_core::REG21_CHARGER_STATUS_1] = 0x03;
+  bus.registers[bq25756_core::REG24_FAULT_STATUS] = 0x00;
+  bus.registers[bq25756_core::REG33_VBAT_ADC] = 0x34;
+  bus.registers[bq25756_core::REG33_VBAT_ADC + 1] = 0x12;
+  bus.registers[bq25756_core::REG37_TS_ADC] = 0xCD;
+  bus.registers[bq25756_core::REG37_TS_ADC + 1] = 0xAB;
+
+  const auto poll = [&](bq25756_core::MeasurementReadResult expected) {
+    bq25756_core::Status status{};
+    bq25756_core::Measurements measurements{};
+    bq25756_core::ControlStates controls{};
+    bq25756_core::AdcConfigurationState adc_state{};
+    assert(service.read_status(status));
+    assert(service.read_measurements(measurements, bq25756_core::ADC_PROFILE_TELEMETRY, adc_state) ==
+           expected);
+    assert(service.read_control_states(controls));
+    if (expected == bq25756_core::MeasurementReadResult::OK) {
+      assert(status.status1 == 0x03);
+      assert(measurements.vbat.raw_le == 0x1234);
+      assert(measurements.ts.raw_le == 0xABCD);
+    }
+  };
+
+  // The first poll verifies REG2B/2C once; every later poll is three bursts.
+  poll(bq25756_core::MeasurementReadResult::OK);
+  assert(bus.read_count == 4);
+  assert(service.adc_configuration_verified());
+  for (int i = 0; i < 5; i++) {
+    const size_t before = bus.read_count;
+    poll(bq25756_core::MeasurementReadResult::OK);
+    assert(bus.read_count - before == 3);
+  }
+  assert(bus.write_count == 0);
+
+  // A new fault bit re-verifies on the next poll only, even while it stays latched.
+  bus.registers[bq25756_core::REG24_FAULT_STATUS] = 0x40;
+  size_t before = bus.read_count;
+  poll(bq25756_core::MeasurementReadResult::OK);
+  assert(bus.read_count - before == 4);
+  before = bus.read_count;
+  poll(bq25756_core::MeasurementReadResult::OK);
+  assert(bus.read_count - before == 3);
+
+  // A reset that reverts the ADC setup is repaired after invalidation.
+  bus.registers[bq25756_core::REG2B_ADC_CONTROL] = 0x00;
+  service.invalidate_adc_configuration();
+  poll(bq25756_core::MeasurementReadResult::CONFIGURATION_CHANGED);
+  assert((bus.registers[bq25756_core::REG2B_ADC_CONTROL] & bq25756_core::REG2B_ADC_PERSISTENT_MASK) ==
+         bq25756_core::REG2B_ADC_CONTINUOUS_15_BIT);
+  before = bus.read_count;
+  poll(bq25756_core::MeasurementReadResult::OK);
+  assert(bus.read_count - before == 3);
+
+  // Switching VFB on changes the requested channels and re-verifies.
+  bq25756_core::Measurements measurements{};
+  bq25756_core::AdcConfigurationState adc_state{};
+  assert(service.read_measurements(measurements, bq25756_core::ADC_PROFILE_CALIBRATION, adc_state) ==
+         bq25756_core::MeasurementReadResult::CONFIGURATION_CHANGED);
+
+  // A failed burst drops the verification.
+  bus.fail_reads = true;
+  assert(service.read_measurements(measurements, bq25756_core::ADC_PROFILE_CALIBRATION, adc_state) ==
+         bq25756_core::MeasurementReadResult::IO_ERROR);
+  bus.fail_reads = false;
+  assert(!service.adc_configuration_verified());
+}
+
+void test_adc_profiles() {
+  FakeBus bus;
+  bq25756_core::Bq25756Service service(&bus);
+  bus.registers[bq25756_core::REG2B_ADC_CONTROL] = bq25756_core::REG2B_ADC_CONTINUOUS_15_BIT;
+  bus.registers[bq25756_core::REG2C_ADC_CHANNEL_CONTROL] = bq25756_core::REG2C_VFB_ADC_DIS_MASK | 0x01;
+  write_value(bus, bq25756_core::REG2D_IAC_ADC, 2, 1000);
+  write_value(bus, bq25756_core::REG2F_IBAT_ADC, 2, 1500);
+  write_value(bus, bq25756_core::REG33_VBAT_ADC, 2, 8000);
+  bq25756_core::Measurements measurements{};
+  bq25756_core::AdcConfigurationState adc_state{};
+
+  // Fast current: 13-bit continuous, IBAT and VBAT only, reserved REG2C bits kept.
+  assert(service.read_measurements(measurements, bq25756_core::ADC_PROFILE_FAST_CURRENT, adc_state) ==
+         bq25756_core::MeasurementReadResult::CONFIGURATION_CHANGED);
+  assert(bus.registers[bq25756_core::REG2B_ADC_CONTROL] == 0xA0);
+  assert(bus.registers[bq25756_core::REG2C_ADC_CHANNEL_CONTROL] == 0xA7);
+  assert(service.read_measurements(measurements, bq25756_core::ADC_PROFILE_FAST_CURRENT, adc_state) ==
+         bq25756_core::MeasurementReadResult::OK);
+  // The burst ends after VBAT.
+  assert(bus.last_read_len == 8);
+  assert(measurements.ibat_ma == 3000.0f);
+  assert(measurements.vbat_mv == 16000.0f);
+  assert(std::isnan(measurements.iac_ma));
+  assert(std::isnan(measurements.ts_percent));
+
+  // One-shot: configured idle, started by ADC_EN, done when the charger clears it.
+  constexpr bq25756_core::AdcProfile one_shot{.one_shot = true, .channels = bq25756_core::ADC_CHANNEL_IBAT};
+  assert(service.start_adc_conversion(one_shot, adc_state) == bq25756_core::AdcEnsureResult::REPAIRED);
+  assert(adc_state.persistent_reg2b == bq25756_core::REG2B_ADC_RATE_MASK);
+  assert(bus.registers[bq25756_core::REG2B_ADC_CONTROL] == 0xC0);
+  bool done = true;
+  assert(service.read_adc_conversion_done(done));
+  assert(!done);
+  bus.registers[bq25756_core::REG2B_ADC_CONTROL] = bq25756_core::REG2B_ADC_RATE_MASK;
+  assert(service.read_adc_conversion_done(done));
+  assert(done);
+  assert(service.read_measurements(measurements, one_shot, adc_state) == bq25756_core::MeasurementReadResult::OK);
+  assert(bus.last_read_len == 4);
+  assert(std::isnan(measurements.vbat_mv));
+
+  // A later start needs no re-verification, and ADC_EN cleared after a shot
+  // is not drift.
+  const size_t writes = bus.write_count;
+  assert(service.start_adc_conversion(one_shot, adc_state) == bq25756_core::AdcEnsureResult::OK);
+  assert(bus.write_count - writes == 1);
+
+  // Back to the default profile.
+  assert(service.read_measurements(measurements, bq25756_core::ADC_PROFILE_TELEMETRY, adc_state) ==
+         bq25756_core::MeasurementReadResult::CONFIGURATION_CHANGED);
+  assert(bus.registers[bq25756_core::REG2B_ADC_CONTROL] == bq25756_core::REG2B_ADC_CONTINUOUS_15_BIT);
+  assert(bus.registers[bq25756_core::REG2C_ADC_CHANNEL_CONTROL] == (bq25756_core::REG2C_VFB_ADC_DIS_MASK | 0x01));
+}
+
 }  // namespace
 
 int main() {
   test_register_info_and_complete_image();
   test_configuration_reconciliation();
   test_configuration_reconciliation_io_failure();
+  test_configuration_restore_bursts();
+  test_connection_events();
   test_little_endian_register_io();
   test_register_field_updates();
   test_probe_and_control_decode();
   test_adc_reconciliation();
+  test_poll_burst_transactions();
+  test_interrupt_flag_sequence();
+  test_adc_profiles();
   test_typed_charger_snapshot();
   return 0;
 }
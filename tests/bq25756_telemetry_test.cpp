@@ -0,0 +1,132 @@
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+#include "components/bq25756/bq25756_telemetry_service.h"
+
+namespace {
+
+using namespace bq25756_core;
+
+constexpr uint8_t CHARGE_STAT_FAST_CC = 3;
+constexpr uint8_t CHARGE_STAT_TAPER_CV = 4;
+
+bool near(double a, double b, double tolerance = 1e-4) { return std::fabs(a - b) < tolerance; }
+
+Measurements sample(float vac_v, float iac_a, float vbat_v, float ibat_a) {
+  Measurements measurements{};
+  measurements.vac_mv = vac_v * 1000.0f;
+  measurements.iac_ma = iac_a * 1000.0f;
+  measurements.vbat_mv = vbat_v * 1000.0f;
+  measurements.ibat_ma = ibat_a * 1000.0f;
+  return measurements;
+}
+
+Status charge_state(uint8_t code) {
+  Status status{};
+  status.status1 = code;
+  return status;
+}
+
+void test_accumulator_stats() {
+  TelemetryAccumulator accumulator;
+  assert(accumulator.stats().count == 0);
+  accumulator.add(3.0f);
+  accumulator.add(-1.0f);
+  accumulator.add(4.0f);
+  const TelemetryStats stats = accumulator.stats();
+  assert(stats.count == 3);
+  assert(near(stats.min, -1.0));
+  assert(near(stats.max, 4.0));
+  assert(near(stats.mean, 2.0));
+}
+
+void test_window_energy_efficiency_and_states() {
+  TelemetryAggregator aggregator;
+  aggregator.start(0);
+
+  // 60 s at 1 Hz: 20 V * 2 A in, 16 V * 2.25 A out (90 %), CC then CV.
+  for (uint32_t second = 0; second <= 60; second++) {
+    const uint8_t state = second < 45 ? CHARGE_STAT_FAST_CC : CHARGE_STAT_TAPER_CV;
+    aggregator.add(second * 1000, charge_state(state), sample(20.0f, 2.0f, 16.0f, 2.25f));
+  }
+  assert(!aggregator.window_elapsed(59999, 60000));
+  assert(aggregator.window_elapsed(60000, 60000));
+
+  const TelemetryWindow window = aggregator.take_window(60000);
+  assert(window.duration_ms == 60000);
+  assert(window.samples == 61);
+  assert(near(window.channel(TelemetryChannel::INPUT_POWER).mean, 40.0));
+  assert(near(window.channel(TelemetryChannel::OUTPUT_POWER).max, 36.0));
+  // 40 W for one minute.
+  assert(near(window.input_energy_wh, 40.0 / 60.0));
+  assert(near(window.output_energy_wh, 36.0 / 60.0));
+  assert(window.has_efficiency);
+  assert(near(window.efficiency, 0.9));
+  assert(window.charge_state_ms[CHARGE_STAT_FAST_CC] == 45000);
+  assert(window.charge_state_ms[CHARGE_STAT_TAPER_CV] == 15000);
+
+  // The next window starts empty; totals carry on.
+  const TelemetryWindow empty = aggregator.take_window(61000);
+  assert(empty.samples == 0);
+  assert(!empty.has_efficiency);
+  assert(near(aggregator.total_input_energy_wh(), 40.0 / 60.0));
+}
+
+void test_trapezoid_ramp_and_gaps() {
+  TelemetryAggregator aggregator;
+  aggregator.start(0);
+  // Input power ramps 0 -> 100 W over 4 s: 200 J.
+  aggregator.add(0, charge_state(CHARGE_STAT_FAST_CC), sample(20.0f, 0.0f, 0.0f, 0.0f));
+  aggregator.add(4000, charge_state(CHARGE_STAT_FAST_CC), sample(20.0f, 5.0f, 0.0f, 0.0f));
+  // A 30 s gap, e.g. a disconnect, is not integrated.
+  aggregator.add(34000, charge_state(CHARGE_STAT_FAST_CC), sample(20.0f, 5.0f, 0.0f, 0.0f));
+  const TelemetryWindow window = aggregator.take_window(34000);
+  assert(near(window.input_energy_wh, 200.0 / 3600.0));
+  assert(window.charge_state_ms[CHARGE_STAT_FAST_CC] == 4000);
+  // No output energy: no efficiency.
+  assert(!window.has_efficiency);
+
+  // A 10 s poll interval, e.g. with the INT pin, integrates every poll and
+  // one missed poll, but still not a disconnect.
+  TelemetryAggregator slow;
+  slow.set_poll_interval_ms(10000);
+  assert(slow.max_integration_gap_ms() == 25000);
+  slow.start(0);
+  for (uint32_t second = 0; second <= 60; second += 10) {
+    slow.add(second * 1000, charge_state(CHARGE_STAT_FAST_CC), sample(20.0f, 5.0f, 16.0f, 5.0f));
+  }
+  slow.add(80000, charge_state(CHARGE_STAT_FAST_CC), sample(20.0f, 5.0f, 16.0f, 5.0f));
+  slow.add(140000, charge_state(CHARGE_STAT_FAST_CC), sample(20.0f, 5.0f, 16.0f, 5.0f));
+  const TelemetryWindow slow_window = slow.take_window(140000);
+  assert(slow_window.charge_state_ms[CHARGE_STAT_FAST_CC] == 80000);
+  assert(near(slow_window.input_energy_wh, 100.0 * 80.0 / 3600.0));
+
+  // Fast polls keep the default gap.
+  slow.set_poll_interval_ms(1000);
+  assert(slow.max_integration_gap_ms() == TelemetryAggregator::DEFAULT_MAX_INTEGRATION_GAP_MS);
+}
+
+void test_reverse_mode_has_no_efficiency() {
+  TelemetryAggregator aggregator;
+  aggregator.start(0);
+  for (uint32_t second = 0; second <= 10; second++) {
+    aggregator.add(second * 1000, charge_state(0), sample(5.0f, -1.0f, 16.0f, -0.35f));
+  }
+  // A profile with the input channels disabled contributes nothing.
+  aggregator.add(11000, charge_state(0), sample(NAN, NAN, 16.0f, -0.35f));
+  const TelemetryWindow window = aggregator.take_window(11000);
+  assert(window.samples == 11);
+  assert(window.input_energy_wh < 0.0f);
+  assert(!window.has_efficiency);
+}
+
+}  // namespace
+
+int main() {
+  test_accumulator_stats();
+  test_window_energy_efficiency_and_states();
+  test_trapezoid_ramp_and_gaps();
+  test_reverse_mode_has_no_efficiency();
+  return 0;
+}
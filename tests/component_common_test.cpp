@@ -1,15 +1,35 @@
 #include <array>
 #include <cassert>
 #include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include "components/component_common/bit_field.h"
 #include "components/component_common/byte_order.h"
 #include "components/component_common/charger.h"
+#include "components/component_common/crc32.h"
+#include "components/component_common/fixed_string.h"
 #include "components/component_common/register_info.h"
 #include "components/component_common/register_manifest.h"
 #include "components/component_common/status.h"
 
+// Counts heap allocations for the text publishing benchmark.
+static size_t g_allocations = 0;
+
+void *operator new(std::size_t size) {
+  ++g_allocations;
+  if (void *memory = std::malloc(size == 0 ? 1 : size))
+    return memory;
+  std::abort();
+}
+
+void operator delete(void *memory) noexcept { std::free(memory); }
+void operator delete(void *memory, std::size_t) noexcept { std::free(memory); }
+
 namespace {
 
 using Field = component_common::RegisterField<uint8_t, 0x70>;
@@ -57,6 +77,25 @@ static_assert(!component_common::register_manifest_valid(UNCLASSIFIED_MANIFEST))
 static_assert(!component_common::register_manifest_valid(OVERLAPPING_MANIFEST));
 static_assert(component_common::register_value_matches(0xA5, 0x05, 0x0F));
 static_assert(component_common::merge_register_value(0xA0, 0x05, 0x0F) == 0xA5);
+static_assert(component_common::register_image_write_value(
+                  {.name = "config", .address = 0x10, .width = 1, .value = 0x1C5,
+                   .mask = 0x0F, .command_mask = 0x40}) == 0x85);
+
+// Adjacent entries share a burst up to the length limit; gaps start a new one.
+constexpr std::array<component_common::RegisterImageEntry, 5> BURST_IMAGE{{
+    {.name = "a", .address = 0x00, .width = 2, .value = 0, .mask = 0xFFFF, .command_mask = 0},
+    {.name = "b", .address = 0x02, .width = 2, .value = 0, .mask = 0xFFFF, .command_mask = 0},
+    {.name = "c", .address = 0x04, .width = 1, .value = 0, .mask = 0xFF, .command_mask = 0},
+    {.name = "d", .address = 0x08, .width = 1, .value = 0, .mask = 0xFF, .command_mask = 0},
+    {.name = "e", .address = 0x09, .width = 1, .value = 0, .mask = 0xFF, .command_mask = 0},
+}};
+constexpr auto BURST_PLAN = component_common::plan_register_image_bursts(BURST_IMAGE, 4);
+static_assert(BURST_PLAN.count == 3);
+static_assert(BURST_PLAN.bursts[0].address == 0x00 && BURST_PLAN.bursts[0].length == 4 &&
+              BURST_PLAN.bursts[0].entry_count == 2);
+static_assert(BURST_PLAN.bursts[1].address == 0x04 && BURST_PLAN.bursts[1].first_entry == 2);
+static_assert(BURST_PLAN.bursts[2].address == 0x08 && BURST_PLAN.bursts[2].length == 2 &&
+              BURST_PLAN.bursts[2].first_entry == 3);
 
 enum class TestRegisterId : uint8_t {
   CONTROL,
@@ -98,23 +137,38 @@ class FakeCharger final : public component_common::ChargerInterface {
     return {true, true, true, true, true, true};
   }
 
-  component_common::ChargerSnapshot snapshot() const override {
-    return snapshot_;
-  }
-
   bool request_enabled(bool enabled) override {
     requested_enabled_ = enabled;
     return true;
   }
 
-  component_common::ChargerSnapshot snapshot_{};
+  void publish(const component_common::ChargerSnapshot &snapshot) { this->publish_snapshot_(snapshot); }
+
   bool requested_enabled_{false};
 };
 
 void test_charger_interface() {
   FakeCharger charger;
-  charger.snapshot_.state = component_common::ChargerState::FAST_CC;
-  charger.snapshot_.valid = true;
+  assert(charger.sample_sequence() == 0);
+  assert(!charger.has_new_sample(0));
+
+  component_common::ChargerSnapshot sample{};
+  sample.state = component_common::ChargerState::FAST_CC;
+  sample.valid = true;
+  sample.sequence = 42;
+  charger.publish(sample);
+
+  // The charger stamps the sequence; the reference follows later publishes.
+  const component_common::ChargerSnapshot &latest = charger.latest_snapshot();
+  assert(latest.sequence == 1);
+  assert(charger.has_new_sample(0));
+  assert(!charger.has_new_sample(1));
+  sample.valid = false;
+  charger.publish(sample);
+  assert(latest.sequence == 2 && !latest.valid);
+  assert(charger.has_new_sample(1));
+  sample.valid = true;
+  charger.publish(sample);
 
   assert(charger.capabilities().enable_control);
   assert(charger.snapshot().valid);
@@ -150,6 +204,19 @@ void test_byte_order() {
   assert(encoded == big);
 }
 
+void test_crc32() {
+  // The standard CRC-32 check value.
+  const char check[] = "123456789";
+  assert(~component_common::crc32_update(0xFFFFFFFFU, check, 9) == 0xCBF43926UL);
+
+  // Fields chain exactly like one contiguous buffer.
+  const uint16_t first = 0x3231;
+  const uint32_t second = 0x36353433UL;
+  uint32_t crc = component_common::crc32_field(0xFFFFFFFFU, first);
+  crc = component_common::crc32_field(crc, second);
+  assert(crc == component_common::crc32_update(0xFFFFFFFFU, check, 6));
+}
+
 void test_configuration_fingerprint() {
   const uint32_t first = component_common::configuration_fingerprint(VALID_IMAGE);
   const uint32_t second = component_common::configuration_fingerprint(VALID_IMAGE);
@@ -157,12 +224,159 @@ void test_configuration_fingerprint() {
   assert(first != component_common::FNV1A_OFFSET_BASIS);
 }
 
+void test_fixed_string() {
+  component_common::FixedString<16> text;
+  assert(text.empty() && text.size() == 0 && text.c_str()[0] == '\0');
+  text.append_item("DRV_OTS", ",").append_item("NO_MTR", ",");
+  assert(text == "DRV_OTS,NO_MTR");
+  assert(!text.truncated());
+
+  text.appendf(" %uV", 20U);
+  assert(text == "DRV_OTS,NO_MTR 2");
+  assert(text.size() == 16 && text.truncated());
+  text.append("more");
+  assert(text.size() == 16 && text.c_str()[16] == '\0');
+
+  text.clear();
+  assert(text.empty() && !text.truncated());
+  text.appendf("%uV %.2fA", 9U, 3.0);
+  assert(text == "9V 3.00A");
+  text.append(static_cast<const char *>(nullptr)).append('!');
+  assert(text == "9V 3.00A!");
+
+  const component_common::FixedString<4> exact("abcd");
+  assert(exact == "abcd" && !exact.truncated());
+}
+
+void test_publish_guard() {
+  static_assert(component_common::text_fingerprint("") == component_common::FNV1A_OFFSET_BASIS);
+  static_assert(component_common::text_fingerprint("none") != component_common::text_fingerprint("None"));
+
+  component_common::PublishGuard guard;
+  assert(!guard.has_value());
+  // The first value always publishes, even an empty one.
+  assert(guard.changed("none"));
+  assert(guard.has_value());
+  assert(!guard.changed("none"));
+  assert(guard.changed("DRV_OTS"));
+  assert(!guard.changed(std::string_view("DRV_OTS,X", 7)));
+  assert(guard.changed("none"));
+  guard.reset();
+  assert(guard.changed("none"));
+}
+
+// A text entity keeps its own std::string copy of every published state,
+// as ESPHome's TextSensor does.
+struct EntityModel {
+  void publish_state(const std::string &text) {
+    this->state = text;
+    this->publishes++;
+  }
+  std::string state;
+  size_t publishes{0};
+};
+
+constexpr const char *PDO_NAMES[] = {"5V 3.00A", "9V 3.00A", "12V 3.00A", "15V 3.00A", "20V 2.25A"};
+constexpr size_t POLLS = 1000;
+
+// One poll of the previous publishing code: the list joined into a fresh
+// std::string, the fault summary collected into a vector of strings, both
+// published every time.
+void poll_with_strings(EntityModel &pdos, EntityModel &faults, bool fault_active) {
+  std::string list;
+  for (const char *name : PDO_NAMES) {
+    if (!list.empty())
+      list += ", ";
+    list += name;
+  }
+  pdos.publish_state(list);
+
+  std::vector<std::string> names;
+  if (fault_active) {
+    names.emplace_back("DRV_OCP_VDS");
+    names.emplace_back("BUS_CURRENT_LIMIT");
+  }
+  std::string summary = "none";
+  if (!names.empty()) {
+    summary.clear();
+    for (size_t i = 0; i < names.size(); i++) {
+      if (i != 0)
+        summary += ", ";
+      summary += names[i];
+    }
+  }
+  faults.publish_state(summary);
+}
+
+void poll_with_fixed_strings(EntityModel &pdos, component_common::PublishGuard &pdo_guard, EntityModel &faults,
+                             component_common::PublishGuard &fault_guard, bool fault_active) {
+  component_common::FixedString<64> list;
+  for (const char *name : PDO_NAMES)
+    list.append_item(name, ", ");
+  if (pdo_guard.changed(list.view()))
+    pdos.publish_state(list.c_str());
+
+  component_common::FixedString<255> summary;
+  if (fault_active)
+    summary.append_item("DRV_OCP_VDS", ", ").append_item("BUS_CURRENT_LIMIT", ", ");
+  if (summary.empty())
+    summary.append("none");
+  if (fault_guard.changed(summary.view()))
+    faults.publish_state(summary.c_str());
+}
+
+// A fault appears once in the run and clears again; everything else is
+// the steady state of a long-running node.
+bool fault_active_at(size_t poll) { return poll >= 400 && poll < 410; }
+
+void benchmark_text_allocations_per_poll() {
+  EntityModel string_pdos;
+  EntityModel string_faults;
+  size_t before = g_allocations;
+  for (size_t poll = 0; poll < POLLS; poll++)
+    poll_with_strings(string_pdos, string_faults, fault_active_at(poll));
+  const size_t string_allocations = g_allocations - before;
+
+  EntityModel fixed_pdos;
+  EntityModel fixed_faults;
+  component_common::PublishGuard pdo_guard;
+  component_common::PublishGuard fault_guard;
+  before = g_allocations;
+  for (size_t poll = 0; poll < POLLS; poll++)
+    poll_with_fixed_strings(fixed_pdos, pdo_guard, fixed_faults, fault_guard, fault_active_at(poll));
+  const size_t fixed_allocations = g_allocations - before;
+
+  assert(string_pdos.state == fixed_pdos.state);
+  assert(string_faults.state == fixed_faults.state && fixed_faults.state == "none");
+  // PDO list once; faults at start, on the fault, and on clearing.
+  assert(fixed_pdos.publishes == 1 && fixed_faults.publishes == 3);
+  // Only the publishes themselves may allocate, and never in steady state.
+  assert(fixed_allocations <= 2 * (fixed_pdos.publishes + fixed_faults.publishes));
+  assert(string_allocations >= 2 * POLLS);
+
+  before = g_allocations;
+  for (size_t poll = 0; poll < 100; poll++)
+    poll_with_fixed_strings(fixed_pdos, pdo_guard, fixed_faults, fault_guard, false);
+  assert(g_allocations == before);
+
+  std::printf("  text publish per poll: std::string %.2f allocations, %.2f publishes; "
+              "fixed + guard %.3f allocations, %.3f publishes\n",
+              static_cast<double>(string_allocations) / POLLS,
+              static_cast<double>(string_pdos.publishes + string_faults.publishes) / POLLS,
+              static_cast<double>(fixed_allocations) / POLLS,
+              static_cast<double>(fixed_pdos.publishes + fixed_faults.publishes) / POLLS);
+}
+
 }  // namespace
 
 int main() {
   test_byte_order();
   test_charger_interface();
   test_status_contract();
+  test_crc32();
   test_configuration_fingerprint();
+  test_fixed_string();
+  test_publish_guard();
+  benchmark_text_allocations_per_poll();
   return 0;
 }
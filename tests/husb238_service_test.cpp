@@ -0,0 +1,193 @@
+#include <cassert>
+#include <cstdint>
+
+#include "components/husb238/husb238_service.h"
+
+namespace {
+
+using husb238_core::ContractEvent;
+using husb238_core::ContractMonitor;
+using husb238_core::ContractState;
+using husb238_core::Status;
+
+constexpr uint8_t PD_SUCCESS = 0x01;
+constexpr uint8_t PD_NOT_SUPPORTED = 0x04;
+
+Status attached(uint8_t voltage, uint8_t pd_response = PD_SUCCESS) {
+  Status status;
+  status.attached = true;
+  status.voltage = voltage;
+  status.pd_response = pd_response;
+  return status;
+}
+
+void test_request_to_accept_latency() {
+  ContractMonitor monitor;
+  assert(monitor.update(attached(5), 100) == ContractEvent::ATTACHED);
+  assert(monitor.state() == ContractState::ATTACHED);
+
+  monitor.on_request(20, 1000);
+  assert(monitor.pending());
+  assert(monitor.update(attached(5), 1020) == ContractEvent::NONE);
+  assert(monitor.update(attached(20), 1140) == ContractEvent::ACCEPTED);
+  assert(monitor.state() == ContractState::ESTABLISHED);
+  assert(monitor.contract_voltage() == 20);
+
+  monitor.on_request(15, 2000);
+  assert(monitor.update(attached(15), 2060) == ContractEvent::ACCEPTED);
+  const auto &stats = monitor.stats();
+  assert(stats.requests == 2 && stats.accepted == 2 && stats.failures() == 0);
+  assert(stats.last_latency_ms == 60);
+  assert(stats.min_latency_ms == 60 && stats.max_latency_ms == 140);
+  assert(stats.average_latency_ms() == 100);
+
+  // Steady polls at the contract voltage are not events.
+  assert(monitor.update(attached(15), 5000) == ContractEvent::NONE);
+}
+
+void test_rejection_and_timeout() {
+  ContractMonitor monitor;
+  monitor.set_timeout_ms(500);
+  monitor.update(attached(5), 0);
+
+  monitor.on_request(20, 100);
+  assert(monitor.update(attached(5, PD_NOT_SUPPORTED), 140) == ContractEvent::REJECTED);
+  assert(monitor.state() == ContractState::FAILED);
+
+  monitor.on_request(20, 1000);
+  assert(monitor.update(attached(5, 0x00), 1400) == ContractEvent::NONE);
+  assert(monitor.update(attached(5, 0x00), 1500) == ContractEvent::TIMED_OUT);
+  assert(monitor.stats().rejected == 1 && monitor.stats().timeouts == 1);
+  assert(monitor.stats().failures() == 2 && monitor.stats().accepted == 0);
+
+  // A stale success from an earlier request does not accept the wrong voltage.
+  monitor.on_request(20, 2000);
+  assert(monitor.update(attached(9), 2020) == ContractEvent::NONE);
+  assert(monitor.pending());
+}
+
+void test_stale_response_is_not_this_request() {
+  ContractMonitor monitor;
+  monitor.update(attached(5), 0);
+  monitor.on_request(20, 100);
+  assert(monitor.update(attached(5, PD_NOT_SUPPORTED), 140) == ContractEvent::REJECTED);
+
+  // PD_RESPONSE still holds the rejection when the request is repeated.
+  monitor.on_request(20, 2000);
+  assert(monitor.update(attached(5, PD_NOT_SUPPORTED), 2020) == ContractEvent::NONE);
+  assert(monitor.update(attached(5, PD_NOT_SUPPORTED), 2400) == ContractEvent::NONE);
+  assert(monitor.pending() && monitor.stats().rejected == 1);
+  // This time the source accepts.
+  assert(monitor.update(attached(20), 2450) == ContractEvent::ACCEPTED);
+  assert(monitor.stats().last_latency_ms == 450);
+
+  // Unchanged past the settle time, the standing rejection is this request's.
+  monitor.on_request(9, 3000);
+  assert(monitor.update(attached(20), 3020) == ContractEvent::NONE);
+  monitor.update(attached(20, PD_NOT_SUPPORTED), 3040);
+  monitor.on_request(9, 4000);
+  assert(monitor.update(attached(20, PD_NOT_SUPPORTED), 4020) == ContractEvent::NONE);
+  assert(monitor.update(attached(20, PD_NOT_SUPPORTED), 4000 + ContractMonitor::RESPONSE_SETTLE_MS) ==
+         ContractEvent::REJECTED);
+
+  // Re-requesting the current contract is not accepted in one poll.
+  monitor.on_request(20, 6000);
+  monitor.update(attached(20), 6030);
+  monitor.on_request(20, 7000);
+  assert(monitor.update(attached(20), 7020) == ContractEvent::NONE);
+  assert(monitor.update(attached(20), 7000 + ContractMonitor::RESPONSE_SETTLE_MS) == ContractEvent::ACCEPTED);
+  assert(monitor.stats().last_latency_ms == ContractMonitor::RESPONSE_SETTLE_MS);
+}
+
+void test_contract_loss_and_voltage_change() {
+  ContractMonitor monitor;
+  monitor.update(attached(5), 0);
+  monitor.on_request(20, 10);
+  assert(monitor.update(attached(20), 50) == ContractEvent::ACCEPTED);
+
+  // The source reset its contract and the sink fell back to 5 V.
+  assert(monitor.update(attached(5), 1000) == ContractEvent::CONTRACT_LOST);
+  assert(monitor.state() == ContractState::LOST);
+  assert(monitor.stats().contract_losses == 1);
+  assert(monitor.update(attached(5), 2000) == ContractEvent::NONE);
+
+  // The source offering the requested voltage again restores the contract.
+  assert(monitor.update(attached(20), 3000) == ContractEvent::NONE);
+  assert(monitor.state() == ContractState::ESTABLISHED);
+
+  assert(monitor.update(attached(12), 4000) == ContractEvent::VOLTAGE_CHANGED);
+  assert(monitor.stats().voltage_changes == 1 && monitor.stats().contract_losses == 1);
+
+  Status detached;
+  assert(monitor.update(detached, 5000) == ContractEvent::DETACHED);
+  assert(monitor.update(detached, 6000) == ContractEvent::NONE);
+  assert(monitor.state() == ContractState::DETACHED);
+  assert(monitor.update(attached(20), 7000) == ContractEvent::ATTACHED);
+  assert(monitor.state() == ContractState::ESTABLISHED);
+}
+
+void test_unrequested_voltage_changes() {
+  ContractMonitor monitor;
+  monitor.update(attached(9), 0);
+  assert(monitor.update(attached(12), 100) == ContractEvent::VOLTAGE_CHANGED);
+  assert(monitor.stats().voltage_changes == 1);
+  // Nothing was requested, so there is nothing to re-request.
+  monitor.set_auto_rerequest(true);
+  assert(!monitor.should_rerequest(1000000));
+}
+
+void test_auto_rerequest_backoff() {
+  ContractMonitor monitor;
+  monitor.update(attached(5), 0);
+  monitor.on_request(20, 0);
+  monitor.update(attached(20), 40);
+  assert(!monitor.should_rerequest(40));
+
+  monitor.update(attached(5), 1000);
+  assert(monitor.state() == ContractState::LOST);
+  assert(!monitor.should_rerequest(1999));
+  monitor.set_auto_rerequest(true);
+  assert(!monitor.should_rerequest(1999));
+  assert(monitor.should_rerequest(2000));
+
+  // Each failure doubles the delay up to the cap.
+  uint32_t now = 2000;
+  uint32_t expected_delay = 2000;
+  for (int attempt = 0; attempt < 8; attempt++) {
+    monitor.on_request(20, now);
+    assert(!monitor.should_rerequest(now));
+    now += ContractMonitor::DEFAULT_TIMEOUT_MS;
+    assert(monitor.update(attached(5, 0x00), now) == ContractEvent::TIMED_OUT);
+    assert(!monitor.should_rerequest(now + expected_delay - 1));
+    assert(monitor.should_rerequest(now + expected_delay));
+    now += expected_delay;
+    expected_delay = expected_delay * 2 > ContractMonitor::RETRY_MAX_MS ? ContractMonitor::RETRY_MAX_MS
+                                                                        : expected_delay * 2;
+  }
+
+  // Acceptance resets the backoff.
+  monitor.on_request(20, now);
+  monitor.update(attached(20), now + 30);
+  monitor.update(attached(5), now + 100);
+  assert(monitor.should_rerequest(now + 100 + ContractMonitor::RETRY_INITIAL_MS));
+
+  // After a reattach at 5 V the request is repeated at once.
+  Status detached;
+  monitor.update(detached, now + 200);
+  assert(!monitor.should_rerequest(now + 300));
+  monitor.update(attached(5), now + 300);
+  assert(monitor.state() == ContractState::ATTACHED);
+  assert(monitor.should_rerequest(now + 300));
+}
+
+}  // namespace
+
+int main() {
+  test_request_to_accept_latency();
+  test_rejection_and_timeout();
+  test_stale_response_is_not_this_request();
+  test_contract_loss_and_voltage_change();
+  test_unrequested_voltage_changes();
+  test_auto_rerequest_backoff();
+  return 0;
+}
@@ -0,0 +1,120 @@
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+#include "components/mcf8316d/mcf8316d_scope_capture.h"
+
+namespace {
+
+using namespace mcf8316d_core;
+
+bool near(float a, float b, float tolerance = 0.001f) { return std::fabs(a - b) < tolerance; }
+
+void test_slot_grid() {
+  ScopeCapture capture;
+  capture.start(1000u, 100u);
+  assert(capture.due(1000u));
+  assert(capture.add(1000u, 1.0f, 1.0f, 24.0f, false));
+  // Same slot again is not due; a late sample keeps its own slot.
+  assert(!capture.due(1099u));
+  assert(!capture.add(1099u, 1.0f, 1.0f, 24.0f, false));
+  assert(capture.add(1130u, 1.0f, 1.0f, 24.0f, false));
+  assert(capture.sample(1).t_ms == 100u);
+  // Slots 2 and 3 passed without a sample.
+  assert(capture.add(1420u, 1.0f, 1.0f, 24.0f, false));
+  assert(capture.sample(2).t_ms == 400u);
+  assert(capture.reduce(ScopeStageLimits{}).missed == 2u);
+
+  capture.start(0u, 10u);
+  for (uint32_t now = 0u; capture.due(now); now += 10u) {
+    assert(capture.add(now, 0.0f, 0.0f, 0.0f, false));
+  }
+  assert(capture.full());
+  assert(capture.size() == ScopeCapture::CAPACITY);
+}
+
+void test_channel_reduction_math() {
+  // Ramp 0, 10, 20, 30 then a +/-1 square wave around 40 for twelve samples.
+  ScopeSample samples[16]{};
+  for (size_t i = 0; i < 16u; i++) {
+    samples[i].t_ms = static_cast<uint32_t>(i) * 100u;
+    samples[i].speed_percent = i < 4u ? static_cast<float>(i) * 10.0f : (i % 2u == 0u ? 41.0f : 39.0f);
+  }
+
+  const ScopeChannelStats stats = reduce_scope_channel(samples, 16u, ScopeChannel::SPEED, 2.0f);
+  assert(stats.settled);
+  assert(stats.settle_ms == 400u);
+  assert(near(stats.mean, 40.0f));
+  assert(near(stats.ripple, 2.0f));
+  assert(near(stats.min, 39.0f));
+  assert(near(stats.max, 41.0f));
+
+  // A band tighter than the ripple never settles; stats fall back to the tail.
+  const ScopeChannelStats tight = reduce_scope_channel(samples, 16u, ScopeChannel::SPEED, 0.5f);
+  assert(!tight.settled);
+  assert(near(tight.mean, 40.0f));
+  assert(near(tight.ripple, 2.0f));
+
+  assert(!reduce_scope_channel(samples, 0u, ScopeChannel::SPEED, 2.0f).settled);
+}
+
+// One 7 s stage on the default 100 ms grid: a speed ramp that only enters the
+// settle band at `settle_ms`, a VM dip until then, and a square-wave ripple
+// after it; the duty command tracks it 30 points higher. A non-zero
+// `fault_ms` latches the fault flag from that slot on.
+void fill_stage(ScopeCapture &capture, uint32_t settle_ms, float ripple, uint32_t fault_ms) {
+  capture.start(0u);
+  for (uint32_t now = 0u; now < 7000u; now += ScopeCapture::DEFAULT_INTERVAL_MS) {
+    const bool settled = now >= settle_ms;
+    const float speed = settled ? 30.0f + (((now / 100u) % 2u) == 0u ? ripple / 2.0f : -ripple / 2.0f)
+                               : 20.0f * static_cast<float>(now) / static_cast<float>(settle_ms);
+    const bool fault = fault_ms != 0u && now >= fault_ms;
+    assert(capture.add(now, speed, speed + 30.0f, 24.0f - (settled ? 0.0f : 1.0f), fault));
+    if (fault) {
+      break;
+    }
+  }
+}
+
+void test_stage_pass_fail() {
+  const ScopeStageLimits limits{};
+  ScopeCapture capture;
+
+  fill_stage(capture, 1500u, 2.0f, 0u);
+  ScopeStageResult result = capture.reduce(limits);
+  assert(result.pass);
+  assert(result.samples == 70u);
+  assert(result.missed == 0u);
+  assert(result.speed.settle_ms == 1500u);
+  // An odd number of settled square-wave samples leaves a small mean bias.
+  assert(near(result.speed.mean, 30.0f, 0.05f));
+  assert(near(result.speed.ripple, 2.0f));
+  assert(near(result.duty.mean, 60.0f, 0.05f));
+  assert(result.vm.settled);
+  assert(near(result.vm.mean, 24.0f));
+
+  fill_stage(capture, 5000u, 2.0f, 0u);
+  assert(!capture.reduce(limits).pass);
+
+  fill_stage(capture, 1500u, 8.0f, 0u);
+  result = capture.reduce(ScopeStageLimits{5.0f, 5.0f, 0.5f, 4000u, 5.0f});
+  assert(result.speed.settled);
+  assert(!result.pass);
+
+  // Samples from the fault on are dropped from the stats.
+  fill_stage(capture, 1000u, 1.0f, 3000u);
+  result = capture.reduce(limits);
+  assert(result.fault);
+  assert(result.fault_ms == 3000u);
+  assert(!result.pass);
+  assert(near(result.speed.mean, 30.0f, 0.05f));
+}
+
+}  // namespace
+
+int main() {
+  test_slot_grid();
+  test_channel_reduction_math();
+  test_stage_pass_fail();
+  return 0;
+}
@@ -0,0 +1,215 @@
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+
+#include "components/mcf8316d/mcf8316d_startup_search.h"
+
+// Runs the startup current search against a simulated motor: codes below the
+// start threshold latch a lock fault, codes at or above it reach closed loop
+// sooner as current rises, overshoot phase current more the further they are
+// above a sweet spot and hold speed less steadily the further they are below
+// it. The clock advances in update-interval steps.
+namespace {
+
+using namespace mcf8316d_core;
+
+constexpr uint16_t STATE_OPEN_LOOP = 0x0007u;
+constexpr uint16_t STATE_CLOSED_LOOP = 0x0009u;
+constexpr uint32_t UPDATE_INTERVAL_MS = 50u;
+
+struct MotorModel {
+  uint8_t start_threshold;
+  uint8_t sweet_spot;
+
+  bool starts(uint8_t code) const { return code >= this->start_threshold; }
+  uint32_t reach_ms(uint8_t code) const {
+    const uint32_t above = static_cast<uint32_t>(code - this->start_threshold);
+    return above >= 10u ? 600u : 2600u - above * 200u;
+  }
+  float overshoot_amps(uint8_t code) const {
+    const int distance = static_cast<int>(code) - static_cast<int>(this->sweet_spot);
+    return distance > 0 ? static_cast<float>(distance) * 0.6f : 0.1f;
+  }
+  float ripple_percent(uint8_t code) const {
+    const int distance = static_cast<int>(code) - static_cast<int>(this->sweet_spot);
+    return distance < 0 ? static_cast<float>(-distance) * 4.0f : 0.5f;
+  }
+};
+
+StartupStepResult run_step(const MotorModel &motor, uint8_t code, uint32_t &now_ms) {
+  StartupStepMonitor monitor;
+  const uint32_t start = now_ms;
+  monitor.start(code, now_ms);
+  while (true) {
+    now_ms += UPDATE_INTERVAL_MS;
+    const uint32_t elapsed = now_ms - start;
+    bool fault = false;
+    uint16_t state = STATE_OPEN_LOOP;
+    float speed_hz = 20.0f;
+    float current_a = 1.0f;
+    if (!motor.starts(code)) {
+      fault = elapsed >= 700u;
+    } else if (elapsed >= motor.reach_ms(code)) {
+      state = STATE_CLOSED_LOOP;
+      const uint32_t in_loop = elapsed - motor.reach_ms(code);
+      // Current overshoots right after handoff; speed settles into a square
+      // ripple around 300 Hz.
+      speed_hz = 300.0f;
+      current_a = 2.0f;
+      if (in_loop < 300u) {
+        current_a += motor.overshoot_amps(code);
+      } else {
+        const float half_ripple_hz = 300.0f * motor.ripple_percent(code) / 200.0f;
+        speed_hz += ((in_loop / UPDATE_INTERVAL_MS) % 2u == 0u) ? half_ripple_hz : -half_ripple_hz;
+      }
+    }
+    if (monitor.sample(now_ms, true, state, fault, true, fault ? regs::FAULT_LOCK_LIMIT : 0u, true, speed_hz,
+                       current_a)) {
+      return monitor.result();
+    }
+  }
+}
+
+uint8_t run_search(StartupCurrentSearch &search, const MotorModel &motor, const StartupSearchConfig &config,
+                   uint32_t &bench_ms) {
+  search.start(config);
+  bench_ms = 0u;
+  uint8_t code = 0u;
+  uint8_t steps = 0u;
+  while (search.next_code(code)) {
+    assert(!search.evaluated(code));
+    search.record(run_step(motor, code, bench_ms));
+    steps++;
+    assert(steps <= STARTUP_CURRENT_CODE_COUNT);
+  }
+  return steps;
+}
+
+uint8_t ceil_log2(uint32_t value) {
+  uint8_t bits = 0u;
+  while ((1u << bits) < value) {
+    bits++;
+  }
+  return bits;
+}
+
+void test_step_reduction_math() {
+  StartupStepMonitor monitor;
+  monitor.start(5u, 0u);
+  assert(!monitor.sample(100u, true, STATE_OPEN_LOOP, false, true, 0u, true, 50.0f, 1.0f));
+  // Closed loop at 1000 ms; current peaks at 3.5 A before settling at 2 A,
+  // speed settles between 294 and 306 Hz. Reverse rotation reads negative.
+  assert(!monitor.sample(1000u, true, STATE_CLOSED_LOOP, false, true, 0u, true, -280.0f, 3.0f));
+  assert(!monitor.sample(1200u, true, STATE_CLOSED_LOOP, false, true, 0u, true, -290.0f, 3.5f));
+  assert(!monitor.sample(1750u, true, STATE_CLOSED_LOOP, false, true, 0u, true, -294.0f, 2.0f));
+  assert(!monitor.sample(2000u, true, STATE_CLOSED_LOOP, false, true, 0u, true, -306.0f, 2.0f));
+  // A failed feedback read is not scored.
+  assert(!monitor.sample(2250u, true, STATE_CLOSED_LOOP, false, true, 0u, false, 0.0f, 9.0f));
+  assert(monitor.sample(2500u, true, STATE_CLOSED_LOOP, false, true, 0u, true, -300.0f, 2.0f));
+
+  const StartupStepResult &result = monitor.result();
+  assert(result.outcome == StartupStepOutcome::PASS);
+  assert(result.reach_ms == 1000u);
+  assert(std::fabs(result.current_overshoot_amps - 1.5f) < 0.001f);
+  assert(std::fabs(result.settled_speed_hz - 300.0f) < 0.001f);
+  assert(std::fabs(result.speed_ripple_percent - 4.0f) < 0.001f);
+  // 1000 ms + 1.5 A * 200 + 4% * 50 + 2.0 A * 100
+  assert(result.score == -(1000 + 300 + 200 + 200));
+}
+
+void test_lock_fault_stops_step_early() {
+  StartupStepMonitor monitor;
+  monitor.start(3u, 0u);
+  assert(!monitor.sample(500u, true, STATE_OPEN_LOOP, false, true, 0u, true, 0.0f, 0.5f));
+  assert(monitor.sample(700u, true, STATE_OPEN_LOOP, true, true, regs::FAULT_MTR_LCK | (1u << 31), true, 0.0f, 0.5f));
+  assert(monitor.result().outcome == StartupStepOutcome::LOCK);
+  assert(monitor.result().score == std::numeric_limits<int32_t>::min());
+
+  monitor.start(3u, 0u);
+  assert(monitor.sample(300u, true, STATE_OPEN_LOOP, true, true, regs::FAULT_MTR_OVER_VOLTAGE, true, 0.0f, 0.5f));
+  assert(monitor.result().outcome == StartupStepOutcome::FAULT);
+
+  monitor.start(3u, 0u);
+  assert(!monitor.sample(3950u, true, STATE_OPEN_LOOP, false, true, 0u, true, 0.0f, 0.5f));
+  assert(monitor.sample(StartupStepMonitor::REACH_TIMEOUT_MS, true, STATE_OPEN_LOOP, false, true, 0u, true, 0.0f, 0.5f));
+  assert(monitor.result().outcome == StartupStepOutcome::STALL);
+}
+
+void test_bisection_finds_lowest_pass_in_log_steps() {
+  const StartupSearchConfig config{0u, 15u, false};
+  const uint8_t linear_steps = STARTUP_CURRENT_CODE_COUNT;
+  const uint8_t log_steps = ceil_log2(STARTUP_CURRENT_CODE_COUNT + 1u);
+  for (uint8_t threshold = 0u; threshold <= STARTUP_CURRENT_CODE_COUNT; threshold++) {
+    StartupCurrentSearch search;
+    uint32_t bench_ms = 0u;
+    const uint8_t steps = run_search(search, MotorModel{threshold, threshold}, config, bench_ms);
+    assert(steps <= log_steps);
+    assert(steps < linear_steps);
+    uint8_t lowest = 0u;
+    if (threshold < STARTUP_CURRENT_CODE_COUNT) {
+      assert(search.lowest_pass(lowest));
+      assert(lowest == threshold);
+    } else {
+      assert(!search.lowest_pass(lowest));
+    }
+  }
+}
+
+void test_refinement_matches_exhaustive_best() {
+  const StartupSearchConfig config{0u, 15u, true};
+  uint32_t total_search_steps = 0u;
+  uint32_t total_linear_steps = 0u;
+  for (uint8_t threshold = 0u; threshold < STARTUP_CURRENT_CODE_COUNT; threshold++) {
+    for (uint8_t sweet = threshold; sweet < STARTUP_CURRENT_CODE_COUNT; sweet++) {
+      const MotorModel motor{threshold, sweet};
+
+      // Exhaustive reference: every code once, as the old linear sweep did.
+      StartupCurrentSearch exhaustive;
+      exhaustive.start(config);
+      uint32_t linear_ms = 0u;
+      for (uint8_t code = 0u; code < STARTUP_CURRENT_CODE_COUNT; code++) {
+        exhaustive.record(run_step(motor, code, linear_ms));
+      }
+      uint8_t expected = 0u;
+      assert(exhaustive.best(expected));
+
+      StartupCurrentSearch search;
+      uint32_t search_ms = 0u;
+      const uint8_t steps = run_search(search, motor, config, search_ms);
+      uint8_t best = 0u;
+      assert(search.best(best));
+      assert(best == expected);
+      assert(steps < STARTUP_CURRENT_CODE_COUNT);
+      assert(search_ms < linear_ms);
+      total_search_steps += steps;
+      total_linear_steps += STARTUP_CURRENT_CODE_COUNT;
+    }
+  }
+  // Bisection plus golden-section averages about half the linear sweep.
+  assert(total_search_steps * 2u <= total_linear_steps + total_linear_steps / 10u);
+}
+
+void test_fault_aborts_search() {
+  StartupCurrentSearch search;
+  search.start(StartupSearchConfig{});
+  uint8_t code = 0u;
+  assert(search.next_code(code));
+  StartupStepResult result{};
+  result.code = code;
+  result.outcome = StartupStepOutcome::FAULT;
+  search.record(result);
+  assert(search.aborted());
+  assert(!search.next_code(code));
+  assert(!search.best(code));
+}
+
+}  // namespace
+
+int main() {
+  test_step_reduction_math();
+  test_lock_fault_stops_step_early();
+  test_bisection_finds_lowest_pass_in_log_steps();
+  test_refinement_matches_exhaustive_best();
+  test_fault_aborts_search();
+  return 0;
+}
@@ -0,0 +1,367 @@
+#include <cassert>
+#include <cstdint>
+#include <map>
+
+#include "components/mcf8329a/mcf8329a_diagnostics.h"
+#include "components/mcf8329a/mcf8329a_poll_service.h"
+
+namespace {
+
+class CountingBus : public mcf83xx_common::RegisterBus {
+ public:
+  bool read_register32(uint16_t offset, uint32_t *value) override {
+    if (value == nullptr) return false;
+    reads[offset]++;
+    total_reads++;
+    *value = registers[offset];
+    return !fail && offset != fail_offset;
+  }
+
+  bool read_register16(uint16_t offset, uint16_t *value) override {
+    if (value == nullptr) return false;
+    reads[offset]++;
+    total_reads++;
+    *value = static_cast<uint16_t>(registers[offset]);
+    return !fail && offset != fail_offset;
+  }
+
+  bool write_register32(uint16_t offset, uint32_t value) override {
+    registers[offset] = value;
+    total_writes++;
+    return true;
+  }
+
+  void delay_microseconds(uint32_t) override {}
+
+  uint32_t count(mcf8329a_core::regs::RegisterId id) { return reads[mcf8329a_core::regs::register_address(id)]; }
+
+  std::map<uint16_t, uint32_t> registers;
+  std::map<uint16_t, uint32_t> reads;
+  uint32_t total_reads{0};
+  uint32_t total_writes{0};
+  bool fail{false};
+  uint16_t fail_offset{0xFFFF};
+};
+
+void test_poll_tiers_follow_register_definitions() {
+  using namespace mcf8329a_core;
+  using namespace mcf8329a_core::regs;
+
+  static_assert(POLL_TIER_REGISTERS[static_cast<size_t>(PollTier::STATUS)].count == 3);
+  static_assert(POLL_TIER_REGISTERS[static_cast<size_t>(PollTier::SPEED)].count == 3);
+  static_assert(POLL_TIER_REGISTERS[static_cast<size_t>(PollTier::SLOW)].count == 4);
+  static_assert(POLL_TIER_REGISTERS[static_cast<size_t>(PollTier::STATUS)].ids[0] == RegisterId::CONTROLLER_FAULT_STATUS);
+  static_assert(poll_tier(RegisterId::CLOSED_LOOP2) == PollTier::NONE);
+}
+
+void test_idle_motor_skips_speed_tier() {
+  using namespace mcf8329a_core;
+  using namespace mcf8329a_core::regs;
+
+  CountingBus bus;
+  MCF8329AService service(&bus);
+  MCF8329APollService poll;
+  poll.set_schedule({.speed_interval_ms = 0, .slow_interval_ms = 5000});
+
+  // One minute at a 50 ms update interval with the motor stopped.
+  for (uint32_t now = 0; now < 60000; now += 50) {
+    poll.poll(service, now, false);
+  }
+
+  assert(poll.stats(PollTier::STATUS).cycles == 1200);
+  assert(poll.stats(PollTier::STATUS).transactions == 3600);
+  assert(poll.stats(PollTier::SPEED).transactions == 0);
+  assert(bus.count(RegisterId::SPEED_FDBK) == 0);
+  // Initial read plus one every 5 s.
+  assert(poll.stats(PollTier::SLOW).cycles == 12);
+  assert(bus.count(RegisterId::VM_VOLTAGE) == 12);
+
+  // Reading all ten registers on every update costs 12000 transactions.
+  assert(bus.total_reads == 3648);
+  assert(bus.total_reads * 2 < 1200u * 10u);
+}
+
+void test_running_motor_polls_speed_at_fast_interval() {
+  using namespace mcf8329a_core;
+  using namespace mcf8329a_core::regs;
+
+  CountingBus bus;
+  MCF8329AService service(&bus);
+  MCF8329APollService poll;
+  poll.set_schedule({.speed_interval_ms = 200, .slow_interval_ms = 5000});
+  bus.registers[register_address(RegisterId::SPEED_FDBK)] = 1234;
+
+  for (uint32_t now = 0; now < 10000; now += 50) {
+    poll.poll(service, now, true);
+    uint32_t speed = 0;
+    if (poll.polled(PollTier::SPEED)) {
+      assert(poll.fresh(RegisterId::SPEED_FDBK, speed));
+      assert(speed == 1234);
+    } else {
+      assert(!poll.fresh(RegisterId::SPEED_FDBK, speed));
+    }
+  }
+  assert(poll.stats(PollTier::SPEED).cycles == 50);
+  assert(bus.count(RegisterId::FG_SPEED_FDBK) == 50);
+
+  // The command is gone but the rotor still coasts: feedback keeps being
+  // polled until it reads zero.
+  poll.poll(service, 10000, false);
+  assert(poll.polled(PollTier::SPEED));
+  bus.registers[register_address(RegisterId::SPEED_FDBK)] = 0;
+  poll.poll(service, 10200, false);
+  assert(poll.polled(PollTier::SPEED));
+  assert(!poll.running(false));
+  const uint32_t speed_reads = bus.count(RegisterId::SPEED_FDBK);
+  for (uint32_t now = 10250; now < 12000; now += 50) {
+    poll.poll(service, now, false);
+  }
+  assert(bus.count(RegisterId::SPEED_FDBK) == speed_reads);
+}
+
+void test_invalidate_and_disable() {
+  using namespace mcf8329a_core;
+  using namespace mcf8329a_core::regs;
+
+  CountingBus bus;
+  MCF8329AService service(&bus);
+  MCF8329APollService poll;
+  poll.set_register_enabled(RegisterId::MTR_PARAMS, false);
+  poll.set_register_enabled(RegisterId::CLOSED_LOOP3, false);
+
+  bus.registers[register_address(RegisterId::CLOSED_LOOP4)] = 0x1111;
+  poll.poll(service, 0, false);
+  assert(poll.polled(PollTier::SLOW));
+  assert(bus.count(RegisterId::MTR_PARAMS) == 0);
+  assert(bus.count(RegisterId::CLOSED_LOOP3) == 0);
+
+  uint32_t value = 0;
+  poll.poll(service, 50, false);
+  assert(!poll.polled(PollTier::SLOW));
+  assert(!poll.fresh(RegisterId::CLOSED_LOOP4, value));
+  assert(poll.cached(RegisterId::CLOSED_LOOP4, value) && value == 0x1111);
+
+  // A write to a slow register refreshes it on the next cycle, not after
+  // the slow interval.
+  bus.registers[register_address(RegisterId::CLOSED_LOOP4)] = 0x2222;
+  poll.invalidate(RegisterId::CLOSED_LOOP4);
+  assert(!poll.cached(RegisterId::CLOSED_LOOP4, value));
+  poll.poll(service, 100, false);
+  assert(poll.fresh(RegisterId::CLOSED_LOOP4, value) && value == 0x2222);
+  assert(poll.stats(PollTier::SLOW).cycles == 2);
+
+  // Failed reads are counted and keep the previous value.
+  bus.fail = true;
+  poll.request(PollTier::SLOW);
+  poll.poll(service, 150, false);
+  assert(!poll.fresh(RegisterId::CLOSED_LOOP4, value));
+  assert(poll.cached(RegisterId::CLOSED_LOOP4, value) && value == 0x2222);
+  assert(poll.stats(PollTier::SLOW).failures == 2);
+  assert(poll.stats(PollTier::STATUS).failures == 3);
+}
+
+void test_closed_loop_rate_encoding() {
+  using namespace mcf8329a_core;
+  using namespace mcf8329a_core::regs;
+
+  assert(encode_closed_loop_rate_code(0.0f) == CLOSED_LOOP_RATE_NO_LIMIT_CODE);
+  assert(decode_closed_loop_rate_hz_per_s(CLOSED_LOOP_RATE_NO_LIMIT_CODE) == 0.0f);
+  assert(encode_closed_loop_rate_code(0.1f) == 0);
+  // 10 %/s of a 900 Hz MAX_SPEED is 90 Hz/s; the ramp never runs faster
+  // than configured, so it rounds down to 80 Hz/s.
+  assert(encode_closed_loop_rate_code(90.0f) == 9);
+  assert(decode_closed_loop_rate_hz_per_s(9) == 80.0f);
+  assert(encode_closed_loop_rate_code(100.0f) == 10);
+  assert(encode_closed_loop_rate_code(1.0e6f) == 30);
+}
+
+void test_hardware_ramp_programs_closed_loop1() {
+  using namespace mcf8329a_core;
+  using namespace mcf8329a_core::regs;
+
+  CountingBus bus;
+  MCF8329AService service(&bus);
+  const uint16_t closed_loop1 = register_address(RegisterId::CLOSED_LOOP1);
+  bus.registers[closed_loop1] = CLOSED_LOOP1_CL_DEC_CONFIG_MASK | 0x3u;
+
+  assert(service.set_closed_loop_ramp(9, 12));
+  const uint32_t value = bus.registers[closed_loop1];
+  assert(((value & CLOSED_LOOP1_CL_ACC_MASK) >> CLOSED_LOOP1_CL_ACC_SHIFT) == 9u);
+  assert(((value & CLOSED_LOOP1_CL_DEC_MASK) >> CLOSED_LOOP1_CL_DEC_SHIFT) == 12u);
+  assert((value & CLOSED_LOOP1_CL_DEC_CONFIG_MASK) == 0u);
+  assert((value & 0x3u) == 0x3u);
+}
+
+// MAX_SPEED comes from CLOSED_LOOP4 whether or not max_speed_hz is set: the
+// device default code 1200 is 200 Hz, so 10 %/s is 20 Hz/s.
+void test_closed_loop_ramp_codes_use_closed_loop4() {
+  using namespace mcf8329a_core;
+  using namespace mcf8329a_core::regs;
+
+  const uint32_t closed_loop4 = (1u << CLOSED_LOOP4_SPD_LOOP_KI_SHIFT) | (1200u << CLOSED_LOOP4_MAX_SPEED_SHIFT);
+  const ClosedLoopRampCodes codes = closed_loop_ramp_codes(closed_loop4, 10.0f, 25.0f);
+  assert(codes.acc == encode_closed_loop_rate_code(20.0f));
+  assert(codes.dec == encode_closed_loop_rate_code(50.0f));
+  assert(codes.acc != CLOSED_LOOP_RATE_NO_LIMIT_CODE && codes.acc < codes.dec);
+
+  // A zero rate is "no limit" rather than the slowest code.
+  assert(closed_loop_ramp_codes(closed_loop4, 0.0f, 0.0f).acc == CLOSED_LOOP_RATE_NO_LIMIT_CODE);
+}
+
+uint32_t speed_command_writes_for_ramp(bool hardware) {
+  using namespace mcf8329a_core;
+  using namespace mcf8329a_core::regs;
+
+  CountingBus bus;
+  MCF8329AService service(&bus);
+  const float up = 10.0f;
+  const float down = 10.0f;
+  if (hardware) {
+    // What apply_motor_config_() programs from the CLOSED_LOOP4 it applied.
+    const ClosedLoopRampCodes codes = closed_loop_ramp_codes(1200u << CLOSED_LOOP4_MAX_SPEED_SHIFT, up, down);
+    assert(service.set_closed_loop_ramp(codes.acc, codes.dec));
+  }
+
+  // 0 -> 100 % and back at 10 %/s with a 50 ms update interval, stepped the
+  // way process_speed_command_ramp_() does.
+  float applied = 0.0f;
+  for (const float target : {100.0f, 0.0f}) {
+    for (uint32_t step = 0; step < 400; step++) {
+      const float next = speed_command_step(hardware, applied, target, up, down, 0.05f);
+      if (next != applied) {
+        assert(service.write_speed_command_raw(static_cast<uint16_t>((next / 100.0f) * 32767.0f)));
+        applied = next;
+      }
+    }
+    assert(applied == target);
+  }
+  return bus.total_writes;
+}
+
+void test_hardware_ramp_write_count() {
+  const uint32_t software = speed_command_writes_for_ramp(false);
+  const uint32_t hardware = speed_command_writes_for_ramp(true);
+  // 200 steps per 10 s ramp in software, one configuration write plus one
+  // target write per change in hardware.
+  assert(software == 400);
+  assert(hardware == 3);
+}
+
+void set_register(CountingBus &bus, mcf8329a_core::regs::RegisterId id, uint32_t value) {
+  bus.registers[mcf8329a_core::regs::register_address(id)] = value;
+}
+
+void test_diagnostic_snapshot_reads_each_register_once() {
+  using namespace mcf8329a_core;
+  using namespace mcf8329a_core::regs;
+
+  CountingBus bus;
+  MCF8329AService service(&bus);
+  MCF8329APollService poll;
+  MCF8329ADiagnosticSnapshot diagnostics;
+  set_register(bus, RegisterId::CONTROLLER_FAULT_STATUS,
+               CONTROLLER_FAULT_ACTIVE_MASK | FAULT_MPET_BEMF | FAULT_HW_LOCK_LIMIT);
+  set_register(bus, RegisterId::ALGORITHM_STATE, 0x0008);
+  set_register(bus, RegisterId::ALGO_DEBUG1, 0x7FFFu << 16);
+  set_register(bus, RegisterId::FAULT_CONFIG1, 7u << FAULT_CONFIG1_ILIMIT_SHIFT);
+  set_register(bus, RegisterId::FAULT_CONFIG2, FAULT_CONFIG2_LOCK1_EN_MASK);
+  set_register(bus, RegisterId::CLOSED_LOOP4, 5u << CLOSED_LOOP4_SPD_LOOP_KI_SHIFT);
+
+  // The first poll also reads the slow tier (MTR_PARAMS, CLOSED_LOOP3/4).
+  poll.poll(service, 0, false);
+  diagnostics.begin(poll);
+  assert(diagnostics.fields().mpet_bemf_active && diagnostics.fields().hw_lock_active);
+  assert(diagnostics.transactions() == 0);
+
+  // What update() does when both fault diagnostics fire and the algorithm
+  // state changed: every group, plus the speed command after the pass.
+  diagnostics.require(service, DIAGNOSTIC_STATUS | DIAGNOSTIC_ALGORITHM_STATE | DIAGNOSTIC_MPET_BEMF |
+                                   DIAGNOSTIC_HW_LOCK);
+  diagnostics.require(service, DIAGNOSTIC_SPEED_COMMAND);
+  diagnostics.require(service, DIAGNOSTIC_ALGORITHM_STATE | DIAGNOSTIC_HW_LOCK);
+
+  for (const auto &entry : bus.reads) {
+    assert(entry.second == 1);
+  }
+  // ALGORITHM_STATE, ALGO_DEBUG1/2, PIN_CONFIG, CLOSED_LOOP2, FAULT_CONFIG1/2.
+  assert(diagnostics.transactions() == 7);
+  assert(bus.count(RegisterId::MTR_PARAMS) == 1);
+  assert(bus.count(RegisterId::CLOSED_LOOP3) == 1);
+  assert(bus.count(RegisterId::CLOSED_LOOP4) == 1);
+  assert(diagnostics.complete(DIAGNOSTIC_MPET_BEMF | DIAGNOSTIC_HW_LOCK | DIAGNOSTIC_ALGORITHM_STATE));
+
+  const DiagnosticFields &fields = diagnostics.fields();
+  assert(fields.algorithm_state == 0x0008);
+  assert(fields.speed_cmd_percent == 100.0f);
+  assert(fields.ilimit == 7);
+  assert(fields.lock1_en && !fields.lock2_en);
+  assert(fields.configured_spd_loop_ki == 5);
+
+  diagnostics.end();
+  uint32_t value = 0;
+  assert(!diagnostics.value(RegisterId::ALGO_DEBUG1, value));
+  assert(!diagnostics.complete(DIAGNOSTIC_STATUS));
+}
+
+void test_diagnostic_snapshot_does_not_retry_failed_reads() {
+  using namespace mcf8329a_core;
+  using namespace mcf8329a_core::regs;
+
+  CountingBus bus;
+  MCF8329AService service(&bus);
+  MCF8329ADiagnosticSnapshot diagnostics;
+  bus.fail_offset = register_address(RegisterId::FAULT_CONFIG2);
+
+  diagnostics.begin();
+  diagnostics.require(service, DIAGNOSTIC_HW_LOCK);
+  diagnostics.require(service, DIAGNOSTIC_HW_LOCK);
+  assert(bus.count(RegisterId::FAULT_CONFIG2) == 1);
+  assert(!diagnostics.complete(DIAGNOSTIC_HW_LOCK));
+  uint32_t value = 0;
+  assert(diagnostics.value(RegisterId::FAULT_CONFIG1, value));
+
+  // The next poll starts over.
+  diagnostics.begin();
+  assert(!diagnostics.value(RegisterId::FAULT_CONFIG1, value));
+  diagnostics.require(service, DIAGNOSTIC_HW_LOCK);
+  assert(bus.count(RegisterId::FAULT_CONFIG2) == 2);
+}
+
+void test_watchdog_tickle_is_one_write() {
+  using namespace mcf8329a_core;
+  using namespace mcf8329a_core::regs;
+
+  CountingBus bus;
+  MCF8329AService service(&bus);
+  const uint32_t forced_align = 90u << 11;
+  set_register(bus, RegisterId::ALGO_CTRL1, forced_align | ALGO_CTRL1_CLR_FLT_MASK);
+
+  uint32_t base = 0;
+  assert(service.read_watchdog_tickle_base(base));
+  assert(base == forced_align);
+  assert(bus.total_reads == 1);
+
+  for (int i = 0; i < 10; i++) {
+    assert(service.tickle_watchdog(base));
+    assert(bus.registers[register_address(RegisterId::ALGO_CTRL1)] == (forced_align | ALGO_CTRL1_WATCHDOG_TICKLE_MASK));
+  }
+  assert(bus.total_reads == 1);
+  assert(bus.total_writes == 10);
+}
+
+}  // namespace
+
+int main() {
+  test_poll_tiers_follow_register_definitions();
+  test_idle_motor_skips_speed_tier();
+  test_running_motor_polls_speed_at_fast_interval();
+  test_invalidate_and_disable();
+  test_closed_loop_rate_encoding();
+  test_hardware_ramp_programs_closed_loop1();
+  test_closed_loop_ramp_codes_use_closed_loop4();
+  test_hardware_ramp_write_count();
+  test_diagnostic_snapshot_reads_each_register_once();
+  test_diagnostic_snapshot_does_not_retry_failed_reads();
+  test_watchdog_tickle_is_one_write();
+  return 0;
+}
@@ -0,0 +1,397 @@
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <set>
+#include <vector>
+
+#include "components/mcf8329a/mcf8329a_tuning_service.h"
+
+// Replays recorded initial-tune runs against the tuning service: the bus
+// serves ALGORITHM_STATE and the speed registers from a per-candidate trace
+// keyed by the MOTOR_STARTUP2 accel/handoff codes, and the clock advances in
+// update-interval steps, so a full sweep runs in milliseconds.
+namespace {
+
+using namespace mcf8329a_core;
+using namespace mcf8329a_core::regs;
+
+constexpr uint16_t STATE_IDLE = 0x0000u;
+constexpr uint16_t STATE_OPEN_LOOP = 0x0007u;
+constexpr uint16_t STATE_CLOSED_LOOP = 0x0008u;
+constexpr float MAX_SPEED_HZ = 1000.0f;
+constexpr uint16_t MAX_SPEED_CODE = 6000u;  // code / 6 = 1000 Hz
+constexpr uint32_t UPDATE_INTERVAL_MS = 50u;
+
+struct TraceSample {
+  uint32_t t_ms;
+  uint16_t algo_state;
+  float fdbk_hz;
+  float fg_hz;
+  bool fault;
+};
+
+using Trace = std::vector<TraceSample>;
+
+uint32_t encode_speed(float hz) { return static_cast<uint32_t>(static_cast<int32_t>(hz / MAX_SPEED_HZ * 134217728.0f)); }
+
+uint16_t trace_key(uint8_t accel_code, uint8_t handoff_code) {
+  return static_cast<uint16_t>((accel_code << 8) | handoff_code);
+}
+
+// Open-loop ramp until `reach_ms`, then closed loop at the given feedback.
+Trace handoff_trace(uint32_t reach_ms, float fdbk_hz, float fg_hz) {
+  return {
+    {0u, STATE_OPEN_LOOP, 0.0f, 0.0f, false},
+    {reach_ms / 2u, STATE_OPEN_LOOP, 60.0f, 60.0f, false},
+    {reach_ms, STATE_CLOSED_LOOP, fdbk_hz, fg_hz, false},
+  };
+}
+
+class ReplayMotor : public mcf83xx_common::RegisterBus, public TuneActuator {
+ public:
+  ReplayMotor() {
+    this->registers[register_address(RegisterId::CLOSED_LOOP4)] = MAX_SPEED_CODE;
+  }
+
+  bool read_register32(uint16_t offset, uint32_t *value) override {
+    if (value == nullptr) return false;
+    const TraceSample sample = this->sample_();
+    if (offset == register_address(RegisterId::SPEED_FDBK)) {
+      *value = encode_speed(sample.fdbk_hz);
+    } else if (offset == register_address(RegisterId::FG_SPEED_FDBK)) {
+      *value = encode_speed(sample.fg_hz);
+    } else if (offset == register_address(RegisterId::SPEED_REF_OPEN_LOOP)) {
+      *value = encode_speed(sample.algo_state == STATE_OPEN_LOOP ? sample.fdbk_hz : 0.0f);
+    } else {
+      *value = this->registers[offset];
+    }
+    return true;
+  }
+
+  bool read_register16(uint16_t offset, uint16_t *value) override {
+    if (value == nullptr) return false;
+    if (offset == register_address(RegisterId::ALGORITHM_STATE)) {
+      *value = this->sample_().algo_state;
+      return true;
+    }
+    *value = static_cast<uint16_t>(this->registers[offset]);
+    return true;
+  }
+
+  bool write_register32(uint16_t offset, uint32_t value) override {
+    this->registers[offset] = value;
+    return true;
+  }
+
+  void delay_microseconds(uint32_t) override {}
+
+  bool start_motor(float percent, const char *) override {
+    assert(percent == MCF8329AInitialTuneService::SPEED_PERCENT);
+    const uint32_t startup2 = this->registers[register_address(RegisterId::MOTOR_STARTUP2)];
+    const uint8_t accel = static_cast<uint8_t>((startup2 & MOTOR_STARTUP2_OL_ACC_A1_MASK) >> MOTOR_STARTUP2_OL_ACC_A1_SHIFT);
+    const uint8_t handoff = static_cast<uint8_t>((startup2 & MOTOR_STARTUP2_OPN_CL_HANDOFF_THR_MASK) >>
+                                                 MOTOR_STARTUP2_OPN_CL_HANDOFF_THR_SHIFT);
+    if (this->refused.count(trace_key(accel, handoff)) != 0u) {
+      return false;
+    }
+    const auto found = this->traces.find(trace_key(accel, handoff));
+    // Unrecorded candidates never leave open loop.
+    this->trace_ = found != this->traces.end() ? &found->second : &this->stuck_open_loop_;
+    this->running_ = true;
+    this->started_ms_ = this->now_ms;
+    this->starts++;
+    return true;
+  }
+
+  void stop_motor(const char *) override {
+    if (this->running_) {
+      this->on_ms += this->now_ms - this->started_ms_;
+    }
+    this->running_ = false;
+  }
+  void clear_faults() override { this->fault_clears++; }
+  void clear_mpet_bits(const char *) override {}
+  bool speed_locked_out() const override { return false; }
+
+  bool fault_active() const { return this->running_ && this->sample_().fault; }
+
+  std::map<uint16_t, Trace> traces;
+  // Candidates whose speed command is refused.
+  std::set<uint16_t> refused;
+  std::map<uint16_t, uint32_t> registers;
+  uint32_t now_ms{0};
+  uint32_t starts{0};
+  uint32_t on_ms{0};
+  uint32_t fault_clears{0};
+
+ protected:
+  TraceSample sample_() const {
+    if (!this->running_ || this->trace_ == nullptr) {
+      return {0u, STATE_IDLE, 0.0f, 0.0f, false};
+    }
+    const uint32_t elapsed = this->now_ms - this->started_ms_;
+    TraceSample sample = this->trace_->front();
+    for (const TraceSample &candidate : *this->trace_) {
+      if (candidate.t_ms <= elapsed) {
+        sample = candidate;
+      }
+    }
+    return sample;
+  }
+
+  Trace stuck_open_loop_{{0u, STATE_OPEN_LOOP, 40.0f, 40.0f, false}};
+  const Trace *trace_{nullptr};
+  bool running_{false};
+  uint32_t started_ms_{0};
+};
+
+struct Decision {
+  TuneEventType type;
+  uint8_t pass;
+  uint8_t accel_code;
+  uint8_t handoff_code;
+  int32_t score;
+  uint32_t reach_ms;
+  const char *reason;
+};
+
+class DecisionLog : public TuneObserver {
+ public:
+  void on_tune_event(const TuneEvent &event) override {
+    if (event.type == TuneEventType::CANDIDATE_APPLY) {
+      this->current = *event.candidate;
+    }
+    if (event.type != TuneEventType::CANDIDATE_SUCCEEDED && event.type != TuneEventType::CANDIDATE_FAILED &&
+        event.type != TuneEventType::CANDIDATE_PRUNED) {
+      return;
+    }
+    this->decisions.push_back({event.type, event.pass, this->current.open_loop_accel_a1_code,
+                               this->current.handoff_code, event.score, event.reach_ms, event.reason});
+  }
+
+  size_t count(TuneEventType type) const {
+    size_t n = 0;
+    for (const Decision &decision : this->decisions) {
+      n += decision.type == type ? 1u : 0u;
+    }
+    return n;
+  }
+
+  TuneCandidate current{};
+  std::vector<Decision> decisions;
+};
+
+TuneReport replay(ReplayMotor &motor, DecisionLog &log, const char *name,
+                  const TuneSearchConfig &search = TuneSearchConfig{}) {
+  MCF8329AService service(&motor);
+  MCF8329AInitialTuneService tune(&motor, &log);
+  tune.set_search(search);
+  tune.start(motor.now_ms);
+  while (tune.active() && motor.now_ms < 600000u) {
+    motor.now_ms += UPDATE_INTERVAL_MS;
+    tune.update(service, motor.fault_active(), motor.now_ms);
+  }
+  assert(!tune.active());
+
+  const TuneReport &report = tune.report();
+  std::printf("  %s: %s in %u ms (motor on %u ms), %u candidate(s), %u pruned, %u cooldown(s) skipped\n", name,
+              report.succeeded ? "tuned" : "failed", static_cast<unsigned>(report.total_ms),
+              static_cast<unsigned>(report.motor_on_ms), static_cast<unsigned>(report.candidates_applied),
+              static_cast<unsigned>(report.candidates_pruned), static_cast<unsigned>(report.cooldowns_skipped));
+  for (size_t i = 1; i < TUNE_STAGE_COUNT; i++) {
+    std::printf("    %-8s %6u ms, motor on %6u ms\n", tune_stage_to_string(static_cast<TuneStage>(i)),
+                static_cast<unsigned>(report.stage_ms[i]), static_cast<unsigned>(report.stage_motor_on_ms[i]));
+  }
+  for (size_t i = 0; i < TUNE_PASS_COUNT; i++) {
+    std::printf("    %-8s %6u ms, motor on %6u ms\n", i == 0 ? "coarse" : "fine", static_cast<unsigned>(report.pass_ms[i]),
+                static_cast<unsigned>(report.pass_motor_on_ms[i]));
+  }
+  for (const Decision &decision : log.decisions) {
+    std::printf("    pass %u accel=%u handoff=%u ", decision.pass, decision.accel_code, decision.handoff_code);
+    if (decision.type == TuneEventType::CANDIDATE_SUCCEEDED) {
+      std::printf("reach=%u ms score=%d\n", static_cast<unsigned>(decision.reach_ms), static_cast<int>(decision.score));
+    } else if (decision.type == TuneEventType::CANDIDATE_PRUNED) {
+      std::printf("pruned at bound %d\n", static_cast<int>(decision.score));
+    } else {
+      std::printf("failed: %s\n", decision.reason);
+    }
+  }
+
+  uint32_t stage_sum = 0;
+  uint32_t stage_motor_on_sum = 0;
+  for (size_t i = 0; i < TUNE_STAGE_COUNT; i++) {
+    stage_sum += report.stage_ms[i];
+    stage_motor_on_sum += report.stage_motor_on_ms[i];
+  }
+  assert(stage_sum == report.total_ms);
+  assert(report.pass_ms[0] + report.pass_ms[1] == report.total_ms);
+  assert(stage_motor_on_sum == report.motor_on_ms);
+  assert(report.pass_motor_on_ms[0] + report.pass_motor_on_ms[1] == report.motor_on_ms);
+  // The motor only runs while a candidate is monitored, and the report agrees
+  // with the time the actuator saw it running.
+  assert(report.motor_on_ms == report.stage_motor_on_ms[static_cast<size_t>(TuneStage::MONITOR)]);
+  assert(report.motor_on_ms == motor.on_ms);
+  return report;
+}
+
+void test_scoring_prefers_fast_clean_handoff() {
+  CandidateQualityMetrics clean{};
+  CandidateQualityMetrics noisy{};
+  for (int i = 0; i < 4; i++) {
+    record_candidate_quality_sample(clean, 110.0f, 108.0f, 112.0f, false);
+    record_candidate_quality_sample(noisy, 110.0f, 90.0f, 130.0f, false);
+  }
+  const TuneCandidate &candidate = TUNE_DISCOVERY_CANDIDATES[0];
+  assert(score_tune_candidate(candidate, 900u, clean) > score_tune_candidate(candidate, 900u, noisy));
+  assert(score_tune_candidate(candidate, 600u, clean) > score_tune_candidate(candidate, 900u, clean));
+  // A handoff without a single sample is worse than a slow one.
+  assert(score_tune_candidate(candidate, 900u, CandidateQualityMetrics{}) <
+         score_tune_candidate(candidate, 5000u, noisy));
+
+  assert(handoff_feedback_stable(110.0f, 108.0f, 112.0f));
+  assert(!handoff_feedback_unstable(110.0f, 108.0f, 112.0f));
+  assert(handoff_feedback_unstable(110.0f, 40.0f, 150.0f));
+  assert(handoff_feedback_unstable(110.0f, 300.0f, 300.0f));
+  assert(!handoff_feedback_stable(110.0f, 10.0f, 10.0f));
+}
+
+void test_replay_refines_to_best_candidate() {
+  ReplayMotor motor;
+  // The coarse pass runs every discovery candidate; the fine passes try
+  // accel +/-1 and handoff +/-2, then handoff +/-1, around the best one.
+  motor.traces[trace_key(10, 13)] = handoff_trace(900u, 108.0f, 112.0f);
+  motor.traces[trace_key(11, 13)] = handoff_trace(600u, 109.0f, 111.0f);
+  motor.traces[trace_key(10, 15)] = handoff_trace(3000u, 108.0f, 112.0f);
+  motor.traces[trace_key(9, 11)] = {
+    {0u, STATE_OPEN_LOOP, 0.0f, 0.0f, false},
+    {200u, STATE_OPEN_LOOP, 30.0f, 30.0f, true},
+  };
+  motor.traces[trace_key(12, 13)] = handoff_trace(400u, 109.0f, 111.0f);
+  DecisionLog log;
+
+  const TuneReport report = replay(motor, log, "coarse to fine");
+
+  assert(report.succeeded);
+  assert(report.best.open_loop_accel_a1_code == 12u);
+  assert(report.best.handoff_code == 13u);
+  assert(report.best_reach_ms == 400u);
+  // 4 coarse, 3 untried neighbours in fine pass 1 and 2 in fine pass 2.
+  assert(report.candidates_applied == 9u);
+  assert(report.candidates_succeeded == 3u);
+  assert(report.candidates_pruned == 5u);
+  assert(report.cooldowns_skipped == 0u);
+  assert(motor.starts == 9u);
+
+  assert(log.decisions.size() == 9u);
+  assert(log.decisions[0].type == TuneEventType::CANDIDATE_SUCCEEDED && log.decisions[0].accel_code == 10u);
+  assert(log.decisions[1].type == TuneEventType::CANDIDATE_SUCCEEDED && log.decisions[1].accel_code == 11u);
+  // Too slow to beat 600 ms: aborted long before its 3 s handoff.
+  assert(log.decisions[2].type == TuneEventType::CANDIDATE_PRUNED && log.decisions[2].handoff_code == 15u);
+  assert(log.decisions[3].type == TuneEventType::CANDIDATE_FAILED);
+  assert(std::strcmp(log.decisions[3].reason, "fault asserted") == 0);
+  assert(log.decisions[4].pass == 1u && log.decisions[4].accel_code == 12u);
+  assert(log.decisions[4].type == TuneEventType::CANDIDATE_SUCCEEDED);
+  for (size_t i = 5; i < 7; i++) {
+    assert(log.decisions[i].pass == 1u && log.decisions[i].type == TuneEventType::CANDIDATE_PRUNED);
+  }
+  for (size_t i = 7; i < 9; i++) {
+    assert(log.decisions[i].pass == 2u && log.decisions[i].type == TuneEventType::CANDIDATE_PRUNED);
+    assert(log.decisions[i].accel_code == 12u);
+    assert(log.decisions[i].handoff_code == 12u || log.decisions[i].handoff_code == 14u);
+  }
+  assert(log.count(TuneEventType::CANDIDATE_PRUNED) == report.candidates_pruned);
+
+  // Every candidate drove the motor, so each one is followed by a cooldown.
+  assert(report.stage_ms[static_cast<size_t>(TuneStage::COOLDOWN)] == 9u * 700u);
+  assert(report.stage_ms[static_cast<size_t>(TuneStage::START)] >= 9u * 250u);
+  // Pruned candidates stop well inside the 2 s open-loop dwell limit.
+  assert(report.stage_ms[static_cast<size_t>(TuneStage::MONITOR)] < 9u * 2000u);
+  assert(report.pass_motor_on_ms[static_cast<size_t>(TunePass::FINE)] > 0u);
+}
+
+void test_replay_reports_failed_discovery() {
+  ReplayMotor motor;
+  motor.refused.insert(trace_key(11, 13));
+  DecisionLog log;
+
+  const TuneReport report = replay(motor, log, "no handoff");
+
+  assert(!report.succeeded);
+  assert(report.candidates_applied == TUNE_DISCOVERY_CANDIDATE_COUNT);
+  assert(report.candidates_pruned == 0u);
+  assert(log.count(TuneEventType::CANDIDATE_FAILED) == TUNE_DISCOVERY_CANDIDATE_COUNT);
+  for (const Decision &decision : log.decisions) {
+    const bool refused = decision.accel_code == 11u && decision.handoff_code == 13u;
+    assert(std::strcmp(decision.reason, refused ? "speed command failed" : "open-loop dwell timeout (heating guard)") ==
+           0);
+  }
+  // The refused candidate never drove current and moves on at the next
+  // update instead of waiting out a cooldown.
+  assert(report.cooldowns_skipped == 1u);
+  assert(report.stage_ms[static_cast<size_t>(TuneStage::COOLDOWN)] ==
+         (TUNE_DISCOVERY_CANDIDATE_COUNT - 1u) * 700u + UPDATE_INTERVAL_MS);
+  // The others ran into their open-loop dwell limit (at least 2 s).
+  assert(report.stage_ms[static_cast<size_t>(TuneStage::MONITOR)] >= (TUNE_DISCOVERY_CANDIDATE_COUNT - 1u) * 2000u);
+  assert(report.pass_ms[static_cast<size_t>(TunePass::FINE)] == 0u);
+  assert(motor.fault_clears == TUNE_DISCOVERY_CANDIDATE_COUNT);
+}
+
+void test_replay_grid_early_termination_saves_time() {
+  TuneSearchConfig search;
+  assert(add_tune_grid_code(search.accel_codes, search.accel_code_count, 10u));
+  assert(add_tune_grid_code(search.accel_codes, search.accel_code_count, 12u));
+  assert(add_tune_grid_code(search.accel_codes, search.accel_code_count, 12u));
+  assert(search.accel_code_count == 2u);
+  assert(add_tune_grid_code(search.handoff_codes, search.handoff_code_count, 13u));
+  assert(add_tune_grid_code(search.handoff_codes, search.handoff_code_count, 17u));
+  search.fine_passes = 1u;
+
+  TuneSearchConfig full_axis;
+  for (uint8_t code = 0u; code < MAX_TUNE_GRID_CODES; code++) {
+    assert(add_tune_grid_code(full_axis.accel_codes, full_axis.accel_code_count, code));
+  }
+  assert(!add_tune_grid_code(full_axis.accel_codes, full_axis.accel_code_count, 15u));
+
+  TuneReport reports[2];
+  for (int pruning = 0; pruning < 2; pruning++) {
+    ReplayMotor motor;
+    motor.traces[trace_key(12, 13)] = handoff_trace(500u, 109.0f, 111.0f);
+    motor.traces[trace_key(10, 13)] = handoff_trace(900u, 108.0f, 112.0f);
+    DecisionLog log;
+    search.early_termination = pruning != 0;
+
+    reports[pruning] = replay(motor, log, pruning != 0 ? "grid, early termination" : "grid, exhaustive", search);
+
+    const TuneReport &report = reports[pruning];
+    assert(report.succeeded);
+    assert(report.best.open_loop_accel_a1_code == 12u && report.best.handoff_code == 13u);
+    // Handoff-major grid order, then accel +/-1 and handoff +/-2 around the
+    // best.
+    assert(log.decisions.size() == 8u);
+    assert(log.decisions[0].accel_code == 10u && log.decisions[0].handoff_code == 13u);
+    assert(log.decisions[1].accel_code == 12u && log.decisions[1].handoff_code == 13u);
+    assert(log.decisions[2].accel_code == 10u && log.decisions[2].handoff_code == 17u);
+    assert(log.decisions[3].accel_code == 12u && log.decisions[3].handoff_code == 17u);
+    assert(log.decisions[4].pass == 1u && log.decisions[4].accel_code == 13u);
+    assert(log.decisions[5].handoff_code == 15u && log.decisions[6].handoff_code == 11u);
+    assert(log.decisions[7].accel_code == 11u);
+    assert(report.candidates_pruned == (pruning != 0 ? 6u : 0u));
+  }
+  assert(reports[1].total_ms < reports[0].total_ms);
+  assert(reports[1].motor_on_ms < reports[0].motor_on_ms);
+  std::printf("  early termination saved %u ms of tune time and %u ms of motor-on time\n",
+              static_cast<unsigned>(reports[0].total_ms - reports[1].total_ms),
+              static_cast<unsigned>(reports[0].motor_on_ms - reports[1].motor_on_ms));
+}
+
+}  // namespace
+
+int main() {
+  test_scoring_prefers_fast_clean_handoff();
+  test_replay_refines_to_best_candidate();
+  test_replay_reports_failed_discovery();
+  test_replay_grid_early_termination_saves_time();
+  return 0;
+}
@@ -1,10 +1,16 @@
 #include <cassert>
+#include <cmath>
 #include <cstdint>
+#include <map>
 #include <utility>
 #include <vector>
 
+#include "components/mcf83xx_common/comms_bringup.h"
 #include "components/mcf83xx_common/protocol.h"
 #include "components/mcf83xx_common/register_access.h"
+#include "components/mcf83xx_common/speed_command.h"
+#include "components/mcf83xx_common/tuning_record.h"
+#include "components/mcf83xx_common/watchdog_tickle.h"
 
 namespace {
 
@@ -43,6 +49,31 @@ class FakeBus : public mcf83xx_common::RegisterBus {
   std::vector<uint32_t> delays;
 };
 
+// Register file covering several offsets, for fingerprint and record tests.
+class MapBus : public mcf83xx_common::RegisterBus {
+ public:
+  bool read_register32(uint16_t offset, uint32_t *value) override {
+    const auto it = registers.find(offset);
+    if (value == nullptr || it == registers.end()) return false;
+    *value = it->second;
+    return true;
+  }
+
+  bool read_register16(uint16_t, uint16_t *) override { return false; }
+
+  bool write_register32(uint16_t offset, uint32_t value) override {
+    if (registers.find(offset) == registers.end()) return false;
+    registers[offset] = value;
+    ++write_count;
+    return true;
+  }
+
+  void delay_microseconds(uint32_t) override {}
+
+  std::map<uint16_t, uint32_t> registers;
+  int write_count{0};
+};
+
 void test_protocol_frames() {
   using mcf83xx_common::RegisterWidth;
 
@@ -97,10 +128,329 @@ void test_register_access() {
   assert(!missing.write32(bus.register_offset, 1U));
 }
 
+void test_configuration_fingerprint() {
+  MapBus bus;
+  bus.registers = {{0x0080, 0x11110000U}, {0x0082, 0x0000ABCDU}};
+  mcf83xx_common::RegisterAccess access(&bus);
+  const mcf83xx_common::FingerprintRegister registers[] = {{0x0080, 0xFFFFFFFFU}, {0x0082, 0xFFFF00FFU}};
+
+  uint32_t base = 0;
+  uint32_t again = 0;
+  assert(mcf83xx_common::read_configuration_fingerprint(access, 0x8329AU, 7U, registers, 2U, base));
+  assert(mcf83xx_common::read_configuration_fingerprint(access, 0x8329AU, 7U, registers, 2U, again));
+  assert(base == again);
+
+  // Masked-out (tuned) bits do not move the fingerprint.
+  bus.registers[0x0082] = 0x0000A0CDU;
+  assert(mcf83xx_common::read_configuration_fingerprint(access, 0x8329AU, 7U, registers, 2U, again));
+  assert(base == again);
+
+  uint32_t other = 0;
+  bus.registers[0x0080] = 0x11110001U;
+  assert(mcf83xx_common::read_configuration_fingerprint(access, 0x8329AU, 7U, registers, 2U, other));
+  assert(other != base);
+  bus.registers[0x0080] = 0x11110000U;
+  assert(mcf83xx_common::read_configuration_fingerprint(access, 0x8316DU, 7U, registers, 2U, other));
+  assert(other != base);
+  assert(mcf83xx_common::read_configuration_fingerprint(access, 0x8329AU, 8U, registers, 2U, other));
+  assert(other != base);
+
+  const mcf83xx_common::FingerprintRegister missing[] = {{0x0084, 0xFFFFFFFFU}};
+  assert(!mcf83xx_common::read_configuration_fingerprint(access, 0x8329AU, 7U, missing, 1U, other));
+}
+
+void test_tuning_record() {
+  using mcf83xx_common::TuningResultKind;
+
+  mcf83xx_common::TuningRecord record{};
+  assert(!mcf83xx_common::tuning_record_valid(record));
+  mcf83xx_common::begin_tuning_record(record, 0x1234U);
+  assert(mcf83xx_common::add_tuned_field(record, 0x0080, 0x000000F0U, 0x000000A5U));
+  assert(mcf83xx_common::add_tuned_field(record, 0x0082, 0x0000FF00U, 0x00001200U));
+  // A second field of the same register merges into its entry.
+  assert(mcf83xx_common::add_tuned_field(record, 0x0080, 0x0000000FU, 0x00000003U));
+  assert(record.count == 2U);
+  assert(record.registers[0].mask == 0x000000FFU);
+  assert(record.registers[0].value == 0x000000A3U);
+  mcf83xx_common::note_tuning_run(record, TuningResultKind::STARTUP, 41000U);
+  mcf83xx_common::seal_tuning_record(record);
+
+  assert(mcf83xx_common::tuning_record_matches(record, 0x1234U));
+  assert(!mcf83xx_common::tuning_record_matches(record, 0x1235U));
+  assert(mcf83xx_common::tuning_record_has(record, TuningResultKind::STARTUP));
+  assert(!mcf83xx_common::tuning_record_has(record, TuningResultKind::MPET));
+  assert(mcf83xx_common::tuning_record_time_saved_ms(record) == 41000U);
+
+  // Another run on the same configuration extends the record.
+  mcf83xx_common::TuningRecord extended = record;
+  mcf83xx_common::begin_tuning_record(extended, 0x1234U);
+  assert(extended.count == 2U);
+  assert(mcf83xx_common::add_tuned_field(extended, 0x0084, 0xFFU, 0x42U));
+  mcf83xx_common::note_tuning_run(extended, TuningResultKind::MPET, 90000U);
+  mcf83xx_common::seal_tuning_record(extended);
+  assert(mcf83xx_common::tuning_record_time_saved_ms(extended) == 131000U);
+
+  // A run on a different configuration starts over.
+  mcf83xx_common::TuningRecord replaced = extended;
+  mcf83xx_common::begin_tuning_record(replaced, 0x9999U);
+  assert(replaced.count == 0U && replaced.kinds == 0U && replaced.fingerprint == 0x9999U);
+
+  mcf83xx_common::TuningRecord corrupt = record;
+  corrupt.registers[1].value ^= 0x100U;
+  assert(!mcf83xx_common::tuning_record_valid(corrupt));
+
+  mcf83xx_common::TuningRecord full{};
+  for (size_t index = 0; index < mcf83xx_common::MAX_TUNED_REGISTERS; ++index) {
+    assert(mcf83xx_common::add_tuned_field(full, static_cast<uint16_t>(index * 2U), 1U, 1U));
+  }
+  assert(!mcf83xx_common::add_tuned_field(full, 0x0100, 1U, 1U));
+  assert(mcf83xx_common::add_tuned_field(full, 0x0000, 2U, 2U));
+
+  MapBus bus;
+  bus.registers = {{0x0080, 0xFFFF0000U}, {0x0082, 0x00000000U}};
+  mcf83xx_common::RegisterAccess access(&bus);
+  assert(mcf83xx_common::apply_tuning_record(access, record));
+  assert(bus.registers[0x0080] == 0xFFFF00A3U);
+  assert(bus.registers[0x0082] == 0x00001200U);
+  assert(bus.write_count == 2);
+  // Fields already in place cost no writes.
+  assert(mcf83xx_common::apply_tuning_record(access, record));
+  assert(bus.write_count == 2);
+  assert(!mcf83xx_common::apply_tuning_record(access, extended));
+}
+
+class FakeProbe : public mcf83xx_common::CommsProbe {
+ public:
+  bool ack_address(uint8_t address) override {
+    ++acks;
+    return present && (address == target || address == other);
+  }
+  bool probe_target() override {
+    ++probes;
+    return registers_ok;
+  }
+
+  uint8_t target{0x01};
+  uint8_t other{0x40};
+  bool present{true};
+  bool registers_ok{true};
+  uint32_t acks{0};
+  uint32_t probes{0};
+};
+
+void test_comms_bringup_backoff_and_deadline() {
+  using mcf83xx_common::CommsEvent;
+  using mcf83xx_common::CommsState;
+
+  FakeProbe probe;
+  probe.present = false;
+  mcf83xx_common::CommsBringup comms;
+  mcf83xx_common::CommsBringupConfig config;
+  config.initial_backoff_ms = 10;
+  config.max_backoff_ms = 1000;
+  config.deadline_ms = 5000;
+  comms.start(config, probe.target, 100);
+
+  // Attempts at 0, 10, 30, 70, ... ms: each step costs at most one probe.
+  std::vector<uint32_t> attempt_times;
+  uint32_t now = 100;
+  for (; now < 100 + 5000; now++) {
+    const uint32_t before = probe.acks;
+    const mcf83xx_common::CommsStep step = comms.step(probe, now);
+    assert(probe.acks - before <= 1);
+    if (step.event == CommsEvent::ATTEMPT_FAILED) {
+      attempt_times.push_back(now - 100);
+    }
+  }
+  const std::vector<uint32_t> expected = {0, 10, 30, 70, 150, 310, 630, 1270, 2270, 3270, 4270};
+  assert(attempt_times == expected);
+  assert(comms.state() == CommsState::CONNECTING);
+
+  // The first attempt at or past the deadline defers to the backoff ceiling.
+  mcf83xx_common::CommsStep step{};
+  for (; step.event == CommsEvent::NONE; now++) {
+    step = comms.step(probe, now);
+  }
+  assert(step.event == CommsEvent::DEADLINE_EXPIRED);
+  assert(now - 1 - 100 == 5270);
+  assert(comms.state() == CommsState::DEFERRED);
+  assert(comms.retry_delay_ms() == 1000);
+
+  probe.present = true;
+  for (step = {}; step.event == CommsEvent::NONE; now++) {
+    step = comms.step(probe, now);
+  }
+  assert(step.event == CommsEvent::ESTABLISHED);
+  assert(now - 1 - 100 == 6270);
+  uint32_t first_ack_ms = 0;
+  assert(comms.first_ack_ms(first_ack_ms) && first_ack_ms == 6270);
+  assert(comms.established_ms() == 6270);
+  assert(comms.attempts() == 13);
+  assert(comms.step(probe, now + 5000).event == CommsEvent::NONE);
+}
+
+void test_comms_bringup_scan() {
+  using mcf83xx_common::CommsEvent;
+  using mcf83xx_common::CommsState;
+
+  FakeProbe probe;
+  probe.registers_ok = false;
+  mcf83xx_common::CommsBringup comms;
+  mcf83xx_common::CommsBringupConfig config;
+  config.scan = true;
+  config.scan_first_address = 0x00;
+  config.scan_last_address = 0x7F;
+  config.scan_addresses_per_step = 8;
+  config.deadline_ms = 0;
+  comms.start(config, probe.target, 0);
+
+  // 128 addresses in chunks of 8.
+  for (int i = 0; i < 15; i++) {
+    assert(comms.step(probe, 0).event == CommsEvent::NONE);
+    assert(comms.state() == CommsState::SCANNING);
+  }
+  assert(comms.step(probe, 0).event == CommsEvent::SCAN_DONE);
+  assert(probe.acks == 128);
+  assert(comms.scan_found_count() == 2);
+  assert(comms.scan_found(0x01) && comms.scan_found(0x40) && !comms.scan_found(0x02));
+  uint32_t first_ack_ms = 1;
+  assert(comms.first_ack_ms(first_ack_ms) && first_ack_ms == 0);
+
+  // The target ACKs but its registers do not answer.
+  const mcf83xx_common::CommsStep step = comms.step(probe, 1);
+  assert(step.event == CommsEvent::DEADLINE_EXPIRED && step.acked);
+
+  // Deferred mode rescans at its interval before the next attempt.
+  assert(comms.step(probe, 1000).event == CommsEvent::NONE);
+  assert(comms.step(probe, 5000).event == CommsEvent::NONE);
+  assert(comms.state() == CommsState::SCANNING);
+  mcf83xx_common::CommsStep rescan{};
+  while (rescan.event == CommsEvent::NONE) {
+    rescan = comms.step(probe, 5000);
+  }
+  assert(rescan.event == CommsEvent::SCAN_DONE);
+  assert(comms.state() == CommsState::DEFERRED);
+  probe.registers_ok = true;
+  assert(comms.step(probe, 5001).event == CommsEvent::ESTABLISHED);
+}
+
+void test_watchdog_tickle_schedule() {
+  mcf83xx_common::WatchdogTickleScheduler watchdog;
+  mcf83xx_common::WatchdogTickleConfig config;
+  config.period_ms = 500;
+  config.timeout_ms = 1000;
+  config.retry_ms = 50;
+  assert(!watchdog.due(0));
+  watchdog.start(config, 100);
+  assert(!watchdog.due(99) && watchdog.due(100));
+
+  watchdog.record(100, true);
+  assert(!watchdog.due(599) && watchdog.due(600));
+  uint32_t margin = 0;
+  assert(!watchdog.window_min_margin_ms(margin));
+
+  // 30 ms late: jitter 30, 470 ms of the timeout left.
+  watchdog.record(630, true);
+  assert(watchdog.stats().last_jitter_ms == 30);
+  assert(watchdog.stats().last_margin_ms == 470);
+  assert(watchdog.due_ms() == 1130);
+
+  // A failed write retries soon instead of waiting a whole period.
+  watchdog.record(1130, false);
+  assert(watchdog.stats().failures == 1);
+  assert(!watchdog.due(1179) && watchdog.due(1180));
+  watchdog.record(1180, true);
+  assert(watchdog.stats().last_jitter_ms == 50);
+  assert(watchdog.stats().last_margin_ms == 450);
+
+  // An overrunning caller that lands past the timeout counts as a miss.
+  watchdog.record(2300, true);
+  assert(watchdog.stats().misses == 1);
+  assert(watchdog.stats().last_margin_ms == 0);
+  assert(watchdog.stats().max_jitter_ms == 620);
+  assert(watchdog.stats().tickles == 4);
+  assert(watchdog.mean_jitter_ms() == (0 + 30 + 50 + 620) / 4);
+
+  assert(watchdog.window_max_jitter_ms() == 620);
+  assert(watchdog.window_min_margin_ms(margin) && margin == 0);
+  watchdog.reset_window();
+  assert(watchdog.window_max_jitter_ms() == 0 && !watchdog.window_min_margin_ms(margin));
+  assert(watchdog.stats().min_margin_ms == 0);
+
+  watchdog.stop();
+  assert(!watchdog.due(10000));
+}
+
+void test_speed_command_encoding() {
+  using namespace mcf83xx_common;
+  static_assert(SPEED_COMMAND_MASK == 0xFFFF0000u);
+  static_assert(speed_command_value(0x7FFF) == 0xFFFF0000u);
+  static_assert(speed_command_value(0) == SPEED_OVERRIDE_MASK);
+  assert(speed_percent_to_code(100.0f) == 0x7FFF);
+  assert(speed_percent_to_code(150.0f) == 0x7FFF);
+  assert(speed_percent_to_code(-5.0f) == 0);
+  assert(speed_percent_to_code(50.0f) == 16384);
+  assert(std::fabs(speed_code_to_percent(speed_percent_to_code(37.5f)) - 37.5f) < 0.01f);
+}
+
+void test_speed_command_ramp() {
+  mcf83xx_common::SpeedCommandRamp ramp;
+  float next = 0.0f;
+
+  // With neither a ramp nor a boost the caller writes the target directly.
+  assert(!ramp.start(40.0f, 0.0f, 1000));
+  assert(!ramp.active() && !ramp.step(0.0f, 1100, next));
+
+  mcf83xx_common::SpeedRampConfig config;
+  config.up_percent_per_s = 10.0f;
+  config.down_percent_per_s = 20.0f;
+  ramp.set_config(config);
+  assert(ramp.start(25.0f, 0.0f, 1000));
+  assert(ramp.step(0.0f, 2000, next) && std::fabs(next - 10.0f) < 0.001f);
+  ramp.settle(next);
+  assert(ramp.active());
+  assert(ramp.step(10.0f, 4000, next) && std::fabs(next - 25.0f) < 0.001f);
+  ramp.settle(next);
+  assert(!ramp.active());
+
+  // Down at its own rate; zero always writes directly.
+  assert(ramp.start(5.0f, 25.0f, 5000));
+  assert(ramp.step(25.0f, 5500, next) && std::fabs(next - 15.0f) < 0.001f);
+  assert(!ramp.start(0.0f, 15.0f, 5600) && !ramp.active());
+
+  // The hardware ramp slews on the chip; only a start boost is timed here.
+  config.hardware = true;
+  ramp.set_config(config);
+  assert(!ramp.start(25.0f, 0.0f, 6000));
+  config.start_boost_percent = 30.0f;
+  config.start_boost_hold_ms = 500;
+  ramp.set_config(config);
+  assert(!ramp.start(25.0f, 10.0f, 6000));
+  assert(ramp.start(25.0f, 0.0f, 6000));
+  assert(ramp.step(0.0f, 6100, next) && next == 30.0f);
+  ramp.settle(next);
+  assert(ramp.active());
+  assert(!ramp.step(30.0f, 6400, next));
+  assert(ramp.step(30.0f, 6500, next) && next == 25.0f);
+  ramp.settle(next);
+  assert(!ramp.active());
+
+  assert(ramp.start(25.0f, 0.0f, 7000));
+  ramp.cancel();
+  assert(!ramp.active() && !ramp.step(0.0f, 7100, next));
+}
+
 }  // namespace
 
 int main() {
   test_protocol_frames();
   test_register_access();
+  test_configuration_fingerprint();
+  test_tuning_record();
+  test_comms_bringup_backoff_and_deadline();
+  test_comms_bringup_scan();
+  test_watchdog_tickle_schedule();
+  test_speed_command_encoding();
+  test_speed_command_ramp();
   return 0;
 }
@@ -0,0 +1,292 @@
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <map>
+
+#include "components/mcf8316d/mcf8316d_diagnostics.h"
+#include "components/mcf8316d/mcf8316d_poll_service.h"
+#include "components/mcf8329a/mcf8329a_diagnostics.h"
+#include "components/mcf8329a/mcf8329a_poll_service.h"
+
+namespace {
+
+class CountingBus : public mcf83xx_common::RegisterBus {
+ public:
+  bool read_register32(uint16_t offset, uint32_t *value) override {
+    if (value == nullptr) return false;
+    reads[offset]++;
+    total_reads++;
+    *value = registers[offset];
+    return true;
+  }
+
+  bool read_register16(uint16_t offset, uint16_t *value) override {
+    if (value == nullptr) return false;
+    reads[offset]++;
+    total_reads++;
+    *value = static_cast<uint16_t>(registers[offset]);
+    return true;
+  }
+
+  bool write_register32(uint16_t offset, uint32_t value) override {
+    registers[offset] = value;
+    written_bits |= value;
+    total_writes++;
+    return true;
+  }
+
+  void delay_microseconds(uint32_t) override {}
+
+  std::map<uint16_t, uint32_t> registers;
+  std::map<uint16_t, uint32_t> reads;
+  uint32_t total_reads{0};
+  uint32_t total_writes{0};
+  uint32_t written_bits{0};
+};
+
+constexpr size_t tier_index(mcf83xx_common::PollTier tier) { return static_cast<size_t>(tier); }
+
+// One poll schedule drives both chips; only the per-chip tables differ.
+template<typename Poll, typename Service>
+void check_status_only_poll(size_t status_count, size_t slow_count, typename Poll::RegisterId status_id) {
+  using mcf83xx_common::PollTier;
+
+  CountingBus bus;
+  Service service(&bus);
+  Poll poll;
+  poll.set_schedule({0, 5000});
+
+  // The first poll after reset() reads every non-empty tier the motor state allows.
+  poll.reset();
+  poll.poll(service, 0, false);
+  assert(poll.polled(PollTier::STATUS));
+  assert(poll.polled(PollTier::SLOW));
+  assert(!poll.polled(PollTier::SPEED));
+  assert(bus.total_reads == status_count + slow_count);
+
+  // Idle polls inside the slow interval cost the status tier alone.
+  for (uint32_t now = 250; now < 5000; now += 250) {
+    const uint32_t before = bus.total_reads;
+    poll.poll(service, now, false);
+    assert(bus.total_reads - before == status_count);
+    assert(!poll.polled(PollTier::SLOW));
+  }
+  uint32_t value = 0;
+  assert(poll.fresh(status_id, value));
+
+  poll.poll(service, 5000, false);
+  assert(poll.polled(PollTier::SLOW));
+  assert(poll.stats(PollTier::SLOW).cycles == 2);
+}
+
+template<typename Service> void check_tickle_is_one_write(uint16_t address, uint32_t clear_fault, uint32_t tickle) {
+  CountingBus bus;
+  Service service(&bus);
+  const uint32_t config_bits = 0x5u << 11;
+  bus.registers[address] = config_bits | clear_fault;
+
+  uint32_t base = 0;
+  assert(service.read_watchdog_tickle_base(base));
+  assert(base == config_bits);
+  for (int i = 0; i < 4; i++) {
+    assert(service.tickle_watchdog(base));
+    assert(bus.registers[address] == (config_bits | tickle));
+  }
+  assert(bus.total_reads == 1);
+  assert(bus.total_writes == 4);
+}
+
+void test_tier_tables() {
+  using mcf83xx_common::PollTier;
+
+  static_assert(mcf8316d_core::POLL_TIER_REGISTERS[tier_index(PollTier::STATUS)].count == 3);
+  static_assert(mcf8316d_core::POLL_TIER_REGISTERS[tier_index(PollTier::SPEED)].count == 0);
+  static_assert(mcf8316d_core::POLL_TIER_REGISTERS[tier_index(PollTier::SLOW)].count == 1);
+  static_assert(
+    mcf8316d_core::POLL_TIER_REGISTERS[tier_index(PollTier::SLOW)].ids[0] == mcf8316d_core::regs::RegisterId::VM_VOLTAGE
+  );
+  static_assert(mcf8329a_core::POLL_TIER_REGISTERS[tier_index(PollTier::STATUS)].count == 3);
+}
+
+void test_mcf8316d_poll() {
+  check_status_only_poll<mcf8316d_core::MCF8316DPollService, mcf8316d_core::MCF8316DService>(
+    3, 1, mcf8316d_core::regs::RegisterId::ALGO_STATUS
+  );
+
+  // Without speed feedback a commanded motor still never polls the empty speed tier.
+  CountingBus bus;
+  mcf8316d_core::MCF8316DService service(&bus);
+  mcf8316d_core::MCF8316DPollService poll;
+  poll.poll(service, 0, true);
+  assert(!poll.polled(mcf83xx_common::PollTier::SPEED));
+  assert(poll.running(true));
+  assert(!poll.running(false));
+}
+
+void test_mcf8329a_poll() {
+  check_status_only_poll<mcf8329a_core::MCF8329APollService, mcf8329a_core::MCF8329AService>(
+    3, 4, mcf8329a_core::regs::RegisterId::ALGO_STATUS
+  );
+}
+
+void test_watchdog_tickles() {
+  {
+    using namespace mcf8316d_core::regs;
+    check_tickle_is_one_write<mcf8316d_core::MCF8316DService>(
+      register_info(RegisterId::ALGO_CTRL1).address,
+      ALGO_CTRL1_CLR_FLT_MASK,
+      ALGO_CTRL1_WATCHDOG_TICKLE_MASK
+    );
+  }
+  {
+    using namespace mcf8329a_core::regs;
+    check_tickle_is_one_write<mcf8329a_core::MCF8329AService>(
+      register_address(RegisterId::ALGO_CTRL1),
+      ALGO_CTRL1_CLR_FLT_MASK,
+      ALGO_CTRL1_WATCHDOG_TICKLE_MASK
+    );
+  }
+}
+
+// MCF8316D datasheet Section 9.3.1, Table 9-13 (mcf8316d.txt): CLR_FLT is
+// bit 29 and WATCHDOG_TICKLE bit 10. FORCED_ALIGN_ANGLE (19:11) and STL_KEY
+// (8:1) are settings that a tickle or a fault clear must carry over.
+void test_mcf8316d_algo_ctrl1_follows_table_9_13() {
+  using namespace mcf8316d_core::regs;
+  static_assert(ALGO_CTRL1_CLR_FLT_MASK == (1u << 29));
+  static_assert(ALGO_CTRL1_CLR_FLT_RETRY_COUNT_MASK == (1u << 28));
+  static_assert(ALGO_CTRL1_EEPROM_WRITE_ACCESS_KEY_MASK == 0x0FF00000u);
+  static_assert(ALGO_CTRL1_WATCHDOG_TICKLE_MASK == (1u << 10));
+  static_assert(ALGO_CTRL1_STL_CMD_MASK == (1u << 9));
+  static_assert(ALGO_CTRL1_COMMAND_MASK == (0xFFF00000u | (1u << 10) | (1u << 9)));
+
+  const uint16_t address = register_info(RegisterId::ALGO_CTRL1).address;
+  const uint32_t settings = (395u << 11) | (0xBEu << 1);
+  static_assert((settings & ALGO_CTRL1_COMMAND_MASK) == 0u);
+
+  CountingBus bus;
+  mcf8316d_core::MCF8316DService service(&bus);
+  bus.registers[address] = settings;
+  assert(service.pulse_clear_faults());
+  assert(bus.total_writes == 2);
+  assert((bus.written_bits & ~settings) == ALGO_CTRL1_CLR_FLT_MASK);
+  assert(bus.registers[address] == settings);
+
+  uint32_t base = 0;
+  assert(service.read_watchdog_tickle_base(base) && base == settings);
+  assert(service.tickle_watchdog(base));
+  assert(bus.registers[address] == (settings | ALGO_CTRL1_WATCHDOG_TICKLE_MASK));
+}
+
+// MCF8316D datasheet Section 9.5, Table 9-23 (mcf8316d.txt): speed feedback
+// is a Q27 fraction of MAX_SPEED (code / 6 Hz), phase currents signed Q27
+// times 10/8 A.
+void test_mcf8316d_feedback_follows_table_9_23() {
+  using namespace mcf8316d_core::regs;
+  static_assert(register_address(RegisterId::FG_SPEED_FDBK) == 0x0194);
+  static_assert(register_address(RegisterId::BUS_CURRENT) == 0x040C);
+  static_assert(register_address(RegisterId::PHASE_CURRENT_A) == 0x0444);
+  static_assert(register_address(RegisterId::PHASE_CURRENT_B) == 0x0446);
+  static_assert(register_address(RegisterId::PHASE_CURRENT_C) == 0x0448);
+  static_assert(register_address(RegisterId::SPEED_FDBK) == 0x0782);
+
+  CountingBus bus;
+  mcf8316d_core::MCF8316DService service(&bus);
+  bus.registers[register_address(RegisterId::CLOSED_LOOP4)] = 0x2710u;
+  const float max_speed_hz = mcf8316d_core::read_max_speed_hz(service, 0.0f);
+  assert(std::fabs(max_speed_hz - 10000.0f / 6.0f) < 0.01f);
+
+  // Half of MAX_SPEED in reverse on the estimator, a quarter on FG.
+  bus.registers[register_address(RegisterId::SPEED_FDBK)] = static_cast<uint32_t>(-(1 << 26));
+  bus.registers[register_address(RegisterId::FG_SPEED_FDBK)] = 1u << 25;
+  float fdbk_hz = 0.0f;
+  float fg_hz = 0.0f;
+  assert(mcf8316d_core::read_speed_pair_hz(service, max_speed_hz, fdbk_hz, fg_hz));
+  assert(std::fabs(fdbk_hz + max_speed_hz / 2.0f) < 0.01f);
+  assert(std::fabs(fg_hz - max_speed_hz / 4.0f) < 0.01f);
+  assert(!mcf8316d_core::read_speed_pair_hz(service, 0.0f, fdbk_hz, fg_hz));
+
+  // 1.0 A, -2.5 A and 0.5 A: the peak is the largest magnitude.
+  bus.registers[register_address(RegisterId::PHASE_CURRENT_A)] = 0x06666666u;
+  bus.registers[register_address(RegisterId::PHASE_CURRENT_B)] = static_cast<uint32_t>(-(1 << 28));
+  bus.registers[register_address(RegisterId::PHASE_CURRENT_C)] = 0x03333333u;
+  float peak_a = 0.0f;
+  assert(mcf8316d_core::read_phase_current_peak_amps(service, peak_a));
+  assert(std::fabs(peak_a - 2.5f) < 0.001f);
+}
+
+// The MCF8316D fault publisher and diagnostic logs read through the same
+// snapshot as MCF8329A: polled registers cost nothing and a register shared by
+// several groups is read once per poll.
+void test_mcf8316d_diagnostic_snapshot() {
+  using namespace mcf8316d_core;
+  CountingBus bus;
+  MCF8316DService service(&bus);
+  MCF8316DPollService poll;
+  MCF8316DDiagnosticSnapshot diagnostics;
+  bus.registers[regs::register_address(regs::RegisterId::ALGO_STATUS)] = 0x1234u;
+
+  poll.reset();
+  poll.poll(service, 0, false);
+  const uint32_t poll_reads = bus.total_reads;
+  diagnostics.begin(poll);
+  assert(!diagnostics.require(service, DIAGNOSTIC_STATUS));
+  uint32_t algo_status = 0;
+  assert(diagnostics.value(regs::RegisterId::ALGO_STATUS, algo_status) && algo_status == 0x1234u);
+
+  const DiagnosticGroups every_log = DIAGNOSTIC_ALGORITHM_STATE | DIAGNOSTIC_LOCK_MODE | DIAGNOSTIC_LOCK_LIMIT |
+                                     DIAGNOSTIC_CONTROL | DIAGNOSTIC_BUCK | DIAGNOSTIC_MPET_ENTRY | DIAGNOSTIC_MPET;
+  assert(diagnostics.require(service, DIAGNOSTIC_LOCK_MODE));
+  assert(diagnostics.transactions() == 2);
+  assert(diagnostics.require(service, every_log));
+  assert(diagnostics.transactions() == 21);
+  assert(bus.total_reads - poll_reads == diagnostics.transactions());
+  assert(!diagnostics.require(service, every_log | DIAGNOSTIC_STATUS));
+  assert(diagnostics.complete(every_log | DIAGNOSTIC_STATUS));
+  for (const auto &[address, count] : bus.reads) {
+    assert(count == 1);
+  }
+
+  diagnostics.end();
+  assert(!diagnostics.valid(regs::RegisterId::ALGO_STATUS));
+}
+
+// Both chips put the same speed command into ALGO_DEBUG1 and keep its low
+// debug bits.
+void test_speed_command_matches_across_chips() {
+  const uint32_t low_bits = 0x0000C0DEu;
+  for (const float percent : {-5.0f, 0.0f, 12.5f, 50.0f, 99.99f, 100.0f, 150.0f}) {
+    CountingBus bus_8316d;
+    mcf8316d_core::MCF8316DService mcf8316d(&bus_8316d);
+    const uint16_t address_8316d = mcf8316d_core::regs::register_address(mcf8316d_core::regs::RegisterId::ALGO_DEBUG1);
+    bus_8316d.registers[address_8316d] = low_bits;
+    assert(mcf8316d.write_speed_command_percent(percent));
+
+    CountingBus bus_8329a;
+    mcf8329a_core::MCF8329AService mcf8329a(&bus_8329a);
+    const uint16_t address_8329a = mcf8329a_core::regs::register_address(mcf8329a_core::regs::RegisterId::ALGO_DEBUG1);
+    bus_8329a.registers[address_8329a] = low_bits;
+    assert(mcf8329a.write_speed_command_raw(mcf83xx_common::speed_percent_to_code(percent)));
+
+    assert(bus_8316d.registers[address_8316d] == bus_8329a.registers[address_8329a]);
+    assert((bus_8316d.registers[address_8316d] & ~mcf83xx_common::SPEED_COMMAND_MASK) == low_bits);
+  }
+  CountingBus bus;
+  mcf8316d_core::MCF8316DService service(&bus);
+  assert(!service.write_speed_command_percent(NAN));
+  assert(bus.total_writes == 0);
+}
+
+}  // namespace
+
+int main() {
+  test_tier_tables();
+  test_mcf8316d_poll();
+  test_mcf8329a_poll();
+  test_watchdog_tickles();
+  test_mcf8316d_algo_ctrl1_follows_table_9_13();
+  test_mcf8316d_feedback_follows_table_9_23();
+  test_mcf8316d_diagnostic_snapshot();
+  test_speed_command_matches_across_chips();
+  return 0;
+}
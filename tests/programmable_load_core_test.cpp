@@ -1,7 +1,12 @@
+#include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <cmath>
+#include <cstdio>
 #include <cstring>
+#include <vector>
 
+#include "../components/programmable_load/calibration_store.h"
 #include "../components/programmable_load/programmable_load_core.h"
 
 namespace core = programmable_load_core;
@@ -155,6 +160,871 @@ void test_multi_fault_detection_and_clear_conditions() {
       false, false));
 }
 
+void test_control_diagnostics() {
+  core::ControlSummaryAccumulator accumulator;
+  assert(accumulator.take().samples == 0u);
+
+  const float errors[] = {-0.2f, 0.1f, 0.4f};
+  const float intervals[] = {0.04f, 0.05f, 0.06f};
+  for (int index = 0; index < 3; index++) {
+    core::ControlSample sample{};
+    sample.sequence = static_cast<uint32_t>(index + 1);
+    sample.error_a = errors[index];
+    sample.command_a = 1.0f + index;
+    sample.integrator_a = 0.5f * index;
+    sample.dt_s = intervals[index];
+    accumulator.add(sample);
+  }
+  const core::ControlSummary summary = accumulator.take();
+  assert(summary.samples == 3u);
+  assert(std::fabs(summary.error_a.minimum + 0.2f) < 0.0001f);
+  assert(std::fabs(summary.error_a.maximum - 0.4f) < 0.0001f);
+  assert(std::fabs(summary.error_a.mean - 0.1f) < 0.0001f);
+  assert(std::fabs(summary.command_a.mean - 2.0f) < 0.0001f);
+  assert(std::fabs(summary.integrator_a.maximum - 1.0f) < 0.0001f);
+  assert(std::fabs(summary.dt_s.mean - 0.05f) < 0.0001f);
+  assert(std::fabs(summary.dt_jitter_s - 0.008165f) < 0.0001f);
+  assert(accumulator.samples() == 0u);
+
+  core::ControlSampleBuffer<4> buffer;
+  for (uint32_t sequence = 1; sequence <= 6; sequence++) {
+    core::ControlSample sample{};
+    sample.sequence = sequence;
+    assert(buffer.push(sample) == (sequence <= 4));
+  }
+  assert(buffer.size() == 4u);
+  assert(buffer.take_dropped() == 2u);
+  assert(buffer.take_dropped() == 0u);
+
+  core::ControlSample sample{};
+  assert(buffer.pop(&sample) && sample.sequence == 1u);
+  core::ControlSample wrapped{};
+  wrapped.sequence = 7;
+  assert(buffer.push(wrapped));
+  for (uint32_t expected : {2u, 3u, 4u, 7u}) {
+    assert(buffer.pop(&sample) && sample.sequence == expected);
+  }
+  assert(!buffer.pop(&sample));
+}
+
+void test_current_controller() {
+  core::ControlTuning tuning{};
+  core::CurrentController controller;
+  core::ControlSample sample{};
+
+  // The command is slew-limited toward the feed-forward target.
+  assert(controller.step(tuning, 5.0f, 0.0f, 40.0f, 0.05f, &sample));
+  assert(std::fabs(controller.command_a() - 0.1f) < 0.0001f);
+  assert(std::fabs(sample.target_a - 5.0f) < 0.0001f);
+  assert(std::fabs(sample.error_a - 5.0f) < 0.0001f);
+  assert(sample.command_a == controller.command_a());
+
+  // The request is clamped to the effective limit.
+  for (int step = 0; step < 200; step++) {
+    assert(controller.step(tuning, 50.0f, 3.0f, 4.0f, 0.05f, &sample));
+  }
+  assert(controller.command_a() <= 4.0f);
+  assert(sample.target_a == 4.0f);
+
+  controller.reset();
+  assert(controller.command_a() == 0.0f && controller.integrator_a() == 0.0f);
+}
+
+void test_channel_control_tick() {
+  using Action = core::ControlAction;
+  const core::ControlTuning tuning{};
+  core::ChannelControl control;
+  core::ControlTickInput input{};
+  input.requested_a = 5.0f;
+  input.measured_valid = true;
+  input.current_limit_a = 40.0f;
+  input.current_sequence = 1;
+  input.current_timestamp_ms = 1000;
+  input.control_period_ms = 50;
+  core::ControlSample sample{};
+
+  // The first sample steps by the control period.
+  core::ControlTick tick = control.tick(tuning, input, &sample);
+  assert(tick.action == Action::DRIVE);
+  assert(sample.sequence == 1 && std::fabs(sample.dt_s - 0.05f) < 0.0001f);
+  assert(std::fabs(control.command_a() - 0.1f) < 0.0001f);
+
+  // The same sample is never used twice; the next one steps by its age.
+  assert(control.tick(tuning, input, &sample).action == Action::HOLD);
+  input.current_sequence = 2;
+  input.current_timestamp_ms = 1100;
+  assert(control.tick(tuning, input, &sample).action == Action::DRIVE);
+  assert(std::fabs(sample.dt_s - 0.1f) < 0.0001f);
+
+  // A sample older than a second is dropped without a step.
+  input.current_sequence = 3;
+  input.current_timestamp_ms = 3000;
+  const float before = control.command_a();
+  assert(control.tick(tuning, input, nullptr).action == Action::HOLD);
+  assert(control.command_a() == before);
+
+  // An active charger turns the output off and restarts the controller.
+  input.charger_active = true;
+  input.current_sequence = 4;
+  assert(control.tick(tuning, input, nullptr).action == Action::OUTPUT_OFF);
+  assert(control.command_a() == 0.0f);
+  input.charger_active = false;
+  assert(control.tick(tuning, input, nullptr).action == Action::HOLD);
+
+  input.charger_control_mismatch = true;
+  tick = control.tick(tuning, input, nullptr);
+  assert(tick.action == Action::TRIP && tick.fault == core::Fault::CHARGER_CONTROL_ERROR);
+  input.charger_control_mismatch = false;
+  input.measured_valid = false;
+  tick = control.tick(tuning, input, nullptr);
+  assert(tick.action == Action::TRIP && tick.fault == core::Fault::CONTROL_ERROR);
+}
+
+struct Channel {
+  core::OperationLock lock{};
+  core::ChannelControl control{};
+  core::ControlTickInput input{};
+  core::Measurement measurement{};
+  core::FaultFlags faults{0u};
+  uint32_t ticks{0};
+};
+
+// One control period of one channel as its component runs it: the running
+// fault check, then the channel's control tick on a fresh current sample,
+// with the simulated current following the command.
+void run_channel(Channel &channel, const core::HardwareLimits &hardware,
+                 const core::Limits &limits,
+                 const core::Calibration &calibration,
+                 const core::ControlTuning &tuning) {
+  if (channel.faults != 0u) return;
+  channel.faults = core::detect_safety_faults(
+      channel.measurement, hardware, limits, tuning.deadband_a, false,
+      channel.input.charger_control_mismatch);
+  if (channel.faults == 0u) {
+    channel.input.measured_a = channel.measurement.current_a;
+    channel.input.measured_valid = channel.measurement.current_valid;
+    channel.input.current_limit_a =
+        core::effective_current_limit(channel.measurement, limits, calibration);
+    channel.input.current_sequence++;
+    channel.input.current_timestamp_ms += 50;
+    const core::ControlTick tick =
+        channel.control.tick(tuning, channel.input, nullptr);
+    channel.ticks++;
+    if (tick.action == core::ControlAction::TRIP) {
+      channel.faults = core::fault_flag(tick.fault);
+    } else if (tick.action == core::ControlAction::DRIVE) {
+      channel.measurement.current_a = channel.control.command_a();
+      channel.measurement.power_w =
+          channel.measurement.current_a * channel.measurement.voltage_v;
+    }
+  }
+  if (channel.faults != 0u) {
+    channel.lock.force_release();
+    channel.control.reset(channel.input.current_sequence,
+                          channel.input.current_timestamp_ms);
+  }
+}
+
+std::vector<Channel> make_channels(std::size_t count) {
+  std::vector<Channel> channels(count);
+  for (Channel &channel : channels) {
+    channel.measurement.current_valid = true;
+    channel.measurement.voltage_valid = true;
+    channel.measurement.temperature_valid = true;
+    channel.measurement.voltage_v = 48.0f;
+    channel.measurement.maximum_temperature_c = 30.0f;
+    channel.input.requested_a = 10.0f;
+    channel.input.control_period_ms = 50;
+    assert(channel.lock.acquire_procedure(&channel));
+  }
+  return channels;
+}
+
+void test_channels_are_isolated_and_scale_linearly() {
+  core::HardwareLimits hardware{};
+  core::Limits limits{};
+  limits.maximum_current_a = 40.0f;
+  limits.minimum_voltage_v = 10.0f;
+  limits.maximum_voltage_v = 60.0f;
+  limits.maximum_power_w = 1000.0f;
+  limits.maximum_temperature_c = 90.0f;
+  const core::Calibration calibration = valid_calibration();
+  const core::ControlTuning tuning{};
+
+  // A fault on one channel stops only that channel.
+  std::vector<Channel> channels = make_channels(3);
+  channels[0].measurement.voltage_v = 70.0f;
+  for (int pass = 0; pass < 10; pass++) {
+    for (Channel &channel : channels)
+      run_channel(channel, hardware, limits, calibration, tuning);
+  }
+  assert(core::has_fault(channels[0].faults, core::Fault::INPUT_OVERVOLTAGE));
+  assert(channels[0].lock.owner() == core::OperationOwner::NONE);
+  assert(channels[0].control.command_a() == 0.0f);
+  assert(channels[1].faults == 0u);
+  assert(channels[1].lock.owner() == core::OperationOwner::PROCEDURE);
+  const float running_a = channels[1].control.command_a();
+  assert(running_a > 0.0f);
+  // A control-path trip on another channel leaves the runner's state alone.
+  channels[2].input.charger_control_mismatch = true;
+  run_channel(channels[2], hardware, limits, calibration, tuning);
+  run_channel(channels[1], hardware, limits, calibration, tuning);
+  assert(core::has_fault(channels[2].faults, core::Fault::CHARGER_CONTROL_ERROR));
+  assert(channels[1].faults == 0u && channels[1].control.command_a() > running_a);
+
+  // Per-channel work of one scheduler pass must not grow with channel count:
+  // every channel takes exactly one control tick per pass and ends where a
+  // lone channel does. The timings are printed for reference only.
+  constexpr int PASSES = 20000;
+  constexpr int REPEATS = 5;
+  double per_channel_ns[2]{};
+  const std::size_t counts[2] = {1, 8};
+  float single_command_a = 0.0f;
+  for (int index = 0; index < 2; index++) {
+    double best = 0.0;
+    for (int repeat = 0; repeat < REPEATS; repeat++) {
+      std::vector<Channel> timed = make_channels(counts[index]);
+      const auto started = std::chrono::steady_clock::now();
+      for (int pass = 0; pass < PASSES; pass++) {
+        for (Channel &channel : timed)
+          run_channel(channel, hardware, limits, calibration, tuning);
+      }
+      const auto elapsed = std::chrono::duration<double, std::nano>(
+                               std::chrono::steady_clock::now() - started)
+                               .count();
+      if (index == 0) single_command_a = timed[0].control.command_a();
+      for (const Channel &channel : timed) {
+        assert(channel.faults == 0u);
+        assert(channel.ticks == static_cast<uint32_t>(PASSES));
+        assert(channel.control.command_a() == single_command_a);
+      }
+      const double value = elapsed / (PASSES * counts[index]);
+      best = repeat == 0 ? value : std::min(best, value);
+    }
+    per_channel_ns[index] = best;
+  }
+  std::printf("  per-channel loop cost: 1 channel %.1f ns, 8 channels %.1f ns\n",
+              per_channel_ns[0], per_channel_ns[1]);
+}
+
+class TestCharger final : public component_common::ChargerInterface {
+ public:
+  component_common::ChargerCapabilities capabilities() const override {
+    this->capability_calls++;
+    return this->capabilities_;
+  }
+  bool request_enabled(bool) override { return true; }
+  void publish(const component_common::ChargerSnapshot &snapshot) {
+    this->publish_snapshot_(snapshot);
+  }
+
+  component_common::ChargerCapabilities capabilities_{true, true, true,
+                                                      true, true, true};
+  mutable uint32_t capability_calls{0};
+};
+
+component_common::ChargerSnapshot charger_sample(uint32_t timestamp_ms) {
+  component_common::ChargerSnapshot sample{};
+  sample.valid = true;
+  sample.enabled = true;
+  sample.current_a = 1.5f;
+  sample.voltage_v = 16.0f;
+  sample.timestamp_ms = timestamp_ms;
+  return sample;
+}
+
+// The copy the component made every loop before chargers published sequence
+// numbers; kept as the benchmark baseline.
+core::ChargerMeasurement copy_charger_measurement(
+    const component_common::ChargerInterface &charger, uint32_t now_ms,
+    uint32_t timeout_ms) {
+  const auto capabilities = charger.capabilities();
+  if (!capabilities.enable_control || !capabilities.battery_current ||
+      !capabilities.battery_voltage || !capabilities.charge_state ||
+      !capabilities.power_good || !capabilities.fault_status) {
+    return {};
+  }
+  core::ChargerMeasurement measurement = charger.snapshot();
+  const bool fresh = measurement.timestamp_ms != 0 &&
+                     (uint32_t) (now_ms - measurement.timestamp_ms) <=
+                         timeout_ms;
+  measurement.valid = measurement.valid && fresh &&
+                      std::isfinite(measurement.current_a) &&
+                      std::isfinite(measurement.voltage_v);
+  return measurement;
+}
+
+void test_charger_sample_tracker() {
+  constexpr uint32_t TIMEOUT_MS = 1000;
+  TestCharger charger;
+  core::ChargerSampleTracker tracker;
+
+  assert(!tracker.update(nullptr, 0, TIMEOUT_MS));
+  assert(!tracker.measurement().valid);
+
+  // Nothing published yet: the first update still takes the empty snapshot.
+  assert(tracker.update(&charger, 100, TIMEOUT_MS));
+  assert(!tracker.measurement().valid);
+  assert(!tracker.update(&charger, 110, TIMEOUT_MS));
+
+  charger.publish(charger_sample(200));
+  assert(tracker.update(&charger, 250, TIMEOUT_MS));
+  assert(tracker.measurement().valid && tracker.measurement().sequence == 1);
+  assert(!tracker.update(&charger, 300, TIMEOUT_MS));
+  assert(tracker.measurement().valid);
+
+  // Without a new sample the held one goes stale.
+  assert(!tracker.update(&charger, 1201, TIMEOUT_MS));
+  assert(!tracker.measurement().valid);
+  charger.publish(charger_sample(1300));
+  assert(tracker.update(&charger, 1301, TIMEOUT_MS));
+  assert(tracker.measurement().valid && tracker.measurement().sequence == 2);
+
+  component_common::ChargerSnapshot bad = charger_sample(1400);
+  bad.current_a = NAN;
+  charger.publish(bad);
+  assert(tracker.update(&charger, 1400, TIMEOUT_MS));
+  assert(!tracker.measurement().valid);
+
+  // A charger missing a required capability never yields a valid sample.
+  TestCharger limited;
+  limited.capabilities_.fault_status = false;
+  limited.publish(charger_sample(100));
+  core::ChargerSampleTracker limited_tracker;
+  assert(limited_tracker.update(&limited, 100, TIMEOUT_MS));
+  assert(!limited_tracker.measurement().valid);
+  assert(!limited_tracker.update(&limited, 110, TIMEOUT_MS));
+
+  // The loop runs far faster than the charger polls. The tracker must match
+  // the per-loop copy while copying, and calling the charger's virtual
+  // capabilities(), only when sample_sequence() has moved. The timings are
+  // printed for reference only.
+  constexpr int LOOPS = 200000;
+  constexpr int LOOPS_PER_SAMPLE = 100;
+  constexpr uint32_t SAMPLES = LOOPS / LOOPS_PER_SAMPLE;
+  constexpr int REPEATS = 5;
+  double loop_ns[2]{};
+  for (int mode = 0; mode < 2; mode++) {
+    double best = 0.0;
+    for (int repeat = 0; repeat < REPEATS; repeat++) {
+      TestCharger timed;
+      core::ChargerSampleTracker timed_tracker;
+      uint32_t valid_loops = 0;
+      uint32_t copies = 0;
+      uint32_t moved = 0;
+      uint32_t seen_sequence = 0;
+      const auto started = std::chrono::steady_clock::now();
+      for (int loop = 0; loop < LOOPS; loop++) {
+        const uint32_t now = static_cast<uint32_t>(loop) + 1;
+        if (loop % LOOPS_PER_SAMPLE == 0) timed.publish(charger_sample(now));
+        if (mode == 0) {
+          valid_loops += copy_charger_measurement(timed, now, TIMEOUT_MS).valid;
+        } else {
+          const bool copied = timed_tracker.update(&timed, now, TIMEOUT_MS);
+          const bool sequence_moved = timed.sample_sequence() != seen_sequence;
+          assert(copied == sequence_moved);
+          seen_sequence = timed.sample_sequence();
+          copies += copied;
+          moved += sequence_moved;
+          valid_loops += timed_tracker.measurement().valid;
+        }
+      }
+      const auto elapsed = std::chrono::duration<double, std::nano>(
+                               std::chrono::steady_clock::now() - started)
+                               .count();
+      assert(valid_loops == static_cast<uint32_t>(LOOPS));
+      if (mode == 0) {
+        assert(timed.capability_calls == static_cast<uint32_t>(LOOPS));
+      } else {
+        assert(moved == SAMPLES && copies == SAMPLES);
+        assert(timed.capability_calls == SAMPLES);
+      }
+      const double value = elapsed / LOOPS;
+      best = repeat == 0 ? value : std::min(best, value);
+    }
+    loop_ns[mode] = best;
+  }
+  std::printf("  charger sample per loop: copy %.1f ns, sequence %.1f ns\n",
+              loop_ns[0], loop_ns[1]);
+}
+
+void test_fan_controller() {
+  core::FanTuning tuning;
+  tuning.start_temperature_c = 35.0f;
+  tuning.full_temperature_c = 70.0f;
+  tuning.target_temperature_c = 50.0f;
+  tuning.hysteresis_c = 3.0f;
+  tuning.minimum_duty = 0.2f;
+  tuning.kick_start_duty = 1.0f;
+  tuning.kick_start_ms = 1000;
+  tuning.write_threshold = 0.02f;
+  core::FanController fan;
+
+  // The first update always writes so the output starts from a known level.
+  assert(fan.update(tuning, 30.0f, 0.0f, 0, 0.5f));
+  assert(!fan.running() && fan.level() == 0.0f);
+  assert(!fan.update(tuning, 34.0f, 0.0f, 500, 0.5f));
+
+  // Starting the fan kicks it at full duty, then settles to minimum duty.
+  assert(fan.update(tuning, 35.0f, 0.0f, 1000, 0.5f));
+  assert(fan.running() && fan.level() == 1.0f);
+  assert(!fan.update(tuning, 35.0f, 0.0f, 1500, 0.5f));
+  assert(fan.update(tuning, 35.0f, 0.0f, 2000, 0.5f));
+  assert(std::fabs(fan.level() - tuning.minimum_duty) < 1e-6f);
+
+  // Hysteresis: the fan keeps running until 3 degC below the start point.
+  assert(!fan.update(tuning, 33.0f, 0.0f, 2500, 0.5f));
+  assert(fan.running());
+  assert(fan.update(tuning, 32.0f, 0.0f, 3000, 0.5f));
+  assert(!fan.running() && fan.level() == 0.0f);
+  assert(!fan.update(tuning, 34.9f, 0.0f, 3500, 0.5f));
+
+  // Small changes are suppressed; the full-duty endpoint is always written.
+  tuning.kick_start_ms = 0;
+  assert(fan.update(tuning, 51.0f, 0.0f, 4000, 0.5f));
+  const float settled = fan.level();
+  assert(!fan.update(tuning, 51.1f, 0.0f, 4500, 0.5f));
+  assert(std::fabs(fan.level() - settled) < tuning.write_threshold);
+  assert(fan.update(tuning, 70.0f, 0.0f, 5000, 0.5f));
+  assert(fan.level() == 1.0f);
+
+  // Losing the regulated temperature drives the fallback level directly.
+  assert(!fan.update(tuning, NAN, 1.0f, 5500, 0.5f));
+  assert(fan.update(tuning, NAN, 0.0f, 6000, 0.5f));
+  assert(fan.level() == 0.0f && fan.integrator() == 0.0f);
+}
+
+// Lumped heatsink model: one thermal mass, passive conduction to ambient and
+// forced convection proportional to fan speed. A stalled fan only starts when
+// driven at or above its start duty.
+struct Heatsink {
+  float temperature_c{25.0f};
+  bool fan_spinning{false};
+
+  void step(float power_w, float duty, float dt_s) {
+    constexpr float AMBIENT_C = 25.0f;
+    constexpr float CAPACITY_J_PER_C = 400.0f;
+    constexpr float PASSIVE_W_PER_C = 1.5f;
+    constexpr float FAN_W_PER_C = 10.0f;
+    constexpr float STALL_DUTY = 0.15f;
+    constexpr float START_DUTY = 0.5f;
+    if (duty < STALL_DUTY) this->fan_spinning = false;
+    if (duty >= START_DUTY) this->fan_spinning = true;
+    const float airflow = this->fan_spinning ? duty : 0.0f;
+    const float conductance = PASSIVE_W_PER_C + FAN_W_PER_C * airflow;
+    this->temperature_c +=
+        (power_w - conductance * (this->temperature_c - AMBIENT_C)) * dt_s /
+        CAPACITY_J_PER_C;
+  }
+};
+
+struct FanRun {
+  uint32_t writes{0};
+  float overshoot_c{0.0f};
+  float settled_error_c{0.0f};
+};
+
+template<typename Policy> FanRun run_fan_thermal_model(Policy policy) {
+  // One hour at the 500 ms fan period: idle, a long 150 W soak, a 300 W step,
+  // then idle again. Readings carry 1/16 degC quantization and a small
+  // deterministic noise term, as a real sensor would.
+  constexpr uint32_t PERIOD_MS = 500;
+  constexpr uint32_t STEPS = 3600u * 1000u / PERIOD_MS;
+  constexpr float TARGET_C = 50.0f;
+  Heatsink heatsink;
+  FanRun run;
+  uint32_t noise = 1;
+  float duty = 0.0f;
+  for (uint32_t step = 0; step < STEPS; step++) {
+    const uint32_t now_ms = step * PERIOD_MS;
+    const float power_w = now_ms < 600000u    ? 0.0f
+                          : now_ms < 2400000u ? 150.0f
+                          : now_ms < 3000000u ? 300.0f
+                                              : 0.0f;
+    noise = noise * 1664525u + 1013904223u;
+    const float jitter_c = ((noise >> 16) % 5u) * 0.05f - 0.1f;
+    const float reading_c =
+        std::round((heatsink.temperature_c + jitter_c) * 16.0f) / 16.0f;
+    if (policy(reading_c, now_ms, PERIOD_MS / 1000.0f, &duty)) run.writes++;
+    for (int substep = 0; substep < 5; substep++) {
+      heatsink.step(power_w, duty, PERIOD_MS / 5000.0f);
+    }
+    if (now_ms >= 600000u && now_ms < 3000000u) {
+      run.overshoot_c =
+          std::max(run.overshoot_c, heatsink.temperature_c - TARGET_C);
+    }
+    if (now_ms == 2399500u) {
+      run.settled_error_c = std::fabs(heatsink.temperature_c - TARGET_C);
+    }
+  }
+  return run;
+}
+
+void test_fan_thermal_model() {
+  // Legacy open-loop curve: linear from 35 to 70 degC, written every period.
+  const FanRun linear = run_fan_thermal_model(
+      [](float temperature_c, uint32_t, float, float *duty) {
+        *duty = std::max(0.0f, std::min(1.0f, (temperature_c - 35.0f) / 35.0f));
+        return true;
+      });
+
+  core::FanTuning tuning;
+  tuning.target_temperature_c = 50.0f;
+  core::FanController fan;
+  const FanRun closed_loop = run_fan_thermal_model(
+      [&](float temperature_c, uint32_t now_ms, float dt_s, float *duty) {
+        const bool write = fan.update(tuning, temperature_c, 0.0f, now_ms, dt_s);
+        if (write) *duty = fan.level();
+        return write;
+      });
+
+  std::printf("  fan linear curve: overshoot %.2f degC, %u writes/h\n",
+              linear.overshoot_c, linear.writes);
+  std::printf("  fan PI:           overshoot %.2f degC, settled error %.2f "
+              "degC, %u writes/h\n",
+              closed_loop.overshoot_c, closed_loop.settled_error_c,
+              closed_loop.writes);
+  assert(closed_loop.writes == fan.writes());
+  assert(closed_loop.writes * 10u < linear.writes);
+  assert(closed_loop.overshoot_c < 5.0f);
+  assert(closed_loop.overshoot_c * 2.0f < linear.overshoot_c);
+  assert(closed_loop.settled_error_c < 1.0f);
+}
+
+void test_thermal_derating() {
+  core::ThermalDeratingConfig config;
+  config.enabled = true;
+  config.thermal_resistance_c_per_w = 0.1f;
+  config.time_constant_s = 100.0f;
+  config.horizon_s = 100.0f;
+  config.margin_c = 5.0f;
+  core::Limits limits{};
+  limits.maximum_temperature_c = 80.0f;
+  core::Measurement measurement{};
+  measurement.current_valid = true;
+  measurement.voltage_valid = true;
+  measurement.voltage_v = 50.0f;
+  measurement.current_a = 0.0f;
+  measurement.power_w = 0.0f;
+  measurement.maximum_temperature_c = 25.0f;
+  core::ThermalDerating derating;
+
+  // Cold and idle: 50 degC of headroom allows more than the static limit.
+  derating.update(config, measurement, limits, 0.05f);
+  assert(derating.allowed_power_w() > 750.0f);
+  assert(derating.apply(config, measurement, 10.0f) == 10.0f);
+  assert(derating.derating_a() == 0.0f);
+
+  // Close to the threshold the same headroom allows less than the request.
+  measurement.maximum_temperature_c = 74.0f;
+  derating.update(config, measurement, limits, 0.05f);
+  const float allowed_w = 1.0f / (0.1f * (1.0f - std::exp(-1.0f)));
+  assert(std::fabs(derating.allowed_power_w() - allowed_w) < 0.1f);
+  const float limit = derating.apply(config, measurement, 20.0f);
+  assert(std::fabs(limit - allowed_w / 50.0f) < 0.01f);
+  assert(std::fabs(derating.derating_a() - (20.0f - limit)) < 1e-5f);
+
+  // Without a valid temperature the prediction is withheld; the overtemperature
+  // and missing-temperature faults remain the authority.
+  measurement.maximum_temperature_c = NAN;
+  derating.update(config, measurement, limits, 0.05f);
+  assert(derating.apply(config, measurement, 20.0f) == 20.0f);
+  config.enabled = false;
+  measurement.maximum_temperature_c = 79.0f;
+  derating.update(config, measurement, limits, 0.05f);
+  assert(derating.apply(config, measurement, 20.0f) == 20.0f);
+}
+
+struct DischargeRun {
+  uint32_t trips{0};
+  uint32_t first_trip_s{0};
+  float peak_temperature_c{0.0f};
+  float maximum_derating_a{0.0f};
+  double derated_seconds{0.0};
+  double delivered_ah{0.0};
+};
+
+DischargeRun run_high_power_discharge(bool derate) {
+  // Eight hours of 10 A discharge from a 58 V to 44 V pack through a heatsink
+  // whose true resistance and time constant differ from the configured model
+  // by 20-25 %. Ambient drifts by 8 degC and the temperature sensor lags the
+  // heatsink by 5 s with 1/16 degC resolution.
+  constexpr float DT_S = 0.05f;
+  constexpr uint32_t STEPS = static_cast<uint32_t>(8.0f * 3600.0f / DT_S);
+  constexpr float TRUE_RESISTANCE_C_PER_W = 0.12f;
+  constexpr float TRUE_TIME_CONSTANT_S = 300.0f;
+  constexpr float SENSOR_LAG_S = 5.0f;
+
+  core::Limits limits{};
+  limits.maximum_current_a = 12.0f;
+  limits.maximum_voltage_v = 60.0f;
+  limits.maximum_power_w = 600.0f;
+  limits.maximum_temperature_c = 80.0f;
+  core::HardwareLimits hardware{};
+  const auto calibration = valid_calibration();
+  core::ThermalDeratingConfig config;
+  config.enabled = derate;
+  config.thermal_resistance_c_per_w = 0.15f;
+  config.time_constant_s = 240.0f;
+  core::ThermalDerating derating;
+  core::CurrentController controller;
+  const core::ControlTuning tuning{};
+
+  DischargeRun run;
+  float heatsink_c = 25.0f;
+  float sensor_c = 25.0f;
+  float current_a = 0.0f;
+  bool tripped = false;
+  core::Measurement measurement{};
+  for (uint32_t step = 0; step < STEPS; step++) {
+    const float t_s = step * DT_S;
+    const float ambient_c =
+        25.0f + 8.0f * std::sin(6.2831853f * t_s / (8.0f * 3600.0f));
+    const float open_circuit_v = 58.0f - 14.0f * t_s / (8.0f * 3600.0f);
+
+    measurement.current_valid = true;
+    measurement.voltage_valid = true;
+    measurement.temperature_valid = true;
+    measurement.current_a = current_a;
+    measurement.voltage_v = open_circuit_v - 0.02f * current_a;
+    measurement.power_w = measurement.current_a * measurement.voltage_v;
+    measurement.maximum_temperature_c =
+        std::round(sensor_c * 16.0f) / 16.0f;
+
+    const core::FaultFlags faults = core::detect_safety_faults(
+        measurement, hardware, limits, 0.01f, false, false);
+    if (core::has_fault(faults, core::Fault::OVERTEMPERATURE)) {
+      if (!tripped && run.trips++ == 0) {
+        run.first_trip_s = static_cast<uint32_t>(t_s);
+      }
+      tripped = true;
+    } else if (tripped && measurement.maximum_temperature_c < 60.0f) {
+      // A long test would be restarted by hand once the heatsink cooled.
+      tripped = false;
+      controller.reset();
+    }
+
+    derating.update(config, measurement, limits, DT_S);
+    const float limit = derating.apply(
+        config, measurement,
+        core::effective_current_limit(measurement, limits, calibration));
+    if (tripped) {
+      controller.reset();
+    } else {
+      const bool stepped =
+          controller.step(tuning, 10.0f, current_a, limit, DT_S, nullptr);
+      assert(stepped);
+      (void) stepped;
+      if (derating.derating_a() > 0.0f) run.derated_seconds += DT_S;
+      run.maximum_derating_a =
+          std::max(run.maximum_derating_a, derating.derating_a());
+    }
+    current_a = controller.command_a();
+    run.delivered_ah += current_a * DT_S / 3600.0;
+
+    const float power_w = current_a * (open_circuit_v - 0.02f * current_a);
+    heatsink_c += (ambient_c + TRUE_RESISTANCE_C_PER_W * power_w - heatsink_c) *
+                  DT_S / TRUE_TIME_CONSTANT_S;
+    sensor_c += (heatsink_c - sensor_c) * DT_S / SENSOR_LAG_S;
+    run.peak_temperature_c = std::max(run.peak_temperature_c, heatsink_c);
+  }
+  return run;
+}
+
+void test_thermal_derating_long_discharge() {
+  const DischargeRun static_limit = run_high_power_discharge(false);
+  const DischargeRun derated = run_high_power_discharge(true);
+  std::printf("  8 h discharge, static limit: %u trips (first at %u s), "
+              "peak %.1f degC, %.1f Ah\n",
+              static_limit.trips, static_limit.first_trip_s,
+              static_limit.peak_temperature_c, static_limit.delivered_ah);
+  std::printf("  8 h discharge, derated:      %u trips, peak %.1f degC, "
+              "%.1f Ah, up to %.2f A derated for %.0f s\n",
+              derated.trips, derated.peak_temperature_c, derated.delivered_ah,
+              derated.maximum_derating_a, derated.derated_seconds);
+  assert(static_limit.trips > 0);
+  assert(derated.trips == 0);
+  assert(derated.peak_temperature_c < 80.0f);
+  assert(derated.maximum_derating_a > 0.0f);
+  assert(derated.delivered_ah > static_limit.delivered_ah);
+}
+
+// In-memory preferences: one record per slot plus the v1 blob.
+class FakeCalibrationFlash : public core::CalibrationStorage {
+ public:
+  bool load_record(uint8_t slot, core::CalibrationRecord *record) override {
+    if (!this->present[slot]) return false;
+    *record = this->records[slot];
+    return true;
+  }
+  bool save_record(uint8_t slot, const core::CalibrationRecord &record) override {
+    if (this->fail_saves) return false;
+    this->records[slot] = record;
+    this->present[slot] = true;
+    this->saves++;
+    return true;
+  }
+  bool load_legacy(core::Calibration *calibration) override {
+    if (!this->legacy_present) return false;
+    *calibration = this->legacy;
+    return true;
+  }
+
+  core::CalibrationRecord records[core::MAX_CALIBRATION_PROFILES]{};
+  bool present[core::MAX_CALIBRATION_PROFILES]{};
+  core::Calibration legacy{};
+  bool legacy_present{false};
+  bool fail_saves{false};
+  uint32_t saves{0};
+};
+
+void test_calibration_store_migration_and_recovery() {
+  using Result = core::CalibrationSaveResult;
+  FakeCalibrationFlash flash;
+  flash.legacy = valid_calibration();
+  flash.legacy.current.scale = 1.002f;
+  flash.legacy_present = true;
+
+  // A v1 blob is migrated into the default profile exactly once.
+  core::CalibrationStore store;
+  assert(store.restore(flash, 0));
+  assert(store.stats().migrated_v1);
+  assert(std::strcmp(store.active_name(), "default") == 0);
+  assert(store.active_calibration()->current.scale == 1.002f);
+  assert(flash.saves == 1);
+  {
+    core::CalibrationStore rebooted;
+    assert(rebooted.restore(flash, 0));
+    assert(!rebooted.stats().migrated_v1);
+    assert(rebooted.active_calibration()->current.scale == 1.002f);
+  }
+
+  // Saving the active coefficients again issues no write.
+  assert(store.save(flash, "default", flash.legacy, 1000) == Result::UNCHANGED);
+  assert(flash.saves == 1 && store.stats().skipped_unchanged == 1);
+
+  // A second fixture becomes active and survives a reboot.
+  auto fixture_b = valid_calibration();
+  fixture_b.output.full_scale_current_a = 48.0f;
+  assert(store.save(flash, "fixture_b", fixture_b, 2000) == Result::SAVED);
+  assert(std::strcmp(store.active_name(), "fixture_b") == 0);
+  {
+    core::CalibrationStore rebooted;
+    assert(rebooted.restore(flash, 0));
+    assert(std::strcmp(rebooted.active_name(), "fixture_b") == 0);
+    assert(rebooted.find("default") != nullptr);
+  }
+
+  // Selecting a profile persists the choice; the selected profile wins.
+  assert(store.select(flash, "default", 3000, nullptr));
+  assert(!store.select(flash, "missing", 3000, nullptr));
+  {
+    core::CalibrationStore rebooted;
+    assert(rebooted.restore(flash, 0));
+    assert(std::strcmp(rebooted.active_name(), "default") == 0);
+  }
+
+  // A corrupted newest record is discarded and the previous profile restored.
+  int newest = 0;
+  for (int slot = 0; slot < core::MAX_CALIBRATION_PROFILES; slot++) {
+    if (flash.present[slot] &&
+        flash.records[slot].sequence > flash.records[newest].sequence) {
+      newest = slot;
+    }
+  }
+  flash.records[newest].calibration.current.offset += 0.5f;
+  {
+    core::CalibrationStore rebooted;
+    assert(rebooted.restore(flash, 0));
+    assert(rebooted.stats().corrupt_records == 1);
+    assert(std::strcmp(rebooted.active_name(), "fixture_b") == 0);
+    assert(rebooted.active_calibration()->output.full_scale_current_a == 48.0f);
+  }
+  flash.records[newest].calibration.current.offset -= 0.5f;
+  assert(core::calibration_record_valid(flash.records[newest]));
+  flash.records[newest].version = 1;
+  assert(!core::calibration_record_valid(flash.records[newest]));
+  flash.records[newest].version = core::CALIBRATION_STORE_VERSION;
+
+  // Failed writes leave the previous state in place.
+  flash.fail_saves = true;
+  auto rejected = valid_calibration();
+  rejected.voltage.offset = 0.1f;
+  assert(store.save(flash, "default", rejected, 4000) == Result::FAILED);
+  assert(store.active_calibration()->voltage.offset == 0.0f);
+  assert(!store.pending());
+  flash.fail_saves = false;
+
+  // Names must fit the record field.
+  assert(core::calibration_profile_name_valid("fixture_b"));
+  assert(!core::calibration_profile_name_valid(""));
+  assert(!core::calibration_profile_name_valid("sixteen_chars_xx"));
+  assert(store.save(flash, "sixteen_chars_xx", rejected, 4000) == Result::FAILED);
+}
+
+void test_calibration_store_write_budget() {
+  using Result = core::CalibrationSaveResult;
+  constexpr uint32_t HOUR_MS = 3600u * 1000u;
+  FakeCalibrationFlash flash;
+  core::CalibrationStore store;
+  store.set_max_writes_per_hour(2);
+  assert(!store.restore(flash, 0));
+
+  // A recalibration session: ten distinct saves within one hour.
+  uint32_t saved = 0;
+  uint32_t deferred = 0;
+  auto calibration = valid_calibration();
+  for (uint32_t step = 0; step < 10; step++) {
+    calibration.current.offset = 0.001f * (step + 1);
+    const Result result = store.save(flash, "bench", calibration, step * 60000u);
+    if (result == Result::SAVED) saved++;
+    if (result == Result::DEFERRED) deferred++;
+    // The newest coefficients are active in RAM regardless of the budget.
+    assert(store.active_calibration()->current.offset == calibration.current.offset);
+  }
+  assert(saved == 2 && deferred == 8);
+  assert(flash.saves == 2 && store.pending());
+  assert(store.flush(flash, HOUR_MS - 1) == Result::DEFERRED);
+  assert(store.flush(flash, HOUR_MS) == Result::SAVED);
+  assert(flash.saves == 3 && !store.pending());
+  assert(store.flush(flash, HOUR_MS + 1) == Result::UNCHANGED);
+
+  // Only the last deferred value reached flash.
+  core::CalibrationStore rebooted;
+  assert(rebooted.restore(flash, 0));
+  assert(rebooted.active_calibration()->current.offset == calibration.current.offset);
+
+  // A fifth profile replaces the least recently active one, never the active.
+  store.set_max_writes_per_hour(60);
+  const char *names[] = {"a", "b", "c", "d"};
+  uint32_t now = 2u * HOUR_MS;
+  for (const char *name : names) {
+    assert(store.save(flash, name, valid_calibration(), now += 1000u) ==
+           Result::SAVED);
+  }
+  assert(store.find("bench") == nullptr);
+  assert(store.find("a") != nullptr && store.find("d") != nullptr);
+  std::printf("  calibration store: %u writes for 10 saves + 4 profiles, "
+              "%u deferred, %u unchanged\n",
+              store.stats().writes, store.stats().deferred,
+              store.stats().skipped_unchanged);
+
+  // Profiles whose writes are still deferred are not evicted for a new one.
+  store.set_max_writes_per_hour(0);
+  for (const char *name : {"a", "b", "c", "d"}) {
+    auto updated = valid_calibration();
+    updated.voltage.offset = 0.01f;
+    assert(store.save(flash, name, updated, now += 1000u) == Result::DEFERRED);
+  }
+  assert(store.save(flash, "e", valid_calibration(), now += 1000u) == Result::FAILED);
+  assert(store.find("b") != nullptr && store.find("b")->voltage.offset == 0.01f);
+  assert(std::strcmp(store.active_name(), "d") == 0);
+  store.set_max_writes_per_hour(60);
+  assert(store.flush(flash, now) == Result::SAVED && !store.pending());
+  assert(store.save(flash, "e", valid_calibration(), now += 1000u) == Result::SAVED);
+  assert(store.find("a") == nullptr && store.find("e") != nullptr);
+}
+
 }  // namespace
 
 int main() {
@@ -163,5 +1033,16 @@ int main() {
   test_hardware_voltage_normalization();
   test_calibration_and_current_limit();
   test_multi_fault_detection_and_clear_conditions();
+  test_control_diagnostics();
+  test_current_controller();
+  test_channel_control_tick();
+  test_channels_are_isolated_and_scale_linearly();
+  test_charger_sample_tracker();
+  test_fan_controller();
+  test_fan_thermal_model();
+  test_thermal_derating();
+  test_thermal_derating_long_discharge();
+  test_calibration_store_migration_and_recovery();
+  test_calibration_store_write_budget();
   return 0;
 }
@@ -8,20 +8,24 @@ import re
 import sys
 
 SOURCE_SUFFIXES = {".c", ".cc", ".cpp", ".cxx", ".h", ".hh", ".hpp"}
-CORE_FILE_RE = re.compile(r"(?:.*_(?:bus|protocol|service|status|core)|calibration)\.(?:c|cc|cpp|cxx|h|hh|hpp)$")
+CORE_FILE_RE = re.compile(r"(?:.*_(?:bus|protocol|service|status|core)|calibration(?:_store)?)\.(?:c|cc|cpp|cxx|h|hh|hpp)$")
 INCLUDE_RE = re.compile(r'^\s*#\s*include\s*[<"]([^>"]+)[>"]')
 FORBIDDEN_TOKENS = ("ESP_LOG", "esphome::")
 
 
 def iter_checked_files(root: Path):
+    # A file named explicitly is checked whatever its name; directories are
+    # filtered to core-looking names unless the whole package must be pure.
     if root.is_file():
-        candidates = [root]
-    else:
-        candidates = sorted(
-            path
-            for path in root.rglob("*")
-            if path.is_file() and ".esphome" not in path.parts
-        )
+        if root.suffix in SOURCE_SUFFIXES:
+            yield root
+        return
+
+    candidates = sorted(
+        path
+        for path in root.rglob("*")
+        if path.is_file() and ".esphome" not in path.parts
+    )
 
     check_all_sources = root.name == "component_common"
     for path in candidates:
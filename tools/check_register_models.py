@@ -31,6 +31,7 @@ NON_REGISTER_COMPONENTS = {
 INTERNAL_COMPONENTS = {
     "component_common",
     "mcf83xx_common",
+    "mcf83xx_facade",
 }
 
 MIGRATED_RAW_CONSTANT_SCAN = {